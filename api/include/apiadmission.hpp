@@ -0,0 +1,87 @@
+#ifndef APIADMISSION_HPP
+#define APIADMISSION_HPP
+
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#endif
+
+#include <thrift/server/TServer.h>
+#include <thrift/transport/TSocket.h>
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace cs {
+
+// admission policy for the public API: caps simultaneous connections per
+// client address and paces request dispatch with a per-address token bucket.
+// A scraper opening hundreds of sockets or hammering one socket only slows
+// its own connection threads down, the thread-per-connection server keeps
+// serving everybody else at full speed
+class ApiAdmissionController {
+public:
+    // zero for either limit disables that part of the policy
+    ApiAdmissionController(int maxConnectionsPerIp, int maxRequestsPerSecondPerIp);
+
+    // called on accept, false means the connection is over the per-address cap
+    bool acceptConnection(const std::string& peer);
+    void releaseConnection(const std::string& peer);
+
+    // called before each request; blocks the calling connection thread until
+    // the peer's token bucket allows one more request
+    void paceRequest(const std::string& peer);
+
+    bool enabled() const {
+        return maxConnectionsPerIp_ > 0 || maxRequestsPerSecondPerIp_ > 0;
+    }
+
+private:
+    struct PeerState {
+        int connections = 0;
+        double tokens = 0.;
+        std::chrono::steady_clock::time_point lastRefill;
+    };
+
+    bool tryTakeToken(const std::string& peer, std::chrono::milliseconds& retryAfter);
+
+    const int maxConnectionsPerIp_;
+    const int maxRequestsPerSecondPerIp_;
+
+    std::mutex mutex_;
+    std::map<std::string, PeerState> peers_;
+};
+
+// Thrift server event handler gluing the controller to TThreadedServer:
+// connections over the cap are closed right after accept, admitted ones are
+// paced in processContext before every request
+class ApiAdmissionHandler : public ::apache::thrift::server::TServerEventHandler {
+public:
+    explicit ApiAdmissionHandler(std::shared_ptr<ApiAdmissionController> controller);
+
+    virtual void* createContext(::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> input,
+                                ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> output) override;
+    virtual void deleteContext(void* serverContext,
+                               ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> input,
+                               ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> output) override;
+    virtual void processContext(void* serverContext,
+                                ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TTransport> transport) override;
+
+private:
+    struct ClientContext {
+        std::string peer;
+        bool admitted = false;
+    };
+
+    std::shared_ptr<ApiAdmissionController> controller_;
+};
+
+}  // namespace cs
+
+#endif  // APIADMISSION_HPP
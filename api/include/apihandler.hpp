@@ -4,6 +4,7 @@
 #include <csstats.hpp>
 
 #include <deque>
+#include <limits>
 #include <queue>
 #include <tuple>
 
@@ -13,6 +14,7 @@
 
 #include "tokens.hpp"
 #include "dumbcv.hpp"
+#include "callcoalescer.hpp"
 #include "executor.hpp"
 
 #include <csnode/apihandler_serializer.hpp>
@@ -274,9 +276,38 @@ private:
     api::SmartContract fetch_smart_body(const csdb::Transaction&);
 
 private:
+    // memoization of wallet id -> public key resolution, so bulk conversions
+    // (TransactionsGet and friends) take the blockchain cache lock at most
+    // once per distinct address instead of twice per row
+    class AddressConversionCache {
+    public:
+        explicit AddressConversionCache(BlockChain& blockchain)
+        : blockchain_(blockchain) {
+        }
+
+        // returns the public key form of any address; Address is shared-data,
+        // so the value return is a reference count bump, not a deep copy
+        csdb::Address resolve(const csdb::Address& address);
+
+    private:
+        // wallet ids are assigned once and never remapped, entries can live
+        // for the whole connection; the cap only bounds worst-case memory
+        constexpr static size_t kResolvedLimit = 16 * 1024;
+
+        BlockChain& blockchain_;
+        std::unordered_map<csdb::internal::WalletId, csdb::Address> byWalletId_;
+    };
+
+    // one cache per serving thread, i.e. per client connection under the
+    // thread-per-connection server: resolved ids and table capacity are
+    // recycled between requests instead of being allocated and torn down
+    // for every call
+    AddressConversionCache& threadAddressCache();
+
     std::vector<api::SealedTransaction> extractTransactions(const csdb::Pool& pool, int64_t limit, const int64_t offset);
 
     api::SealedTransaction convertTransaction(const csdb::Transaction& transaction);
+    api::SealedTransaction convertTransaction(const csdb::Transaction& transaction, AddressConversionCache& addresses);
 
     std::vector<api::SealedTransaction> convertTransactions(const std::vector<csdb::Transaction>& transactions);
     
@@ -305,9 +336,19 @@ private:
     std::optional<std::string> checkTransaction(const ::api::Transaction&, csdb::Transaction& cTransaction);
     void checkTransactionsFlow(const cs::TransactionsPacket& packet, cs::DumbCv::Condition condition);
     api::ShortTransaction convertTransactionToShort(csdb::Transaction tr);
+    api::ShortTransaction convertTransactionToShort(csdb::Transaction tr, AddressConversionCache& addresses);
 
     TokensMaster tm_;
 
+    // materialized ordering for TokensListGet: explorer pages walk the same
+    // sort with different offsets, so the sorted id list is rebuilt only when
+    // the token cache revision moved or the requested ordering changed
+    std::mutex tokensListCacheMut_;
+    std::vector<TokenId> tokensListSorted_;
+    uint64_t tokensListRevision_ = std::numeric_limits<uint64_t>::max();
+    TokensListSortField tokensListOrder_{};
+    bool tokensListDesc_ = false;
+
     const uint8_t ERROR_CODE = 1;
 
     friend class ::csconnector::connector;
@@ -331,6 +372,25 @@ private:
     std::mutex tlMutex_;
     uint64_t requestId_ = 0;
 
+    // response caches for read-heavy explorer queries, keyed by request parameters and
+    // valid only for the chain sequence they were filled at; flushed on every stored block
+    const size_t MaxCachedResponses = 1000;
+    std::mutex responseCacheLock_;
+    cs::Sequence responseCacheSequence_ = 0;
+    std::map<std::pair<int64_t, int64_t>, api::PoolListGetResult> poolListCache_;
+    std::map<int64_t, api::PoolInfoGetResult> poolInfoCache_;
+    std::map<general::Address, api::WalletDataGetResult> walletDataCache_;
+    std::optional<api::StatsGetResult> statsCache_;
+
+    // must be called under responseCacheLock_
+    void refreshResponseCaches(cs::Sequence lastSequence);
+
+    // single-flight execution for the hottest polled queries: identical
+    // concurrent requests share one computation instead of each taking
+    // the blockchain locks
+    cs::CallCoalescer<int64_t, api::PoolInfoGetResult> poolInfoCoalescer_;
+    cs::CallCoalescer<general::Address, api::WalletBalanceGetResult> walletBalanceCoalescer_;
+
 private slots:
     void updateSmartCachesPool(const csdb::Pool& pool);
     void store_block_slot(const csdb::Pool& pool);
@@ -0,0 +1,95 @@
+#ifndef CALLCOALESCER_HPP
+#define CALLCOALESCER_HPP
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace cs {
+///
+/// Single-flight execution of identical concurrent API queries.
+///
+/// When a popular dApp polls, the same request arrives dozens of times inside
+/// one polling window and every copy used to recompute the answer under the
+/// blockchain locks. The coalescer lets the first caller of a key execute the
+/// query while late arrivals with the same key block on the flight and receive
+/// a copy of its result. The flight is removed as soon as the leader finishes,
+/// so results are never served stale - freshness is governed by the response
+/// caches, not by the coalescer.
+///
+template <typename Key, typename Result>
+class CallCoalescer {
+public:
+    template <typename Func>
+    void perform(const Key& key, Result& result, Func&& compute) {
+        std::shared_ptr<Flight> flight;
+        bool leader = false;
+        {
+            std::lock_guard lock(mutex_);
+            auto it = flights_.find(key);
+            if (it == flights_.end()) {
+                flight = std::make_shared<Flight>();
+                flights_.emplace(key, flight);
+                leader = true;
+            }
+            else {
+                flight = it->second;
+            }
+        }
+
+        if (leader) {
+            try {
+                compute(result);
+            }
+            catch (...) {
+                finish(key, flight, result, false);
+                throw;
+            }
+            finish(key, flight, result, true);
+        }
+        else {
+            std::unique_lock lock(flight->mutex);
+            flight->cv.wait(lock, [&flight]() { return flight->done; });
+            if (flight->valid) {
+                result = flight->result;
+            }
+            else {
+                // the leader threw, recompute independently
+                lock.unlock();
+                compute(result);
+            }
+        }
+    }
+
+private:
+    struct Flight {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        bool valid = false;
+        Result result;
+    };
+
+    void finish(const Key& key, const std::shared_ptr<Flight>& flight, Result& result, bool valid) {
+        {
+            std::lock_guard lock(mutex_);
+            flights_.erase(key);
+        }
+        {
+            std::lock_guard lock(flight->mutex);
+            if (valid) {
+                flight->result = result;
+            }
+            flight->valid = valid;
+            flight->done = true;
+        }
+        flight->cv.notify_all();
+    }
+
+    std::mutex mutex_;
+    std::map<Key, std::shared_ptr<Flight>> flights_;
+};
+}  // namespace cs
+
+#endif  // CALLCOALESCER_HPP
@@ -10,6 +10,10 @@
 #include <thrift/server/TThreadPoolServer.h>
 #include <thrift/server/TThreadedServer.h>
 
+#ifdef API_NONBLOCKING_SERVER
+#include <thrift/server/TNonblockingServer.h>
+#endif
+
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
@@ -24,10 +28,14 @@
 #include <thread>
 
 #include <apidiaghandler.hpp>
+#include <receiptspusher.hpp>
+#include <walletsexporter.hpp>
 
 #ifdef PROFILE_API
 #include <profiler/profilerprocessor.hpp>
 #include <profiler/profilereventhandler.hpp>
+#else
+#include <metricsprocessor.hpp>
 #endif
 
 #include <csnode/caches_serialization_manager.hpp>
@@ -47,7 +55,7 @@ public:
 #ifdef PROFILE_API
     using ApiProcessor = cs::ProfilerProcessor;
 #else
-    using ApiProcessor = ::api::APIProcessor;
+    using ApiProcessor = cs::MetricsProcessor;
 #endif
 
     explicit connector(Node& node, cs::CachesSerializationManager&);
@@ -68,6 +76,7 @@ public:
 
     void onStoreBlock(const csdb::Pool& pool) {
         api_handler->store_block_slot(pool);
+        receipts_pusher->onBlockStored(pool);
     }
 
     void onMaxBlocksCount(cs::Sequence lastBlockNum) {
@@ -103,6 +112,9 @@ private:
 #ifdef BINARY_TCP_API
     std::thread api_thread;
     std::shared_ptr<::apache::thrift::server::TThreadedServer> api_server;
+#ifdef API_NONBLOCKING_SERVER
+    std::shared_ptr<::apache::thrift::server::TNonblockingServer> nonblocking_api_server;
+#endif
 #endif
 
 #ifdef AJAX_IFACE
@@ -118,6 +130,9 @@ private:
     std::thread diag_thread;
     std::shared_ptr<::apache::thrift::server::TThreadedServer> diag_server;
 
+    std::unique_ptr<cs::WalletsExporter> wallets_exporter;
+    std::unique_ptr<cs::ReceiptsPusher> receipts_pusher;
+
     std::atomic_bool stop_flag;
 };
 }  // namespace csconnector
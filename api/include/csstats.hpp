@@ -71,6 +71,9 @@ const uint32_t updateTimeSec = 3;
 const uint32_t updateTimeSec = 30;
 #endif
 const uint32_t secondsPerDay = 24 * 60 * 60;
+// granularity of the sliding-window ring: one cut per hour keeps the month
+// window at 720 entries
+const uint32_t cutTimeSec = 60 * 60;
 const Periods collectionPeriods = {secondsPerDay, secondsPerDay * 7, secondsPerDay * 30, secondsPerDay * 365 * 100};
 
 class csstats {
@@ -79,6 +82,10 @@ public:
 
     StatsPerPeriod getStats();
 
+    // incremental feed: called for every stored block, so the update cycle
+    // never has to walk the chain itself
+    void onStoreBlock(const csdb::Pool& pool);
+
     ~csstats();
 
 	void run(const ::csstats::AllStats& allStats);
@@ -93,6 +100,14 @@ private:
     StatsPerPeriod currentStats;
     StatsCut statsCut;
 
+    // blocks accumulated from store events since the last update cycle
+    PeriodStats pendingCut;
+    std::mutex pendingCutMutex;
+
+    // in-progress cut of the current cutTimeSec slot
+    PeriodStats currentCut;
+    std::chrono::system_clock::time_point nextRotation;
+
     std::mutex currentStatsMutex;
     std::chrono::system_clock::time_point lastUpdateTime = std::chrono::system_clock::from_time_t(0);
 
@@ -101,6 +116,8 @@ private:
     StatsPerPeriod collectStats(const Periods& periods);
     //AllStats collectAllStats(const Periods& periods);
 
+    void accumulate(PeriodStats& periodStats, const csdb::Pool& pool);
+
     template <class F>
     void matchPeriod(const Periods& periods, period_t period, F func);
 
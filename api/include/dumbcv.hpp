@@ -1,6 +1,7 @@
 #ifndef DUMBCV_HPP
 #define DUMBCV_HPP
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <map>
@@ -28,6 +29,11 @@ public:
     };
 
     bool addCVInfo(const cs::Signature& signature);
+
+    // drops a registered entry nobody is going to wait for, e.g. when the
+    // transaction was rejected at conveyer admission
+    void remove(const cs::Signature& signature);
+
     void sendCvSignal(const cs::Signature& signature, Condition condition, const csdb::TransactionID& id, const csdb::Amount fee);
     DumbCv::Result waitCvSignal(const cs::Signature& signature);
 
@@ -40,8 +46,21 @@ private:
         csdb::Amount fee{};
     };
 
-    std::map<cs::Signature, CvInfo> cvInfo_;
-    std::mutex mutex_;
+    // a single map under one mutex serialized every submission at burst rates;
+    // signatures are uniform, so the first byte spreads them over the shards
+    // and add/signal/wait for different transactions no longer contend
+    static const size_t kShardsCount = 16;
+
+    struct Shard {
+        std::mutex mutex;
+        std::map<cs::Signature, CvInfo> cvInfo;
+    };
+
+    Shard& shard(const cs::Signature& signature) {
+        return shards_[signature[0] & (kShardsCount - 1)];
+    }
+
+    std::array<Shard, kShardsCount> shards_;
 };
 }
 
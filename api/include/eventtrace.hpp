@@ -0,0 +1,86 @@
+#ifndef EVENTTRACE_HPP
+#define EVENTTRACE_HPP
+
+#include <map>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// Compact binary trace format for event report analytics.
+///
+/// The collector used to recover event streams from csevent() log lines,
+/// which caps aggregation throughput at regex speed. A trace frame keeps the
+/// structured fields the collector actually groups by - event id, reporter
+/// key, round, chain top - in a schema cheap enough to decode at millions of
+/// records per second during incident triage.
+///
+/// Frame layout (all varints are unsigned LEB128):
+///   'E' 'T'            magic
+///   version            one byte, currently 1
+///   senderCount        varint, then senderCount raw 32-byte public keys;
+///                      records reference this dictionary by index, a frame
+///                      full of reports from few nodes stores each key once
+///   recordCount        varint
+///   records            repeated:
+///     id               one byte, EventReport::Id of the wrapped pack
+///     senderIndex      varint into the key dictionary
+///     roundDelta       zigzag varint against the previous record
+///     lastBlockDelta   zigzag varint against the previous record
+///     payloadSize      varint, then the original EventReport binary pack
+///
+/// Rounds and chain tops of consecutive records differ by little within a
+/// frame, so deltas keep most of them to one or two bytes.
+///
+
+/// one event occurrence as seen by the collector
+struct EventTraceRecord {
+    uint8_t id = 0;                    // EventReport::Id of the wrapped pack
+    cs::RoundNumber round = 0;         // reporter round at send time
+    cs::Sequence senderLastBlock = 0;  // reporter chain top at send time
+    cs::PublicKey sender{};            // reporting node key
+    cs::Bytes payload;                 // original EventReport binary pack
+};
+
+///
+/// Accumulates records and seals them into one batch frame.
+/// Not thread safe, the collector feeds it from a single ingest thread.
+///
+class EventTraceEncoder {
+public:
+    void append(const EventTraceRecord& record);
+
+    size_t recordsCount() const {
+        return recordsCount_;
+    }
+
+    /// finalizes the frame and resets the encoder for the next batch
+    cs::Bytes seal();
+
+private:
+    cs::Bytes body_;
+    std::vector<cs::PublicKey> senders_;
+    std::map<cs::PublicKey, size_t> senderIndex_;
+
+    size_t recordsCount_ = 0;
+    cs::RoundNumber previousRound_ = 0;
+    cs::Sequence previousLastBlock_ = 0;
+};
+
+///
+/// Decodes batch frames produced by EventTraceEncoder.
+///
+class EventTraceDecoder {
+public:
+    ///
+    /// @brief Decodes a sealed frame into records.
+    /// @return False on malformed or truncated input, records is left
+    /// untouched in that case - a damaged frame is dropped whole rather
+    /// than aggregated partially.
+    ///
+    static bool decode(const cs::Bytes& frame, std::vector<EventTraceRecord>& records);
+};
+}  // namespace cs
+
+#endif  // EVENTTRACE_HPP
@@ -21,6 +21,8 @@
 #include <any>
 #include <memory>
 #include <optional>
+#include <shared_mutex>
+#include <vector>
 
 #include <lib/system/common.hpp>
 #include <lib/system/process.hpp>
@@ -30,6 +32,7 @@
 
 #include <csdb/currency.hpp>
 
+#include "callcoalescer.hpp"
 #include "executormanager.hpp"
 
 class BlockChain;
@@ -237,6 +240,25 @@ private:
 
     void recreateOriginExecutor();
 
+    // dedicated connection for read-only (getter) executions, so dApp read traffic
+    // does not queue behind consensus executions on the main connection; the
+    // concurrent client pipelines parallel calls over each connection on its own
+    struct GetterConnection {
+        ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TSocket> socket;
+        ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TTransport> transport;
+        std::unique_ptr<OriginExecutor> client;
+        std::shared_mutex errorMutex;
+    };
+
+    GetterConnection* acquireGetterConnection();
+    void recreateGetterClient(GetterConnection& connection);
+
+    // post-restart warm-up: pushes the most frequently executed contract
+    // bytecodes through the fresh executor, so first user calls do not pay
+    // JVM class loading and JIT compilation from zero
+    void warmUpContracts();
+    void recordExecution(const csdb::Address& address);
+
 private:
     const BlockChain& blockchain_;
     const cs::SolverCore& solver_;
@@ -245,6 +267,8 @@ private:
     ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TTransport> executorTransport_;
 
     std::unique_ptr<executor::ContractExecutorConcurrentClient> origExecutor_;
+    std::vector<std::unique_ptr<GetterConnection>> getterConnections_;
+    std::atomic_size_t nextGetterConnection_{0};
     std::unique_ptr<cs::Process> executorProcess_;
 
     general::AccessID lastAccessId_{};
@@ -260,12 +284,25 @@ private:
     std::shared_mutex mutex_;
     std::atomic_size_t execCount_{0};
 
+    // getContractMethods memoization keyed by bytecode hash: token factories
+    // deploy byte-identical contracts en masse, each compile-check is a full
+    // executor round trip, so repeated bytecode is verified exactly once and
+    // concurrent validations of the same bytecode share a single flight
+    cs::CallCoalescer<cs::Hash, executor::GetContractMethodsResult> contractMethodsCoalescer_;
+    std::mutex contractMethodsCacheMutex_;
+    std::map<cs::Hash, executor::GetContractMethodsResult> contractMethodsCache_;
+    static constexpr size_t kContractMethodsCacheLimit = 1000;
+
+    // per-contract execution frequency, ranks the warm-up candidates
+    std::mutex executionCountsMutex_;
+    std::map<csdb::Address, uint64_t> executionCounts_;
+    static constexpr size_t kWarmUpContractsLimit = 8;
+
     mutable std::condition_variable cvErrorConnect_;
     std::atomic_bool requestStop_{ false };
 
     const int16_t EXECUTOR_VERSION = 4;
 
-    std::mutex callExecutorLock_;
     std::atomic<bool> isWatcherRunning_ = { false };
 
     cs::ExecutorManager manager_;
@@ -0,0 +1,47 @@
+#ifndef METRICSEXPORTER_HPP
+#define METRICSEXPORTER_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+class Node;
+
+namespace cs {
+// plain HTTP scrape endpoint serving node gauges and latency histograms
+// in prometheus text format; one short-lived connection per scrape, no
+// thrift session needed. Disabled unless [api] metrics_port is set.
+//
+// The exporter is created and run() before the node exists, so the long
+// blockchain replay is already observable through the progress counters;
+// node-level gauges appear once attachNode() is called
+class MetricsExporter {
+public:
+    MetricsExporter();
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // enables the node gauges; must precede the node's destruction by stop()
+    void attachNode(Node& node);
+
+    void run();
+    void stop();
+
+private:
+    void serverRoutine(uint16_t port);
+    std::string render();
+
+    std::atomic<Node*> node_{nullptr};
+
+    std::thread thread_;
+    std::atomic_bool stopFlag_{false};
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+}  // namespace cs
+
+#endif  // METRICSEXPORTER_HPP
@@ -0,0 +1,18 @@
+#ifndef METRICSPROCESSOR_HPP
+#define METRICSPROCESSOR_HPP
+
+#include <API.h>
+
+namespace cs {
+// records per-method dispatch latency of the public API to the metrics
+// registry, histograms are named api_<method>_us
+class MetricsProcessor : public ::api::APIProcessor {
+public:
+    explicit MetricsProcessor(::apache::thrift::stdcxx::shared_ptr<api::APIIf> iface);
+    virtual bool dispatchCall(::apache::thrift::protocol::TProtocol* iprot,
+                              ::apache::thrift::protocol::TProtocol* oprot,
+                              const std::string& fname, int32_t seqid, void* callContext) override;
+};
+}
+
+#endif // METRICSPROCESSOR_HPP
@@ -1,6 +1,10 @@
 #ifndef PROFILER_HPP
 #define PROFILER_HPP
 
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
 #include <vector>
 #include <string>
 #include <fstream>
@@ -93,6 +97,109 @@ private:
     std::atomic<bool> isRunning_ = { false };
 };
 
+// aggregates api method spans: per method wall time histogram with lock wait
+// and storage call attribution, periodically dumps the top offenders to the
+// file logger. Recording is atomic per field, spans never block each other
+class SpanProfiler {
+public:
+    enum Options {
+        HistogramBuckets = 24,  // log2 buckets of microseconds, ~8 s cap
+        TopMethodsCount = 8,
+        DumpPeriodSec = 60
+    };
+
+    struct MethodStats {
+        std::atomic<uint64_t> calls{ 0 };
+        std::atomic<uint64_t> totalTimeUs{ 0 };
+        std::atomic<uint64_t> maxTimeUs{ 0 };
+        std::atomic<uint64_t> lockWaitUs{ 0 };
+        std::atomic<uint64_t> storageCalls{ 0 };
+        std::array<std::atomic<uint64_t>, HistogramBuckets> histogram{};
+    };
+
+    static SpanProfiler& instance() {
+        static SpanProfiler profiler;
+        return profiler;
+    }
+
+    // stable reference, resolved once per span start
+    MethodStats& stats(const std::string& method);
+
+    void record(MethodStats& stats, uint64_t wallUs, uint64_t lockWaitUs, uint64_t storageCalls);
+
+private:
+    SpanProfiler() = default;
+    void dump();
+
+    std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<MethodStats>> methods_;
+    std::atomic<int64_t> lastDumpTimeMs_ = { 0 };
+};
+
+// RAII span around an api method; the innermost active span of the thread
+// collects the lock waits and storage calls reported while it is alive
+class ProfilerSpan {
+public:
+    explicit ProfilerSpan(const std::string& method)
+    : stats_(SpanProfiler::instance().stats(method))
+    , point_(std::chrono::steady_clock::now())
+    , previous_(current_) {
+        current_ = this;
+    }
+
+    ~ProfilerSpan() {
+        current_ = previous_;
+
+        auto wall = std::chrono::steady_clock::now() - point_;
+        auto wallUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(wall).count());
+
+        SpanProfiler::instance().record(stats_, wallUs, lockWaitUs_, storageCalls_);
+    }
+
+    // attribute a lock acquisition wait to the active span, no-op without one
+    static void addLockWait(std::chrono::nanoseconds wait) {
+        if (current_ != nullptr) {
+            current_->lockWaitUs_ += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(wait).count());
+        }
+    }
+
+    // attribute one blockchain/storage call to the active span
+    static void addStorageCall() {
+        if (current_ != nullptr) {
+            ++current_->storageCalls_;
+        }
+    }
+
+private:
+    SpanProfiler::MethodStats& stats_;
+    std::chrono::steady_clock::time_point point_;
+    uint64_t lockWaitUs_ = 0;
+    uint64_t storageCalls_ = 0;
+
+    ProfilerSpan* previous_;
+    inline static thread_local ProfilerSpan* current_ = nullptr;
+};
+
+// lock guard reporting the time spent on acquisition to the active span
+template <typename Lockable>
+class ProfiledLock {
+public:
+    explicit ProfiledLock(Lockable& lockable)
+    : lock_(acquire(lockable)) {
+    }
+
+private:
+    static std::unique_lock<Lockable> acquire(Lockable& lockable) {
+        auto point = std::chrono::steady_clock::now();
+        std::unique_lock<Lockable> lock(lockable);
+
+        ProfilerSpan::addLockWait(std::chrono::steady_clock::now() - point);
+        return lock;
+    }
+
+    std::unique_lock<Lockable> lock_;
+};
+
 // RAII watcher to file logger
 class Profiler {
 public:
@@ -0,0 +1,129 @@
+#ifndef RECEIPTSPUSHER_HPP
+#define RECEIPTSPUSHER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <csdb/pool.hpp>
+
+#include <lib/system/common.hpp>
+#include <lib/system/signals.hpp>
+
+class Node;
+
+namespace cs {
+class TransactionsPacket;
+
+// push subscriptions for transaction inclusion over raw TCP, replacing the
+// TransactionFlow/TransactionGet polling loop dApps run today. A client
+// registers interest in concrete transactions (source key + inner id) or in
+// whole addresses; the node pushes one record per match when a block is
+// stored, or when the packet expires or is rejected by consensus. Single-use
+// transaction watches are dropped from the index once fired, so the
+// pending-watch index only ever holds what is still awaited. Disabled unless
+// [api] receipts_push_port is set.
+//
+// Stream layout, integers in host byte order like the rest of the binary api:
+//   server -> client on connect: 'CSRP', uint8 version
+//   client -> server: [uint8 cmd] where cmd 1 (watch transaction) is
+//   followed by a 32 byte source key and int64 inner id, cmd 2 (watch
+//   address) by a 32 byte key
+//   server -> client per match: [uint8 result][32 byte key][int64 inner id]
+//   [uint64 sequence][uint32 index]; result is 1 included, 2 expired,
+//   3 rejected; sequence and index are zero unless included
+class ReceiptsPusher {
+public:
+    explicit ReceiptsPusher(Node& node);
+    ~ReceiptsPusher();
+
+    ReceiptsPusher(const ReceiptsPusher&) = delete;
+    ReceiptsPusher& operator=(const ReceiptsPusher&) = delete;
+
+    void run();
+    void stop();
+
+public slots:
+    void onBlockStored(const csdb::Pool& pool);
+    void onPacketExpired(const cs::TransactionsPacket& packet);
+    void onTransactionsRejected(const cs::TransactionsPacket& packet);
+
+private:
+    constexpr static uint8_t kVersion = 1;
+
+    constexpr static uint8_t kCmdWatchTransaction = 1;
+    constexpr static uint8_t kCmdWatchAddress = 2;
+
+    constexpr static uint8_t kResultIncluded = 1;
+    constexpr static uint8_t kResultExpired = 2;
+    constexpr static uint8_t kResultRejected = 3;
+
+    // block storage never waits on client sockets: events queue up here and
+    // the dispatcher thread delivers them; oldest events go first overboard
+    // if a stalled client lets the queue grow this far
+    constexpr static size_t kMaxPendingEvents = 1024;
+
+    class Session;
+    using SessionPtr = std::shared_ptr<Session>;
+
+    struct TransactionRecord {
+        cs::PublicKey source;
+        cs::PublicKey target;
+        int64_t innerId;
+        uint32_t index;
+    };
+
+    struct Event {
+        uint8_t result;
+        cs::Sequence sequence;
+        std::vector<TransactionRecord> records;
+    };
+
+    struct TransactionWatch {
+        cs::PublicKey source;
+        int64_t innerId;
+
+        bool operator==(const TransactionWatch& other) const {
+            return innerId == other.innerId && source == other.source;
+        }
+    };
+
+    struct TransactionWatchHash {
+        size_t operator()(const TransactionWatch& watch) const;
+    };
+
+    void serverRoutine(uint16_t port);
+    void sessionRoutine(SessionPtr session);
+    void dispatcherRoutine();
+
+    void enqueue(uint8_t result, const csdb::Pool* pool, const cs::TransactionsPacket* packet);
+    void deliver(const Event& event);
+    void push(const SessionPtr& session, uint8_t result, const cs::PublicKey& key,
+              int64_t innerId, cs::Sequence sequence, uint32_t index);
+
+    Node& node_;
+
+    std::thread acceptThread_;
+    std::thread dispatchThread_;
+    std::atomic_bool stopFlag_{false};
+
+    std::mutex watchMutex_;
+    std::unordered_map<TransactionWatch, std::vector<std::weak_ptr<Session>>, TransactionWatchHash> transactionWatches_;
+    std::unordered_map<cs::PublicKey, std::vector<std::weak_ptr<Session>>> addressWatches_;
+
+    std::mutex eventMutex_;
+    std::condition_variable eventArrived_;
+    std::deque<Event> events_;
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+}  // namespace cs
+
+#endif  // RECEIPTSPUSHER_HPP
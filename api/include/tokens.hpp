@@ -1,6 +1,7 @@
 #ifndef TOKENS_HPP
 #define TOKENS_HPP
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <mutex>
@@ -88,12 +89,24 @@ public:
     };
 
     void updateTokenChaches(const csdb::Address& addr, const std::string& newState, const TokenInvocationData::Params& params);
-    
-    void refreshTokenState(const csdb::Address& token, const std::string& newState, bool checkBalance = false);
+
+    // bumped on every token cache mutation; lets the api layer keep
+    // materialized sorted views and rebuild them only after a real change
+    uint64_t revision() const {
+        return revision_.load(std::memory_order_acquire);
+    }
+
+    // dirtyHolders narrows the balance refresh to the holders a transfer could
+    // have touched; null means every holder is re-queried
+    void refreshTokenState(const csdb::Address& token, const std::string& newState, bool checkBalance = false, const std::vector<HolderKey>* dirtyHolders = nullptr);
 
 private:
     void initiateHolder(Token&, const csdb::Address& token, const csdb::Address& holder, bool increaseTransfers = false);
 
+    void bumpRevision() {
+        revision_.fetch_add(1, std::memory_order_release);
+    }
+
     api::APIHandler* api_;
 
     std::mutex cvMut_;
@@ -107,6 +120,7 @@ private:
     std::mutex dataMut_;
     TokensMap tokens_;
     HoldersMap holders_;
+    std::atomic<uint64_t> revision_{0};
 
     friend class cs::TokensMaster_Serializer;
 };
@@ -0,0 +1,41 @@
+#ifndef WALLETSEXPORTER_HPP
+#define WALLETSEXPORTER_HPP
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+class Node;
+
+namespace cs {
+// bulk wallet snapshot stream over raw TCP: one connection gets every wallet
+// as (key, balance, delegated, txCount) records in framed binary batches,
+// optionally LZ4-compressed, replacing hundreds of thousands of per-wallet
+// thrift round trips. Batches are copied out of MultiWallets under a
+// per-batch shared lock, so cache updates are never blocked for the whole
+// dump. Disabled unless [api] wallets_export_port is set
+class WalletsExporter {
+public:
+    explicit WalletsExporter(Node& node);
+    ~WalletsExporter();
+
+    WalletsExporter(const WalletsExporter&) = delete;
+    WalletsExporter& operator=(const WalletsExporter&) = delete;
+
+    void run();
+    void stop();
+
+private:
+    void serverRoutine(uint16_t port);
+
+    Node& node_;
+
+    std::thread thread_;
+    std::atomic_bool stopFlag_{false};
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+}  // namespace cs
+
+#endif  // WALLETSEXPORTER_HPP
@@ -0,0 +1,164 @@
+#include <apiadmission.hpp>
+
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#endif
+
+#include <thrift/transport/TBufferTransports.h>
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#include <algorithm>
+#include <thread>
+
+#include <lib/system/logger.hpp>
+#include <lib/system/reflection.hpp>
+
+namespace {
+// a client may burst up to one second worth of its rate before pacing kicks in
+constexpr double kBurstSeconds = 1.0;
+}  // namespace
+
+cs::ApiAdmissionController::ApiAdmissionController(int maxConnectionsPerIp, int maxRequestsPerSecondPerIp)
+: maxConnectionsPerIp_(maxConnectionsPerIp)
+, maxRequestsPerSecondPerIp_(maxRequestsPerSecondPerIp) {
+}
+
+bool cs::ApiAdmissionController::acceptConnection(const std::string& peer) {
+    if (peer.empty()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& state = peers_[peer];
+
+    if (maxConnectionsPerIp_ > 0 && state.connections >= maxConnectionsPerIp_) {
+        return false;
+    }
+
+    if (state.connections == 0) {
+        state.tokens = maxRequestsPerSecondPerIp_ * kBurstSeconds;
+        state.lastRefill = std::chrono::steady_clock::now();
+    }
+
+    ++state.connections;
+    return true;
+}
+
+void cs::ApiAdmissionController::releaseConnection(const std::string& peer) {
+    if (peer.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer);
+
+    if (it == peers_.end()) {
+        return;
+    }
+
+    if (--(it->second.connections) <= 0) {
+        peers_.erase(it);
+    }
+}
+
+bool cs::ApiAdmissionController::tryTakeToken(const std::string& peer, std::chrono::milliseconds& retryAfter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer);
+
+    if (it == peers_.end()) {
+        return true;
+    }
+
+    auto& state = it->second;
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - state.lastRefill).count();
+
+    state.lastRefill = now;
+    state.tokens = std::min(state.tokens + elapsed * maxRequestsPerSecondPerIp_, maxRequestsPerSecondPerIp_ * kBurstSeconds);
+
+    if (state.tokens >= 1.) {
+        state.tokens -= 1.;
+        return true;
+    }
+
+    const double deficitSeconds = (1. - state.tokens) / maxRequestsPerSecondPerIp_;
+    retryAfter = std::chrono::milliseconds(static_cast<int64_t>(deficitSeconds * 1000.) + 1);
+    return false;
+}
+
+void cs::ApiAdmissionController::paceRequest(const std::string& peer) {
+    if (maxRequestsPerSecondPerIp_ <= 0 || peer.empty()) {
+        return;
+    }
+
+    // sleeping here blocks only this connection's serving thread, so an
+    // over-rate client pays for its own excess while everybody else proceeds
+    std::chrono::milliseconds retryAfter{0};
+
+    while (!tryTakeToken(peer, retryAfter)) {
+        std::this_thread::sleep_for(retryAfter);
+    }
+}
+
+cs::ApiAdmissionHandler::ApiAdmissionHandler(std::shared_ptr<ApiAdmissionController> controller)
+: controller_(std::move(controller)) {
+}
+
+void* cs::ApiAdmissionHandler::createContext(::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> input,
+                                             ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> output) {
+    csunused(output);
+
+    auto context = new ClientContext();
+    auto transport = input->getTransport();
+
+    if (auto buffered = std::dynamic_pointer_cast<::apache::thrift::transport::TBufferedTransport>(transport)) {
+        transport = buffered->getUnderlyingTransport();
+    }
+
+    auto socket = std::dynamic_pointer_cast<::apache::thrift::transport::TSocket>(transport);
+
+    if (socket) {
+        context->peer = socket->getPeerAddress();
+    }
+
+    context->admitted = controller_->acceptConnection(context->peer);
+
+    if (!context->admitted) {
+        cswarning() << "API: connection cap reached for " << context->peer << ", closing connection";
+
+        if (socket) {
+            socket->close();
+        }
+    }
+
+    return context;
+}
+
+void cs::ApiAdmissionHandler::deleteContext(void* serverContext,
+                                            ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> input,
+                                            ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::protocol::TProtocol> output) {
+    csunused(input);
+    csunused(output);
+
+    auto context = static_cast<ClientContext*>(serverContext);
+
+    if (context->admitted) {
+        controller_->releaseConnection(context->peer);
+    }
+
+    delete context;
+}
+
+void cs::ApiAdmissionHandler::processContext(void* serverContext,
+                                             ::apache::thrift::stdcxx::shared_ptr<::apache::thrift::transport::TTransport> transport) {
+    csunused(transport);
+
+    auto context = static_cast<ClientContext*>(serverContext);
+
+    if (context->admitted) {
+        controller_->paceRequest(context->peer);
+    }
+}
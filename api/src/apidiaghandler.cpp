@@ -8,6 +8,16 @@
 #include <packetvalidator.hpp>
 #include <api_types.h>
 
+#include <csnode/multiwallets.hpp>
+#include <csnode/odatastream.hpp>
+
+#include <lib/system/cryptoservice.hpp>
+#include <lib/system/metrics.hpp>
+
+#ifdef LOCK_PROFILING
+#include <lib/system/lockprofiler.hpp>
+#endif
+
 // see: apihandler.cpp #175
 //extern std::string fromByteArray(const cs::PublicKey& key);
 template <typename TArr>
@@ -468,6 +478,106 @@ namespace api_diag {
             node_.showDbParams();
         }*/
 
+        if (order == 8U) {  // latency histograms dump
+            _return.__set_code(kOk);
+            _return.__set_message(cs::Metrics::instance().report());
+            return;
+        }
+
+        if (order == 9U) {  // warm standby on, node keeps caches hot but stays out of consensus
+            node_.enterStandby();
+            _return.__set_code(kOk);
+            _return.__set_message("standby mode on");
+            return;
+        }
+
+        if (order == 10U) {  // warm standby off, spare becomes a full validator next round
+            node_.leaveStandby();
+            _return.__set_code(kOk);
+            _return.__set_message("standby mode off");
+            return;
+        }
+
+        if (order == 11U) {  // LMDB map occupancy, to provision ahead of a remap stall
+            const auto& blockchain = node_.getBlockChain();
+            _return.__set_code(kOk);
+            _return.__set_message("trxindex map " + std::to_string(blockchain.getTrxIndexDbOccupancy()) +
+                                  "% full, blockhashes map " + std::to_string(blockchain.getBlockHashesDbOccupancy()) + "% full");
+            return;
+        }
+
+        if (order == 12U) {  // lock contention profile, only in LOCK_PROFILING builds
+#ifdef LOCK_PROFILING
+            _return.__set_code(kOk);
+            _return.__set_message(cs::LockProfiler::instance().report());
+#else
+            _return.__set_code(kNotImplemented);
+            _return.__set_message("lock profiling is disabled, rebuild with -DLOCK_PROFILING=ON");
+#endif
+            return;
+        }
+        if (order == 13U) {  // crypto service throughput counters
+            _return.__set_code(kOk);
+            _return.__set_message(cs::CryptoService::instance().report());
+            return;
+        }
+
+        if (order == 14U) {  // vectored balance query for exchange reconciliation
+            uint32_t count = 0;
+            stream >> count;
+
+            constexpr uint32_t kMaxBalanceQueryKeys = 10'000;
+            if (!stream.isValid() || count == 0 || count > kMaxBalanceQueryKeys) {
+                _return.__set_code(kError);
+                _return.__set_message("key count must be in [1.." + std::to_string(kMaxBalanceQueryKeys) + "]");
+                return;
+            }
+
+            std::vector<cs::PublicKey> keys;
+            keys.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                cs::PublicKey key;
+                stream >> key;
+                keys.push_back(key);
+            }
+            if (!stream.isValid()) {
+                _return.__set_code(kError);
+                _return.__set_message("malformed key list");
+                return;
+            }
+
+            const auto& blockchain = node_.getBlockChain();
+
+            // the whole batch answers from one MultiWallets snapshot; retry
+            // until the chain top is stable across the resolve so the witness
+            // names the exact block the balances are consistent with
+            cs::Sequence top;
+            std::vector<csdb::Amount> balances;
+            do {
+                top = blockchain.getLastSeq();
+                balances = blockchain.multiWallets().balances(keys);
+            } while (top != blockchain.getLastSeq());
+
+            // reply layout: sequence, block hash (witness), count, then
+            // (integral, fraction) per key in submission order
+            cs::Bytes reply;
+            cs::ODataStream out(reply);
+            out << top << blockchain.getHashBySequence(top) << count;
+            for (const auto& balance : balances) {
+                out << balance.integral() << balance.fraction();
+            }
+
+            _return.__set_code(kOk);
+            _return.__set_message(to_string(reply));
+            return;
+        }
+
+        if (order == 15U) {  // per-peer link and traffic stats
+            _return.__set_code(kOk);
+            _return.__set_message(node_.getPeerStatsReport());
+            return;
+        }
+
         _return.__set_code(kNotImplemented);
         _return.__set_message("Not implemented");
     }
@@ -1,5 +1,8 @@
 #include <apihandler.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+
 #include <csnode/fee.hpp>
 #include <csnode/conveyer.hpp>
 #include <csnode/itervalidator.hpp>
@@ -18,6 +21,8 @@
 #include "stdafx.h"
 #include "serializer.hpp"
 
+#include <profiler/profiler.hpp>
+
 #include <thread>
 
 #include <base58.h>
@@ -53,7 +58,7 @@ APIHandler::APIHandler(BlockChain& blockchain, cs::SolverCore& _solver, cs::Exec
         auto nowGlobal = std::chrono::system_clock::now();
         auto lastTimePoint = nowGlobal - std::chrono::seconds(::csstats::collectionPeriods[::csstats::PeriodIndex::Month]);
 
-        for (auto time = nowGlobal; time > lastTimePoint; time -= std::chrono::seconds(::csstats::updateTimeSec)) {
+        for (auto time = nowGlobal; time > lastTimePoint; time -= std::chrono::seconds(::csstats::cutTimeSec)) {
             ::csstats::PeriodStats cut;
             cut.timeStamp = time;
             stats_.first.push_back(cut);
@@ -117,9 +122,21 @@ void APIHandlerBase::SetResponseStatus(general::APIResponse& response, bool comm
 }
 
 void APIHandler::WalletDataGet(WalletDataGetResult& _return, const general::Address& address) {
+    const cs::Sequence lastSequence = blockchain_.getLastSeq();
+    {
+        cs::ProfiledLock lock(responseCacheLock_);
+        refreshResponseCaches(lastSequence);
+        const auto it = walletDataCache_.find(address);
+        if (it != walletDataCache_.end()) {
+            _return = it->second;
+            return;
+        }
+    }
+
     const csdb::Address addr = BlockChain::getAddressFromKey(address);
     BlockChain::WalletData wallData{};
     BlockChain::WalletId wallId{};
+    cs::ProfilerSpan::addStorageCall();
     if (!blockchain_.findWalletData(addr, wallData, wallId)) {
         if (!blockchain_.findWalletData(addr, wallData)) { // **
             return;
@@ -137,6 +154,11 @@ void APIHandler::WalletDataGet(WalletDataGetResult& _return, const general::Addr
     }
 
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
+
+    cs::ProfiledLock lock(responseCacheLock_);
+    if (responseCacheSequence_ == lastSequence && walletDataCache_.size() < MaxCachedResponses) {
+        walletDataCache_[address] = _return;
+    }
 }
 
 void APIHandler::WalletIdGet(api::WalletIdGetResult& _return, const general::Address& address) {
@@ -155,6 +177,7 @@ void APIHandler::WalletIdGet(api::WalletIdGetResult& _return, const general::Add
 void APIHandler::WalletTransactionsCountGet(api::WalletTransactionsCountGetResult& _return, const general::Address& address) {
     const csdb::Address addr = BlockChain::getAddressFromKey(address);
     BlockChain::WalletData wallData{};
+    cs::ProfilerSpan::addStorageCall();
     if (!blockchain_.findWalletData(addr, wallData)) {
         SetResponseStatus(_return.status, APIRequestStatusType::NOT_FOUND);
         return;
@@ -164,18 +187,21 @@ void APIHandler::WalletTransactionsCountGet(api::WalletTransactionsCountGetResul
 }
 
 void APIHandler::WalletBalanceGet(api::WalletBalanceGetResult& _return, const general::Address& address) {
-    const csdb::Address addr = BlockChain::getAddressFromKey(address);
-    BlockChain::WalletData wallData{};
-    if (!blockchain_.findWalletData(addr, wallData)) {
-        return;
-    }
-    _return.balance.integral = wallData.balance_.integral();
-    _return.balance.fraction = static_cast<decltype(_return.balance.fraction)>(wallData.balance_.fraction());
-    std::optional<api::Delegated> delegated = getDelegated(wallData);
-    if (delegated.has_value()) {
-        _return.__set_delegated(delegated.value());
-    }
-    SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
+    walletBalanceCoalescer_.perform(address, _return, [this, &address](api::WalletBalanceGetResult& result) {
+        const csdb::Address addr = BlockChain::getAddressFromKey(address);
+        BlockChain::WalletData wallData{};
+        cs::ProfilerSpan::addStorageCall();
+        if (!blockchain_.findWalletData(addr, wallData)) {
+            return;
+        }
+        result.balance.integral = wallData.balance_.integral();
+        result.balance.fraction = static_cast<decltype(result.balance.fraction)>(wallData.balance_.fraction());
+        std::optional<api::Delegated> delegated = getDelegated(wallData);
+        if (delegated.has_value()) {
+            result.__set_delegated(delegated.value());
+        }
+        SetResponseStatus(result.status, APIRequestStatusType::SUCCESS);
+    });
 }
 
 std::string fromByteArray(const cs::Bytes& bar) {
@@ -326,22 +352,43 @@ static void fillTransInfoWithOpData(const SmartOp& op, TransInfo& ti) {
         ti.__set_stateTransaction(convert_transaction_id(op.stateTransaction));
 }
 
+csdb::Address APIHandler::AddressConversionCache::resolve(const csdb::Address& address) {
+    if (!address.is_wallet_id()) {
+        return address;
+    }
+
+    const auto id = address.wallet_id();
+    auto it = byWalletId_.find(id);
+
+    if (it == byWalletId_.end()) {
+        if (byWalletId_.size() >= kResolvedLimit) {
+            // clear() keeps the bucket array, the table refills without rehashes
+            byWalletId_.clear();
+        }
+
+        it = byWalletId_.emplace(id, blockchain_.getAddressByType(address, BlockChain::AddressType::PublicKey)).first;
+    }
+
+    return it->second;
+}
+
+APIHandler::AddressConversionCache& APIHandler::threadAddressCache() {
+    static thread_local AddressConversionCache cache(blockchain_);
+    return cache;
+}
+
 api::SealedTransaction APIHandler::convertTransaction(const csdb::Transaction& transaction) {
+    AddressConversionCache& addresses = threadAddressCache();
+    return convertTransaction(transaction, addresses);
+}
+
+api::SealedTransaction APIHandler::convertTransaction(const csdb::Transaction& transaction, AddressConversionCache& addresses) {
     using namespace cs::trx_uf;
     api::SealedTransaction result;
     const csdb::Amount amount = transaction.amount();
     csdb::Currency currency = transaction.currency();
-    csdb::Address address = transaction.source();
-
-    if (address.is_wallet_id()) {
-        address = blockchain_.getAddressByType(transaction.source(), BlockChain::AddressType::PublicKey);
-    }
-
-    csdb::Address target = transaction.target();
-
-    if (target.is_wallet_id()) {
-        target = blockchain_.getAddressByType(transaction.target(), BlockChain::AddressType::PublicKey);
-    }
+    const csdb::Address address = addresses.resolve(transaction.source());
+    const csdb::Address target = addresses.resolve(transaction.target());
 
     result.id = convert_transaction_id(transaction.id());
     result.__isset.id = true;
@@ -649,11 +696,12 @@ std::vector<api::ExtraFee> APIHandler::fillExtraFee(const csdb::Transaction& tra
 
 std::vector<api::SealedTransaction> APIHandler::convertTransactions(const std::vector<csdb::Transaction>& transactions) {
     std::vector<api::SealedTransaction> result;
-    auto size = transactions.size();
-    result.resize(size);
+    result.reserve(transactions.size());
+
+    AddressConversionCache& addresses = threadAddressCache();
 
-    for (size_t Count = 0; Count < result.size(); Count++) {
-        result[Count] = convertTransaction(transactions[Count]);
+    for (const auto& transaction : transactions) {
+        result.push_back(convertTransaction(transaction, addresses));
     }
     return result;
 }
@@ -726,10 +774,15 @@ std::vector<api::SealedTransaction> APIHandler::extractTransactions(const csdb::
         limit = transactionsCount;  // the limit is decreasing till the present transactions number
     }
 
+    result.reserve(static_cast<size_t>(limit));
+    const uint64_t blockTime = BlockChain::getBlockTime(pool);
+
+    AddressConversionCache& addresses = threadAddressCache();
+
     for (int64_t index = offset; index < (offset + limit); ++index) {
         auto tr = pool.transaction(static_cast<size_t>(index));
-        tr.set_time(BlockChain::getBlockTime(pool));
-        result.push_back(convertTransaction(tr));
+        tr.set_time(blockTime);
+        result.push_back(convertTransaction(tr, addresses));
     }
 
     return result;
@@ -859,8 +912,13 @@ csdb::Transaction APIHandler::makeTransaction(const Transaction& transaction) {
 }
 
 api::ShortTransaction APIHandler::convertTransactionToShort(csdb::Transaction tr) {
+    AddressConversionCache& addresses = threadAddressCache();
+    return convertTransactionToShort(tr, addresses);
+}
+
+api::ShortTransaction APIHandler::convertTransactionToShort(csdb::Transaction tr, AddressConversionCache& addresses) {
     api::ShortTransaction apiTr;
-    auto sTr = convertTransaction(tr);
+    auto sTr = convertTransaction(tr, addresses);
     apiTr.amount = sTr.trxn.amount;
     apiTr.currency = sTr.trxn.currency;
     apiTr.fee = sTr.trxn.fee;
@@ -881,6 +939,21 @@ std::string getDelimitedTransactionSigHex(const csdb::Transaction& tr) {
     return std::string({' '}) + cs::Utils::byteStreamToHex(bs.data(), bs.length());
 }
 
+static const char* admissionRejectMessage(cs::PacketQueue::PushResult result) {
+    switch (result) {
+        case cs::PacketQueue::PushResult::QueueFull:
+            return "transaction queue is full, resend the transaction later";
+        case cs::PacketQueue::PushResult::SourceLimitReached:
+            return "source address sends too many transactions this round, resend the transaction later";
+        case cs::PacketQueue::PushResult::FeeTooLow:
+            return "offered fee per byte is below the current admission level, resend with a higher max fee";
+        case cs::PacketQueue::PushResult::Duplicate:
+            return "the same transaction was accepted recently, duplicate is dropped";
+        default:
+            return "transaction is not accepted";
+    }
+}
+
 void APIHandler::dumbTransactionFlow(api::TransactionFlowResult& _return, const csdb::Transaction& tr) {
     //auto tr = makeTransaction(transaction);
 
@@ -891,7 +964,15 @@ void APIHandler::dumbTransactionFlow(api::TransactionFlowResult& _return, const
         return;
     }
 
-    cs::Conveyer::instance().addTransaction(tr);
+    // rejection at admission answers at once, the sender does not sit out
+    // the whole confirmation timeout
+    const auto admission = cs::Conveyer::instance().addTransaction(tr);
+
+    if (admission != cs::PacketQueue::PushResult::Added) {
+        dumbCv_.remove(tr.signature());
+        SetResponseStatus(_return.status, APIRequestStatusType::FAILURE, admissionRejectMessage(admission));
+        return;
+    }
 
     // wait for transaction in blockchain
     auto result = dumbCv_.waitCvSignal(tr.signature());
@@ -1266,7 +1347,14 @@ void APIHandler::smartTransactionFlow(api::TransactionFlowResult& _return, const
         return;
     }
 
-    cs::Conveyer::instance().addTransaction(send_transaction);
+    const auto admission = cs::Conveyer::instance().addTransaction(send_transaction);
+
+    if (admission != cs::PacketQueue::PushResult::Added) {
+        dumbCv_.remove(send_transaction.signature());
+        SetResponseStatus(_return.status, APIRequestStatusType::FAILURE, admissionRejectMessage(admission));
+        return;
+    }
+
     csdebug() << __func__ << "> transaction added";
     cs::Hash hashState;
     csdb::TransactionID newTransactionId{};
@@ -1505,10 +1593,26 @@ void APIHandler::PoolListGet(api::PoolListGetResult& _return, const int64_t offs
         return;
     }
 
+    const auto cacheKey = std::make_pair(offset, static_cast<int64_t>(limit));
+    {
+        std::unique_lock lock(responseCacheLock_);
+        refreshResponseCaches(sequence);
+        const auto it = poolListCache_.find(cacheKey);
+        if (it != poolListCache_.end()) {
+            _return = it->second;
+            return;
+        }
+    }
+
     _return.pools.reserve(limit);
 
     PoolListGetStable(_return, static_cast<int64_t>(sequence - cs::Sequence(offset)), static_cast<int64_t>(limit));
     _return.count = int32_t(sequence + 1);
+
+    std::unique_lock lock(responseCacheLock_);
+    if (responseCacheSequence_ == sequence && poolListCache_.size() < MaxCachedResponses) {
+        poolListCache_[cacheKey] = _return;
+    }
 }
 
 void APIHandler::PoolTransactionsGet(PoolTransactionsGetResult& _return, const int64_t sequence, const int64_t offset, const int64_t const_limit) {
@@ -1524,18 +1628,46 @@ void APIHandler::PoolTransactionsGet(PoolTransactionsGetResult& _return, const i
 
 void APIHandler::PoolInfoGet(PoolInfoGetResult& _return, const int64_t sequence, const int64_t index) {
     csunused(index);
-    csdb::Pool pool = executor_.loadBlockApi(cs::Sequence(sequence));
-    _return.isFound = pool.is_valid();
+    poolInfoCoalescer_.perform(sequence, _return, [this, sequence](PoolInfoGetResult& result) {
+        const cs::Sequence lastSequence = blockchain_.getLastSeq();
+        {
+            std::unique_lock lock(responseCacheLock_);
+            refreshResponseCaches(lastSequence);
+            const auto it = poolInfoCache_.find(sequence);
+            if (it != poolInfoCache_.end()) {
+                result = it->second;
+                return;
+            }
+        }
 
-    if (_return.isFound) {
-        _return.__set_pool(convertPool(pool));
-    }
+        csdb::Pool pool = executor_.loadBlockApi(cs::Sequence(sequence));
+        result.isFound = pool.is_valid();
 
-    SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
+        if (result.isFound) {
+            result.__set_pool(convertPool(pool));
+        }
+
+        SetResponseStatus(result.status, APIRequestStatusType::SUCCESS);
+
+        std::unique_lock lock(responseCacheLock_);
+        if (responseCacheSequence_ == lastSequence && poolInfoCache_.size() < MaxCachedResponses) {
+            poolInfoCache_[sequence] = result;
+        }
+    });
 }
 
 void APIHandler::StatsGet(api::StatsGetResult& _return) {
 #ifdef USE_DEPRECATED_STATS //MONITOR_NODE
+    const cs::Sequence lastSequence = blockchain_.getLastSeq();
+    {
+        std::unique_lock lock(responseCacheLock_);
+        refreshResponseCaches(lastSequence);
+        if (statsCache_.has_value()) {
+            _return = statsCache_.value();
+            return;
+        }
+    }
+
     csstats::StatsPerPeriod stats_inst = this->stats.getStats();
 
     for (auto& s : stats_inst) {
@@ -1556,6 +1688,11 @@ void APIHandler::StatsGet(api::StatsGetResult& _return) {
         _return.stats.push_back(ps);
     }
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
+
+    std::unique_lock lock(responseCacheLock_);
+    if (responseCacheSequence_ == lastSequence) {
+        statsCache_ = _return;
+    }
 #else
     SetResponseStatus(_return.status, APIRequestStatusType::NOT_IMPLEMENTED);
 #endif
@@ -1622,12 +1759,13 @@ void APIHandler::FilteredTransactionsListGet(api::FilteredTransactionsListResult
         api::PublicKeyTransactions singleResponse;
         singleResponse.requestedAddress = currentQuery.requestedAddress;
         size_t tcnt = 0;
+        AddressConversionCache& addresses = threadAddressCache();
         for (auto it : transactions) {
             ++tcnt;
             if (limit > 0) {
                 --limit;
             }
-            singleResponse.transactions.push_back(convertTransactionToShort(it));
+            singleResponse.transactions.push_back(convertTransactionToShort(it, addresses));
         }
 
         std::vector<std::tuple<csdb::Address, std::string, std::string>> tokensList;
@@ -1743,12 +1881,13 @@ void APIHandler::filteredTrxsProcess(const api::TransactionsQuery& generalQuery,
         api::PublicKeyTransactions singleResponse;
         singleResponse.requestedAddress = currentQuery.requestedAddress;
         size_t tcnt = 0;
+        AddressConversionCache& addresses = threadAddressCache();
         for (auto it : transactions) {
             ++tcnt;
             if (limit > 0) {
                 --limit;
             }
-            singleResponse.transactions.push_back(convertTransactionToShort(it));
+            singleResponse.transactions.push_back(convertTransactionToShort(it, addresses));
         }
 
         std::vector<std::tuple<csdb::Address, std::string, std::string>> tokensList;
@@ -1850,7 +1989,25 @@ void APIHandler::filteredTrxsProcess(const api::TransactionsQuery& generalQuery,
     }
 }
 
+void APIHandler::refreshResponseCaches(cs::Sequence lastSequence) {
+    if (responseCacheSequence_ != lastSequence) {
+        poolListCache_.clear();
+        poolInfoCache_.clear();
+        walletDataCache_.clear();
+        statsCache_.reset();
+        responseCacheSequence_ = lastSequence;
+    }
+}
+
 void APIHandler::store_block_slot(const csdb::Pool& pool) {
+    {
+        // cached explorer answers are stale from this block on
+        std::unique_lock lock(responseCacheLock_);
+        refreshResponseCaches(pool.sequence());
+    }
+#ifdef USE_DEPRECATED_STATS
+    stats.onStoreBlock(pool);
+#endif
     updateSmartCachesPool(pool);
 }
 
@@ -2257,7 +2414,7 @@ void APIHandler::PoolListGetStable(api::PoolListGetResult& _return, const int64_
             if (pool.is_valid()) {
                 api::Pool apiPool = convertPool(pool);
                 _return.pools.push_back(apiPool);
-                lockedPoolCache->insert(cch, std::make_pair(seq, apiPool));
+                lockedPoolCache->insert(cch, std::make_pair(seq, std::move(apiPool)));
                 if (!limSet) {
                     _return.count = int32_t(seq + 1);
                     limSet = true;
@@ -2885,6 +3042,32 @@ static std::function<bool(const T&, const T&)> getComparator(const FieldType fie
     return [field, desc](const T& lhs, const T& rhs) { return desc ? (lhs.second.*field > rhs.second.*field) : (lhs.second.*field < rhs.second.*field); };
 }
 
+// decorate-sort for the materialized TokensListGet ordering: the sort key is
+// extracted once per token instead of once per comparison, and only ids are
+// kept so the cached view stays small
+template <typename Key, typename Getter>
+static std::vector<TokenId> sortTokenIds(const TokensMap& tokens, Getter getter, const bool desc) {
+    std::vector<std::pair<Key, TokenId>> decorated;
+    decorated.reserve(tokens.size());
+
+    for (const auto& token : tokens) {
+        decorated.emplace_back(getter(token), token.first);
+    }
+
+    std::stable_sort(decorated.begin(), decorated.end(), [desc](const auto& lhs, const auto& rhs) {
+        return desc ? (rhs.first < lhs.first) : (lhs.first < rhs.first);
+    });
+
+    std::vector<TokenId> ids;
+    ids.reserve(decorated.size());
+
+    for (auto& entry : decorated) {
+        ids.push_back(entry.second);
+    }
+
+    return ids;
+}
+
 void APIHandler::TokenHoldersGet(api::TokenHoldersResult& _return, const general::Address& token, int64_t offset, int64_t limit, const TokenHoldersSortField order,
                                  const bool desc) {
     #ifndef MONITOR_NODE
@@ -2963,41 +3146,57 @@ void APIHandler::TokensListGet(api::TokensListResult& _return, int64_t offset, i
     }
 
     using VT = TokensMap::value_type;
-    std::function<bool(const VT&, const VT&)> comparator;
 
-    switch (order) {
-        case TL_Code:
-            comparator = getComparator<VT>(&Token::symbol, desc);
-            break;
-        case TL_Name:
-            comparator = getComparator<VT>(&Token::name, desc);
-            break;
-        case TL_TotalSupply:
-            comparator = [desc](const VT& lhs, const VT& rhs) { return desc ^ (stod(lhs.second.totalSupply) < stod(rhs.second.totalSupply)); };
-            break;
-        case TL_Address:
-            comparator = [desc](const VT& lhs, const VT& rhs) { return desc ^ (lhs.first < rhs.first); };
-            break;
-        case TL_HoldersCount:
-            comparator = getComparator<VT>(&Token::realHoldersCount, desc);
-            break;
-        case TL_TransfersCount:
-            comparator = getComparator<VT>(&Token::transfersCount, desc);
-            break;
-        case TL_TransactionsCount:
-            comparator = getComparator<VT>(&Token::transactionsCount, desc);
-            break;
+    const uint64_t revision = tm_.revision();
+    std::lock_guard<std::mutex> cacheLock(tokensListCacheMut_);
+
+    if (revision != tokensListRevision_ || order != tokensListOrder_ || desc != tokensListDesc_) {
+        tm_.loadTokenInfo([&](const TokensMap& tokens, const HoldersMap&) {
+            switch (order) {
+                case TL_Code:
+                    tokensListSorted_ = sortTokenIds<std::string>(tokens, [](const VT& t) { return t.second.symbol; }, desc);
+                    break;
+                case TL_Name:
+                    tokensListSorted_ = sortTokenIds<std::string>(tokens, [](const VT& t) { return t.second.name; }, desc);
+                    break;
+                case TL_TotalSupply:
+                    tokensListSorted_ = sortTokenIds<double>(tokens, [](const VT& t) { return std::strtod(t.second.totalSupply.c_str(), nullptr); }, desc);
+                    break;
+                case TL_Address:
+                    tokensListSorted_ = sortTokenIds<TokenId>(tokens, [](const VT& t) { return t.first; }, desc);
+                    break;
+                case TL_HoldersCount:
+                    tokensListSorted_ = sortTokenIds<uint64_t>(tokens, [](const VT& t) { return t.second.realHoldersCount; }, desc);
+                    break;
+                case TL_TransfersCount:
+                    tokensListSorted_ = sortTokenIds<uint64_t>(tokens, [](const VT& t) { return t.second.transfersCount; }, desc);
+                    break;
+                case TL_TransactionsCount:
+                    tokensListSorted_ = sortTokenIds<uint64_t>(tokens, [](const VT& t) { return t.second.transactionsCount; }, desc);
+                    break;
+            }
+        });
+
+        tokensListRevision_ = revision;
+        tokensListOrder_ = order;
+        tokensListDesc_ = desc;
     }
 
-    tm_.loadTokenInfo([&, comparator](const TokensMap& tm_, const HoldersMap&) {
-        _return.count = static_cast<int32_t>(tm_.size());
-        applyToSortedMap(tm_, comparator, [&](const TokensMap::value_type& t) {
-            if (--offset >= 0) {
-                return true;
+    tm_.loadTokenInfo([&](const TokensMap& tokens, const HoldersMap&) {
+        _return.count = static_cast<int32_t>(tokens.size());
+
+        // the requested page is a plain scan over the cached order; offset
+        // skips whole entries up front because the original code applied it
+        // before the filters as well
+        for (size_t i = offset < 0 ? size_t(0) : std::min(static_cast<size_t>(offset), tokensListSorted_.size()); i < tokensListSorted_.size(); ++i) {
+            const auto tIt = tokens.find(tokensListSorted_[i]);
+
+            if (tIt == tokens.end()) {
+                continue;
             }
 
             api::TokenInfo tok;
-            putTokenInfo(tok, fromByteArray(t.first.public_key()), t.second);
+            putTokenInfo(tok, fromByteArray(tIt->first.public_key()), tIt->second);
 
             // filters
             auto posName = tok.name.find(filters.name);
@@ -3012,11 +3211,9 @@ void APIHandler::TokensListGet(api::TokensListResult& _return, int64_t offset, i
                 _return.tokens.push_back(tok);
 
             if (--limit == 0)
-                return false;
-
-            return true;
-            });
-        });
+                break;
+        }
+    });
 
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
 }
@@ -3230,9 +3427,8 @@ void apiexec::APIEXECHandler::WalletBalanceGet(api::WalletBalanceGetResult& _ret
 }
 
 void apiexec::APIEXECHandler::PoolGet(PoolGetResult& _return, const int64_t sequence) {
-    auto poolBin = executor_.loadBlockApi(static_cast<cs::Sequence>(sequence)).to_binary();
-    _return.pool.reserve(poolBin.size());
-    std::copy(poolBin.begin(), poolBin.end(), std::back_inserter(_return.pool));
+    const auto poolBin = executor_.loadBlockApi(static_cast<cs::Sequence>(sequence)).to_binary();
+    _return.pool.assign(poolBin.begin(), poolBin.end());
     SetResponseStatus(_return.status, APIRequestStatusType::SUCCESS);
 }
 
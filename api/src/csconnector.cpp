@@ -9,12 +9,20 @@
 #include <thrift/protocol/TJSONProtocol.h>
 #include <thrift/transport/THttpServer.h>
 
+#ifdef API_NONBLOCKING_SERVER
+#include <thrift/concurrency/ThreadFactory.h>
+#include <thrift/concurrency/ThreadManager.h>
+#include <thrift/transport/TNonblockingServerSocket.h>
+#endif
+
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif  // _MSC_VER
 
 #include "csconnector/csconnector.hpp"
 
+#include <apiadmission.hpp>
+
 #include <csnode/configholder.hpp>
 #include <csnode/transactionspacket.hpp>
 #include <csnode/node.hpp>
@@ -43,6 +51,8 @@ connector::connector(Node& node, cs::CachesSerializationManager& serializationMa
 , api_processor(make_shared<connector::ApiProcessor>(api_handler))
 , apiexec_processor(make_shared<apiexec::APIEXECProcessor>(apiexec_handler))
 , diag_processor(make_shared<api_diag::API_DIAGProcessor>(diag_handler))
+, wallets_exporter(std::make_unique<cs::WalletsExporter>(node))
+, receipts_pusher(std::make_unique<cs::ReceiptsPusher>(node))
 , stop_flag(false)
 {
 #ifdef NODE_API
@@ -102,6 +112,11 @@ void connector::run() {
 
     using ::apache::thrift::server::TThreadedServer;
 
+    // the metrics exporter is not started here: the peer owns it and brings
+    // it up before the node is even constructed, see cs::Peer::onInit()
+    wallets_exporter->run();
+    receipts_pusher->run();
+
 #ifdef BINARY_TCP_API
    
     api_thread = std::thread([this]() {
@@ -117,6 +132,46 @@ void connector::run() {
                 }
                 continue;
             }
+#ifdef API_NONBLOCKING_SERVER
+            if (config.nonblockingServer) {
+                uint32_t workers = config.nonblockingWorkerThreads;
+                if (workers == 0) {
+                    workers = std::max(1U, std::thread::hardware_concurrency());
+                }
+                cslog() << "Starting public API on port " << api_port << " (nonblocking, " << workers << " worker threads, framed transport)";
+                auto threadManager = ::apache::thrift::concurrency::ThreadManager::newSimpleThreadManager(workers);
+                threadManager->threadFactory(make_shared<::apache::thrift::concurrency::ThreadFactory>());
+                threadManager->start();
+                nonblocking_api_server = std::make_shared<TNonblockingServer>(
+                    api_processor,
+                    make_shared<TBinaryProtocolFactory>(kStringLimit, kContainerLimit, kStrictRead, kStrictWrite),
+                    make_shared<TNonblockingServerSocket>(api_port),
+                    threadManager
+                );
+
+                try {
+                    std::shared_ptr<TNonblockingServer> srv = nonblocking_api_server;
+                    srv->serve();
+                    threadManager->stop();
+                    if (stop_flag) {
+                        cslog() << "Stop public API on port " << api_port;
+                        break;
+                    }
+                    cslog() << "Public API is trying to stop";
+                    continue;
+                }
+                catch (...) {
+                    cserror() << "Public API stopped unexpectedly";
+                    threadManager->stop();
+                }
+                // wait before restarting server
+                std::this_thread::sleep_for(std::chrono::milliseconds(kRestartThriftPause_ms));
+                if (stop_flag) {
+                    break;
+                }
+                continue;
+            }
+#endif
             cslog() << "Starting public API on port " << api_port;
             api_server = std::make_shared<TThreadedServer>(
                 api_processor,
@@ -128,6 +183,13 @@ void connector::run() {
 #ifdef PROFILE_API
             cs::ProfilerFileLogger::bufferSize = 1000;
             api_server->setServerEventHandler(make_shared<cs::ProfilerEventHandler>());
+#else
+            if (config.maxConnectionsPerIp > 0 || config.maxRequestsPerSecondPerIp > 0) {
+                cslog() << "Public API admission is on: " << config.maxConnectionsPerIp << " connection(s), "
+                        << config.maxRequestsPerSecondPerIp << " request(s)/s per client address";
+                auto admission = std::make_shared<cs::ApiAdmissionController>(config.maxConnectionsPerIp, config.maxRequestsPerSecondPerIp);
+                api_server->setServerEventHandler(make_shared<cs::ApiAdmissionHandler>(admission));
+            }
 #endif
 
             try {
@@ -257,6 +319,13 @@ void connector::stop() {
     stop_flag = true;
 
 #ifdef BINARY_TCP_API
+#ifdef API_NONBLOCKING_SERVER
+    if (nonblocking_api_server) {
+        cslog() << "API: stop public API";
+        nonblocking_api_server->stop();
+        nonblocking_api_server.reset();
+    }
+#endif
     if (api_server) {
         cslog() << "API: stop public API";
         api_server->stop();
@@ -302,14 +371,25 @@ void connector::stop() {
        diag_thread.join();
     }
 
+    if (wallets_exporter) {
+        cslog() << "API: stop wallets exporter";
+        wallets_exporter->stop();
+    }
+
+    if (receipts_pusher) {
+        cslog() << "API: stop receipts pusher";
+        receipts_pusher->stop();
+    }
 }
 
 void connector::onPacketExpired(const cs::TransactionsPacket& packet) {
     api_handler->onPacketExpired(packet);
+    receipts_pusher->onPacketExpired(packet);
 }
 
 void connector::onTransactionsRejected(const cs::TransactionsPacket& packet) {
     api_handler->onTransactionsRejected(packet);
+    receipts_pusher->onTransactionsRejected(packet);
 }
 
 connector::ApiHandlerPtr connector::apiHandler() const {
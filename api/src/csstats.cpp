@@ -18,6 +18,32 @@ void csstats::matchPeriod(const Periods& periods, period_t period, F func) {
     }
 }
 
+void csstats::accumulate(PeriodStats& periodStats, const csdb::Pool& pool) {
+    periodStats.poolsCount++;
+    std::size_t transactionsCount = pool.transactions_count();
+    periodStats.transactionsCount += static_cast<uint32_t>(transactionsCount);
+
+    for (std::size_t i = 0; i < transactionsCount; ++i) {
+        const auto& transaction = pool.transaction(csdb::TransactionID(pool.sequence(), i));
+#ifdef MONITOR_NODE
+        if (is_smart(transaction) || is_smart_state(transaction))
+            ++periodStats.transactionsSmartCount;
+#endif
+        if (is_deploy_transaction(transaction))
+            ++periodStats.smartContractsCount;
+
+        Currency currency = currencies_indexed[transaction.currency().to_string()];
+        const auto& amount = transaction.amount();
+        periodStats.balancePerCurrency[currency].integral += amount.integral();
+        periodStats.balancePerCurrency[currency].fraction += amount.fraction();
+    }
+}
+
+void csstats::onStoreBlock(const csdb::Pool& pool) {
+    ScopedLock lock(pendingCutMutex);
+    accumulate(pendingCut, pool);
+}
+
 StatsPerPeriod csstats::collectStats(const Periods& periods) {
     assert(std::is_sorted(std::begin(periods), std::end(periods), [](const Period& l, const Period& r) { return l < r; }));
 
@@ -25,44 +51,16 @@ StatsPerPeriod csstats::collectStats(const Periods& periods) {
 
     auto stats = currentStats;
     auto startTime = std::chrono::high_resolution_clock::now();
-    auto blockHash = blockchain.getLastHash();
-
-	static auto lastHash = blockHash;
 
+    // blocks arrive through onStoreBlock(), so the cycle only merges what was
+    // accumulated since the previous one and never re-reads the chain
     PeriodStats periodStats;
-    periodStats.timeStamp = std::chrono::system_clock::now();
-
     {
-        auto future_last_hash = blockHash;
-
-        if (blockHash.is_empty()) {
-            cserror() << "Stats: no bricks in the wall (last hash is empty)";
-        }
-
-        while (blockHash != lastHash && !blockHash.is_empty()) {
-            csdb::Pool pool = blockchain.loadBlock(blockHash);
-            periodStats.poolsCount++;
-            std::size_t transactionsCount = pool.transactions_count();
-            periodStats.transactionsCount += static_cast<uint32_t>(transactionsCount);
-
-            for (std::size_t i = 0; i < transactionsCount; ++i) {
-                const auto& transaction = pool.transaction(csdb::TransactionID(pool.sequence(), i));
-#ifdef MONITOR_NODE
-                if (is_smart(transaction) || is_smart_state(transaction))
-                    ++periodStats.transactionsSmartCount;
-#endif
-                if (is_deploy_transaction(transaction))
-                    ++periodStats.smartContractsCount;
-
-                Currency currency = currencies_indexed[transaction.currency().to_string()];
-                const auto& amount = transaction.amount();
-                periodStats.balancePerCurrency[currency].integral += amount.integral();
-                periodStats.balancePerCurrency[currency].fraction += amount.fraction();
-            }
-            blockHash = pool.previous_hash();
-        }
-        lastHash = future_last_hash;
+        ScopedLock lock(pendingCutMutex);
+        periodStats = std::move(pendingCut);
+        pendingCut = PeriodStats{};
     }
+    periodStats.timeStamp = std::chrono::system_clock::now();
 
     // total
     auto& total = stats[PeriodIndex::Total];
@@ -76,45 +74,68 @@ StatsPerPeriod csstats::collectStats(const Periods& periods) {
         total.balancePerCurrency[element.first].fraction += element.second.fraction;
     }
 
+    // fresh blocks belong to every sliding window
     for (size_t i = 0; i < periods.size(); ++i) {
-        assert(updateTimeSec != 0);
+        auto& stat = stats.at(i);
 
-        std::size_t index = (periods[i] / updateTimeSec) - 1;
+        stat.poolsCount += periodStats.poolsCount;
+        stat.smartContractsCount += periodStats.smartContractsCount;
+        stat.transactionsCount += periodStats.transactionsCount;
+        stat.transactionsSmartCount += periodStats.transactionsSmartCount;
 
-        try {
-            auto& lastPeriodStats = statsCut.at(index);
-            auto& stat = stats.at(i);
+        for (auto& element : periodStats.balancePerCurrency) {
+            stat.balancePerCurrency[element.first].integral += element.second.integral;
+            stat.balancePerCurrency[element.first].fraction += element.second.fraction;
+        }
+    }
 
-            // remove last stats
-            stat.poolsCount -= lastPeriodStats.poolsCount;
-            stat.smartContractsCount -= lastPeriodStats.smartContractsCount;
-            stat.transactionsCount -= lastPeriodStats.transactionsCount;
-            stat.transactionsSmartCount -= lastPeriodStats.transactionsSmartCount;
+    // the in-progress cut of the current ring slot
+    currentCut.poolsCount += periodStats.poolsCount;
+    currentCut.smartContractsCount += periodStats.smartContractsCount;
+    currentCut.transactionsCount += periodStats.transactionsCount;
+    currentCut.transactionsSmartCount += periodStats.transactionsSmartCount;
 
-            for (auto& element : lastPeriodStats.balancePerCurrency) {
-                stat.balancePerCurrency[element.first].integral -= element.second.integral;
-                stat.balancePerCurrency[element.first].fraction -= element.second.fraction;
-            }
+    for (auto& element : periodStats.balancePerCurrency) {
+        currentCut.balancePerCurrency[element.first].integral += element.second.integral;
+        currentCut.balancePerCurrency[element.first].fraction += element.second.fraction;
+    }
+
+    // once per cutTimeSec the completed cut enters the ring and the cut that
+    // leaves each window is subtracted
+    if (periodStats.timeStamp >= nextRotation) {
+        for (size_t i = 0; i < periods.size(); ++i) {
+            assert(cutTimeSec != 0);
 
-            // add new stats
-            stat.poolsCount += periodStats.poolsCount;
-            stat.smartContractsCount += periodStats.smartContractsCount;
-            stat.transactionsCount += periodStats.transactionsCount;
-            stat.transactionsSmartCount += periodStats.transactionsSmartCount;
+            std::size_t index = (periods[i] / cutTimeSec) - 1;
 
-            for (auto& element : periodStats.balancePerCurrency) {
-                stat.balancePerCurrency[element.first].integral += element.second.integral;
-                stat.balancePerCurrency[element.first].fraction += element.second.fraction;
+            try {
+                auto& lastPeriodStats = statsCut.at(index);
+                auto& stat = stats.at(i);
+
+                // remove last stats
+                stat.poolsCount -= lastPeriodStats.poolsCount;
+                stat.smartContractsCount -= lastPeriodStats.smartContractsCount;
+                stat.transactionsCount -= lastPeriodStats.transactionsCount;
+                stat.transactionsSmartCount -= lastPeriodStats.transactionsSmartCount;
+
+                for (auto& element : lastPeriodStats.balancePerCurrency) {
+                    stat.balancePerCurrency[element.first].integral -= element.second.integral;
+                    stat.balancePerCurrency[element.first].fraction -= element.second.fraction;
+                }
+            }
+            catch (const std::exception& e) {
+                cslog() << "STATS> " << e.what();
             }
         }
-        catch (const std::exception& e) {
-            cslog() << "STATS> " << e.what();
-        }
-    }
 
-    // update cuts
-    statsCut.push_front(periodStats);
-    statsCut.pop_back();
+        // update cuts
+        currentCut.timeStamp = periodStats.timeStamp;
+        statsCut.push_front(currentCut);
+        statsCut.pop_back();
+
+        currentCut = PeriodStats{};
+        nextRotation += std::chrono::seconds(cutTimeSec);
+    }
 
     auto finishTime = std::chrono::high_resolution_clock::now();
 
@@ -277,6 +298,7 @@ void csstats::run(const ::csstats::AllStats& allStats) {
 
         currentStats = std::move(allStats.second);
         statsCut = std::move(allStats.first);
+        nextRotation = std::chrono::system_clock::now() + std::chrono::seconds(cutTimeSec);
 
         assert(currentStats.size() == collectionPeriods.size());
 
@@ -1,20 +1,29 @@
 #include <dumbcv.hpp>
 
 bool cs::DumbCv::addCVInfo(const cs::Signature& signature) {
-    cs::Lock lock(mutex_);
+    auto& s = shard(signature);
+    cs::Lock lock(s.mutex);
 
-    if (const auto& it = cvInfo_.find(signature); it != cvInfo_.end()) {
+    if (const auto& it = s.cvInfo.find(signature); it != s.cvInfo.end()) {
         return false;
     }
 
-    cvInfo_[signature];
+    s.cvInfo[signature];
     return true;
 }
 
+void cs::DumbCv::remove(const cs::Signature& signature) {
+    auto& s = shard(signature);
+    cs::Lock lock(s.mutex);
+
+    s.cvInfo.erase(signature);
+}
+
 void cs::DumbCv::sendCvSignal(const cs::Signature& signature, Condition condition, const csdb::TransactionID& id, const csdb::Amount fee) {
-    cs::Lock lock(mutex_);
+    auto& s = shard(signature);
+    cs::Lock lock(s.mutex);
 
-    if (auto it = cvInfo_.find(signature); it != cvInfo_.end()) {
+    if (auto it = s.cvInfo.find(signature); it != s.cvInfo.end()) {
         auto& [cv, flag, cond, i, f] = it->second;
         cond = condition;
         flag = true;
@@ -28,9 +37,10 @@ cs::DumbCv::Result cs::DumbCv::waitCvSignal(const cs::Signature& signature) {
     Result result;
     result.condition = cs::DumbCv::Condition::TimeOut;
 
-    std::unique_lock lock(mutex_);
+    auto& s = shard(signature);
+    std::unique_lock lock(s.mutex);
 
-    if (auto it = cvInfo_.find(signature); it != cvInfo_.end()) {
+    if (auto it = s.cvInfo.find(signature); it != s.cvInfo.end()) {
         it->second.cv.wait_for(lock, std::chrono::seconds(kWaitTimeSec), [it]() -> bool {
             return it->second.condFlg;
         });
@@ -41,7 +51,7 @@ cs::DumbCv::Result cs::DumbCv::waitCvSignal(const cs::Signature& signature) {
             result.fee = it->second.fee;
         }
 
-        cvInfo_.erase(signature);
+        s.cvInfo.erase(signature);
     }
 
     return result;
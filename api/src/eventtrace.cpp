@@ -0,0 +1,182 @@
+#include <eventtrace.hpp>
+
+#include <algorithm>
+
+namespace {
+constexpr cs::Byte kMagic0 = cs::Byte('E');
+constexpr cs::Byte kMagic1 = cs::Byte('T');
+constexpr cs::Byte kVersion = cs::Byte(1);
+
+void putVarint(cs::Bytes& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(cs::Byte((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(cs::Byte(value));
+}
+
+void putZigzag(cs::Bytes& out, int64_t value) {
+    putVarint(out, (uint64_t(value) << 1) ^ uint64_t(value >> 63));
+}
+
+bool getVarint(const cs::Byte*& ptr, const cs::Byte* end, uint64_t& value) {
+    value = 0;
+    unsigned shift = 0;
+
+    while (ptr != end && shift < 64) {
+        const cs::Byte byte = *ptr++;
+        value |= uint64_t(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+
+        shift += 7;
+    }
+
+    return false;
+}
+
+bool getZigzag(const cs::Byte*& ptr, const cs::Byte* end, int64_t& value) {
+    uint64_t raw = 0;
+
+    if (!getVarint(ptr, end, raw)) {
+        return false;
+    }
+
+    value = int64_t(raw >> 1) ^ -int64_t(raw & 1);
+    return true;
+}
+}  // namespace
+
+namespace cs {
+void EventTraceEncoder::append(const EventTraceRecord& record) {
+    auto [iterator, inserted] = senderIndex_.emplace(record.sender, senders_.size());
+
+    if (inserted) {
+        senders_.push_back(record.sender);
+    }
+
+    body_.push_back(cs::Byte(record.id));
+    putVarint(body_, iterator->second);
+    putZigzag(body_, int64_t(record.round) - int64_t(previousRound_));
+    putZigzag(body_, int64_t(record.senderLastBlock) - int64_t(previousLastBlock_));
+    putVarint(body_, record.payload.size());
+    body_.insert(body_.end(), record.payload.begin(), record.payload.end());
+
+    previousRound_ = record.round;
+    previousLastBlock_ = record.senderLastBlock;
+    ++recordsCount_;
+}
+
+cs::Bytes EventTraceEncoder::seal() {
+    cs::Bytes frame;
+    frame.reserve(3 + senders_.size() * sizeof(cs::PublicKey) + body_.size() + 10);
+
+    frame.push_back(kMagic0);
+    frame.push_back(kMagic1);
+    frame.push_back(kVersion);
+
+    putVarint(frame, senders_.size());
+
+    for (const auto& sender : senders_) {
+        frame.insert(frame.end(), sender.begin(), sender.end());
+    }
+
+    putVarint(frame, recordsCount_);
+    frame.insert(frame.end(), body_.begin(), body_.end());
+
+    body_.clear();
+    senders_.clear();
+    senderIndex_.clear();
+    recordsCount_ = 0;
+    previousRound_ = 0;
+    previousLastBlock_ = 0;
+
+    return frame;
+}
+
+bool EventTraceDecoder::decode(const cs::Bytes& frame, std::vector<EventTraceRecord>& records) {
+    const cs::Byte* ptr = frame.data();
+    const cs::Byte* end = ptr + frame.size();
+
+    if (end - ptr < 3 || ptr[0] != kMagic0 || ptr[1] != kMagic1 || ptr[2] != kVersion) {
+        return false;
+    }
+
+    ptr += 3;
+
+    uint64_t senderCount = 0;
+    if (!getVarint(ptr, end, senderCount)) {
+        return false;
+    }
+
+    if (uint64_t(end - ptr) / sizeof(cs::PublicKey) < senderCount) {
+        return false;
+    }
+
+    std::vector<cs::PublicKey> senders(size_t(senderCount));
+
+    for (auto& sender : senders) {
+        std::copy(ptr, ptr + sender.size(), sender.begin());
+        ptr += sender.size();
+    }
+
+    uint64_t recordCount = 0;
+    if (!getVarint(ptr, end, recordCount)) {
+        return false;
+    }
+
+    std::vector<EventTraceRecord> result;
+    result.reserve(size_t(std::min<uint64_t>(recordCount, uint64_t(end - ptr))));
+
+    int64_t round = 0;
+    int64_t lastBlock = 0;
+
+    for (uint64_t i = 0; i < recordCount; ++i) {
+        if (ptr == end) {
+            return false;
+        }
+
+        EventTraceRecord record;
+        record.id = uint8_t(*ptr++);
+
+        uint64_t senderIndex = 0;
+        int64_t roundDelta = 0;
+        int64_t lastBlockDelta = 0;
+        uint64_t payloadSize = 0;
+
+        if (!getVarint(ptr, end, senderIndex) || senderIndex >= senders.size()) {
+            return false;
+        }
+        if (!getZigzag(ptr, end, roundDelta) || !getZigzag(ptr, end, lastBlockDelta)) {
+            return false;
+        }
+        if (!getVarint(ptr, end, payloadSize) || payloadSize > uint64_t(end - ptr)) {
+            return false;
+        }
+
+        round += roundDelta;
+        lastBlock += lastBlockDelta;
+
+        if (round < 0 || lastBlock < 0) {
+            return false;
+        }
+
+        record.sender = senders[size_t(senderIndex)];
+        record.round = cs::RoundNumber(round);
+        record.senderLastBlock = cs::Sequence(lastBlock);
+        record.payload.assign(ptr, ptr + payloadSize);
+        ptr += payloadSize;
+
+        result.push_back(std::move(record));
+    }
+
+    if (ptr != end) {
+        return false;
+    }
+
+    records = std::move(result);
+    return true;
+}
+}  // namespace cs
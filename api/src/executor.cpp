@@ -10,10 +10,18 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+
 #include "serializer.hpp"
 
+#include <cscrypto/cscrypto.hpp>
 #include <csnode/configholder.hpp>
 
+// contract byte code and state blobs routinely reach several megabytes, the
+// default 512-byte transport buffer would push them through the socket in
+// thousands of tiny writes
+static constexpr uint32_t kExecutorTransportBufferSize = 1 << 20;
+
 #include <solver/solvercore.hpp>
 #include <solver/smartcontracts.hpp>
 
@@ -35,9 +43,6 @@ cs::ExecutorSettings::Types cs::ExecutorSettings::get() {
 void cs::Executor::executeByteCode(executor::ExecuteByteCodeResult& resp, const std::string& address, const std::string& smart_address,
                                    const std::vector<general::ByteCodeObject>& code, const std::string& state,
                                    std::vector<executor::MethodHeader>& methodHeader, bool isGetter, cs::Sequence sequence) {
-    static std::mutex mutex;
-    std::lock_guard lock(mutex);  // temporary solution
-
     if (!code.empty()) {
         executor::SmartContractBinary smartContractBinary;
         smartContractBinary.contractAddress = smart_address;
@@ -92,27 +97,65 @@ void cs::Executor::executeByteCodeMultiple(executor::ExecuteByteCodeMultipleResu
 }
 
 void cs::Executor::getContractMethods(executor::GetContractMethodsResult& _return, const std::vector<general::ByteCodeObject>& byteCodeObjects) {
-    try {
-        std::shared_lock lock(sharedErrorMutex_);
-        origExecutor_->getContractMethods(_return, byteCodeObjects, EXECUTOR_VERSION);
+    // identical byte code always yields identical methods, so compile-checks
+    // of mass deploys (token factories) hit the cache instead of the executor
+    cs::Bytes codeBlob;
+
+    for (const auto& object : byteCodeObjects) {
+        codeBlob.insert(codeBlob.end(), object.name.begin(), object.name.end());
+        codeBlob.insert(codeBlob.end(), object.byteCode.begin(), object.byteCode.end());
     }
-    catch (const ::apache::thrift::transport::TTransportException& x) {
-        // sets stop_ flag to true forever, replace with new instance
-        if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
-        }
 
-        _return.status.code = 1;
-        _return.status.message = x.what();
+    const cs::Hash key = cscrypto::calculateHash(codeBlob.data(), codeBlob.size());
 
-        notifyError();
-    }
-    catch(const std::exception& x ) {
-        _return.status.code = 1;
-        _return.status.message = x.what();
+    {
+        std::lock_guard lock(contractMethodsCacheMutex_);
+        const auto it = contractMethodsCache_.find(key);
 
-        notifyError();
+        if (it != contractMethodsCache_.end()) {
+            _return = it->second;
+            return;
+        }
     }
+
+    // concurrent validations of the same byte code share one executor call
+    contractMethodsCoalescer_.perform(key, _return, [this, &byteCodeObjects, &key](executor::GetContractMethodsResult& result) {
+        try {
+            std::shared_lock lock(sharedErrorMutex_);
+            origExecutor_->getContractMethods(result, byteCodeObjects, EXECUTOR_VERSION);
+        }
+        catch (const ::apache::thrift::transport::TTransportException& x) {
+            // sets stop_ flag to true forever, replace with new instance
+            if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
+                recreateOriginExecutor();
+            }
+
+            result.status.code = 1;
+            result.status.message = x.what();
+
+            notifyError();
+            return;
+        }
+        catch(const std::exception& x ) {
+            result.status.code = 1;
+            result.status.message = x.what();
+
+            notifyError();
+            return;
+        }
+
+        // only successful verdicts are remembered, transient executor
+        // failures stay retryable
+        if (result.status.code == 0) {
+            std::lock_guard lock(contractMethodsCacheMutex_);
+
+            if (contractMethodsCache_.size() >= kContractMethodsCacheLimit) {
+                contractMethodsCache_.clear();
+            }
+
+            contractMethodsCache_.emplace(key, result);
+        }
+    });
 }
 
 void cs::Executor::getContractVariables(executor::GetContractVariablesResult& _return, const std::vector<general::ByteCodeObject>& byteCodeObjects, const std::string& contractState) {
@@ -352,6 +395,8 @@ std::optional<cs::Executor::ExecuteResult> cs::Executor::executeTransaction(cons
     auto smartSource = blockchain_.getAddressByType(source, BlockChain::AddressType::PublicKey);
     auto smartTarget = blockchain_.getAddressByType(target, BlockChain::AddressType::PublicKey);
 
+    recordExecution(smartTarget);
+
     // get deploy transaction
     const auto isdeploy = (headTransaction.id() == deployTrxn.id()); //isDeploy(head_transaction);
 
@@ -496,6 +541,8 @@ std::optional<cs::Executor::ExecuteResult> cs::Executor::reexecuteContract(cs::E
     auto smartSource = blockchain_.getAddressByType(contract.transaction.source(), BlockChain::AddressType::PublicKey);
     auto smartTarget = blockchain_.getAddressByType(contract.transaction.target(), BlockChain::AddressType::PublicKey);
 
+    recordExecution(smartTarget);
+
     // get deploy transaction
     const csdb::Transaction& deployTrxn = contract.deploy;
     const auto isdeploy = (contract.deploy.id() == contract.transaction.id()); // isDeploy(contract.transaction);
@@ -787,6 +834,97 @@ void cs::Executor::checkExecutorVersion() {
 
         cs::Concurrent::run(cs::ConcurrentPolicy::Thread, terminate);
     }
+    else {
+        // the executor came up with an acceptable version, push the hottest
+        // bytecodes through it before user traffic arrives
+        cs::Concurrent::run(cs::ConcurrentPolicy::Thread, [this] {
+            warmUpContracts();
+        });
+    }
+}
+
+void cs::Executor::recordExecution(const csdb::Address& address) {
+    std::lock_guard lock(executionCountsMutex_);
+    ++executionCounts_[address];
+}
+
+void cs::Executor::warmUpContracts() {
+    std::vector<std::pair<uint64_t, csdb::Address>> ranked;
+
+    {
+        std::lock_guard lock(executionCountsMutex_);
+        ranked.reserve(executionCounts_.size());
+
+        for (const auto& [address, count] : executionCounts_) {
+            ranked.emplace_back(count, address);
+        }
+    }
+
+    if (ranked.empty()) {
+        return;
+    }
+
+    const size_t limit = std::min(ranked.size(), kWarmUpContractsLimit);
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(limit), ranked.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    size_t warmed = 0;
+
+    for (size_t index = 0; index < limit; ++index) {
+        if (requestStop_ || !isConnected()) {
+            return;
+        }
+
+        const csdb::Address& address = ranked[index].second;
+        const auto deployId = getDeployTrxn(address);
+
+        if (!deployId.has_value()) {
+            continue;
+        }
+
+        const csdb::Transaction deployTrxn = loadTransactionApi(deployId.value());
+
+        if (!deployTrxn.is_valid() || !deployTrxn.user_field(cs::trx_uf::deploy::Code).is_valid()) {
+            continue;
+        }
+
+        const auto sci = cs::Serializer::deserialize<api::SmartContractInvocation>(deployTrxn.user_field(cs::trx_uf::deploy::Code).value<std::string>());
+
+        if (sci.smartContractDeploy.byteCodeObjects.empty()) {
+            continue;
+        }
+
+        // raw call on purpose: the local methods cache survives executor
+        // restarts, the point here is to make the fresh JVM load the classes
+        executor::GetContractMethodsResult result;
+
+        try {
+            std::shared_lock lock(sharedErrorMutex_);
+            origExecutor_->getContractMethods(result, sci.smartContractDeploy.byteCodeObjects, EXECUTOR_VERSION);
+        }
+        catch (const ::apache::thrift::transport::TTransportException& x) {
+            // sets stop_ flag to true forever, replace with new instance
+            if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
+                recreateOriginExecutor();
+            }
+
+            csdebug() << csname() << "contract warm-up stopped: " << x.what();
+            return;
+        }
+        catch (const std::exception& x) {
+            csdebug() << csname() << "contract warm-up stopped: " << x.what();
+            return;
+        }
+
+        if (result.status.code == 0) {
+            ++warmed;
+        }
+    }
+
+    if (warmed != 0) {
+        cslog() << csname() << "executor warm-up done, " << warmed << " contract bytecodes preloaded";
+    }
 }
 
 cs::Executor::Executor(const cs::ExecutorSettings::Types& types)
@@ -794,10 +932,28 @@ cs::Executor::Executor(const cs::ExecutorSettings::Types& types)
 , solver_(std::get<cs::Reference<const cs::SolverCore>>(types))
 , socket_(::apache::thrift::stdcxx::make_shared<::apache::thrift::transport::TSocket>(cs::ConfigHolder::instance().config()->getApiSettings().executorHost,
                                                                                       cs::ConfigHolder::instance().config()->getApiSettings().executorPort))
-, executorTransport_(new ::apache::thrift::transport::TBufferedTransport(socket_))
+, executorTransport_(new ::apache::thrift::transport::TBufferedTransport(socket_, kExecutorTransportBufferSize))
 , origExecutor_(std::make_unique<executor::ContractExecutorConcurrentClient>(::apache::thrift::stdcxx::make_shared<apache::thrift::protocol::TBinaryProtocol>(executorTransport_))) {
     socket_->setSendTimeout(cs::ConfigHolder::instance().config()->getApiSettings().executorSendTimeout);
     socket_->setRecvTimeout(cs::ConfigHolder::instance().config()->getApiSettings().executorReceiveTimeout);
+    socket_->setNoDelay(true);
+
+    int getterConnections = cs::ConfigHolder::instance().config()->getApiSettings().executorGetterConnections;
+    if (getterConnections > 16) {
+        getterConnections = 16;
+    }
+
+    for (int i = 0; i < getterConnections; ++i) {
+        auto connection = std::make_unique<GetterConnection>();
+        connection->socket = ::apache::thrift::stdcxx::make_shared<::apache::thrift::transport::TSocket>(cs::ConfigHolder::instance().config()->getApiSettings().executorHost,
+                                                                                                         cs::ConfigHolder::instance().config()->getApiSettings().executorPort);
+        connection->socket->setSendTimeout(cs::ConfigHolder::instance().config()->getApiSettings().executorSendTimeout);
+        connection->socket->setRecvTimeout(cs::ConfigHolder::instance().config()->getApiSettings().executorReceiveTimeout);
+        connection->socket->setNoDelay(true);
+        connection->transport.reset(new ::apache::thrift::transport::TBufferedTransport(connection->socket, kExecutorTransportBufferSize));
+        connection->client = std::make_unique<OriginExecutor>(::apache::thrift::stdcxx::make_shared<BinaryProtocol>(connection->transport));
+        getterConnections_.push_back(std::move(connection));
+    }
 
     commitMin_ = cs::ConfigHolder::instance().config()->getApiSettings().executorCommitMin;
     commitMax_ = cs::ConfigHolder::instance().config()->getApiSettings().executorCommitMax;
@@ -930,19 +1086,37 @@ std::optional<cs::Executor::OriginExecuteResult> cs::Executor::execute(const std
         accessId = generateAccessId(explicitSequence, time);
     }
 
+    // read-only executions take the fast lane: a dedicated connection from the
+    // getter pool, so they do not queue behind consensus executions
+    GetterConnection* connection = isGetter ? acquireGetterConnection() : nullptr;
+
     ++execCount_;
 
     const auto timeBeg = std::chrono::steady_clock::now();
 
     try {
-        std::shared_lock sharedLock(sharedErrorMutex_);
-        std::lock_guard lock(callExecutorLock_);
-        origExecutor_->executeByteCode(originExecuteRes.resp, static_cast<general::AccessID>(accessId), address, smartContractBinary, methodHeader, EXECUTION_TIME, EXECUTOR_VERSION);
+        // no exclusive lock here: the concurrent client multiplexes parallel
+        // calls over one connection (responses are matched by seqid), so
+        // independent contracts execute in the Java executor simultaneously;
+        // conflicting contracts are kept apart by the exe_queue address locks
+        if (connection != nullptr) {
+            std::shared_lock sharedLock(connection->errorMutex);
+            connection->client->executeByteCode(originExecuteRes.resp, static_cast<general::AccessID>(accessId), address, smartContractBinary, methodHeader, EXECUTION_TIME, EXECUTOR_VERSION);
+        }
+        else {
+            std::shared_lock sharedLock(sharedErrorMutex_);
+            origExecutor_->executeByteCode(originExecuteRes.resp, static_cast<general::AccessID>(accessId), address, smartContractBinary, methodHeader, EXECUTION_TIME, EXECUTOR_VERSION);
+        }
     }
     catch (::apache::thrift::transport::TTransportException& x) {
         // sets stop_ flag to true forever, replace with new instance
         if (x.getType() == ::apache::thrift::transport::TTransportException::NOT_OPEN) {
-            recreateOriginExecutor();
+            if (connection != nullptr) {
+                recreateGetterClient(*connection);
+            }
+            else {
+                recreateOriginExecutor();
+            }
         }
 
         if (x.getType() == ::apache::thrift::transport::TTransportException::TIMED_OUT) {
@@ -953,13 +1127,19 @@ std::optional<cs::Executor::OriginExecuteResult> cs::Executor::execute(const std
         }
         originExecuteRes.resp.status.message = x.what();
 
-        notifyError();
+        // a failed getter connection is reopened on next acquire and must not
+        // tear down the main connection shared with consensus executions
+        if (connection == nullptr) {
+            notifyError();
+        }
     }
     catch (std::exception& x) {
         originExecuteRes.resp.status.code = cs::error::StdException;
         originExecuteRes.resp.status.message = x.what();
 
-        notifyError();
+        if (connection == nullptr) {
+            notifyError();
+        }
     }
 
     originExecuteRes.timeExecute = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - timeBeg).count();
@@ -991,6 +1171,14 @@ void cs::Executor::disconnect() {
     catch (::apache::thrift::transport::TTransportException&) {
         notifyError();
     }
+
+    for (auto& connection : getterConnections_) {
+        try {
+            connection->transport->close();
+        }
+        catch (::apache::thrift::transport::TTransportException&) {
+        }
+    }
 }
 
 void cs::Executor::notifyError() {
@@ -1006,3 +1194,39 @@ void cs::Executor::recreateOriginExecutor() {
     disconnect();
     origExecutor_.reset(new executor::ContractExecutorConcurrentClient(::apache::thrift::stdcxx::make_shared<apache::thrift::protocol::TBinaryProtocol>(executorTransport_)));
 }
+
+cs::Executor::GetterConnection* cs::Executor::acquireGetterConnection() {
+    if (getterConnections_.empty()) {
+        return nullptr;
+    }
+
+    GetterConnection* connection = getterConnections_[nextGetterConnection_.fetch_add(1) % getterConnections_.size()].get();
+
+    if (!connection->transport->isOpen()) {
+        std::lock_guard lock(connection->errorMutex);
+
+        if (!connection->transport->isOpen()) {
+            try {
+                connection->transport->open();
+            }
+            catch (...) {
+                // fall back to the main connection
+                return nullptr;
+            }
+        }
+    }
+
+    return connection;
+}
+
+void cs::Executor::recreateGetterClient(GetterConnection& connection) {
+    std::lock_guard lock(connection.errorMutex);
+
+    try {
+        connection.transport->close();
+    }
+    catch (::apache::thrift::transport::TTransportException&) {
+    }
+
+    connection.client.reset(new OriginExecutor(::apache::thrift::stdcxx::make_shared<BinaryProtocol>(connection.transport)));
+}
@@ -0,0 +1,173 @@
+#include <metricsexporter.hpp>
+
+#include <chrono>
+
+#include <boost/asio.hpp>
+
+#include <csnode/blockchain.hpp>
+#include <csnode/configholder.hpp>
+#include <csnode/conveyer.hpp>
+#include <csnode/node.hpp>
+
+#include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
+
+namespace cs {
+class MetricsExporter::Impl {
+public:
+    boost::asio::io_context context;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+};
+
+MetricsExporter::MetricsExporter()
+: impl_(std::make_unique<Impl>()) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+void MetricsExporter::attachNode(Node& node) {
+    node_.store(&node, std::memory_order_release);
+}
+
+void MetricsExporter::run() {
+    const uint16_t port = cs::ConfigHolder::instance().config()->getApiSettings().metricsPort;
+
+    if (port == 0) {
+        cslog() << "Metrics exporter is disabled ([api] metrics_port = 0)";
+        return;
+    }
+
+    stopFlag_.store(false, std::memory_order_release);
+    thread_ = std::thread(&MetricsExporter::serverRoutine, this, port);
+}
+
+void MetricsExporter::stop() {
+    stopFlag_.store(true, std::memory_order_release);
+
+    if (impl_->acceptor) {
+        boost::system::error_code ignored;
+        impl_->acceptor->close(ignored);
+    }
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void MetricsExporter::serverRoutine(uint16_t port) {
+    using boost::asio::ip::tcp;
+
+    try {
+        impl_->acceptor = std::make_unique<tcp::acceptor>(impl_->context, tcp::endpoint(tcp::v4(), port));
+    }
+    catch (const std::exception& e) {
+        cserror() << "Metrics exporter can not listen on port " << port << ": " << e.what();
+        return;
+    }
+
+    cslog() << "Metrics exporter started on port " << port;
+
+    while (!stopFlag_.load(std::memory_order_acquire)) {
+        boost::system::error_code error;
+        tcp::socket socket(impl_->context);
+
+        impl_->acceptor->accept(socket, error);
+
+        if (error) {
+            // closed by stop() or a transient failure
+            if (!stopFlag_.load(std::memory_order_acquire)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            continue;
+        }
+
+        std::string body;
+
+        try {
+            body = render();
+        }
+        catch (const std::exception& e) {
+            cswarning() << "Metrics exporter render failed: " << e.what();
+            continue;
+        }
+
+        // the request itself is not parsed, every connection gets the full dump
+        const std::string response = "HTTP/1.0 200 OK\r\n"
+                                     "Content-Type: text/plain; version=0.0.4\r\n"
+                                     "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                                     "Connection: close\r\n"
+                                     "\r\n" + body;
+
+        boost::asio::write(socket, boost::asio::buffer(response), error);
+        socket.shutdown(tcp::socket::shutdown_both, error);
+    }
+}
+
+std::string MetricsExporter::render() {
+    std::string body;
+    body.reserve(1024);
+
+    const auto gauge = [&body](const char* name, uint64_t value) {
+        body += "# TYPE ";
+        body += name;
+        body += " gauge\n";
+        body += name;
+        body += ' ';
+        body += std::to_string(value);
+        body += '\n';
+    };
+
+    // progress counters come first and are available from process start,
+    // before the node-level gauges below have anything behind them
+    cs::Metrics::instance().forEachCounter([&body](const std::string& name, uint64_t value) {
+        body += "# TYPE credits_" + name + " counter\n";
+        body += "credits_" + name + ' ' + std::to_string(value) + '\n';
+    });
+
+    // latency histograms in their human-readable form, attached as comments
+    // so the exposition stays parseable
+    std::string histograms = cs::Metrics::instance().report();
+    size_t start = 0;
+
+    while (start < histograms.size()) {
+        size_t end = histograms.find('\n', start);
+
+        if (end == std::string::npos) {
+            end = histograms.size();
+        }
+
+        body += "# " + histograms.substr(start, end - start) + "\n";
+        start = end + 1;
+    }
+
+    Node* node = node_.load(std::memory_order_acquire);
+
+    if (node == nullptr) {
+        return body;
+    }
+
+    const cs::Conveyer& conveyer = cs::Conveyer::instance();
+    const BlockChain& blockchain = node->getBlockChain();
+
+    gauge("credits_round_number", conveyer.currentRoundNumber());
+    gauge("credits_last_sequence", blockchain.getLastSeq());
+    gauge("credits_neighbours", node->neighboursCount());
+    gauge("credits_transport_inbox_packets", node->transportInboxQueueSize());
+    gauge("credits_conveyer_queue_transactions", conveyer.packetQueueTransactionsCount());
+    gauge("credits_conveyer_table_packets", conveyer.packetsTableSize());
+    gauge("credits_blockhashes_db_map_bytes", blockchain.getBlockHashesDbMapSize());
+    gauge("credits_trxindex_db_map_bytes", blockchain.getTrxIndexDbMapSize());
+    gauge("credits_blockhashes_db_occupancy_percent", blockchain.getBlockHashesDbOccupancy());
+    gauge("credits_trxindex_db_occupancy_percent", blockchain.getTrxIndexDbOccupancy());
+
+    const cs::RoundStat& stat = node->roundStat();
+    gauge("credits_round_duration_ms_p50", stat.roundDurationPercentile(50.0));
+    gauge("credits_round_duration_ms_p90", stat.roundDurationPercentile(90.0));
+    gauge("credits_round_duration_ms_p99", stat.roundDurationPercentile(99.0));
+    gauge("credits_round_perf_window_rounds", stat.perfRecordsCount());
+
+    return body;
+}
+}  // namespace cs
@@ -0,0 +1,14 @@
+#include <metricsprocessor.hpp>
+
+#include <lib/system/metrics.hpp>
+
+cs::MetricsProcessor::MetricsProcessor(::apache::thrift::stdcxx::shared_ptr<api::APIIf> iface)
+: ::api::APIProcessor(iface) {
+}
+
+bool cs::MetricsProcessor::dispatchCall(apache::thrift::protocol::TProtocol* iprot,
+                                        apache::thrift::protocol::TProtocol* oprot,
+                                        const std::string& fname, int32_t seqid, void* callContext) {
+    cs::MetricsTimer timer(cs::Metrics::instance().histogram("api_" + fname + "_us"));
+    return ::api::APIProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
+}
@@ -1,5 +1,6 @@
 #include <profiler/profiler.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 #include <lib/system/utils.hpp>
@@ -73,3 +74,100 @@ void cs::ProfilerFileLogger::eventLoop() {
         }
     }
 }
+
+cs::SpanProfiler::MethodStats& cs::SpanProfiler::stats(const std::string& method) {
+    std::lock_guard lock(mutex_);
+
+    auto& entry = methods_[method];
+    if (!entry) {
+        entry = std::make_unique<MethodStats>();
+    }
+
+    return *entry;
+}
+
+void cs::SpanProfiler::record(MethodStats& stats, uint64_t wallUs, uint64_t lockWaitUs, uint64_t storageCalls) {
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    stats.totalTimeUs.fetch_add(wallUs, std::memory_order_relaxed);
+    stats.lockWaitUs.fetch_add(lockWaitUs, std::memory_order_relaxed);
+    stats.storageCalls.fetch_add(storageCalls, std::memory_order_relaxed);
+
+    uint64_t max = stats.maxTimeUs.load(std::memory_order_relaxed);
+    while (max < wallUs && !stats.maxTimeUs.compare_exchange_weak(max, wallUs, std::memory_order_relaxed));
+
+    size_t bucket = 0;
+    for (uint64_t value = wallUs; value > 1 && (bucket + 1) < HistogramBuckets; value >>= 1) {
+        ++bucket;
+    }
+    stats.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto last = lastDumpTimeMs_.load(std::memory_order_acquire);
+
+    if ((nowMs - last) >= int64_t(DumpPeriodSec) * 1000 && lastDumpTimeMs_.compare_exchange_strong(last, nowMs)) {
+        dump();
+    }
+}
+
+void cs::SpanProfiler::dump() {
+    struct Line {
+        std::string method;
+        uint64_t calls;
+        uint64_t totalTimeUs;
+        uint64_t maxTimeUs;
+        uint64_t lockWaitUs;
+        uint64_t storageCalls;
+        uint64_t p99Us;
+    };
+
+    std::vector<Line> lines;
+    {
+        std::lock_guard lock(mutex_);
+        lines.reserve(methods_.size());
+
+        for (const auto& [method, stats] : methods_) {
+            Line line;
+            line.method = method;
+            line.calls = stats->calls.load(std::memory_order_relaxed);
+            line.totalTimeUs = stats->totalTimeUs.load(std::memory_order_relaxed);
+            line.maxTimeUs = stats->maxTimeUs.load(std::memory_order_relaxed);
+            line.lockWaitUs = stats->lockWaitUs.load(std::memory_order_relaxed);
+            line.storageCalls = stats->storageCalls.load(std::memory_order_relaxed);
+
+            // upper bound of the bucket holding the 99th percentile call
+            uint64_t accumulated = 0;
+            line.p99Us = 0;
+            for (size_t bucket = 0; bucket < HistogramBuckets; ++bucket) {
+                accumulated += stats->histogram[bucket].load(std::memory_order_relaxed);
+                if (accumulated * 100 >= line.calls * 99) {
+                    line.p99Us = uint64_t(1) << (bucket + 1);
+                    break;
+                }
+            }
+
+            if (line.calls != 0) {
+                lines.push_back(std::move(line));
+            }
+        }
+    }
+
+    std::sort(lines.begin(), lines.end(), [](const Line& lhs, const Line& rhs) {
+        return lhs.totalTimeUs > rhs.totalTimeUs;
+    });
+
+    if (lines.size() > TopMethodsCount) {
+        lines.resize(TopMethodsCount);
+    }
+
+    auto& logger = ProfilerFileLogger::instance();
+    logger.add("Top api methods by total time, " + std::to_string(DumpPeriodSec) + " s window");
+
+    for (const auto& line : lines) {
+        logger.add(line.method + ": calls " + std::to_string(line.calls) +
+                   ", avg " + std::to_string(line.totalTimeUs / line.calls) + " us" +
+                   ", p99 <= " + std::to_string(line.p99Us) + " us" +
+                   ", max " + std::to_string(line.maxTimeUs) + " us" +
+                   ", lock wait " + std::to_string(line.lockWaitUs) + " us" +
+                   ", storage calls " + std::to_string(line.storageCalls));
+    }
+}
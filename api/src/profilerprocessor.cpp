@@ -9,5 +9,6 @@ bool cs::ProfilerProcessor::dispatchCall(apache::thrift::protocol::TProtocol* ip
                                          apache::thrift::protocol::TProtocol* oprot,
                                          const std::string& fname, int32_t seqid, void* callContext) {
     cs::Profiler profiler("Method " + fname);
+    cs::ProfilerSpan span(fname);
     return ::api::APIProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
 }
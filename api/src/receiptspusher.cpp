@@ -0,0 +1,377 @@
+#include <receiptspusher.hpp>
+
+#include <chrono>
+#include <cstring>
+
+#include <boost/asio.hpp>
+
+#include <csnode/blockchain.hpp>
+#include <csnode/configholder.hpp>
+#include <csnode/node.hpp>
+#include <csnode/transactionspacket.hpp>
+
+#include <csdb/transaction.hpp>
+
+#include <lib/system/logger.hpp>
+
+namespace cs {
+class ReceiptsPusher::Session {
+public:
+    explicit Session(boost::asio::ip::tcp::socket socket)
+    : socket(std::move(socket)) {
+    }
+
+    boost::asio::ip::tcp::socket socket;
+    std::mutex writeMutex;
+    std::atomic_bool alive{true};
+    std::thread thread;
+};
+
+class ReceiptsPusher::Impl {
+public:
+    boost::asio::io_context context;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+
+    std::mutex sessionsMutex;
+    std::vector<SessionPtr> sessions;
+};
+
+size_t ReceiptsPusher::TransactionWatchHash::operator()(const TransactionWatch& watch) const {
+    // the key is already uniformly distributed, the inner id is not; fold it
+    // in with a multiplier so sequential ids from one source spread out
+    return std::hash<cs::PublicKey>{}(watch.source) ^ (static_cast<size_t>(watch.innerId) * 0x9E3779B97F4A7C15ULL);
+}
+
+ReceiptsPusher::ReceiptsPusher(Node& node)
+: node_(node)
+, impl_(std::make_unique<Impl>()) {
+}
+
+ReceiptsPusher::~ReceiptsPusher() {
+    stop();
+}
+
+void ReceiptsPusher::run() {
+    const uint16_t port = cs::ConfigHolder::instance().config()->getApiSettings().receiptsPushPort;
+
+    if (port == 0) {
+        cslog() << "Receipts pusher is disabled ([api] receipts_push_port = 0)";
+        return;
+    }
+
+    stopFlag_.store(false, std::memory_order_release);
+    dispatchThread_ = std::thread(&ReceiptsPusher::dispatcherRoutine, this);
+    acceptThread_ = std::thread(&ReceiptsPusher::serverRoutine, this, port);
+}
+
+void ReceiptsPusher::stop() {
+    stopFlag_.store(true, std::memory_order_release);
+
+    if (impl_->acceptor) {
+        boost::system::error_code ignored;
+        impl_->acceptor->close(ignored);
+    }
+
+    {
+        std::lock_guard lock(impl_->sessionsMutex);
+        for (auto& session : impl_->sessions) {
+            boost::system::error_code ignored;
+            session->socket.close(ignored);
+        }
+    }
+
+    eventArrived_.notify_all();
+
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+
+    if (dispatchThread_.joinable()) {
+        dispatchThread_.join();
+    }
+
+    std::lock_guard lock(impl_->sessionsMutex);
+    for (auto& session : impl_->sessions) {
+        if (session->thread.joinable()) {
+            session->thread.join();
+        }
+    }
+    impl_->sessions.clear();
+}
+
+void ReceiptsPusher::serverRoutine(uint16_t port) {
+    using boost::asio::ip::tcp;
+
+    try {
+        impl_->acceptor = std::make_unique<tcp::acceptor>(impl_->context, tcp::endpoint(tcp::v4(), port));
+    }
+    catch (const std::exception& e) {
+        cserror() << "Receipts pusher can not listen on port " << port << ": " << e.what();
+        return;
+    }
+
+    cslog() << "Receipts pusher started on port " << port;
+
+    while (!stopFlag_.load(std::memory_order_acquire)) {
+        boost::system::error_code error;
+        tcp::socket socket(impl_->context);
+
+        impl_->acceptor->accept(socket, error);
+
+        if (error) {
+            // closed by stop() or a transient failure
+            if (!stopFlag_.load(std::memory_order_acquire)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            continue;
+        }
+
+        auto session = std::make_shared<Session>(std::move(socket));
+
+        const uint8_t header[5] = {'C', 'S', 'R', 'P', kVersion};
+        boost::asio::write(session->socket, boost::asio::buffer(header, sizeof(header)), error);
+
+        if (error) {
+            continue;
+        }
+
+        std::lock_guard lock(impl_->sessionsMutex);
+
+        // reap sessions whose reader has finished, the watch index drops
+        // their expired weak pointers on its own
+        for (auto it = impl_->sessions.begin(); it != impl_->sessions.end();) {
+            if (!(*it)->alive.load(std::memory_order_acquire)) {
+                if ((*it)->thread.joinable()) {
+                    (*it)->thread.join();
+                }
+                it = impl_->sessions.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        impl_->sessions.push_back(session);
+        session->thread = std::thread(&ReceiptsPusher::sessionRoutine, this, session);
+    }
+}
+
+void ReceiptsPusher::sessionRoutine(SessionPtr session) {
+    while (!stopFlag_.load(std::memory_order_acquire)) {
+        boost::system::error_code error;
+        uint8_t command = 0;
+
+        boost::asio::read(session->socket, boost::asio::buffer(&command, 1), error);
+
+        if (error) {
+            break;
+        }
+
+        if (command == kCmdWatchTransaction) {
+            TransactionWatch watch;
+            boost::asio::read(session->socket, boost::asio::buffer(watch.source.data(), watch.source.size()), error);
+
+            if (!error) {
+                boost::asio::read(session->socket, boost::asio::buffer(&watch.innerId, sizeof(watch.innerId)), error);
+            }
+
+            if (error) {
+                break;
+            }
+
+            std::lock_guard lock(watchMutex_);
+            transactionWatches_[watch].push_back(session);
+        }
+        else if (command == kCmdWatchAddress) {
+            cs::PublicKey key;
+            boost::asio::read(session->socket, boost::asio::buffer(key.data(), key.size()), error);
+
+            if (error) {
+                break;
+            }
+
+            std::lock_guard lock(watchMutex_);
+            addressWatches_[key].push_back(session);
+        }
+        else {
+            cswarning() << "Receipts pusher: unknown command " << static_cast<int>(command) << ", closing session";
+            break;
+        }
+    }
+
+    boost::system::error_code ignored;
+    session->socket.close(ignored);
+    session->alive.store(false, std::memory_order_release);
+}
+
+void ReceiptsPusher::dispatcherRoutine() {
+    while (true) {
+        Event event;
+
+        {
+            std::unique_lock lock(eventMutex_);
+            eventArrived_.wait(lock, [this] {
+                return !events_.empty() || stopFlag_.load(std::memory_order_acquire);
+            });
+
+            if (events_.empty()) {
+                return;
+            }
+
+            event = std::move(events_.front());
+            events_.pop_front();
+        }
+
+        deliver(event);
+    }
+}
+
+void ReceiptsPusher::onBlockStored(const csdb::Pool& pool) {
+    enqueue(kResultIncluded, &pool, nullptr);
+}
+
+void ReceiptsPusher::onPacketExpired(const cs::TransactionsPacket& packet) {
+    enqueue(kResultExpired, nullptr, &packet);
+}
+
+void ReceiptsPusher::onTransactionsRejected(const cs::TransactionsPacket& packet) {
+    enqueue(kResultRejected, nullptr, &packet);
+}
+
+void ReceiptsPusher::enqueue(uint8_t result, const csdb::Pool* pool, const cs::TransactionsPacket* packet) {
+    {
+        // nobody waits for anything, keep block storage at zero extra cost
+        std::lock_guard lock(watchMutex_);
+        if (transactionWatches_.empty() && addressWatches_.empty()) {
+            return;
+        }
+    }
+
+    const auto& transactions = pool != nullptr ? pool->transactions() : packet->transactions();
+
+    if (transactions.empty()) {
+        return;
+    }
+
+    Event event;
+    event.result = result;
+    event.sequence = pool != nullptr ? pool->sequence() : 0;
+    event.records.reserve(transactions.size());
+
+    const BlockChain& blockchain = node_.getBlockChain();
+
+    uint32_t index = 0;
+    for (const auto& transaction : transactions) {
+        TransactionRecord record;
+
+        // stored blocks carry optimized wallet-id addresses, resolve them
+        // back to the keys the subscriber registered with
+        record.source = blockchain.getAddressByType(transaction.source(), BlockChain::AddressType::PublicKey).public_key();
+        record.target = blockchain.getAddressByType(transaction.target(), BlockChain::AddressType::PublicKey).public_key();
+        record.innerId = transaction.innerID();
+        record.index = index++;
+
+        event.records.push_back(record);
+    }
+
+    std::lock_guard lock(eventMutex_);
+
+    if (events_.size() >= kMaxPendingEvents) {
+        cswarning() << "Receipts pusher: event queue is full, dropping the oldest event";
+        events_.pop_front();
+    }
+
+    events_.push_back(std::move(event));
+    eventArrived_.notify_one();
+}
+
+void ReceiptsPusher::deliver(const Event& event) {
+    const bool included = event.result == kResultIncluded;
+
+    for (const auto& record : event.records) {
+        const cs::Sequence sequence = included ? event.sequence : 0;
+        const uint32_t index = included ? record.index : 0;
+
+        std::vector<SessionPtr> targets;
+
+        {
+            std::lock_guard lock(watchMutex_);
+
+            TransactionWatch watch{record.source, record.innerId};
+            auto it = transactionWatches_.find(watch);
+
+            if (it != transactionWatches_.end()) {
+                for (auto& weak : it->second) {
+                    if (auto session = weak.lock(); session && session->alive.load(std::memory_order_acquire)) {
+                        targets.push_back(session);
+                    }
+                }
+
+                // all three results are terminal, the watch is spent
+                transactionWatches_.erase(it);
+            }
+
+            // address watches are standing; a transaction that never made it
+            // into a block only concerns the sender
+            const auto collect = [this, &targets](const cs::PublicKey& key) {
+                auto found = addressWatches_.find(key);
+                if (found == addressWatches_.end()) {
+                    return;
+                }
+
+                auto& watchers = found->second;
+                for (auto weak = watchers.begin(); weak != watchers.end();) {
+                    if (auto session = weak->lock(); session && session->alive.load(std::memory_order_acquire)) {
+                        targets.push_back(session);
+                        ++weak;
+                    }
+                    else {
+                        weak = watchers.erase(weak);
+                    }
+                }
+
+                if (watchers.empty()) {
+                    addressWatches_.erase(found);
+                }
+            };
+
+            collect(record.source);
+
+            if (included && record.target != record.source) {
+                collect(record.target);
+            }
+        }
+
+        for (auto& session : targets) {
+            push(session, event.result, record.source, record.innerId, sequence, index);
+        }
+    }
+}
+
+void ReceiptsPusher::push(const SessionPtr& session, uint8_t result, const cs::PublicKey& key,
+                          int64_t innerId, cs::Sequence sequence, uint32_t index) {
+    uint8_t record[1 + sizeof(cs::PublicKey) + sizeof(innerId) + sizeof(uint64_t) + sizeof(index)];
+    uint8_t* out = record;
+
+    *out++ = result;
+    std::memcpy(out, key.data(), key.size());
+    out += key.size();
+    std::memcpy(out, &innerId, sizeof(innerId));
+    out += sizeof(innerId);
+    const uint64_t sequenceValue = sequence;
+    std::memcpy(out, &sequenceValue, sizeof(sequenceValue));
+    out += sizeof(sequenceValue);
+    std::memcpy(out, &index, sizeof(index));
+
+    std::lock_guard lock(session->writeMutex);
+
+    boost::system::error_code error;
+    boost::asio::write(session->socket, boost::asio::buffer(record, sizeof(record)), error);
+
+    if (error) {
+        boost::system::error_code ignored;
+        session->socket.close(ignored);
+        session->alive.store(false, std::memory_order_release);
+    }
+}
+}  // namespace cs
@@ -2,7 +2,16 @@
 
 #include <base58.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <lib/system/base58.hpp>
+#include <lib/system/concurrent.hpp>
+
 #include "apihandler.hpp"
 #include "tokens.hpp"
 #include "smartcontracts.hpp"
@@ -163,7 +172,7 @@ void executeAndCall(api::APIHandler* p_api, const general::Address& addr, const
         handler(getVariantAs<RetType>(result.results[0].ret_val));
 }
 
-void TokensMaster::refreshTokenState(const csdb::Address& token, const std::string& newState, bool checkBalance) {
+void TokensMaster::refreshTokenState(const csdb::Address& token, const std::string& newState, bool checkBalance, const std::vector<HolderKey>* dirtyHolders) {
     bool present = false;
     auto byteCodeObjects = api_->getSmartByteCode(token, present);
     if (!present || byteCodeObjects.empty()) return;
@@ -196,49 +205,106 @@ void TokensMaster::refreshTokenState(const csdb::Address& token, const std::stri
 
     // balance
     if (checkBalance) {
-        executor::ExecuteByteCodeMultipleResult result;
-        if (byteCodeObjects.empty())
-            return;
-
         executor::SmartContractBinary smartContractBinary;
         smartContractBinary.contractAddress = addr;
         smartContractBinary.object.byteCodeObjects = byteCodeObjects;
         smartContractBinary.object.instance = newState;
         smartContractBinary.stateCanModify = 0;
 
+        // a transfer names the only holders whose balances could have changed,
+        // so only they are queried; otherwise every known holder is re-walked
         std::vector<csdb::Address> holders;
-        holders.reserve(t.holders.size());
-        for (auto& h : t.holders)
-            holders.push_back(h.first);
+        if (dirtyHolders != nullptr) {
+            holders.reserve(dirtyHolders->size());
+            for (auto& h : *dirtyHolders) {
+                if (t.holders.count(h) != 0)
+                    holders.push_back(h);
+            }
+        }
+        else {
+            holders.reserve(t.holders.size());
+            for (auto& h : t.holders)
+                holders.push_back(h.first);
+        }
 
         std::vector<std::vector<general::Variant>> holderKeysParams;
         holderKeysParams.reserve(holders.size());
         for (auto& h : holders) {
             general::Variant var;
             auto key = h.public_key();
-            var.__set_v_string(EncodeBase58(cs::Bytes(key.begin(), key.end())));
+            var.__set_v_string(cs::Base58::encode(key));
             holderKeysParams.push_back(std::vector<general::Variant>(1, var));
         }
 
-        api_->getExecutor().executeByteCodeMultiple(result, dpAddr, smartContractBinary, "balanceOf", holderKeysParams, 100, cs::Executor::kUseLastSequence);
+        // one bounded multi-call per partition instead of a single giant invocation,
+        // partitions run concurrently on the thread pool
+        const size_t holdersCount = holders.size();
+        constexpr size_t kBatchSize = 1000;
+        const size_t batchesCount = (holdersCount + kBatchSize - 1) / kBatchSize;
+
+        std::vector<executor::ExecuteByteCodeMultipleResult> batchResults(batchesCount);
+
+        auto executeBatch = [&](size_t batch) {
+            const size_t first = batch * kBatchSize;
+            const size_t last = std::min(first + kBatchSize, holdersCount);
+            std::vector<std::vector<general::Variant>> batchParams(holderKeysParams.begin() + static_cast<ptrdiff_t>(first),
+                                                                   holderKeysParams.begin() + static_cast<ptrdiff_t>(last));
+            api_->getExecutor().executeByteCodeMultiple(batchResults[batch], dpAddr, smartContractBinary, "balanceOf", batchParams, 100, cs::Executor::kUseLastSequence);
+        };
+
+        if (batchesCount > 1 && std::thread::hardware_concurrency() > 1) {
+            std::atomic<size_t> jobsLeft = batchesCount;
+            std::mutex doneMutex;
+            std::condition_variable doneCondition;
+
+            for (size_t batch = 0; batch < batchesCount; ++batch) {
+                boost::asio::post(cs::ThreadPool::instance(), [&, batch] {
+                    executeBatch(batch);
+
+                    if (jobsLeft.fetch_sub(1) == 1) {
+                        cs::Lock lock(doneMutex);
+                        doneCondition.notify_one();
+                    }
+                });
+            }
+
+            std::unique_lock<std::mutex> lock(doneMutex);
+            doneCondition.wait(lock, [&] { return jobsLeft.load() == 0; });
+        }
+        else {
+            for (size_t batch = 0; batch < batchesCount; ++batch) {
+                executeBatch(batch);
+            }
+        }
+
+        // results are applied in holder order, batch after batch
+        for (size_t batch = 0; batch < batchesCount; ++batch) {
+            const auto& result = batchResults[batch];
+            const size_t first = batch * kBatchSize;
+            const size_t count = std::min(kBatchSize, holdersCount - first);
 
-        if (!result.status.code && (result.results.size() == holders.size())) {
-            for (uint32_t i = 0; i < holders.size(); ++i) {
+            if (result.status.code || result.results.size() != count)
+                continue;
+
+            for (size_t i = 0; i < count; ++i) {
                 const auto& res = result.results[i];
                 if (!res.status.code) {
+                    const auto& holder = holders[first + i];
                     bool zeroBalanceFlg = true;
-                    if (!isZeroAmount(t.holders[holders[i]].balance))
+                    if (!isZeroAmount(t.holders[holder].balance))
                         zeroBalanceFlg = false;
 
-                    t.holders[holders[i]].balance = tryExtractAmount(getVariantAs<std::string>(res.ret_val));
-                    if (zeroBalanceFlg && !isZeroAmount(t.holders[holders[i]].balance))
+                    t.holders[holder].balance = tryExtractAmount(getVariantAs<std::string>(res.ret_val));
+                    if (zeroBalanceFlg && !isZeroAmount(t.holders[holder].balance))
                         ++t.realHoldersCount;
-                    else if (!zeroBalanceFlg && isZeroAmount(t.holders[holders[i]].balance))
+                    else if (!zeroBalanceFlg && isZeroAmount(t.holders[holder].balance))
                         --t.realHoldersCount;
                 }
             }
         }
     }
+
+    bumpRevision();
 }
 
 /* Call under data lock only */
@@ -268,6 +334,11 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
     initiateHolder(tIt->second, tIt->first, ps.initiator);
     ++tIt->second.transactionsCount;
 
+    // a recognized transfer pins down the holders it could have touched, the
+    // balance refresh below is then limited to them instead of every holder
+    std::vector<HolderKey> dirtyHolders;
+    bool dirtyTracked = false;
+
     if (!ps.method.empty()) {
         if (isTransfer(ps.method, ps.params)) {
             ++tIt->second.transfersCount;
@@ -276,6 +347,14 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
                 initiateHolder(tIt->second, tIt->first, trPair.first, true);
             if (trPair.second.is_valid())
                 initiateHolder(tIt->second, tIt->first, trPair.second, true);
+
+            if (trPair.first.is_valid() && trPair.second.is_valid()) {
+                dirtyTracked = true;
+                dirtyHolders.push_back(trPair.first);
+                dirtyHolders.push_back(trPair.second);
+                if (ps.initiator != trPair.first && ps.initiator != trPair.second)
+                    dirtyHolders.push_back(ps.initiator);
+            }
         }
         else if (tIt->second.tokenStandard == TokenStandard::CreditsExtended) {
             csdb::Address regDude = tryGetRegisterData(ps.method, ps.params);
@@ -303,7 +382,7 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
             // param: owner
             std::vector<general::Variant> param(1);
             std::string addrOwnerStr = addrOwner.to_api_addr();
-            param[0].__set_v_string(EncodeBase58({ addrOwnerStr.begin(), addrOwnerStr.end() }));
+            param[0].__set_v_string(cs::Base58::encode(cs::Bytes{ addrOwnerStr.begin(), addrOwnerStr.end() }));
             //
             std::string retBalance{ "0" };
             executeAndCall<std::string>(api_, dpAddr, addrToken, byteCodeObjects, newState, "balanceOf", param,
@@ -358,8 +437,10 @@ void TokensMaster::updateTokenChaches(const csdb::Address& addr, const std::stri
         else if (ps.method.empty()) // deploy token
             refreshBalance(tokens_[addr].owner);
 #endif
-        refreshTokenState(addr, cs::SmartContracts::get_contract_state(api_->get_s_blockchain(), addr), true);
+        refreshTokenState(addr, cs::SmartContracts::get_contract_state(api_->get_s_blockchain(), addr), true, dirtyTracked ? &dirtyHolders : nullptr);
     }
+
+    bumpRevision();
 }
 
 void TokensMaster::checkNewDeploy(const csdb::Address& sc, const csdb::Address& deployer, const api::SmartContractInvocation& sci) {
@@ -381,6 +462,8 @@ void TokensMaster::checkNewDeploy(const csdb::Address& sc, const csdb::Address&
                     std::lock_guard<decltype(dataMut_)> lInt(dataMut_);
                     tokens_[dt.address] = t;
                 }
+
+                bumpRevision();
             }
         }
     }
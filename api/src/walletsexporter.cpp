@@ -0,0 +1,228 @@
+#include <walletsexporter.hpp>
+
+#include <chrono>
+
+#include <boost/asio.hpp>
+
+#include <lz4.h>
+
+#include <csnode/blockchain.hpp>
+#include <csnode/configholder.hpp>
+#include <csnode/multiwallets.hpp>
+#include <csnode/node.hpp>
+#include <csnode/odatastream.hpp>
+
+#include <lib/system/logger.hpp>
+
+namespace {
+// stream layout, integers in host byte order like the rest of the binary api:
+//   client -> server: one flag byte, bit 0 asks for LZ4-compressed frames
+//   server -> client: 'CSWE', uint8 version, uint8 granted flags, uint64
+//   wallet count at stream start, then frames of
+//   [uint32 rawSize][uint32 payloadSize][payload] where payload is a single
+//   LZ4 block when compression was granted; a frame with rawSize 0 ends the
+//   stream. Records are fixed width: 32 byte public key, balance and
+//   delegated as int32 integral + uint64 fraction, uint64 transaction count
+constexpr uint8_t kVersion = 1;
+constexpr uint8_t kFlagLz4 = 0x01;
+
+// ~1 MB of raw records per frame, small enough to keep the per-batch shared
+// lock on the wallets cache short
+constexpr size_t kBatchWallets = 16384;
+}  // namespace
+
+namespace cs {
+class WalletsExporter::Impl {
+public:
+    boost::asio::io_context context;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+};
+
+WalletsExporter::WalletsExporter(Node& node)
+: node_(node)
+, impl_(std::make_unique<Impl>()) {
+}
+
+WalletsExporter::~WalletsExporter() {
+    stop();
+}
+
+void WalletsExporter::run() {
+    const uint16_t port = cs::ConfigHolder::instance().config()->getApiSettings().walletsExportPort;
+
+    if (port == 0) {
+        cslog() << "Wallets exporter is disabled ([api] wallets_export_port = 0)";
+        return;
+    }
+
+    stopFlag_.store(false, std::memory_order_release);
+    thread_ = std::thread(&WalletsExporter::serverRoutine, this, port);
+}
+
+void WalletsExporter::stop() {
+    stopFlag_.store(true, std::memory_order_release);
+
+    if (impl_->acceptor) {
+        boost::system::error_code ignored;
+        impl_->acceptor->close(ignored);
+    }
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void WalletsExporter::serverRoutine(uint16_t port) {
+    using boost::asio::ip::tcp;
+
+    try {
+        impl_->acceptor = std::make_unique<tcp::acceptor>(impl_->context, tcp::endpoint(tcp::v4(), port));
+    }
+    catch (const std::exception& e) {
+        cserror() << "Wallets exporter can not listen on port " << port << ": " << e.what();
+        return;
+    }
+
+    cslog() << "Wallets exporter started on port " << port;
+
+    while (!stopFlag_.load(std::memory_order_acquire)) {
+        boost::system::error_code error;
+        tcp::socket socket(impl_->context);
+
+        impl_->acceptor->accept(socket, error);
+
+        if (error) {
+            // closed by stop() or a transient failure
+            if (!stopFlag_.load(std::memory_order_acquire)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            continue;
+        }
+
+        // the flag byte is optional: wait for it briefly, a silent client gets
+        // an uncompressed stream instead of hanging the accept loop
+        uint8_t requestFlags = 0;
+
+        for (int waited = 0; waited < 10 && !stopFlag_.load(std::memory_order_acquire); ++waited) {
+            boost::system::error_code available;
+
+            if (socket.available(available) > 0 || available) {
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        if (socket.available() > 0) {
+            boost::asio::read(socket, boost::asio::buffer(&requestFlags, sizeof(requestFlags)), error);
+
+            if (error) {
+                continue;
+            }
+        }
+
+        const bool compress = (requestFlags & kFlagLz4) != 0;
+        const cs::MultiWallets& wallets = node_.getBlockChain().multiWallets();
+
+        cs::Bytes header;
+        {
+            cs::ODataStream stream(header);
+            stream << cs::Byte('C') << cs::Byte('S') << cs::Byte('W') << cs::Byte('E');
+            stream << kVersion;
+            stream << static_cast<uint8_t>(compress ? kFlagLz4 : 0);
+            stream << static_cast<uint64_t>(wallets.size());
+        }
+
+        boost::asio::write(socket, boost::asio::buffer(header.data(), header.size()), error);
+
+        if (error) {
+            continue;
+        }
+
+        cs::PublicKey position{};
+        bool fromStart = true;
+        bool failed = false;
+        uint64_t streamed = 0;
+
+        while (!stopFlag_.load(std::memory_order_acquire)) {
+            const auto batch = wallets.nextBatch(position, kBatchWallets, fromStart);
+            fromStart = false;
+
+            if (batch.empty()) {
+                break;
+            }
+
+            position = batch.back().key_;
+
+            cs::Bytes raw;
+            raw.reserve(batch.size() * (sizeof(cs::PublicKey) + sizeof(int32_t) * 2 + sizeof(uint64_t) * 3));
+
+            {
+                cs::ODataStream stream(raw);
+
+                for (const auto& data : batch) {
+                    stream << data.key_;
+                    stream << data.balance_.integral() << data.balance_.fraction();
+                    stream << data.delegated_.integral() << data.delegated_.fraction();
+                    stream << data.transNum_;
+                }
+            }
+
+            cs::Bytes compressed;
+            const cs::Byte* payload = raw.data();
+            size_t payloadSize = raw.size();
+
+            if (compress) {
+                compressed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(raw.size()))));
+                const int compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(raw.data()),
+                                                                reinterpret_cast<char*>(compressed.data()),
+                                                                static_cast<int>(raw.size()),
+                                                                static_cast<int>(compressed.size()));
+
+                if (compressedSize <= 0) {
+                    cswarning() << "Wallets exporter frame compression failed, stream aborted";
+                    failed = true;
+                    break;
+                }
+
+                payload = compressed.data();
+                payloadSize = static_cast<size_t>(compressedSize);
+            }
+
+            cs::Bytes frameHeader;
+            {
+                cs::ODataStream stream(frameHeader);
+                stream << static_cast<uint32_t>(raw.size());
+                stream << static_cast<uint32_t>(payloadSize);
+            }
+
+            boost::asio::write(socket, boost::asio::buffer(frameHeader.data(), frameHeader.size()), error);
+
+            if (!error) {
+                boost::asio::write(socket, boost::asio::buffer(payload, payloadSize), error);
+            }
+
+            if (error) {
+                failed = true;
+                break;
+            }
+
+            streamed += batch.size();
+        }
+
+        if (!failed) {
+            cs::Bytes terminator;
+            {
+                cs::ODataStream stream(terminator);
+                stream << uint32_t(0) << uint32_t(0);
+            }
+
+            boost::asio::write(socket, boost::asio::buffer(terminator.data(), terminator.size()), error);
+            csdebug() << "Wallets exporter streamed " << streamed << " wallets";
+        }
+
+        boost::system::error_code ignored;
+        socket.shutdown(tcp::socket::shutdown_both, ignored);
+    }
+}
+}  // namespace cs
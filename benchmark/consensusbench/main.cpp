@@ -0,0 +1,260 @@
+#include <framework.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/pool.hpp>
+#include <csdb/transaction.hpp>
+
+#include <csnode/configholder.hpp>
+#include <csnode/conveyer.hpp>
+#include <csnode/fee.hpp>
+#include <csnode/nodecore.hpp>
+#include <csnode/transactionspacket.hpp>
+
+#include <lib/system/console.hpp>
+#include <lib/system/reflection.hpp>
+#include <lib/system/signals.hpp>
+
+// trusted-node round cost benchmark. Every iteration replays one consensus
+// round against the real conveyer: a small share of the payload enters through
+// the client queue and is flushed, the rest arrives pre-packed the way network
+// peers deliver it, then the round table is set and the block candidate is
+// assembled, fee-counted, masked and materialized into a pool exactly like
+// stage-1 and the writer path do it. Stage times are reported separately so a
+// change to one stage can be judged without the noise of the others.
+//
+// The real transactions validator is not driven here, it needs a solver
+// context with a live blockchain behind it; its verdict is modelled by the
+// reject share of the characteristic mask, which is what the validator feeds
+// into the apply step anyway.
+//
+// Arguments, all optional and positional:
+//   1 - transactions per round (default 10000)
+//   2 - rounds to replay      (default 20)
+//   3 - rejected share, %     (default 5)
+
+static volatile size_t result = 0;
+
+static size_t transactionsPerRound = 10'000;
+static size_t syntheticRounds = 20;
+static size_t rejectPercent = 5;
+
+// the node's own clients contribute a modest slice of a big round, the bulk
+// is relayed packets; kept under the early flush watermark so the queue
+// drains only when the bench asks it to
+static const size_t localTransactions = 200;
+static const size_t transactionsPerNetworkPacket = 100;
+static const size_t userFieldPeriod = 5;
+static const cs::RoundNumber firstRound = 10;
+
+static int64_t nextInnerId = 1;
+
+class LibsodiumInit {
+public:
+    LibsodiumInit() {
+        cscrypto::cryptoInit();
+    }
+};
+
+static cs::PrivateKey generatePrivateKey() {
+    cs::PublicKey key{};
+    [[maybe_unused]] static LibsodiumInit init;
+
+    return cs::PrivateKey::generateWithPair(key);
+}
+
+static csdb::Transaction makeTransaction(int64_t innerId) {
+    csdb::Transaction transaction;
+
+    auto startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000007");
+    cs::PublicKey publicKey{};
+
+    transaction.set_target(csdb::Address::from_public_key(publicKey));
+    transaction.set_source(startAddress);
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(10000, 0));
+    transaction.set_innerID(innerId);
+
+    // a slice of transfers carries a payload, mainnet rounds are never
+    // uniformly sized
+    if (static_cast<size_t>(innerId) % userFieldPeriod == 0) {
+        transaction.add_user_field(1, std::string(64, 'x'));
+    }
+
+    return transaction;
+}
+
+static cs::TransactionsPacket makeNetworkPacket(size_t transactionsCount, cs::RoundNumber round) {
+    cs::TransactionsPacket packet;
+
+    for (size_t i = 0; i < transactionsCount; ++i) {
+        packet.addTransaction(makeTransaction(nextInnerId++));
+    }
+
+    packet.setExpiredRound(round + cs::ConfigHolder::instance().config()->conveyerData().maxPacketLifeTime);
+    packet.makeHash();
+
+    return packet;
+}
+
+template <typename Func>
+static uint64_t timedUs(Func func) {
+    const auto started = std::chrono::steady_clock::now();
+    func();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count());
+}
+
+struct StageTimes {
+    uint64_t flushUs = 0;
+    uint64_t stagingUs = 0;
+    uint64_t assembleUs = 0;
+    uint64_t feeUs = 0;
+    uint64_t applyUs = 0;
+    uint64_t serializeUs = 0;
+};
+
+static void runConsensusRounds() {
+    cs::Conveyer& conveyer = cs::Conveyer::instance();
+    conveyer.setPrivateKey(generatePrivateKey());
+
+    cs::PacketsHashes flushedHashes;
+
+    cs::Connector::connect(&conveyer.packetFlushed, [&flushedHashes](const cs::TransactionsPacket& packet) {
+        flushedHashes.push_back(packet.hash());
+    });
+
+    StageTimes times;
+    size_t blockTransactions = 0;
+    size_t blockBytes = 0;
+
+    for (size_t iteration = 0; iteration < syntheticRounds; ++iteration) {
+        const cs::RoundNumber round = firstRound + static_cast<cs::RoundNumber>(iteration);
+        conveyer.setRound(round);
+
+        // client path: single transactions coalesced into packets by the flush
+        flushedHashes.clear();
+
+        for (size_t i = 0; i < localTransactions; ++i) {
+            conveyer.addTransaction(makeTransaction(nextInnerId++));
+        }
+
+        times.flushUs += timedUs([&conveyer] {
+            conveyer.flushTransactions();
+        });
+
+        cs::PacketsHashes hashes = flushedHashes;
+
+        // network path: the rest of the round arrives already packed
+        times.stagingUs += timedUs([&conveyer, &hashes, round] {
+            size_t remaining = transactionsPerRound > localTransactions ? transactionsPerRound - localTransactions : 0;
+
+            while (remaining != 0) {
+                const size_t count = std::min(remaining, transactionsPerNetworkPacket);
+                cs::TransactionsPacket packet = makeNetworkPacket(count, round);
+
+                hashes.push_back(packet.hash());
+                conveyer.addTransactionsPacket(packet);
+
+                remaining -= count;
+            }
+
+            conveyer.setTable(cs::RoundTable{round, cs::ConfidantsKeys{}, hashes});
+        });
+
+        // stage-1: assemble the block candidate from the shared hash order
+        std::optional<std::pair<cs::TransactionsPacket, cs::PacketsVector>> data;
+
+        times.assembleUs += timedUs([&conveyer, &data, round] {
+            data = conveyer.createPacket(round);
+        });
+
+        if (!data.has_value()) {
+            cs::Console::writeLine("Round ", round, " failed to assemble the block candidate, benchmark stopped");
+            return;
+        }
+
+        auto& [packet, smartContractPackets] = data.value();
+        csunused(smartContractPackets);
+
+        times.feeUs += timedUs([&packet] {
+            cs::fee::setCountedFees(packet.transactions());
+        });
+
+        // validator verdict stand-in, see the file comment
+        cs::Bytes mask(packet.transactionsCount());
+
+        for (size_t i = 0; i < mask.size(); ++i) {
+            mask[i] = (i % 100) < rejectPercent ? cs::Byte(0) : cs::Byte(1);
+        }
+
+        conveyer.setCharacteristic(cs::Characteristic{mask}, round);
+
+        cs::PoolMetaInfo metaInfo;
+        metaInfo.timestamp = "1542617459297";
+        metaInfo.sequenceNumber = round;
+
+        std::optional<csdb::Pool> pool;
+
+        times.applyUs += timedUs([&conveyer, &pool, &metaInfo] {
+            pool = conveyer.applyCharacteristic(metaInfo);
+        });
+
+        if (!pool.has_value()) {
+            cs::Console::writeLine("Round ", round, " failed to apply the characteristic, benchmark stopped");
+            return;
+        }
+
+        blockTransactions += pool.value().transactions_count();
+
+        times.serializeUs += timedUs([&pool, &blockBytes] {
+            blockBytes += pool.value().to_binary().size();
+        });
+    }
+
+    result += blockBytes;
+
+    cs::Console::writeLine("Rounds replayed ", syntheticRounds, ", block transactions total ", blockTransactions, ", block bytes total ", blockBytes);
+    cs::Console::writeLine("Average per round, microseconds:");
+    cs::Console::writeLine("  conveyer flush            ", times.flushUs / syntheticRounds);
+    cs::Console::writeLine("  packet staging and table  ", times.stagingUs / syntheticRounds);
+    cs::Console::writeLine("  candidate assembly        ", times.assembleUs / syntheticRounds);
+    cs::Console::writeLine("  fee counting              ", times.feeUs / syntheticRounds);
+    cs::Console::writeLine("  characteristic apply      ", times.applyUs / syntheticRounds);
+    cs::Console::writeLine("  block serialization       ", times.serializeUs / syntheticRounds);
+}
+
+static void testConsensusRounds() {
+    cs::Console::writeLine("Test trusted-node round path, rounds ", syntheticRounds, " of ", transactionsPerRound, " transactions, rejected ", rejectPercent, "%");
+    cs::Framework::execute(&runConsensusRounds, std::chrono::seconds(300));
+    cs::Console::writeLine("");
+}
+
+static size_t parseArgument(const char* value, size_t fallback) {
+    const size_t parsed = static_cast<size_t>(std::strtoull(value, nullptr, 10));
+    return parsed != 0 ? parsed : fallback;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        transactionsPerRound = parseArgument(argv[1], transactionsPerRound);
+    }
+
+    if (argc > 2) {
+        syntheticRounds = parseArgument(argv[2], syntheticRounds);
+    }
+
+    if (argc > 3) {
+        rejectPercent = std::min<size_t>(parseArgument(argv[3], rejectPercent), 100);
+    }
+
+    testConsensusRounds();
+
+    return 0;
+}
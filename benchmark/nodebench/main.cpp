@@ -0,0 +1,193 @@
+#include <framework.hpp>
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/currency.hpp>
+#include <csdb/pool.hpp>
+#include <csdb/transaction.hpp>
+
+#include <csnode/conveyer.hpp>
+#include <csnode/odatastream.hpp>
+#include <csnode/transactionspacket.hpp>
+
+#include <net/packet.hpp>
+#include <net/packetsqueue.hpp>
+#include <net/packetvalidator.hpp>
+
+#include <lib/system/console.hpp>
+
+// node data path benchmarks, run them before and after a change to compare
+// releases on the same machine. By default every bench generates its own
+// payload; pass a capture file as the first argument to decode real mainnet
+// blocks instead. The capture format is a plain sequence of records, each one
+// a uint32_t byte count followed by csdb::Pool::to_binary() output.
+
+static volatile size_t result = 0;
+
+static const size_t transactionsPerPool = 1000;
+static const size_t poolDecodeIterations = 1000;
+static const size_t conveyerTransactionsCount = 100'000;
+static const size_t packetHashIterations = 1000;
+static const size_t loopbackIterations = 100'000;
+
+static csdb::Transaction makeTransaction(int64_t innerId) {
+    csdb::Transaction transaction;
+
+    auto startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000007");
+    cs::PublicKey publicKey{};
+
+    transaction.set_target(csdb::Address::from_public_key(publicKey));
+    transaction.set_source(startAddress);
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(10000, 0));
+    transaction.set_innerID(innerId);
+
+    return transaction;
+}
+
+static csdb::Pool makePool(cs::Sequence sequence, size_t transactionsCount) {
+    csdb::Pool pool;
+    pool.set_sequence(sequence);
+
+    for (size_t i = 0; i < transactionsCount; ++i) {
+        pool.add_transaction(makeTransaction(static_cast<int64_t>(i)));
+    }
+
+    pool.compose();
+    return pool;
+}
+
+static std::vector<cs::Bytes> loadCapturedPools(const std::string& fileName) {
+    std::vector<cs::Bytes> samples;
+    std::ifstream file(fileName, std::ios::binary);
+
+    if (!file.is_open()) {
+        cs::Console::writeLine("Can not open capture file ", fileName, ", generated payload would be used");
+        return samples;
+    }
+
+    uint32_t size = 0;
+
+    while (file.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+        cs::Bytes bytes(size);
+
+        if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size))) {
+            cs::Console::writeLine("Capture file ", fileName, " is truncated, tail record skipped");
+            break;
+        }
+
+        samples.push_back(std::move(bytes));
+    }
+
+    return samples;
+}
+
+static std::vector<cs::Bytes> poolSamples;
+
+static void runPoolDecode() {
+    size_t decodedTransactions = 0;
+
+    for (size_t i = 0; i < poolDecodeIterations; ++i) {
+        for (const auto& sample : poolSamples) {
+            cs::Bytes bytes = sample;
+            csdb::Pool pool = csdb::Pool::from_binary(std::move(bytes));
+            decodedTransactions += pool.transactions_count();
+        }
+    }
+
+    cs::Console::writeLine("Decoded transactions ", decodedTransactions);
+}
+
+static void runConveyerIngest() {
+    cs::Conveyer& conveyer = cs::Conveyer::instance();
+
+    for (size_t i = 0; i < conveyerTransactionsCount; ++i) {
+        conveyer.addTransaction(makeTransaction(static_cast<int64_t>(i)));
+    }
+}
+
+static void runPacketHash() {
+    for (size_t i = 0; i < packetHashIterations; ++i) {
+        cs::TransactionsPacket packet;
+
+        for (size_t j = 0; j < transactionsPerPool; ++j) {
+            packet.addTransaction(makeTransaction(static_cast<int64_t>(j)));
+        }
+
+        packet.makeHash();
+    }
+}
+
+static void runPacketLoopback() {
+    cs::TransactionsPacket packet;
+    packet.addTransaction(makeTransaction(0));
+    packet.makeHash();
+
+    cs::PublicKey sender{};
+    PacketsQueue queue;
+
+    for (size_t i = 0; i < loopbackIterations; ++i) {
+        cs::Bytes packetBytes;
+        cs::ODataStream stream(packetBytes);
+        stream << BaseFlags::Clear;
+        stream << MsgTypes::TransactionPacket;
+        stream << cs::RoundNumber(1);
+        stream << packet;
+
+        Packet pack(std::move(packetBytes));
+
+        if (!cs::PacketValidator::validate(pack)) {
+            cs::Console::writeLine("Loopback packet failed validation");
+            return;
+        }
+
+        queue.push(sender, std::move(pack));
+        auto entry = queue.pop();
+        result += entry.second.size();
+    }
+}
+
+static void testPoolDecode() {
+    cs::Console::writeLine("Test Pool::from_binary decode rate, pools per pass ", poolSamples.size(), ", passes ", poolDecodeIterations);
+    cs::Framework::execute(&runPoolDecode, std::chrono::seconds(120));
+    cs::Console::writeLine("");
+}
+
+static void testConveyerIngest() {
+    cs::Console::writeLine("Test conveyer ingest, transactions ", conveyerTransactionsCount);
+    cs::Framework::execute(&runConveyerIngest, std::chrono::seconds(120));
+    cs::Console::writeLine("");
+}
+
+static void testPacketHash() {
+    cs::Console::writeLine("Test packet serialization and hash, packets ", packetHashIterations, " of ", transactionsPerPool, " transactions");
+    cs::Framework::execute(&runPacketHash, std::chrono::seconds(120));
+    cs::Console::writeLine("");
+}
+
+static void testPacketLoopback() {
+    cs::Console::writeLine("Test wire loopback round-trips, packets ", loopbackIterations);
+    cs::Framework::execute(&runPacketLoopback, std::chrono::seconds(120));
+    cs::Console::writeLine("");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        poolSamples = loadCapturedPools(argv[1]);
+    }
+
+    if (poolSamples.empty()) {
+        poolSamples.push_back(makePool(1, transactionsPerPool).to_binary());
+    }
+
+    testPoolDecode();
+    testConveyerIngest();
+    testPacketHash();
+    testPacketLoopback();
+
+    return 0;
+}
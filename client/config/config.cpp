@@ -59,9 +59,27 @@ const std::string PARAM_NAME_SYNC_ON = "sync_on";
 const std::string PARAM_NAME_MAX_UNCORRECTED_BLOCK = "max_uncorrected_block";
 const std::string PARAM_NAME_GENERATE_FORK = "generate_fork";
 const std::string PARAM_NAME_IDLE_MODE = "idle_mode";
+const std::string PARAM_NAME_STANDBY_MODE = "standby_mode";
+const std::string PARAM_NAME_OBSERVER_MODE = "observer_mode";
+const std::string PARAM_NAME_API_REPLICA_MODE = "api_replica_mode";
+const std::string PARAM_NAME_REPLICA_UPSTREAM = "replica_upstream";
 const std::string PARAM_NAME_DAEMON_MODE = "daemon_mode";
+const std::string PARAM_NAME_PACKET_TRACE_FILE = "packet_trace_file";
+const std::string PARAM_NAME_PACKET_TRACE_SIZE_MB = "packet_trace_size_mb";
+const std::string PARAM_NAME_REPLAY_TRACE_FILE = "replay_trace_file";
+const std::string PARAM_NAME_REPLAY_TRACE_SPEED = "replay_trace_speed";
+const std::string PARAM_NAME_SYNC_CHECKPOINT_SEQ = "sync_checkpoint_seq";
+const std::string PARAM_NAME_SYNC_CHECKPOINT_HASH = "sync_checkpoint_hash";
+
+const std::string PARAM_NAME_AFFINITY_NETWORK_CORES = "affinity_network_cores";
+const std::string PARAM_NAME_AFFINITY_DISPATCH_CORES = "affinity_dispatch_cores";
+const std::string PARAM_NAME_AFFINITY_WORKER_CORES = "affinity_worker_cores";
 
 const std::string PARAM_NAME_CONVEYER_MAX_PACKET_LIFETIME = "max_packet_life_time";
+const std::string PARAM_NAME_CONVEYER_PACKET_COALESCE_TIME = "packet_coalesce_time_ms";
+const std::string PARAM_NAME_CONVEYER_MAX_CACHED_MEMORY = "max_cached_memory_mb";
+const std::string PARAM_NAME_CONVEYER_EARLY_FLUSH_TRANSACTIONS = "early_flush_transactions";
+const std::string PARAM_NAME_CONVEYER_EARLY_FLUSH_KB = "early_flush_kb";
 
 const std::string PARAM_NAME_ID = "id";
 const std::string PARAM_NAME_IP = "ip";
@@ -73,10 +91,15 @@ const std::string PARAM_NAME_POOL_SYNC_SEQ_VERIF_FREQ = "sequences_verification_
 const std::string PARAM_NAME_STORAGE_CHECKPOINT_KEEP = "checkpoint_keep";
 const std::string PARAM_NAME_STORAGE_CHECKPOINT_EVERY = "checkpoint_every";
 const std::string PARAM_NAME_STORAGE_CHECKPOINT_EVERY_MINUTES = "checkpoint_every_minutes";
+const std::string PARAM_NAME_STORAGE_ARCHIVE_HORIZON = "archive_horizon_blocks";
+const std::string PARAM_NAME_STORAGE_WRITE_BEHIND = "write_behind_blocks";
 
 const std::string PARAM_NAME_API_PORT = "port";
 const std::string PARAM_NAME_AJAX_PORT = "ajax_port";
 const std::string PARAM_NAME_DIAG_PORT = "diag_port";
+const std::string PARAM_NAME_METRICS_PORT = "metrics_port";
+const std::string PARAM_NAME_WALLETS_EXPORT_PORT = "wallets_export_port";
+const std::string PARAM_NAME_RECEIPTS_PUSH_PORT = "receipts_push_port";
 const std::string PARAM_NAME_EXECUTOR_PORT = "executor_port";
 const std::string PARAM_NAME_APIEXEC_PORT = "apiexec_port";
 const std::string PARAM_NAME_EXECUTOR_SEND_TIMEOUT = "executor_send_timeout";
@@ -85,12 +108,17 @@ const std::string PARAM_NAME_SERVER_SEND_TIMEOUT = "server_send_timeout";
 const std::string PARAM_NAME_SERVER_RECEIVE_TIMEOUT = "server_receive_timeout";
 const std::string PARAM_NAME_AJAX_SERVER_SEND_TIMEOUT = "ajax_server_send_timeout";
 const std::string PARAM_NAME_AJAX_SERVER_RECEIVE_TIMEOUT = "ajax_server_receive_timeout";
+const std::string PARAM_NAME_API_MAX_CONNECTIONS_PER_IP = "max_connections_per_ip";
+const std::string PARAM_NAME_API_MAX_REQUESTS_PER_SECOND_PER_IP = "max_requests_per_second_per_ip";
+const std::string PARAM_NAME_API_NONBLOCKING_SERVER = "nonblocking_server";
+const std::string PARAM_NAME_API_NONBLOCKING_WORKER_THREADS = "nonblocking_worker_threads";
 const std::string PARAM_NAME_EXECUTOR_IP = "executor_ip";
 const std::string PARAM_NAME_EXECUTOR_CMDLINE = "executor_command";
 const std::string PARAM_NAME_EXECUTOR_RUN_DELAY = "executor_run_delay";
 const std::string PARAM_NAME_EXECUTOR_BACKGROUND_THREAD_DELAY = "executor_background_thread_delay";
 const std::string PARAM_NAME_EXECUTOR_CHECK_VERSION_DELAY = "executor_check_version_delay";
 const std::string PARAM_NAME_EXECUTOR_MULTI_INSTANCE = "executor_multi_instance";
+const std::string PARAM_NAME_EXECUTOR_GETTER_CONNECTIONS = "executor_getter_connections";
 const std::string PARAM_NAME_EXECUTOR_VERSION_COMMIT_MIN = "executor_commit_min";
 const std::string PARAM_NAME_EXECUTOR_VERSION_COMMIT_MAX = "executor_commit_max";
 const std::string PARAM_NAME_JPS_COMMAND_LINE = "jps_command";
@@ -109,6 +137,7 @@ const std::string PARAM_NAME_EVENTS_REJECT_TRANSACTION = "reject_transaction";
 const std::string PARAM_NAME_EVENTS_REJECT_CONTRACT_EXECUTION = "reject_contract_execution";
 const std::string PARAM_NAME_EVENTS_REJECT_CONTRACT_CONSENSUS = "reject_contract_consensus";
 const std::string PARAM_NAME_EVENTS_ALARM_INVALID_BLOCK = "alarm_invalid_block";
+const std::string PARAM_NAME_EVENTS_ROUND_STALL_TRACE = "round_stall_trace";
 
 const std::string PARAM_NAME_DBSQL_HOST = "host";
 const std::string PARAM_NAME_DBSQL_PORT = "port";
@@ -125,6 +154,8 @@ const std::string ARG_NAME_RECREATE_INDEX = "recreate-index";
 const std::string ARG_NAME_NEW_BC_TOP = "set-bc-top";
 const std::string ARG_NAME_BAL_CHANGE = "bal-change";
 const std::string ARG_NAME_DISABLE_AUTO_SHUTDOWN = "disable-auto-shutdown";
+const std::string ARG_NAME_EXPORT_SNAPSHOT = "export-snapshot";
+const std::string ARG_NAME_IMPORT_SNAPSHOT = "import-snapshot";
 
 const uint32_t MIN_PASSWORD_LENGTH = 3;
 const uint32_t MAX_PASSWORD_LENGTH = 128;
@@ -193,6 +224,38 @@ static inline std::string getArgFromCmdLine(const po::variables_map& vm, const s
     return vm.count(name) ? vm[name].as<std::string>() : defVal;
 }
 
+// parses a cpu list like "0-7,16,20-23" into cpu indices, returns empty list on malformed input
+static std::vector<uint16_t> parseCpuList(const std::string& value) {
+    std::vector<uint16_t> cpus;
+    std::vector<std::string> tokens;
+    boost::split(tokens, value, boost::is_any_of(","));
+
+    try {
+        for (const auto& token : tokens) {
+            const std::string item = boost::trim_copy(token);
+            const size_t dash = item.find('-');
+
+            if (dash == std::string::npos) {
+                cpus.push_back(static_cast<uint16_t>(std::stoul(item)));
+            }
+            else {
+                const unsigned long first = std::stoul(item.substr(0, dash));
+                const unsigned long last = std::stoul(item.substr(dash + 1));
+
+                for (unsigned long cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(static_cast<uint16_t>(cpu));
+                }
+            }
+        }
+    }
+    catch (...) {
+        cswarning() << "config: invalid cpu list \"" << value << "\", affinity setting ignored";
+        return {};
+    }
+
+    return cpus;
+}
+
 static inline void writeFile(const std::string name, const std::string data) {
     std::ofstream file(name);
     file << data;
@@ -267,6 +330,13 @@ Config Config::read(po::variables_map& vm, bool atStart) {
             result.showBalanceChangeKey_.fill(0);
             //csinfo() << "Balance changes account is set to " << cs::Utils::byteStreamToHex(result.showBalanceChangeKey_);
         }
+
+        if (vm.count(ARG_NAME_EXPORT_SNAPSHOT)) {
+            result.snapshotExportPath_ = vm[ARG_NAME_EXPORT_SNAPSHOT].as<std::string>();
+        }
+        if (vm.count(ARG_NAME_IMPORT_SNAPSHOT)) {
+            result.snapshotImportPath_ = vm[ARG_NAME_IMPORT_SNAPSHOT].as<std::string>();
+        }
     }
     return result;
 }
@@ -811,6 +881,72 @@ Config Config::readFromFile(const std::string& fileName) {
             result.idleMode_ = params.get<bool>(PARAM_NAME_IDLE_MODE);
         }
 
+        if (params.count(PARAM_NAME_STANDBY_MODE)) {
+            result.standbyMode_ = params.get<bool>(PARAM_NAME_STANDBY_MODE);
+        }
+
+        if (params.count(PARAM_NAME_OBSERVER_MODE)) {
+            result.observerMode_ = params.get<bool>(PARAM_NAME_OBSERVER_MODE);
+        }
+
+        if (params.count(PARAM_NAME_API_REPLICA_MODE)) {
+            result.apiReplicaMode_ = params.get<bool>(PARAM_NAME_API_REPLICA_MODE);
+        }
+
+        if (params.count(PARAM_NAME_REPLICA_UPSTREAM)) {
+            // one base58 node key per line, same layout as the initial
+            // trusted file
+            std::ifstream upstreamFile(params.get<std::string>(PARAM_NAME_REPLICA_UPSTREAM));
+            std::string upstreamLine;
+            cs::Bytes keyBytes;
+            while (getline(upstreamFile, upstreamLine)) {
+                if (!upstreamLine.empty() && DecodeBase58(upstreamLine, keyBytes)) {
+                    cs::PublicKey key;
+                    std::copy(keyBytes.begin(), keyBytes.end(), key.begin());
+                    result.replicaUpstream_.push_back(key);
+                }
+            }
+        }
+
+        if (params.count(PARAM_NAME_PACKET_TRACE_FILE)) {
+            result.packetTraceFile_ = params.get<std::string>(PARAM_NAME_PACKET_TRACE_FILE);
+        }
+
+        result.packetTraceSizeMb_ = params.count(PARAM_NAME_PACKET_TRACE_SIZE_MB) ? params.get<uint64_t>(PARAM_NAME_PACKET_TRACE_SIZE_MB) : DEFAULT_PACKET_TRACE_SIZE_MB;
+
+        if (params.count(PARAM_NAME_REPLAY_TRACE_FILE)) {
+            result.replayTraceFile_ = params.get<std::string>(PARAM_NAME_REPLAY_TRACE_FILE);
+        }
+
+        if (params.count(PARAM_NAME_REPLAY_TRACE_SPEED)) {
+            result.replayTraceSpeed_ = params.get<uint64_t>(PARAM_NAME_REPLAY_TRACE_SPEED);
+        }
+
+        if (params.count(PARAM_NAME_SYNC_CHECKPOINT_SEQ)) {
+            result.syncCheckpointSequence_ = params.get<uint64_t>(PARAM_NAME_SYNC_CHECKPOINT_SEQ);
+        }
+
+        if (params.count(PARAM_NAME_SYNC_CHECKPOINT_HASH)) {
+            result.syncCheckpointHash_ = params.get<std::string>(PARAM_NAME_SYNC_CHECKPOINT_HASH);
+        }
+
+        if (result.syncCheckpointSequence_ != 0 && result.syncCheckpointHash_.empty()) {
+            cswarning() << "config: sync_checkpoint_seq without sync_checkpoint_hash, checkpoint ignored";
+            result.syncCheckpointSequence_ = 0;
+        }
+
+        if (params.count(PARAM_NAME_AFFINITY_NETWORK_CORES)) {
+            result.affinityNetworkCores_ = parseCpuList(params.get<std::string>(PARAM_NAME_AFFINITY_NETWORK_CORES));
+        }
+
+        if (params.count(PARAM_NAME_AFFINITY_DISPATCH_CORES)) {
+            result.affinityDispatchCores_ = parseCpuList(params.get<std::string>(PARAM_NAME_AFFINITY_DISPATCH_CORES));
+        }
+
+        if (params.count(PARAM_NAME_AFFINITY_WORKER_CORES)) {
+            result.affinityWorkerCores_ = parseCpuList(params.get<std::string>(PARAM_NAME_AFFINITY_WORKER_CORES));
+        }
+
         result.connectionBandwidth_ = params.count(PARAM_NAME_CONNECTION_BANDWIDTH) ? params.get<uint64_t>(PARAM_NAME_CONNECTION_BANDWIDTH) : DEFAULT_CONNECTION_BANDWIDTH;
         result.observerWaitTime_ = params.count(PARAM_NAME_OBSERVER_WAIT_TIME) ? params.get<uint64_t>(PARAM_NAME_OBSERVER_WAIT_TIME) : DEFAULT_OBSERVER_WAIT_TIME;
         result.roundElapseTime_ = params.count(PARAM_NAME_ROUND_ELAPSE_TIME) ? params.get<uint64_t>(PARAM_NAME_ROUND_ELAPSE_TIME) : DEFAULT_ROUND_ELAPSE_TIME;
@@ -962,6 +1098,8 @@ void Config::readStorageData(const boost::property_tree::ptree& config) {
         storageData_.checkpointEvery = 1000;
     }
     checkAndSaveValue(data, block, PARAM_NAME_STORAGE_CHECKPOINT_EVERY_MINUTES, storageData_.checkpointEveryMinutes);
+    checkAndSaveValue(data, block, PARAM_NAME_STORAGE_ARCHIVE_HORIZON, storageData_.archiveHorizonBlocks);
+    checkAndSaveValue(data, block, PARAM_NAME_STORAGE_WRITE_BEHIND, storageData_.writeBehindBlocks);
 }
 
 void Config::readApiData(const boost::property_tree::ptree& config) {
@@ -974,6 +1112,9 @@ void Config::readApiData(const boost::property_tree::ptree& config) {
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_API_PORT, apiData_.port);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_AJAX_PORT, apiData_.ajaxPort);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_DIAG_PORT, apiData_.diagPort);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_METRICS_PORT, apiData_.metricsPort);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_WALLETS_EXPORT_PORT, apiData_.walletsExportPort);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_RECEIPTS_PUSH_PORT, apiData_.receiptsPushPort);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_PORT, apiData_.executorPort);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_SEND_TIMEOUT, apiData_.executorSendTimeout);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_RECEIVE_TIMEOUT, apiData_.executorReceiveTimeout);
@@ -981,10 +1122,15 @@ void Config::readApiData(const boost::property_tree::ptree& config) {
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_BACKGROUND_THREAD_DELAY, apiData_.executorBackgroundThreadDelay);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_CHECK_VERSION_DELAY, apiData_.executorCheckVersionDelay);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_MULTI_INSTANCE, apiData_.executorMultiInstance);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_GETTER_CONNECTIONS, apiData_.executorGetterConnections);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_SERVER_SEND_TIMEOUT, apiData_.serverSendTimeout);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_SERVER_RECEIVE_TIMEOUT, apiData_.serverReceiveTimeout);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_AJAX_SERVER_SEND_TIMEOUT, apiData_.ajaxServerSendTimeout);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_AJAX_SERVER_RECEIVE_TIMEOUT, apiData_.ajaxServerReceiveTimeout);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_API_MAX_CONNECTIONS_PER_IP, apiData_.maxConnectionsPerIp);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_API_MAX_REQUESTS_PER_SECOND_PER_IP, apiData_.maxRequestsPerSecondPerIp);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_API_NONBLOCKING_SERVER, apiData_.nonblockingServer);
+    checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_API_NONBLOCKING_WORKER_THREADS, apiData_.nonblockingWorkerThreads);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_APIEXEC_PORT, apiData_.apiexecPort);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_VERSION_COMMIT_MIN, apiData_.executorCommitMin);
     checkAndSaveValue(data, BLOCK_NAME_API, PARAM_NAME_EXECUTOR_VERSION_COMMIT_MAX, apiData_.executorCommitMax);
@@ -1012,6 +1158,10 @@ void Config::readConveyerData(const boost::property_tree::ptree& config) {
     const boost::property_tree::ptree& data = config.get_child(BLOCK_NAME_CONVEYER);
 
     checkAndSaveValue(data, BLOCK_NAME_CONVEYER, PARAM_NAME_CONVEYER_MAX_PACKET_LIFETIME, conveyerData_.maxPacketLifeTime);
+    checkAndSaveValue(data, BLOCK_NAME_CONVEYER, PARAM_NAME_CONVEYER_PACKET_COALESCE_TIME, conveyerData_.packetCoalesceTimeMs);
+    checkAndSaveValue(data, BLOCK_NAME_CONVEYER, PARAM_NAME_CONVEYER_MAX_CACHED_MEMORY, conveyerData_.maxCachedMemoryMb);
+    checkAndSaveValue(data, BLOCK_NAME_CONVEYER, PARAM_NAME_CONVEYER_EARLY_FLUSH_TRANSACTIONS, conveyerData_.earlyFlushTransactions);
+    checkAndSaveValue(data, BLOCK_NAME_CONVEYER, PARAM_NAME_CONVEYER_EARLY_FLUSH_KB, conveyerData_.earlyFlushKb);
 }
 
 void Config::readEventsReportData(const boost::property_tree::ptree& config) {
@@ -1045,6 +1195,7 @@ void Config::readEventsReportData(const boost::property_tree::ptree& config) {
     checkAndSaveValue(data, BLOCK_NAME_EVENT_REPORTER, PARAM_NAME_EVENTS_REJECT_CONTRACT_EXECUTION, eventsReport_.reject_contract_execution);
     checkAndSaveValue(data, BLOCK_NAME_EVENT_REPORTER, PARAM_NAME_EVENTS_REJECT_CONTRACT_CONSENSUS, eventsReport_.reject_contract_consensus);
     checkAndSaveValue(data, BLOCK_NAME_EVENT_REPORTER, PARAM_NAME_EVENTS_ALARM_INVALID_BLOCK, eventsReport_.alarm_invalid_block);
+    checkAndSaveValue(data, BLOCK_NAME_EVENT_REPORTER, PARAM_NAME_EVENTS_ROUND_STALL_TRACE, eventsReport_.round_stall_trace);
 }
 
 void Config::readDbSQLData(const boost::property_tree::ptree& config) {
@@ -1117,18 +1268,26 @@ bool operator==(const ApiData& lhs, const ApiData& rhs) {
            lhs.ajaxPort == rhs.ajaxPort &&
            lhs.executorPort == rhs.executorPort &&
            lhs.apiexecPort == rhs.apiexecPort &&
+           lhs.metricsPort == rhs.metricsPort &&
+           lhs.walletsExportPort == rhs.walletsExportPort &&
+           lhs.receiptsPushPort == rhs.receiptsPushPort &&
            lhs.executorSendTimeout == rhs.executorSendTimeout &&
            lhs.executorReceiveTimeout == rhs.executorReceiveTimeout &&
            lhs.serverSendTimeout == rhs.serverSendTimeout &&
            lhs.serverReceiveTimeout == rhs.serverReceiveTimeout &&
            lhs.ajaxServerSendTimeout == rhs.ajaxServerSendTimeout &&
            lhs.ajaxServerReceiveTimeout == rhs.ajaxServerReceiveTimeout &&
+           lhs.nonblockingServer == rhs.nonblockingServer &&
+           lhs.nonblockingWorkerThreads == rhs.nonblockingWorkerThreads &&
            lhs.executorHost == rhs.executorHost &&
            lhs.executorCmdLine == rhs.executorCmdLine &&
            lhs.executorRunDelay == rhs.executorRunDelay &&
            lhs.executorBackgroundThreadDelay == rhs.executorBackgroundThreadDelay &&
            lhs.executorCheckVersionDelay == rhs.executorCheckVersionDelay &&
            lhs.executorMultiInstance == rhs.executorMultiInstance &&
+           lhs.executorGetterConnections == rhs.executorGetterConnections &&
+           lhs.maxConnectionsPerIp == rhs.maxConnectionsPerIp &&
+           lhs.maxRequestsPerSecondPerIp == rhs.maxRequestsPerSecondPerIp &&
            lhs.executorCommitMin == rhs.executorCommitMin &&
            lhs.executorCommitMax == rhs.executorCommitMax &&
            lhs.jpsCmdLine == rhs.jpsCmdLine;
@@ -1139,7 +1298,11 @@ bool operator!=(const ApiData& lhs, const ApiData& rhs) {
 }
 
 bool operator==(const ConveyerData& lhs, const ConveyerData& rhs) {
-    return lhs.maxPacketLifeTime == rhs.maxPacketLifeTime;
+    return lhs.maxPacketLifeTime == rhs.maxPacketLifeTime &&
+           lhs.packetCoalesceTimeMs == rhs.packetCoalesceTimeMs &&
+           lhs.maxCachedMemoryMb == rhs.maxCachedMemoryMb &&
+           lhs.earlyFlushTransactions == rhs.earlyFlushTransactions &&
+           lhs.earlyFlushKb == rhs.earlyFlushKb;
 }
 
 bool operator!=(const ConveyerData& lhs, const ConveyerData& rhs) {
@@ -1160,6 +1323,7 @@ bool operator==(const EventsReportData& lhs, const EventsReportData rhs) {
         lhs.reject_contract_consensus == rhs.reject_contract_consensus &&
         lhs.reject_contract_execution == rhs.reject_contract_execution &&
         lhs.reject_transaction == rhs.reject_transaction &&
+        lhs.round_stall_trace == rhs.round_stall_trace &&
         lhs.collector_id == rhs.collector_id;
 }
 
@@ -36,6 +36,11 @@ const uint32_t DEFAULT_ROUND_ELAPSE_TIME = 1000 * 60; // ms
 const uint32_t DEFAULT_STORE_BLOCK_ELAPSE_TIME = 1000 * 40; // ms
 
 const size_t DEFAULT_CONVEYER_MAX_PACKET_LIFETIME = 30; // rounds
+const size_t DEFAULT_CONVEYER_PACKET_COALESCE_TIME_MS = 300;
+const size_t DEFAULT_CONVEYER_MAX_CACHED_MEMORY_MB = 256;
+const size_t DEFAULT_CONVEYER_EARLY_FLUSH_TRANSACTIONS = 300;
+const size_t DEFAULT_CONVEYER_EARLY_FLUSH_KB = 256;
+const uint64_t DEFAULT_PACKET_TRACE_SIZE_MB = 256;
 
 using Port = short unsigned;
 
@@ -62,6 +67,8 @@ struct StorageData {
     size_t checkpointKeep = 5;              // retained periodic checkpoints (qs/0 always kept on top)
     size_t checkpointEvery = 500'000;       // blocks between periodic checkpoints (rolling history depth = checkpointEvery * checkpointKeep)
     size_t checkpointEveryMinutes = 0;      // wall-clock fallback: also save if this many minutes elapsed since last save (0 = disabled; opt-in for slow networks)
+    size_t archiveHorizonBlocks = 0;        // blocks deeper than this are re-packed into the compressed cold tier (0 = disabled)
+    size_t writeBehindBlocks = 0;           // write-behind queue depth for observer/API nodes, sync runs ahead of the disk by up to this many blocks (0 = synchronous writes)
 };
 
 struct ApiData {
@@ -75,18 +82,29 @@ struct ApiData {
     uint16_t apiexecPort = 9070;
     // off by default:
     uint16_t diagPort = 0; // former 9060;
+    // off by default:
+    uint16_t metricsPort = 0; // plain HTTP scrape endpoint, prometheus text format
+    // off by default:
+    uint16_t walletsExportPort = 0; // bulk wallet snapshot stream, framed binary batches over raw TCP
+    // off by default:
+    uint16_t receiptsPushPort = 0; // transaction inclusion push subscriptions over raw TCP
     int executorSendTimeout = 4000;
     int executorReceiveTimeout = 4000;
     int serverSendTimeout = 30000;
     int serverReceiveTimeout = 30000;
     int ajaxServerSendTimeout = 30000;
     int ajaxServerReceiveTimeout = 30000;
+    bool nonblockingServer = false;         // serve public API via TNonblockingServer, needs node built with API_NONBLOCKING_SERVER; clients must speak framed transport
+    uint32_t nonblockingWorkerThreads = 0;  // worker pool size for the nonblocking server, 0 picks the core count
     std::string executorHost{ "localhost" };
     std::string executorCmdLine{};
     int executorRunDelay = 100;
     int executorBackgroundThreadDelay = 100;
     int executorCheckVersionDelay = 5000;
     bool executorMultiInstance = false;
+    int executorGetterConnections = 2;  // dedicated connections for read-only executions, 0 disables the fast lane
+    int maxConnectionsPerIp = 0;        // public API admission: simultaneous connections allowed per client address, 0 removes the cap
+    int maxRequestsPerSecondPerIp = 0;  // public API admission: request pacing per client address, 0 disables pacing
     int executorCommitMin = 1506;   // first commit with support of checking
     int executorCommitMax{-1};      // unlimited range on the right
     std::string jpsCmdLine = "jps";
@@ -94,6 +112,20 @@ struct ApiData {
 
 struct ConveyerData {
     size_t maxPacketLifeTime = DEFAULT_CONVEYER_MAX_PACKET_LIFETIME;
+
+    // how long a partially filled tail packet may wait for more single
+    // transactions before it is flushed, 0 disables coalescing
+    size_t packetCoalesceTimeMs = DEFAULT_CONVEYER_PACKET_COALESCE_TIME_MS;
+
+    // byte budget for conveyer packet caches in megabytes, 0 disables
+    // eviction and memory pressure admission
+    size_t maxCachedMemoryMb = DEFAULT_CONVEYER_MAX_CACHED_MEMORY_MB;
+
+    // watermarks for flushing the packet queue ahead of the sending timer:
+    // once either the queued transaction count or the queued kilobytes is
+    // reached mid-tick, packets go out immediately; 0 disables a watermark
+    size_t earlyFlushTransactions = DEFAULT_CONVEYER_EARLY_FLUSH_TRANSACTIONS;
+    size_t earlyFlushKb = DEFAULT_CONVEYER_EARLY_FLUSH_KB;
 };
 
 struct EventsReportData {
@@ -129,6 +161,8 @@ struct EventsReportData {
     bool reject_contract_consensus = true;
     // invalid block detected by node
     bool alarm_invalid_block = true;
+    // sampled stacks of service threads captured during an overlong round
+    bool round_stall_trace = true;
 };
 
 struct DbSQLData {
@@ -284,6 +318,30 @@ public:
         return idleMode_;
     }
 
+    // warm spare: the node syncs and applies blocks as usual, keeping all
+    // caches hot, but never offers itself as a trusted candidate until it is
+    // switched to full operation through the diagnostic API
+    bool isStandbyMode() const {
+        return standbyMode_;
+    }
+
+    // permanent observer/API box: unlike standby there is no way back to full
+    // duty, so consensus-only subsystems are not even fed at dispatch
+    bool isObserverMode() const {
+        return observerMode_;
+    }
+
+    // read replica serving the API: the observer profile plus a neighbourhood
+    // pinned to the configured upstream nodes, so replicas scale without
+    // occupying slots in the general P2P topology
+    bool isApiReplicaMode() const {
+        return apiReplicaMode_;
+    }
+
+    const std::vector<cs::PublicKey>& getReplicaUpstream() const {
+        return replicaUpstream_;
+    }
+
     uint64_t maxUncorrectedBlock() const {
         return maxUncorrectedBlock_;
     }
@@ -296,6 +354,42 @@ public:
         return daemonMode_;
     }
 
+    const std::string& getPacketTraceFile() const {
+        return packetTraceFile_;
+    }
+
+    uint64_t getPacketTraceSizeMb() const {
+        return packetTraceSizeMb_;
+    }
+
+    const std::string& getReplayTraceFile() const {
+        return replayTraceFile_;
+    }
+
+    uint64_t getReplayTraceSpeed() const {
+        return replayTraceSpeed_;
+    }
+
+    uint64_t getSyncCheckpointSequence() const {
+        return syncCheckpointSequence_;
+    }
+
+    const std::string& getSyncCheckpointHash() const {
+        return syncCheckpointHash_;
+    }
+
+    const std::vector<uint16_t>& getAffinityNetworkCores() const {
+        return affinityNetworkCores_;
+    }
+
+    const std::vector<uint16_t>& getAffinityDispatchCores() const {
+        return affinityDispatchCores_;
+    }
+
+    const std::vector<uint16_t>& getAffinityWorkerCores() const {
+        return affinityWorkerCores_;
+    }
+
     uint64_t newBlockchainTopSeq() const {
         return newBlockchainTopSeq_;
     }
@@ -347,6 +441,14 @@ public:
         ;
     }
 
+    const std::string& getSnapshotExportPath() const {
+        return snapshotExportPath_;
+    }
+
+    const std::string& getSnapshotImportPath() const {
+        return snapshotImportPath_;
+    }
+
 
 private:
     static Config readFromFile(const std::string& fileName);
@@ -416,9 +518,29 @@ private:
     uint64_t newBlockchainTopSeq_;
     bool generateFork_ = false;
     bool idleMode_ = false;
+    bool standbyMode_ = false;
+    bool observerMode_ = false;
+    bool apiReplicaMode_ = false;
+    std::vector<cs::PublicKey> replicaUpstream_;
 
     bool daemonMode_ = false;
 
+    // message stream capture/replay, see Transport::replayTrace()
+    std::string packetTraceFile_;
+    uint64_t packetTraceSizeMb_ = DEFAULT_PACKET_TRACE_SIZE_MB;
+    std::string replayTraceFile_;
+    uint64_t replayTraceSpeed_ = 1;
+
+    // trusted checkpoint for deep-history sync: blocks up to the sequence skip
+    // group signature re-verification, the checkpoint block must match the hash
+    uint64_t syncCheckpointSequence_ = 0;
+    std::string syncCheckpointHash_;
+
+    // NUMA-aware placement of the processing domains, empty means no pinning
+    std::vector<uint16_t> affinityNetworkCores_;
+    std::vector<uint16_t> affinityDispatchCores_;
+    std::vector<uint16_t> affinityWorkerCores_;
+
     uint64_t observerWaitTime_ = DEFAULT_OBSERVER_WAIT_TIME;
     uint64_t roundElapseTime_ = DEFAULT_ROUND_ELAPSE_TIME;
     uint64_t storeBlockElapseTime_ = DEFAULT_STORE_BLOCK_ELAPSE_TIME;
@@ -430,6 +552,9 @@ private:
     cs::PublicKey showBalanceChangeKey_;
     std::string showBalanceChangeAddress_;
 
+    std::string snapshotExportPath_;
+    std::string snapshotImportPath_;
+
     std::vector<std::pair<cs::RoundNumber, cs::RoundNumber>> stakingRoundRanges_;
 
     std::vector<std::pair<cs::RoundNumber, cs::RoundNumber>> miningRoundRanges_;
@@ -8,6 +8,8 @@ struct cmdline {
     static constexpr const char* argDumpKeys = "dumpkeys";
     static constexpr const char* argSetBCTop = "set-bc-top";
     static constexpr const char* argBalChange = "bal-change";
+    static constexpr const char* argExportSnapshot = "export-snapshot";
+    static constexpr const char* argImportSnapshot = "import-snapshot";
 #ifdef _WIN32
     static constexpr const char* argInstall   = "install";
     static constexpr const char* argUninstall = "uninstall";
@@ -9,6 +9,7 @@
 #include <params.hpp>
 #include <lib/system/service/service.hpp>
 #include <csnode/node.hpp>
+#include <metricsexporter.hpp>
 #include <observer.hpp>
 
 #include <boost/program_options.hpp>
@@ -37,6 +38,10 @@ protected:
 
 private:
     Service                                service_;
+    // owned here rather than by the API connector so the scrape endpoint is
+    // already serving startup progress while the Node constructor replays
+    // the blockchain
+    std::unique_ptr<cs::MetricsExporter>   metricsExporter_;
     std::unique_ptr<Node>                  node_;
     std::unique_ptr<config::Observer>      observer_;
     Config&                                config_;
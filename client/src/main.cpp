@@ -53,6 +53,8 @@ int main(int argc, char* argv[]) {
         (cmdline::argSeed, "enter with seed instead of keys")
         (cmdline::argSetBCTop, po::value<uint64_t>(), "all blocks in blockchain with higher sequence will be removed")
         (cmdline::argBalChange, po::value<std::string>(), "prints all changes in account balance in log file")
+        (cmdline::argExportSnapshot, po::value<std::string>(), "export a signed state snapshot to the specified file and exit")
+        (cmdline::argImportSnapshot, po::value<std::string>(), "import a signed state snapshot before starting; only blocks past the snapshot are synced")
         ("disable-auto-shutdown", "node will be prohibited to shutdown in case of fatal errors")
         ("version", "show node version")
         ("db-path", po::value<std::string>(), "path to DB (default: \"db/\")")
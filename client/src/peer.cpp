@@ -116,19 +116,28 @@ bool Peer::onInit(const char*) {
         &cs::ConfigHolder::onConfigChanged
     );
 
+    // bring the metrics endpoint up before the Node constructor starts the
+    // (possibly hours-long) blockchain replay; until attachNode() it serves
+    // only the startup progress counters, which is exactly what an external
+    // watchdog needs to tell a working start from a hung one
+    metricsExporter_ = std::make_unique<cs::MetricsExporter>();
+    metricsExporter_->run();
+
     node_ = std::make_unique<Node>(*observer_);
     if (!node_->isGood()) {
         cserror() << "Node is not good after init";
-        return false;        
+        return false;
     }
 
+    metricsExporter_->attachNode(*node_);
+
     cslog() << "Node initialized successfully";
 
     return true;
 }
 
 bool Peer::onRun(const char*) {
-    if (vm_.count(cmdline::argSetBCTop) == 0) {
+    if (vm_.count(cmdline::argSetBCTop) == 0 && vm_.count(cmdline::argExportSnapshot) == 0) {
         cslog() << "Running Node";
         node_->run();
     }
@@ -139,6 +148,10 @@ bool Peer::onRun(const char*) {
 
     cslog() << "Node stopped";
     node_->stop();   // idempotent; ensures stop ordering even if run() returned via a non-stop path
+    if (metricsExporter_) {
+        // joined before the node goes away, render() must not outlive it
+        metricsExporter_->stop();
+    }
     cslog() << "Destroying Node";
     node_->destroy();
     node_.reset(nullptr);
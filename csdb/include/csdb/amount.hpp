@@ -402,6 +402,79 @@ struct Amount::amount_full<'.', s...>
   static constexpr const Amount value() {return Amount{static_cast<int32_t>(integral), fraction};}
 };
 
+/**
+ * @brief Deferred-normalization accumulator for summing many \ref Amount values.
+ *
+ * operator+=() of \ref Amount performs the fraction carry on every addition. The accumulator
+ * keeps separate 64-bit integral and fraction lanes and carries only once per kCarryPeriod
+ * additions and once more in value(). The carry-free inner loop of the span add() overload
+ * is a plain pair of 64-bit integer additions per element, which compilers vectorize.
+ */
+class AmountAccumulator {
+public:
+    inline constexpr AmountAccumulator() = default;
+
+    inline constexpr void add(const Amount& value) noexcept {
+        integral_ += value.integral();
+        fraction_ += value.fraction();
+        if (++pending_ == kCarryPeriod) {
+            carry();
+        }
+    }
+
+    inline constexpr void add(const Amount* values, std::size_t count) noexcept {
+        while (count != 0) {
+            std::size_t run = kCarryPeriod - pending_;
+            if (run > count) {
+                run = count;
+            }
+            for (std::size_t i = 0; i < run; ++i) {
+                integral_ += values[i].integral();
+                fraction_ += values[i].fraction();
+            }
+            values += run;
+            count -= run;
+            pending_ += run;
+            if (pending_ == kCarryPeriod) {
+                carry();
+            }
+        }
+    }
+
+    inline constexpr AmountAccumulator& operator+=(const Amount& value) noexcept {
+        add(value);
+        return *this;
+    }
+
+    /// Normalizes the pending lanes and returns the total
+    inline constexpr Amount value() const noexcept {
+        return Amount(static_cast<int32_t>(integral_ + static_cast<int64_t>(fraction_ / Amount::AMOUNT_MAX_FRACTION)),
+                      fraction_ % Amount::AMOUNT_MAX_FRACTION);
+    }
+
+private:
+    inline constexpr void carry() noexcept {
+        integral_ += static_cast<int64_t>(fraction_ / Amount::AMOUNT_MAX_FRACTION);
+        fraction_ %= Amount::AMOUNT_MAX_FRACTION;
+        pending_ = 0;
+    }
+
+    // a carried fraction lane is below AMOUNT_MAX_FRACTION < 2^60, so 16 further
+    // additions cannot overflow the unsigned 64-bit lane
+    static constexpr const std::size_t kCarryPeriod = 16;
+
+    int64_t integral_ = 0;
+    uint64_t fraction_ = 0;
+    std::size_t pending_ = 0;
+};
+
+/// Sums a span of amounts with a single final normalization
+inline constexpr Amount accumulate(const Amount* values, std::size_t count) noexcept {
+    AmountAccumulator accumulator;
+    accumulator.add(values, count);
+    return accumulator.value();
+}
+
 }  // namespace csdb
 
 inline constexpr csdb::Amount operator +(const int32_t a, const csdb::Amount& b)
@@ -45,9 +45,28 @@ public:
     using ItemList = std::vector<Item>;
     virtual bool write_batch(const ItemList& items) = 0;
 
+    struct SequencedItem {
+        cs::Bytes key;
+        uint32_t seq_no;
+        cs::Bytes value;
+    };
+    using SequencedItemList = std::vector<SequencedItem>;
+
+    // stores a group of blocks; default implementation falls back to put()
+    // per item, backends may override to commit the whole group at once
+    virtual bool putBatch(const SequencedItemList& items);
+
     virtual bool updateContractData(const cs::Bytes& key, const cs::Bytes& data) = 0;
     virtual bool getContractData(const cs::Bytes& key, cs::Bytes& data) = 0;
 
+    // makes pending contract-state updates durable in the backing store;
+    // default is a no-op for backends that write synchronously
+    virtual void flushContractData() {}
+
+    // blocks deeper than the horizon may be re-packed into a compressed cold
+    // tier; 0 (the default for backends without one) disables archiving
+    virtual void setBlocksArchiveHorizon(uint32_t) {}
+
     class Iterator {
     protected:
         Iterator();
@@ -7,7 +7,13 @@
 #define _CREDITS_CSDB_DATABASE_BERKELEY_H_INCLUDED_
 
 #include <db_cxx.h>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 
 #include <csdb/database.hpp>
@@ -20,6 +26,10 @@ struct Options;
 
 namespace csdb {
 
+namespace priv {
+class BlockArchive;
+}  // namespace priv
+
 class DatabaseBerkeleyDB : public Database {
 public:
     DatabaseBerkeleyDB();
@@ -31,6 +41,7 @@ public:
 private:
     bool is_open() const final;
     bool put(const cs::Bytes& key, uint32_t seq_no, const cs::Bytes& value) final;
+    bool putBatch(const SequencedItemList& items) final;
     bool get(const cs::Bytes& key, cs::Bytes* value) final;
     bool get(const uint32_t seq_no, cs::Bytes* value) final;
     bool remove(const cs::Bytes&) final;
@@ -40,6 +51,8 @@ private:
 
     bool updateContractData(const cs::Bytes& key, const cs::Bytes& data) override;
     bool getContractData(const cs::Bytes& key, cs::Bytes& data) override;
+    void flushContractData() override;
+    void setBlocksArchiveHorizon(uint32_t horizon) override;
 
     void logfile_routine();
 
@@ -50,12 +63,54 @@ private:
     void set_last_error_from_berkeleydb(int status);
 
 private:
+    bool writeContractDataDirect(const cs::Bytes& key, const cs::Bytes& data);
+    bool appendContractJournal(const cs::Bytes& key, const cs::Bytes& data);
+    void replayContractJournal();
+    void archiveColdBlocks();
+    void compactBlocksDb();
+    bool foregroundIsBusy();
+
+    void rememberSeqNo(const cs::Bytes& key, uint32_t stored);
+    bool lookupSeqNo(const cs::Bytes& key, uint32_t& stored);
+    void forgetSeqNo(const cs::Bytes& key);
+
     DbEnv env_;
     std::unique_ptr<Db> db_blocks_;
     std::unique_ptr<Db> db_seq_no_;
     std::unique_ptr<Db> db_contracts_;
     std::thread logfile_thread_;
     bool quit_ = false;
+
+    // write-back contract-state cache: updates gather here and in the journal,
+    // flushContractData() commits them to db_contracts_ in one transaction
+    std::mutex contractsCacheMutex_;
+    std::map<cs::Bytes, cs::Bytes> contractsPending_;
+    std::string contractsJournalPath_;
+    std::ofstream contractsJournal_;
+
+    // bounded hash -> stored-sequence index: db_blocks_ is recno, so once the
+    // sequence is known a block read is a single descent (or an O(1) archive
+    // lookup); this index spares the db_seq_no_ descent for recently written
+    // and recently resolved hashes, FIFO-evicted at kHashIndexLimit entries
+    constexpr static size_t kHashIndexLimit = 65536;
+    std::mutex hashIndexMutex_;
+    std::map<cs::Bytes, uint32_t> hashIndex_;
+    std::deque<cs::Bytes> hashIndexOrder_;
+
+    // cold tier: blocks deeper than the horizon are re-packed into immutable
+    // compressed segments and deleted from db_blocks_; gets fall through here
+    std::unique_ptr<priv::BlockArchive> archive_;
+    std::atomic<uint32_t> blocksCount_ = { 0 };      // highest stored sequence + 1
+    std::atomic<uint32_t> archiveHorizon_ = { 0 };   // 0 disables archiving
+
+    // background maintenance (archiving, b-tree compaction) yields to
+    // foreground traffic: every database call bumps the counter and a
+    // maintenance pass runs only when the interval since the previous pass
+    // stayed below kBusyForegroundOps calls
+    constexpr static uint64_t kBusyForegroundOps = 256;
+    constexpr static uint32_t kCompactPagesPerPass = 128;
+    std::atomic<uint64_t> foregroundOps_ = { 0 };
+    uint64_t opsAtLastMaintenance_ = 0;              // touched by the maintenance thread only
 };
 
 }  // namespace csdb
@@ -35,9 +35,14 @@ class obstream;
 class ibstream;
 }  // namespace priv
 
+///
+/// Hash of a pool. The value is kept inline as a fixed array instead of a
+/// shared_data block: hashes are copied, moved and compared in huge numbers
+/// during database reading and hash-chain verification, and the former
+/// heap node plus reference counter dominated those paths. The class is
+/// trivially copyable, so containers of hashes relocate with memmove.
+///
 class PoolHash {
-    SHARED_DATA_CLASS_DECLARE(PoolHash)
-
 public:
     bool is_empty() const noexcept;
     size_t size() const noexcept;
@@ -68,21 +73,33 @@ public:
 
     static PoolHash calc_from_data(const cs::Bytes& data);
 
+    // kept for uniformity with the shared_data classes; a copy is already deep
+    PoolHash clone() const noexcept {
+        return *this;
+    }
+
 private:
     void put(::csdb::priv::obstream&) const;
     bool get(::csdb::priv::ibstream&);
     friend class ::csdb::priv::obstream;
     friend class ::csdb::priv::ibstream;
     friend class Storage;
-};
 
-class PoolHash::priv : public ::csdb::internal::shared_data {
-public:
-    cs::Bytes value;
-    DEFAULT_PRIV_CLONE();
+    // bytes beyond size_ are always zero, so equal-sized hashes compare
+    // as whole arrays
+    ::std::array<cs::Byte, cscrypto::kHashSize> value_{};
+    uint8_t size_ = 0;  // 0 (empty hash) or cscrypto::kHashSize
 };
-SHARED_DATA_CLASS_IMPLEMENTATION_INLINE(PoolHash)
 
+///
+/// Pool copies are copy-on-write: a copy shares the whole body, including
+/// transaction storage, and a writer detaches onto its own data before the
+/// first mutation. Prefer a plain copy for snapshots served to readers
+/// (sync replies, store events) - it is a reference-count bump. clone()
+/// forces an immediate deep copy down to every transaction and is only
+/// needed when the copy must not share anything with the source, e.g. for
+/// in-place edits through previously stored references.
+///
 class Pool {
     SHARED_DATA_CLASS_DECLARE(Pool)
 public:
@@ -147,6 +164,23 @@ public:
 
     static PoolHash hash_from_binary(cs::Bytes&& data);
     static Pool from_binary(cs::Bytes&& data, bool makeReadOnly = true);
+
+    /**
+     * @brief Creates pool from binary representation parsing the header only.
+     *
+     * Sequence, previous hash, user fields, round cost and transactions count
+     * are available immediately; transactions, wallets, confidants and
+     * signatures are materialized from the kept binary representation on
+     * first access (including hash(), since the hashing length is stored
+     * after the transactions).
+     */
+    static Pool from_binary_lazy(cs::Bytes&& data);
+
+    /**
+     * @brief Returns true while the pool body is not materialized yet.
+     */
+    bool isLazy() const noexcept;
+
     static Pool meta_from_binary(cs::Bytes&& data, size_t& cnt);
     static Pool load(const PoolHash& hash, Storage storage = Storage());
 
@@ -215,6 +249,17 @@ public:
 #endif
     );
 
+    /**
+     * @brief Adds a run of transactions to pool.
+     * @param[in] begin first transaction of the run
+     * @param[in] end one past the last transaction of the run
+     * @return true, if all transactions were added. false, if any of them was invalid and skipped
+     *
+     * Bulk variant of \ref add_transaction: storage is reserved once for the whole run,
+     * so large accepted runs avoid repeated reallocation.
+     */
+    bool add_transactions(Transactions::const_iterator begin, Transactions::const_iterator end);
+
     /**
      * @brief Finalize the pool creation.
      * @return true, if the binary representation is formed for the current pool
@@ -192,6 +192,33 @@ public:
      */
     bool pool_save(Pool pool);
 
+    /**
+     * @brief writes a contiguous chain segment into the storage
+     * @param[in] pools Pools to be stored, ordered by sequence; the first pool
+     *            must continue the current last hash
+     * @return number of pools actually stored. The accepted prefix is written
+     *         as a single database transaction with one sync.
+     *
+     * \sa ::csdb::Storage::pool_save
+     */
+    size_t pool_save_batch(std::vector<Pool>& pools);
+
+    /**
+     * @brief Switches pool_save to write-behind: blocks enqueue to an ordered
+     *        writer thread (at most \p blocks entries, producers block on a
+     *        full queue) that commits them in groups. Recent blocks stay
+     *        readable through the pool cache and the write queue. 0 (the
+     *        default) restores the synchronous per-block path.
+     */
+    void set_write_behind(size_t blocks) const;
+
+    /**
+     * @brief Blocks until every queued write-behind block is committed; no-op
+     *        in synchronous mode. Call before taking a state checkpoint so it
+     *        never references blocks that are not yet on disk.
+     */
+    void flush_write_behind() const;
+
     /**
      * @brief Loads pool form the storage/ overloaded method
      * @param[in]   hash - hash of pool to be loaded,
@@ -206,6 +233,20 @@ public:
     Pool pool_load(const cs::Sequence sequence) const;
     Pool pool_load_meta(const PoolHash& hash, size_t& cnt) const;
 
+    /**
+     * @brief Loads a consecutive range of pools with a single database cursor.
+     * @param[in]   fromSeq - sequence of the first pool of the range,
+     *              count - number of pools requested.
+     * @return Loaded pools in sequence order. The result is shorter than count
+     *         if the range runs past the stored chain or hits a record that
+     *         cannot be decoded; every returned pool is valid.
+     *
+     * Consecutive records are read by one cursor walk instead of a key lookup
+     * per block, which is what serving block requests to syncing peers spends
+     * most of its time on.
+     */
+    std::vector<Pool> pool_load_range(const cs::Sequence fromSeq, const size_t count) const;
+
     Pool pool_remove_last();
     /**
 	 * @brief Removes last pool form the storage without calculating pool hash. Used in case of data consistancy interrruption,
@@ -304,6 +345,22 @@ public:
 
     bool update_contract_data(const Address& abs_addr /*input*/, const cs::Bytes& data /*input*/) const;
 
+    /**
+     * Commits contract data updates pending in the backend write-back cache.
+     *
+     * Called on round boundaries, so every round pays one sequential write
+     * instead of a synchronous write per updated contract.
+     */
+    void flush_contract_data() const;
+
+    /**
+     * Enables cold-tier archiving of blocks deeper than the given horizon.
+     *
+     * @param   blocks  Minimum distance from the chain top, in blocks; 0
+     *                  (the default) disables archiving.
+     */
+    void set_blocks_archive_horizon(uint32_t blocks) const;
+
     /**
      * Gets from database pool sequence by pool hash
      *
@@ -159,6 +159,18 @@ public:
      */
     UserField user_field(user_field_id_t id) const noexcept;
 
+    /**
+     * @brief Checks whether a user field with id is present.
+     * @param[in] id  user field id
+     * @return  true if the transaction carries the field.
+     *
+     * Unlike \ref user_field this never decodes the field values: for
+     * transactions deserialized from the network the check runs over the
+     * retained wire form, so it is cheap enough for per-transaction
+     * classification (e.g. contract marker probes).
+     */
+    bool contains_user_field(user_field_id_t id) const noexcept;
+
     /**
      * @brief User fields id's list
      * @return  User fields id's list
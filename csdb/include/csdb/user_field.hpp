@@ -55,7 +55,6 @@ constexpr const user_field_id_t UFID_COMMENT = (-1);
  * User fields are used in classes \ref Transaction and \ref Pool.
  */
 class UserField {
-    SHARED_DATA_CLASS_DECLARE(UserField)
 public:
     enum Type : char {
         Unknown = 0,
@@ -64,6 +63,19 @@ public:
         Amount = 3
     };
 
+    /**
+     * The value is stored inline rather than behind a shared_data allocation:
+     * comment and contract marker fields are small and transactions carry maps
+     * of them, so the former copy-on-write indirection cost a heap round trip
+     * per field on every parse and serialize. Short strings live in
+     * ::std::string's own small-buffer storage, only long binary payloads
+     * still allocate.
+     */
+    inline UserField() noexcept
+    : type_(Unknown)
+    , i_value_(0) {
+    }
+
     template <typename T, typename = typename ::std::enable_if<::std::is_integral<T>::value>::type>
     UserField(T value);
     template <typename T, typename = typename ::std::enable_if<!::std::is_integral<T>::value>::type>
@@ -71,6 +83,12 @@ public:
 
     UserField(const char* value);
 
+    /// a copy is already deep, kept for call sites written against the
+    /// former shared_data interface
+    inline UserField clone() const {
+        return *this;
+    }
+
     bool is_valid() const noexcept;
     Type type() const noexcept;
 
@@ -87,47 +105,21 @@ private:
     void put(::csdb::priv::obstream&) const;
     void put_for_sig(::csdb::priv::obstream&) const;
     bool get(::csdb::priv::ibstream&);
-    friend class ::csdb::priv::obstream;
-    friend class ::csdb::priv::ibstream;
-};
 
-class UserField::priv : public ::csdb::internal::shared_data {
-    inline priv()
-    : type_(UserField::Unknown)
-    , i_value_(0) {
-    }
+    // advances the stream over one encoded field without constructing it;
+    // lets the transaction keep user fields in wire form until someone
+    // actually asks for them
+    static bool skip(::csdb::priv::ibstream&);
 
-    inline priv(uint64_t value)
-    : type_(UserField::Integer)
-    , i_value_(value) {
-    }
-
-    inline priv(const ::std::string& value)
-    : type_(UserField::String)
-    , i_value_(0)
-    , s_value_(value) {
-    }
-
-    inline priv(const ::csdb::Amount& value)
-    : type_(UserField::Amount)
-    , i_value_(0)
-    , a_value_(value) {
-    }
-
-    inline void put(::csdb::priv::obstream& os) const;
-    inline void put_for_sig(::csdb::priv::obstream& os) const;
-    inline bool get(::csdb::priv::ibstream& is);
-    inline bool is_equal(const priv* other) const;
-
-    DEFAULT_PRIV_CLONE()
+    friend class ::csdb::priv::obstream;
+    friend class ::csdb::priv::ibstream;
+    friend class Transaction;
 
-    UserField::Type type_;
+    Type type_;
     uint64_t i_value_;
     ::std::string s_value_;
     ::csdb::Amount a_value_;
-    friend class UserField;
 };
-SHARED_DATA_CLASS_IMPLEMENTATION_INLINE(UserField)
 
 inline bool UserField::operator !=(const UserField& other) const noexcept
 {
@@ -14,6 +14,8 @@
 #include <type_traits>
 #include <utility>
 
+#include <boost/container/flat_map.hpp>
+
 #include <csdb/internal/types.hpp>
 
 #include <lib/system/common.hpp>
@@ -41,12 +43,20 @@ public:
     template <class K, class T, class C, class A>
     void put(const ::std::map<K, T, C, A>& value);
 
+    // same wire format as the ::std::map overloads, both containers iterate
+    // in key order
+    template <class K, class T, class C, class A>
+    void put(const ::boost::container::flat_map<K, T, C, A>& value);
+
     template <std::size_t Size>
     void put(const cs::ByteArray<Size>& value);
 
     template <class K, class T, class C, class A>
     void put_smart(const ::std::map<K, T, C, A>& value);
 
+    template <class K, class T, class C, class A>
+    void put_smart(const ::boost::container::flat_map<K, T, C, A>& value);
+
     inline const cs::Bytes& buffer() const {
         return buffer_;
     }
@@ -81,13 +91,40 @@ public:
     template <class K, class T, class C, class A>
     bool get(::std::map<K, T, C, A>& value);
 
+    template <class K, class T, class C, class A>
+    bool get(::boost::container::flat_map<K, T, C, A>& value);
+
     template <std::size_t Size>
     bool get(::cs::ByteArray<Size>& value);
 
+    // current read position; decode shims that alias a region of the
+    // underlying buffer keep this pointer instead of copying the bytes out
+    inline const void* data() const noexcept {
+        return data_;
+    }
+
+    inline bool skip(size_t size) noexcept {
+        if (size > size_) {
+            return false;
+        }
+        data_ = static_cast<const uint8_t*>(data_) + size;
+        size_ -= size;
+        return true;
+    }
+
     inline size_t size() const noexcept {
         return size_;
     }
 
+    // quota guard for count fields read from the wire: a container of
+    // `count` elements, each at least `minElementSize` bytes in serialized
+    // form, cannot come out of the bytes still left in the buffer. Checked
+    // before any reserve(), so a malformed count fails fast instead of
+    // triggering a multi-gigabyte speculative allocation
+    inline bool hasQuotaFor(size_t count, size_t minElementSize) const noexcept {
+        return minElementSize != 0 && count <= size_ / minElementSize;
+    }
+
     inline bool empty() const noexcept {
         return (0 == size_);
     }
@@ -132,6 +169,15 @@ void obstream::put(const cs::ByteArray<Size>& value) {
     buffer_.insert(buffer_.end(), value.begin(), value.end());
 }
 
+template <class K, class T, class C, class A>
+void obstream::put(const ::boost::container::flat_map<K, T, C, A>& value) {
+    put((uint8_t)value.size());
+    for (const auto& it : value) {
+        put(it.first);
+        put(it.second);
+    }
+}
+
 template <class K, class T, class C, class A>
 void obstream::put_smart(const ::std::map<K, T, C, A>& value) {
     put(static_cast<uint8_t>(value.size()));
@@ -140,6 +186,14 @@ void obstream::put_smart(const ::std::map<K, T, C, A>& value) {
     }
 }
 
+template <class K, class T, class C, class A>
+void obstream::put_smart(const ::boost::container::flat_map<K, T, C, A>& value) {
+    put(static_cast<uint8_t>(value.size()));
+    for (const auto& it : value) {
+        put_for_sig(it.second);
+    }
+}
+
 template <typename T>
 typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, bool>::type inline ibstream::get(T& value) {
     if (size_ >= sizeof(T)) {
@@ -180,6 +234,32 @@ bool ibstream::get(::std::map<K, T, C, A>& value) {
     return true;
 }
 
+template <class K, class T, class C, class A>
+bool ibstream::get(::boost::container::flat_map<K, T, C, A>& value) {
+    value.clear();
+
+    uint8_t size;
+    if (!get(size)) {
+        return false;
+    }
+
+    value.reserve(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        K key;
+        if (!get(key)) {
+            return false;
+        }
+        T val;
+        if (!get(val)) {
+            return false;
+        }
+        value.emplace(key, val);
+    }
+
+    return true;
+}
+
 template <std::size_t Size>
 bool ibstream::get(::cs::ByteArray<Size>& value) {
     if (Size > size_) {
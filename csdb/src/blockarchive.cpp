@@ -0,0 +1,265 @@
+#include "blockarchive.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+
+#include <lz4.h>
+
+#include <lib/system/logger.hpp>
+#include <lib/system/mmappedfile.hpp>
+
+namespace {
+constexpr uint32_t kSegmentMagic = 0x52414243;  // "CBAR"
+constexpr uint32_t kSegmentVersion = 1;
+constexpr size_t kMaxMappedSegments = 8;
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t baseSequence;
+    uint32_t count;
+};
+}  // namespace
+
+namespace csdb {
+namespace priv {
+
+struct BlockArchive::Segment {
+    Segment(const std::string& path, size_t fileSize)
+    : file(path, fileSize, false)
+    , size(fileSize) {
+    }
+
+    const char* data() {
+        return file.data<const char>();
+    }
+
+    const SegmentHeader* header() {
+        return reinterpret_cast<const SegmentHeader*>(data());
+    }
+
+    bool isValid(uint32_t baseSequence) {
+        if (!file.isOpen() || size < sizeof(SegmentHeader)) {
+            return false;
+        }
+
+        const SegmentHeader* h = header();
+        if (h->magic != kSegmentMagic || h->version != kSegmentVersion || h->baseSequence != baseSequence || h->count == 0) {
+            return false;
+        }
+
+        const size_t indexSize = sizeof(SegmentHeader) + (size_t(h->count) + 1) * sizeof(uint64_t) + size_t(h->count) * sizeof(uint32_t);
+        return indexSize <= size;
+    }
+
+    cs::MMappedFileWrap<cs::FileSource> file;
+    size_t size;
+};
+
+std::string BlockArchive::segmentFileName(uint32_t baseSequence) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "segment_%010u.dat", baseSequence);
+    return std::string(name);
+}
+
+bool BlockArchive::open(const std::string& dbPath) {
+    directory_ = dbPath + "/archive";
+
+    boost::filesystem::path direc(directory_);
+    if (boost::filesystem::exists(direc)) {
+        if (!boost::filesystem::is_directory(direc)) {
+            return false;
+        }
+    }
+    else {
+        if (!boost::filesystem::create_directories(direc)) {
+            return false;
+        }
+    }
+
+    // coverage is contiguous from sequence 0: walk forward until a segment is
+    // missing; anything past a hole belongs to the live database again
+    std::lock_guard<std::mutex> lock(mutex_);
+    archivedUpTo_ = 0;
+
+    for (;;) {
+        const std::string path = directory_ + "/" + segmentFileName(archivedUpTo_);
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            break;
+        }
+
+        SegmentHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!file.good() || header.magic != kSegmentMagic || header.version != kSegmentVersion ||
+            header.baseSequence != archivedUpTo_ || header.count == 0) {
+            cswarning() << "csdb: invalid archive segment " << path << ", archive coverage stops at " << archivedUpTo_;
+            break;
+        }
+
+        archivedUpTo_ += header.count;
+
+        if (header.count < kSegmentBlocks) {
+            break;  // a partial segment ends the coverage
+        }
+    }
+
+    if (archivedUpTo_ != 0) {
+        cslog() << "csdb: block archive covers sequences [0, " << archivedUpTo_ << ")";
+    }
+
+    return true;
+}
+
+uint32_t BlockArchive::archivedUpTo() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return archivedUpTo_;
+}
+
+std::shared_ptr<BlockArchive::Segment> BlockArchive::segment(uint32_t baseSequence) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (auto it = segments_.find(baseSequence); it != segments_.end()) {
+        return it->second;
+    }
+
+    const std::string path = directory_ + "/" + segmentFileName(baseSequence);
+
+    boost::system::error_code ec;
+    const auto fileSize = boost::filesystem::file_size(path, ec);
+    if (ec) {
+        return nullptr;
+    }
+
+    auto segment = std::make_shared<Segment>(path, size_t(fileSize));
+    if (!segment->isValid(baseSequence)) {
+        cserror() << "csdb: corrupted archive segment " << path;
+        return nullptr;
+    }
+
+    // keep a handful of hot segments mapped
+    if (segments_.size() >= kMaxMappedSegments) {
+        segments_.clear();
+    }
+
+    segments_[baseSequence] = segment;
+    return segment;
+}
+
+bool BlockArchive::get(uint32_t seq_no, cs::Bytes* value) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (seq_no >= archivedUpTo_) {
+            return false;
+        }
+    }
+
+    auto seg = segment(seq_no - (seq_no % kSegmentBlocks));
+    if (!seg) {
+        return false;
+    }
+
+    const char* base = seg->data();
+    const SegmentHeader* header = seg->header();
+
+    const uint32_t index = seq_no - header->baseSequence;
+    if (index >= header->count) {
+        return false;
+    }
+
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(base + sizeof(SegmentHeader));
+    const uint32_t* rawSizes = reinterpret_cast<const uint32_t*>(base + sizeof(SegmentHeader) + (size_t(header->count) + 1) * sizeof(uint64_t));
+
+    const uint64_t from = offsets[index];
+    const uint64_t to = offsets[index + 1];
+    if (from > to || to > seg->size) {
+        cserror() << "csdb: archive segment index out of bounds, sequence " << seq_no;
+        return false;
+    }
+
+    if (value == nullptr) {
+        return true;
+    }
+
+    const uint32_t rawSize = rawSizes[index];
+    value->resize(rawSize);
+
+    const int decoded = LZ4_decompress_safe(base + from, reinterpret_cast<char*>(value->data()), int(to - from), int(rawSize));
+    if (decoded != int(rawSize)) {
+        cserror() << "csdb: archive segment decompression failed, sequence " << seq_no;
+        return false;
+    }
+
+    return true;
+}
+
+bool BlockArchive::appendSegment(const std::vector<cs::Bytes>& blocks) {
+    if (blocks.empty() || blocks.size() > kSegmentBlocks) {
+        return false;
+    }
+
+    uint32_t baseSequence = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        baseSequence = archivedUpTo_;
+    }
+
+    SegmentHeader header{kSegmentMagic, kSegmentVersion, baseSequence, uint32_t(blocks.size())};
+
+    std::vector<uint64_t> offsets(blocks.size() + 1);
+    std::vector<uint32_t> rawSizes(blocks.size());
+    std::vector<char> compressed;
+    std::vector<char> buffer;
+
+    uint64_t offset = sizeof(SegmentHeader) + offsets.size() * sizeof(uint64_t) + rawSizes.size() * sizeof(uint32_t);
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const int rawSize = int(blocks[i].size());
+        const int bound = LZ4_compressBound(rawSize);
+        buffer.resize(size_t(bound));
+
+        const int written = LZ4_compress_default(reinterpret_cast<const char*>(blocks[i].data()), buffer.data(), rawSize, bound);
+        if (written <= 0) {
+            return false;
+        }
+
+        offsets[i] = offset;
+        rawSizes[i] = uint32_t(rawSize);
+        compressed.insert(compressed.end(), buffer.begin(), buffer.begin() + written);
+        offset += uint64_t(written);
+    }
+
+    offsets.back() = offset;
+
+    const std::string temporary = directory_ + "/segment.tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(offsets.data()), std::streamsize(offsets.size() * sizeof(uint64_t)));
+        file.write(reinterpret_cast<const char*>(rawSizes.data()), std::streamsize(rawSizes.size() * sizeof(uint32_t)));
+        file.write(compressed.data(), std::streamsize(compressed.size()));
+        file.flush();
+
+        if (!file.good()) {
+            return false;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(temporary, directory_ + "/" + segmentFileName(baseSequence), ec);
+    if (ec) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    archivedUpTo_ = baseSequence + uint32_t(blocks.size());
+    return true;
+}
+
+}  // namespace priv
+}  // namespace csdb
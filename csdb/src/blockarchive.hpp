@@ -0,0 +1,58 @@
+/**
+ * @file blockarchive.hpp
+ *
+ * Cold tier for the blocks database. Full runs of kSegmentBlocks consecutive
+ * blocks are re-packed into immutable segment files - per-block LZ4 compressed,
+ * with an offset index in the file head - and mmapped on read, so cold reads
+ * turn into sequential page-ins instead of b-tree point lookups.
+ */
+
+#pragma once
+#ifndef _CREDITS_CSDB_PRIVATE_BLOCK_ARCHIVE_H_INCLUDED_
+#define _CREDITS_CSDB_PRIVATE_BLOCK_ARCHIVE_H_INCLUDED_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <csdb/internal/types.hpp>
+
+namespace csdb {
+namespace priv {
+
+class BlockArchive {
+public:
+    enum : uint32_t {
+        kSegmentBlocks = 4096
+    };
+
+    bool open(const std::string& dbPath);
+
+    /// first sequence that is NOT archived; every block below it is served here
+    uint32_t archivedUpTo() const;
+
+    bool get(uint32_t seq_no, cs::Bytes* value) const;
+
+    /// blocks must start exactly at archivedUpTo(); the segment is written to
+    /// a temporary file and renamed into place, a crash never leaves a torn
+    /// segment visible
+    bool appendSegment(const std::vector<cs::Bytes>& blocks);
+
+private:
+    struct Segment;
+
+    std::shared_ptr<Segment> segment(uint32_t baseSequence) const;
+    static std::string segmentFileName(uint32_t baseSequence);
+
+    std::string directory_;
+    mutable std::mutex mutex_;
+    uint32_t archivedUpTo_ = 0;
+    mutable std::map<uint32_t, std::shared_ptr<Segment>> segments_;  // mmap cache
+};
+
+}  // namespace priv
+}  // namespace csdb
+
+#endif  // _CREDITS_CSDB_PRIVATE_BLOCK_ARCHIVE_H_INCLUDED_
@@ -22,6 +22,16 @@ Database::Database() {
 
 Database::~Database() = default;
 
+bool Database::putBatch(const SequencedItemList& items) {
+    for (const auto& item : items) {
+        if (!put(item.key, item.seq_no, item.value)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 Database::Iterator::Iterator() = default;
 
 Database::Iterator::~Iterator() = default;
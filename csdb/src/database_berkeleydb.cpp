@@ -3,12 +3,14 @@
 #include <cstdio>
 #include <cstdlib>
 #include <exception>
+#include <fstream>
 
 #include <boost/filesystem.hpp>
 
 #include <csdb/database_berkeleydb.hpp>
 #include <csdb/pool.hpp>
 
+#include "blockarchive.hpp"
 #include "priv_crypto.hpp"
 
 #include <lib/system/scopeguard.hpp>
@@ -73,6 +75,15 @@ DatabaseBerkeleyDB::DatabaseBerkeleyDB()
 , db_contracts_(nullptr) {}
 
 DatabaseBerkeleyDB::~DatabaseBerkeleyDB() {
+    std::cout << "Attempt to flush pending contract data...\n" << std::flush;
+    flushContractData();
+    if (contractsJournal_.is_open()) {
+        contractsJournal_.close();
+    }
+    if (logfile_thread_.joinable()) {
+        quit_ = true;
+        logfile_thread_.join();
+    }
     std::cout << "Attempt db_blocks_ to close...\n" << std::flush;
     db_blocks_->close(0);
     std::cout << "DB db_blocks_ was closed.\n" << std::flush;
@@ -82,10 +93,6 @@ DatabaseBerkeleyDB::~DatabaseBerkeleyDB() {
     std::cout << "Attempt db_contracts_ to close...\n" << std::flush;
     db_contracts_->close(0);
     std::cout << "DB db_contracts_ was closed.\n" << std::flush;
-    if (logfile_thread_.joinable()) {
-        quit_ = true;
-        logfile_thread_.join();
-    }
     env_.close(0);
 }
 
@@ -94,6 +101,17 @@ void DatabaseBerkeleyDB::logfile_routine() {
     /* Check once every 5 minutes. */
     for (;; std::this_thread::sleep_for(std::chrono::seconds(1))) {
         if (quit_) break;
+        if (cnt % 30 == 0) {
+            // maintenance yields to foreground traffic: a busy interval skips
+            // the pass, the next quiet one resumes where the last left off
+            if (!foregroundIsBusy()) {
+                // at most one segment per pass keeps the i/o burst bounded
+                archiveColdBlocks();
+                compactBlocksDb();
+                // reads the archiver itself issued are not foreground pressure
+                opsAtLastMaintenance_ = foregroundOps_.load(std::memory_order_relaxed);
+            }
+        }
         if (++cnt % 300 == 0) {
             int ret;
             char **begin, **list;
@@ -117,6 +135,41 @@ void DatabaseBerkeleyDB::logfile_routine() {
     }
 }
 
+void DatabaseBerkeleyDB::rememberSeqNo(const cs::Bytes &key, uint32_t stored) {
+    std::lock_guard<std::mutex> lock(hashIndexMutex_);
+
+    auto result = hashIndex_.emplace(key, stored);
+    if (!result.second) {
+        result.first->second = stored;
+        return;
+    }
+
+    hashIndexOrder_.push_back(key);
+
+    while (hashIndexOrder_.size() > kHashIndexLimit) {
+        hashIndex_.erase(hashIndexOrder_.front());
+        hashIndexOrder_.pop_front();
+    }
+}
+
+bool DatabaseBerkeleyDB::lookupSeqNo(const cs::Bytes &key, uint32_t &stored) {
+    std::lock_guard<std::mutex> lock(hashIndexMutex_);
+
+    auto it = hashIndex_.find(key);
+    if (it == hashIndex_.end()) {
+        return false;
+    }
+
+    stored = it->second;
+    return true;
+}
+
+void DatabaseBerkeleyDB::forgetSeqNo(const cs::Bytes &key) {
+    std::lock_guard<std::mutex> lock(hashIndexMutex_);
+    // the stale order entry is harmless, eviction just skips it
+    hashIndex_.erase(key);
+}
+
 void DatabaseBerkeleyDB::set_last_error_from_berkeleydb(int status) {
     Error err = UnknownError;
     if (status == 0) {
@@ -195,6 +248,30 @@ bool DatabaseBerkeleyDB::open(const std::string &path) {
         return false;
     }
 
+    contractsJournalPath_ = path + "/contracts.journal";
+    replayContractJournal();
+    contractsJournal_.open(contractsJournalPath_, std::ios::binary | std::ios::trunc);
+
+    archive_ = std::make_unique<priv::BlockArchive>();
+    if (!archive_->open(path)) {
+        cslog() << "csdb: block archive directory is not usable, cold-tier archiving disabled";
+        archive_.reset();
+    }
+
+    {
+        // remember the newest stored sequence, the archiver needs it to know
+        // which blocks already sank below the horizon
+        Dbc* cursor = nullptr;
+        if (db_blocks_->cursor(nullptr, &cursor, 0) == 0) {
+            Dbt db_key;
+            Dbt_safe db_value;
+            if (cursor->get(&db_key, &db_value, DB_LAST) == 0 && db_key.get_size() == sizeof(uint32_t)) {
+                blocksCount_.store(*static_cast<uint32_t*>(db_key.get_data()));
+            }
+            cursor->close();
+        }
+    }
+
     logfile_thread_ = std::thread(&DatabaseBerkeleyDB::logfile_routine, this);
 
     set_last_error();
@@ -206,6 +283,7 @@ bool DatabaseBerkeleyDB::is_open() const {
 }
 
 bool DatabaseBerkeleyDB::put(const cs::Bytes &key, uint32_t seq_no, const cs::Bytes &value) {
+    foregroundOps_.fetch_add(1, std::memory_order_relaxed);
     if (!db_blocks_) {
         set_last_error(NotOpen);
         return false;
@@ -236,6 +314,71 @@ bool DatabaseBerkeleyDB::put(const cs::Bytes &key, uint32_t seq_no, const cs::By
     }
 
     if (!status) {
+        if (seq_no + 1 > blocksCount_.load()) {
+            blocksCount_.store(seq_no + 1);
+        }
+        rememberSeqNo(key, seq_no + 1);
+        set_last_error();
+        return true;
+    }
+    else {
+        set_last_error_from_berkeleydb(status);
+        return false;
+    }
+}
+
+bool DatabaseBerkeleyDB::putBatch(const SequencedItemList &items) {
+    foregroundOps_.fetch_add(1, std::memory_order_relaxed);
+    if (!db_blocks_) {
+        set_last_error(NotOpen);
+        return false;
+    }
+
+    if (items.empty()) {
+        set_last_error();
+        return true;
+    }
+
+    DbTxn *tid;
+    int status = env_.txn_begin(nullptr, &tid, DB_READ_UNCOMMITTED);
+    int txn_create_status = status;
+    auto g = cs::scopeGuard([&]() {
+        if (txn_create_status) {
+            return;
+        }
+        if (status) {
+            tid->abort();
+        }
+        else {
+            // whole group of blocks becomes durable with a single commit/sync
+            tid->commit(0);
+        }
+    });
+
+    for (const auto &item : items) {
+        if (status) {
+            break;
+        }
+
+        Dbt_copy<uint32_t> db_seq_no(item.seq_no + 1);
+        Dbt_copy<cs::Bytes> db_value(item.value);
+        status = db_blocks_->put(tid, &db_seq_no, &db_value, 0);
+
+        if (!status) {
+            Dbt_copy<cs::Bytes> db_key(item.key);
+            status = db_seq_no_->put(tid, &db_key, &db_seq_no, 0);
+        }
+
+        if (!status && item.seq_no + 1 > blocksCount_.load()) {
+            blocksCount_.store(item.seq_no + 1);
+        }
+    }
+
+    if (!status) {
+        // remember only committed mappings, an aborted group wrote nothing
+        for (const auto &item : items) {
+            rememberSeqNo(item.key, item.seq_no + 1);
+        }
         set_last_error();
         return true;
     }
@@ -246,6 +389,7 @@ bool DatabaseBerkeleyDB::put(const cs::Bytes &key, uint32_t seq_no, const cs::By
 }
 
 bool DatabaseBerkeleyDB::get(const cs::Bytes &key, cs::Bytes *value) {
+    foregroundOps_.fetch_add(1, std::memory_order_relaxed);
     if (!db_blocks_) {
         set_last_error(NotOpen);
         return false;
@@ -256,16 +400,28 @@ bool DatabaseBerkeleyDB::get(const cs::Bytes &key, cs::Bytes *value) {
         return db_seq_no_->exists(nullptr, &db_key, 0) == 0;
     }
 
-    Dbt_copy<uint32_t> db_seq_no;
-    int status = db_seq_no_->get(nullptr, &db_key, &db_seq_no, DB_READ_UNCOMMITTED);
-    if (status) {
-        set_last_error_from_berkeleydb(status);
-        return false;
+    uint32_t stored = 0;
+    if (!lookupSeqNo(key, stored)) {
+        Dbt_copy<uint32_t> db_stored;
+        int resolve_status = db_seq_no_->get(nullptr, &db_key, &db_stored, DB_READ_UNCOMMITTED);
+        if (resolve_status) {
+            set_last_error_from_berkeleydb(resolve_status);
+            return false;
+        }
+
+        stored = *static_cast<uint32_t *>(db_stored.get_data());
+        rememberSeqNo(key, stored);
     }
 
+    if (archive_ && stored != 0 && archive_->get(stored - 1, value)) {
+        set_last_error();
+        return true;
+    }
+
+    Dbt_copy<uint32_t> db_seq_no(stored);
     Dbt_safe db_value;
 
-    status = db_blocks_->get(nullptr, &db_seq_no, &db_value, DB_READ_UNCOMMITTED);
+    int status = db_blocks_->get(nullptr, &db_seq_no, &db_value, DB_READ_UNCOMMITTED);
     if (status) {
         set_last_error_from_berkeleydb(status);
         return false;
@@ -279,6 +435,7 @@ bool DatabaseBerkeleyDB::get(const cs::Bytes &key, cs::Bytes *value) {
 
 // sequnce from block hash
 bool DatabaseBerkeleyDB::seq_no(const cs::Bytes& key, uint32_t* value) {
+    foregroundOps_.fetch_add(1, std::memory_order_relaxed);
     if (value == nullptr) {
         set_last_error(InvalidArgument);
         return false;
@@ -288,6 +445,10 @@ bool DatabaseBerkeleyDB::seq_no(const cs::Bytes& key, uint32_t* value) {
         return false;
     }
 
+    if (lookupSeqNo(key, *value)) {
+        return true;
+    }
+
     Dbt_copy<cs::Bytes> db_key(key);
     Dbt_copy<uint32_t> db_seq_no;
     int status = db_seq_no_->get(nullptr, &db_key, &db_seq_no, DB_READ_UNCOMMITTED);
@@ -295,12 +456,14 @@ bool DatabaseBerkeleyDB::seq_no(const cs::Bytes& key, uint32_t* value) {
         set_last_error_from_berkeleydb(status);
         return false;
     }
-    
+
     *value = *static_cast<uint32_t*>(db_seq_no.get_data());
+    rememberSeqNo(key, *value);
     return true;
 }
 
 bool DatabaseBerkeleyDB::get(const uint32_t seq_no, cs::Bytes *value) {
+    foregroundOps_.fetch_add(1, std::memory_order_relaxed);
     if (!db_blocks_) {
         set_last_error(NotOpen);
         return false;
@@ -310,6 +473,11 @@ bool DatabaseBerkeleyDB::get(const uint32_t seq_no, cs::Bytes *value) {
         return false;
     }
 
+    if (archive_ && archive_->get(seq_no, value)) {
+        set_last_error();
+        return true;
+    }
+
     Dbt_safe db_value;
     // storage wants to load blocks by 0-based index: 1 => pool[0], 2 => pool[1] etc.
     Dbt_copy<uint32_t> db_seq_no(seq_no + 1);
@@ -340,12 +508,24 @@ bool DatabaseBerkeleyDB::remove(const cs::Bytes &key) {
         return false;
     }
 
+    const uint32_t stored = *static_cast<uint32_t*>(db_seq_no.get_data());
+    if (archive_ && stored != 0 && stored - 1 < archive_->archivedUpTo()) {
+        // only blocks near the top of the chain are ever removed; an archived
+        // block is immutable by design
+        cswarning() << "csdb: refusing to remove archived block " << stored - 1;
+        set_last_error(UnknownError);
+        return false;
+    }
+
     status = db_seq_no_->del(nullptr, &db_key, 0);
     if (status != 0) {
         set_last_error_from_berkeleydb(status);
         return false;
     }
 
+    // the authoritative mapping is gone, the index must not keep serving it
+    forgetSeqNo(key);
+
     status = db_blocks_->del(nullptr, &db_seq_no, 0);
     if (status != 0) {
         set_last_error_from_berkeleydb(status);
@@ -529,6 +709,21 @@ bool DatabaseBerkeleyDB::updateContractData(const cs::Bytes& key, const cs::Byte
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(contractsCacheMutex_);
+
+    // write-back: the update is made crash-safe by the sequential journal
+    // append, the db_contracts_ write is deferred to flushContractData()
+    if (appendContractJournal(key, data)) {
+        contractsPending_[key] = data;
+        set_last_error();
+        return true;
+    }
+
+    // no journal - fall back to the old synchronous write
+    return writeContractDataDirect(key, data);
+}
+
+bool DatabaseBerkeleyDB::writeContractDataDirect(const cs::Bytes& key, const cs::Bytes& data) {
     DbTxn* tid;
     int status = env_.txn_begin(nullptr, &tid, DB_READ_UNCOMMITTED);
     int txn_create_status = status;
@@ -584,6 +779,17 @@ bool DatabaseBerkeleyDB::getContractData(const cs::Bytes& key, cs::Bytes& data)
         return false;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(contractsCacheMutex_);
+        auto it = contractsPending_.find(key);
+
+        if (it != contractsPending_.end()) {
+            data = it->second;
+            set_last_error();
+            return true;
+        }
+    }
+
     Dbt_copy<cs::Bytes> db_key(key);
     Dbt_safe db_value;
 
@@ -599,4 +805,220 @@ bool DatabaseBerkeleyDB::getContractData(const cs::Bytes& key, cs::Bytes& data)
     return true;
 }
 
+void DatabaseBerkeleyDB::flushContractData() {
+    std::lock_guard<std::mutex> lock(contractsCacheMutex_);
+
+    if (contractsPending_.empty() || !db_contracts_) {
+        return;
+    }
+
+    DbTxn* tid;
+    int status = env_.txn_begin(nullptr, &tid, DB_READ_UNCOMMITTED);
+    int txn_create_status = status;
+    auto g = cs::scopeGuard([&]() {
+        if (txn_create_status) {
+            return;
+        }
+        if (status) {
+            tid->abort();
+        }
+        else {
+            tid->commit(0);
+        }
+    });
+
+    if (status == 0) {
+        for (const auto& [key, data] : contractsPending_) {
+            Dbt_copy<cs::Bytes> db_key(key);
+            Dbt_copy<cs::Bytes> db_value(data);
+
+            status = db_contracts_->put(tid, &db_key, &db_value, 0);
+            if (status) {
+                break;
+            }
+        }
+    }
+
+    if (status) {
+        // keep the cache and journal, the states stay readable and recoverable
+        set_last_error_from_berkeleydb(status);
+        return;
+    }
+
+    contractsPending_.clear();
+
+    // the group is durable, start the journal over
+    if (contractsJournal_.is_open()) {
+        contractsJournal_.close();
+    }
+    contractsJournal_.open(contractsJournalPath_, std::ios::binary | std::ios::trunc);
+
+    set_last_error();
+}
+
+bool DatabaseBerkeleyDB::appendContractJournal(const cs::Bytes& key, const cs::Bytes& data) {
+    if (!contractsJournal_.is_open()) {
+        return false;
+    }
+
+    const uint32_t keySize = static_cast<uint32_t>(key.size());
+    const uint32_t dataSize = static_cast<uint32_t>(data.size());
+
+    contractsJournal_.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+    contractsJournal_.write(reinterpret_cast<const char*>(key.data()), keySize);
+    contractsJournal_.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+    contractsJournal_.write(reinterpret_cast<const char*>(data.data()), dataSize);
+    contractsJournal_.flush();
+
+    return contractsJournal_.good();
+}
+
+void DatabaseBerkeleyDB::replayContractJournal() {
+    std::ifstream journal(contractsJournalPath_, std::ios::binary);
+
+    if (!journal.is_open()) {
+        return;
+    }
+
+    size_t replayed = 0;
+
+    while (true) {
+        uint32_t keySize = 0;
+        if (!journal.read(reinterpret_cast<char*>(&keySize), sizeof(keySize))) {
+            break;
+        }
+
+        cs::Bytes key(keySize);
+        if (!journal.read(reinterpret_cast<char*>(key.data()), keySize)) {
+            break;
+        }
+
+        uint32_t dataSize = 0;
+        if (!journal.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize))) {
+            break;
+        }
+
+        cs::Bytes data(dataSize);
+        if (dataSize != 0 && !journal.read(reinterpret_cast<char*>(data.data()), dataSize)) {
+            break;
+        }
+
+        // a torn record at the tail simply stops the replay, everything before it is applied
+        if (writeContractDataDirect(key, data)) {
+            ++replayed;
+        }
+    }
+
+    journal.close();
+
+    if (replayed != 0) {
+        std::cout << "Replayed " << replayed << " contract state(s) from journal\n" << std::flush;
+    }
+}
+
+void DatabaseBerkeleyDB::setBlocksArchiveHorizon(uint32_t horizon) {
+    archiveHorizon_.store(horizon);
+}
+
+bool DatabaseBerkeleyDB::foregroundIsBusy() {
+    const uint64_t ops = foregroundOps_.load(std::memory_order_relaxed);
+    const uint64_t delta = ops - opsAtLastMaintenance_;
+    opsAtLastMaintenance_ = ops;
+    return delta > kBusyForegroundOps;
+}
+
+void DatabaseBerkeleyDB::compactBlocksDb() {
+    if (!db_blocks_) {
+        return;
+    }
+
+    // years of appends scatter recno leaf pages all over the file and
+    // sequential sync reads degrade to random i/o; compact() rewrites pages
+    // into contiguous fresh ones online. The page limit bounds each pass to a
+    // small slice, repeated idle passes walk the whole tree over time
+    DB_COMPACT cdata;
+    memset(&cdata, 0, sizeof(cdata));
+    cdata.compact_pages = kCompactPagesPerPass;
+
+    const int status = db_blocks_->compact(nullptr, nullptr, nullptr, &cdata, DB_FREE_SPACE, nullptr);
+
+    if (status != 0) {
+        cswarning() << "csdb: blocks compaction pass failed, error " << status;
+        return;
+    }
+
+    if (cdata.compact_pages_free != 0) {
+        csdebug() << "csdb: compaction freed " << cdata.compact_pages_free << " page(s), examined " << cdata.compact_pages_examine;
+    }
+}
+
+void DatabaseBerkeleyDB::archiveColdBlocks() {
+    const uint32_t horizon = archiveHorizon_.load();
+    if (horizon == 0 || !archive_ || !db_blocks_) {
+        return;
+    }
+
+    const uint32_t count = blocksCount_.load();
+    const uint32_t upTo = archive_->archivedUpTo();
+
+    // only a full segment resting entirely below the horizon is re-packed,
+    // so archived blocks are always immutable and never partial
+    if (count < horizon || count - horizon < upTo + priv::BlockArchive::kSegmentBlocks) {
+        return;
+    }
+
+    std::vector<cs::Bytes> blocks;
+    blocks.reserve(priv::BlockArchive::kSegmentBlocks);
+
+    for (uint32_t seq = upTo; seq < upTo + priv::BlockArchive::kSegmentBlocks; ++seq) {
+        cs::Bytes value;
+        if (!get(seq, &value)) {
+            cswarning() << "csdb: block " << seq << " is missing, archiving postponed";
+            return;
+        }
+        blocks.push_back(std::move(value));
+    }
+
+    if (!archive_->appendSegment(blocks)) {
+        cswarning() << "csdb: failed to write archive segment at " << upTo;
+        return;
+    }
+
+    // the segment is durable, the hot copies may go; the hash->sequence
+    // mappings stay in db_seq_no_ so hash lookups still resolve
+    DbTxn* tid;
+    int status = env_.txn_begin(nullptr, &tid, DB_READ_UNCOMMITTED);
+    int txn_create_status = status;
+    auto g = cs::scopeGuard([&]() {
+        if (txn_create_status) {
+            return;
+        }
+        if (status) {
+            tid->abort();
+        }
+        else {
+            tid->commit(0);
+        }
+    });
+
+    if (status == 0) {
+        for (uint32_t seq = upTo; seq < upTo + priv::BlockArchive::kSegmentBlocks; ++seq) {
+            Dbt_copy<uint32_t> db_seq_no(seq + 1);
+            const int del_status = db_blocks_->del(tid, &db_seq_no, 0);
+            if (del_status != 0 && del_status != DB_NOTFOUND) {
+                status = del_status;
+                break;
+            }
+        }
+    }
+
+    if (status) {
+        // the reads fall through to the archive anyway, only space is wasted
+        cswarning() << "csdb: failed to delete archived blocks, error " << status;
+        return;
+    }
+
+    cslog() << "csdb: archived blocks [" << upTo << ", " << upTo + priv::BlockArchive::kSegmentBlocks << ")";
+}
+
 }  // namespace csdb
@@ -63,8 +63,21 @@ std::size_t decode(const void *buf, std::size_t size, uint64_t &value) {
     }
     auto d = static_cast<const char *>(buf);
     auto first = static_cast<uint8_t>(*d);
-    uint8_t bytes = 0;
-    for (uint8_t mask = first; 0 != (mask & 0x1u); ++bytes, mask >>= 1) {
+    // length prefix is a run of low ones; one trailing-zero scan of the
+    // inverted byte replaces the former per-bit loop
+    const uint32_t inverted = static_cast<uint8_t>(~first);
+    uint8_t bytes;
+    if (0 == inverted) {
+        bytes = 8;
+    }
+    else {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, inverted);
+        bytes = static_cast<uint8_t>(index);
+#else
+        bytes = static_cast<uint8_t>(__builtin_ctz(inverted));
+#endif
     }
     if ((bytes + 1u) > size) {
         return 0;
@@ -85,5 +98,18 @@ std::size_t decode(const void *buf, std::size_t size, uint64_t &value) {
     return bytes + 1;
 }
 
+std::size_t decode_run(const void *buf, std::size_t size, uint64_t *values, std::size_t count) {
+    auto data = static_cast<const char *>(buf);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t used = decode(data + total, size - total, values[i]);
+        if (0 == used) {
+            return 0;
+        }
+        total += used;
+    }
+    return total;
+}
+
 }  // namespace priv
 }  // namespace csdb
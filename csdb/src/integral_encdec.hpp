@@ -65,6 +65,18 @@ std::size_t decode(const void *buf, std::size_t size, bool& value);
 template<>
 std::size_t decode(const void *buf, std::size_t size, uint64_t& value);
 
+/**
+ * @brief Decoding of a contiguous run of coded integers in a single call.
+ * @param[in]   buf    Buffer, contains \ref count sequentially coded values.
+ * @param[in]   size   Buffer data size.
+ * @param[out]  values Array of at least \ref count elements receiving the results.
+ * @param[in]   count  Number of values to decode.
+ * @return  Total number of bytes read from \ref buf. 0, if the buffer ends
+ *          before all \ref count values are decoded; \ref values contents are
+ *          unspecified in that case.
+ */
+std::size_t decode_run(const void *buf, std::size_t size, uint64_t *values, std::size_t count);
+
 }  // namespace priv
 }  // namespace csdb
 
@@ -1,6 +1,7 @@
 #include <csdb/pool.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <map>
 #include <sstream>
@@ -28,64 +29,72 @@
 
 namespace csdb {
 
+namespace {
+// Explicit versions of the pool wire envelope. The leading byte of every
+// binary representation has always been the version, so all historic blocks
+// decode through the version 0 shims. A layout change bumps kWireVersionCurrent
+// and adds its own shim set next to the v0 one; old shims stay untouched and
+// old blocks keep decoding in place over the original buffer, no migration.
+constexpr uint8_t kWireVersion0 = 0;
+constexpr uint8_t kWireVersionCurrent = kWireVersion0;
+}  // namespace
+
 bool PoolHash::is_empty() const noexcept {
-    return d->value.empty();
+    return size_ == 0;
 }
 
 size_t PoolHash::size() const noexcept {
-    return d->value.size();
+    return size_;
 }
 
 std::string PoolHash::to_string() const noexcept {
-    return internal::to_hex(d->value);
+    return internal::to_hex(value_.begin(), value_.begin() + size_);
 }
 
 cs::Bytes PoolHash::to_binary() const noexcept {
-    return d->value;
+    return cs::Bytes(value_.begin(), value_.begin() + size_);
 }
 
 PoolHash PoolHash::from_binary(cs::Bytes&& data) {
-    const size_t sz = data.size();
     PoolHash res;
-    if ((0 == sz) || (::csdb::priv::crypto::hash_size == sz)) {
-        res.d->value = std::move(data);
+    if (::csdb::priv::crypto::hash_size == data.size()) {
+        std::copy(data.begin(), data.end(), res.value_.begin());
+        res.size_ = static_cast<uint8_t>(data.size());
     }
     return res;
 }
 
 bool PoolHash::operator==(const PoolHash& other) const noexcept {
-    return (d == other.d) || (d->value == other.d->value);
+    // unused bytes are kept zeroed, the whole array is comparable
+    return (size_ == other.size_) && (value_ == other.value_);
 }
 
 bool PoolHash::operator<(const PoolHash& other) const noexcept {
-    return (d != other.d) && (d->value < other.d->value);
+    if (size_ != other.size_) {
+        return size_ < other.size_;
+    }
+    return value_ < other.value_;
 }
 
 size_t PoolHash::calcHash() const noexcept {
-    return *reinterpret_cast<const size_t *>(d->value.data());
+    size_t result;
+    std::memcpy(&result, value_.data(), sizeof(result));
+    return result;
 }
 
 PoolHash PoolHash::from_string(const ::std::string& str) {
-    const cs::Bytes hash = ::csdb::internal::from_hex(str);
-    const size_t sz = hash.size();
-    PoolHash res;
-    if ((0 == sz) || (::csdb::priv::crypto::hash_size == sz)) {
-        res.d->value = hash;
-    }
-    return res;
+    cs::Bytes hash = ::csdb::internal::from_hex(str);
+    return from_binary(std::move(hash));
 }
 
 PoolHash PoolHash::calc_from_data(const cs::Bytes& data) {
-    PoolHash res;
-    res.d->value = ::csdb::priv::crypto::calc_hash(data);
-    return res;
+    return from_binary(::csdb::priv::crypto::calc_hash(data));
 }
 
 void PoolHash::put(::csdb::priv::obstream& os) const {
-    size_t size = d->value.size();
-    os.put(static_cast<uint8_t>(size));
-    if (!d->value.empty()) {
-        os.put((const void*)d->value.data(), size);
+    os.put(static_cast<uint8_t>(size_));
+    if (size_ != 0) {
+        os.put((const void*)value_.data(), size_);
     }
 }
 
@@ -95,16 +104,15 @@ bool PoolHash::get(::csdb::priv::ibstream& is) {
         return false;
     }
     if (size == 0) {
-        d->value.clear();
+        value_.fill(0);
+        size_ = 0;
         return true;
     }
     if (size != cscrypto::kHashSize || is.size() < cscrypto::kHashSize) {
         return false;
     }
-    if (d->value.size() != cscrypto::kHashSize) {
-        d->value.resize(cscrypto::kHashSize);
-    }
-    return is.get(d->value.data(), cscrypto::kHashSize);
+    size_ = size;
+    return is.get(value_.data(), cscrypto::kHashSize);
 }
 
 class Pool::priv : public ::csdb::internal::shared_data {
@@ -206,6 +214,20 @@ class Pool::priv : public ::csdb::internal::shared_data {
             return false;
         }
 
+        switch (version_) {
+            case kWireVersion0:
+                return get_meta_v0(is, cnt);
+            default:
+                csmeta(cswarning) << "unsupported pool format version " << static_cast<int>(version_);
+                return false;
+        }
+    }
+
+    // version 0 shim: the format every released node writes. The field readers
+    // it shares with get()/get_hashed_data() decode straight over the caller's
+    // buffer; a future version keeps them for the regions whose layout survived
+    // and only adds readers for what actually changed
+    bool get_meta_v0(::csdb::priv::ibstream& is, size_t& cnt) {
         if (!is.get(previous_hash_)) {
             csmeta(cswarning) << "get previous hash is failed";
             return false;
@@ -247,6 +269,16 @@ class Pool::priv : public ::csdb::internal::shared_data {
     }
 
     bool getTransactions(::csdb::priv::ibstream& is, size_t cnt) {
+        // a signed transaction can never serialize below its signature
+        // alone, which bounds how many of them the remaining payload can
+        // possibly hold; a count from a fuzzed packet fails here before
+        // the reserve() below would allocate for it
+        constexpr size_t kMinTransactionWireSize = sizeof(cs::Signature);
+        if (!is.hasQuotaFor(cnt, kMinTransactionWireSize)) {
+            csmeta(cswarning) << "transactions count " << cnt << " exceeds payload quota, " << is.size() << " bytes left";
+            return false;
+        }
+
         transactions_.clear();
         transactions_.reserve(cnt);
         for (size_t i = 0; i < cnt; ++i) {
@@ -371,6 +403,12 @@ class Pool::priv : public ::csdb::internal::shared_data {
             return false;
         }
 
+        // records are fixed width on the wire, see NewWalletInfo::put()
+        if (!is.hasQuotaFor(cnt, sizeof(size_t) + sizeof(internal::WalletId))) {
+            csmeta(cswarning) << "new wallets count " << cnt << " exceeds payload quota, " << is.size() << " bytes left";
+            return false;
+        }
+
         newWallets_.clear();
         newWallets_.reserve(cnt);
         for (uint32_t i = 0; i < cnt; ++i) {
@@ -449,6 +487,24 @@ class Pool::priv : public ::csdb::internal::shared_data {
         return true;
     }
 
+    // materializes body of a lazily created pool from its binary representation
+    void ensureParsed() {
+        if (!lazy_) {
+            return;
+        }
+
+        lazy_ = false;
+
+        ::csdb::priv::ibstream is(binary_representation_.data(), binary_representation_.size());
+
+        if (!get(is)) {
+            is_valid_ = false;
+            return;
+        }
+
+        update_transactions();
+    }
+
     void compose() {
         if (!is_valid_) {
             binary_representation_.clear();
@@ -499,6 +555,7 @@ class Pool::priv : public ::csdb::internal::shared_data {
         result.is_valid_ = is_valid_;
         result.version_ = version_;
         result.read_only_ = read_only_;
+        result.lazy_ = lazy_;
         result.hash_ = hash_.clone();
         result.previous_hash_ = previous_hash_.clone();
         result.sequence_ = sequence_;
@@ -534,7 +591,8 @@ class Pool::priv : public ::csdb::internal::shared_data {
 
     bool is_valid_ = false;
     bool read_only_ = false;
-    uint8_t version_ = 0;
+    bool lazy_ = false;
+    uint8_t version_ = kWireVersionCurrent;
     PoolHash hash_;
     PoolHash previous_hash_;
     cs::Sequence sequence_{};
@@ -580,6 +638,11 @@ uint8_t Pool::version() const noexcept {
 }
 
 PoolHash Pool::hash() const noexcept {
+    if (d->lazy_) {
+        // hashing length is known only after the full parse
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     if (d->hash_.is_empty()) {
         const_cast<Pool*>(this)->d->updateHash();
     }
@@ -600,6 +663,10 @@ Storage Pool::storage() const noexcept {
 }
 
 Transaction Pool::transaction(size_t index) const {
+    if (d->lazy_) {
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     return (d->transactions_.size() > index) ? d->transactions_[index] : Transaction{};
 }
 
@@ -620,10 +687,18 @@ uint8_t Pool::numberConfirmations() const noexcept {
 }
 
 const std::vector<cs::Signature>& Pool::roundConfirmations() const noexcept {
+    if (d->lazy_) {
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     return d->roundConfirmations_;
 }
 
 Transaction Pool::transaction(TransactionID id) const {
+    if (d->lazy_) {
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     if ((!d->is_valid_) || (!d->read_only_) || (!id.is_valid()) || (id.pool_seq() != d->sequence_) || (d->transactions_.size() <= id.index_)) {
         return Transaction{};
     }
@@ -695,6 +770,29 @@ bool Pool::add_transaction(Transaction transaction
     return true;
 }
 
+bool Pool::add_transactions(Transactions::const_iterator begin, Transactions::const_iterator end) {
+    if (d.constData()->read_only_) {
+        return false;
+    }
+
+    d->transactions_.reserve(d->transactions_.size() + static_cast<size_t>(std::distance(begin, end)));
+
+    bool result = true;
+
+    for (auto it = begin; it != end; ++it) {
+        // keep add_transaction() semantics, an invalid transaction is skipped
+        if (!it->is_valid()) {
+            result = false;
+            continue;
+        }
+
+        d->transactions_.push_back(Transaction(new Transaction::priv(*(it->d.constData()))));
+        ++d->transactionsCount_;
+    }
+
+    return result;
+}
+
 size_t Pool::transactions_count() const noexcept {
     // return d->transactionsCount_; // bad work
     return d->transactions_.size();
@@ -731,14 +829,26 @@ const cs::PublicKey& Pool::writer_public_key() const noexcept {
 //}
 
 const std::vector<cs::PublicKey>& Pool::confidants() const noexcept {
+    if (d->lazy_) {
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     return d->confidants_;
 }
 
 const std::vector<cs::Signature>& Pool::signatures() const noexcept {
+    if (d->lazy_) {
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     return d->signatures_;
 }
 
 const ::std::vector<csdb::Pool::SmartSignature>& Pool::smartSignatures() const noexcept {
+    if (d->lazy_) {
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     return d->smartSignatures_;
 }
 
@@ -851,10 +961,16 @@ void Pool::set_storage(const Storage& storage) noexcept {
 }
 
 Pool::Transactions& Pool::transactions() {
+    d->ensureParsed();
+
     return d->transactions_;
 }
 
 const Pool::Transactions& Pool::transactions() const {
+    if (d->lazy_) {
+        const_cast<Pool*>(this)->d->ensureParsed();
+    }
+
     return d->transactions_;
 }
 
@@ -940,6 +1056,25 @@ Pool Pool::from_binary(cs::Bytes&& data, bool makeReadOnly) {
     return Pool(p.release());
 }
 
+/*static*/
+Pool Pool::from_binary_lazy(cs::Bytes&& data) {
+    std::unique_ptr<priv> p{new priv()};
+    ::csdb::priv::ibstream is(data.data(), data.size());
+
+    size_t cnt = 0;
+    if (!p->get_meta(is, cnt)) {
+        return Pool();
+    }
+
+    p->update_binary_representation(std::move(data));
+    p->lazy_ = true;
+    return Pool(p.release());
+}
+
+bool Pool::isLazy() const noexcept {
+    return d->lazy_;
+}
+
 Pool Pool::meta_from_binary(cs::Bytes&& data, size_t& cnt) {
     std::unique_ptr<priv> p(new priv());
     ::csdb::priv::ibstream is(data.data(), data.size());
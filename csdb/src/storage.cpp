@@ -1,21 +1,27 @@
 #include <csdb/storage.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
 #include <cstdarg>
+#include <cstring>
 #include <deque>
 #include <limits>
 #include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <thread>
+#include <unordered_map>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 
+#include <lib/system/concurrent.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/mmappedfile.hpp>
+#include <lib/system/stacksampler.hpp>
 #include <lib/system/utils.hpp>
 
 #include <csdb/address.hpp>
@@ -114,6 +120,67 @@ using tails_t = std::map<PoolHash, PoolHash>;
 
 }  // namespace
 
+// mmap-backed ring of recently written raw blocks; hot loads of the last few
+// hundred pools are served from mapped bytes instead of database round trips
+class HotBlocksWindow {
+public:
+    static const size_t kWindowSize = 64 * 1024 * 1024;
+
+    void open(const std::string& path) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        file_ = std::make_unique<cs::MMappedFileWrap<cs::FileSink>>(path, kWindowSize);
+
+        if (!file_->isOpen()) {
+            file_.reset();
+        }
+
+        index_.clear();
+        writeOffset_ = 0;
+    }
+
+    void append(cs::Sequence sequence, const cs::Bytes& bytes) {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (!file_ || bytes.empty() || bytes.size() > kWindowSize) {
+            return;
+        }
+
+        if (writeOffset_ + bytes.size() > kWindowSize) {
+            // wrap around, the window restarts and older entries are dropped
+            index_.clear();
+            writeOffset_ = 0;
+        }
+
+        std::memcpy(file_->data<char>() + writeOffset_, bytes.data(), bytes.size());
+        index_[sequence] = std::make_pair(writeOffset_, bytes.size());
+        writeOffset_ += bytes.size();
+    }
+
+    bool load(cs::Sequence sequence, cs::Bytes& bytes) const {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (!file_) {
+            return false;
+        }
+
+        auto it = index_.find(sequence);
+
+        if (it == index_.end()) {
+            return false;
+        }
+
+        const char* data = file_->data<char>() + it->second.first;
+        bytes.assign(data, data + it->second.second);
+        return true;
+    }
+
+private:
+    mutable std::unique_ptr<cs::MMappedFileWrap<cs::FileSink>> file_;
+    std::unordered_map<cs::Sequence, std::pair<size_t, size_t>> index_;
+    size_t writeOffset_ = 0;
+    mutable std::mutex mutex_;
+};
+
 class Storage::priv {
 public:
     priv() {
@@ -121,11 +188,22 @@ public:
     }
 
     ~priv() {
-        if (write_thread.joinable()) {
+        stop_write_behind();
+    }
+
+    void stop_write_behind() {
+        if (!write_thread.joinable()) {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lock(write_lock);
             quit = true;
-            write_cond_var.notify_one();
-            write_thread.join();
         }
+        write_cond_var.notify_one();
+        write_space_cond.notify_all();
+        write_thread.join();
+        quit = false;
+        write_behind_on = false;
     }
 
 private:
@@ -133,6 +211,7 @@ private:
     void write_routine();
 
     std::shared_ptr<Database> db = nullptr;
+    HotBlocksWindow hot_blocks;
     PoolHash last_hash;     // Last pool's hash
     size_t count_pool = 0;  // Number of transaction's pools inthe storage (initially filled in check)
     cs::Sequence startSequence = 0;
@@ -149,6 +228,15 @@ private:
     std::mutex write_lock;
     std::condition_variable write_cond_var;
 
+    // write-behind mode: pool_save enqueues and the writer thread commits
+    // ordered groups, so the processing pipeline runs ahead of the disk by at
+    // most write_behind_depth blocks; 0 keeps the synchronous per-block path
+    static constexpr size_t kWriteBehindGroup = 128;
+    size_t write_behind_depth = 0;
+    bool write_behind_on = false;
+    bool write_in_flight = false;
+    std::condition_variable write_space_cond;
+
     struct PoolElement {
         cs::Sequence seq; struct bySequence {};
         PoolHash hash;  struct byHash {};
@@ -291,10 +379,61 @@ bool Storage::priv::rescan(Storage::OpenCallback callback) {
         it->next();
     }
 
-    for (; it->is_valid(); it->next()) {
-        cs::Bytes v = it->value();
+    // replay runs as a pipeline over double-buffered batches: while the
+    // current batch is applied to consumers strictly in chain order, the next
+    // one is already being read, deserialized and hashed on the thread pool,
+    // so replay time is bounded by the serial apply stage
+    const size_t batchSize = std::max<size_t>(std::thread::hardware_concurrency(), 1) * 32;
+
+    struct ReplayBatch {
+        std::vector<cs::Bytes> raw;
+        std::vector<Pool> parsed;
+        std::atomic<size_t> jobsLeft{0};
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+    };
+
+    ReplayBatch batches[2];
+
+    auto fillBatch = [&](ReplayBatch& batch) {
+        batch.raw.clear();
+        for (; it->is_valid() && batch.raw.size() < batchSize; it->next()) {
+            batch.raw.push_back(it->value());
+        }
+    };
+
+    auto launchBatch = [&](ReplayBatch& batch) {
+        batch.parsed.assign(batch.raw.size(), Pool{});
+        batch.jobsLeft.store(batch.raw.size());
+
+        for (size_t i = 0; i < batch.raw.size(); ++i) {
+            boost::asio::post(cs::ThreadPool::instance(), [&batch, i] {
+                Pool pool = Pool::from_binary(std::move(batch.raw[i]));
+
+                if (pool.is_valid()) {
+                    // forces blake2 computation on the worker
+                    pool.hash();
+                }
+
+                batch.parsed[i] = std::move(pool);
+
+                if (batch.jobsLeft.fetch_sub(1) == 1) {
+                    std::unique_lock<std::mutex> doneLock(batch.doneMutex);
+                    batch.doneCondition.notify_one();
+                }
+            });
+        }
+    };
 
-            Pool p = Pool::from_binary(std::move(v));
+    auto joinBatch = [](ReplayBatch& batch) {
+        std::unique_lock<std::mutex> doneLock(batch.doneMutex);
+        batch.doneCondition.wait(doneLock, [&batch] {
+            return batch.jobsLeft.load() == 0;
+        });
+    };
+
+    auto applyBatch = [&](ReplayBatch& batch) -> bool {
+        for (Pool& p : batch.parsed) {
             if (!p.is_valid()) {
                 set_last_error(Storage::DataIntegrityError, "Data integrity error: Corrupted pool %d.", count_pool);
                 cserror() << "Please restart node with command : client --set-bc-top " << count_pool - 1;
@@ -315,14 +454,36 @@ bool Storage::priv::rescan(Storage::OpenCallback callback) {
                 return false;
             }
 
-        progress.poolsProcessed++;
+            progress.poolsProcessed++;
 
-        if (callback != nullptr) {
-            if (callback(progress)) {
-                set_last_error(Storage::UserCancelled);
-                return false;
+            if (callback != nullptr) {
+                if (callback(progress)) {
+                    set_last_error(Storage::UserCancelled);
+                    return false;
+                }
             }
         }
+        return true;
+    };
+
+    size_t current = 0;
+    fillBatch(batches[current]);
+    launchBatch(batches[current]);
+
+    while (!batches[current].raw.empty()) {
+        const size_t next = current ^ 1;
+        fillBatch(batches[next]);
+        launchBatch(batches[next]);
+
+        joinBatch(batches[current]);
+
+        if (!applyBatch(batches[current])) {
+            // the prefetched workers still reference the batch buffers
+            joinBatch(batches[next]);
+            return false;
+        }
+
+        current = next;
     }
 
     emit stop_reading_event();
@@ -330,22 +491,63 @@ bool Storage::priv::rescan(Storage::OpenCallback callback) {
 }
 
 void Storage::priv::write_routine() {
+    cs::StackSampler::instance().registerThread("storage");
+
     std::unique_lock<std::mutex> lock(write_lock);
-    while (!quit) {
-        write_cond_var.wait(lock);
-        while (!write_queue.empty()) {
-            Pool& pool = write_queue.front();
-            if (!pool.is_read_only()) {
-                if (!pool.compose()) {
-                    set_last_error(Storage::DataIntegrityError, "Pool passed to storage is not composed and failed to compose now");
-                }
+    for (;;) {
+        write_cond_var.wait(lock, [this] {
+            return quit || !write_queue.empty();
+        });
+
+        if (write_queue.empty()) {
+            if (quit) {
+                cs::StackSampler::instance().unregisterThread();
+                return;   // nothing left to drain
             }
-            const PoolHash hash = pool.hash();
-
-            db->put(hash.to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_binary());
+            continue;
+        }
 
+        // take a group and write it with one commit while producers keep going
+        std::vector<Pool> group;
+        const size_t count = std::min(write_queue.size(), kWriteBehindGroup);
+        group.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            group.push_back(std::move(write_queue.front()));
             write_queue.pop_front();
         }
+
+        write_in_flight = true;
+        lock.unlock();
+        write_space_cond.notify_all();
+
+        Database::SequencedItemList items;
+        items.reserve(group.size());
+
+        for (Pool& pool : group) {
+            if (!pool.is_read_only() && !pool.compose()) {
+                set_last_error(Storage::DataIntegrityError, "Pool passed to storage is not composed and failed to compose now");
+            }
+            items.push_back(Database::SequencedItem{pool.hash().to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_binary()});
+        }
+
+        if (!db->putBatch(items)) {
+            // group commit failed, fall back to per-block writes so one bad
+            // block does not hold the rest of the group hostage
+            for (const auto& item : items) {
+                if (!db->put(item.key, item.seq_no, item.value)) {
+                    set_last_error(Storage::IOError, "write-behind: cannot store block %u", item.seq_no);
+                }
+            }
+        }
+
+        for (const auto& item : items) {
+            hot_blocks.append(item.seq_no, item.value);
+        }
+
+        lock.lock();
+        write_in_flight = false;
+        // wake a flusher that waits for the whole queue to become durable
+        write_space_cond.notify_all();
     }
 }
 
@@ -506,16 +708,51 @@ bool Storage::open(
     auto db{::std::make_shared<::csdb::DatabaseBerkeleyDB>()};
     db->open(path);
 
+    d->hot_blocks.open(path + "/hotblocks.dat");
+
     //d->write_thread = std::thread(&Storage::priv::write_routine, d.get());
 
     return open(OpenOptions{db, newBlockchainTop, startReadFrom}, callback);
 }
 
 void Storage::close() {
+    d->stop_write_behind();
     d->db.reset();
     d->set_last_error();
 }
 
+void Storage::set_write_behind(size_t blocks) const {
+    if (blocks == 0) {
+        d->stop_write_behind();
+        return;
+    }
+
+    if (!isOpen()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(d->write_lock);
+    d->write_behind_depth = blocks;
+
+    if (!d->write_behind_on) {
+        d->write_behind_on = true;
+        d->write_thread = std::thread(&Storage::priv::write_routine, d.get());
+    }
+}
+
+void Storage::flush_write_behind() const {
+    std::unique_lock<std::mutex> lock(d->write_lock);
+
+    if (!d->write_behind_on) {
+        return;
+    }
+
+    d->write_cond_var.notify_one();
+    d->write_space_cond.wait(lock, [&] {
+        return d->write_queue.empty() && !d->write_in_flight;
+    });
+}
+
 bool Storage::isOpen() const {
     return ((d->db) && (d->db->is_open()));
 }
@@ -552,14 +789,23 @@ bool Storage::pool_save(Pool pool) {
         d->set_last_error(InvalidParameter, "%s: Trying to save pool with another prev hash [hash: %s]", funcName(), pool.previous_hash().to_string().c_str());
         return false;
     }
-    /*
-      {
-        std::unique_lock<std::mutex> lock(d->write_lock);
-        d->write_queue.push_back(pool);
+    if (d->write_behind_on) {
+        {
+            std::unique_lock<std::mutex> lock(d->write_lock);
+            // bounded queue: when the disk falls too far behind, the producer
+            // blocks here instead of growing memory without limit
+            d->write_space_cond.wait(lock, [&] {
+                return d->write_queue.size() < d->write_behind_depth || d->quit;
+            });
+            d->write_queue.push_back(pool);
+        }
         d->write_cond_var.notify_one();
-      }
-    */
-    d->db->put(hash.to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_binary());
+    }
+    else {
+        const cs::Bytes binary = pool.to_binary();
+        d->db->put(hash.to_binary(), static_cast<uint32_t>(pool.sequence()), binary);
+        d->hot_blocks.append(pool.sequence(), binary);
+    }
 
     {
         std::unique_lock<std::mutex> lock(d->data_lock);
@@ -575,6 +821,69 @@ bool Storage::pool_save(Pool pool) {
     return true;
 }
 
+size_t Storage::pool_save_batch(std::vector<Pool>& pools) {
+    if (!isOpen()) {
+        d->set_last_error(NotOpen);
+        return 0;
+    }
+
+    // keep ordering with any queued write-behind blocks
+    flush_write_behind();
+
+    Database::SequencedItemList items;
+    items.reserve(pools.size());
+
+    // validate the whole chain segment first, then write it with one commit
+    size_t accepted = 0;
+    PoolHash expectedPrevious = last_hash();
+
+    for (Pool& pool : pools) {
+        if (!pool.is_valid()) {
+            d->set_last_error(InvalidParameter, "%s: Invalid pool passed", funcName());
+            break;
+        }
+
+        const PoolHash hash = pool.hash();
+
+        if (expectedPrevious != pool.previous_hash()) {
+            d->set_last_error(InvalidParameter, "%s: Trying to save pool with another prev hash [hash: %s]", funcName(), pool.previous_hash().to_string().c_str());
+            break;
+        }
+
+        if (d->db->get(hash.to_binary())) {
+            d->set_last_error(InvalidParameter, "%s: Pool already present [hash: %s]", funcName(), hash.to_string().c_str());
+            break;
+        }
+
+        items.push_back(Database::SequencedItem{hash.to_binary(), static_cast<uint32_t>(pool.sequence()), pool.to_binary()});
+        expectedPrevious = hash;
+        ++accepted;
+    }
+
+    if (items.empty()) {
+        return 0;
+    }
+
+    if (!d->db->putBatch(items)) {
+        d->set_last_error(IOError, "%s: Batch write failed", funcName());
+        return 0;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(d->data_lock);
+        d->count_pool += accepted;
+        d->last_hash = expectedPrevious;
+    }
+
+    for (size_t i = 0; i < accepted; ++i) {
+        d->hot_blocks.append(items[i].seq_no, items[i].value);
+        d->pools_cache_insert(pools[i].sequence(), pools[i].hash(), pools[i]);
+    }
+
+    d->set_last_error();
+    return accepted;
+}
+
 Pool Storage::pool_load_internal(const PoolHash& hash, const bool metaOnly, size_t& trxCnt) const {
     if (!isOpen()) {
         d->set_last_error(NotOpen);
@@ -700,6 +1009,20 @@ Pool Storage::pool_load(const cs::Sequence sequence) const {
         return res;
     }
 
+    if (d->hot_blocks.load(sequence, data)) {
+        res = Pool::from_binary(std::move(data));
+        d->pools_cache_insert(res.sequence(), res.hash(), res);
+
+        if (!res.is_valid()) {
+            d->set_last_error(DataIntegrityError);
+        }
+        else {
+            d->set_last_error();
+        }
+
+        return res;
+    }
+
     if (!d->db->get(static_cast<uint32_t>(sequence), &data)) {
         {
             std::unique_lock<std::mutex> lock2(d->write_lock);
@@ -733,6 +1056,61 @@ Pool Storage::pool_load(const cs::Sequence sequence) const {
     return res;
 }
 
+std::vector<Pool> Storage::pool_load_range(const cs::Sequence fromSeq, const size_t count) const {
+    std::vector<Pool> result;
+
+    if (!isOpen()) {
+        d->set_last_error(NotOpen);
+        return result;
+    }
+
+    if (count == 0) {
+        d->set_last_error();
+        return result;
+    }
+
+    result.reserve(count);
+
+    const cs::Sequence endSeq = fromSeq + count;
+    cs::Sequence expected = fromSeq;
+
+    {
+        auto iterator = d->db->new_iterator();
+
+        if (iterator) {
+            for (iterator->seek(static_cast<uint32_t>(fromSeq)); iterator->is_valid() && expected < endSeq; iterator->next()) {
+                if (static_cast<cs::Sequence>(iterator->key()) != expected) {
+                    break;
+                }
+
+                Pool pool = Pool::from_binary(iterator->value());
+
+                if (!pool.is_valid()) {
+                    d->set_last_error(DataIntegrityError);
+                    return result;
+                }
+
+                result.push_back(std::move(pool));
+                ++expected;
+            }
+        }
+    }
+
+    // the tail of the range may still sit in the caches or the write queue
+    for (; expected < endSeq; ++expected) {
+        Pool pool = pool_load(expected);
+
+        if (!pool.is_valid()) {
+            break;
+        }
+
+        result.push_back(std::move(pool));
+    }
+
+    d->set_last_error();
+    return result;
+}
+
 Pool Storage::pool_load_meta(const PoolHash& hash, size_t& cnt) const {
     if (!isOpen()) {
         d->set_last_error(NotOpen);
@@ -750,8 +1128,28 @@ Pool Storage::pool_load_meta(const PoolHash& hash, size_t& cnt) const {
         return res;
     }
 
+    // a cached pool already carries everything meta decoding would produce
+    const auto &index = d->pools_cache.get<Storage::priv::PoolElement::byHash>();
+    auto it = index.find(hash);
+    if (it != index.end() && (*it).pool.is_valid()) {
+        cnt = (*it).pool.transactions().size();
+        d->set_last_error();
+        return (*it).pool;
+    }
+
     cs::Bytes data;
-    if (!d->db->get(hash.to_binary(), &data)) {
+    uint32_t stored = 0;
+
+    // resolve the hash to its sequence once, then fetch the block bytes over
+    // the sequence-addressed path (hot window, recno or archive segment)
+    // instead of a second b-tree descent through the hash table
+    if (d->db->seq_no(hash.to_binary(), &stored) && stored != 0) {
+        if (!d->hot_blocks.load(stored - 1, data) && !d->db->get(stored - 1, &data)) {
+            d->set_last_error(DatabaseError);
+            return Pool{};
+        }
+    }
+    else if (!d->db->get(hash.to_binary(), &data)) {
         d->set_last_error(DatabaseError);
         return Pool{};
     }
@@ -1070,6 +1468,18 @@ bool Storage::update_contract_data(const Address& abs_addr /*input*/, const cs::
     return d->db->updateContractData(bytes, data);
 }
 
+void Storage::flush_contract_data() const {
+    if (d->db) {
+        d->db->flushContractData();
+    }
+}
+
+void Storage::set_blocks_archive_horizon(uint32_t blocks) const {
+    if (d->db) {
+        d->db->setBlocksArchiveHorizon(blocks);
+    }
+}
+
 cs::Sequence Storage::pool_sequence(const PoolHash& hash) const {
     cs::Sequence seq = std::numeric_limits<cs::Sequence>::max();
     if (!isOpen()) {
@@ -1,10 +1,13 @@
 #include <csdb/transaction.hpp>
 #include "transaction_p.hpp"
 
+#include <cassert>
 #include <cinttypes>
 #include <iomanip>
 #include <iterator>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include <cscrypto/cscrypto.hpp>
 #include <csdb/address.hpp>
@@ -16,8 +19,86 @@
 #include "binary_streams.hpp"
 #include "priv_crypto.hpp"
 
+#include <lib/system/common.hpp>
+#include <lib/system/reflection.hpp>
+
+namespace {
+
+/* Recycling pool of fixed-size blocks for Transaction::priv. Pages are
+   allocated in bulk and released blocks are kept for reuse, so building
+   and tearing down packet-sized transaction sets does not hammer the
+   global heap with one malloc/free pair per transaction. */
+template <size_t BlockSize>
+class FixedBlockPool {
+public:
+    enum : size_t { kPageSize = 4096 };
+
+    void* allocate() {
+        cs::Lock lock(lock_);
+        if (freeBlocks_.empty()) {
+            allocateNextPage();
+        }
+        void* block = freeBlocks_.back();
+        freeBlocks_.pop_back();
+        return block;
+    }
+
+    void deallocate(void* block) {
+        cs::Lock lock(lock_);
+        freeBlocks_.push_back(block);
+    }
+
+    static FixedBlockPool& instance() {
+        // never destroyed: transactions held in static containers may be
+        // released after static destruction has started
+        static auto* pool = new FixedBlockPool();
+        return *pool;
+    }
+
+private:
+    void allocateNextPage() {
+        pages_.push_back(::std::make_unique<uint8_t[]>(BlockSize * kPageSize));
+        uint8_t* page = pages_.back().get();
+
+        freeBlocks_.reserve(freeBlocks_.size() + kPageSize);
+        for (size_t i = 0; i < kPageSize; ++i) {
+            freeBlocks_.push_back(page + i * BlockSize);
+        }
+    }
+
+    cs::SpinLock lock_{ATOMIC_FLAG_INIT};
+    ::std::vector<void*> freeBlocks_;
+    ::std::vector<::std::unique_ptr<uint8_t[]>> pages_;
+};
+
+}  // namespace
+
 namespace csdb {
 
+void* Transaction::priv::operator new(size_t size) {
+    assert(sizeof(Transaction::priv) == size);
+    csunused(size);
+    return FixedBlockPool<sizeof(Transaction::priv)>::instance().allocate();
+}
+
+void Transaction::priv::operator delete(void* ptr) {
+    FixedBlockPool<sizeof(Transaction::priv)>::instance().deallocate(ptr);
+}
+
+void Transaction::priv::ensure_user_fields() const {
+    if (!user_fields_pending_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::call_once(user_fields_once_, [this]() {
+        // a pure decode: raw_user_fields_ stays untouched and remains the
+        // authoritative wire form, serialization keeps splicing it verbatim
+        ::csdb::priv::ibstream is(raw_user_fields_.data(), raw_user_fields_.size());
+        is.get(user_fields_);
+        user_fields_pending_.store(false, std::memory_order_release);
+    });
+}
+
 //SHARED_DATA_CLASS_IMPLEMENTATION(TransactionID)
 
 TransactionID::TransactionID()
@@ -209,19 +290,65 @@ bool Transaction::add_user_field(user_field_id_t id, UserField field) noexcept {
     if (d.constData()->read_only_ || (!field.is_valid())) {
         return false;
     }
+    // the wire form can no longer describe the mutated set, drop it so the
+    // map becomes authoritative again
+    d->ensure_user_fields();
+    d->raw_user_fields_.clear();
     d->user_fields_[id] = field;
     return true;
 }
 
 UserField Transaction::user_field(user_field_id_t id) const noexcept {
     const priv* data = d.constData();
+    data->ensure_user_fields();
     auto it = data->user_fields_.find(id);
     return (data->user_fields_.end() == it) ? UserField{} : it->second;
 }
 
+bool Transaction::contains_user_field(user_field_id_t id) const noexcept {
+    const priv* data = d.constData();
+
+    if (!data->raw_user_fields_.empty() && !data->user_fields_pending_.load(std::memory_order_acquire)) {
+        // already materialized, the map lookup is cheaper than a rescan
+        return data->user_fields_.count(id) != 0;
+    }
+
+    if (!data->raw_user_fields_.empty()) {
+        // presence probes (contract markers above all) are answered from
+        // the wire form so the frequent negative case never builds the map
+        ::csdb::priv::ibstream is(data->raw_user_fields_.data(), data->raw_user_fields_.size());
+        uint8_t count = 0;
+
+        if (!is.get(count)) {
+            return false;
+        }
+
+        for (uint8_t i = 0; i < count; ++i) {
+            user_field_id_t field_id;
+
+            if (!is.get(field_id)) {
+                return false;
+            }
+
+            if (field_id == id) {
+                return true;
+            }
+
+            if (!UserField::skip(is)) {
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    return data->user_fields_.count(id) != 0;
+}
+
 ::std::set<user_field_id_t> Transaction::user_field_ids() const noexcept {
     ::std::set<user_field_id_t> res;
     const priv* data = d.constData();
+    data->ensure_user_fields();
     for (const auto& it : data->user_fields_) {
         res.insert(it.first);
     }
@@ -297,6 +424,7 @@ std::vector<uint8_t> Transaction::to_byte_stream_for_sig() const {
     os.put(data->max_fee_);
     os.put(data->currency_);
 
+    data->ensure_user_fields();
     decltype(data->user_fields_) custom_user_fields(data->user_fields_.lower_bound(0), data->user_fields_.end());
     if (custom_user_fields.size()) {
         os.put_smart(custom_user_fields);
@@ -336,7 +464,14 @@ void Transaction::put(::csdb::priv::obstream& os) const {
     os.put(data->max_fee_);
     os.put(data->currency_);
 
-    os.put(data->user_fields_);
+    if (!data->raw_user_fields_.empty()) {
+        // the retained wire form is byte-for-byte what is.get() consumed,
+        // reserialize it without ever building the map
+        os.put(data->raw_user_fields_.data(), data->raw_user_fields_.size());
+    }
+    else {
+        os.put(data->user_fields_);
+    }
 
     os.put(data->signature_);
     os.put(data->counted_fee_);
@@ -421,11 +556,29 @@ bool Transaction::get(::csdb::priv::ibstream& is) {
 
     data->currency_ = parse;
 
-    res = is.get(data->user_fields_);
+    // validate the user field block and retain its raw span instead of
+    // materializing the map: most transactions read off the wire are only
+    // hashed, counted and reserialized, their fields are never inspected
+    const auto* fieldsBegin = static_cast<const uint8_t*>(is.data());
+    uint8_t fieldsCount;
+    res = is.get(fieldsCount);
     if (!res) {
         return res;
     }
 
+    for (uint8_t i = 0; i < fieldsCount; ++i) {
+        user_field_id_t fieldId;
+        if (!is.get(fieldId) || !UserField::skip(is)) {
+            return false;
+        }
+    }
+
+    const auto* fieldsEnd = static_cast<const uint8_t*>(is.data());
+    data->user_fields_.clear();
+    data->raw_user_fields_.assign(fieldsBegin, fieldsEnd);
+    // an empty block is a lone zero byte, there is nothing to decode later
+    data->user_fields_pending_.store(fieldsCount != 0, std::memory_order_release);
+
     return is.get(data->signature_) && is.get(data->counted_fee_);
 }
 
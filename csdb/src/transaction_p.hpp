@@ -9,8 +9,12 @@
 
 #include <csdb/transaction.hpp>
 
+#include <atomic>
 #include <limits>
 #include <map>
+#include <mutex>
+
+#include <boost/container/flat_map.hpp>
 
 #include <csdb/address.hpp>
 #include <csdb/amount.hpp>
@@ -21,6 +25,12 @@
 namespace csdb {
 
 class Transaction::priv : public ::csdb::internal::shared_data {
+    // priv objects are churned in packet-sized bursts on the conveyer hot
+    // paths, so they are carved from a recycling fixed-block pool instead
+    // of going through malloc/free individually
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+
     inline priv()
     : read_only_(false)
     , innerID_(0)
@@ -41,8 +51,14 @@ class Transaction::priv : public ::csdb::internal::shared_data {
     , max_fee_(other.max_fee_)
     , counted_fee_(other.counted_fee_)
     , signature_(other.signature_)
-    , user_fields_(other.user_fields_)
+    , raw_user_fields_(other.raw_user_fields_)
     , time_(other.time_) {
+        // decoding into the copy instead of copying the map sidesteps any
+        // race with a reader materializing the source's fields right now
+        user_fields_pending_.store(!raw_user_fields_.empty(), std::memory_order_relaxed);
+        if (raw_user_fields_.empty()) {
+            user_fields_ = other.user_fields_;
+        }
     }
 
     inline priv(int64_t innerID, Address source, Address target, Currency currency, Amount amount, AmountCommission max_fee, AmountCommission counted_fee, cs::Signature signature)
@@ -76,8 +92,12 @@ class Transaction::priv : public ::csdb::internal::shared_data {
         result.counted_fee_ = counted_fee_;
         result.signature_ = signature_;
 
-        for (auto& uf : user_fields_)
-            result.user_fields_[uf.first] = uf.second.clone();
+        result.raw_user_fields_ = raw_user_fields_;
+        result.user_fields_pending_.store(!raw_user_fields_.empty(), std::memory_order_relaxed);
+        if (raw_user_fields_.empty()) {
+            for (auto& uf : user_fields_)
+                result.user_fields_[uf.first] = uf.second.clone();
+        }
 
         result.time_ = time_;
 
@@ -94,7 +114,21 @@ class Transaction::priv : public ::csdb::internal::shared_data {
     AmountCommission max_fee_;
     AmountCommission counted_fee_;
     cs::Signature signature_;
-    ::std::map<::csdb::user_field_id_t, ::csdb::UserField> user_fields_;
+    // transactions rarely carry more than a handful of user fields, the flat
+    // map keeps them in one contiguous node-free buffer. After wire
+    // deserialization the map stays empty and raw_user_fields_ holds the
+    // encoded span; ensure_user_fields() materializes the map on the first
+    // real access, which most transactions on sync paths never see
+    mutable ::boost::container::flat_map<::csdb::user_field_id_t, ::csdb::UserField> user_fields_;
+
+    // authoritative wire form while non-empty; cleared by add_user_field()
+    // so programmatic mutation can never fall out of sync with it
+    cs::Bytes raw_user_fields_;
+    mutable std::atomic<bool> user_fields_pending_{false};
+    mutable std::once_flag user_fields_once_;
+
+    // decodes raw_user_fields_ into user_fields_, thread-safe and idempotent
+    void ensure_user_fields() const;
 
     uint64_t time_{};  // optional, not set automatically
 
@@ -4,7 +4,73 @@
 
 namespace csdb {
 
-inline void UserField::priv::put(::csdb::priv::obstream& os) const {
+template <>
+UserField::UserField(uint64_t value)
+: type_(UserField::Integer)
+, i_value_(value) {
+}
+
+template <>
+UserField::UserField(const ::std::string& value)
+: type_(UserField::String)
+, i_value_(0)
+, s_value_(value) {
+}
+
+template <>
+UserField::UserField(const ::csdb::Amount& value)
+: type_(UserField::Amount)
+, i_value_(0)
+, a_value_(value) {
+}
+
+UserField::UserField(const char* value)
+: type_(UserField::String)
+, i_value_(0)
+, s_value_(value) {
+}
+
+bool UserField::is_valid() const noexcept {
+    return (Unknown != type_);
+}
+
+UserField::Type UserField::type() const noexcept {
+    return type_;
+}
+
+template <>
+uint64_t UserField::value<uint64_t>() const noexcept {
+    return (Integer == type_) ? i_value_ : 0;
+}
+
+template <>
+::std::string UserField::value<::std::string>() const noexcept {
+    return (String == type_) ? s_value_ : ::std::string{};
+}
+
+template <>
+::csdb::Amount UserField::value<::csdb::Amount>() const noexcept {
+    return (Amount == type_) ? a_value_ : 0_c;
+}
+
+bool UserField::operator==(const UserField& other) const noexcept {
+    if (type_ != other.type_) {
+        return false;
+    }
+
+    switch (type_) {
+        case UserField::Integer:
+            return (i_value_ == other.i_value_);
+        case UserField::String:
+            return (s_value_ == other.s_value_);
+        case UserField::Amount:
+            return (a_value_ == other.a_value_);
+        default:
+            return true;
+    }
+}
+
+void UserField::put(::csdb::priv::obstream& os) const {
     switch (type_) {
         case UserField::Integer:
             os.put(type_);
@@ -26,7 +92,7 @@ inline void UserField::priv::put(::csdb::priv::obstream& os) const {
     }
 }
 
-inline void UserField::priv::put_for_sig(::csdb::priv::obstream& os) const {
+void UserField::put_for_sig(::csdb::priv::obstream& os) const {
     switch (type_) {
         case UserField::Integer:
             os.put(i_value_);
@@ -45,7 +111,36 @@ inline void UserField::priv::put_for_sig(::csdb::priv::obstream& os) const {
     }
 }
 
-inline bool UserField::priv::get(::csdb::priv::ibstream& is) {
+bool UserField::skip(::csdb::priv::ibstream& is) {
+    UserField::Type type;
+    if (!is.get(type)) {
+        return false;
+    }
+    switch (type) {
+        case UserField::Integer: {
+            uint64_t ignored;
+            return is.get(ignored);
+        }
+
+        case UserField::String: {
+            uint32_t size;
+            if (!is.get(size)) {
+                return false;
+            }
+            return is.skip(size);
+        }
+
+        case UserField::Amount: {
+            ::csdb::Amount ignored;
+            return is.get(ignored);
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool UserField::get(::csdb::priv::ibstream& is) {
     UserField::Type type;
     if (!is.get(type)) {
         return false;
@@ -76,82 +171,4 @@ inline bool UserField::priv::get(::csdb::priv::ibstream& is) {
     return true;
 }
 
-inline bool UserField::priv::is_equal(const priv* other) const {
-    if (type_ != other->type_) {
-        return false;
-    }
-
-    switch (type_) {
-        case UserField::Integer:
-            return (i_value_ == other->i_value_);
-        case UserField::String:
-            return (s_value_ == other->s_value_);
-        case UserField::Amount:
-            return (a_value_ == other->a_value_);
-        default:
-            return true;
-    }
-}
-
-template <>
-UserField::UserField(uint64_t value)
-: d(new priv(value)) {
-}
-
-template <>
-UserField::UserField(const ::std::string& value)
-: d(new priv(value)) {
-}
-
-template <>
-UserField::UserField(const ::csdb::Amount& value)
-: d(new priv(value)) {
-}
-
-UserField::UserField(const char* value)
-: d(new priv(::std::string(value))) {
-}
-
-bool UserField::is_valid() const noexcept {
-    return (Unknown != d->type_);
-}
-
-UserField::Type UserField::type() const noexcept {
-    return d->type_;
-}
-
-template <>
-uint64_t UserField::value<uint64_t>() const noexcept {
-    const priv* data = d.constData();
-    return (Integer == data->type_) ? data->i_value_ : 0;
-}
-
-template <>
-::std::string UserField::value<::std::string>() const noexcept {
-    const priv* data = d.constData();
-    return (String == data->type_) ? data->s_value_ : ::std::string{};
-}
-
-template <>
-::csdb::Amount UserField::value<::csdb::Amount>() const noexcept {
-    const priv* data = d.constData();
-    return (Amount == data->type_) ? data->a_value_ : 0_c;
-}
-
-bool UserField::operator==(const UserField& other) const noexcept {
-    return d->is_equal(other.d);
-}
-
-void UserField::put(::csdb::priv::obstream& os) const {
-    d->put(os);
-}
-
-void UserField::put_for_sig(::csdb::priv::obstream& os) const {
-    d->put_for_sig(os);
-}
-
-bool UserField::get(::csdb::priv::ibstream& is) {
-    return d->get(is);
-}
-
 }  // namespace csdb
@@ -350,6 +350,25 @@ TEST_F(AmountTest, Plus)
   EXPECT_EQ((-1.6) + 2.6_c, 1_c);
 }
 
+TEST_F(AmountTest, Accumulator)
+{
+  AmountAccumulator acc;
+  for (int i = 0; i < 100; ++i) {
+    acc += 0.3_c;
+  }
+  EXPECT_EQ(acc.value(), 30_c);
+
+  const Amount values[] = {1.6_c, 2.6_c, -1.2_c, 0.5_c};
+  EXPECT_EQ(accumulate(values, 4), 3.5_c);
+
+  AmountAccumulator negative;
+  negative += -1.6_c;
+  negative += -2.6_c;
+  EXPECT_EQ(negative.value(), -4.2_c);
+
+  EXPECT_EQ(AmountAccumulator().value(), 0_c);
+}
+
 TEST_F(AmountTest, Minus)
 {
   EXPECT_EQ(2_c - 1_c, 1_c);
@@ -79,6 +79,27 @@ TEST_ENCDEC(uint64_t_1p, uint64_t, 1, "\x02")
 TEST_ENCDEC(uint64_t_max, uint64_t, std::numeric_limits<uint64_t>::max(), "\xFE")
 TEST_ENCDEC(uint64_t_max_1m, uint64_t, std::numeric_limits<uint64_t>::max() >> 2, "\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x3F")
 
+TEST_F(IntegralEncDec, DecodeRun)
+{
+  const int64_t src[] = {0, 1, -1, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), 127};
+  const std::size_t count = sizeof(src) / sizeof(src[0]);
+  char buf[count * ::csdb::priv::MAX_INTEGRAL_ENCODED_SIZE];
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    size += ::csdb::priv::encode(buf + size, src[i]);
+  }
+
+  uint64_t dst[count];
+  EXPECT_EQ(::csdb::priv::decode_run(buf, size, dst, count), size);
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(static_cast<int64_t>(dst[i]), src[i]);
+  }
+
+  // буфер короче последовательности — ничего не декодируем
+  EXPECT_EQ(::csdb::priv::decode_run(buf, size - 1, dst, count), 0);
+  EXPECT_EQ(::csdb::priv::decode_run(buf, 0, dst, count), 0);
+}
+
 // enum
 TEST_F(IntegralEncDec, Enum)
 {
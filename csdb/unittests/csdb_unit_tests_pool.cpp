@@ -383,6 +383,22 @@ TEST_F(PoolTest, FromBinaryInvalidEmpty)
   }
 }
 
+TEST_F(PoolTest, FromBinaryUnsupportedFormatVersion)
+{
+  Pool src(PoolHash::calc_from_data({1}), 1);
+  EXPECT_TRUE(src.compose());
+  ::csdb::internal::byte_array binary = src.to_binary();
+  ASSERT_FALSE(binary.empty());
+
+  // the leading byte of the envelope is the format version; a version this
+  // build does not know must be rejected instead of being misdecoded
+  binary[0] = 0x7F;
+  EXPECT_FALSE(Pool::from_binary(::csdb::internal::byte_array(binary)).is_valid());
+
+  size_t cnt = 0;
+  EXPECT_FALSE(Pool::meta_from_binary(std::move(binary), cnt).is_valid());
+}
+
 TEST_F(PoolTest, ErrorSaveInvalidOrUncomposed)
 {
   Storage s;
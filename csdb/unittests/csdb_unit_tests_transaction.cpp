@@ -215,6 +215,35 @@ TEST_F(TransactionTest, UserFieldSerialize)
   EXPECT_EQ(src, res);
 }
 
+TEST_F(TransactionTest, UserFieldLazyDecode)
+{
+  Transaction src(addr1, addr2, Currency("CS"), 1_c);
+  EXPECT_TRUE(src.add_user_field(1, 100));
+  EXPECT_TRUE(src.add_user_field(2, "Text"));
+
+  ::csdb::internal::byte_array enc = src.to_binary();
+  Transaction res = Transaction::from_binary(enc);
+  ASSERT_TRUE(res.is_valid());
+
+  // presence checks and reserialization must not require decoded fields
+  EXPECT_TRUE(res.contains_user_field(1));
+  EXPECT_TRUE(res.contains_user_field(2));
+  EXPECT_FALSE(res.contains_user_field(3));
+  EXPECT_EQ(res.to_binary(), enc);
+
+  // materialized values still round-trip
+  EXPECT_EQ(res.user_field(1), UserField(100));
+  EXPECT_EQ(res.user_field(2), UserField("Text"));
+  EXPECT_TRUE(res.contains_user_field(1));
+  EXPECT_FALSE(res.contains_user_field(3));
+
+  // mutating after decode drops the wire form and stays consistent
+  Transaction copy = Transaction::from_binary(enc);
+  EXPECT_TRUE(copy.add_user_field(3, 123.456_c));
+  EXPECT_EQ(copy.user_field_ids(), ::std::set<user_field_id_t>({1,2,3}));
+  EXPECT_EQ(copy.user_field(3), UserField(123.456_c));
+}
+
 TEST_F(TransactionTest, Balance)
 {
   {
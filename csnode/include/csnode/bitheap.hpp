@@ -1,14 +1,30 @@
 #ifndef BITHEAP_H
 #define BITHEAP_H
 
-#include <bitset>
+#include <array>
 #include <climits>
+#include <cstdint>
 #include <limits>
+#include <string>
+#include <type_traits>
 
 #include <boost/serialization/serialization.hpp>
-#include <boost/serialization/bitset.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/string.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace cs {
+
+// dense window of recently seen values just below the greatest one, stored as
+// explicit 64-bit words. The word layout keeps contains() a single indexed test
+// and lets pop() of the greatest value skip empty words instead of walking the
+// window bit by bit, which matters for hot wallets whose tails are popped and
+// re-pushed in bursts. The external semantics and the serialized representation
+// are exactly those of the former std::bitset-based implementation: validation
+// verdicts are consensus-critical and caches written by older nodes must load
 template <typename T, size_t BitSize = sizeof(T) * CHAR_BIT, typename = std::enable_if<std::is_integral<T>::value>>
 class BitHeap {
 public:
@@ -18,6 +34,7 @@ public:
     BitHeap()
         : greatest_(std::numeric_limits<T>::max())
         , isValueSet_(false) {
+        words_.fill(0);
     }
 
     void push(T val) {
@@ -29,42 +46,39 @@ public:
 
         if (val > greatest_) {
             T shift = val - greatest_;
-            bits_ <<= shift;
+            shiftLeft(shift >= static_cast<T>(BitSize) ? BitSize : static_cast<size_t>(shift));
             // curr greatest
-            size_t ind = shift - 1;
+            size_t ind = static_cast<size_t>(shift) - 1;
             if (ind < BitSize)
-                bits_.set(ind);
+                set(ind);
             // new greatest
             greatest_ = val;
         }
         else if (val < greatest_) {
-            size_t ind = greatest_ - val - 1;
+            size_t ind = static_cast<size_t>(greatest_ - val) - 1;
             if (ind < BitSize)
-                bits_.set(ind);
+                set(ind);
         }
     }
 
     void pop(T val) {
         if (val < greatest_) {
-            size_t ind = greatest_ - val - 1;
+            size_t ind = static_cast<size_t>(greatest_ - val) - 1;
             if (ind < BitSize) {
-                bits_.reset(ind);
+                reset(ind);
             }
             return;
         }
         if (val == greatest_) {
-            --greatest_;
-            int count = BitSize;
-            while (!bits_[0] && count--) {
-                bits_ >>= 1;
-                --greatest_;
-            }
-            if (count < 0) {
+            const size_t first = findFirstSet();
+            if (first == BitSize) {
                 isValueSet_ = false;
                 greatest_ = std::numeric_limits<T>::max();
                 return;
             }
-            bits_ >>= 1;
+            // the next remembered value becomes the implicit greatest
+            greatest_ -= static_cast<T>(first + 1);
+            shiftRight(first + 1);
         }
     }
 
@@ -82,9 +96,9 @@ public:
         else if (val == greatest_)
             return true;
         else {
-            size_t ind = greatest_ - val - 1;
+            size_t ind = static_cast<size_t>(greatest_ - val) - 1;
             if (ind < BitSize)
-                return bits_.test(ind) == 1;
+                return test(ind);
             else
                 return false;
         }
@@ -93,8 +107,12 @@ public:
     size_t count() const {
         if (empty())
             return 0;
-        else
-            return 1 + bits_.count();
+
+        size_t result = 1;
+        for (uint64_t word : words_) {
+            result += popCount(word);
+        }
+        return result;
     }
 
     T getGreatest() {
@@ -102,17 +120,136 @@ public:
     }
 
 private:
+    constexpr static size_t kWordBits = 64;
+    constexpr static size_t kWords = (BitSize + kWordBits - 1) / kWordBits;
+
+    void set(size_t ind) {
+        words_[ind / kWordBits] |= uint64_t(1) << (ind % kWordBits);
+    }
+
+    void reset(size_t ind) {
+        words_[ind / kWordBits] &= ~(uint64_t(1) << (ind % kWordBits));
+    }
+
+    bool test(size_t ind) const {
+        return (words_[ind / kWordBits] >> (ind % kWordBits)) & 1;
+    }
+
+    // index of the lowest set bit, BitSize when the window is all zero
+    size_t findFirstSet() const {
+        for (size_t w = 0; w < kWords; ++w) {
+            if (words_[w] != 0) {
+                return w * kWordBits + countTrailingZeros(words_[w]);
+            }
+        }
+        return BitSize;
+    }
+
+    void shiftLeft(size_t n) {
+        if (n >= BitSize) {
+            words_.fill(0);
+            return;
+        }
+        const size_t wordShift = n / kWordBits;
+        const size_t bitShift = n % kWordBits;
+        for (size_t i = kWords; i-- > 0;) {
+            uint64_t value = 0;
+            if (i >= wordShift) {
+                value = words_[i - wordShift] << bitShift;
+                if (bitShift != 0 && i > wordShift) {
+                    value |= words_[i - wordShift - 1] >> (kWordBits - bitShift);
+                }
+            }
+            words_[i] = value;
+        }
+        trimTail();
+    }
+
+    void shiftRight(size_t n) {
+        if (n >= BitSize) {
+            words_.fill(0);
+            return;
+        }
+        const size_t wordShift = n / kWordBits;
+        const size_t bitShift = n % kWordBits;
+        for (size_t i = 0; i < kWords; ++i) {
+            uint64_t value = 0;
+            if (i + wordShift < kWords) {
+                value = words_[i + wordShift] >> bitShift;
+                if (bitShift != 0 && i + wordShift + 1 < kWords) {
+                    value |= words_[i + wordShift + 1] << (kWordBits - bitShift);
+                }
+            }
+            words_[i] = value;
+        }
+    }
+
+    // keeps bits beyond BitSize clear when the window is not word-aligned
+    void trimTail() {
+        constexpr size_t used = BitSize % kWordBits;
+        if constexpr (used != 0) {
+            words_[kWords - 1] &= (uint64_t(1) << used) - 1;
+        }
+    }
+
+    static size_t countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return static_cast<size_t>(index);
+#else
+        return static_cast<size_t>(__builtin_ctzll(value));
+#endif
+    }
+
+    static size_t popCount(uint64_t value) {
+#if defined(_MSC_VER)
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return static_cast<size_t>((value * 0x0101010101010101ull) >> 56);
+#else
+        return static_cast<size_t>(__builtin_popcountll(value));
+#endif
+    }
+
     friend class boost::serialization::access;
+
+    // the window travels in the character form the std::bitset serializer
+    // emitted, so caches written before the word-array rewrite load unchanged
+    template<class Archive>
+    void save(Archive& ar, [[maybe_unused]] const unsigned int version) const {
+        ar & greatest_;
+        ar & isValueSet_;
+        std::string bits(BitSize, '0');
+        for (size_t i = 0; i < BitSize; ++i) {
+            if (test(i)) {
+                bits[BitSize - 1 - i] = '1';
+            }
+        }
+        ar & bits;
+    }
+
     template<class Archive>
-    void serialize(Archive &ar, [[maybe_unused]] const unsigned int version) {
+    void load(Archive& ar, [[maybe_unused]] const unsigned int version) {
         ar & greatest_;
         ar & isValueSet_;
-        ar & bits_;
+        std::string bits;
+        ar & bits;
+        words_.fill(0);
+        const size_t limit = bits.size() < BitSize ? bits.size() : BitSize;
+        for (size_t i = 0; i < limit; ++i) {
+            if (bits[bits.size() - 1 - i] == '1') {
+                set(i);
+            }
+        }
     }
 
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
     T greatest_;
     uint8_t isValueSet_;
-    std::bitset<BitSize> bits_;
+    std::array<uint64_t, kWords> words_;
 };
 
 }  // namespace cs
@@ -2,6 +2,7 @@
 #define BLOCKCHAIN_HPP
 
 #include <chrono>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
@@ -22,6 +23,7 @@
 #include <csnode/nodecore.hpp>
 #include <csnode/multiwallets.hpp>
 #include <csnode/walletsids.hpp>
+#include <csnode/blockreadcache.hpp>
 #include <csnode/poolcache.hpp>
 #include <csnode/caches_serialization_manager.hpp>
 
@@ -47,6 +49,8 @@ using TryToStoreBlockSignal = cs::Signal<void(const csdb::Pool&, bool*)>;
 using NeedStopSignal = cs::Signal<void(bool)>;
 /** @brief   The new block signal emits when finalizeBlock() occurs just before recordBlock() */
 using StoreBlockSignal = cs::Signal<void(const csdb::Pool&)>;
+/** @brief   The batched new block signal emits with several stored blocks at once while synchronization is active */
+using StoreBlocksBatchSignal = cs::Signal<void(const std::vector<csdb::Pool>&)>;
 using OrderNecessaryBlockSignal = cs::Signal<void(csdb::PoolHash, cs::Sequence)>;
 
 /** @brief   The write block or remove block signal emits when block is flushed to disk */
@@ -146,6 +150,14 @@ public:
     void removeWalletsInPoolFromCache(const csdb::Pool& pool);
     void removeLastBlock();
     void showDBParams();
+
+    // LMDB map sizes, for metrics export
+    size_t getBlockHashesDbMapSize() const;
+    size_t getTrxIndexDbMapSize() const;
+
+    // LMDB map occupancy in percent, to provision before a remap stall
+    size_t getBlockHashesDbOccupancy() const;
+    size_t getTrxIndexDbOccupancy() const;
     /**
      * Mark last block as compromised and handle the situation:
      *  - store required parameters  
@@ -254,6 +266,11 @@ public:
         return uncertainLastBlockFlag_;
     }
 
+    // turns on grouped delivery through storeBlocksBatchEvent, called when pool synchronization starts
+    void startStoreBatching();
+    // flushes the pending batch and returns to immediate delivery, called when pool synchronization finishes
+    void stopStoreBatching();
+
 public signals:
     //orderNecessaryBlock(&tryBlock, lastBlock.sequence());
     cs::OrderNecessaryBlockSignal orderNecessaryBlock;
@@ -261,6 +278,11 @@ public signals:
     /** @brief The new block event. Raised when the next incoming block is finalized and just before stored into chain */
     cs::StoreBlockSignal storeBlockEvent;
 
+    /** @brief The batched variant of storeBlockEvent. While batching is active (pool synchronization) blocks are
+        delivered in groups of up to kStoreBatchSize, so subscribers amortize their per-call overhead across the batch.
+        Subscribers connect either to storeBlockEvent or to this one, not to both */
+    cs::StoreBlocksBatchSignal storeBlocksBatchEvent;
+
     cs::NeedStopSignal stopNode;
 
     /** @brief The event storing synchronized block. Raised when the next incoming block is trying to be stored into chain */
@@ -313,6 +335,7 @@ public:
     csdb::Pool loadBlock(const csdb::PoolHash&) const;
     csdb::Pool loadBlock(const cs::Sequence sequence) const;
     csdb::Pool loadBlockForSync(const cs::Sequence sequence) const;
+    std::vector<csdb::Pool> loadBlocksForSync(const cs::Sequence fromSeq, const std::size_t count) const;
     csdb::Pool loadBlockMeta(const csdb::PoolHash&, size_t& cnt) const;
     csdb::Transaction loadTransaction(const csdb::TransactionID&) const;
     void iterateOverWallets(const std::function<bool(const cs::PublicKey&, const cs::WalletsCache::WalletData&)>);
@@ -357,6 +380,11 @@ public:
     csdb::TransactionID getLastTransaction(const csdb::Address&) const;
     cs::Sequence getPreviousPoolSeq(const csdb::Address&, cs::Sequence) const;
 
+    // bulk variant: the whole per-address chain in one index transaction,
+    // newest first; see TransactionsIndex::getPrevTransBlocks
+    std::vector<cs::Sequence> getPreviousPoolSeqs(const csdb::Address&, cs::Sequence,
+                                                  size_t maxHops = std::numeric_limits<size_t>::max()) const;
+
     std::pair<cs::Sequence, uint32_t> getLastNonEmptyBlock();
     std::pair<cs::Sequence, uint32_t> getPreviousNonEmptyBlock(cs::Sequence);
     uint64_t getTransactionsCount() const {
@@ -420,6 +448,9 @@ private:
     bool finalizeBlock(csdb::Pool& pool, bool isTrusted, cs::PublicKeys lastConfidants);
     bool applyBlockToCaches(const csdb::Pool& pool);
 
+    void appendToStoreBatch(const csdb::Pool& pool);
+    void flushStoreBatch();
+
     void onStartReadFromDB(cs::Sequence lastWrittenPoolSeq);
     void onReadFromDB(csdb::Pool block, bool* shouldStop);
     bool postInitFromDB(bool successfulQuickStart);
@@ -438,6 +469,10 @@ private:
     mutable std::recursive_mutex dbLock_;
     csdb::Storage storage_;
 
+    // two-level pool read cache with sequential readahead in front of
+    // storage_, used and invalidated under dbLock_ (see loadBlock)
+    mutable cs::BlockReadCache readCache_;
+
     std::unique_ptr<cs::BlockHashes> blockHashes_;
     std::unique_ptr<cs::TransactionsIndex> trxIndex_;
 
@@ -460,6 +495,21 @@ private:
     std::map<cs::Sequence, NonEmptyBlockData> previousNonEmpty_;
     NonEmptyBlockData lastNonEmptyBlock_;
 
+    // continuation cursors for paged getTransactions(): remembers where the previous page
+    // of a wallet ended, so the next sequential page resumes the walk in O(1) instead of
+    // re-skipping the whole chain of links from the head; any new transaction of the wallet
+    // shifts every offset, so a cursor is reusable only while the wallet's last transaction
+    // is still the same
+    struct TransactionsCursor {
+        uint64_t offset = 0;
+        csdb::TransactionID head;
+        csdb::TransactionID last;
+    };
+
+    static const size_t MaxTransactionsCursors = 1000;
+    std::mutex transactionsCursorsMutex_;
+    std::map<csdb::Address, TransactionsCursor> transactionsCursors_;
+
     /**
      * @fn    std::optional<csdb::Pool> BlockChain::recordBlock(csdb::Pool pool, std::optional<cs::PrivateKey> writer_key);
      *
@@ -487,6 +537,12 @@ private:
     mutable std::mutex cachedBlocksMutex_;
     std::unique_ptr<cs::PoolCache> cachedBlocks_;
 
+    // grouped delivery of stored blocks, active only while pool synchronization runs
+    static const size_t kStoreBatchSize = 16;
+    mutable std::mutex storeBatchMutex_;
+    std::vector<csdb::Pool> storeBatch_;
+    bool storeBatchingOn_ = false;
+
     // block storage to defer storing it in blockchain until confirmation from other nodes got
     // (idea is it is more easy not to store block immediately then to revert it after storing)
     csdb::Pool deferredBlock_;
@@ -545,6 +601,16 @@ private:
 
     cs::CachesSerializationManager* serializationManPtr_ = nullptr;
 
+    // serializing every cache for a checkpoint takes long enough to miss a
+    // round, so periodic checkpoints run on a worker thread; the head below
+    // is refreshed under cacheMutex_ on every applied block and the worker
+    // reads it under the same lock, so the serialized caches and the chain
+    // position they claim always match. Only the round that happens to
+    // complete during the save waits, the triggering one returns at once
+    void saveCheckpointAsync(size_t checkpointKeep);
+    cs::CheckpointHead cachesHead_;
+    std::atomic_bool checkpointRunning_ = false;
+
     // compare only state content: transactions, new wallets, sequence, round fee, user fields
     // true if both pools are not valid, or both pools have equal state content
     static bool testContentEqual(const csdb::Pool& lhs, const csdb::Pool& rhs);
@@ -1,6 +1,7 @@
 #ifndef BLOCKHASHES_HPP
 #define BLOCKHASHES_HPP
 
+#include <algorithm>
 #include <map>
 
 #include <csdb/pool.hpp>
@@ -18,6 +19,16 @@ public:
 
     size_t size() const;
 
+    // combined LMDB map size of both databases, for metrics export
+    size_t dbMapSize() const {
+        return seqDb_.mapSize() + hashDb_.mapSize();
+    }
+
+    // the fuller of the two maps in percent; provisioning watches the worst one
+    size_t dbOccupancyPercent() const {
+        return std::max(seqDb_.occupancyPercent(), hashDb_.occupancyPercent());
+    }
+
     void close();
     bool onNextBlock(const csdb::Pool& block) {
         return update(block);
@@ -37,8 +48,18 @@ private slots:
 private:
     void initialization();
 
+    // commits all buffered mappings, one LMDB transaction per database
+    void flushBuffer();
+
+    // mappings arrive one per block; committing an LMDB transaction each time
+    // dominates hash-index maintenance during sync, so appends are buffered
+    // and written behind in batches
+    static constexpr size_t kWriteBufferLimit = 256;
+
     cs::Lmdb seqDb_;
     cs::Lmdb hashDb_;
+
+    std::map<cs::Sequence, cs::Bytes> pending_;
 };
 }  // namespace cs
 
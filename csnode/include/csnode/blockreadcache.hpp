@@ -0,0 +1,70 @@
+#ifndef BLOCK_READ_CACHE_HPP
+#define BLOCK_READ_CACHE_HPP
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <csdb/pool.hpp>
+#include <csnode/compressor.hpp>
+#include <lib/system/common.hpp>
+
+namespace cs {
+// two-level read cache in front of pool storage: a small level of recently
+// used deserialized pools over a larger level of lz4-compressed pool bytes.
+// Pools evicted from the first level are demoted to the second instead of
+// being dropped. API walks (pool listing, transaction iteration) are
+// strongly sequential, so a run of consecutive accesses switches misses to
+// a multi-pool readahead and the following requests become hits.
+// Not synchronized on its own - the blockchain drives it under the same
+// lock that already guards storage reads.
+class BlockReadCache {
+public:
+    using RangeLoader = std::function<std::vector<csdb::Pool>(cs::Sequence, size_t)>;
+
+    // returns the pool for the sequence, loading through loadRange on miss;
+    // loadRange may return fewer pools than asked, extra ones are cached
+    csdb::Pool get(cs::Sequence sequence, const RangeLoader& loadRange);
+
+    // drops every cached pool with sequence >= from, called on rollback
+    void invalidateFrom(cs::Sequence from);
+
+    void clear();
+
+    size_t hits() const {
+        return hits_;
+    }
+
+    size_t misses() const {
+        return misses_;
+    }
+
+private:
+    constexpr static size_t kMaxPools = 128;
+    constexpr static size_t kMaxCompressed = 1024;
+    constexpr static size_t kPrefetchDepth = 32;
+    constexpr static size_t kSequentialRun = 4;
+
+    void noteAccess(cs::Sequence sequence);
+    void storePool(const csdb::Pool& pool);
+    void storeCompressed(const csdb::Pool& pool);
+
+    // first level: deserialized pools, most recently used at the front
+    std::list<std::pair<cs::Sequence, csdb::Pool>> pools_;
+    std::unordered_map<cs::Sequence, std::list<std::pair<cs::Sequence, csdb::Pool>>::iterator> poolIndex_;
+
+    // second level: compressed pool bytes, fed by evictions and readahead
+    std::list<std::pair<cs::Sequence, CompressedRegion>> compressed_;
+    std::unordered_map<cs::Sequence, std::list<std::pair<cs::Sequence, CompressedRegion>>::iterator> compressedIndex_;
+
+    Compressor compressor_;
+
+    cs::Sequence lastSequence_ = 0;
+    size_t sequentialRun_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+}  // namespace cs
+#endif  // BLOCK_READ_CACHE_HPP
@@ -60,6 +60,12 @@ private:
     Node& node_;
     const BlockChain& bc_;
 
+    // always-on plugins composed at compile time, one fused chain walk per
+    // validation call instead of a registry lookup with virtual dispatch
+    struct CoreChain;
+    std::unique_ptr<CoreChain> core_;
+
+    // dynamic registry, only optional diagnostic plugins live here
     std::map<ValidationLevel, std::unique_ptr<ValidationPlugin>> plugins_;
 
     friend class ValidationPlugin;
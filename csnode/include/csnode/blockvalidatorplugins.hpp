@@ -27,6 +27,13 @@ public:
     using ErrorType = BlockValidator::ErrorType;
     virtual ErrorType validateBlock(const csdb::Pool&) = 0;
 
+    // dependency declaration: independent plugins only read the block, the chain
+    // and prevBlock, so they may run concurrently with each other; plugins that
+    // mutate shared state (wallets, accumulated balances) must stay sequential
+    virtual bool isIndependent() const {
+        return false;
+    }
+
 protected:
     Node& getNode() {
         return blockValidator_.node_;    
@@ -50,7 +57,11 @@ private:
     BlockValidator& blockValidator_;
 };
 
-class SmartStateValidator : public ValidationPlugin {
+// concrete plugins are final: the statically composed core chain in
+// blockvalidator.cpp reaches them through their exact type, so the
+// validateBlock calls devirtualize on the common all-pass path
+
+class SmartStateValidator final : public ValidationPlugin {
 public:
     SmartStateValidator(BlockValidator& bv) : ValidationPlugin(bv) {}
     ErrorType validateBlock(const csdb::Pool&) override;
@@ -59,39 +70,51 @@ private:
     bool checkNewState(const csdb::Transaction&);
 };
 
-class HashValidator : public ValidationPlugin {
+class HashValidator final : public ValidationPlugin {
 public:
     HashValidator(BlockValidator& bv)
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+    bool isIndependent() const override {
+        return true;
+    }
 };
 
-class BlockNumValidator : public ValidationPlugin {
+class BlockNumValidator final : public ValidationPlugin {
 public:
     BlockNumValidator(BlockValidator& bv)
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+    bool isIndependent() const override {
+        return true;
+    }
 };
 
-class TimestampValidator : public ValidationPlugin {
+class TimestampValidator final : public ValidationPlugin {
 public:
     TimestampValidator(BlockValidator& bv)
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+    bool isIndependent() const override {
+        return true;
+    }
 };
 
-class BlockSignaturesValidator : public ValidationPlugin {
+class BlockSignaturesValidator final : public ValidationPlugin {
 public:
     BlockSignaturesValidator(BlockValidator& bv)
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+    bool isIndependent() const override {
+        return true;
+    }
 };
 
-class SmartSourceSignaturesValidator : public ValidationPlugin {
+class SmartSourceSignaturesValidator final : public ValidationPlugin {
 public:
     using Transactions = std::vector<csdb::Transaction>;
     using SmartSignatures = std::vector<csdb::Pool::SmartSignature>;
@@ -101,6 +124,9 @@ public:
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+    bool isIndependent() const override {
+        return true;
+    }
 
 private:
     bool containsNewState(const Transactions&);
@@ -115,7 +141,7 @@ private:
 ///
 /// @brief check balances when prev block was added to blockchain
 ///
-class BalanceChecker : public ValidationPlugin {
+class BalanceChecker final : public ValidationPlugin {
 public:
     BalanceChecker(BlockValidator& bv)
     : ValidationPlugin(bv) {
@@ -130,7 +156,7 @@ private:
 ///
 /// @brief check balances of the given block accounts
 ///
-class BalanceOnlyChecker : public ValidationPlugin {
+class BalanceOnlyChecker final : public ValidationPlugin {
 public:
     BalanceOnlyChecker(BlockValidator& bv)
         : ValidationPlugin(bv) {
@@ -141,18 +167,21 @@ private:
     static constexpr csdb::Amount zeroBalance_ = 0;
 };
 
-class TransactionsChecker : public ValidationPlugin {
+class TransactionsChecker final : public ValidationPlugin {
 public:
     TransactionsChecker(BlockValidator& bv)
     : ValidationPlugin(bv) {
     }
     ErrorType validateBlock(const csdb::Pool&) override;
+    bool isIndependent() const override {
+        return true;
+    }
 
 private:
     bool checkSignature(const csdb::Transaction&);
 };
 
-class AccountBalanceChecker : public ValidationPlugin
+class AccountBalanceChecker final : public ValidationPlugin
 {
 public:
 
@@ -65,6 +65,17 @@ public:
     bool isLoadedFromCompletedSnapshot() const;
     void pruneCheckpoints(size_t keep);
 
+    // Snapshot bootstrap: packs the newest chain-bound checkpoint into one
+    // portable file, signed with the exporter's node key. A fresh replica
+    // imports it instead of replaying the chain and then syncs only blocks
+    // past the checkpoint sequence.
+    bool exportSnapshot(const std::string& filePath, const cs::PrivateKey& key);
+    // Verifies the exporter signature (and, when trustedKeys is non-empty,
+    // that the exporter key is a member) and unpacks the checkpoint into the
+    // quick-start root; the regular load() then applies the usual hash and
+    // chain-binding checks.
+    bool importSnapshot(const std::string& filePath, const std::set<cs::PublicKey>& trustedKeys);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> pImpl_;
@@ -1,6 +1,7 @@
 #ifndef COMPRESSOR_HPP
 #define COMPRESSOR_HPP
 
+#include <cstring>
 #include <mutex>
 
 #include <lz4.h>
@@ -16,9 +17,26 @@ class Compressor {
 public:
     enum Compression : cs::Byte {
         None = 0,
-        Compressed = 1
+        Compressed = 1,
+        CompressedWithDictionary = 2
     };
 
+    // lz4 default, higher values trade ratio for speed
+    static constexpr int DefaultAcceleration = 1;
+
+    // loads a static dictionary shared by all subsequent compressions.
+    // Both producer and consumer of a message family must be configured
+    // with byte-identical dictionaries, so set it up before first use
+    // and never change it while regions created with it are still alive.
+    // lz4 only uses the last 64 KB
+    void setDictionary(cs::Bytes dictionary) {
+        dictionary_ = std::move(dictionary);
+    }
+
+    void setAcceleration(int acceleration) {
+        acceleration_ = acceleration;
+    }
+
     static Compression checkCompression(const cs::Byte* data, size_t size) {
         return size < 2 ? Compression::None : Compression(*(data));
     }
@@ -27,6 +45,10 @@ public:
         return checkCompression(region.data(), region.size());
     }
 
+    static Compression checkCompression(const CompressedRegionView& region) {
+        return checkCompression(region.data(), region.size());
+    }
+
     // returns compressed bytes
     // compression may failed of errors or no possibility to compress
     // bytes representation will be copied to region ptr anyway
@@ -43,8 +65,8 @@ public:
         const auto maxSize = LZ4_compressBound(binSize);
 
         cs::Bytes region(static_cast<size_t>(byteSizeof_ + maxSize));
-        const int compressedSize = LZ4_compress_default(data, reinterpret_cast<char*>(region.data()) + byteSizeof_, binSize,
-                                                        cs::numeric_cast<int>(region.size()) - byteSizeof_);
+        const int compressedSize = compressBuffer(data, reinterpret_cast<char*>(region.data()) + byteSizeof_, binSize,
+                                                  cs::numeric_cast<int>(region.size()) - byteSizeof_);
 
         CompressedRegion::SizeType size = 0;
 
@@ -56,26 +78,92 @@ public:
             size = static_cast<uint32_t>(compressedSize + byteSizeof_);
         }
 
-        *(static_cast<cs::Byte*>(region.data())) = compressedSize ? Compression::Compressed : Compression::None;
+        *(static_cast<cs::Byte*>(region.data())) = compressionMarker(compressedSize);
         region.resize(size);
 
         return CompressedRegion { std::move(region), static_cast<size_t>(binSize) };
     }
 
+    // gather-style variant of compress(): the region is compressed straight
+    // into the tail of out, after whatever the caller already wrote there
+    // (e.g. a packet header), using the wire framing ODataStream emits for
+    // CompressedRegion (binary size, then size-prefixed region bytes). The
+    // send path can then hand one buffer to the socket layer without
+    // re-copying megabytes of already-compressed payload
+    template<typename T>
+    void compressInto(const T& entity, cs::Bytes& out) {
+        cs::Bytes bytes;
+        cs::ODataStream stream(bytes);
+
+        stream << entity;
+
+        auto data = reinterpret_cast<char*>(bytes.data());
+        const int binSize = cs::numeric_cast<int>(bytes.size());
+
+        const auto maxSize = LZ4_compressBound(binSize);
+
+        const size_t headerSize = out.size();
+        const size_t framingSize = sizeof(size_t) * 2; // binary size + region size
+
+        out.resize(headerSize + framingSize + static_cast<size_t>(byteSizeof_ + maxSize));
+
+        auto regionPtr = reinterpret_cast<char*>(out.data()) + headerSize + framingSize;
+        const int compressedSize = compressBuffer(data, regionPtr + byteSizeof_, binSize, maxSize);
+
+        CompressedRegion::SizeType size = 0;
+
+        if (!compressedSize) {
+            std::copy(data, data + binSize, regionPtr + byteSizeof_);
+            size = static_cast<uint32_t>(binSize + byteSizeof_);
+        }
+        else {
+            size = static_cast<uint32_t>(compressedSize + byteSizeof_);
+        }
+
+        *(reinterpret_cast<cs::Byte*>(regionPtr)) = compressionMarker(compressedSize);
+        out.resize(headerSize + framingSize + size);
+
+        const size_t binarySize = static_cast<size_t>(binSize);
+        const size_t regionSize = static_cast<size_t>(size);
+        std::memcpy(out.data() + headerSize, &binarySize, sizeof(binarySize));
+        std::memcpy(out.data() + headerSize + sizeof(binarySize), &regionSize, sizeof(regionSize));
+    }
+
     // try to decompress data, returns object if serializable
     template<typename T>
     T decompress(const CompressedRegion& region) {
+        return decompress<T>(CompressedRegionView { region.data(), region.size(), region.binarySize() });
+    }
+
+    // view overload, uncompressed payload is parsed in place without any copy
+    template<typename T>
+    T decompress(const CompressedRegionView& region) {
         const auto compression = checkCompression(region.data(), region.size());
 
         cs::Bytes bytes;
         cs::Byte* data = nullptr;
         size_t size = 0;
 
-        if (compression == Compression::Compressed) {
+        if (compression != Compression::None) {
             bytes.resize(region.binarySize());
 
-            const int uncompressedSize = LZ4_decompress_safe(reinterpret_cast<char*>(region.data()) + byteSizeof_, reinterpret_cast<char*>(bytes.data()),
-                                                             cs::numeric_cast<int>(region.size()) - byteSizeof_, cs::numeric_cast<int>(region.binarySize()));
+            int uncompressedSize = 0;
+
+            if (compression == Compression::CompressedWithDictionary) {
+                if (dictionary_.empty()) {
+                    cserror() << "No dictionary configured to decompress " << cstype(T);
+                    return T{};
+                }
+
+                uncompressedSize = LZ4_decompress_safe_usingDict(reinterpret_cast<char*>(region.data()) + byteSizeof_, reinterpret_cast<char*>(bytes.data()),
+                                                                 cs::numeric_cast<int>(region.size()) - byteSizeof_, cs::numeric_cast<int>(region.binarySize()),
+                                                                 reinterpret_cast<const char*>(dictionary_.data()), cs::numeric_cast<int>(dictionary_.size()));
+            }
+            else {
+                uncompressedSize = LZ4_decompress_safe(reinterpret_cast<char*>(region.data()) + byteSizeof_, reinterpret_cast<char*>(bytes.data()),
+                                                       cs::numeric_cast<int>(region.size()) - byteSizeof_, cs::numeric_cast<int>(region.binarySize()));
+            }
+
             if (uncompressedSize < 0) {
                 cserror() << "Decompress error of " << cstype(T);
                 return T{};
@@ -98,7 +186,32 @@ public:
     }
 
 private:
+    // compresses with the configured dictionary when one is set;
+    // returns 0 when the data is incompressible or on error
+    int compressBuffer(const char* source, char* destination, int sourceSize, int capacity) {
+        if (dictionary_.empty()) {
+            return LZ4_compress_fast(source, destination, sourceSize, capacity, acceleration_);
+        }
+
+        LZ4_stream_t stream;
+        LZ4_resetStream(&stream);
+        LZ4_loadDict(&stream, reinterpret_cast<const char*>(dictionary_.data()), cs::numeric_cast<int>(dictionary_.size()));
+
+        return LZ4_compress_fast_continue(&stream, source, destination, sourceSize, capacity, acceleration_);
+    }
+
+    cs::Byte compressionMarker(int compressedSize) const {
+        if (!compressedSize) {
+            return Compression::None;
+        }
+
+        return dictionary_.empty() ? Compression::Compressed : Compression::CompressedWithDictionary;
+    }
+
     static inline int byteSizeof_ = sizeof(cs::Byte);
+
+    cs::Bytes dictionary_;
+    int acceleration_ = DefaultAcceleration;
 };
 
 // multi-threaded compressor
@@ -110,12 +223,24 @@ public:
         return Compressor::compress(entity);
     }
 
+    template<typename T>
+    void compressInto(const T& entity, cs::Bytes& out) {
+        cs::Lock lock(mutex_);
+        Compressor::compressInto(entity, out);
+    }
+
     template<typename T>
     T decompress(CompressedRegion region) {
         cs::Lock lock(mutex_);
         return Compressor::decompress<T>(region);
     }
 
+    template<typename T>
+    T decompress(const CompressedRegionView& region) {
+        cs::Lock lock(mutex_);
+        return Compressor::decompress<T>(region);
+    }
+
 protected:
     std::mutex mutex_;
 };
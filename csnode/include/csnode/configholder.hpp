@@ -1,6 +1,9 @@
 #ifndef CONFIGHOLDER_HPP
 #define CONFIGHOLDER_HPP
 
+#include <atomic>
+#include <memory>
+
 #include <config.hpp>
 
 #include <lib/system/signals.hpp>
@@ -19,11 +22,20 @@ public:
     void setConfig(const Config& config);
     const Config* config() const;
 
+    // consistent snapshot, stays valid across a concurrent reload; paths reading
+    // several settings should take one snapshot and use it throughout
+    std::shared_ptr<const Config> snapshot() const;
+
+    // incremented on every reload, lets consumers cheaply detect that values
+    // derived from the config must be rebuilt
+    uint64_t version() const;
+
 public slots:
     void onConfigChanged(const Config& config);
 
 private:
     cs::LockFreeChanger<Config> config_;
+    std::atomic<uint64_t> version_ = { 0 };
 };
 } // namespace cs
 #endif  // CONFIGHOLDER_HPP
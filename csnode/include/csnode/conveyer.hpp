@@ -20,6 +20,7 @@ using StatesSignal = cs::Signal<void(const std::vector<csdb::Transaction>&)>;
 using RoundChangeSignal = cs::Signal<void(cs::RoundNumber)>;
 using PacketExpiredSignal = cs::Signal<void(const cs::TransactionsPacket&)>;
 using RejectTransactionsSignal = cs::Signal<void(const cs::TransactionsPacket&)>;
+using MemoryPressureSignal = cs::Signal<void(size_t usedBytes, size_t budgetBytes)>;
 
 ///
 /// @brief The Conveyer class, represents utils and mechanics
@@ -58,8 +59,10 @@ public:
     /// @brief Adds transaction to conveyer, start point of conveyer.
     /// @param transaction csdb Transaction, not valid transavtion would not be
     /// sent to network.
+    /// @return admission verdict, callers facing clients should report
+    /// everything except Added back to the sender
     ///
-    void addTransaction(const csdb::Transaction& transaction);
+    PacketQueue::PushResult addTransaction(const csdb::Transaction& transaction);
 
     ///
     /// @brief Adds packet to transactions block as monolith entity.
@@ -68,6 +71,13 @@ public:
     ///
     void addContractPacket(TransactionsPacket& packet);
 
+    ///
+    /// @brief Adds bulk of packets to transactions block, locks conveyer once.
+    /// @param packets Created from outside packets with transactions, moved in.
+    /// @warning Client should guarantee that packets have expired time, hash and sign
+    ///
+    void addContractPackets(cs::PacketsVector&& packets);
+
     ///
     /// @brief Adds transactions packet received by network.
     /// @param packet Created from network transactions packet.
@@ -252,6 +262,55 @@ public:
     ///
     std::optional<cs::TransactionsPacket> findPacket(const cs::TransactionsPacketHash& hash, const cs::RoundNumber round) const;
 
+    ///
+    /// @brief Searches transactions packet at current round sharded table.
+    /// Locks only one table shard in shared mode, never the conveyer mutex.
+    /// @warning Thread safe.
+    ///
+    std::optional<cs::TransactionsPacket> findPacketInCurrentTable(const cs::TransactionsPacketHash& hash) const;
+
+    ///
+    /// @brief Builds a digest of a stored packet: per-transaction fingerprints instead of
+    /// transaction bodies. Smart packets are never digested, their state transactions
+    /// can not be restored by the receiver.
+    /// @return Returns digest if the packet is found and digestable, otherwise returns nothing.
+    /// @warning No thread safe.
+    ///
+    std::optional<cs::PacketDigest> makePacketDigest(const cs::TransactionsPacketHash& hash, cs::RoundNumber round) const;
+
+    ///
+    /// @brief Tries to rebuild digested packets from transactions the current table already
+    /// holds under a different grouping. Every rebuilt packet must reproduce the digested
+    /// hash exactly, otherwise its hash is reported as still missing.
+    /// @return Returns reconstructed packets and hashes that need a full packet request.
+    /// @warning No thread safe.
+    ///
+    std::pair<cs::PacketsVector, cs::PacketsHashes> assembleFromDigests(const cs::PacketDigests& digests) const;
+
+    ///
+    /// @brief Encodes hashes as a bitmask over the round table hash order. Both peers
+    /// received the same ordered hash list with the table, so bit indices substitute
+    /// the 32-byte hashes in repeated sync requests.
+    /// @return Returns mask bytes if the round table is known and contains every hash,
+    /// otherwise returns nothing.
+    /// @warning No thread safe.
+    ///
+    std::optional<cs::Bytes> makeHashIndexMask(cs::RoundNumber round, const cs::PacketsHashes& hashes) const;
+
+    ///
+    /// @brief Resolves a mask built by makeHashIndexMask() back to hashes.
+    /// @return Returns empty hashes if the round table is unknown or the mask length
+    /// does not match its hash count.
+    /// @warning No thread safe.
+    ///
+    cs::PacketsHashes resolveHashIndexMask(cs::RoundNumber round, const cs::Bytes& mask) const;
+
+    ///
+    /// @brief Returns packet existence state at current round sharded table.
+    /// @warning Thread safe.
+    ///
+    bool isPacketInCurrentTable(const cs::TransactionsPacketHash& hash) const;
+
     bool isPacketAtMeta(const cs::TransactionsPacketHash& hash) const;
     ///
     /// @brief Returns existing of invalid transaction in meta storage.
@@ -271,6 +330,12 @@ public:
     ///
     size_t packetsTableSize() const;
 
+    ///
+    /// @brief Returns summary bytes held by conveyer caches: the packet queue,
+    /// the current round table and every cached round meta. Thread safe.
+    ///
+    size_t cachedBytes() const;
+
     // sync, try do not use it :]
     std::unique_lock<cs::SharedMutex> lock() const;
 
@@ -281,9 +346,13 @@ public signals:
     cs::PacketExpiredSignal packetExpired;
     cs::RejectTransactionsSignal transactionsRejected;
 
+    // emitted when the share of the memory budget held by conveyer caches
+    // changes, both on the way up and on the way back down
+    cs::MemoryPressureSignal memoryPressureChanged;
+
 public slots:
 
-    /// try to send transactions packets to network
+    /// try to send transactions packets to network, sending timer driven
     void flushTransactions();
 
 private slots:
@@ -302,6 +371,25 @@ protected:
     // returns true if packet is found at cache, otherwise - false
     bool isPacketAtCache(const cs::TransactionsPacket& packet);
 
+    // lock-free stale/garbage round filter: rejects rounds the meta storage
+    // can no longer (or not yet plausibly) hold, checked before any locking
+    bool isRoundInAcceptanceWindow(cs::RoundNumber round) const;
+
+    // keeps cached bytes within the configured budget: oldest non-current
+    // round metas are evicted first, remaining pressure is pushed into packet
+    // queue admission. Call with the conveyer exclusively locked
+    void enforceMemoryBudget();
+
+    // shared flush body; a zero coalesce window releases the partial tail
+    // packet immediately, the path watermark flushes take
+    void flushQueue(std::chrono::milliseconds coalesceWindow);
+
+    // schedules an immediate out-of-timer flush once the packet queue crosses
+    // a configured transaction count or byte volume watermark; transactions
+    // arriving right after a timer tick stop waiting out the next one.
+    // Call with the conveyer exclusively locked
+    void scheduleEarlyFlushIfWatermarked();
+
 private:
     struct Impl;
     std::unique_ptr<Impl> pimpl_;
@@ -0,0 +1,38 @@
+#ifndef DATASTREAMLAYOUT_HPP
+#define DATASTREAMLAYOUT_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace cs {
+namespace datastream {
+///
+/// Compile-time wire size of a fixed-layout stream field.
+///
+/// Scalars occupy sizeof(T) bytes, std::array fields occupy one byte per element
+/// to match addArray()/parseArray(). Byte order is the host order, exactly as
+/// the per-field addValue()/parseValue() path writes it.
+///
+template <typename T>
+struct WireSize {
+    static_assert(std::is_trivially_copyable_v<T>, "Fixed-layout stream fields must be trivially copyable");
+    static constexpr std::size_t value = sizeof(T);
+};
+
+template <typename T, std::size_t size>
+struct WireSize<std::array<T, size>> {
+    static constexpr std::size_t value = size;
+};
+
+///
+/// Total wire size of a pack of fixed-layout fields, computed at compile time.
+///
+template <typename... Ts>
+constexpr std::size_t wireSizeOf() {
+    return (WireSize<Ts>::value + ... + std::size_t(0));
+}
+}  // namespace datastream
+}  // namespace cs
+
+#endif  // DATASTREAMLAYOUT_HPP
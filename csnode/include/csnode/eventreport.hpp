@@ -2,6 +2,7 @@
 #define EVENTREPORT_HPP
 
 #include <lib/system/common.hpp>
+#include <lib/system/stacksampler.hpp>
 
 #include <cstdint>
 #include <vector>
@@ -83,7 +84,8 @@ public:
         EraseFromList,
         RejectTransactions,
         RejectContractExecution,
-        RunningStatus
+        RunningStatus,
+        RoundStallTrace
     };
 
     static Id getId(const cs::Bytes& bin_pack);
@@ -279,6 +281,37 @@ public:
 
     static bool parseRunningStatus(const cs::Bytes& bin_pack, Running::Status& status);
 
+    /**
+     * Sends stack samples captured during an overlong round.
+     *
+     * The samples carry raw return addresses of the node's service threads,
+     * intended for offline symbolization against the shipped binary, so the
+     * collector gets a first-incident flame graph instead of waiting for the
+     * stall to reproduce under a profiler. Oversized captures are thinned
+     * evenly to keep the report within one network message.
+     *
+     * @param [in,out]  node        The node service.
+     * @param           round       The round that overran its deadline.
+     * @param           durationMs  The observed round duration, ms.
+     * @param           samples     The captured stacks, product of cs::StackSampler::capture().
+     */
+
+    static void sendRoundStallTrace(Node& node, cs::RoundNumber round, uint64_t durationMs, const std::vector<cs::StackSampler::Sample>& samples);
+
+    /**
+     * Parse a round stall trace report
+     *
+     * @param           bin_pack    The byte array pack, must be a product of sendRoundStallTrace()
+     *  call on remote node.
+     * @param [in,out]  round       The placeholder for the stalled round.
+     * @param [in,out]  durationMs  The placeholder for the observed duration.
+     * @param [in,out]  samples     The placeholder for the captured stacks.
+     *
+     * @returns True if it succeeds, false if it fails.
+     */
+
+    static bool parseRoundStallTrace(const cs::Bytes& bin_pack, cs::RoundNumber& round, uint64_t& durationMs, std::vector<cs::StackSampler::Sample>& samples);
+
 private:
 
     static void sendListUpdate(Node& node, const cs::PublicKey& key, bool added, uint32_t count_rounds);
@@ -0,0 +1,89 @@
+#if !defined(EVENTSPOOL_HPP)
+#define EVENTSPOOL_HPP
+
+#include <lib/system/common.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace cs {
+
+///
+/// @brief Asynchronous spool for outgoing event reports.
+///
+/// Event emission happens on the dispatch and consensus paths, and during
+/// incident storms (mass disconnects, consensus problems) the signing and
+/// sending of every report used to compete with recovery traffic on the
+/// emitting thread. The spool decouples the two: producers append the raw
+/// event pack to a bounded lock-free ring and return immediately, a
+/// background thread periodically drains the ring, collapses byte-identical
+/// repeats and ships the batch through the supplied shipper under a simple
+/// token-bucket rate limit. When the ring is full or the rate limit is
+/// exhausted events are dropped and counted - telemetry must never add
+/// latency or backpressure to the node itself.
+///
+class EventSpool {
+public:
+    using Shipper = std::function<void(const cs::Bytes&)>;
+
+    explicit EventSpool(Shipper shipper);
+    ~EventSpool();
+
+    void start();
+    void stop();
+
+    /// never blocks; returns false when the ring is full and the event is dropped
+    bool enqueue(cs::Bytes&& binPack);
+
+    uint64_t droppedCount() const {
+        return droppedCount_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void routine();
+    bool dequeue(cs::Bytes& binPack);
+    void flush();
+
+    // ring capacity, must be a power of two; full ring means the collector
+    // is already far behind, so further events carry little extra signal
+    constexpr static size_t kCapacity = 1024;
+    constexpr static std::chrono::milliseconds kFlushPeriod{100};
+    // token bucket: sustained and burst limits on shipped reports
+    constexpr static size_t kMaxEventsPerSecond = 50;
+    constexpr static size_t kMaxBurst = 100;
+    constexpr static std::chrono::seconds kDropLogPeriod{10};
+
+    // bounded multi-producer ring (Vyukov scheme): every slot carries a
+    // sequence number, so producers claim slots with a single CAS and the
+    // consumer never takes a lock
+    struct Slot {
+        std::atomic<size_t> sequence;
+        cs::Bytes pack;
+    };
+
+    std::array<Slot, kCapacity> ring_;
+    std::atomic<size_t> enqueuePos_{ 0 };
+    size_t dequeuePos_ = 0;  // consumer thread only
+
+    std::atomic<uint64_t> droppedCount_{ 0 };
+    uint64_t reportedDropped_ = 0;
+    std::chrono::steady_clock::time_point lastDropLog_;
+
+    double tokens_ = kMaxBurst;
+    std::chrono::steady_clock::time_point lastRefill_;
+
+    Shipper shipper_;
+    std::atomic<bool> stopped_{ true };
+    std::condition_variable stopCv_;
+    std::mutex stopMux_;
+    std::thread thread_;
+};
+
+}  // namespace cs
+#endif  // EVENTSPOOL_HPP
@@ -2,10 +2,12 @@
 #define IDATASTREAM_HPP
 
 #include <algorithm>
+#include <cstring>
 #include <exception>
 #include <string>
 #include <type_traits>
 
+#include <csnode/datastreamlayout.hpp>
 #include <csnode/nodecore.hpp>
 
 #include <csdb/pool.hpp>
@@ -58,7 +60,9 @@ public:
     /// @return Returns state of available bytes.
     ///
     bool isAvailable(std::size_t size) {
-        return (index_ + size) <= dataSize_;
+        // subtraction form, (index_ + size) could wrap around for a length
+        // field taken straight from a hostile packet and pass the check
+        return index_ <= dataSize_ && size <= dataSize_ - index_;
     }
 
     ///
@@ -102,8 +106,15 @@ public:
             return array;
         }
 
-        for (std::size_t i = 0; i < size; ++i) {
-            array[i] = static_cast<T>(data_[i + index_]);
+        // one-byte elements match the wire format exactly, so the whole
+        // array is one memcpy; keys, signatures and hashes all take this path
+        if constexpr (sizeof(T) == 1 && std::is_trivially_copyable_v<T>) {
+            std::memcpy(array.data(), data_ + index_, size);
+        }
+        else {
+            for (std::size_t i = 0; i < size; ++i) {
+                array[i] = static_cast<T>(data_[i + index_]);
+            }
         }
 
         index_ += size;
@@ -125,15 +136,31 @@ public:
             return str;
         }
 
-        for (std::size_t i = 0; i < size; ++i) {
-            str[i] = data_[i + index_];
-        }
-
+        std::memcpy(str.data(), data_ + index_, size);
         index_ += size;
 
         return str;
     }
 
+    ///
+    /// Reads a pack of fixed-layout fields with a single availability check.
+    ///
+    /// The total size of the pack is known at compile time, so per-field
+    /// branches are removed from hot parsing paths. The wire format is exactly
+    /// the one produced by field-by-field operator>>.
+    ///
+    template <typename... Ts>
+    inline void parseFields(Ts&... fields) {
+        constexpr std::size_t packSize = datastream::wireSizeOf<Ts...>();
+
+        if (!isAvailable(packSize)) {
+            badState();
+            return;
+        }
+
+        (parseFixedField(fields), ...);
+    }
+
     ///
     /// Returns byte size of write/read data.
     ///
@@ -277,6 +304,28 @@ private:
     void badState() {
         state_ = false;
     }
+
+    // availability is checked once by parseFields() for the whole pack
+    template <typename T>
+    inline void parseFixedField(T& field) {
+        static_assert(std::is_trivially_copyable_v<T>, "Fixed-layout stream fields must be trivially copyable");
+        std::memcpy(&field, data_ + index_, sizeof(T));
+        index_ += sizeof(T);
+    }
+
+    template <typename T, std::size_t size>
+    inline void parseFixedField(std::array<T, size>& array) {
+        if constexpr (sizeof(T) == 1 && std::is_trivially_copyable_v<T>) {
+            std::memcpy(array.data(), data_ + index_, size);
+        }
+        else {
+            for (std::size_t i = 0; i < size; ++i) {
+                array[i] = static_cast<T>(data_[i + index_]);
+            }
+        }
+
+        index_ += size;
+    }
 };
 
 template <typename T, std::size_t size>
@@ -352,6 +401,58 @@ inline IDataStream& operator>>(IDataStream& stream, csdb::Pool& pool) {
     return stream;
 }
 
+///
+/// Bulk overload for vectors of fixed-size arrays.
+///
+/// Stage messages and round tables are mostly runs of public keys and
+/// signatures; reading them element by element pays a bounds check per entry.
+/// Byte-element arrays have no padding and match the wire format exactly, so
+/// the whole run is validated once and copied with a single memcpy.
+///
+template <typename T, std::size_t arraySize, typename U>
+inline IDataStream& operator>>(IDataStream& stream, std::vector<std::array<T, arraySize>, U>& entities) {
+    std::size_t size = 0;
+    stream >> size;
+
+    if (size == 0) {
+        return stream;
+    }
+
+    if constexpr (sizeof(T) == 1 && std::is_trivially_copyable_v<T>) {
+        // the division keeps size * arraySize from overflowing on a
+        // malformed count, which would otherwise sail past the bounds
+        // check into the allocation below
+        if (size > stream.size() / arraySize || !stream.isAvailable(size * arraySize)) {
+            return stream;
+        }
+
+        std::vector<std::array<T, arraySize>, U> expectedEntities(size);
+        std::memcpy(expectedEntities.data(), stream.data(), size * arraySize);
+        stream.skip(size * arraySize);
+
+        entities = std::move(expectedEntities);
+    }
+    else {
+        if (!stream.isAvailable(size)) {
+            return stream;
+        }
+
+        std::vector<std::array<T, arraySize>, U> expectedEntities;
+        expectedEntities.reserve(size);
+
+        for (std::size_t i = 0; i < size; i++) {
+            std::array<T, arraySize> entity;
+            stream >> entity;
+
+            expectedEntities.push_back(entity);
+        }
+
+        entities = std::move(expectedEntities);
+    }
+
+    return stream;
+}
+
 template <typename T, typename U>
 inline IDataStream& operator>>(IDataStream& stream, std::vector<T, U>& entities) {
     std::size_t size = 0;
@@ -395,6 +496,14 @@ inline IDataStream& operator>>(IDataStream& stream, std::pair<T, U>& pair) {
     return stream;
 }
 
+inline IDataStream& operator>>(IDataStream& stream, cs::PacketDigest& digest) {
+    stream >> digest.hash;
+    stream >> digest.expiredRound;
+    stream >> digest.fingerprints;
+    stream >> digest.signatures;
+    return stream;
+}
+
 inline IDataStream& operator>>(IDataStream& stream, csdb::Amount& amount) {
     cs::Bytes bytes;
     stream >> bytes;
@@ -419,6 +528,21 @@ inline IDataStream& operator>>(IDataStream& stream, CompressedRegion& region) {
 
     return stream;
 }
+
+inline IDataStream& operator>>(IDataStream& stream, CompressedRegionView& region) {
+    std::size_t binarySize = 0;
+    stream >> binarySize;
+
+    std::size_t size = 0;
+    stream >> size;
+
+    if (size != 0 && stream.isAvailable(size)) {
+        region = CompressedRegionView { reinterpret_cast<cs::Byte*>(stream.data()), size, binarySize };
+        stream.skip(size);
+    }
+
+    return stream;
+}
 }  // namespace cs
 
 #endif  // IDATASTREAM_HPP
@@ -1,6 +1,7 @@
 #ifndef ITER_VALIDATOR_HPP
 #define ITER_VALIDATOR_HPP
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <vector>
@@ -48,7 +49,7 @@ private:
 
     std::mutex sMutex_;
 
-    size_t rCounter_;
+    std::atomic<size_t> rCounter_;
 };
 
 class IterValidator::SimpleValidator {
@@ -1,12 +1,14 @@
 #ifndef MULTIWALLETS_HPP
 #define MULTIWALLETS_HPP
 
+#include <iterator>
 #include <mutex>
 
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/ranked_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 
 #include <csnode/walletscache.hpp>
@@ -25,6 +27,7 @@ public:
 #ifdef MONITOR_NODE
        , ByCreateTime
 #endif
+       , ByKeyOrdered
     };
 
     enum class Order {
@@ -38,13 +41,18 @@ public:
     csdb::Amount balance(const PublicKey& key) const;
     uint64_t transactionsCount(const PublicKey& key) const;
 
+    // vectored variant of balance(): resolves the whole batch under one
+    // shared lock, so every answer comes from the same cache snapshot.
+    // Results keep submission order, unknown keys resolve to zero
+    std::vector<csdb::Amount> balances(const std::vector<PublicKey>& keys) const;
+
 #ifdef MONITOR_NODE
     uint64_t createTime(const PublicKey& key) const;
 #endif
 
     template<Tags tag>
     std::vector<InternalData> iterate(int64_t offset, int64_t limit, Order order = Order::Greater) const {
-        cs::Lock lock(mutex_);
+        cs::SharedLock lock(mutex_);
         auto& bucket = indexes_.get<tag>();
 
         if (static_cast<int64_t>(bucket.size()) < offset || limit == 0) {
@@ -59,14 +67,21 @@ public:
     csdb::Amount checkWallets();
     void iterate(std::function<bool(const PublicKey& key, const InternalData& data)> func);
 
+    // key-ordered resumable scan for bulk export: copies up to limit wallets
+    // with keys greater than after, or from the first key when fromStart is
+    // set. The shared lock covers a single batch, so a long export interleaves
+    // with cache updates instead of pinning them out for the whole dump; keys
+    // inserted behind the scan position are picked up, keys inserted before it
+    // wait for the next dump
+    std::vector<InternalData> nextBatch(const PublicKey& after, size_t limit, bool fromStart = false) const;
+
 protected:
     template <Order order, typename Bucket>
     std::vector<InternalData> shadowIterate(Bucket& bucket, int64_t offset, int64_t limit, int64_t capacity) const {
         std::vector<InternalData> result;
         result.reserve(static_cast<size_t>(capacity));
 
-        auto [begin, end] = rangeOrder<order>(bucket);
-        std::advance(begin, offset);
+        auto [begin, end] = rangeOrder<order>(bucket, static_cast<size_t>(offset));
 
         for (; begin != end; ++begin) {
             result.push_back(*begin);
@@ -79,13 +94,14 @@ protected:
         return result;
     }
 
+    // ranked indexes position pagination offsets in O(log n) via nth()
     template<Order order, typename Bucket>
-    constexpr auto rangeOrder(Bucket& bucket) const {
+    constexpr auto rangeOrder(Bucket& bucket, size_t offset) const {
         if constexpr(order == Order::Greater) {
-            return std::make_pair(bucket.begin(), bucket.end());
+            return std::make_pair(bucket.nth(offset), bucket.end());
         }
         else {
-            return std::make_pair(bucket.rbegin(), bucket.rend());
+            return std::make_pair(std::make_reverse_iterator(bucket.nth(bucket.size() - offset)), bucket.rend());
         }
     }
 
@@ -100,16 +116,19 @@ private:
     using Container = boost::multi_index_container<InternalData,
         indexed_by<
             hashed_unique<member<InternalData, PublicKey, &InternalData::key_>>,
-            ordered_non_unique<member<InternalData, csdb::Amount, &InternalData::balance_>, std::greater<csdb::Amount>>,
-            ordered_non_unique<member<InternalData, uint64_t, &InternalData::transNum_>, std::greater<uint64_t>>,
+            ranked_non_unique<member<InternalData, csdb::Amount, &InternalData::balance_>, std::greater<csdb::Amount>>,
+            ranked_non_unique<member<InternalData, uint64_t, &InternalData::transNum_>, std::greater<uint64_t>>,
 #ifdef MONITOR_NODE
-            ordered_non_unique<member<InternalData, uint64_t, &InternalData::createTime_>, std::greater<uint64_t>>,
+            ranked_non_unique<member<InternalData, uint64_t, &InternalData::createTime_>, std::greater<uint64_t>>,
 #endif
             ordered_unique<member<InternalData, PublicKey, &InternalData::key_>>
         >
     >;
 
-    mutable std::mutex mutex_;
+    // writers are per-wallet updates from block application, readers are
+    // API queries: shared lock keeps lookups from stalling behind each other
+    // while a block is being applied
+    mutable cs::SharedMutex mutex_;
     Container indexes_;
 };
 }
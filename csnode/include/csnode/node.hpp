@@ -30,6 +30,7 @@ class SolverCore;
 namespace cs {
 class PoolSynchronizer;
 class BlockValidator;
+class EventSpool;
 }  // namespace cs
 
 namespace cs::config {
@@ -99,14 +100,21 @@ public:
     void performRoundPackage(cs::RoundPackage& rPackage, const cs::PublicKey& sender, bool updateRound);
     bool isTransactionsInputAvailable();
     void clearRPCache(cs::RoundNumber rNum);
+    bool isVerifiedRoundPackage(cs::RoundNumber rNum, const cs::Hash& packageHash) const;
+    void markRoundPackageVerified(cs::RoundNumber rNum, const cs::Hash& packageHash);
     void sendHash(cs::RoundNumber round);
     void getHash(const uint8_t* data, const size_t size, cs::RoundNumber rNum, const cs::PublicKey& sender);
     void roundPackRequest(const cs::PublicKey& respondent, cs::RoundNumber round);
+    void getRoundPackageHash(const uint8_t* data, const size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender);
     void askConfidantsRound(cs::RoundNumber round, const cs::ConfidantsKeys& confidants);
     void getRoundPackRequest(const uint8_t* data, const size_t size, cs::RoundNumber rNum, const cs::PublicKey& sender);
     void emptyRoundPackReply(const cs::PublicKey & respondent);
     void getEmptyRoundPack(const uint8_t * data, const size_t size, cs::RoundNumber rNum, const cs::PublicKey & sender);
     void roundPackReply(const cs::PublicKey& respondent);
+
+    // assembled RoundTable reply packet, rebuilt only when the package changes;
+    // a wave of lagging peers after a partition is served from the same bytes
+    const Packet& roundTableReplyPacket(cs::RoundPackage& package);
     void sendHashReply(const csdb::PoolHash& hash, const cs::PublicKey& respondent);
     void getHashReply(const uint8_t* data, const size_t size, cs::RoundNumber rNum, const cs::PublicKey& sender);
 
@@ -174,6 +182,15 @@ public:
     // transaction's pack syncro
     void getPacketHashesRequest(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey&);
     void getPacketHashesReply(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
+
+    // transaction-level reconciliation of missed packets, kilobyte-scale digests
+    // instead of full packet re-sends; falls back to the full packet request
+    void getPacketDigestsRequest(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey&);
+    void getPacketDigestsReply(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
+
+    // compact retry of the hash request: a bitmask over the shared round table
+    // hash order stands in for the explicit 32-byte hash list
+    void getPacketIndexRequest(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey&);
     void getBlockAlarm(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
     void getEventReport(const uint8_t*, const std::size_t, const cs::RoundNumber, const cs::PublicKey& sender);
 
@@ -186,7 +203,7 @@ public:
 
     void accountInitiationRequest(uint64_t& aTime, cs::PublicKey key);
     void cleanConfirmationList(cs::RoundNumber rNum);
-    uint8_t calculateBootStrapWeight(cs::PublicKeys& confidants);
+    uint8_t calculateBootStrapWeight(const cs::PublicKeys& confidants);
     // state syncro functions
     
     void sendStateRequest(const csdb::Address& contract_abs_addr, const cs::PublicKeys& confidants);
@@ -225,20 +242,47 @@ public:
     void sendTransactionsPacket(const cs::TransactionsPacket& packet);
     void sendPacketHashesRequest(const cs::PacketsHashes& hashes, const cs::RoundNumber round, uint32_t requestStep);
     void sendPacketHashesReply(const cs::PacketsVector& packets, const cs::RoundNumber round, const cs::PublicKey& target);
+    void sendPacketDigestsReply(const cs::PacketDigests& digests, const cs::RoundNumber round, const cs::PublicKey& target);
 
     // smarts consensus additional functions:
 
     // syncro send functions
-    void sendBlockReply(const cs::PoolsBlock& poolsBlock, const cs::PublicKey& target);
+    // dictionaryAnchor, when not cs::kWrongSequence, selects the shared sync
+    // compression dictionary offered by the requester (see getBlockRequest)
+    void sendBlockReply(const cs::PoolsBlock& poolsBlock, const cs::PublicKey& target, cs::Sequence dictionaryAnchor = cs::kWrongSequence);
+
+    // short-TTL reply cache for block serving: mass peer restarts request the
+    // same ranges over and over, a hit re-sends the compressed packet without
+    // another storage pass; touched only on the processor thread
+    Packet lookupBlockReplyCache(cs::Sequence fromSeq, size_t count, cs::Sequence dictionaryAnchor);
+    void storeBlockReplyCache(cs::Sequence fromSeq, size_t count, cs::Sequence dictionaryAnchor, const Packet& packet);
 
     void specialSync(cs::Sequence finSeq, cs::PublicKey& source);
     void setTop(cs::Sequence finSeq);
     bool checkKnownIssues(cs::Sequence seq);
 
     void showNeighbours();
+    // per-neighbour link and traffic report, served through the diag API
+    std::string getPeerStatsReport();
     void setIdle();
     void setWorking();
     void showDbParams();
+
+    // warm standby: caches stay hot through normal block application while the
+    // node refuses to enter consensus; a spare flips to full duty in one round
+    void enterStandby();
+    void leaveStandby();
+    bool isStandby() const {
+        return standbyMode_.load(std::memory_order_relaxed);
+    }
+
+    // metrics export helpers
+    uint32_t neighboursCount() const;
+    size_t transportInboxQueueSize();
+
+    const cs::RoundStat& roundStat() const {
+        return stat_;
+    }
     //void restoreSequence(cs::Sequence seq);
 
     uint8_t requestKBAnswer(std::vector<std::string> choice);
@@ -275,6 +319,17 @@ public:
     // this function should filter the packages only using their roundNumber
     MessageActions chooseMessageAction(const cs::RoundNumber, const MsgTypes, const cs::PublicKey);
 
+    // true for stage and hash traffic that only consensus participants consume
+    static bool isConsensusOnlyMessage(const MsgTypes type);
+
+    // permanent observer/API profile set from config at startup; unlike warm
+    // standby it never returns to full duty, so consensus-only messages are
+    // dropped before parsing and stage storages stay empty for the process
+    // lifetime
+    bool isObserver() const {
+        return observerMode_;
+    }
+
     void updateConfigFromFile();
 
     const cs::PublicKey& getNodeIdKey() const {
@@ -391,8 +446,10 @@ public slots:
     void deepBlockValidation(const csdb::Pool& block, bool* shouldStop);
     void sendBlockAlarmSignal(cs::Sequence seq);
     void onRoundTimeElapsed();
+    void onRoundStallTraceCaptured(const std::vector<cs::StackSampler::Sample>& samples, uint64_t durationMs);
     void onNeighbourAdded(const cs::PublicKey& neighbour, cs::Sequence lastSeq, cs::RoundNumber lastRound);
     void onNeighbourRemoved(const cs::PublicKey& neighbour);
+    void onNeighbourLagUpdated(uint64_t rttMs, const cs::PublicKey& neighbour);
 
     bool canSaveSmartStages(cs::Sequence seq, cs::PublicKey key);
 
@@ -400,12 +457,21 @@ private:
     bool init();
     void initPoolSynchronizer();
 
+    // signs and ships a single event report, runs on the event spool thread
+    void sendEventReport(const cs::Bytes& bin_pack);
+
     void setupNextMessageBehaviour();
     void setupPoolSynchronizerBehaviour();
 
     bool sendRoundPackage(const cs::RoundNumber rNum, const cs::PublicKey& target);
     void sendRoundPackageToAll(cs::RoundPackage& rPackage);
 
+    // round package dissemination tree: full packages travel down-tree to a few
+    // fan-out children picked by link RTT, every other neighbour only hears the
+    // package hash and pulls the full copy if nothing arrives in time
+    cs::PublicKeys selectRoundPackageRelay(const cs::PublicKey* sender, cs::PublicKeys& announceTargets) const;
+    void relayRoundPackage(const cs::RoundNumber rNum, cs::Byte subRound, const cs::Bytes& bytes, const cs::PublicKey& sender);
+
     void reviewConveyerHashes();
 
     void processSync();
@@ -449,6 +515,8 @@ private:
     bool good_ = true;
 
     std::atomic_bool stopRequested_{ false };
+    std::atomic_bool standbyMode_{ false };
+    bool observerMode_ = false;
 
     // file names for crypto public/private keys
     inline const static std::string privateKeyFileName_ = "NodePrivate.txt";
@@ -476,6 +544,7 @@ private:
     static const size_t kLastPoolSynchroDelay_ = 30000;
 
     cs::PoolSynchronizer* poolSynchronizer_;
+    cs::EventSpool* eventSpool_;
 
     // sends transactions blocks to network
     cs::Timer sendingTimer_;
@@ -523,8 +592,27 @@ private:
     std::unique_ptr<cs::BlockValidator> blockValidator_;
     std::vector<cs::RoundPackage> roundPackageCache_;
 
+    // hashes of received round package payloads that already passed the group signature checks;
+    // duplicate copies relayed by other neighbours cost a lookup instead of ed25519 verifications
+    std::map<cs::RoundNumber, std::vector<cs::Hash>> verifiedRoundPackageHashes_;
+
     cs::RoundPackage currentRoundPackage_;
     size_t roundPackRequests_ = 0;
+
+    // cached RoundTable reply (see roundTableReplyPacket); the binary size is
+    // part of the key since signatures are appended to the package lazily
+    Packet roundReplyPacket_;
+    cs::RoundNumber roundReplyRound_ = 0;
+    cs::Byte roundReplySubRound_ = 0;
+    size_t roundReplyBinarySize_ = 0;
+
+    // round package dissemination tree state; the lag map is only touched on
+    // the transport processor thread, same as the message handlers
+    constexpr static size_t kRoundPackageFanout = 4;
+    constexpr static int kRoundPackagePullDelayMs = 300;
+    std::map<cs::PublicKey, uint64_t> neighbourLags_;
+    cs::RoundNumber lastRelayedRound_ = 0;
+    cs::RoundNumber roundPackagePullScheduled_ = 0;
     bool lastBlockRemoved_ = false;
     std::map<cs::RoundNumber, uint8_t> receivedBangs;
     std::map<cs::PublicKey, size_t> blackListCounter_;
@@ -543,6 +631,19 @@ private:
     bool isBootstrapRound_ = false;
     cs::CachesSerializationManager cachesSerializationManager_;
 
+    // see lookupBlockReplyCache(); a handful of entries covers the overlap of
+    // restarting peers, anything older than the TTL is likely stale anyway
+    struct BlockReplyCacheEntry {
+        cs::Sequence fromSeq;
+        size_t count;
+        cs::Sequence dictionaryAnchor;
+        std::chrono::steady_clock::time_point createdAt;
+        Packet packet;
+    };
+    constexpr static size_t kBlockReplyCacheLimit = 8;
+    constexpr static std::chrono::milliseconds kBlockReplyCacheTtl{2500};
+    std::vector<BlockReplyCacheEntry> blockReplyCache_;
+
     size_t notInRound_ = 0;
     std::map<cs::PublicKey, std::tuple<cs::Sequence, cs::SyncroMessage, uint64_t>> synchroRequestsLog_;
     std::map<cs::TransactionsPacketHash, cs::RoundNumber> orderedPackets_;
@@ -3,6 +3,7 @@
 
 #include <csdb/pool.hpp>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -10,6 +11,7 @@
 
 #include <client/params.hpp>
 #include <csnode/transactionspacket.hpp>
+#include <csnode/transactionspackettable.hpp>
 
 #include <lib/system/common.hpp>
 #include <lib/system/metastorage.hpp>
@@ -23,8 +25,8 @@ struct hash<cs::TransactionsPacketHash> {
 }  // namespace std
 
 namespace cs {
-// table for fast transactions storage
-using TransactionsPacketTable = std::map<TransactionsPacketHash, TransactionsPacket>;   // to be sorted by default
+// table for fast transactions storage, iterated in sorted hash order
+// (see transactionspackettable.hpp)
 
 // array of notifications
 using Notifications = std::vector<cs::Bytes>;
@@ -87,10 +89,85 @@ struct Characteristic {
     cs::Bytes mask;
 };
 
+///
+/// Interned immutable confidants snapshot. Round tables are copied into the
+/// conveyer metas, round packages and stage bookkeeping many times per round,
+/// and the trusted set rarely changes between rounds - cloning the full key
+/// vector each time was pure waste. Copies of the snapshot share one
+/// reference-counted vector; assigning a key list re-uses the previously
+/// interned vector when the contents are identical. The read interface
+/// mirrors the vector, so holders iterate and index as before.
+///
+class SharedConfidants {
+public:
+    using const_iterator = ConfidantsKeys::const_iterator;
+
+    SharedConfidants();
+    SharedConfidants(ConfidantsKeys keys);
+    SharedConfidants& operator=(ConfidantsKeys keys);
+
+    SharedConfidants(const SharedConfidants&) = default;
+    SharedConfidants(SharedConfidants&&) = default;
+    SharedConfidants& operator=(const SharedConfidants&) = default;
+    SharedConfidants& operator=(SharedConfidants&&) = default;
+
+    const ConfidantsKeys& keys() const {
+        return *data_;
+    }
+
+    operator const ConfidantsKeys&() const {
+        return *data_;
+    }
+
+    size_t size() const {
+        return data_->size();
+    }
+
+    bool empty() const {
+        return data_->empty();
+    }
+
+    const PublicKey& operator[](size_t index) const {
+        return (*data_)[index];
+    }
+
+    const_iterator begin() const {
+        return data_->begin();
+    }
+
+    const_iterator end() const {
+        return data_->end();
+    }
+
+    const_iterator cbegin() const {
+        return data_->cbegin();
+    }
+
+    const_iterator cend() const {
+        return data_->cend();
+    }
+
+    // table construction only, detaches and re-interns the grown list
+    void push_back(const PublicKey& key);
+
+    bool operator==(const SharedConfidants& other) const {
+        return data_ == other.data_ || *data_ == *other.data_;
+    }
+
+    bool operator!=(const SharedConfidants& other) const {
+        return !operator==(other);
+    }
+
+private:
+    static std::shared_ptr<const ConfidantsKeys> intern(ConfidantsKeys&& keys);
+
+    std::shared_ptr<const ConfidantsKeys> data_;
+};
+
 struct RoundTable {
     cs::Bytes toBinary() const;
     RoundNumber round = 0;
-    ConfidantsKeys confidants;
+    SharedConfidants confidants;
     PacketsHashes hashes;
 };
 
@@ -104,6 +181,19 @@ struct PoolMetaInfo {
     std::vector <csdb::Pool::SmartSignature> smartSignatures;
 };
 
+// compact description of a transactions packet used by the digest reconciliation
+// flow: per-transaction fingerprints instead of transaction bodies, so a receiver
+// that already holds the transactions under a different grouping can rebuild the
+// packet locally, see Node::getPacketDigestsReply()
+struct PacketDigest {
+    cs::TransactionsPacketHash hash;
+    cs::RoundNumber expiredRound = 0;
+    std::vector<uint64_t> fingerprints;
+    cs::BlockSignatures signatures;
+};
+
+using PacketDigests = std::vector<PacketDigest>;
+
 // metas
 struct PoolSyncMeta {
     csdb::Pool pool;
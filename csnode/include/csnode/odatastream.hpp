@@ -2,10 +2,12 @@
 #define ODATASTREAM_HPP
 
 #include <algorithm>
+#include <cstring>
 #include <exception>
 #include <string>
 #include <type_traits>
 
+#include <csnode/datastreamlayout.hpp>
 #include <csnode/nodecore.hpp>
 
 #include <csdb/pool.hpp>
@@ -59,6 +61,20 @@ public:
         bytes_->insert(bytes_->end(), array.begin(), array.end());
     }
 
+    ///
+    /// Adds a whole vector of fixed-size byte arrays in one insert.
+    ///
+    /// The elements are contiguous in memory and the wire format stores one
+    /// byte per element, so the run needs no per-entry handling.
+    ///
+    template <typename V, std::size_t size, typename U>
+    inline void addArrays(const std::vector<std::array<V, size>, U>& arrays) {
+        static_assert(sizeof(V) == 1, "Bulk array append expects one byte per element on the wire");
+
+        const auto* begin = reinterpret_cast<const cs::Byte*>(arrays.data());
+        bytes_->insert(bytes_->end(), begin, begin + arrays.size() * size);
+    }
+
     ///
     /// Adds fixed string to stream.
     ///
@@ -69,6 +85,20 @@ public:
         bytes_->insert(bytes_->end(), fixedString.begin(), fixedString.end());
     }
 
+    ///
+    /// Adds a pack of fixed-layout fields with a single storage reservation.
+    ///
+    /// The total size of the pack is known at compile time. The wire format is
+    /// exactly the one produced by field-by-field operator<<.
+    ///
+    template <typename... Vs>
+    inline void addFields(const Vs&... fields) {
+        constexpr std::size_t packSize = datastream::wireSizeOf<Vs...>();
+        bytes_->reserve(bytes_->size() + packSize);
+
+        (addFixedField(fields), ...);
+    }
+
     ///
     /// Returns byte size of written data
     ///
@@ -129,6 +159,21 @@ private:
     void insertBytes(const cs::Byte* data, std::size_t size) {
         insertBytes(reinterpret_cast<const char*>(data), size);
     }
+
+    // storage is reserved once by addFields() for the whole pack
+    template <typename V>
+    inline void addFixedField(const V& field) {
+        static_assert(std::is_trivially_copyable_v<V>, "Fixed-layout stream fields must be trivially copyable");
+
+        const std::size_t offset = bytes_->size();
+        bytes_->resize(offset + sizeof(V));
+        std::memcpy(bytes_->data() + offset, &field, sizeof(V));
+    }
+
+    template <typename V, std::size_t size>
+    inline void addFixedField(const std::array<V, size>& array) {
+        addArray(array);
+    }
 };
 
 template <typename T, typename V, std::size_t size>
@@ -195,6 +240,24 @@ inline ODataStream<T>& operator<<(ODataStream<T>& stream, const csdb::Pool& pool
     return stream;
 }
 
+// bulk overload matching the IDataStream one: runs of keys and signatures
+// are appended in a single insert instead of element by element
+template <typename T, typename V, std::size_t arraySize, typename U>
+inline ODataStream<T>& operator<<(ODataStream<T>& stream, const std::vector<std::array<V, arraySize>, U>& entities) {
+    stream << entities.size();
+
+    if constexpr (sizeof(V) == 1) {
+        stream.addArrays(entities);
+    }
+    else {
+        for (const auto& entity : entities) {
+            stream << entity;
+        }
+    }
+
+    return stream;
+}
+
 template <typename T, typename V, typename U>
 inline ODataStream<T>& operator<<(ODataStream<T>& stream, const std::vector<V, U>& entities) {
     stream << entities.size();
@@ -224,6 +287,15 @@ inline ODataStream<T>& operator<<(ODataStream<T>& stream, const csdb::Amount& am
     stream << amount.toBytes();
     return stream;
 }
+
+template<typename T>
+inline ODataStream<T>& operator<<(ODataStream<T>& stream, const cs::PacketDigest& digest) {
+    stream << digest.hash;
+    stream << digest.expiredRound;
+    stream << digest.fingerprints;
+    stream << digest.signatures;
+    return stream;
+}
 }  // namespace cs
 
 #endif  // ODATASTREAM_HPP
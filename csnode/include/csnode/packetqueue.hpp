@@ -1,8 +1,11 @@
 #ifndef PACKETQUEUE_HPP
 #define PACKETQUEUE_HPP
 
+#include <chrono>
 #include <deque>
+#include <limits>
 #include <optional>
+#include <unordered_map>
 
 #include <csnode/nodecore.hpp>
 #include <boost/noncopyable.hpp>
@@ -11,13 +14,30 @@ namespace cs {
 // implements business logic for transpaction packet
 class PacketQueue : public boost::noncopyable {
 public:
+    // admission verdict for a single transaction; everything except Added is
+    // reported back to the sender instead of being silently dropped
+    enum class PushResult : uint8_t {
+        Added,
+        Invalid,
+        QueueFull,
+        SourceLimitReached,
+        FeeTooLow,
+        Duplicate
+    };
+
     explicit PacketQueue(size_t queueSize, size_t transactionsSize, size_t packetsPerRound);
     ~PacketQueue() = default;
 
-    bool push(const csdb::Transaction& transaction);
+    PushResult push(const csdb::Transaction& transaction);
     void push(const cs::TransactionsPacket& packet);
 
-    cs::PacketsVector pop();
+    // moves all packets to queue in one pass, caller locks once instead of per packet
+    void pushBulk(std::vector<cs::TransactionsPacket>&& packets);
+
+    // pops up to maxPacketsPerRound packets; a partially filled tail packet is
+    // held back while it is younger than the coalesce window, so single
+    // transactions gather into shared packets instead of one packet per tick
+    cs::PacketsVector pop(std::chrono::milliseconds coalesceWindow = std::chrono::milliseconds{0});
 
     std::deque<cs::TransactionsPacket>::const_iterator begin() const;
     std::deque<cs::TransactionsPacket>::const_iterator end() const;
@@ -26,15 +46,62 @@ public:
     bool isEmpty() const;
     std::deque<cs::TransactionsPacket>::const_reference back() const;
 
+    // summary transactions count of all queued packets, O(1), maintained by push/pop
+    size_t transactionsCount() const;
+
+    // summary serialized bytes of all queued packets, O(1), maintained by push/pop
+    size_t bytesCount() const;
+
+    // conveyer-wide memory pressure in percent of the byte budget; at or above
+    // kPressurePercent the same caps fire as on queue fill, at 100 and more
+    // new single transactions are turned away entirely
+    void setMemoryPressure(size_t percent);
+
 private:
+    // fee and serialized size of a queued packet, index-aligned with queue_;
+    // packets without byte accounting (contract packets, separators) are
+    // exempt from fee ordering and stay at the front of the round budget
+    struct FeeProfile {
+        double fee = 0.;
+        size_t bytes = 0;
+
+        double rate() const {
+            return bytes == 0 ? std::numeric_limits<double>::max() : fee / static_cast<double>(bytes);
+        }
+    };
+
+    // moves the best paying packets to the queue front, both groups keep
+    // their arrival order inside themselves
+    void prioritizeFront(size_t budget);
+
+    // pressure enables per-source caps, high pressure additionally prices
+    // admission by fee per byte; below these levels the queue stays pure FIFO
+    static constexpr size_t kPressurePercent = 50;
+    static constexpr size_t kHighPressurePercent = 75;
+    static constexpr double kFeeRateEwmaWindow = 64.;
+
     std::deque<cs::TransactionsPacket> queue_;
+    std::deque<FeeProfile> feeProfiles_;
 
     size_t maxQueueSize_;
     size_t maxTransactionsSize_;
     size_t maxPacketsPerRound_;
 
+    // admission engine state, counters start over on every round change
+    cs::RoundNumber admissionRound_;
+    std::unordered_map<csdb::Address, size_t> sourceCounters_;
+    double admittedFeeRateEwma_;
+
     cs::RoundNumber cachedRound_;
     size_t cachedPackets_;
+    size_t transactionsCount_;
+    size_t bytesCount_;
+
+    // externally supplied pressure, percent of the conveyer byte budget
+    size_t memoryPressurePercent_;
+
+    // when the first transaction entered the current tail packet
+    std::chrono::steady_clock::time_point tailPacketStarted_;
 };
 }
 
@@ -4,6 +4,7 @@
 #include <map>
 #include <optional>
 
+#include <compressor.hpp>
 #include <lmdb.hpp>
 #include <nodecore.hpp>
 
@@ -70,10 +71,24 @@ private slots:
     void onFailed(const cs::LmdbException& exception);
 
 private:
+    // stored value framing: pools close to the pop edge stay raw, entries far
+    // ahead of it (the bulk under heavy desync) are lz4-compressed
+    enum StorageTag : cs::Byte {
+        kRawTag = 0,
+        kCompressedTag = 1
+    };
+
+    // entries within this window above the lowest cached sequence are popped
+    // soon and kept raw
+    static constexpr cs::Sequence kHotWindow = 1024;
+
     void initialization();
     cs::PoolStoreType cachedType(cs::Sequence sequence) const;
     void checkInvariant() const;
 
+    cs::Bytes pack(cs::Sequence sequence, const cs::Bytes& bytes);
+    cs::Bytes unpack(cs::Bytes&& stored) const;
+
     std::vector<Interval> createInterval(cs::Sequence min, cs::Sequence max) const;
 
     size_t syncedPoolSize_ = 0;
@@ -82,6 +97,7 @@ private:
     std::map<cs::Sequence, cs::PoolStoreType> sequences_;
     decltype(sequences_)::iterator syncedIter;
 
+    mutable cs::Compressor compressor_;
     cs::Lmdb db_;
 };
 }
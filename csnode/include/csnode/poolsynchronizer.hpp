@@ -1,12 +1,14 @@
 #ifndef POOLSYNCHRONIZER_HPP
 #define POOLSYNCHRONIZER_HPP
 
+#include <deque>
 #include <mutex>
 
 #include <csdb/pool.hpp>
 
 #include <csnode/blockchain.hpp>
 #include <csnode/nodecore.hpp>
+#include <csnode/sequencebitmap.hpp>
 
 #include <lib/system/common.hpp>
 #include <lib/system/timer.hpp>
@@ -35,6 +37,9 @@ public:
     static const size_t kFreeBlocksTimeoutMs = 10000;
     static const size_t kCachedBlocksLimit = 10000;
 
+    // how many range requests may stay outstanding to distinct neighbours
+    static const size_t kMaxPipelinedRequests = 4;
+
     //void trySource(cs::Sequence finSeq, cs::PublicKey& source);
     //void showNeighbours();
     //void syncTill(cs::Sequence finSeq, const cs::PublicKey& source, bool newCall);
@@ -47,6 +52,7 @@ public slots:
     void onPingReceived(Sequence sequence, const PublicKey& publicKey);
     void onNeighbourAdded(const PublicKey&, Sequence) {}
     void onNeighbourRemoved(const PublicKey& publicKey);
+    void onNeighbourLagUpdated(uint64_t rttMs, const PublicKey& publicKey);
 
 private slots:
     void onTimeOut();
@@ -63,15 +69,40 @@ private:
 
     bool showSyncronizationProgress(Sequence lastWrittenSequence) const;
     void manageSyncBlocks(cs::PoolsBlock&& poolsBlock);
+    void processReplyQueue();
+    size_t awaitingRepliesCount() const;
 
     std::vector<Sequence> getNeededSequences(
         const std::vector<BlockChain::SequenceInterval>& requiredBlocks,
-        Sequence neighbourLastSeq
+        Sequence neighbourLastSeq,
+        size_t requestSize
     );
 
+    // per-peer adaptive request sizing: ranges grow while a peer keeps
+    // answering quickly and shrink when it answers slowly or times out, so
+    // fast peers serve big ranges while slow ones are not pushed into
+    // repeated expirations by a size they cannot deliver in time
+    struct RequestProfile {
+        size_t rangeSize = 0;  // 0 = start from the configured blockPoolsCount
+    };
+
+    size_t requestSizeFor(const PublicKey& neighbour) const;
+    void onRangeServed(const PublicKey& neighbour, uint64_t elapsedMs);
+    void onRangeExpired(const PublicKey& neighbour);
+
+    constexpr static size_t kMinRequestSize = 4;
+    // never request more than this multiple of the configured range size
+    constexpr static size_t kMaxRequestSizeFactor = 4;
+    constexpr static uint64_t kFastReplyMs = 1000;
+    constexpr static uint64_t kSlowReplyMs = 5000;
+
     void synchroFinished();
     size_t nextIndex(size_t index) const;
 
+    // actual neighbours sorted by smoothed ping round-trip, fastest first;
+    // peers without a measured lag go last
+    std::vector<std::pair<PublicKey, Sequence>> neighboursOrderedByLag() const;
+
     BlockChain* blockChain_;
 
     std::atomic<bool> isSyncroStarted_ = false;
@@ -79,9 +110,22 @@ private:
 
     Sequence maxRequestedSequence_ = kWrongSequence;
     std::unordered_map<PublicKey, Sequence> neighbours_;
+    std::unordered_map<PublicKey, uint64_t> neighbourLagMs_;
+    std::unordered_map<PublicKey, RequestProfile> requestProfiles_;
 
     std::map<cs::PublicKey, std::tuple<cs::PoolsRequestedSequences, SyncroMessage, uint64_t>> synchroLog_;
+
+    // one bit per in-flight sequence; makes the "already requested" test O(1)
+    // instead of a scan over every synchroLog_ entry, and lets the needed-range
+    // walk skip whole requested runs through the summary level
+    SequenceBitmap requestedSequences_;
     Timer timer_;
+
+    // replies are stored and handled by a single pool worker, so the network
+    // thread returns to the wire immediately
+    std::deque<cs::PoolsBlock> replyQueue_;
+    std::mutex replyMutex_;
+    std::atomic<bool> replyWorkerBusy_ = false;
 };
 }  // namespace cs
 #endif  // POOLSYNCHRONIZER_HPP
@@ -6,12 +6,26 @@
 namespace cs {
 class RoundPackage {
 public:
+    // wire marker of the delta representation, full packages start with a version byte (0U or 1U)
+    constexpr static cs::Byte DeltaMarker = 2U;
+
     RoundPackage();
 
     const cs::Bytes& toBinary(bool showVersion);
     cs::Byte subRound();
     bool fromBinary(const cs::Bytes& bytes, cs::RoundNumber rNum, cs::Byte subRound);
 
+    static bool isDelta(const cs::Bytes& bytes);
+
+    // serializes against the package of the previous round: the confidants list is omitted
+    // when it did not change since then, the receiver restores it from its own copy of the
+    // previous round table. Returns the ordinary full representation when no delta is possible
+    cs::Bytes toDeltaBinary(const RoundPackage& previous, bool showVersion);
+
+    // restores the full representation from a delta one using confidants of the previous round,
+    // then parses it as usual, so signatures are verified over exactly the bytes the sender signed
+    bool fromDeltaBinary(const cs::Bytes& bytes, const cs::ConfidantsKeys& previousConfidants, cs::RoundNumber rNum, cs::Byte subRound);
+
     std::string toString();
     cs::Bytes bytesToSign(bool showVersion);
     const cs::RoundTable& roundTable() const;
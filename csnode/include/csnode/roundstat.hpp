@@ -6,12 +6,14 @@
 
 #include <lib/system/common.hpp>
 #include <lib/system/signals.hpp>
+#include <lib/system/stacksampler.hpp>
 
 #include <set>
 #include <atomic>
 #include <chrono>
 #include <mutex>
 #include <map>
+#include <vector>
 
 class Config;
 
@@ -21,6 +23,7 @@ constexpr uint64_t daySeconds = 86400ULL;
 
 using PingCheckSignal = cs::Signal<void(cs::Sequence, const cs::PublicKey&)>;
 using AccountStartTimeSignal = cs::Signal<void(uint64_t&, const cs::PublicKey)>;
+using RoundStallTraceSignal = cs::Signal<void(const std::vector<cs::StackSampler::Sample>&, uint64_t)>;
 
 struct NodeStat {
     std::string toString();
@@ -106,6 +109,11 @@ public:
     size_t aveRoundMs() const;
     size_t nodeStartRound() const;
 
+    // percentile over round durations in the perf ring, percentile in [0, 100];
+    // the ring covers the last kRoundPerfWindow finished rounds
+    size_t roundDurationPercentile(double percentile) const;
+    size_t perfRecordsCount() const;
+
     MinedEvaluation getMined() {
         return totalMined_;
     }
@@ -146,15 +154,37 @@ public signals:
     PingCheckSignal pingChecked;
     AccountStartTimeSignal accountInitiationRequest;
 
+    // sampled stacks of the service threads recorded while a round overran
+    // its deadline, with the observed round duration in ms
+    RoundStallTraceSignal roundStallTraceCaptured;
+
 private:
     void checkRoundElapse();
     void checkStoreBlockElapse();
+    void maybeCaptureStallTrace(uint64_t elapsedMs);
     void countTrustAndTrx(const csdb::Pool& block);
     void fillMinedEvaluation(const cs::PublicKeys& confidants, const std::vector<csdb::Amount>& rew);
     void dayChangeProcedure(uint64_t cTime);
     void monthChangeProcedure();
 
     static const int64_t kMaxPingSynchroDelay = 30000;
+    static const size_t kRoundPerfWindow = 3600;    // about an hour of normal rounds
+
+    // stall trace capture: a few seconds of stacks at a coarse interval is
+    // enough to show where the time goes, and the cooldown keeps a persistent
+    // stall from turning the watchdog into a profiler
+    static const size_t kStallTraceDurationMs = 3000;
+    static const size_t kStallTraceIntervalMs = 20;
+    static const size_t kStallTraceCooldownMs = 600000;
+
+    struct RoundPerfRecord {
+        cs::RoundNumber round = 0;
+        uint32_t durationMs = 0;
+        uint32_t transactions = 0;  // transactions of the block stored during that round
+    };
+
+    void appendPerfRecord(cs::RoundNumber round, size_t durationMs);
+
     //<to save>
     // amount of transactions received (to verify or not or to ignore)
     size_t totalReceivedTransactions_;
@@ -176,11 +206,20 @@ private:
 
     std::atomic<size_t> lastRoundMs_;
 
+    // fixed-size ring of per-round records for percentile queries, not serialized
+    mutable std::mutex perfMutex_;
+    std::vector<RoundPerfRecord> perfRing_;
+    size_t perfNext_ = 0;
+    std::atomic<uint32_t> lastBlockTransactions_ = {0};
+
     // round time elapsing calcualtion, store block elapsing and sync
     std::mutex statsElapseMutex_;
     std::chrono::steady_clock::time_point roundElapseTimePoint_;
     std::chrono::steady_clock::time_point storeBlockElapseTimePoint_;
 
+    // only touched from checkRoundElapse(), i.e. the main thread iteration
+    std::chrono::steady_clock::time_point lastStallTracePoint_;
+
     std::chrono::milliseconds checkPingDelta_{0};
     //<to save>
     std::map<cs::PublicKey, cs::NodeStat> nodes_;
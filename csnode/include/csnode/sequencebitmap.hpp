@@ -0,0 +1,188 @@
+#ifndef SEQUENCEBITMAP_HPP
+#define SEQUENCEBITMAP_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+
+// one bit per block sequence in a sliding window above the written chain, with
+// a summary bit over every payload word that is completely set. The summary
+// level lets nextClear() hop over long runs of in-flight sequences 4096 at a
+// time instead of testing them one by one, so synchronizer bookkeeping stays
+// flat even with a multi-hundred-thousand block deficit. The window is trimmed
+// in whole summary strides as the chain advances, which keeps the two levels
+// aligned without ever rebuilding them.
+class SequenceBitmap {
+public:
+    void insert(Sequence sequence) {
+        const uint64_t word = sequence / kBitsPerWord;
+
+        if (words_.empty()) {
+            baseWord_ = word;
+        }
+
+        if (word < baseWord_) {
+            // below the discarded part of the window: already written, a bit
+            // for it would never be read again
+            return;
+        }
+
+        const size_t index = static_cast<size_t>(word - baseWord_);
+
+        if (index >= words_.size()) {
+            words_.resize(index + 1, 0);
+            summary_.resize((words_.size() + kBitsPerWord - 1) / kBitsPerWord, 0);
+        }
+
+        const uint64_t mask = uint64_t(1) << (sequence % kBitsPerWord);
+
+        if ((words_[index] & mask) == 0) {
+            words_[index] |= mask;
+            ++count_;
+
+            if (words_[index] == kAllSet) {
+                summary_[index / kBitsPerWord] |= uint64_t(1) << (index % kBitsPerWord);
+            }
+        }
+    }
+
+    void erase(Sequence sequence) {
+        const uint64_t word = sequence / kBitsPerWord;
+
+        if (words_.empty() || word < baseWord_ || word - baseWord_ >= words_.size()) {
+            return;
+        }
+
+        const size_t index = static_cast<size_t>(word - baseWord_);
+        const uint64_t mask = uint64_t(1) << (sequence % kBitsPerWord);
+
+        if ((words_[index] & mask) != 0) {
+            words_[index] &= ~mask;
+            --count_;
+            summary_[index / kBitsPerWord] &= ~(uint64_t(1) << (index % kBitsPerWord));
+        }
+    }
+
+    bool contains(Sequence sequence) const {
+        const uint64_t word = sequence / kBitsPerWord;
+
+        if (words_.empty() || word < baseWord_ || word - baseWord_ >= words_.size()) {
+            return false;
+        }
+
+        return (words_[word - baseWord_] & (uint64_t(1) << (sequence % kBitsPerWord))) != 0;
+    }
+
+    // first sequence >= the argument whose bit is clear
+    Sequence nextClear(Sequence sequence) const {
+        uint64_t word = sequence / kBitsPerWord;
+
+        if (words_.empty() || word < baseWord_ || word - baseWord_ >= words_.size()) {
+            return sequence;
+        }
+
+        size_t index = static_cast<size_t>(word - baseWord_);
+
+        // pretend the bits below the start position are set, so the scan only
+        // sees clear bits at or above it
+        uint64_t masked = words_[index] | ((uint64_t(1) << (sequence % kBitsPerWord)) - 1);
+
+        while (true) {
+            if (masked != kAllSet) {
+                return (baseWord_ + index) * kBitsPerWord + countTrailingZeros(~masked);
+            }
+
+            ++index;
+
+            if (index % kBitsPerWord == 0) {
+                // hop over fully set word groups through the summary level
+                while (index + kBitsPerWord <= words_.size() && summary_[index / kBitsPerWord] == kAllSet) {
+                    index += kBitsPerWord;
+                }
+            }
+
+            if (index >= words_.size()) {
+                return (baseWord_ + index) * kBitsPerWord;
+            }
+
+            masked = words_[index];
+        }
+    }
+
+    // drops whole summary strides below the given sequence; called as the
+    // chain tip advances so the window never grows with the chain itself
+    void discardBelow(Sequence sequence) {
+        const uint64_t word = sequence / kBitsPerWord;
+
+        if (words_.empty() || word <= baseWord_) {
+            return;
+        }
+
+        const uint64_t stride = kBitsPerWord;
+        size_t trimmed = static_cast<size_t>(std::min<uint64_t>(word - baseWord_, words_.size()));
+        trimmed -= trimmed % stride;
+
+        if (trimmed == 0) {
+            return;
+        }
+
+        for (size_t i = 0; i < trimmed; ++i) {
+            count_ -= popCount(words_[i]);
+        }
+
+        words_.erase(words_.begin(), words_.begin() + static_cast<std::ptrdiff_t>(trimmed));
+        summary_.erase(summary_.begin(), summary_.begin() + static_cast<std::ptrdiff_t>(trimmed / stride));
+        baseWord_ += trimmed;
+    }
+
+    size_t count() const {
+        return count_;
+    }
+
+    void clear() {
+        words_.clear();
+        summary_.clear();
+        baseWord_ = 0;
+        count_ = 0;
+    }
+
+private:
+    static constexpr uint64_t kBitsPerWord = 64;
+    static constexpr uint64_t kAllSet = ~uint64_t(0);
+
+    static size_t countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return static_cast<size_t>(index);
+#else
+        return static_cast<size_t>(__builtin_ctzll(value));
+#endif
+    }
+
+    static size_t popCount(uint64_t value) {
+#if defined(_MSC_VER)
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return static_cast<size_t>((value * 0x0101010101010101ull) >> 56);
+#else
+        return static_cast<size_t>(__builtin_popcountll(value));
+#endif
+    }
+
+    uint64_t baseWord_ = 0;
+    std::vector<uint64_t> words_;
+    std::vector<uint64_t> summary_;
+    size_t count_ = 0;
+};
+}  // namespace cs
+#endif  // SEQUENCEBITMAP_HPP
@@ -0,0 +1,94 @@
+#ifndef SHARDED_PACKET_TABLE_HPP
+#define SHARDED_PACKET_TABLE_HPP
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+#include <csnode/nodecore.hpp>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// @brief Sharded transactions packet table, reduces conveyer lock contention.
+/// Packets are distributed to shards by hash prefix, every shard is guarded
+/// by its own shared mutex, so lookups performed by stage processing never
+/// serialize against inserts done by the network thread on other shards.
+///
+class ShardedPacketTable {
+public:
+    enum : size_t {
+        ShardsCount = 16
+    };
+
+    ShardedPacketTable() = default;
+
+    ShardedPacketTable(const ShardedPacketTable&) = delete;
+    ShardedPacketTable& operator=(const ShardedPacketTable&) = delete;
+
+    ///
+    /// @brief Adds packet to table if its hash is not presented yet.
+    /// @return Returns true if packet was added, otherwise - false.
+    ///
+    bool append(const cs::TransactionsPacketHash& hash, const cs::TransactionsPacket& packet);
+    bool append(cs::TransactionsPacketHash&& hash, cs::TransactionsPacket&& packet);
+
+    ///
+    /// @brief Searches packet by hash, locks only one shard in shared mode.
+    /// @return Returns packet copy if found, otherwise returns nothing.
+    ///
+    std::optional<cs::TransactionsPacket> find(const cs::TransactionsPacketHash& hash) const;
+
+    ///
+    /// @brief Returns packet existence state, locks only one shard in shared mode.
+    ///
+    bool contains(const cs::TransactionsPacketHash& hash) const;
+
+    ///
+    /// @brief Removes packet by hash.
+    /// @return Returns true if packet was removed, otherwise - false.
+    ///
+    bool remove(const cs::TransactionsPacketHash& hash);
+
+    ///
+    /// @brief Returns summary packets count of all shards.
+    ///
+    size_t size() const;
+
+    ///
+    /// @brief Removes all packets from all shards.
+    ///
+    void clear();
+
+    ///
+    /// @brief Grows every shard to hold its part of expected packets count.
+    /// Growing takes the shard locks exclusively, call it on round boundaries
+    /// rather than on the ingest path.
+    ///
+    void reserve(size_t expectedPackets);
+
+    ///
+    /// @brief Calls func for each stored packet, shard by shard.
+    /// @warning Shard is locked in shared mode during iteration, do not
+    /// call table modification from func.
+    ///
+    void forEach(const std::function<void(const cs::TransactionsPacketHash&, const cs::TransactionsPacket&)>& func) const;
+
+private:
+    struct Shard {
+        mutable cs::SharedMutex mutex;
+        std::unordered_map<cs::TransactionsPacketHash, cs::TransactionsPacket> table;
+    };
+
+    const Shard& shard(const cs::TransactionsPacketHash& hash) const;
+    Shard& shard(const cs::TransactionsPacketHash& hash);
+
+    static size_t shardIndex(const cs::TransactionsPacketHash& hash);
+
+    std::array<Shard, ShardsCount> shards_;
+};
+}  // namespace cs
+
+#endif  // SHARDED_PACKET_TABLE_HPP
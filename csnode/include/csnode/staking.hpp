@@ -80,11 +80,20 @@ public:
       return &it->second;
     }
 
+    // repopulates the mining expiry index from miningDelegations_, used
+    // after deserialization
+    void rebuildMiningExpiry();
+
 private:
     static inline const uint64_t kMinDelegationForMiningSeconds_ = 7'776'000;
 
     DelegationsTiming currentDelegations_;
     MiningDelegations miningDelegations_;
+    // expiry time -> targets holding a mining delegation ending then, so the
+    // per-block cleanup visits only delegations actually expiring instead of
+    // scanning every target. Stale entries (delegation reverted earlier) are
+    // simply skipped when their time comes
+    std::map<uint64_t, std::vector<PublicKey>> miningExpiry_;
     GetWalletDataCallback getWalletData_;
     WalletUpdatedCallback updateCallback_;
 
@@ -1,9 +1,11 @@
 #ifndef TRANSACTIONSINDEX_HPP
 #define TRANSACTIONSINDEX_HPP
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <csdb/address.hpp>
 #include <lib/system/common.hpp>
@@ -34,6 +36,16 @@ public:
 
     bool recreate() const;
 
+    // LMDB map size, for metrics export
+    size_t dbMapSize() const {
+        return db_ ? db_->mapSize() : 0;
+    }
+
+    // used share of the LMDB map in percent, for provisioning before stalls
+    size_t dbOccupancyPercent() const {
+        return db_ ? db_->occupancyPercent() : 0;
+    }
+
     // false while pinFloor lifted past unwalked blocks; cleared by a slow-start walk.
     bool isReady() const;
 
@@ -45,6 +57,13 @@ public:
 
     Sequence getPrevTransBlock(const csdb::Address& _addr, Sequence _curr) const;
 
+    // Walks the address's previous-block chain starting from _curr inside a
+    // single LMDB read transaction using a cursor, so a deep history fetch
+    // costs one transaction instead of one handle per hop. Returns the block
+    // sequences newest first, _curr included when it is indexed.
+    std::vector<Sequence> getPrevTransBlocks(const csdb::Address& _addr, Sequence _curr,
+                                             size_t _maxHops = std::numeric_limits<size_t>::max()) const;
+
 public slots:
     void onStartReadFromDb(Sequence _lastWrittenPoolSeq);
     void onReadFromDb(const csdb::Pool&);
@@ -68,6 +87,15 @@ private:
     void setPrevTransBlock(const PublicKey&, cs::Sequence _curr, cs::Sequence _prev);
     void removeLastTransBlock(const PublicKey&, cs::Sequence _curr);
 
+    // Bloom filter over every address that ever got an index entry; negative
+    // lookups (the bulk of speculative explorer queries) return without
+    // touching LMDB. Never trusted unless provably in sync with the index:
+    // false positives only cost a get, false negatives would hide history.
+    bool bloomMayContain(const PublicKey&) const;
+    void bloomAdd(const PublicKey&);
+    void loadBloomFromDb();
+    void saveBloom();
+
     void loadIncompleteFromDb();
     void updateIncompleteFlag();
     void loadCompleteFlagFromDb();
@@ -82,6 +110,14 @@ private:
     bool indexComplete_ = false;
 
     std::map<csdb::Address, cs::Sequence> lapoos_;
+
+    // set by updateFromNextBlock() while a group commit is open, so
+    // setPrevTransBlock() routes entries into it instead of one
+    // transaction per insert
+    Lmdb::WriteBatch* activeBatch_ = nullptr;
+
+    cs::Bytes bloomBits_;
+    bool bloomValid_ = false;
 };
 } // namespace cs
 #endif // TRANSACTIONSINDEX_HPP
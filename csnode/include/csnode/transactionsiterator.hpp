@@ -13,6 +13,7 @@ class TransactionsIterator {
 public:
     TransactionsIterator(const BlockChain&, const csdb::Address&);
     TransactionsIterator(const BlockChain&, const csdb::Address&, const csdb::Pool&);
+    TransactionsIterator(const BlockChain&, const csdb::Address&, const csdb::TransactionID&);
 
     void next();
     bool isValid() const;
@@ -99,6 +99,12 @@ public:  // Static interface
     ///
     static TransactionsPacket fromByteStream(const char* data, size_t size);
 
+    ///
+    /// @brief Calculates a compact 64-bit fingerprint of a transaction binary
+    /// representation, used by the packet digest reconciliation flow
+    ///
+    static uint64_t transactionFingerprint(const csdb::Transaction& transaction);
+
 public:  // Interface
     enum Serialization : cs::Byte {
         Transactions = 0x01,
@@ -122,6 +128,12 @@ public:  // Interface
     ///
     cs::Bytes toBinary(Serialization options = Serialization::All) const noexcept;
 
+    ///
+    /// @brief Reserves storage for expected transactions count
+    /// @param transactionsCount Expected packet payload, e.g. Consensus::MaxPacketTransactions
+    ///
+    void reserve(size_t transactionsCount);
+
     ///
     /// @brief Generates hash
     /// @return True if hash generated successed
@@ -212,6 +224,13 @@ public:  // Interface
     ///
     bool isSmart() const;
 
+    ///
+    /// @brief Returns serialized payload size in bytes, the unit the conveyer
+    /// memory budget is accounted in. Cheap while the incremental hash buffer
+    /// is valid, otherwise transactions are measured one by one.
+    ///
+    size_t estimatedByteSize() const noexcept;
+
 private:  // Service
     void put(::csdb::priv::obstream& os, Serialization options) const;
     bool get(::csdb::priv::ibstream& is);
@@ -222,6 +241,13 @@ private:  // Members
     std::vector<csdb::Transaction> stateTransactions_;
     cs::BlockSignatures signatures_;
     cs::RoundNumber expiredRound_{};
+
+    // incremental hash state: every addTransaction() appends the serialized
+    // transaction here, so makeHash() only prepends the header instead of
+    // re-serializing the whole packet. Invalidated when transactions are
+    // obtained or replaced bypassing addTransaction()
+    cs::Bytes hashableBytes_;
+    bool hashableValid_ = true;
 };
 }  // namespace cs
 
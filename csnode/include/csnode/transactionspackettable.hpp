@@ -0,0 +1,166 @@
+#ifndef TRANSACTIONS_PACKET_TABLE_HPP
+#define TRANSACTIONS_PACKET_TABLE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <csnode/transactionspacket.hpp>
+
+namespace cs {
+///
+/// @brief Hash-indexed transactions packet table with deterministic iteration.
+/// Lookups and inserts go through flat hash storage keyed by the leading bytes
+/// of the packet hash - the hash is a uniform digest already, so no byte-wise
+/// mixing or node-based tree walk is paid per access. Iteration stays sorted
+/// by hash, the order stage one candidate selection and characteristic
+/// construction rely on, through a pointer index maintained on every mutation.
+///
+class TransactionsPacketTable {
+public:
+    using Entry = std::pair<const cs::TransactionsPacketHash, cs::TransactionsPacket>;
+
+    ///
+    /// Read-only forward iterator over entries in ascending hash order.
+    ///
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = const Entry&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return **position_;
+        }
+
+        pointer operator->() const {
+            return *position_;
+        }
+
+        const_iterator& operator++() {
+            ++position_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++position_;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return position_ == other.position_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return position_ != other.position_;
+        }
+
+    private:
+        friend class TransactionsPacketTable;
+
+        explicit const_iterator(const Entry* const* position)
+        : position_(position) {
+        }
+
+        const Entry* const* position_ = nullptr;
+    };
+
+    TransactionsPacketTable() = default;
+
+    TransactionsPacketTable(const TransactionsPacketTable& other);
+    TransactionsPacketTable& operator=(const TransactionsPacketTable& other);
+
+    TransactionsPacketTable(TransactionsPacketTable&&) = default;
+    TransactionsPacketTable& operator=(TransactionsPacketTable&&) = default;
+
+    ///
+    /// @brief Adds packet to table if its hash is not presented yet.
+    /// @return Returns pointer to the stored packet and insertion state.
+    ///
+    std::pair<cs::TransactionsPacket*, bool> emplace(cs::TransactionsPacketHash hash, cs::TransactionsPacket packet);
+
+    ///
+    /// @brief Searches packet by hash.
+    /// @return Returns pointer to the stored packet, nullptr if not found.
+    ///
+    cs::TransactionsPacket* find(const cs::TransactionsPacketHash& hash);
+    const cs::TransactionsPacket* find(const cs::TransactionsPacketHash& hash) const;
+
+    ///
+    /// @brief Returns stored packet by hash, throws if hash is not presented.
+    ///
+    const cs::TransactionsPacket& at(const cs::TransactionsPacketHash& hash) const;
+
+    ///
+    /// @brief Returns packet existence state.
+    ///
+    bool contains(const cs::TransactionsPacketHash& hash) const;
+
+    ///
+    /// @brief Removes packet by hash.
+    /// @return Returns true if packet was removed, otherwise - false.
+    ///
+    bool erase(const cs::TransactionsPacketHash& hash);
+
+    ///
+    /// @brief Pre-allocates buckets for expected packets count, rounded up to
+    /// a power of two, so the fill that follows never rehashes mid-way.
+    ///
+    void reserve(size_t expectedCount);
+
+    size_t size() const {
+        return storage_.size();
+    }
+
+    ///
+    /// @brief Returns accumulated payload bytes of stored packets, O(1).
+    /// Sizes are captured at emplace time; in-place edits through find() are
+    /// not tracked, the figure is a budget estimate, not an exact census.
+    ///
+    size_t byteSize() const {
+        return bytes_;
+    }
+
+    bool empty() const {
+        return storage_.empty();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(ordered_.data());
+    }
+
+    const_iterator end() const {
+        return const_iterator(ordered_.data() + ordered_.size());
+    }
+
+private:
+    // the packet hash is a uniform digest, its leading machine word is a
+    // ready-made bucket key with no quality lost to the shortcut
+    struct LeadingBytesHash {
+        size_t operator()(const cs::TransactionsPacketHash& hash) const noexcept;
+    };
+
+    using Storage = std::unordered_map<cs::TransactionsPacketHash, cs::TransactionsPacket, LeadingBytesHash>;
+
+    void insertOrdered(const Entry* entry);
+    void rebuildOrdered();
+
+    Storage storage_;
+
+    // entry pointers sorted by hash, pointers into storage_ stay valid across
+    // rehash, so the index survives any growth untouched
+    std::vector<const Entry*> ordered_;
+
+    // payload bytes of stored packets, maintained by emplace/erase
+    size_t bytes_ = 0;
+};
+}  // namespace cs
+
+#endif  // TRANSACTIONS_PACKET_TABLE_HPP
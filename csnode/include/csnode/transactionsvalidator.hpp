@@ -56,6 +56,10 @@ private:
 private:
 	Reject::Reason validateTransactionAsSource(SolverContext& context, const Transactions& trxs, size_t trxInd);
 	Reject::Reason validateNewStateAsSource(SolverContext& context, const csdb::Transaction& trx);
+
+    // looks up the starter transaction of a new_state, cached across validation iterations
+    // and rounds (the referenced blocks are immutable history)
+    csdb::Transaction findStarterTransaction(SolverContext& context, const csdb::Transaction& trx);
 	Reject::Reason validateCommonAsSource(SolverContext& context, const Transactions& trxs, size_t trxInd, WalletsState::WalletData& wallState);
 
 	Reject::Reason validateTransactionAsTarget(const csdb::Transaction& trx);
@@ -66,12 +70,17 @@ private:
     bool removeTransactions_NegativeOne(SolverContext& context, Node& node, const Transactions& trxs, CharacteristicMask& maskIncluded);
     bool removeTransactions_NegativeAll(SolverContext& context, Node& node, const Transactions& trxs, CharacteristicMask& maskIncluded);
 
-    size_t makeSmartsValid(SolverContext& context, RejectedSmarts& smarts, const csdb::Address& source, CharacteristicMask& maskIncluded);
+    // positions index smartsWithNegativeBalances_, grouped per contract by checkRejectedSmarts()
+    size_t makeSmartsValid(const std::vector<size_t>& positions, CharacteristicMask& maskIncluded);
 
 private:
     Config config_;
     WalletsState& walletsState_;
     TrxList trxList_;
+    // destination wallets resolved when a transaction is linked into its chain,
+    // parallel to trxList_; pointers into WalletsState storage stay valid for
+    // the whole round, the same way negativeNodes_ relies on it
+    std::vector<Node*> targetNodes_;
     std::map<csdb::Address, csdb::Amount> payableMaxFees_;
     std::unordered_map<csdb::Address, Reject::Reason> rejectedNewStates_;
     std::vector<std::pair<size_t, bool>> validNewStates_; // index in block + false if invalidated by smart source trx
@@ -79,6 +88,12 @@ private:
     Stack negativeNodes_;
     RejectedSmarts smartsWithNegativeBalances_;
     size_t cntRemovedTrxs_;
+
+    // starter transactions of new_states keyed by (sequence, index in block); survives
+    // clearCaches() since blocks are immutable, dropped entirely on chain rollback
+    static constexpr size_t maxStarterCacheSize_ = 4096;
+    std::map<std::pair<cs::Sequence, size_t>, csdb::Transaction> starterTrxCache_;
+    cs::Sequence lastSeenSequence_ = 0;
 };
 
 inline void TransactionsValidator::clearCaches() {
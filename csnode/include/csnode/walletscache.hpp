@@ -87,6 +87,10 @@ private:
 
     std::unique_ptr<Staking> staking_;
 
+    // set for the duration of Updater::loadNextBlock so the staking
+    // callbacks observe and update the staged wallets, not the flushed ones
+    Updater* activeUpdater_ = nullptr;
+
     friend class WalletsCache_Serializer;
 };
 
@@ -122,9 +126,14 @@ public:
     static std::vector<csdb::Amount> getRewardDistribution(const csdb::Pool& pool);
 
 private:
+    friend class WalletsCache;
+
     WalletData getWalletData(const PublicKey&);
     WalletData getWalletData(const csdb::Address&);
 
+    void walletUpdated(const WalletData&);
+    void flushStaged();
+
     double load(const csdb::Transaction& tr, const BlockChain& blockchain, const uint64_t timeStamp, bool inverse);
 
     double loadTrxForSource(const csdb::Transaction& tr,
@@ -160,6 +169,14 @@ private:
     WalletsCache& data_;
     cs::PublicKey showBalanceChangeKey_;
     bool showBalanceChange_ = false;
+
+    // block-local staging of touched wallets. Applying a block mutates the
+    // same wallets several times (fees, rewards, delegations), and every
+    // write-through used to rebalance the ranked views of the multi-index
+    // container. While a block is loading the mutations land in this flat
+    // map and each touched wallet is re-indexed exactly once on flush
+    std::unordered_map<PublicKey, WalletData> staged_;
+    bool stagingActive_ = false;
 };
 
 inline double WalletsCache::Updater::load(const csdb::Transaction& t, const BlockChain& bc, const uint64_t timeStamp, bool inverse) {
@@ -28,6 +28,7 @@ using namespace boost::multi_index;
 
 namespace cs {
 class WalletsCache;
+class Staking;
 
 class WalletsCache_Serializer {
 public:
@@ -213,6 +214,7 @@ private:
 #endif
     CurrentDelegations *currentDelegations_ = nullptr;
     MiningDelegations *miningDelegations_ = nullptr;
+    Staking *staking_ = nullptr;
 };
 } // namespace cs
 #endif // WALLETS_CACHE_SERIALIZER_HPP
@@ -4,6 +4,8 @@
 #include <map>
 #include <memory>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -13,6 +15,8 @@
 #include <csdb/internal/types.hpp>
 #include <csdb/pool.hpp>
 
+#include <lib/system/common.hpp>
+
 using namespace boost::multi_index;
 
 namespace cs {
@@ -78,7 +82,38 @@ private:
         >
     >;
 
+    // flat open-addressing index over the public keys, serving the hot
+    // address -> id resolution path. One control byte per slot, probed eight
+    // at a time through a word load; data_ stays authoritative and keeps the
+    // rare id -> address direction and serialization
+    class FlatIndex {
+    public:
+        FlatIndex();
+
+        bool find(const cs::PublicKey& key, WalletId& id) const;
+        void insert(const cs::PublicKey& key, WalletId id);
+        void erase(const cs::PublicKey& key);
+        void clear();
+
+    private:
+        constexpr static size_t kGroupSize = 8;
+        constexpr static size_t kInitialCapacity = 1024;  // slots, power of two
+        constexpr static cs::Byte kEmpty = 0x00;
+        constexpr static cs::Byte kTombstone = 0x01;
+
+        void rehash(size_t capacity);
+
+        std::vector<cs::Byte> control_;
+        std::vector<std::pair<cs::PublicKey, WalletId>> slots_;
+        size_t size_ = 0;
+        size_t used_ = 0;  // occupied slots plus tombstones, drives the rehash
+    };
+
+    // repopulates index_ from data_, used after deserialization
+    void rebuildIndex();
+
     Data data_;
+    FlatIndex index_;
     WalletId nextId_;
     std::unique_ptr<Normal> norm_;
 
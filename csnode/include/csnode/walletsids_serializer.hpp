@@ -77,6 +77,7 @@ private:
         >
     >;
 
+    WalletsIds *ids_ = nullptr;
     Data *data_ = nullptr;
     WalletId *nextId_ = nullptr;
 };
@@ -2,10 +2,12 @@
 #define WALLETS_STATE_HPP
 
 #include <unordered_map>
+#include <vector>
 
 #include <csdb/address.hpp>
 #include <csdb/amount.hpp>
 #include <csdb/internal/types.hpp>
+#include <csdb/transaction.hpp>
 #include <csnode/transactionstail.hpp>
 #include <csnode/walletscache.hpp>
 
@@ -32,11 +34,25 @@ public:
     explicit WalletsState(const WalletsCache::Updater& cacheUpd) : wallCache_(cacheUpd) {}
     WalletData& getData(const WalletAddress& address);
 
-    void updateFromSource() { storage_.clear(); }
+    void updateFromSource() {
+        storage_.clear();
+        idMemo_.clear();
+    }
+
+    // materializes balances of the round's distinct source and target wallets
+    // in one pass over the transactions, so the following validation
+    // iterations run on the local snapshot and its arithmetic without going
+    // back to WalletsCache per transaction
+    void roundSnapshot(const std::vector<csdb::Transaction>& transactions);
 
 private:
+    PublicKey toCachedPublicKey(const WalletAddress& address);
+    WalletData& materialize(const PublicKey& pubKey);
+
     const WalletsCache::Updater& wallCache_;
     std::unordered_map<PublicKey, WalletData> storage_;
+    // round-scoped id resolution memo, spares the WalletsIds lookup per transaction
+    std::unordered_map<csdb::internal::WalletId, PublicKey> idMemo_;
 };
 }  // namespace cs
 #endif // WALLETS_STATE_HPP
@@ -10,6 +10,7 @@
 
 #include <csconnector/csconnector.hpp>
 #include <csnode/serializers_helper.hpp>
+#include <lib/system/mmappedfile.hpp>
 
 namespace {
 const std::string kDataFileName = "apihandler.dat";
@@ -27,8 +28,8 @@ void APIHandler_Serializer::bind(api::APIHandler& apih) {
 }
 
 void APIHandler_Serializer::save(const std::filesystem::path& rootDir) {
-    std::ofstream ofs(rootDir / kDataFileName, std::ios::binary);
-    boost::archive::binary_oarchive oa(ofs);
+    MMappedOutput out((rootDir / kDataFileName).string());
+    boost::archive::binary_oarchive oa(out.stream());
 
     auto saveHelper = [&](auto& entity) {
       auto ref = lockedReference(entity);
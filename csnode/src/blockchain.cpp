@@ -3,8 +3,10 @@
 #include <csdb/currency.hpp>
 #include <lib/system/hash.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/utils.hpp>
 #include <limits>
+#include <thread>
 
 #ifdef DBSQL
 #include <dbsql/roundinfo.hpp>
@@ -178,6 +180,17 @@ bool BlockChain::init(
         return false;
     }
 
+    {
+        const auto& sto = cs::ConfigHolder::instance().config()->getStorageSettings();
+        storage_.set_blocks_archive_horizon(uint32_t(sto.archiveHorizonBlocks));
+        if (sto.writeBehindBlocks != 0) {
+            // meant for observer/API replicas: sync may run ahead of the disk,
+            // checkpoints still flush the queue before binding to a block
+            cslog() << kLogPrefix << "write-behind block storage enabled, queue depth " << sto.writeBehindBlocks;
+            storage_.set_write_behind(sto.writeBehindBlocks);
+        }
+    }
+
     if (newBlockchainTop != cs::kWrongSequence) {
         if (trxIndex_) trxIndex_->trimToFloor(newBlockchainTop);
         return true;
@@ -237,6 +250,15 @@ void BlockChain::onStartReadFromDB(cs::Sequence lastWrittenPoolSeq) {
 }
 
 void BlockChain::onReadFromDB(csdb::Pool block, bool* shouldStop) {
+    // per-phase replay progress for the metrics endpoint; an orchestrator
+    // polling these can tell a node grinding through a big DB from one that
+    // is stuck
+    static std::atomic<uint64_t>& blocksRead = cs::Metrics::instance().counter("startup_blocks_read");
+    static std::atomic<uint64_t>& blocksHashed = cs::Metrics::instance().counter("startup_blocks_hashed");
+    static std::atomic<uint64_t>& blocksApplied = cs::Metrics::instance().counter("startup_blocks_applied");
+
+    blocksRead.fetch_add(1, std::memory_order_relaxed);
+
     auto blockSeq = block.sequence();
     lastSequence_ = blockSeq;
     if (blockSeq == 1) {
@@ -255,6 +277,8 @@ void BlockChain::onReadFromDB(csdb::Pool block, bool* shouldStop) {
             *shouldStop = true;
         }
         else {
+            blocksHashed.fetch_add(1, std::memory_order_relaxed);
+
             if (block.transactions_count() > 0) {
                 const auto block_time = BlockChain::getBlockTime(block);
                 for (auto& t : block.transactions()) {
@@ -263,6 +287,7 @@ void BlockChain::onReadFromDB(csdb::Pool block, bool* shouldStop) {
             }
             updateNonEmptyBlocks(block);
             walletsCacheUpdater_->loadNextBlock(block, block.confidants(), *this);
+            blocksApplied.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
@@ -433,7 +458,10 @@ csdb::Pool BlockChain::loadBlock(const csdb::PoolHash& ph) const {
     std::lock_guard l(dbLock_);
 
     if (deferredBlock_.hash() == ph) {
-        return deferredBlock_.clone();
+        // a plain copy shares transaction storage copy-on-write: any later
+        // mutation of the deferred block detaches it first, so read-only
+        // serving never pays the deep per-transaction clone
+        return deferredBlock_;
     }
 
     return storage_.pool_load(ph);
@@ -443,13 +471,25 @@ csdb::Pool BlockChain::loadBlock(const cs::Sequence sequence) const {
     std::lock_guard lock(dbLock_);
 
     if (deferredBlock_.is_valid() && deferredBlock_.sequence() == sequence) {
-        // deferredBlock already composed:
-        return deferredBlock_.clone();
+        // deferredBlock already composed, copy-on-write snapshot is enough
+        return deferredBlock_;
     }
     if (sequence > getLastSeq()) {
         return csdb::Pool{};
     }
-    return storage_.pool_load(sequence);
+    return readCache_.get(sequence, [this](cs::Sequence from, size_t count) {
+        // readahead must not run past the chain tip or into the deferred
+        // block, which has not reached storage yet
+        cs::Sequence upperBound = getLastSeq();
+        if (deferredBlock_.is_valid() && deferredBlock_.sequence() <= upperBound && deferredBlock_.sequence() > 0) {
+            upperBound = deferredBlock_.sequence() - 1;
+        }
+        if (from > upperBound) {
+            return std::vector<csdb::Pool>{};
+        }
+        count = std::min<size_t>(count, static_cast<size_t>(upperBound - from + 1));
+        return storage_.pool_load_range(from, count);
+    });
 }
 
 csdb::Pool BlockChain::loadBlockForSync(const cs::Sequence sequence) const {
@@ -461,11 +501,36 @@ csdb::Pool BlockChain::loadBlockForSync(const cs::Sequence sequence) const {
     }
 }
 
+std::vector<csdb::Pool> BlockChain::loadBlocksForSync(const cs::Sequence fromSeq, const std::size_t count) const {
+    std::lock_guard lock(dbLock_);
+
+    std::size_t storageCount = count;
+
+    // the uncertain block must not be served at all, the deferred one never reaches storage
+    if (uncertainLastBlockFlag_ && uncertainSequence_ >= fromSeq && uncertainSequence_ < fromSeq + storageCount) {
+        storageCount = static_cast<std::size_t>(uncertainSequence_ - fromSeq);
+    }
+
+    const bool deferredInRange = deferredBlock_.is_valid() && deferredBlock_.sequence() >= fromSeq && deferredBlock_.sequence() < fromSeq + storageCount;
+
+    if (deferredInRange) {
+        storageCount = static_cast<std::size_t>(deferredBlock_.sequence() - fromSeq);
+    }
+
+    std::vector<csdb::Pool> result = storage_.pool_load_range(fromSeq, storageCount);
+
+    if (deferredInRange && result.size() == storageCount) {
+        result.push_back(deferredBlock_);
+    }
+
+    return result;
+}
+
 csdb::Pool BlockChain::loadBlockMeta(const csdb::PoolHash& ph, size_t& cnt) const {
     std::lock_guard lock(dbLock_);
 
     if (deferredBlock_.hash() == ph) {
-        return deferredBlock_.clone();
+        return deferredBlock_;
     }
 
     return storage_.pool_load_meta(ph, cnt);
@@ -513,6 +578,9 @@ void BlockChain::removeLastBlock() {
         else {
             pool = storage_.pool_remove_last();
         }
+
+        // the read cache must not serve the removed block anymore
+        readCache_.invalidateFrom(remove_seq);
     }
 
     if (!pool.is_valid()) {
@@ -578,7 +646,7 @@ bool BlockChain::compromiseLastBlock(const csdb::PoolHash& desired_hash) {
         cs::Lock lock(dbLock_);
 
         if (deferredBlock_.is_valid()) {
-            last_block = deferredBlock_.clone();
+            last_block = deferredBlock_;
         }
     }
     if (!last_block.is_valid()) {
@@ -723,7 +791,23 @@ bool BlockChain::finalizeBlock(csdb::Pool& pool, bool isTrusted, cs::PublicKeys
     const auto& confidants = pool.confidants();
     const auto& signatures = pool.signatures();
     const auto& realTrusted = pool.realTrusted();
-    if (currentSequence > 1) {
+
+    // trusted-checkpoint fast sync: history up to the configured checkpoint skips group
+    // signature re-verification, the hash chain and the checkpoint hash still anchor it
+    const cs::Sequence checkpointSeq = cs::ConfigHolder::instance().config()->getSyncCheckpointSequence();
+    const bool belowCheckpoint = checkpointSeq != 0 && currentSequence <= checkpointSeq;
+
+    if (belowCheckpoint && currentSequence == checkpointSeq) {
+        const auto& expectedHash = cs::ConfigHolder::instance().config()->getSyncCheckpointHash();
+        if (pool.hash().to_string() != expectedHash) {
+            cserror() << kLogPrefix << "block " << currentSequence << " hash " << pool.hash().to_string()
+                      << " does not match the configured sync checkpoint " << expectedHash;
+            return false;
+        }
+        cslog() << kLogPrefix << "sync checkpoint " << currentSequence << " reached, hash matches, resuming full validation";
+    }
+
+    if (currentSequence > 1 && !belowCheckpoint) {
         csdebug() << kLogPrefix << "Finalize: starting confidants validation procedure (#" << currentSequence << "):";
 
         cs::Bytes trustedToHash;
@@ -767,7 +851,10 @@ bool BlockChain::finalizeBlock(csdb::Pool& pool, bool isTrusted, cs::PublicKeys
     auto mask = cs::Utils::bitsToMask(pool.numberTrusted(), pool.realTrusted());
 
     // pool signatures check: start
-    if (pool.sequence() > 0) {
+    if (belowCheckpoint) {
+        csmeta(csdetails) << kLogPrefix << "block " << currentSequence << " is below the sync checkpoint, signatures accepted without verification";
+    }
+    else if (pool.sequence() > 0) {
         //  csmeta(csdebug) << "Pool Hash: " << cs::Utils::byteStreamToHex(pool.hash().to_binary().data(), pool.hash().to_binary().size());
         //  csmeta(csdebug) << "Prev Hash: " << cs::Utils::byteStreamToHex(pool.previous_hash().to_binary().data(), pool.previous_hash().to_binary().size());
         Hash tempHash;
@@ -826,6 +913,12 @@ bool BlockChain::applyBlockToCaches(const csdb::Pool& pool) {
 
         // update non-empty block storage
         updateNonEmptyBlocks(pool);
+
+        // remember which chain position these caches now describe, the
+        // asynchronous checkpoint below reads it under the same lock
+        cachesHead_.sequence = pool.sequence();
+        cachesHead_.head_hash = pool.hash().to_binary();
+        cachesHead_.prev_hash = pool.previous_hash().to_binary();
     }
     catch (std::exception & e) {
         cserror() << "apply block to caches, exception: " << e.what();
@@ -844,24 +937,42 @@ bool BlockChain::applyBlockToCaches(const csdb::Pool& pool) {
         const bool byTime = (sto.checkpointEveryMinutes > 0
             && now - lastCheckpointWallClock_ >= std::chrono::minutes(sto.checkpointEveryMinutes));
         if (byCount || byTime) {
-            trxIndex_->flush();
-            cs::CheckpointHead head;
-            head.sequence = pool.sequence();
-            head.head_hash = pool.hash().to_binary();
-            head.prev_hash = pool.previous_hash().to_binary();
-            if (serializationManPtr_->save(pool.sequence(), head)) {
-                serializationManPtr_->pruneCheckpoints(sto.checkpointKeep);
-                lastCheckpointWallClock_ = now;
-            }
-            else {
-                cserror() << "Cannot save caches with version " << pool.sequence();
-            }
+            lastCheckpointWallClock_ = now;
+            saveCheckpointAsync(sto.checkpointKeep);
         }
     }
 
     return true;
 }
 
+void BlockChain::saveCheckpointAsync(size_t checkpointKeep) {
+    if (checkpointRunning_.exchange(true)) {
+        // the previous checkpoint is still being written, the next interval
+        // tick retries
+        return;
+    }
+
+    cs::Concurrent::run([this, checkpointKeep]() {
+        // everything the checkpoint will reference has to be durable before
+        // the caches are serialized
+        trxIndex_->flush();
+        storage_.flush_write_behind();
+
+        std::lock_guard lock(cacheMutex_);
+        const cs::CheckpointHead head = cachesHead_;
+
+        cslog() << kLogPrefix << "saving checkpoint at block " << WithDelimiters(head.sequence);
+        if (serializationManPtr_->save(head.sequence, head)) {
+            serializationManPtr_->pruneCheckpoints(checkpointKeep);
+        }
+        else {
+            cserror() << kLogPrefix << "cannot save checkpoint at " << head.sequence;
+        }
+
+        checkpointRunning_ = false;
+    });
+}
+
 csdb::PoolHash BlockChain::getHashBySequence(cs::Sequence seq) const {
     std::lock_guard lock(dbLock_);
 
@@ -913,17 +1024,65 @@ uint64_t BlockChain::getWalletsCount() const {
 }
 
 void BlockChain::getTransactions(Transactions& transactions, csdb::Address address, uint64_t offset, uint64_t limit) {
-    for (auto trIt = cs::TransactionsIterator(*this, address); trIt.isValid(); trIt.next()) {
-        if (offset > 0) {
-            --offset;
-            continue;
+    if (limit == 0) {
+        return;
+    }
+
+    const csdb::Address key = getAddressByType(address, AddressType::PublicKey);
+    const csdb::TransactionID head = getLastTransaction(address);
+    const uint64_t nextOffset = offset + limit;
+
+    csdb::TransactionID resumeFrom;
+    if (offset > 0) {
+        std::lock_guard lock(transactionsCursorsMutex_);
+        const auto cursor = transactionsCursors_.find(key);
+        if (cursor != transactionsCursors_.end() && cursor->second.offset == offset && cursor->second.head == head) {
+            resumeFrom = cursor->second.last;
         }
+    }
 
-        transactions.push_back(*trIt);
-        transactions.back().set_time(BlockChain::getBlockTime(trIt.getPool()));
+    csdb::TransactionID last;
+    bool resumed = false;
 
-        if (--limit == 0)
-            break;
+    if (resumeFrom.is_valid()) {
+        // continue the walk right after the last transaction of the previous page
+        cs::TransactionsIterator trIt(*this, address, resumeFrom);
+        if (trIt.isValid()) {
+            resumed = true;
+            for (trIt.next(); trIt.isValid(); trIt.next()) {
+                transactions.push_back(*trIt);
+                transactions.back().set_time(BlockChain::getBlockTime(trIt.getPool()));
+                last = trIt->id();
+
+                if (--limit == 0)
+                    break;
+            }
+        }
+    }
+
+    if (!resumed) {
+        for (auto trIt = cs::TransactionsIterator(*this, address); trIt.isValid(); trIt.next()) {
+            if (offset > 0) {
+                --offset;
+                continue;
+            }
+
+            transactions.push_back(*trIt);
+            transactions.back().set_time(BlockChain::getBlockTime(trIt.getPool()));
+            last = trIt->id();
+
+            if (--limit == 0)
+                break;
+        }
+    }
+
+    if (limit == 0 && last.is_valid()) {
+        // the page is full, remember where it ended to serve the next one without the skip
+        std::lock_guard lock(transactionsCursorsMutex_);
+        if (transactionsCursors_.size() >= MaxTransactionsCursors && transactionsCursors_.count(key) == 0) {
+            transactionsCursors_.clear();
+        }
+        transactionsCursors_[key] = TransactionsCursor{nextOffset, head, last};
     }
 }
 
@@ -1104,8 +1263,19 @@ void BlockChain::tryFlushDeferredBlock() {
 
 void BlockChain::close() {
     stop_ = true;
+
+    // let a checkpoint still being written in the background finish before
+    // the final save below reuses the serialization manager
+    while (checkpointRunning_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
     tryFlushDeferredBlock();
 
+#ifdef DBSQL
+    dbsql::stopExport();
+#endif
+
     cs::CheckpointHead headInfo;
     if (serializationManPtr_) {
         const auto topSeq = getLastSeq();
@@ -1265,14 +1435,20 @@ bool BlockChain::checkForConsistency(csdb::Pool& pool, bool isNew) {
     if (cs::Utils::maskValue(pool.realTrusted()) != pool.signatures().size()) {
         return false;
     }
-    csdb::Pool tmp = pool.clone();
-    if (isNew && !tmp.compose()) {
+    if (isNew && !pool.is_valid()) {
+        // exactly what a trial compose() would report, read without mutating
         csinfo() << kLogPrefix << "Check for consistency: can't compose block";
         return false;
     }
 
-    cs::Bytes checking = tmp.to_binary();
-    csdb::Pool tmpCopy = csdb::Pool::from_binary(std::move(checking));
+    // serialize in place instead of deep cloning every transaction only to
+    // trial-compose a throwaway copy: the deferred block already caches its
+    // composed binary, a new block is written once here by the same writer
+    // compose() uses. Parsing back just the header keeps the round-trip check
+    // while skipping a re-parse of the whole round's transactions
+    cs::Bytes checking = isNew ? pool.to_binary_updated() : pool.to_binary();
+    size_t transactionsCount = 0;
+    csdb::Pool tmpCopy = csdb::Pool::meta_from_binary(std::move(checking), transactionsCount);
     if (tmpCopy.sequence() == 0) {
         csinfo() << kLogPrefix << "Check for consistency: Failed to create correct binary representation of block #" << pool.sequence();
         return false;
@@ -1434,6 +1610,8 @@ std::optional<csdb::Pool> BlockChain::recordBlock(csdb::Pool& pool, bool isTrust
     }
 
     if (flushed_block_seq != NoSequence) {
+        // the round's contract-state updates become durable together with the block
+        storage_.flush_contract_data();
         csdebug() << "---------------------------- Flush block #" << flushed_block_seq << " to disk ---------------------------";
         csdebug() << "signatures amount = " << deferredBlock_.signatures().size() << ", smartSignatures amount = " << deferredBlock_.smartSignatures().size()
                   << ", see block info above";
@@ -1445,12 +1623,15 @@ std::optional<csdb::Pool> BlockChain::recordBlock(csdb::Pool& pool, bool isTrust
         cs::Lock lock(dbLock_);
 
         deferredBlock_ = pool;
-        pool = deferredBlock_.clone();
+        // subscribers get a copy-on-write snapshot, later deferred block
+        // mutations detach before writing and leave it untouched
+        pool = deferredBlock_;
         lastSequence_ = deferredBlock_.sequence();
     }
 
     //csdetails() << kLogPrefix << "Pool #" << deferredBlock_.sequence() << ": " << cs::Utils::byteStreamToHex(deferredBlock_.to_binary().data(), deferredBlock_.to_binary().size());
     emit storeBlockEvent(pool);
+    appendToStoreBatch(pool);
     if constexpr (false && (pool.transactions_count() > 0 || pool.sequence() % 10 == 0)) {//log code
         std::string res = printWalletCaches() + "\nTransactions: \n";
         csdb::Amount r_cost{ 0 };
@@ -1471,6 +1652,64 @@ std::optional<csdb::Pool> BlockChain::recordBlock(csdb::Pool& pool, bool isTrust
     return std::make_optional(pool);
 }
 
+void BlockChain::startStoreBatching() {
+    cs::Lock lock(storeBatchMutex_);
+
+    if (!storeBatchingOn_) {
+        storeBatchingOn_ = true;
+        storeBatch_.reserve(kStoreBatchSize);
+        csdebug() << kLogPrefix << "store batching is on, blocks are delivered in groups of up to " << kStoreBatchSize;
+    }
+}
+
+void BlockChain::stopStoreBatching() {
+    {
+        cs::Lock lock(storeBatchMutex_);
+
+        if (!storeBatchingOn_) {
+            return;
+        }
+        storeBatchingOn_ = false;
+    }
+
+    flushStoreBatch();
+    csdebug() << kLogPrefix << "store batching is off";
+}
+
+void BlockChain::appendToStoreBatch(const csdb::Pool& pool) {
+    if (storeBlocksBatchEvent.size() == 0) {
+        return;
+    }
+
+    bool flush = false;
+    {
+        cs::Lock lock(storeBatchMutex_);
+
+        storeBatch_.push_back(pool);
+        // subscribers to the batched event must not miss blocks stored outside of sync,
+        // so without batching every block forms a batch of one
+        flush = !storeBatchingOn_ || storeBatch_.size() >= kStoreBatchSize;
+    }
+
+    if (flush) {
+        flushStoreBatch();
+    }
+}
+
+void BlockChain::flushStoreBatch() {
+    std::vector<csdb::Pool> batch;
+    {
+        cs::Lock lock(storeBatchMutex_);
+
+        if (storeBatch_.empty()) {
+            return;
+        }
+        batch.swap(storeBatch_);
+    }
+
+    emit storeBlocksBatchEvent(batch);
+}
+
 bool BlockChain::updateLastBlock(cs::RoundPackage& rPackage) {
     return updateLastBlock(rPackage, deferredBlock_);
 }
@@ -1600,8 +1839,9 @@ bool BlockChain::isBootstrap(const csdb::Pool& block) {
 
 bool BlockChain::deferredBlockExchange(cs::RoundPackage& rPackage, const csdb::Pool& newPool) {
 
-    // final compose and test:
-    csdb::Pool tmp_clone = newPool.clone();
+    // final compose and test: copy-on-write, set_signatures detaches the
+    // header while the transaction storage stays shared with newPool
+    csdb::Pool tmp_clone = newPool;
     auto tmp = rPackage.poolSignatures();
     tmp_clone.set_signatures(tmp);
     tmp_clone.compose();
@@ -1638,6 +1878,9 @@ bool BlockChain::isSpecial(const csdb::Transaction& t) {
 }
 
 bool BlockChain::storeBlock(csdb::Pool& pool, cs::PoolStoreType type) {
+    static cs::LatencyHistogram& histogram = cs::Metrics::instance().histogram("blockchain_store_block_us");
+    cs::MetricsTimer timer(histogram);
+
     const auto lastSequence = getLastSeq();
     const auto poolSequence = pool.sequence();
     
@@ -2049,6 +2292,10 @@ cs::Sequence BlockChain::getPreviousPoolSeq(const csdb::Address& addr, cs::Seque
     return previousSequence;
 }
 
+std::vector<cs::Sequence> BlockChain::getPreviousPoolSeqs(const csdb::Address& addr, cs::Sequence ps, size_t maxHops) const {
+    return trxIndex_->getPrevTransBlocks(addr, ps, maxHops);
+}
+
 std::pair<cs::Sequence, uint32_t> BlockChain::getLastNonEmptyBlock() {
     std::lock_guard lock(dbLock_);
     return std::make_pair(lastNonEmptyBlock_.poolSeq, lastNonEmptyBlock_.transCount);
@@ -2177,6 +2424,22 @@ std::vector<cs::Sequence>* BlockChain::getIncorrectBlockNumbers() {
 void BlockChain::showDBParams() {
     csinfo() << "last seq = " << lastSequence_ << ", db size = " << storage_.size();
 }
+
+size_t BlockChain::getBlockHashesDbMapSize() const {
+    return blockHashes_ ? blockHashes_->dbMapSize() : 0;
+}
+
+size_t BlockChain::getTrxIndexDbMapSize() const {
+    return trxIndex_ ? trxIndex_->dbMapSize() : 0;
+}
+
+size_t BlockChain::getBlockHashesDbOccupancy() const {
+    return blockHashes_ ? blockHashes_->dbOccupancyPercent() : 0;
+}
+
+size_t BlockChain::getTrxIndexDbOccupancy() const {
+    return trxIndex_ ? trxIndex_->dbOccupancyPercent() : 0;
+}
 //while caching the blocks are put out of the storeage in the with sequence decrement
 void BlockChain::cacheLastBlocks() {
     csinfo() << kLogPrefix << __func__;//we have to begin with good block
@@ -11,6 +11,7 @@
 #include <csnode/blockchain_serializer.hpp>
 #include <csnode/serializers_helper.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/mmappedfile.hpp>
 
 namespace {
 const std::string kDataFileName = "blockchain.dat";
@@ -55,8 +56,8 @@ void BlockChain_Serializer::clear(const std::filesystem::path& rootDir) {
 }
 
 void BlockChain_Serializer::save(const std::filesystem::path& rootDir) {
-    std::ofstream ofs(rootDir / kDataFileName, std::ios::binary);
-    boost::archive::binary_oarchive oa(ofs);
+    MMappedOutput out((rootDir / kDataFileName).string());
+    boost::archive::binary_oarchive oa(out.stream());
     oa << *previousNonEmpty_;
     oa << *lastNonEmptyBlock_;
     oa << *totalTransactionsCount_;
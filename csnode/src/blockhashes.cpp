@@ -16,6 +16,8 @@ BlockHashes::BlockHashes(const std::string& path)
 }
 
 void BlockHashes::close() {
+    flushBuffer();
+
     if (seqDb_.isOpen()) {
         seqDb_.close();
     }
@@ -26,7 +28,7 @@ void BlockHashes::close() {
 }
 
 size_t BlockHashes::size() const {
-    return seqDb_.size();
+    return seqDb_.size() + pending_.size();
 }
 
 bool BlockHashes::update(const csdb::Pool& block) {
@@ -39,13 +41,27 @@ bool BlockHashes::update(const csdb::Pool& block) {
         return true;
     }
 
-    seqDb_.insert(seq, hash.to_binary());
-    hashDb_.insert(hash.to_binary(), seq);
+    // a gap means the chain jumped (rollback, cache pop out of order); flush
+    // so the databases never lag behind by more than a contiguous tail
+    if (!pending_.empty() && pending_.rbegin()->first + 1 != seq) {
+        flushBuffer();
+    }
+
+    pending_[seq] = hash.to_binary();
+
+    if (pending_.size() >= kWriteBufferLimit) {
+        flushBuffer();
+    }
 
     return true;
 }
 
 csdb::PoolHash BlockHashes::find(cs::Sequence seq) const {
+    if (auto it = pending_.find(seq); it != pending_.end()) {
+        cs::Bytes binary = it->second;
+        return csdb::PoolHash::from_binary(std::move(binary));
+    }
+
     if (seqDb_.size() == 0 || !seqDb_.isKeyExists(seq)) {
         return csdb::PoolHash{};
     }
@@ -55,14 +71,29 @@ csdb::PoolHash BlockHashes::find(cs::Sequence seq) const {
 }
 
 cs::Sequence BlockHashes::find(const csdb::PoolHash& hash) const {
-    if (hash.is_empty() || hashDb_.size() == 0 || !hashDb_.isKeyExists(hash.to_binary())) {
+    if (hash.is_empty()) {
         return cs::kWrongSequence;
     }
 
-    return hashDb_.value<cs::Sequence>(hash.to_binary());
+    // the buffer holds at most kWriteBufferLimit entries
+    const auto binary = hash.to_binary();
+    for (const auto& [seq, hashBinary] : pending_) {
+        if (hashBinary == binary) {
+            return seq;
+        }
+    }
+
+    if (hashDb_.size() == 0 || !hashDb_.isKeyExists(binary)) {
+        return cs::kWrongSequence;
+    }
+
+    return hashDb_.value<cs::Sequence>(binary);
 }
 
 bool BlockHashes::remove(cs::Sequence sequence) {
+    // removals are rare (rollback); keep them simple by draining the buffer
+    flushBuffer();
+
     auto hash = find(sequence);
     if (hash.is_empty()) {
         return false;
@@ -73,6 +104,8 @@ bool BlockHashes::remove(cs::Sequence sequence) {
 }
 
 bool BlockHashes::remove(const csdb::PoolHash& hash) {
+    flushBuffer();
+
     auto sequence = find(hash);
     if (sequence == kWrongSequence) {
         return false;
@@ -82,6 +115,40 @@ bool BlockHashes::remove(const csdb::PoolHash& hash) {
     return true;
 }
 
+void BlockHashes::flushBuffer() {
+    if (pending_.empty()) {
+        return;
+    }
+
+    try {
+        auto batch = seqDb_.writeBatch();
+
+        for (const auto& [seq, hashBinary] : pending_) {
+            batch.insert(seq, hashBinary);
+        }
+
+        batch.commit();
+    }
+    catch (const lmdb::error& error) {
+        cswarning() << csfunc() << ", seqDb batch commit failed: " << error.what();
+    }
+
+    try {
+        auto batch = hashDb_.writeBatch();
+
+        for (const auto& [seq, hashBinary] : pending_) {
+            batch.insert(hashBinary, seq);
+        }
+
+        batch.commit();
+    }
+    catch (const lmdb::error& error) {
+        cswarning() << csfunc() << ", hashDb batch commit failed: " << error.what();
+    }
+
+    pending_.clear();
+}
+
 void BlockHashes::onDbFailed(const LmdbException& exception) {
     cswarning() << csfunc() << ", block hashes database exception: " << exception.what();
 }
@@ -0,0 +1,129 @@
+#include <csnode/blockreadcache.hpp>
+
+namespace cs {
+
+csdb::Pool BlockReadCache::get(cs::Sequence sequence, const RangeLoader& loadRange) {
+    noteAccess(sequence);
+
+    auto poolIt = poolIndex_.find(sequence);
+    if (poolIt != poolIndex_.end()) {
+        ++hits_;
+        pools_.splice(pools_.begin(), pools_, poolIt->second);
+        return poolIt->second->second;
+    }
+
+    auto regionIt = compressedIndex_.find(sequence);
+    if (regionIt != compressedIndex_.end()) {
+        ++hits_;
+        csdb::Pool pool = csdb::Pool::from_binary(compressor_.decompress<cs::Bytes>(regionIt->second->second));
+        compressed_.erase(regionIt->second);
+        compressedIndex_.erase(regionIt);
+
+        if (pool.is_valid()) {
+            storePool(pool);
+            return pool;
+        }
+        // corrupt entry, fall through to storage; should not happen
+    }
+
+    ++misses_;
+
+    // a sequential run means a chain walk: read ahead in one storage pass,
+    // the next requests of the walk are then served from the cache
+    const size_t count = sequentialRun_ >= kSequentialRun ? kPrefetchDepth : 1;
+    std::vector<csdb::Pool> loaded = loadRange(sequence, count);
+
+    if (loaded.empty()) {
+        return csdb::Pool{};
+    }
+
+    storePool(loaded.front());
+
+    for (size_t i = 1; i < loaded.size(); ++i) {
+        storeCompressed(loaded[i]);
+    }
+
+    return loaded.front();
+}
+
+void BlockReadCache::invalidateFrom(cs::Sequence from) {
+    for (auto it = pools_.begin(); it != pools_.end();) {
+        if (it->first >= from) {
+            poolIndex_.erase(it->first);
+            it = pools_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    for (auto it = compressed_.begin(); it != compressed_.end();) {
+        if (it->first >= from) {
+            compressedIndex_.erase(it->first);
+            it = compressed_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void BlockReadCache::clear() {
+    pools_.clear();
+    poolIndex_.clear();
+    compressed_.clear();
+    compressedIndex_.clear();
+    sequentialRun_ = 0;
+}
+
+void BlockReadCache::noteAccess(cs::Sequence sequence) {
+    sequentialRun_ = (lastSequence_ + 1 == sequence) ? sequentialRun_ + 1 : 1;
+    lastSequence_ = sequence;
+}
+
+void BlockReadCache::storePool(const csdb::Pool& pool) {
+    if (!pool.is_valid()) {
+        return;
+    }
+
+    const cs::Sequence sequence = pool.sequence();
+    auto it = poolIndex_.find(sequence);
+
+    if (it != poolIndex_.end()) {
+        it->second->second = pool;
+        pools_.splice(pools_.begin(), pools_, it->second);
+        return;
+    }
+
+    pools_.emplace_front(sequence, pool);
+    poolIndex_[sequence] = pools_.begin();
+
+    if (pools_.size() > kMaxPools) {
+        // demote the coldest pool to the compressed level instead of dropping it
+        auto& victim = pools_.back();
+        poolIndex_.erase(victim.first);
+        storeCompressed(victim.second);
+        pools_.pop_back();
+    }
+}
+
+void BlockReadCache::storeCompressed(const csdb::Pool& pool) {
+    if (!pool.is_valid()) {
+        return;
+    }
+
+    const cs::Sequence sequence = pool.sequence();
+    if (poolIndex_.find(sequence) != poolIndex_.end() || compressedIndex_.find(sequence) != compressedIndex_.end()) {
+        return;
+    }
+
+    compressed_.emplace_front(sequence, compressor_.compress(pool.to_binary()));
+    compressedIndex_[sequence] = compressed_.begin();
+
+    if (compressed_.size() > kMaxCompressed) {
+        compressedIndex_.erase(compressed_.back().first);
+        compressed_.pop_back();
+    }
+}
+
+}  // namespace cs
@@ -1,5 +1,10 @@
 #include <csnode/blockvalidator.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <vector>
+
 #include <csnode/node.hpp>
 #include <csnode/blockchain.hpp>
 #include <csnode/walletsstate.hpp>
@@ -9,18 +14,69 @@
 
 namespace cs {
 
+///
+/// @brief Compile-time composition of the always-on plugins. The chain is one
+/// fused function per visitor instantiation: level bits are tested inline and
+/// every validateBlock call binds to the final plugin type, no map walk and
+/// no vtable on the common all-pass path.
+///
+struct BlockValidator::CoreChain {
+    explicit CoreChain(BlockValidator& bv)
+    : hash_(bv)
+    , blockNum_(bv)
+    , timestamp_(bv)
+    , blockSignatures_(bv)
+    , smartSignatures_(bv)
+    , balances_(bv)
+    , transactionsSignatures_(bv)
+    , smartStates_(bv) {
+    }
+
+    ///
+    /// @brief Calls visitor with every plugin whose level bit is requested.
+    /// Independent read-only plugins go first, state-mutating ones after -
+    /// the same two-phase order the registry walk used to produce. Stops at
+    /// the first visitor returning false.
+    ///
+    template <typename Visitor>
+    bool visit(ValidationFlags flags, Visitor&& visitor) {
+        return visitOne<hashIntergrity>(flags, hash_, visitor)
+            && visitOne<blockNum>(flags, blockNum_, visitor)
+            && visitOne<timestamp>(flags, timestamp_, visitor)
+            && visitOne<blockSignatures>(flags, blockSignatures_, visitor)
+            && visitOne<smartSignatures>(flags, smartSignatures_, visitor)
+            && visitOne<transactionsSignatures>(flags, transactionsSignatures_, visitor)
+            && visitOne<balances>(flags, balances_, visitor)
+            && visitOne<smartStates>(flags, smartStates_, visitor);
+    }
+
+private:
+    template <ValidationLevel level, typename Plugin, typename Visitor>
+    static bool visitOne(ValidationFlags flags, Plugin& plugin, Visitor& visitor) {
+        if ((flags & level) == 0u) {
+            return true;
+        }
+
+        return visitor(plugin);
+    }
+
+    HashValidator hash_;
+    BlockNumValidator blockNum_;
+    TimestampValidator timestamp_;
+    BlockSignaturesValidator blockSignatures_;
+    SmartSourceSignaturesValidator smartSignatures_;
+    BalanceChecker balances_;
+    TransactionsChecker transactionsSignatures_;
+    SmartStateValidator smartStates_;
+};
+
 BlockValidator::BlockValidator(Node& node)
 : node_(node)
 , bc_(node_.getBlockChain())
 , wallets_(::std::make_shared<WalletsState>(bc_.getCacheUpdater())) {
-    plugins_.insert(std::make_pair(hashIntergrity, std::make_unique<HashValidator>(*this)));
-    plugins_.insert(std::make_pair(blockNum, std::make_unique<BlockNumValidator>(*this)));
-    plugins_.insert(std::make_pair(timestamp, std::make_unique<TimestampValidator>(*this)));
-    plugins_.insert(std::make_pair(blockSignatures, std::make_unique<BlockSignaturesValidator>(*this)));
-    plugins_.insert(std::make_pair(smartSignatures, std::make_unique<SmartSourceSignaturesValidator>(*this)));
-    plugins_.insert(std::make_pair(balances, std::make_unique<BalanceChecker>(*this)));
-    plugins_.insert(std::make_pair(transactionsSignatures, std::make_unique<TransactionsChecker>(*this)));
-    plugins_.insert(std::make_pair(smartStates, std::make_unique<SmartStateValidator>(*this)));
+    core_ = std::make_unique<CoreChain>(*this);
+
+    // optional diagnostic plugins stay behind the dynamic registry
     /*HL99dwfM3YPQnauN1djBvVLZNbC3b1FHwe5vPv8pDZ1y - 0xAAE*/
     /*CSa4DTfTcenryQAifiPKVpY9jzWshYY11g3mXQR6B7rJ - dAp*/
     /*8Vr9JA4AessnxVthGjp2ae7YLWQPU7jMvWYiPZA6vpDH - -253CS*/
@@ -56,13 +112,85 @@ bool BlockValidator::validateBlock(const csdb::Pool& block, ValidationFlags flag
     }
 
     ErrorType validationResult = noError;
-    for (auto& plugin : plugins_) {
-        if (flags & plugin.first) {
-            validationResult = plugin.second->validateBlock(block);
+
+    if (!block.transactions().empty()) {
+        // heavy block: the fan-out over independent plugins pays off, the
+        // chain only collects bound calls here, dispatch is still static
+        std::vector<std::function<ErrorType()>> independent;
+        std::vector<std::function<ErrorType()>> dependent;
+
+        core_->visit(flags, [&](auto& plugin) {
+            (plugin.isIndependent() ? independent : dependent).push_back([&plugin, &block] {
+                return plugin.validateBlock(block);
+            });
+
+            return true;
+        });
+
+        for (auto& entry : plugins_) {
+            if (flags & entry.first) {
+                ValidationPlugin* plugin = entry.second.get();
+                (plugin->isIndependent() ? independent : dependent).push_back([plugin, &block] {
+                    return plugin->validateBlock(block);
+                });
+            }
+        }
+
+        if (independent.size() > 1) {
+            // independent plugins only read shared state, fan them out and keep the worst result
+            std::vector<std::future<ErrorType>> results;
+            results.reserve(independent.size() - 1);
+
+            for (size_t i = 1; i < independent.size(); ++i) {
+                results.push_back(std::async(std::launch::async, independent[i]));
+            }
+
+            validationResult = independent.front()();
+
+            for (auto& result : results) {
+                validationResult = std::max(validationResult, result.get());
+            }
+
             if (!return_(validationResult, severity)) {
                 return false;
             }
         }
+        else {
+            for (auto& plugin : independent) {
+                validationResult = plugin();
+                if (!return_(validationResult, severity)) {
+                    return false;
+                }
+            }
+        }
+
+        for (auto& plugin : dependent) {
+            validationResult = plugin();
+            if (!return_(validationResult, severity)) {
+                return false;
+            }
+        }
+    }
+    else {
+        // empty block, the sync common case: one fused pass over the core
+        // chain, nothing is collected and nothing goes through a vtable
+        const bool passed = core_->visit(flags, [&](auto& plugin) {
+            validationResult = plugin.validateBlock(block);
+            return return_(validationResult, severity);
+        });
+
+        if (!passed) {
+            return false;
+        }
+
+        for (auto& entry : plugins_) {
+            if (flags & entry.first) {
+                validationResult = entry.second->validateBlock(block);
+                if (!return_(validationResult, severity)) {
+                    return false;
+                }
+            }
+        }
     }
 
     prevBlock_ = block;
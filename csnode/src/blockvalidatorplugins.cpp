@@ -2,7 +2,11 @@
 
 #include <string>
 #include <algorithm>
+#include <deque>
 #include <set>
+#include <vector>
+
+#include <lib/system/cryptoservice.hpp>
 
 #include <csdb/pool.hpp>
 #include <csnode/blockchain.hpp>
@@ -223,22 +227,28 @@ ValidationPlugin::ErrorType BlockSignaturesValidator::validateBlock(const csdb::
     return ErrorType::error;
   }
 
-  size_t checkingSignature = 0;
   auto signedData = cscrypto::calculateHash(block.to_binary().data(), block.hashingLength());
+
+  // collect the (signature, key) pairs first, then verify the whole batch;
+  // signature checks dominate full-validation sync, the crypto service
+  // spreads large sets over the pool workers on its own
+  std::vector<cs::CryptoService::VerifyJob> jobs;
+  jobs.reserve(signatures.size());
+
+  size_t slot = 0;
   for (size_t i = 0; i < confidants.size(); ++i) {
     if (realTrustedMask & (1ull << i)) {
-      if (!cscrypto::verifySignature(signatures[checkingSignature],
-                                     confidants[i],
-                                     signedData.data(),
-                                     cscrypto::kHashSize)) {
-        cserror() << kLogPrefix << "block " << block.sequence()
-                  << " has invalid signatures";
-        return ErrorType::error;
-      }
-      ++checkingSignature;
+      jobs.push_back(cs::CryptoService::VerifyJob{signatures[slot].data(), confidants[i].data(), signedData.data(), cscrypto::kHashSize});
+      ++slot;
     }
   }
 
+  if (!cs::CryptoService::instance().verifyAll(jobs)) {
+    cserror() << kLogPrefix << "block " << block.sequence()
+              << " has invalid signatures";
+    return ErrorType::error;
+  }
+
   return ErrorType::noError;
 }
 
@@ -312,6 +322,22 @@ bool SmartSourceSignaturesValidator::checkSignatures(const SmartSignatures& sigs
     return false;
   }
 
+  // the signatures of every packet are independent of each other, so all of
+  // them go into one batch and the crypto service spreads the work over its
+  // pool the same way block signatures are handled during sync
+  struct JobOrigin {
+    const cs::TransactionsPacket* pack;
+    cs::Byte confidant;
+    cs::Sequence initSequence;
+  };
+
+  std::vector<cs::CryptoService::VerifyJob> jobs;
+  std::vector<JobOrigin> origins;
+  std::vector<cs::Bytes> hashes;
+  hashes.reserve(smartPacks.size());
+  // jobs keep raw pointers, deque never relocates the stored keys
+  std::deque<cs::PublicKey> keys;
+
   for (const auto& pack : smartPacks) {
     auto it = std::find_if(sigs.begin(), sigs.end(),
                            [&pack] (const csdb::Pool::SmartSignature& s) {
@@ -326,22 +352,35 @@ bool SmartSourceSignaturesValidator::checkSignatures(const SmartSignatures& sigs
     auto initPool = getBlockChain().loadBlock(it->smartConsensusPool);
     const auto& confidants = initPool.confidants();
     const auto& smartSignatures = it->signatures;
+    hashes.push_back(pack.hash().toBinary());
+
     for (const auto& s : smartSignatures) {
       if (s.first >= confidants.size()) {
         cserror() << kLogPrefix << "smart signature validation: no conf with index "
                   << s.first << " in init pool with sequence " << initPool.sequence();
         return false;
       }
-      if (!cscrypto::verifySignature(s.second, confidants[s.first], pack.hash().toBinary().data(), cscrypto::kHashSize)) {
-        cserror() << kLogPrefix << "incorrect signature of smart "
-                  << pack.transactions()[0].source().to_string() << " of confidant " << s.first
-                  << " from init pool with sequence " << initPool.sequence();
-        return false;
-      }
+      keys.push_back(confidants[s.first]);
+      jobs.push_back(cs::CryptoService::VerifyJob{s.second.data(), keys.back().data(),
+                                                  hashes.back().data(), hashes.back().size()});
+      origins.push_back(JobOrigin{&pack, s.first, initPool.sequence()});
+    }
+  }
+
+  const std::vector<cs::Byte> results = cs::CryptoService::instance().verifyBatch(jobs);
+  bool allValid = true;
+
+  for (size_t index = 0; index < results.size(); ++index) {
+    if (results[index] == 0) {
+      const JobOrigin& origin = origins[index];
+      cserror() << kLogPrefix << "incorrect signature of smart "
+                << origin.pack->transactions()[0].source().to_string() << " of confidant " << origin.confidant
+                << " from init pool with sequence " << origin.initSequence;
+      allValid = false;
     }
   }
 
-  return true;
+  return allValid;
 }
 
 inline bool SmartSourceSignaturesValidator::containsNewState(const Transactions& trxs) {
@@ -1,13 +1,20 @@
 #include <csnode/caches_serialization_manager.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <vector>
 
+#include <base58.h>
+
 #ifdef _WIN32
 #  include <io.h>
 #  include <fcntl.h>
@@ -25,6 +32,7 @@
 #include <csnode/roundstat_serializer.hpp>
 #include <csconnector/csconnector.hpp>
 
+#include <lib/system/concurrent.hpp>
 #include <lib/system/logger.hpp>
 
 namespace {
@@ -87,6 +95,8 @@ struct CachesSerializationManager::Impl {
     const std::string kSchemaFile = "schema_version";
     const std::string kSentinelFile = "sentinel.bin";
     static constexpr uint8_t kCurrentSchemaVersion = 1;
+    static constexpr uint32_t kSnapshotMagic = 0x50414E53u; // "SNAP" LE
+    static constexpr uint8_t kSnapshotFormatVersion = 1;
     static constexpr uint32_t kHeadMagic = 0x44414548u; // "HEAD" LE
     static constexpr uint8_t kSentinelCompletedFromGenesisBit = 1 << 0;
     const std::vector <std::string> hashesDivisions = {"blockchain", "smartcontracts","walletscache","walletsIds","roundstat","tokensmaster","apihandler"};
@@ -563,15 +573,58 @@ bool CachesSerializationManager::save(size_t version, const CheckpointHead& head
     }
 
     try {
-        pImpl_->blockchainSerializer.save(tmp_path);
-        pImpl_->smartContractsSerializer.save(tmp_path);
-        pImpl_->walletsCacheSerializer.save(tmp_path);
-        pImpl_->walletsIdsSerializer.save(tmp_path);
-        pImpl_->roundStatSerializer.save(tmp_path);
+        // subsystem states are independent and write disjoint files, so they
+        // are serialized concurrently: the checkpoint takes as long as the
+        // largest cache instead of the sum of all of them
+        std::vector<std::function<void()>> jobs;
+        jobs.emplace_back([&] { pImpl_->blockchainSerializer.save(tmp_path); });
+        jobs.emplace_back([&] { pImpl_->smartContractsSerializer.save(tmp_path); });
+        jobs.emplace_back([&] { pImpl_->walletsCacheSerializer.save(tmp_path); });
+        jobs.emplace_back([&] { pImpl_->walletsIdsSerializer.save(tmp_path); });
+        jobs.emplace_back([&] { pImpl_->roundStatSerializer.save(tmp_path); });
 #ifdef NODE_API
-        pImpl_->tokensMasterSerializer.save(tmp_path);
-        pImpl_->apiHandlerSerializer.save(tmp_path);
+        jobs.emplace_back([&] { pImpl_->tokensMasterSerializer.save(tmp_path); });
+        jobs.emplace_back([&] { pImpl_->apiHandlerSerializer.save(tmp_path); });
 #endif
+
+        std::atomic<size_t> jobsLeft = jobs.size();
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+        std::mutex errorMutex;
+        std::string errorMessage;
+
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            boost::asio::post(cs::ThreadPool::instance(), [&, i] {
+                try {
+                    jobs[i]();
+                }
+                catch (const std::exception& e) {
+                    cs::Lock lock(errorMutex);
+                    errorMessage = e.what();
+                }
+                catch (...) {
+                    cs::Lock lock(errorMutex);
+                    errorMessage = "unknown serializer error";
+                }
+
+                if (jobsLeft.fetch_sub(1) == 1) {
+                    std::unique_lock<std::mutex> doneLock(doneMutex);
+                    doneCondition.notify_one();
+                }
+            });
+        }
+
+        {
+            std::unique_lock<std::mutex> doneLock(doneMutex);
+            doneCondition.wait(doneLock, [&] {
+                return jobsLeft.load() == 0;
+            });
+        }
+
+        if (!errorMessage.empty()) {
+            throw std::runtime_error(errorMessage);
+        }
+
         pImpl_->saveHashes(tmp_path);
         pImpl_->saveSchema(tmp_path);
         pImpl_->saveSentinel(tmp_path);
@@ -768,4 +821,238 @@ void CachesSerializationManager::pruneCheckpoints(size_t keep) {
     }
 }
 
+namespace {
+
+void appendBytes(cs::Bytes& out, const void* data, size_t size) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), p, p + size);
+}
+
+template <typename T>
+void appendValue(cs::Bytes& out, T value) {
+    appendBytes(out, &value, sizeof(T));
+}
+
+template <typename T>
+bool readValue(const cs::Bytes& in, size_t& pos, T& value) {
+    if (in.size() - pos < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+bool CachesSerializationManager::exportSnapshot(const std::string& filePath, const cs::PrivateKey& key) {
+    // newest chain-bound checkpoint wins; legacy ones (no head.bin) cannot be
+    // verified against the chain on the importing side, so they do not qualify
+    size_t bestVersion = 0;
+    cs::Sequence bestSeq = 0;
+    bool found = false;
+
+    for (size_t v : pImpl_->getVersions()) {
+        std::filesystem::path p(pImpl_->kQuickStartRoot);
+        p /= std::to_string(v);
+        auto head = pImpl_->loadHead(p);
+        if (!head) {
+            continue;
+        }
+        const auto effective = std::max<cs::Sequence>(head->sequence, static_cast<cs::Sequence>(v));
+        if (!found || effective > bestSeq) {
+            bestVersion = v;
+            bestSeq = effective;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        cserror() << "CachesSerializationManager: no chain-bound checkpoint to export";
+        return false;
+    }
+
+    const std::filesystem::path dir = std::filesystem::path(pImpl_->kQuickStartRoot) / std::to_string(bestVersion);
+    csinfo() << "CachesSerializationManager: exporting qs/" << bestVersion << " (seq " << bestSeq << ") to " << filePath;
+
+    cs::Bytes payload;
+    appendValue(payload, pImpl_->kSnapshotMagic);
+    appendValue(payload, pImpl_->kSnapshotFormatVersion);
+    appendValue(payload, static_cast<uint64_t>(bestVersion));
+
+    uint32_t fileCount = 0;
+    const size_t fileCountPos = payload.size();
+    appendValue(payload, fileCount);
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(dir, ec)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+
+        const std::string name = entry.path().lexically_relative(dir).generic_string();
+
+        std::ifstream f(entry.path(), std::ios::binary);
+        if (!f.is_open()) {
+            cserror() << "CachesSerializationManager: cannot read " << entry.path();
+            return false;
+        }
+        cs::Bytes content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+        appendValue(payload, static_cast<uint16_t>(name.size()));
+        appendBytes(payload, name.data(), name.size());
+        appendValue(payload, static_cast<uint64_t>(content.size()));
+        appendBytes(payload, content.data(), content.size());
+        ++fileCount;
+    }
+
+    if (fileCount == 0) {
+        cserror() << "CachesSerializationManager: checkpoint qs/" << bestVersion << " is empty";
+        return false;
+    }
+    std::memcpy(payload.data() + fileCountPos, &fileCount, sizeof(fileCount));
+
+    // the exporter key is inside the signed region, the importer checks it
+    // against its trusted set before unpacking anything
+    const cs::PublicKey exporter = cscrypto::getMatchingPublic(key);
+    appendBytes(payload, exporter.data(), exporter.size());
+
+    const cs::Hash hash = cscrypto::calculateHash(payload.data(), payload.size());
+    const cs::Signature signature = cscrypto::generateSignature(key, hash.data(), hash.size());
+
+    std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(payload.data()), std::streamsize(payload.size()));
+    out.write(reinterpret_cast<const char*>(signature.data()), std::streamsize(signature.size()));
+    out.flush();
+    if (!out.good()) {
+        cserror() << "CachesSerializationManager: cannot write snapshot to " << filePath;
+        return false;
+    }
+
+    csinfo() << "CachesSerializationManager: snapshot exported, " << payload.size() + signature.size()
+             << " bytes, exporter key " << EncodeBase58(exporter.data(), exporter.data() + exporter.size());
+    return true;
+}
+
+bool CachesSerializationManager::importSnapshot(const std::string& filePath, const std::set<cs::PublicKey>& trustedKeys) {
+    std::ifstream f(filePath, std::ios::binary);
+    if (!f.is_open()) {
+        cserror() << "CachesSerializationManager: cannot open snapshot " << filePath;
+        return false;
+    }
+    cs::Bytes blob((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    if (blob.size() < kSignatureLength + kPublicKeyLength) {
+        cserror() << "CachesSerializationManager: snapshot " << filePath << " is truncated";
+        return false;
+    }
+
+    // signature covers everything before it, exporter key included
+    const size_t payloadSize = blob.size() - kSignatureLength;
+
+    cs::Signature signature;
+    std::memcpy(signature.data(), blob.data() + payloadSize, kSignatureLength);
+
+    cs::PublicKey exporter;
+    std::memcpy(exporter.data(), blob.data() + payloadSize - kPublicKeyLength, kPublicKeyLength);
+
+    const cs::Hash hash = cscrypto::calculateHash(blob.data(), payloadSize);
+    if (!cscrypto::verifySignature(signature, exporter, hash.data(), hash.size())) {
+        cserror() << "CachesSerializationManager: snapshot signature verification failed";
+        return false;
+    }
+
+    if (!trustedKeys.empty() && trustedKeys.count(exporter) == 0) {
+        cserror() << "CachesSerializationManager: snapshot exporter "
+                  << EncodeBase58(exporter.data(), exporter.data() + exporter.size())
+                  << " is not in the trusted key set";
+        return false;
+    }
+
+    size_t pos = 0;
+    uint32_t magic = 0;
+    uint8_t formatVersion = 0;
+    uint64_t version = 0;
+    uint32_t fileCount = 0;
+    if (!readValue(blob, pos, magic) || magic != pImpl_->kSnapshotMagic) {
+        cserror() << "CachesSerializationManager: snapshot magic mismatch";
+        return false;
+    }
+    if (!readValue(blob, pos, formatVersion) || formatVersion != pImpl_->kSnapshotFormatVersion) {
+        cserror() << "CachesSerializationManager: unsupported snapshot format version "
+                  << static_cast<int>(formatVersion);
+        return false;
+    }
+    if (!readValue(blob, pos, version) || !readValue(blob, pos, fileCount) || fileCount == 0) {
+        cserror() << "CachesSerializationManager: snapshot header truncated";
+        return false;
+    }
+
+    const std::filesystem::path root(pImpl_->kQuickStartRoot);
+    const std::filesystem::path finalPath = root / std::to_string(version);
+    const std::filesystem::path tmpPath = root / (std::to_string(version) + ".tmp");
+
+    std::error_code ec;
+    std::filesystem::create_directories(root, ec);
+    std::filesystem::remove_all(tmpPath, ec);
+    std::filesystem::create_directories(tmpPath, ec);
+    if (ec) {
+        cserror() << "CachesSerializationManager: cannot create " << tmpPath << ": " << ec.message();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < fileCount; ++i) {
+        uint16_t nameSize = 0;
+        if (!readValue(blob, pos, nameSize) || nameSize == 0 || blob.size() - pos < nameSize) {
+            cserror() << "CachesSerializationManager: snapshot file entry truncated";
+            std::filesystem::remove_all(tmpPath, ec);
+            return false;
+        }
+        const std::string name(reinterpret_cast<const char*>(blob.data() + pos), nameSize);
+        pos += nameSize;
+
+        // the archive only ever holds paths relative to the checkpoint dir
+        const std::filesystem::path relative(name);
+        if (relative.is_absolute() || name.find("..") != std::string::npos) {
+            cserror() << "CachesSerializationManager: snapshot contains unsafe path " << name;
+            std::filesystem::remove_all(tmpPath, ec);
+            return false;
+        }
+
+        uint64_t contentSize = 0;
+        if (!readValue(blob, pos, contentSize) || blob.size() - pos < contentSize) {
+            cserror() << "CachesSerializationManager: snapshot file " << name << " truncated";
+            std::filesystem::remove_all(tmpPath, ec);
+            return false;
+        }
+
+        const std::filesystem::path target = tmpPath / relative;
+        std::filesystem::create_directories(target.parent_path(), ec);
+        std::ofstream out(target, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(blob.data() + pos), std::streamsize(contentSize));
+        if (!out.good()) {
+            cserror() << "CachesSerializationManager: cannot write " << target;
+            std::filesystem::remove_all(tmpPath, ec);
+            return false;
+        }
+        pos += contentSize;
+    }
+
+    fsyncDirContents(tmpPath);
+
+    std::filesystem::remove_all(finalPath, ec);
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        cserror() << "CachesSerializationManager: publish rename " << tmpPath << " -> " << finalPath
+                  << " failed: " << ec.message();
+        std::filesystem::remove_all(tmpPath, ec);
+        return false;
+    }
+    fsyncDir(root);
+
+    csinfo() << "CachesSerializationManager: snapshot imported into qs/" << version
+             << ", exporter key " << EncodeBase58(exporter.data(), exporter.data() + exporter.size());
+    return true;
+}
+
 } // namespace cs
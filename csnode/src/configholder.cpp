@@ -11,11 +11,20 @@ void cs::ConfigHolder::onConfigChanged(const Config& config) {
 
 void cs::ConfigHolder::setConfig(const Config& config) {
     config_.exchange(config);
+    version_.fetch_add(1, std::memory_order_release);
 }
 
 const Config* cs::ConfigHolder::config() const {
     return config_.operator->();
 }
 
+std::shared_ptr<const Config> cs::ConfigHolder::snapshot() const {
+    return config_.share();
+}
+
+uint64_t cs::ConfigHolder::version() const {
+    return version_.load(std::memory_order_acquire);
+}
+
 cs::ConfigHolder::ConfigHolder() = default;
 cs::ConfigHolder::~ConfigHolder() = default;
@@ -1,19 +1,31 @@
 #include "csnode/conveyer.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <exception>
 #include <iomanip>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <csdb/transaction.hpp>
 
 #include <csnode/configholder.hpp>
+#include <csnode/cyclicbuffer.hpp>
 #include <csnode/datastream.hpp>
 #include <csnode/sendcachedata.hpp>
+#include <csnode/shardedpackettable.hpp>
 
 #include <solver/consensus.hpp>
 #include <solver/smartcontracts.hpp>
 
+#include <lib/system/concurrent.hpp>
 #include <lib/system/hash.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/metrics.hpp>
 #include <lib/system/utils.hpp>
 
 namespace {
@@ -23,6 +35,102 @@ std::once_flag onceFlag = {};
 static void setup(cs::ConveyerBase* conveyer) {
     conveyerView = conveyer;
 }
+
+// true if any of the eight mask bytes packed into the word is zero
+inline bool hasZeroByte(uint64_t word) {
+    return ((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) != 0;
+}
+
+// returns the end of the run of mask bytes starting at position that share the given
+// acceptance state; uniform words are skipped eight mask bytes at a time
+static size_t maskRunEnd(const cs::Byte* mask, size_t position, size_t size, bool accepted) {
+    constexpr size_t wordSize = sizeof(uint64_t);
+
+    while (position + wordSize <= size) {
+        uint64_t word = 0;
+        std::memcpy(&word, mask + position, wordSize);
+
+        const bool uniform = accepted ? !hasZeroByte(word) : word == 0;
+
+        if (!uniform) {
+            break;
+        }
+
+        position += wordSize;
+    }
+
+    while (position < size && (mask[position] != 0u) == accepted) {
+        ++position;
+    }
+
+    return position;
+}
+
+// rotating window of 64-bit transaction fingerprints covering the last
+// kDedupRounds rounds; a replayed or re-gossiped transaction is recognized at
+// hash-set cost instead of reaching validation every round it reappears. The
+// fingerprint folds the whole source address, so a collision needs all 64 bits
+// to match; a source switching between key and wallet-id representation only
+// costs the fast path, validation still rejects it by inner id
+class DedupWindow {
+public:
+    static uint64_t fingerprint(const csdb::Transaction& transaction) {
+        // FNV-1a over the source address bytes followed by the inner id
+        uint64_t hash = 14695981039346656037ULL;
+
+        const auto fold = [&hash](const void* data, size_t size) {
+            const auto* bytes = static_cast<const cs::Byte*>(data);
+
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+
+        const csdb::Address source = transaction.source();
+
+        if (source.is_public_key()) {
+            const cs::PublicKey& key = source.public_key();
+            fold(key.data(), key.size());
+        }
+        else {
+            const auto id = source.wallet_id();
+            fold(&id, sizeof(id));
+        }
+
+        const int64_t innerID = transaction.innerID();
+        fold(&innerID, sizeof(innerID));
+
+        return hash;
+    }
+
+    bool contains(uint64_t fingerprint) const {
+        for (const auto& bucket : buckets_) {
+            if (bucket.count(fingerprint) != 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void insert(uint64_t fingerprint) {
+        buckets_[current_].insert(fingerprint);
+    }
+
+    // reuses the oldest bucket for the new round, so fingerprints age out
+    // after kDedupRounds rotations without a scan
+    void rotate() {
+        current_ = (current_ + 1) % buckets_.size();
+        buckets_[current_].clear();
+    }
+
+private:
+    constexpr static size_t kDedupRounds = 8;
+
+    std::array<std::unordered_set<uint64_t>, kDedupRounds> buckets_;
+    size_t current_ = 0;
+};
 }
 
 struct cs::ConveyerBase::Impl {
@@ -34,6 +142,9 @@ struct cs::ConveyerBase::Impl {
     // current round transactions packets storage
     cs::TransactionsPacketTable packetsTable;
 
+    // sharded read-side index of packetsTable, lookups do not take the conveyer mutex
+    cs::ShardedPacketTable shardedTable;
+
     // main conveyer meta data
     cs::ConveyerMetaStorage metaStorage;
 
@@ -43,16 +154,67 @@ struct cs::ConveyerBase::Impl {
     // cached active current round number
     std::atomic<cs::RoundNumber> currentRound = 0;
 
+    // front-line duplicate filter, guarded by the conveyer mutex
+    ::DedupWindow dedupWindow;
+
     // to sign transaction packets
     cs::PrivateKey privateKey;
 
+    // last reported share of the memory budget, percent
+    size_t pressurePercent = 0;
+
+    // a watermark flush is posted and not yet executed
+    std::atomic_bool earlyFlushScheduled = false;
+
+    // rounds of history behind the shard pre-sizing estimate
+    constexpr static uint32_t kPacketHistoryRounds = 16;
+
+    // live table fill observed at recent round switches
+    CyclicBuffer<size_t, kPacketHistoryRounds> packetHistory;
+
     // helpers
     const cs::ConveyerMeta* validMeta() &;
+    size_t cachedBytes() const;
+    size_t expectedRoundPackets() const;
 };
 
 inline cs::ConveyerBase::Impl::Impl(size_t queueSize, size_t transactionsSize, size_t packetsPerRound, size_t metaSize)
 : packetQueue(queueSize, transactionsSize, packetsPerRound)
 , metaStorage(metaSize) {
+    // the per-round packet limit is known up front, skip the growth path entirely
+    packetsTable.reserve(packetsPerRound);
+}
+
+inline size_t cs::ConveyerBase::Impl::cachedBytes() const {
+    // table counters are O(1), the walk is bounded by meta storage capacity
+    size_t bytes = packetQueue.bytesCount() + packetsTable.byteSize();
+
+    for (const auto& element : metaStorage) {
+        bytes += element.meta.hashTable.byteSize();
+        bytes += element.meta.invalidTransactions.estimatedByteSize();
+    }
+
+    return bytes;
+}
+
+inline size_t cs::ConveyerBase::Impl::expectedRoundPackets() const {
+    if (packetHistory.empty()) {
+        return 0;
+    }
+
+    // p90 of recent rounds: high enough to absorb bursts, immune to a single
+    // pathological round inflating the reservation for the next sixteen
+    std::array<size_t, kPacketHistoryRounds> samples{};
+    const size_t count = packetHistory.size();
+
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = packetHistory[i];
+    }
+
+    const auto nth = samples.begin() + static_cast<std::ptrdiff_t>((count * 9) / 10);
+    std::nth_element(samples.begin(), nth, samples.begin() + static_cast<std::ptrdiff_t>(count));
+
+    return *nth;
 }
 
 inline const cs::ConveyerMeta* cs::ConveyerBase::Impl::validMeta() & {
@@ -69,6 +231,17 @@ cs::ConveyerBase::ConveyerBase() {
     pimpl_ = std::make_unique<cs::ConveyerBase::Impl>(Consensus::MaxQueueSize, Consensus::MaxPacketTransactions, Consensus::MaxPacketsPerRound, Consensus::MaxRoundsCancelContract);
     pimpl_->metaStorage.append(cs::ConveyerMetaStorage::Element());
 
+    // during long stalls old metas pin whole packet tables in memory, make the drop visible
+    pimpl_->metaStorage.setEvictionHandler([](cs::ConveyerMetaStorage::Element&& element) {
+        if (!element.meta.hashTable.empty()) {
+            cswarning() << "CONVEYER> meta for round " << element.round << " evicted with " << element.meta.hashTable.size() << " cached packets";
+        }
+    });
+
+#ifdef LOCK_PROFILING
+    cs::LockProfiler::instance().name(&sharedMutex_, "conveyer.sharedMutex");
+#endif
+
     std::call_once(::onceFlag, &::setup, this);
     cs::Connector::connect(&roundChanged, this, &cs::Conveyer::onRoundChanged);
 }
@@ -84,6 +257,11 @@ void cs::ConveyerBase::setRound(cs::RoundNumber round) {
         pimpl_->currentRound = round;
         csdebug() << csname() << "cached round updated";
 
+        {
+            cs::Lock lock(sharedMutex_);
+            pimpl_->dedupWindow.rotate();
+        }
+
         emit roundChanged(round);
     }
     else {
@@ -93,22 +271,45 @@ void cs::ConveyerBase::setRound(cs::RoundNumber round) {
 
 cs::ConveyerBase::~ConveyerBase() = default;
 
-void cs::ConveyerBase::addTransaction(const csdb::Transaction& transaction) {
+cs::PacketQueue::PushResult cs::ConveyerBase::addTransaction(const csdb::Transaction& transaction) {
     if (!transaction.is_valid()) {
         cswarning() << csname() << "Can not add no valid transaction to conveyer";
-        return;
+        return cs::PacketQueue::PushResult::Invalid;
     }
 
     cs::Lock lock(sharedMutex_);
 
     auto id = transaction.innerID();
+    const uint64_t fingerprint = ::DedupWindow::fingerprint(transaction);
 
-    if (pimpl_->packetQueue.push(transaction)) {
-        csdetails() << csname() << "Add valid transaction to conveyer id: " << id << ", queue size: " << pimpl_->packetQueue.size();
+    if (pimpl_->dedupWindow.contains(fingerprint)) {
+        csdebug() << csname() << "Transaction rejected, same source and id seen within dedup window, id: " << id;
+        return cs::PacketQueue::PushResult::Duplicate;
     }
-    else {
-        cswarning() << csname() << "Add transaction failed to queue, transaction id: " << id << ", queue size: " << pimpl_->packetQueue.size();
+
+    const auto result = pimpl_->packetQueue.push(transaction);
+
+    if (result == cs::PacketQueue::PushResult::Added) {
+        pimpl_->dedupWindow.insert(fingerprint);
     }
+
+    switch (result) {
+        case cs::PacketQueue::PushResult::Added:
+            csdetails() << csname() << "Add valid transaction to conveyer id: " << id << ", queue size: " << pimpl_->packetQueue.size();
+            scheduleEarlyFlushIfWatermarked();
+            break;
+        case cs::PacketQueue::PushResult::SourceLimitReached:
+            cswarning() << csname() << "Transaction rejected, source over per round limit, id: " << id << ", queue size: " << pimpl_->packetQueue.size();
+            break;
+        case cs::PacketQueue::PushResult::FeeTooLow:
+            cswarning() << csname() << "Transaction rejected, fee per byte below admission level, id: " << id << ", queue size: " << pimpl_->packetQueue.size();
+            break;
+        default:
+            cswarning() << csname() << "Add transaction failed to queue, transaction id: " << id << ", queue size: " << pimpl_->packetQueue.size();
+            break;
+    }
+
+    return result;
 }
 
 void cs::ConveyerBase::addContractPacket(cs::TransactionsPacket& packet) {
@@ -116,15 +317,38 @@ void cs::ConveyerBase::addContractPacket(cs::TransactionsPacket& packet) {
     csdebug() << csname() << "Add separate transactions packet to conveyer, transactions " << packet.transactionsCount();
     cs::Lock lock(sharedMutex_);
 
-    if (auto iterator = pimpl_->packetsTable.find(hash); iterator == pimpl_->packetsTable.end()) {
+    if (!pimpl_->packetsTable.contains(hash)) {
         // add current packet
         pimpl_->packetQueue.push(packet);
+        scheduleEarlyFlushIfWatermarked();
     }
     else {
         csdebug() << csname() << "Same separate packet already is in table: " << hash.toString();
     }
 }
 
+void cs::ConveyerBase::addContractPackets(cs::PacketsVector&& packets) {
+    csdebug() << csname() << "Add bulk of separate transactions packets to conveyer, packets " << packets.size();
+    cs::Lock lock(sharedMutex_);
+
+    cs::PacketsVector accepted;
+    accepted.reserve(packets.size());
+
+    for (auto& packet : packets) {
+        cs::TransactionsPacketHash hash = packet.hash();
+
+        if (!pimpl_->packetsTable.contains(hash)) {
+            accepted.push_back(std::move(packet));
+        }
+        else {
+            csdebug() << csname() << "Same separate packet already is in table: " << hash.toString();
+        }
+    }
+
+    pimpl_->packetQueue.pushBulk(std::move(accepted));
+    scheduleEarlyFlushIfWatermarked();
+}
+
 void cs::ConveyerBase::addTransactionsPacket(const cs::TransactionsPacket& packet) {
     auto round = currentRoundNumber();
 
@@ -134,17 +358,108 @@ void cs::ConveyerBase::addTransactionsPacket(const cs::TransactionsPacket& packe
         return;
     }
 
+    if (!isRoundInAcceptanceWindow(packet.expiredRound())) {
+        csdebug() << csname() << "Ignore packet with implausible expired round " << packet.expiredRound()
+                  << ", current round " << round;
+        return;
+    }
+
     cs::TransactionsPacketHash hash = packet.hash();
     cs::Lock lock(sharedMutex_);
 
     if (!isPacketAtCache(packet)) {
+        // a repackaged replay carries a fresh hash over already seen content;
+        // own packets returning from gossip never get here, the hash check
+        // above catches them first
+        const auto& transactions = packet.transactions();
+        bool allSeen = !transactions.empty();
+
+        for (const auto& transaction : transactions) {
+            if (!pimpl_->dedupWindow.contains(::DedupWindow::fingerprint(transaction))) {
+                allSeen = false;
+                break;
+            }
+        }
+
+        if (allSeen) {
+            csdebug() << csname() << "Ignore re-gossiped packet, every transaction seen within dedup window: " << hash.toString();
+            return;
+        }
+
+        for (const auto& transaction : transactions) {
+            pimpl_->dedupWindow.insert(::DedupWindow::fingerprint(transaction));
+        }
+
+        pimpl_->shardedTable.append(hash, packet);
         pimpl_->packetsTable.emplace(std::move(hash), packet);
+
+        enforceMemoryBudget();
     }
     else {
         csdebug() << csname() << "Same hash already exists at table: " << hash.toString();
     }
 }
 
+bool cs::ConveyerBase::isRoundInAcceptanceWindow(cs::RoundNumber round) const {
+    const cs::RoundNumber current = pimpl_->currentRound.load(std::memory_order_relaxed);
+
+    // metas older than the storage capacity are evicted, such packets can
+    // never be placed; rounds far past the current one are flood noise -
+    // both rejected here at memory-read cost, before any lock is taken
+    if (round + Consensus::MaxRoundsCancelContract < current) {
+        return false;
+    }
+
+    return round <= current + Consensus::MaxRoundsCancelContract;
+}
+
+void cs::ConveyerBase::enforceMemoryBudget() {
+    const size_t budget = cs::ConfigHolder::instance().config()->conveyerData().maxCachedMemoryMb * 1024 * 1024;
+
+    if (budget == 0) {
+        return;
+    }
+
+    size_t used = pimpl_->cachedBytes();
+
+    // oldest cold metas go first, the current and the previous round are
+    // pinned - pool creation and characteristic application still need them
+    while (used > budget) {
+        const cs::RoundNumber current = pimpl_->currentRound;
+        cs::RoundNumber oldest = 0;
+        bool found = false;
+
+        for (const auto& element : pimpl_->metaStorage) {
+            if (element.round + 1 < current && (!found || element.round < oldest)) {
+                oldest = element.round;
+                found = true;
+            }
+        }
+
+        if (!found) {
+            break;
+        }
+
+        auto meta = pimpl_->metaStorage.extract(oldest);
+
+        if (meta.has_value() && !meta.value().hashTable.empty()) {
+            cswarning() << csname() << "memory budget exceeded, meta for round " << oldest << " evicted with " << meta.value().hashTable.size() << " cached packets";
+        }
+
+        used = pimpl_->cachedBytes();
+    }
+
+    // whatever is left after eviction belongs to rounds still in flight,
+    // the pressure is pushed into admission instead
+    const size_t percent = used * 100 / budget;
+    pimpl_->packetQueue.setMemoryPressure(percent);
+
+    if (percent != pimpl_->pressurePercent) {
+        pimpl_->pressurePercent = percent;
+        emit memoryPressureChanged(used, budget);
+    }
+}
+
 const cs::TransactionsPacketTable& cs::ConveyerBase::transactionsPacketTable() const {
     return pimpl_->packetsTable;
 }
@@ -171,19 +486,19 @@ std::optional<std::pair<cs::TransactionsPacket, cs::PacketsVector>> cs::Conveyer
     cs::TransactionsPacketTable& table = pimpl_->packetsTable;
 
     for (const auto& hash : hashes) {
-        const auto iterator = table.find(hash);
+        const cs::TransactionsPacket* tablePacket = table.find(hash);
 
-        if (iterator == table.end()) {
+        if (tablePacket == nullptr) {
             cswarning() << csname() << "packet creation hash not found";
             return std::nullopt;
         }
 
         // to smarts
-        if (iterator->second.signatures().size() > smartContractDetector) {
-            smartContractPackets.push_back(iterator->second);
+        if (tablePacket->signatures().size() > smartContractDetector) {
+            smartContractPackets.push_back(*tablePacket);
         }
 
-        const auto& transactions = iterator->second.transactions();
+        const auto& transactions = tablePacket->transactions();
 
         for (const auto& transaction : transactions) {
             if (!packet.addTransaction(transaction)) {
@@ -231,7 +546,7 @@ void cs::ConveyerBase::setTable(const RoundTable& table) {
     {
         cs::SharedLock lock(sharedMutex_);
         std::copy_if(hashes.begin(), hashes.end(), std::back_inserter(neededHashes), [this](const auto& hash) {
-            return (pimpl_->packetsTable.count(hash) == 0u);
+            return !pimpl_->packetsTable.contains(hash);
         });
     }
 
@@ -257,6 +572,36 @@ void cs::ConveyerBase::setTable(const RoundTable& table) {
         else {
             csfatal() << csname() << "Meta round currently in conveyer";
         }
+
+        // history-driven pre-sizing: remember how full the live table was at
+        // recent round switches and grow the shards to the p90 of that now,
+        // so no shard rehash lands in the middle of the coming round's ingest
+        if (pimpl_->packetHistory.full()) {
+            pimpl_->packetHistory.pop_front();
+        }
+        pimpl_->packetHistory.push_back(pimpl_->packetsTable.size());
+        pimpl_->shardedTable.reserve(pimpl_->expectedRoundPackets());
+
+        // speculative pre-build of the round storage table: every packet named by the
+        // table that already sits in the live table is staged here, at round start,
+        // so applying the characteristic later only fixes up late arrivals instead
+        // of assembling the whole storage table on the round-critical path
+        cs::ConveyerMeta* meta = pimpl_->metaStorage.get(table.round);
+
+        if (meta != nullptr) {
+            // the table never holds more than the round names, one allocation up front
+            meta->hashTable.reserve(meta->roundTable.hashes.size());
+
+            for (const auto& hash : meta->roundTable.hashes) {
+                const cs::TransactionsPacket* packet = pimpl_->packetsTable.find(hash);
+
+                if (packet != nullptr) {
+                    meta->hashTable.emplace(hash, *packet);
+                }
+            }
+        }
+
+        enforceMemoryBudget();
     }
 
     csmeta(csdebug) << "done, current table size " << pimpl_->packetsTable.size();
@@ -337,6 +682,12 @@ const cs::PacketsHashes* cs::ConveyerBase::neededHashes(cs::RoundNumber round) c
 }
 
 void cs::ConveyerBase::addFoundPacket(cs::RoundNumber round, cs::TransactionsPacket&& packet) {
+    if (!isRoundInAcceptanceWindow(round)) {
+        csdebug() << csname() << "Ignore sync packet for out-of-window round " << round
+                  << ", current round " << currentRoundNumber();
+        return;
+    }
+
     cs::Lock lock(sharedMutex_);
 
     cs::ConveyerMeta* metaPointer = pimpl_->metaStorage.get(round);
@@ -362,7 +713,17 @@ void cs::ConveyerBase::addFoundPacket(cs::RoundNumber round, cs::TransactionsPac
 
         // add to current table
         auto hash = packet.hash();
+
+        if (tablePointer == &pimpl_->packetsTable) {
+            pimpl_->shardedTable.append(hash, packet);
+
+            // keep the speculative round storage table complete, see setTable()
+            metaPointer->hashTable.emplace(hash, packet);
+        }
+
         tablePointer->emplace(std::move(hash), std::move(packet));
+
+        enforceMemoryBudget();
     }
 }
 
@@ -447,7 +808,8 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
         return std::nullopt;
     }
 
-    cs::TransactionsPacketTable hashTable;
+    // mostly pre-built speculatively at setTable(), only late arrivals are added here
+    cs::TransactionsPacketTable& hashTable = meta->hashTable;
     const cs::PacketsHashes& localHashes = meta->roundTable.hashes;
     const cs::Characteristic& characteristic = meta->characteristic;
     cs::TransactionsPacketTable& currentHashTable = poolTable(round);
@@ -470,16 +832,22 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
     bool isStateRejected = false;
 
     for (const auto& hash : localHashes) {
-        // try to get from meta if can
-        auto optionalPacket = findPacket(hash, round);
+        const cs::TransactionsPacket* staged = hashTable.find(hash);
 
-        if (!optionalPacket.has_value()) {
-            csmeta(cserror) << "hash not found " << hash.toString() << ", strange behaviour detected";
-            removeHashesFromTable(localHashes);
-            return std::nullopt;
+        if (staged == nullptr) {
+            // fix-up pass: the packet arrived after the round table was set
+            auto optionalPacket = findPacket(hash, round);
+
+            if (!optionalPacket.has_value()) {
+                csmeta(cserror) << "hash not found " << hash.toString() << ", strange behaviour detected";
+                removeHashesFromTable(localHashes);
+                return std::nullopt;
+            }
+
+            staged = hashTable.emplace(hash, std::move(optionalPacket).value()).first;
         }
 
-        auto packet = std::move(optionalPacket).value();
+        const cs::TransactionsPacket& packet = *staged;
         const auto& transactions = packet.transactions();
 
         // first look at signatures if it is smarts packet
@@ -518,28 +886,35 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
             }
         }
 
-        // look all next transactions
-        for (const auto& transaction : transactions) {
-            if (maskIndex < mask.size()) {
-                if (mask[maskIndex] != 0u) {
-                    newPool.add_transaction(transaction);
-                }
-                else {
-                    invalidTransactions.addTransaction(transaction);
+        // look all next transactions: split the packet mask into runs of accepted and
+        // rejected transactions, accepted runs are appended to the pool in bulk
+        const size_t available = maskIndex < mask.size() ? std::min(transactions.size(), mask.size() - maskIndex) : 0;
+        const cs::Byte* packetMask = mask.data() + maskIndex;
+        size_t position = 0;
+
+        while (position < available) {
+            const bool accepted = packetMask[position] != 0u;
+            const size_t runEnd = maskRunEnd(packetMask, position, available, accepted);
+
+            if (accepted) {
+                newPool.add_transactions(transactions.begin() + static_cast<std::ptrdiff_t>(position), transactions.begin() + static_cast<std::ptrdiff_t>(runEnd));
+            }
+            else {
+                for (size_t index = position; index < runEnd; ++index) {
+                    invalidTransactions.addTransaction(transactions[index]);
                 }
             }
 
-            ++maskIndex;
+            position = runEnd;
         }
 
+        maskIndex += transactions.size();
+
         if (maskIndex > mask.size()) {
             csmeta(cserror) << "hash failed, mask size: " << mask.size() << " mask index: " << maskIndex;
             removeHashesFromTable(localHashes);
             return std::nullopt;
         }
-
-        // create storage hash table and remove from current hash table
-        hashTable.emplace(hash, std::move(packet));
     }
 
     // remove current hashes from table
@@ -549,8 +924,7 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
         emit transactionsRejected(invalidTransactions);
     }
 
-    // add current round hashes to storage
-    meta->hashTable = std::move(hashTable);
+    // current round hashes already live in meta->hashTable, staged above
     meta->invalidTransactions = std::move(invalidTransactions);
 
     if (characteristic.mask.size() != newPool.transactions_count()) {
@@ -582,8 +956,8 @@ std::optional<csdb::Pool> cs::ConveyerBase::applyCharacteristic(const cs::PoolMe
 }
 
 std::optional<cs::TransactionsPacket> cs::ConveyerBase::findPacket(const cs::TransactionsPacketHash& hash, const RoundNumber round) const {
-    if (auto iterator = pimpl_->packetsTable.find(hash); iterator != pimpl_->packetsTable.end()) {
-        return iterator->second;
+    if (auto packet = pimpl_->shardedTable.find(hash); packet.has_value()) {
+        return packet;
     }
 
     cs::ConveyerMeta* meta = pimpl_->metaStorage.get(round);
@@ -592,10 +966,8 @@ std::optional<cs::TransactionsPacket> cs::ConveyerBase::findPacket(const cs::Tra
         return std::nullopt;
     }
 
-    const auto& value = meta->hashTable;
-
-    if (auto iter = value.find(hash); iter != value.end()) {
-        return iter->second;
+    if (const cs::TransactionsPacket* packet = meta->hashTable.find(hash); packet != nullptr) {
+        return *packet;
     }
 
     return std::nullopt;
@@ -620,21 +992,159 @@ bool cs::ConveyerBase::isMetaTransactionInvalid(int64_t id) {
 
 size_t cs::ConveyerBase::packetQueueTransactionsCount() const {
     cs::SharedLock lock(sharedMutex_);
-    size_t count = 0;
+    return pimpl_->packetQueue.transactionsCount();
+}
 
-    auto begin = pimpl_->packetQueue.begin();
-    auto end = pimpl_->packetQueue.end();
+size_t cs::ConveyerBase::packetsTableSize() const {
+    return pimpl_->shardedTable.size();
+}
 
-    std::for_each(begin, end, [&](const auto& packet) {
-        count += packet.transactionsCount();
-    });
+size_t cs::ConveyerBase::cachedBytes() const {
+    cs::SharedLock lock(sharedMutex_);
+    return pimpl_->cachedBytes();
+}
 
-    return count;
+std::optional<cs::TransactionsPacket> cs::ConveyerBase::findPacketInCurrentTable(const cs::TransactionsPacketHash& hash) const {
+    return pimpl_->shardedTable.find(hash);
 }
 
-size_t cs::ConveyerBase::packetsTableSize() const {
-    cs::SharedLock lock(sharedMutex_);
-    return pimpl_->packetsTable.size();
+bool cs::ConveyerBase::isPacketInCurrentTable(const cs::TransactionsPacketHash& hash) const {
+    return pimpl_->shardedTable.contains(hash);
+}
+
+std::optional<cs::PacketDigest> cs::ConveyerBase::makePacketDigest(const cs::TransactionsPacketHash& hash, cs::RoundNumber round) const {
+    std::optional<cs::TransactionsPacket> packet = findPacket(hash, round);
+
+    if (!packet.has_value() || packet.value().isSmart()) {
+        return std::nullopt;
+    }
+
+    cs::PacketDigest digest;
+    digest.hash = packet.value().hash();
+    digest.expiredRound = packet.value().expiredRound();
+    digest.signatures = packet.value().signatures();
+    digest.fingerprints.reserve(packet.value().transactionsCount());
+
+    for (const auto& transaction : packet.value().transactions()) {
+        digest.fingerprints.push_back(cs::TransactionsPacket::transactionFingerprint(transaction));
+    }
+
+    return digest;
+}
+
+std::pair<cs::PacketsVector, cs::PacketsHashes> cs::ConveyerBase::assembleFromDigests(const cs::PacketDigests& digests) const {
+    cs::PacketsVector packets;
+    cs::PacketsHashes missing;
+
+    // fingerprint index over every transaction the current table already holds
+    std::unordered_map<uint64_t, const csdb::Transaction*> index;
+
+    for (const auto& [hash, packet] : pimpl_->packetsTable) {
+        csunused(hash);
+
+        for (const auto& transaction : packet.transactions()) {
+            index.emplace(cs::TransactionsPacket::transactionFingerprint(transaction), &transaction);
+        }
+    }
+
+    for (const auto& digest : digests) {
+        cs::TransactionsPacket packet;
+        packet.setExpiredRound(digest.expiredRound);
+        packet.reserve(digest.fingerprints.size());
+
+        bool complete = true;
+
+        for (const auto fingerprint : digest.fingerprints) {
+            const auto iter = index.find(fingerprint);
+
+            if (iter == index.end()) {
+                complete = false;
+                break;
+            }
+
+            packet.addTransaction(*iter->second);
+        }
+
+        if (complete) {
+            packet.makeHash();
+        }
+
+        // the rebuilt packet must reproduce the digested hash exactly
+        if (!complete || packet.hash() != digest.hash) {
+            missing.push_back(digest.hash);
+            continue;
+        }
+
+        for (const auto& [signatureIndex, signature] : digest.signatures) {
+            packet.addSignature(signatureIndex, signature);
+        }
+
+        packets.push_back(std::move(packet));
+    }
+
+    return std::make_pair(std::move(packets), std::move(missing));
+}
+
+std::optional<cs::Bytes> cs::ConveyerBase::makeHashIndexMask(cs::RoundNumber round, const cs::PacketsHashes& hashes) const {
+    cs::ConveyerMeta* meta = pimpl_->metaStorage.get(round);
+
+    if (meta == nullptr) {
+        return std::nullopt;
+    }
+
+    const cs::PacketsHashes& tableHashes = meta->roundTable.hashes;
+
+    if (tableHashes.empty() || hashes.empty()) {
+        return std::nullopt;
+    }
+
+    std::unordered_map<cs::TransactionsPacketHash, size_t> indices;
+    indices.reserve(tableHashes.size());
+
+    for (size_t i = 0; i < tableHashes.size(); ++i) {
+        indices.emplace(tableHashes[i], i);
+    }
+
+    cs::Bytes mask((tableHashes.size() + 7) / 8, 0);
+
+    for (const auto& hash : hashes) {
+        const auto it = indices.find(hash);
+
+        if (it == indices.end()) {
+            // a hash outside the table can not be indexed, caller falls back
+            // to the explicit list
+            return std::nullopt;
+        }
+
+        mask[it->second / 8] |= static_cast<cs::Byte>(1u << (it->second % 8));
+    }
+
+    return mask;
+}
+
+cs::PacketsHashes cs::ConveyerBase::resolveHashIndexMask(cs::RoundNumber round, const cs::Bytes& mask) const {
+    cs::PacketsHashes hashes;
+    cs::ConveyerMeta* meta = pimpl_->metaStorage.get(round);
+
+    if (meta == nullptr) {
+        return hashes;
+    }
+
+    const cs::PacketsHashes& tableHashes = meta->roundTable.hashes;
+
+    // a length mismatch means the peers disagree on the table, an answer built
+    // from wrong indices would only waste the reply traffic
+    if (tableHashes.empty() || mask.size() != (tableHashes.size() + 7) / 8) {
+        return hashes;
+    }
+
+    for (size_t i = 0; i < tableHashes.size(); ++i) {
+        if (0 != (mask[i / 8] & (1u << (i % 8)))) {
+            hashes.push_back(tableHashes[i]);
+        }
+    }
+
+    return hashes;
 }
 
 std::unique_lock<cs::SharedMutex> cs::ConveyerBase::lock() const {
@@ -642,37 +1152,131 @@ std::unique_lock<cs::SharedMutex> cs::ConveyerBase::lock() const {
 }
 
 void cs::ConveyerBase::flushTransactions() {
+    flushQueue(std::chrono::milliseconds(cs::ConfigHolder::instance().config()->conveyerData().packetCoalesceTimeMs));
+}
+
+void cs::ConveyerBase::scheduleEarlyFlushIfWatermarked() {
+    const auto& data = cs::ConfigHolder::instance().config()->conveyerData();
+    const size_t transactionsWatermark = data.earlyFlushTransactions;
+    const size_t bytesWatermark = data.earlyFlushKb * 1024;
+
+    const bool crossed = (transactionsWatermark != 0 && pimpl_->packetQueue.transactionsCount() >= transactionsWatermark) ||
+                         (bytesWatermark != 0 && pimpl_->packetQueue.bytesCount() >= bytesWatermark);
+
+    if (!crossed || currentRoundNumber() <= cs::TransactionsFlushRound) {
+        return;
+    }
+
+    // single flight: one posted flush drains the backlog, later crossings
+    // re-arm after it ran
+    if (pimpl_->earlyFlushScheduled.exchange(true)) {
+        return;
+    }
+
+    csdebug() << csname() << "packet queue watermark crossed, flushing ahead of the sending timer";
+
+    // the conveyer is locked here, the flush itself relocks on a pool thread;
+    // zero coalesce window, the watermark already proved the backlog is worth a packet
+    boost::asio::post(cs::ThreadPool::instance(), [this] {
+        pimpl_->earlyFlushScheduled = false;
+        flushQueue(std::chrono::milliseconds{0});
+    });
+}
+
+void cs::ConveyerBase::flushQueue(std::chrono::milliseconds coalesceWindow) {
+    static cs::LatencyHistogram& histogram = cs::Metrics::instance().histogram("conveyer_flush_us");
+    cs::MetricsTimer timer(histogram);
+
     cs::Lock lock(sharedMutex_);
 
-    auto packets = pimpl_->packetQueue.pop();
+    auto packets = pimpl_->packetQueue.pop(coalesceWindow);
     auto round = currentRoundNumber();
 
-    for (auto& packet : packets) {
-        if ((packet.transactionsCount() != 0u)) {
-            // set max round for no setupped packets
-            if (!packet.expiredRound()) {
-                packet.setExpiredRound(round + cs::ConfigHolder::instance().config()->conveyerData().maxPacketLifeTime);
+    enum : uint8_t {
+        PacketSkipped,
+        PacketReady,
+        PacketHashFailed,
+        PacketSignFailed
+    };
+
+    auto preparePacket = [this, round](cs::TransactionsPacket& packet) -> uint8_t {
+        if (packet.transactionsCount() == 0u) {
+            return PacketSkipped;
+        }
+
+        // set max round for no setupped packets
+        if (!packet.expiredRound()) {
+            packet.setExpiredRound(round + cs::ConfigHolder::instance().config()->conveyerData().maxPacketLifeTime);
+        }
+
+        if (packet.isHashEmpty()) {
+            if (!packet.makeHash()) {
+                return PacketHashFailed;
             }
+        }
 
-            if (packet.isHashEmpty()) {
-                if (!packet.makeHash()) {
-                    cserror() << csname() << "Transaction packet hashing failed";
-                    continue;
-                }
+        if (packet.signatures().empty()) {
+            if (!packet.sign(pimpl_->privateKey)) {
+                return PacketSignFailed;
             }
+        }
+
+        return PacketReady;
+    };
 
-            if (packet.signatures().empty()) {
-                if (!packet.sign(pimpl_->privateKey)) {
-                    cswarning() << "Can not sign unsigned transaction packet, drop";
-                    break;
+    // hashing and signing dominate the flush and are independent per packet,
+    // run them on the thread pool; packets stay local, only the ordered
+    // bookkeeping below touches shared state
+    const size_t packetsCount = packets.size();
+    std::vector<uint8_t> states(packetsCount, PacketSkipped);
+
+    if (packetsCount > 1 && std::thread::hardware_concurrency() > 1) {
+        std::atomic<size_t> jobsLeft = packetsCount;
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+
+        for (size_t i = 0; i < packetsCount; ++i) {
+            boost::asio::post(cs::ThreadPool::instance(), [&, i] {
+                states[i] = preparePacket(packets[i]);
+
+                if (jobsLeft.fetch_sub(1) == 1) {
+                    cs::Lock doneLock(doneMutex);
+                    doneCondition.notify_one();
                 }
-            }
+            });
+        }
 
-            emit packetFlushed(packet);
+        std::unique_lock<std::mutex> doneLock(doneMutex);
+        doneCondition.wait(doneLock, [&] { return jobsLeft.load() == 0; });
+    }
+    else {
+        for (size_t i = 0; i < packetsCount; ++i) {
+            states[i] = preparePacket(packets[i]);
+        }
+    }
+
+    // completions are applied in flush order, exactly as the serial loop did
+    for (size_t i = 0; i < packetsCount; ++i) {
+        if (states[i] == PacketSkipped) {
+            continue;
+        }
+
+        if (states[i] == PacketHashFailed) {
+            cserror() << csname() << "Transaction packet hashing failed";
+            continue;
+        }
 
-            addPacketToMeta(packet);
+        if (states[i] == PacketSignFailed) {
+            cswarning() << "Can not sign unsigned transaction packet, drop";
+            break;
         }
+
+        emit packetFlushed(packets[i]);
+
+        addPacketToMeta(packets[i]);
     }
+
+    enforceMemoryBudget();
 }
 
 void cs::ConveyerBase::onRoundChanged(cs::RoundNumber round) {
@@ -699,6 +1303,7 @@ void cs::ConveyerBase::onRoundChanged(cs::RoundNumber round) {
             const auto& hash = packet.hash();
 
             pimpl_->packetsTable.erase(hash);
+            pimpl_->shardedTable.remove(hash);
 
             emit packetExpired(packet);
         }
@@ -714,6 +1319,7 @@ void cs::ConveyerBase::addPacketToMeta(cs::TransactionsPacket& packet) {
 
     if (!isPacketAtCache(packet)) {
         csdebug() << "Adding packet with hash: " << hash.toString();
+        pimpl_->shardedTable.append(hash, packet);
         pimpl_->packetsTable.emplace(std::move(hash), std::move(packet));
     }
     else {
@@ -730,17 +1336,13 @@ void cs::ConveyerBase::changeRound(cs::RoundNumber round) {
 }
 
 std::optional<cs::TransactionsPacket> cs::ConveyerBase::findPacketAtMeta(const cs::TransactionsPacketHash& hash) const {
-    auto iter = pimpl_->packetsTable.find(hash);
-
-    if (iter != pimpl_->packetsTable.end()) {
-        return iter->second;
+    if (const cs::TransactionsPacket* packet = pimpl_->packetsTable.find(hash); packet != nullptr) {
+        return *packet;
     }
 
     for (const auto& element : pimpl_->metaStorage) {
-        auto metaIter = element.meta.hashTable.find(hash);
-
-        if (metaIter != element.meta.hashTable.end()) {
-            return metaIter->second;
+        if (const cs::TransactionsPacket* packet = element.meta.hashTable.find(hash); packet != nullptr) {
+            return *packet;
         }
     }
 
@@ -748,16 +1350,12 @@ std::optional<cs::TransactionsPacket> cs::ConveyerBase::findPacketAtMeta(const c
 }
 
 bool cs::ConveyerBase::isPacketAtMeta(const cs::TransactionsPacketHash& hash) const {
-    auto iter = pimpl_->packetsTable.find(hash);
-
-    if (iter != pimpl_->packetsTable.end()) {
+    if (pimpl_->packetsTable.contains(hash)) {
         return true;
     }
 
     for (const auto& element : pimpl_->metaStorage) {
-        auto metaIter = element.meta.hashTable.find(hash);
-
-        if (metaIter != element.meta.hashTable.end()) {
+        if (element.meta.hashTable.contains(hash)) {
             return true;
         }
     }
@@ -770,6 +1368,7 @@ void cs::ConveyerBase::removeHashesFromTable(const cs::PacketsHashes& hashes) {
     for (const auto& hash : hashes) {
         csdetails() << csname() << " remove hash " << hash.toString();
         pimpl_->packetsTable.erase(hash);
+        pimpl_->shardedTable.remove(hash);
     }
 }
 
@@ -789,16 +1388,13 @@ cs::TransactionsPacketTable& cs::ConveyerBase::poolTable(cs::RoundNumber round)
 
 bool cs::ConveyerBase::isPacketAtCache(const cs::TransactionsPacket& packet) {
     auto hash = packet.hash();
-    auto iter = pimpl_->packetsTable.find(hash);
 
-    if (iter != pimpl_->packetsTable.end()) {
+    if (pimpl_->packetsTable.contains(hash)) {
         return true;
     }
 
     for (const auto& element : pimpl_->metaStorage) {
-        auto metaIter = element.meta.hashTable.find(hash);
-
-        if (metaIter != element.meta.hashTable.end()) {
+        if (element.meta.hashTable.contains(hash)) {
             return true;
         }
     }
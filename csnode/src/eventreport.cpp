@@ -385,3 +385,60 @@ bool EventReport::parseRunningStatus(const cs::Bytes& bin_pack, Running::Status&
     in >> status;
     return in.isValid() && in.isEmpty();
 }
+
+/*static*/
+void EventReport::sendRoundStallTrace(Node& node, cs::RoundNumber round, uint64_t durationMs, const std::vector<cs::StackSampler::Sample>& samples) {
+    const auto& config = cs::ConfigHolder::instance().config()->getEventsReportData();
+    if (!config.is_active || !config.round_stall_trace) {
+        return;
+    }
+    if (samples.empty()) {
+        return;
+    }
+
+    // a sample is at most a short name plus kMaxFrames addresses, so this
+    // keeps the whole report within a single network message
+    constexpr size_t kMaxReportSamples = 100;
+    const size_t stride = samples.size() > kMaxReportSamples ? (samples.size() + kMaxReportSamples - 1) / kMaxReportSamples : 1;
+    const uint16_t count = static_cast<uint16_t>((samples.size() + stride - 1) / stride);
+
+    cs::Bytes bin_pack;
+    cs::ODataStream out(bin_pack);
+    out << Id::RoundStallTrace << round << durationMs << count;
+
+    // even-stride thinning preserves the capture's time coverage, unlike
+    // cutting off the tail
+    for (size_t i = 0; i < samples.size(); i += stride) {
+        const auto& sample = samples[i];
+        out << sample.thread << sample.offsetMs << sample.frames;
+    }
+
+    cslog() << log_prefix << "send stall trace of round " << round << ", " << count << " stack samples";
+    node.reportEvent(bin_pack);
+}
+
+/*static*/
+bool EventReport::parseRoundStallTrace(const cs::Bytes& bin_pack, cs::RoundNumber& round, uint64_t& durationMs, std::vector<cs::StackSampler::Sample>& samples) {
+    if (bin_pack.empty()) {
+        return false;
+    }
+    cs::IDataStream in(bin_pack.data(), bin_pack.size());
+    Id id = Id::None;
+    in >> id;
+    if (id != Id::RoundStallTrace) {
+        return false;
+    }
+
+    uint16_t count = 0;
+    in >> round >> durationMs >> count;
+
+    samples.clear();
+    samples.reserve(count);
+    for (uint16_t i = 0; i < count && in.isValid(); ++i) {
+        cs::StackSampler::Sample sample;
+        in >> sample.thread >> sample.offsetMs >> sample.frames;
+        samples.push_back(std::move(sample));
+    }
+
+    return in.isValid() && in.isEmpty() && samples.size() == count;
+}
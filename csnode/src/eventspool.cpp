@@ -0,0 +1,143 @@
+#include <csnode/eventspool.hpp>
+
+#include <lib/system/logger.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace cs {
+
+EventSpool::EventSpool(Shipper shipper)
+: shipper_(std::move(shipper)) {
+    for (size_t i = 0; i < kCapacity; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+EventSpool::~EventSpool() {
+    stop();
+}
+
+void EventSpool::start() {
+    if (!stopped_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    lastRefill_ = std::chrono::steady_clock::now();
+    lastDropLog_ = lastRefill_;
+    thread_ = std::thread(&EventSpool::routine, this);
+}
+
+void EventSpool::stop() {
+    if (stopped_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    stopCv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    const auto dropped = droppedCount();
+    if (dropped != 0) {
+        cslog() << "EVENTS> reports dropped by spool: " << dropped;
+    }
+}
+
+bool EventSpool::enqueue(cs::Bytes&& binPack) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring_[pos & (kCapacity - 1)];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.pack = std::move(binPack);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+            // pos reloaded by the failed CAS, retry
+        }
+        else if (diff < 0) {
+            // ring is full, the consumer has not freed this slot yet
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool EventSpool::dequeue(cs::Bytes& binPack) {
+    Slot& slot = ring_[dequeuePos_ & (kCapacity - 1)];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != dequeuePos_ + 1) {
+        return false;
+    }
+    binPack = std::move(slot.pack);
+    slot.pack.clear();
+    slot.pack.shrink_to_fit();
+    slot.sequence.store(dequeuePos_ + kCapacity, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+}
+
+void EventSpool::routine() {
+    while (!stopped_.load(std::memory_order_acquire)) {
+        {
+            std::unique_lock lock(stopMux_);
+            stopCv_.wait_for(lock, kFlushPeriod, [this]() {
+                return stopped_.load(std::memory_order_acquire);
+            });
+        }
+        flush();
+    }
+    // ship what producers managed to append before the stop
+    flush();
+}
+
+void EventSpool::flush() {
+    std::vector<cs::Bytes> batch;
+    cs::Bytes pack;
+    while (dequeue(pack)) {
+        batch.push_back(std::move(pack));
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    tokens_ += std::chrono::duration<double>(now - lastRefill_).count() * kMaxEventsPerSecond;
+    if (tokens_ > double(kMaxBurst)) {
+        tokens_ = double(kMaxBurst);
+    }
+    lastRefill_ = now;
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        // collapse byte-identical repeats within the batch: incident storms
+        // tend to re-emit the same ban or consensus problem many times
+        bool repeated = false;
+        for (size_t j = 0; j < i; ++j) {
+            if (batch[j] == batch[i]) {
+                repeated = true;
+                break;
+            }
+        }
+        if (repeated) {
+            continue;
+        }
+        if (tokens_ < 1.0) {
+            droppedCount_.fetch_add(batch.size() - i, std::memory_order_relaxed);
+            break;
+        }
+        tokens_ -= 1.0;
+        shipper_(batch[i]);
+    }
+
+    const auto dropped = droppedCount();
+    if (dropped != reportedDropped_ && now - lastDropLog_ >= kDropLogPeriod) {
+        cswarning() << "EVENTS> " << dropped - reportedDropped_ << " event report(s) dropped, " << dropped << " total";
+        reportedDropped_ = dropped;
+        lastDropLog_ = now;
+    }
+}
+
+}  // namespace cs
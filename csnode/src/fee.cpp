@@ -1,7 +1,14 @@
 #include "csnode/fee.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <tuple>
 
+#include <lib/system/concurrent.hpp>
+
 #include <solver/smartcontracts.hpp>
 
 namespace cs {
@@ -89,11 +96,52 @@ bool estimateMaxFee(const csdb::Transaction& t, csdb::AmountCommission& countedF
 }
 
 void setCountedFees(Transactions& trxs) {
-    for (auto& t : trxs) {
-        if (!cs::SmartContracts::is_new_state(t)) {
-            t.set_counted_fee(getFee(t));
+    const size_t transactionsCount = trxs.size();
+    const size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    // getFee() serializes every transaction to measure it, large packets are worth sharding
+    const size_t maxSingleThreadCountingLimit = 100;
+
+    if (transactionsCount <= maxSingleThreadCountingLimit || cores == 1) {
+        for (auto& t : trxs) {
+            if (!cs::SmartContracts::is_new_state(t)) {
+                t.set_counted_fee(getFee(t));
+            }
         }
+        return;
+    }
+
+    size_t threadTrxCount = transactionsCount / cores;
+    if (transactionsCount % cores != 0) {
+        ++threadTrxCount;
+    }
+
+    // counting shards run on the shared pool, each writes its own index range only
+    std::atomic<size_t> jobsLeft = cores;
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    for (size_t thCounter = 0; thCounter < cores; ++thCounter) {
+        boost::asio::post(cs::ThreadPool::instance(), [&, thCounter] {
+            const size_t first = thCounter * threadTrxCount;
+            const size_t last = std::min(first + threadTrxCount, transactionsCount);
+            for (size_t i = first; i < last; ++i) {
+                auto& t = trxs[i];
+                if (!cs::SmartContracts::is_new_state(t)) {
+                    t.set_counted_fee(getFee(t));
+                }
+            }
+
+            if (jobsLeft.fetch_sub(1) == 1) {
+                cs::Lock lock(doneMutex);
+                doneCondition.notify_one();
+            }
+        });
     }
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(lock, [&] {
+        return jobsLeft.load() == 0;
+    });
 }
 
 csdb::Amount getExecutionFee(long long duration_mcs) {
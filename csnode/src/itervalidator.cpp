@@ -1,7 +1,10 @@
 #include <csnode/itervalidator.hpp>
 
+#include <condition_variable>
 #include <cstring>
 
+#include <lib/system/concurrent.hpp>
+
 #include <csdb/amount_commission.hpp>
 #include <csnode/fee.hpp>
 #include <csnode/walletsstate.hpp>
@@ -33,7 +36,8 @@ Characteristic IterValidator::formCharacteristic(SolverContext& context, Transac
     do {
         csdebug() << kLogPrefix << "current iteration: " << iterationCounter;
         context.blockchain().setTransactionsFees(transactions, characteristic.mask);
-        context.wallets().updateFromSource();
+        // one pass over WalletsCache per iteration instead of lock round-trips per transaction
+        context.wallets().roundSnapshot(transactions);
         pTransval_->reset(transactions.size());
         needNewIteration = validateTransactions(context, characteristic.mask, transactions);
         ++iterationCounter;
@@ -236,41 +240,42 @@ void IterValidator::checkTransactionsSignatures(SolverContext& context, const Tr
 
 
     rCounter_ = 0;
-    int cores = std::thread::hardware_concurrency();
-    size_t maxSingleThreadValidationLimit = 100;
-    size_t threadTrxCount = transactionsCount;
-    bool multiThread = false;
-    if (transactionsCount > maxSingleThreadValidationLimit) {
-        threadTrxCount = transactionsCount / cores;
-        if (transactionsCount % cores != 0) {
-            ++threadTrxCount;
-        }
-        multiThread = true;
-    }
-    std::vector<std::thread> threadsVector;
-    size_t numCores = multiThread ? cores : 1;
-    csdebug() << "Available cores: " << numCores;
+    const size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t maxSingleThreadValidationLimit = 100;
+    csdebug() << "Available cores: " << cores;
     csdebug() << "Checking transactions: " << transactionsCount;
-    if (!multiThread) {
-        checkSignatures(transactions, characteristicMask, threadTrxCount, 0);
+    if (transactionsCount <= maxSingleThreadValidationLimit || cores == 1) {
+        checkSignatures(transactions, characteristicMask, transactionsCount, 0);
     }
     else {
-        for (size_t thCounter = 0; thCounter < numCores; ++thCounter) {
-            std::thread thr(&IterValidator::checkSignatures, this, transactions, std::ref(characteristicMask), threadTrxCount, thCounter);
-            threadsVector.emplace_back(std::move(thr));
+        size_t threadTrxCount = transactionsCount / cores;
+        if (transactionsCount % cores != 0) {
+            ++threadTrxCount;
         }
-        for (auto& thr : threadsVector) {
-            thr.join();
+
+        // verification shards run on the shared pool, no thread spawn and no
+        // per-thread copy of the transactions vector
+        std::atomic<size_t> jobsLeft = cores;
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+
+        for (size_t thCounter = 0; thCounter < cores; ++thCounter) {
+            boost::asio::post(cs::ThreadPool::instance(), [&, thCounter] {
+                checkSignatures(transactions, characteristicMask, threadTrxCount, thCounter);
+
+                if (jobsLeft.fetch_sub(1) == 1) {
+                    cs::Lock lock(doneMutex);
+                    doneCondition.notify_one();
+                }
+            });
         }
 
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCondition.wait(lock, [&] {
+            return jobsLeft.load() == 0;
+        });
     }
-    size_t tmpCounter = 0;
-    {
-        /*sMutex_.lock();*/
-        //std::lock_guard<std::mutex> guard(sMutex_);
-        tmpCounter = rCounter_;
-        /*sMutex_.unlock();*/
-    }
+    size_t tmpCounter = rCounter_;
     if (tmpCounter) {
         for (size_t i = 0; i < transactionsCount; ++i) {
             if (characteristicMask[i] == Reject::Reason::WrongSignature) {
@@ -6,27 +6,43 @@
 #include <csnode/configholder.hpp>
 
 bool cs::MultiWallets::contains(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    cs::SharedLock lock(mutex_);
 
     auto& byKey = indexes_.get<Tags::ByPublicKey>();
     return byKey.find(key) != byKey.end();
 }
 
 size_t cs::MultiWallets::size() const {
-    cs::Lock lock(mutex_);
+    cs::SharedLock lock(mutex_);
     return indexes_.size();
 }
 
 csdb::Amount cs::MultiWallets::balance(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    cs::SharedLock lock(mutex_);
 
     auto& keys = indexes_.get<Tags::ByPublicKey>();
     auto it = keys.find(key);
     return it == keys.end() ? csdb::Amount(0) : it->balance_;
 }
 
+std::vector<csdb::Amount> cs::MultiWallets::balances(const std::vector<cs::PublicKey>& keys) const {
+    cs::SharedLock lock(mutex_);
+
+    auto& byKey = indexes_.get<Tags::ByPublicKey>();
+
+    std::vector<csdb::Amount> result;
+    result.reserve(keys.size());
+
+    for (const auto& key : keys) {
+        auto it = byKey.find(key);
+        result.push_back(it == byKey.end() ? csdb::Amount(0) : it->balance_);
+    }
+
+    return result;
+}
+
 uint64_t cs::MultiWallets::transactionsCount(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    cs::SharedLock lock(mutex_);
 
     auto& keys = indexes_.get<Tags::ByPublicKey>();
     auto it = keys.find(key);
@@ -35,7 +51,7 @@ uint64_t cs::MultiWallets::transactionsCount(const cs::PublicKey& key) const {
 
 #ifdef MONITOR_NODE
 uint64_t cs::MultiWallets::createTime(const cs::PublicKey& key) const {
-    cs::Lock lock(mutex_);
+    cs::SharedLock lock(mutex_);
 
     auto& keys = indexes_.get<Tags::ByPublicKey>();
     auto it = keys.find(key);
@@ -44,7 +60,7 @@ uint64_t cs::MultiWallets::createTime(const cs::PublicKey& key) const {
 #endif
 
 bool cs::MultiWallets::getWalletData(cs::MultiWallets::InternalData& data) const {
-  cs::Lock lock(mutex_);
+  cs::SharedLock lock(mutex_);
 
   auto& keys = indexes_.get<Tags::ByPublicKey>();
 
@@ -78,7 +94,7 @@ void cs::MultiWallets::onWalletCacheUpdated(const cs::WalletsCache::WalletData&
 }
 
 void cs::MultiWallets::iterate(std::function<bool(const PublicKey& key, const InternalData& data)> func) {
-    cs::Lock lock(mutex_);
+    cs::SharedLock lock(mutex_);
     for (auto it = indexes_.begin(); it != indexes_.end(); ++it) {
         if (!func(it->key_, *it)) {
             break;
@@ -86,8 +102,24 @@ void cs::MultiWallets::iterate(std::function<bool(const PublicKey& key, const In
     }
 }
 
+std::vector<cs::MultiWallets::InternalData> cs::MultiWallets::nextBatch(const PublicKey& after, size_t limit, bool fromStart) const {
+    cs::SharedLock lock(mutex_);
+
+    auto& byKey = indexes_.get<Tags::ByKeyOrdered>();
+    auto iter = fromStart ? byKey.begin() : byKey.upper_bound(after);
+
+    std::vector<InternalData> result;
+    result.reserve(std::min(limit, byKey.size()));
+
+    for (; iter != byKey.end() && result.size() < limit; ++iter) {
+        result.push_back(*iter);
+    }
+
+    return result;
+}
+
 csdb::Amount cs::MultiWallets::checkWallets() {
-    cs::Lock lock(mutex_);
+    cs::SharedLock lock(mutex_);
     csdb::Amount total{ 0 };
     for (auto it = indexes_.begin(); it != indexes_.end(); ++it) {
         total += it->balance_;
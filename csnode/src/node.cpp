@@ -1,10 +1,14 @@
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <csignal>
+#include <limits>
 #include <numeric>
 #include <random>
 #include <sstream>
 #include <numeric>
 #include <stdexcept>
+#include <thread>
 
 #include <solver/consensus.hpp>
 #include <solver/solvercore.hpp>
@@ -22,9 +26,13 @@
 #include <csnode/roundpackage.hpp>
 #include <csnode/configholder.hpp>
 #include <csnode/eventreport.hpp>
+#include <csnode/eventspool.hpp>
 
+#include <lib/system/concurrent.hpp>
+#include <lib/system/deferredlogger.hpp>
 #include <lib/system/logger.hpp>
 #include <lib/system/progressbar.hpp>
+#include <lib/system/scratchbuffer.hpp>
 #include <lib/system/signals.hpp>
 #include <lib/system/utils.hpp>
 
@@ -53,6 +61,21 @@ Packet formPacket(BaseFlags flags, MsgTypes msgType, cs::RoundNumber round, Args
     (void)(stream << ... << std::forward<Args>(args));
     return Packet(std::move(packetBytes));
 }
+
+// gather-style assembly for bulk payloads: the header fields are written
+// first and the payload is compressed straight into the same buffer, so
+// megabyte block replies skip the serialize-then-copy pass of formPacket
+template<class T, class... Trailing>
+Packet formCompressedPacket(cs::Compressor& compressor, BaseFlags flags, MsgTypes msgType, cs::RoundNumber round, const T& payload, const Trailing&... trailing) {
+    cs::Bytes packetBytes;
+    cs::ODataStream stream(packetBytes);
+    stream << flags;
+    stream << msgType;
+    stream << round;
+    compressor.compressInto(payload, packetBytes);
+    (void)(stream << ... << trailing);
+    return Packet(std::move(packetBytes));
+}
 } // namespace
 
 const csdb::Address Node::genesisAddress_ = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000001");
@@ -68,10 +91,23 @@ Node::Node(cs::config::Observer& observer)
 , status_(cs::NodeStatus::ReadingBlocks){
     solver_ = new cs::SolverCore(this, genesisAddress_, startAddress_);
 
+    if (cs::ConfigHolder::instance().config()->isObserverMode() || cs::ConfigHolder::instance().config()->isApiReplicaMode()) {
+        // the API replica is an observer with its neighbourhood pinned to the
+        // upstream nodes, see init()
+        observerMode_ = true;
+        enterStandby();
+        cslog() << "NODE> running as a permanent observer, consensus subsystems are off";
+    }
+    else if (cs::ConfigHolder::instance().config()->isStandbyMode()) {
+        enterStandby();
+    }
+
     std::cout << "Start transport... ";
     transport_ = new Transport(this);
     std::cout << "Done\n";
     poolSynchronizer_ = new cs::PoolSynchronizer(&blockChain_);
+    eventSpool_ = new cs::EventSpool([this](const cs::Bytes& bin_pack) { sendEventReport(bin_pack); });
+    eventSpool_->start();
 
     cs::ExecutorSettings::set(cs::makeReference(blockChain_), cs::makeReference(solver_));
     auto& executor = cs::Executor::instance();
@@ -100,13 +136,16 @@ Node::Node(cs::config::Observer& observer)
 
     cs::Connector::connect(&transport_->neighbourAdded, this, &Node::onNeighbourAdded);
     cs::Connector::connect(&transport_->neighbourRemoved, this, &Node::onNeighbourRemoved);
+    cs::Connector::connect(&transport_->pingLagUpdated, this, &Node::onNeighbourLagUpdated);
     cs::Connector::connect(&transport_->pingReceived, &stat_, &cs::RoundStat::onPingReceived);
     cs::Connector::connect(&transport_->mainThreadIterated, &stat_, &cs::RoundStat::onMainThreadIterated);
 
     cs::Connector::connect(&blockChain_.alarmBadBlock, this, &Node::sendBlockAlarmSignal);
     cs::Connector::connect(&blockChain_.tryToStoreBlockEvent, this, &Node::deepBlockValidation);
     cs::Connector::connect(&blockChain_.stopNode, this, &Node::stop);
-    cs::Connector::connect(&blockChain_.storeBlockEvent, this, &Node::processSpecialInfo);
+    // special info travels in transactions, empty blocks have nothing to scan
+    cs::Connector::connectIf(
+        &blockChain_.storeBlockEvent, [](const csdb::Pool& pool) { return pool.transactions_count() > 0; }, this, &Node::processSpecialInfo);
     cs::Connector::connect(&blockChain_.uncertainBlock, this, &Node::sendBlockRequestToConfidants);
     cs::Connector::connect(&blockChain_.orderNecessaryBlock, this, &Node::sendNecessaryBlockRequest);
     cs::Connector::connect(&stat_.accountInitiationRequest, this, &Node::accountInitiationRequest);
@@ -126,6 +165,7 @@ Node::~Node() {
     delete solver_;
     delete transport_;
     delete poolSynchronizer_;
+    delete eventSpool_;
 }
 
 void Node::dumpKnownPeersToFile() {
@@ -141,6 +181,30 @@ bool Node::init() {
         transport_->setPermanentNeighbours(initialConfidants_);
     }
 
+    if (cs::ConfigHolder::instance().config()->isApiReplicaMode()) {
+        const auto& upstream = cs::ConfigHolder::instance().config()->getReplicaUpstream();
+        if (upstream.empty()) {
+            cserror() << "NODE> api replica mode requires a replica_upstream key list";
+            return false;
+        }
+        // sync and serve the API through the upstream links only, the rest of
+        // the topology never learns the replica as a neighbour
+        transport_->setPermanentNeighbours(std::set<cs::PublicKey>(upstream.begin(), upstream.end()));
+        transport_->restrictNeighboursToPermanent();
+        cslog() << "NODE> api replica profile: " << upstream.size() << " upstream node(s) pinned";
+    }
+
+    const auto& snapshotImportPath = cs::ConfigHolder::instance().config()->getSnapshotImportPath();
+    if (!snapshotImportPath.empty()) {
+        // unpack before blockchain init so QUICK START picks the snapshot up;
+        // the node then syncs only blocks past the snapshot sequence
+        cslog() << "Importing state snapshot from " << snapshotImportPath;
+        if (!cachesSerializationManager_.importSnapshot(snapshotImportPath, initialConfidants_)) {
+            cserror() << "Cannot import state snapshot from " << snapshotImportPath;
+            return false;
+        }
+    }
+
 #ifdef NODE_API
     std::cout << "Init API... ";
 
@@ -249,6 +313,33 @@ bool Node::init() {
 
     cslog() << "Blockchain is ready, contains " << WithDelimiters(stat_.totalTransactions()) << " transactions";
 
+    const auto& snapshotExportPath = cs::ConfigHolder::instance().config()->getSnapshotExportPath();
+    if (!snapshotExportPath.empty()) {
+        // save a fresh checkpoint at the current top so the exported snapshot
+        // is as close to the live chain as possible
+        cs::CheckpointHead headInfo;
+        const auto topSeq = blockChain_.getLastSeq();
+        auto hh = blockChain_.getHashBySequence(topSeq);
+        if (!hh.is_empty()) {
+            headInfo.sequence = topSeq;
+            headInfo.head_hash = hh.to_binary();
+            if (topSeq > 0) {
+                auto ph = blockChain_.getHashBySequence(topSeq - 1);
+                if (!ph.is_empty()) headInfo.prev_hash = ph.to_binary();
+            }
+        }
+        if (headInfo.head_hash.empty() || !cachesSerializationManager_.save(topSeq, headInfo)) {
+            cserror() << "Cannot save checkpoint at " << topSeq << " for snapshot export";
+            return false;
+        }
+        blockChain_.flushIndexes();
+        if (!cachesSerializationManager_.exportSnapshot(snapshotExportPath, solver_->getPrivateKey())) {
+            cserror() << "Cannot export state snapshot to " << snapshotExportPath;
+            return false;
+        }
+        cslog() << "State snapshot exported to " << snapshotExportPath;
+    }
+
 #ifdef NODE_API
     api_->run();
 #endif  // NODE_API
@@ -289,6 +380,7 @@ bool Node::init() {
 
 void Node::initPoolSynchronizer() {
     cs::Connector::connect(&transport_->pingReceived, poolSynchronizer_, &cs::PoolSynchronizer::onPingReceived);
+    cs::Connector::connect(&transport_->pingLagUpdated, poolSynchronizer_, &cs::PoolSynchronizer::onNeighbourLagUpdated);
     cs::Connector::connect(&transport_->neighbourAdded, poolSynchronizer_, &cs::PoolSynchronizer::onNeighbourAdded);
     cs::Connector::connect(&transport_->neighbourRemoved, poolSynchronizer_, &cs::PoolSynchronizer::onNeighbourRemoved);
 }
@@ -296,6 +388,7 @@ void Node::initPoolSynchronizer() {
 void Node::setupNextMessageBehaviour() {
     cs::Connector::connect(&cs::Conveyer::instance().roundChanged, &stat_, &cs::RoundStat::onRoundChanged);
     cs::Connector::connect(&stat_.roundTimeElapsed, this, &Node::onRoundTimeElapsed);
+    cs::Connector::connect(&stat_.roundStallTraceCaptured, this, &Node::onRoundStallTraceCaptured);
 }
 
 void Node::printInitialConfidants() {
@@ -327,6 +420,9 @@ void Node::stop() {
         poolSynchronizer_->stop();
     }
 
+    // flushes the queued Stop status report while transport is still alive
+    eventSpool_->stop();
+
     // stopping transport stops the node (see Node::run() method)
     transport_->stop();
     cswarning() << "[TRANSPORT STOPPED]";
@@ -374,6 +470,11 @@ void Node::onNeighbourAdded(const cs::PublicKey& neighbour, cs::Sequence lastSeq
 
 void Node::onNeighbourRemoved(const cs::PublicKey& neighbour) {
     cslog() << "NODE: neighbour removed " << EncodeBase58(neighbour.data(), neighbour.data() + neighbour.size());
+    neighbourLags_.erase(neighbour);
+}
+
+void Node::onNeighbourLagUpdated(uint64_t rttMs, const cs::PublicKey& neighbour) {
+    neighbourLags_[neighbour] = rttMs;
 }
 
 void Node::onSuccessQS(csdb::Amount blockReward, csdb::Amount miningCoeff, bool miningOn, bool stakingOn, uint32_t stageOneHashesTime) {
@@ -444,7 +545,7 @@ void Node::getUtilityMessage(const uint8_t* data, const size_t size) {
     }
 }
 
-uint8_t Node::calculateBootStrapWeight(cs::PublicKeys& confidants) {
+uint8_t Node::calculateBootStrapWeight(const cs::PublicKeys& confidants) {
     size_t confSize = confidants.size();
     uint8_t currentWeight = 0U;
     if (confSize > 8) {
@@ -802,6 +903,11 @@ bool Node::canBeTrusted(bool critical) {
         return false;
     }
 
+    // a warm spare keeps its caches hot but stays out of consensus
+    if (isStandby()) {
+        return false;
+    }
+
     if (!critical) {
         if (Consensus::DisableTrustedRequestNextRound) {
             // ignore flag after Bootstrap
@@ -881,6 +987,118 @@ void Node::getPacketHashesReply(const uint8_t* data, const std::size_t size, con
     processPacketsReply(std::move(packets), round);
 }
 
+void Node::getPacketIndexRequest(const uint8_t* data, const std::size_t size, const cs::RoundNumber round, const cs::PublicKey& sender) {
+    cs::IDataStream stream(data, size);
+
+    cs::Bytes mask;
+    stream >> mask;
+
+    if (mask.empty()) {
+        csmeta(cserror) << "Empty packet index mask requested";
+        return;
+    }
+
+    cs::PacketsHashes hashes;
+    const auto& conveyer = cs::Conveyer::instance();
+
+    {
+        std::unique_lock<cs::SharedMutex> lock = conveyer.lock();
+        hashes = conveyer.resolveHashIndexMask(round, mask);
+    }
+
+    if (hashes.empty()) {
+        // table already dropped or a different table view, the requester's next
+        // retry carries the explicit hash list
+        csdebug() << "NODE> can not resolve packet index mask of round " << round;
+        return;
+    }
+
+    csdebug() << "NODE> Get index mask request for " << hashes.size() << " packet hashes from " << cs::Utils::byteStreamToHex(sender.data(), sender.size());
+    processPacketsRequest(std::move(hashes), round, sender);
+}
+
+void Node::getPacketDigestsRequest(const uint8_t* data, const std::size_t size, const cs::RoundNumber round, const cs::PublicKey& sender) {
+    cs::IDataStream stream(data, size);
+
+    cs::PacketsHashes hashes;
+    stream >> hashes;
+
+    if (hashes.empty()) {
+        csmeta(cserror) << "Wrong hashes list requested";
+        return;
+    }
+
+    csdebug() << "NODE> Get request for " << hashes.size() << " packet digests from " << cs::Utils::byteStreamToHex(sender.data(), sender.size());
+
+    cs::PacketDigests digests;
+    cs::PacketsVector fullPackets;
+
+    const auto& conveyer = cs::Conveyer::instance();
+
+    {
+        std::unique_lock<cs::SharedMutex> lock = conveyer.lock();
+
+        for (const auto& hash : hashes) {
+            if (auto digest = conveyer.makePacketDigest(hash, round); digest.has_value()) {
+                digests.push_back(std::move(digest).value());
+            }
+            else if (auto packet = conveyer.findPacket(hash, round); packet.has_value()) {
+                // smart packets carry state transactions and are always sent in full
+                fullPackets.push_back(std::move(packet).value());
+            }
+        }
+    }
+
+    if (digests.empty() && fullPackets.empty()) {
+        csdebug() << "NODE> Cannot find packets in storage";
+        return;
+    }
+
+    sendPacketDigestsReply(digests, round, sender);
+    sendPacketHashesReply(fullPackets, round, sender);
+}
+
+void Node::getPacketDigestsReply(const uint8_t* data, const std::size_t size, const cs::RoundNumber round, const cs::PublicKey& sender) {
+    cs::Conveyer& conveyer = cs::Conveyer::instance();
+
+    if (conveyer.isSyncCompleted(round)) {
+        csdebug() << "NODE> sync packets have already finished in round " << round;
+        return;
+    }
+
+    cs::IDataStream stream(data, size);
+
+    cs::PacketDigests digests;
+    stream >> digests;
+
+    if (digests.empty()) {
+        csmeta(cserror) << "Packet digests reply, bad digests parsing";
+        return;
+    }
+
+    cs::PacketsVector packets;
+    cs::PacketsHashes missingHashes;
+
+    {
+        std::unique_lock<cs::SharedMutex> lock = conveyer.lock();
+        auto result = conveyer.assembleFromDigests(digests);
+        packets = std::move(result.first);
+        missingHashes = std::move(result.second);
+    }
+
+    csdebug() << "NODE> Rebuilt " << packets.size() << " packets from digests of sender " << cs::Utils::byteStreamToHex(sender)
+              << ", still missing " << missingHashes.size();
+
+    if (!packets.empty()) {
+        processPacketsReply(std::move(packets), round);
+    }
+
+    if (!missingHashes.empty()) {
+        // transactions we do not hold, ask the sender for the full packets
+        sendDirect(sender, MsgTypes::TransactionsPacketRequest, round, missingHashes);
+    }
+}
+
 
 bool Node::checkCharacteristic(cs::RoundPackage& rPackage) {
     auto& conveyer = cs::Conveyer::instance();
@@ -1034,7 +1252,9 @@ void Node::getCharacteristic(cs::RoundPackage& rPackage) {
     auto tmp = rPackage.poolSignatures();
     pool.value().set_signatures(tmp);
     pool.value().set_confidants(confidantsReference);
-    auto tmpPool = solver_->getDeferredBlock().clone();
+    // copy-on-write: the re-signing below detaches the header, transaction
+    // storage stays shared with the solver's deferred block
+    csdb::Pool tmpPool = solver_->getDeferredBlock();
     if (tmpPool.is_valid() && tmpPool.sequence() == round) {
         auto tmp2 = rPackage.poolSignatures();
         BlockChain::setTimestamp(tmpPool, rPackage.poolMetaInfo().timestamp);
@@ -1108,7 +1328,8 @@ void Node::getBlockAlarm(const uint8_t* data, const std::size_t size, const cs::
     cs::Signature sig;
     stream >> sig;
 
-    cs::Bytes message;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& message = scratch.bytes();
     cs::ODataStream bytes(message);
     bytes << rNum;
 
@@ -1126,7 +1347,17 @@ void Node::reportEvent(const cs::Bytes& bin_pack) {
     if (!conf.is_active) {
         return;
     }
-    cs::Bytes message;
+    // signing and sending happen on the spool thread, emission never waits
+    eventSpool_->enqueue(cs::Bytes(bin_pack));
+}
+
+void Node::sendEventReport(const cs::Bytes& bin_pack) {
+    const auto& conf = cs::ConfigHolder::instance().config()->getEventsReportData();
+    if (!conf.is_active) {
+        return;
+    }
+    cs::ScratchBuffer scratch;
+    cs::Bytes& message = scratch.bytes();
     cs::ODataStream stream(message);
 
     constexpr uint8_t kEventReportVersion = 0;
@@ -1318,7 +1549,8 @@ void Node::sendStateRequest(const csdb::Address& contract_abs_addr, const cs::Pu
     csmeta(csdebug) << cs::SmartContracts::to_base58(blockChain_, contract_abs_addr);
 
     auto round = cs::Conveyer::instance().currentRoundNumber();
-    cs::Bytes message;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& message = scratch.bytes();
     cs::ODataStream stream(message);
     const auto& key = contract_abs_addr.public_key();
     stream << round << key;
@@ -1344,7 +1576,8 @@ void Node::getStateRequest(const uint8_t * data, const std::size_t size, const c
         return;
     }
 
-    cs::Bytes signed_bytes;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& signed_bytes = scratch.bytes();
     cs::ODataStream bytesStream(signed_bytes);
     bytesStream << rNum << key;
 
@@ -1365,7 +1598,8 @@ void Node::sendStateReply(const cs::PublicKey& respondent, const csdb::Address&
         << "to " << cs::Utils::byteStreamToHex(respondent.data(), respondent.size());
 
     cs::RoundNumber round = cs::Conveyer::instance().currentRoundNumber();
-    cs::Bytes signed_data;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& signed_data = scratch.bytes();
     cs::ODataStream stream(signed_data);
 
     const cs::PublicKey& key = contract_abs_addr.public_key();
@@ -1393,7 +1627,8 @@ void Node::getStateReply(const uint8_t* data, const std::size_t size, const cs::
         return;
     }
 
-    cs::Bytes signed_data;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& signed_data = scratch.bytes();
     cs::ODataStream signed_stream(signed_data);
     signed_stream << rNum << key << contract_data;
 
@@ -1564,8 +1799,35 @@ void Node::sendPacketHashesRequest(const cs::PacketsHashes& hashes, const cs::Ro
         cswarning() << csname() << "Can not send packet hashes to neighbours: no neighbours";
     }
     else {
-        transport_->forEachNeighbour([this, round, &hashes](const cs::PublicKey& neighbour, cs::Sequence, cs::RoundNumber) {
-                                        sendDirect(neighbour, MsgTypes::TransactionsPacketRequest, round, hashes);
+        // the first attempt asks for digests only: most missed packets can be rebuilt
+        // from transactions we already hold under a different grouping; retries (and
+        // neighbours that do not understand digests) fall back to full packets
+        MsgTypes requestType = requestStep == 0 ? MsgTypes::TransactionsPacketDigestRequest : MsgTypes::TransactionsPacketRequest;
+        cs::Bytes indexMask;
+
+        const uint32_t attempt = requestStep / packetRequestStep_;
+
+        if (attempt != 0 && (attempt & 1u) != 0) {
+            // odd retries replace the hash list with a bitmask over the round table
+            // order both peers share, a few hundred bytes instead of 32 bytes per
+            // hash; even retries keep the explicit list so neighbours that already
+            // dropped the table still get a request they can serve
+            std::unique_lock<cs::SharedMutex> lock = conveyer.lock();
+            auto mask = conveyer.makeHashIndexMask(round, hashes);
+
+            if (mask.has_value()) {
+                indexMask = std::move(mask).value();
+                requestType = MsgTypes::TransactionsPacketIndexRequest;
+            }
+        }
+
+        transport_->forEachNeighbour([this, round, &hashes, &indexMask, requestType](const cs::PublicKey& neighbour, cs::Sequence, cs::RoundNumber) {
+                                        if (requestType == MsgTypes::TransactionsPacketIndexRequest) {
+                                            sendDirect(neighbour, requestType, round, indexMask);
+                                        }
+                                        else {
+                                            sendDirect(neighbour, requestType, round, hashes);
+                                        }
                                      });
     }
 
@@ -1594,6 +1856,15 @@ void Node::sendPacketHashesReply(const cs::PacketsVector& packets, const cs::Rou
     sendDirect(target, MsgTypes::TransactionsPacketReply, round, packets);
 }
 
+void Node::sendPacketDigestsReply(const cs::PacketDigests& digests, const cs::RoundNumber round, const cs::PublicKey& target) {
+    if (digests.empty()) {
+        return;
+    }
+
+    csdebug() << "NODE> Reply packet digests: " << digests.size();
+    sendDirect(target, MsgTypes::TransactionsPacketDigestReply, round, digests);
+}
+
 void Node::sendSyncroMessage(cs::Byte msg, const cs::PublicKey& target) {
     csdebug() << __func__;
     if (cs::Conveyer::instance().currentRoundNumber() < Consensus::syncroChangeRound) {
@@ -1737,6 +2008,17 @@ void Node::getBlockRequest(const uint8_t* data, const size_t size, const cs::Pub
         return;
     }
 
+    // optional trailing field from newer requesters: the last block they already
+    // store, offered as a shared compression dictionary anchor for the reply
+    cs::Sequence dictionaryAnchor = cs::kWrongSequence;
+    if (stream.isAvailable(sizeof(cs::Sequence))) {
+        stream >> dictionaryAnchor;
+    }
+    if (dictionaryAnchor >= sequences.front()) {
+        // the dictionary may only be built from blocks below the requested range
+        dictionaryAnchor = cs::kWrongSequence;
+    }
+
     if (!checkSynchroRequestsLog(sender, sequences.back())) {
         csdebug() << __func__ << ": Dupplicate request";
         sendSyncroMessage(cs::SyncroMessage::DuplicatedRequest, sender);
@@ -1760,24 +2042,126 @@ void Node::getBlockRequest(const uint8_t* data, const size_t size, const cs::Pub
     poolsBlock.reserve(reserveSize);
 
     auto sendReply = [&] {
-        sendBlockReply(poolsBlock, sender);
+        sendBlockReply(poolsBlock, sender, dictionaryAnchor);
         poolsBlock.clear();
     };
 
-    for (auto& sequence : sequences) {
-        csdb::Pool pool = blockChain_.loadBlockForSync(sequence);
+    const bool consecutive = std::is_sorted(sequences.begin(), sequences.end()) && sequences.back() - sequences.front() + 1 == sequences.size();
 
-        if (pool.is_valid()) {
-            poolsBlock.push_back(std::move(pool));
+    if (consecutive) {
+        // overlapping restarts ask for the same range many times within
+        // seconds; a cached reply skips the storage pass and the compression
+        if (Packet cached = lookupBlockReplyCache(sequences.front(), sequences.size(), dictionaryAnchor)) {
+            csdebug() << "NODE> serving " << sequences.size() << " block(s) from the reply cache";
+            changeSynchroRequestsLog(sender, cs::SyncroMessage::Sent);
+            transport_->sendDirect(std::move(cached), sender);
+            return;
         }
-        else {
-            csmeta(cslog) << "unable to load block " << sequence << " from blockchain";
+
+        // one storage cursor serves the whole range instead of a lookup per block
+        poolsBlock = blockChain_.loadBlocksForSync(sequences.front(), sequences.size());
+
+        if (poolsBlock.size() != sequences.size()) {
+            csmeta(cslog) << "loaded " << poolsBlock.size() << " of " << sequences.size() << " requested blocks";
+        }
+    }
+    else {
+        for (auto& sequence : sequences) {
+            csdb::Pool pool = blockChain_.loadBlockForSync(sequence);
+
+            if (pool.is_valid()) {
+                poolsBlock.push_back(std::move(pool));
+            }
+            else {
+                csmeta(cslog) << "unable to load block " << sequence << " from blockchain";
+            }
         }
     }
 
     sendReply();
 }
 
+namespace {
+
+// shared compression dictionary for sync replies: serialized blocks walked back
+// from anchor until the lz4 window (64 KB) is filled. Requester and responder
+// derive it independently from blocks both already store, which extends the
+// compression window of a reply backwards into the requester's own chain tail
+// where consecutive blocks repeat addresses and amount patterns. The recipe must
+// stay byte-identical on both sides; an empty result means the anchor is not
+// servable and the dictionary mode must not be used
+cs::Bytes buildSyncDictionary(const BlockChain& blockChain, cs::Sequence anchor) {
+    constexpr size_t kDictionaryLimit = 64 * 1024;  // lz4 matches against the last 64 KB only
+
+    std::vector<cs::Bytes> parts;
+    size_t collected = 0;
+
+    for (cs::Sequence sequence = anchor; collected < kDictionaryLimit; --sequence) {
+        csdb::Pool pool = blockChain.loadBlockForSync(sequence);
+
+        if (!pool.is_valid()) {
+            return cs::Bytes{};
+        }
+
+        parts.push_back(pool.to_binary());
+        collected += parts.back().size();
+
+        if (sequence == 0) {
+            break;
+        }
+    }
+
+    cs::Bytes dictionary;
+    dictionary.reserve(collected);
+
+    for (auto part = parts.rbegin(); part != parts.rend(); ++part) {
+        dictionary.insert(dictionary.end(), part->begin(), part->end());
+    }
+
+    return dictionary;
+}
+
+// pools inside one reply are independent, so their deserialization fans out
+// across the shared worker pool; the batch keeps its wire order
+cs::PoolsBlock decodePoolsBlock(std::vector<cs::Bytes>&& packed) {
+    cs::PoolsBlock pools(packed.size());
+
+    if (packed.size() > 1 && std::thread::hardware_concurrency() > 1) {
+        std::atomic<size_t> jobsLeft = packed.size();
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+
+        for (size_t i = 0; i < packed.size(); ++i) {
+            boost::asio::post(cs::ThreadPool::instance(), [&, i] {
+                if (!packed[i].empty()) {
+                    pools[i] = csdb::Pool::from_binary(std::move(packed[i]));
+                }
+
+                if (jobsLeft.fetch_sub(1) == 1) {
+                    std::unique_lock<std::mutex> doneLock(doneMutex);
+                    doneCondition.notify_one();
+                }
+            });
+        }
+
+        std::unique_lock<std::mutex> doneLock(doneMutex);
+        doneCondition.wait(doneLock, [&] {
+            return jobsLeft.load() == 0;
+        });
+    }
+    else {
+        for (size_t i = 0; i < packed.size(); ++i) {
+            if (!packed[i].empty()) {
+                pools[i] = csdb::Pool::from_binary(std::move(packed[i]));
+            }
+        }
+    }
+
+    return pools;
+}
+
+} // namespace
+
 void Node::getBlockReply(const uint8_t* data, const size_t size, const cs::PublicKey& sender) {
     csinfo() << __func__ << " from " << cs::Utils::byteStreamToHex(sender);
 
@@ -1793,10 +2177,36 @@ void Node::getBlockReply(const uint8_t* data, const size_t size, const cs::Publi
 
     cs::IDataStream stream(data, size);
 
-    cs::CompressedRegion region;
+    // view over incoming payload, block replies of several MB are parsed in place
+    cs::CompressedRegionView region;
     stream >> region;
 
-    cs::PoolsBlock poolsBlock = compressor_.decompress<cs::PoolsBlock>(region);
+    // each pool travels as a length-prefixed byte blob, so the envelope can be
+    // split without parsing and the per-pool decode parallelized
+    cs::PoolsBlock poolsBlock;
+
+    if (cs::Compressor::checkCompression(region) == cs::Compressor::CompressedWithDictionary) {
+        // the responder honoured our dictionary anchor; rebuild the same
+        // dictionary from our own chain tail to widen the decompression window
+        cs::Sequence dictionaryAnchor = cs::kWrongSequence;
+        stream >> dictionaryAnchor;
+
+        cs::Bytes dictionary = dictionaryAnchor != cs::kWrongSequence ? buildSyncDictionary(blockChain_, dictionaryAnchor) : cs::Bytes{};
+
+        if (dictionary.empty()) {
+            // anchor blocks are not readable right now, treat the reply as lost:
+            // the synchronizer re-requests the range on its usual timeout
+            cslog() << kLogPrefix_ << "cannot rebuild sync dictionary for anchor " << dictionaryAnchor << ", dropping reply";
+            return;
+        }
+
+        cs::Compressor dictionaryCompressor;
+        dictionaryCompressor.setDictionary(std::move(dictionary));
+        poolsBlock = decodePoolsBlock(dictionaryCompressor.decompress<std::vector<cs::Bytes>>(region));
+    }
+    else {
+        poolsBlock = decodePoolsBlock(compressor_.decompress<std::vector<cs::Bytes>>(region));
+    }
 
     if (poolsBlock.empty()) {
         cserror() << "NODE> Get block reply> No pools found";
@@ -1824,7 +2234,35 @@ void Node::getBlockReply(const uint8_t* data, const size_t size, const cs::Publi
     }
 }
 
-void Node::sendBlockReply(const cs::PoolsBlock& poolsBlock, const cs::PublicKey& target) {
+Packet Node::lookupBlockReplyCache(cs::Sequence fromSeq, size_t count, cs::Sequence dictionaryAnchor) {
+    const auto now = std::chrono::steady_clock::now();
+
+    for (auto iterator = blockReplyCache_.begin(); iterator != blockReplyCache_.end();) {
+        if (now - iterator->createdAt > kBlockReplyCacheTtl) {
+            iterator = blockReplyCache_.erase(iterator);
+            continue;
+        }
+
+        if (iterator->fromSeq == fromSeq && iterator->count == count && iterator->dictionaryAnchor == dictionaryAnchor) {
+            return iterator->packet;
+        }
+
+        ++iterator;
+    }
+
+    return Packet{};
+}
+
+void Node::storeBlockReplyCache(cs::Sequence fromSeq, size_t count, cs::Sequence dictionaryAnchor, const Packet& packet) {
+    if (blockReplyCache_.size() >= kBlockReplyCacheLimit) {
+        // oldest entry sits at the front, insertion below keeps it that way
+        blockReplyCache_.erase(blockReplyCache_.begin());
+    }
+
+    blockReplyCache_.push_back({fromSeq, count, dictionaryAnchor, std::chrono::steady_clock::now(), packet});
+}
+
+void Node::sendBlockReply(const cs::PoolsBlock& poolsBlock, const cs::PublicKey& target, cs::Sequence dictionaryAnchor) {
     if (poolsBlock.empty()) {
         return;
     }
@@ -1839,11 +2277,38 @@ void Node::sendBlockReply(const cs::PoolsBlock& poolsBlock, const cs::PublicKey&
         csdetails() << "#" << it.sequence() << " signs = " << it.signatures().size();
     }
 
-    auto region = compressor_.compress(poolsBlock);
+    Packet packet;
+
+    if (dictionaryAnchor != cs::kWrongSequence) {
+        // the requester offered its chain tail as a shared dictionary, so the
+        // compression window of this reply extends into blocks it already has;
+        // the trailing anchor tells it which dictionary to rebuild
+        cs::Bytes dictionary = buildSyncDictionary(blockChain_, dictionaryAnchor);
+
+        if (!dictionary.empty()) {
+            cs::Compressor dictionaryCompressor;
+            dictionaryCompressor.setDictionary(std::move(dictionary));
+            packet = formCompressedPacket(dictionaryCompressor, BaseFlags::Compressed, MsgTypes::RequestedBlock,
+                                          cs::Conveyer::instance().currentRoundNumber(), poolsBlock, dictionaryAnchor);
+        }
+    }
+
+    if (!packet) {
+        packet = formCompressedPacket(compressor_, BaseFlags::Compressed, MsgTypes::RequestedBlock,
+                                      cs::Conveyer::instance().currentRoundNumber(), poolsBlock);
+    }
+
     csdebug() << "NODE> block package compressed";
     changeSynchroRequestsLog(target, cs::SyncroMessage::Sent);
 
-    sendDirect(target, MsgTypes::RequestedBlock, cs::Conveyer::instance().currentRoundNumber(), region);
+    // consecutive ranges are what restarting peers ask for in overlapping
+    // waves, keep the finished packet around for the next identical request
+    const bool consecutive = poolsBlock.back().sequence() - poolsBlock.front().sequence() + 1 == poolsBlock.size();
+    if (consecutive) {
+        storeBlockReplyCache(poolsBlock.front().sequence(), poolsBlock.size(), dictionaryAnchor, packet);
+    }
+
+    transport_->sendDirect(std::move(packet), target);
     csdebug() << "NODE> block package sent";
 }
 
@@ -1963,6 +2428,10 @@ void Node::showNeighbours() {
     /*poolSynchronizer_->showNeighbours();*/
 }
 
+std::string Node::getPeerStatsReport() {
+    return transport_->getPeerStatsReport();
+}
+
 void Node::setIdle() {
 
 }
@@ -1971,10 +2440,30 @@ void Node::setWorking() {
 
 }
 
+void Node::enterStandby() {
+    if (!standbyMode_.exchange(true, std::memory_order_relaxed)) {
+        cslog() << "NODE> entering warm standby, consensus participation is off";
+    }
+}
+
+void Node::leaveStandby() {
+    if (standbyMode_.exchange(false, std::memory_order_relaxed)) {
+        cslog() << "NODE> leaving warm standby, consensus participation resumes next round";
+    }
+}
+
 void Node::showDbParams() {
     getBlockChain().showDBParams();
 }
 
+uint32_t Node::neighboursCount() const {
+    return transport_->getNeighboursCount();
+}
+
+size_t Node::transportInboxQueueSize() {
+    return transport_->inboxQueueSize();
+}
+
 void Node::addToBlackList(const cs::PublicKey& key, bool isMarked) {
     if (isMarked) {
         transport_->ban(key);
@@ -2040,7 +2529,12 @@ void Node::sendBlockRequest(const cs::PublicKey& target, const cs::PoolsRequeste
                       << ", to: " << sequences.back() << ", round: " << round;
 
     BaseFlags flags = static_cast<BaseFlags>(BaseFlags::Signed | BaseFlags::Compressed);
-    transport_->sendDirect(formPacket(flags, MsgTypes::BlockRequest, round, sequences), target);
+
+    // trailing dictionary anchor: the last block we surely store. A responder
+    // aware of it compresses the reply against our own chain tail (see
+    // getBlockRequest); older responders ignore the extra field
+    const cs::Sequence dictionaryAnchor = blockChain_.getLastSeq();
+    transport_->sendDirect(formPacket(flags, MsgTypes::BlockRequest, round, sequences, dictionaryAnchor), target);
 }
 
 void Node::sendBlockRequestToConfidants(cs::Sequence sequence) {
@@ -2054,11 +2548,40 @@ void Node::sendBlockRequestToConfidants(cs::Sequence sequence) {
     sendDirect(confidants, MsgTypes::BlockRequest, round, sequences, size_t(0) /*packetNum*/);
 }
 
+bool Node::isConsensusOnlyMessage(const MsgTypes type) {
+    switch (type) {
+        case MsgTypes::FirstStage:
+        case MsgTypes::SecondStage:
+        case MsgTypes::ThirdStage:
+        case MsgTypes::FirstStageRequest:
+        case MsgTypes::SecondStageRequest:
+        case MsgTypes::ThirdStageRequest:
+        case MsgTypes::FirstSmartStage:
+        case MsgTypes::SecondSmartStage:
+        case MsgTypes::ThirdSmartStage:
+        case MsgTypes::SmartFirstStageRequest:
+        case MsgTypes::SmartSecondStageRequest:
+        case MsgTypes::SmartThirdStageRequest:
+        case MsgTypes::RejectedContracts:
+        case MsgTypes::BlockHash:
+        case MsgTypes::HashReply:
+            return true;
+        default:
+            return false;
+    }
+}
+
 Node::MessageActions Node::chooseMessageAction(const cs::RoundNumber rNum, const MsgTypes type, const cs::PublicKey sender) {
     if (!good_) {
         return MessageActions::Drop;
     }
 
+    // an observer never takes part in any consensus, stage traffic would only
+    // fill storages nobody drains
+    if (observerMode_ && isConsensusOnlyMessage(type)) {
+        return MessageActions::Drop;
+    }
+
     // always process this types
     switch (type) {
         case MsgTypes::FirstSmartStage:
@@ -2071,9 +2594,15 @@ Node::MessageActions Node::chooseMessageAction(const cs::RoundNumber rNum, const
         case MsgTypes::TransactionsPacketReply:
         case MsgTypes::TransactionsPacketBaseRequest:
         case MsgTypes::TransactionsPacketBaseReply:
+        case MsgTypes::TransactionsPacketDigestRequest:
+        case MsgTypes::TransactionsPacketDigestReply:
+        case MsgTypes::TransactionsPacketIndexRequest:
         case MsgTypes::RoundTableRequest:
         case MsgTypes::RejectedContracts:
         case MsgTypes::RoundPackRequest:
+        // the announcement usually arrives one round ahead; postponing it would
+        // fire the pull only after the package came some other way, so handle now
+        case MsgTypes::RoundPackageHash:
         case MsgTypes::EmptyRoundPack:
         case MsgTypes::StateRequest:
         case MsgTypes::StateReply:
@@ -2193,40 +2722,35 @@ std::ostream& operator<<(std::ostream& os, Node::Level nodeLevel) {
 
 template <typename... Args>
 void Node::sendDirect(const cs::PublicKey& target, const MsgTypes msgType, const cs::RoundNumber round, Args&&... args) {
-    csdetails() << "NODE> Sending Direct data, round " << round
-                << "msgType: " << Packet::messageTypeToString(msgType);
+    csdeferredlog(trace, "NODE> Sending Direct data, round {} msgType: {}", round, Packet::messageTypeToString(msgType));
 
     transport_->sendDirect(formPacket(BaseFlags::Compressed, msgType, round, args...), target);
 }
 
 template <typename... Args>
 void Node::sendDirect(const cs::PublicKeys& keys, const MsgTypes msgType, const cs::RoundNumber round, Args&&... args) {
-    csdebug() << "NODE> Sending direct to list, round: " << round
-              << ", msgType: " << Packet::messageTypeToString(msgType);
+    csdeferredlog(debug, "NODE> Sending direct to list, round: {}, msgType: {}", round, Packet::messageTypeToString(msgType));
 
     transport_->sendMulticast(formPacket(BaseFlags::Compressed, msgType, round, args...), keys);
 }
 
 template <class... Args>
 void Node::sendBroadcast(const MsgTypes msgType, const cs::RoundNumber round, Args&&... args) {
-    csdetails() << "NODE> Sending broadcast, round: " << round
-                << ", msgType: " << Packet::messageTypeToString(msgType);
+    csdeferredlog(trace, "NODE> Sending broadcast, round: {}, msgType: {}", round, Packet::messageTypeToString(msgType));
 
     transport_->sendBroadcast(formPacket(BaseFlags::Compressed, msgType, round, args...));
 }
 
 template <class... Args>
 void Node::sendBroadcastIfNoConnection(const cs::PublicKey& target, const MsgTypes msgType, const cs::RoundNumber round, Args&&... args) {
-    csdetails() << "NODE> Sending broadcast IF NO CONNECTION, round: " << round
-                << ", msgType: " << Packet::messageTypeToString(msgType);
+    csdeferredlog(trace, "NODE> Sending broadcast IF NO CONNECTION, round: {}, msgType: {}", round, Packet::messageTypeToString(msgType));
 
     transport_->sendBroadcastIfNoConnection(formPacket(BaseFlags::Compressed, msgType, round, args...), target);
 }
 
 template <class... Args>
 void Node::sendBroadcastIfNoConnection(const cs::PublicKeys& keys, const MsgTypes msgType, const cs::RoundNumber round, Args&&... args) {
-    csdetails() << "NODE> Sending broadcast IF NO CONNECTION, round: " << round
-                << ", msgType: " << Packet::messageTypeToString(msgType);
+    csdeferredlog(trace, "NODE> Sending broadcast IF NO CONNECTION, round: {}, msgType: {}", round, Packet::messageTypeToString(msgType));
 
     for (auto& key : keys) {
         transport_->sendBroadcastIfNoConnection(formPacket(BaseFlags::Compressed, msgType, round, args...), key);
@@ -2297,7 +2821,8 @@ void Node::getStageOne(const uint8_t* data, const size_t size, const cs::PublicK
     stage.messageHash = cscrypto::calculateHash(stage.message.data(), stage.message.size());
     const cs::Conveyer& conveyer = cs::Conveyer::instance();
 
-    cs::Bytes signedMessage;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& signedMessage = scratch.bytes();
     cs::ODataStream signedStream(signedMessage);
     signedStream << conveyer.currentRoundNumber();
     signedStream << subRound_;
@@ -2305,8 +2830,7 @@ void Node::getStageOne(const uint8_t* data, const size_t size, const cs::PublicK
 
     // stream for main message
     cs::IDataStream stageStream(stage.message.data(), stage.message.size());
-    stageStream >> stage.sender;
-    stageStream >> stage.hash;
+    stageStream.parseFields(stage.sender, stage.hash);
     stageStream >> stage.trustedCandidates;
     stageStream >> stage.hashesCandidates;
     stageStream >> stage.roundTimeStamp;
@@ -2457,12 +2981,8 @@ void Node::getStageThree(const uint8_t* data, const size_t size, const cs::Publi
     }
 
     cs::IDataStream stageStream(bytes.data(), bytes.size());
-    stageStream >> stage.sender;
-    stageStream >> stage.writer;
-    stageStream >> stage.iteration;  // this is a potential problem!!!
-    stageStream >> stage.blockSignature;
-    stageStream >> stage.roundSignature;
-    stageStream >> stage.trustedSignature;
+    // iteration is a potential problem!!!
+    stageStream.parseFields(stage.sender, stage.writer, stage.iteration, stage.blockSignature, stage.roundSignature, stage.trustedSignature);
     stageStream >> stage.realTrustedMask;
 
     const cs::Conveyer& conveyer = cs::Conveyer::instance();
@@ -2612,7 +3132,8 @@ void Node::sendSmartReject(const std::vector<RefExecution>& rejectList) {
         return;
     }
 
-    cs::Bytes data;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& data = scratch.bytes();
     cs::ODataStream stream(data);
 
     stream << rejectList;
@@ -2963,8 +3484,7 @@ bool Node::sendRoundPackage(const cs::RoundNumber rNum, const cs::PublicKey& tar
         csdebug() << "Cannot find round table, so cannot send";
         return false;
     }
-    bool showVersion = rpCurrent->roundTable().round >= Consensus::StartingDPOS && Consensus::miningOn;
-    sendDirect(target, MsgTypes::RoundTable, rpCurrent->roundTable().round, rpCurrent->subRound(), rpCurrent->toBinary(showVersion));
+    transport_->sendDirect(Packet(roundTableReplyPacket(*rpCurrent)), target);
     csdebug() << "Done";
 
     if (!rpCurrent->poolMetaInfo().characteristic.mask.empty()) {
@@ -2974,11 +3494,140 @@ bool Node::sendRoundPackage(const cs::RoundNumber rNum, const cs::PublicKey& tar
     return true;
 }
 
+cs::PublicKeys Node::selectRoundPackageRelay(const cs::PublicKey* sender, cs::PublicKeys& announceTargets) const {
+    std::vector<std::pair<uint64_t, cs::PublicKey>> ranked;
+
+    transport_->forEachNeighbour([&](const cs::PublicKey& neighbour, cs::Sequence, cs::RoundNumber) {
+        if (sender != nullptr && neighbour == *sender) {
+            return;
+        }
+
+        const auto lag = neighbourLags_.find(neighbour);
+        ranked.emplace_back(lag != neighbourLags_.end() ? lag->second : std::numeric_limits<uint64_t>::max(), neighbour);
+    });
+
+    // fastest links first; the key breaks ties, so the pick is stable between calls
+    std::sort(ranked.begin(), ranked.end());
+
+    announceTargets.clear();
+    cs::PublicKeys relayTargets;
+
+    for (const auto& entry : ranked) {
+        if (relayTargets.size() < kRoundPackageFanout) {
+            relayTargets.push_back(entry.second);
+        }
+        else {
+            announceTargets.push_back(entry.second);
+        }
+    }
+
+    return relayTargets;
+}
+
+void Node::relayRoundPackage(const cs::RoundNumber rNum, cs::Byte subRound, const cs::Bytes& bytes, const cs::PublicKey& sender) {
+    if (rNum <= lastRelayedRound_) {
+        return;
+    }
+
+    lastRelayedRound_ = rNum;
+
+    cs::PublicKeys announceTargets;
+    cs::PublicKeys relayTargets = selectRoundPackageRelay(&sender, announceTargets);
+
+    if (relayTargets.empty()) {
+        return;
+    }
+
+    // forwarding the received payload byte for byte keeps relayed copies identical,
+    // so the seen-packets cache on every receiver collapses crossing tree branches
+    sendDirect(relayTargets, MsgTypes::RoundTable, rNum, subRound, bytes);
+
+    if (!announceTargets.empty()) {
+        const cs::Hash packageHash = cscrypto::calculateHash(bytes.data(), bytes.size());
+        sendDirect(announceTargets, MsgTypes::RoundPackageHash, rNum, subRound, packageHash);
+    }
+}
+
+void Node::getRoundPackageHash(const uint8_t* data, const size_t size, const cs::RoundNumber rNum, const cs::PublicKey& sender) {
+    cs::IDataStream stream(data, size);
+
+    cs::Byte subRound = 0;
+    cs::Hash packageHash;
+    stream >> subRound >> packageHash;
+
+    if (!stream.isValid() || !stream.isEmpty()) {
+        csmeta(cserror) << "Malformed round package announcement";
+        return;
+    }
+
+    csdebug() << "NODE> round package #" << rNum << "." << static_cast<int>(subRound) << " announced by "
+              << cs::Utils::byteStreamToHex(sender.data(), sender.size());
+
+    if (cs::Conveyer::instance().currentRoundNumber() >= rNum || isVerifiedRoundPackage(rNum, packageHash)) {
+        return;
+    }
+
+    // every announce-only neighbour repeats the same hash, one pull is enough
+    if (roundPackagePullScheduled_ >= rNum) {
+        return;
+    }
+
+    roundPackagePullScheduled_ = rNum;
+
+    cs::Timer::singleShot(kRoundPackagePullDelayMs, cs::RunPolicy::CallQueuePolicy, [this, rNum, sender] {
+        if (cs::Conveyer::instance().currentRoundNumber() >= rNum) {
+            return;  // the full package arrived down-tree meanwhile
+        }
+
+        roundPackRequest(sender, rNum);
+    });
+}
+
 void Node::sendRoundPackageToAll(cs::RoundPackage& rPackage) {
     // add signatures// blockSignatures, roundSignatures);
     csmeta(csdetails) << "Send round table to all";
     bool showVersion = rPackage.roundTable().round >= Consensus::StartingDPOS && Consensus::miningOn;
-    sendBroadcast(MsgTypes::RoundTable, rPackage.roundTable().round, rPackage.subRound(), rPackage.toBinary(showVersion));
+
+    // confidants rarely change between consecutive rounds, so send a delta package
+    // when the previous one is cached; peers unable to restore it request the full table
+    auto rpPrevious = std::find_if(roundPackageCache_.begin(), roundPackageCache_.end(),
+                                   [&rPackage](cs::RoundPackage& rp) { return rp.roundTable().round + 1 == rPackage.roundTable().round; });
+
+    const cs::Bytes binary = rpPrevious != roundPackageCache_.end() ? rPackage.toDeltaBinary(*rpPrevious, showVersion) : rPackage.toBinary(showVersion);
+    const cs::RoundNumber round = rPackage.roundTable().round;
+
+    cs::PublicKeys announceTargets;
+    cs::PublicKeys relayTargets = selectRoundPackageRelay(nullptr, announceTargets);
+
+    if (announceTargets.empty()) {
+        // too few neighbours for the dissemination tree to save anything
+        sendBroadcast(MsgTypes::RoundTable, round, rPackage.subRound(), binary);
+    }
+    else {
+        // the writer seeds the tree: next round confidants never wait for relays,
+        // they get the full package on top of the fastest links
+        for (const auto& confidant : rPackage.roundTable().confidants) {
+            if (confidant == solver_->getPublicKey()) {
+                continue;
+            }
+
+            if (std::find(relayTargets.cbegin(), relayTargets.cend(), confidant) == relayTargets.cend()) {
+                relayTargets.push_back(confidant);
+
+                const auto it = std::find(announceTargets.cbegin(), announceTargets.cend(), confidant);
+                if (it != announceTargets.cend()) {
+                    announceTargets.erase(it);
+                }
+            }
+        }
+
+        sendDirect(relayTargets, MsgTypes::RoundTable, round, rPackage.subRound(), binary);
+
+        if (!announceTargets.empty()) {
+            const cs::Hash packageHash = cscrypto::calculateHash(binary.data(), binary.size());
+            sendDirect(announceTargets, MsgTypes::RoundPackageHash, round, rPackage.subRound(), packageHash);
+        }
+    }
 
     if (!rPackage.poolMetaInfo().characteristic.mask.empty()) {
         csmeta(csdebug) << "Packing " << rPackage.poolMetaInfo().characteristic.mask.size() << " bytes of char. mask to send";
@@ -3155,7 +3804,18 @@ void Node::getRoundTable(const uint8_t* data, const size_t size, const cs::Round
 
     cs::RoundPackage rPackage;
 
-    if (!rPackage.fromBinary(bytes, rNum, subRound)) {
+    if (cs::RoundPackage::isDelta(bytes)) {
+        // the delta package carries no confidants list, restore it from the previous round table;
+        // nodes that are out of sync cannot do that and fall back to requesting the full table
+        const cs::RoundTable* previousTable = conveyer.roundTable(rNum - 1);
+
+        if (previousTable == nullptr || !rPackage.fromDeltaBinary(bytes, previousTable->confidants, rNum, subRound)) {
+            csdebug() << "NODE> Delta RoundPackage could not be restored, request the full round table";
+            roundPackRequest(sender, rNum);
+            return;
+        }
+    }
+    else if (!rPackage.fromBinary(bytes, rNum, subRound)) {
         csdebug() << "NODE> RoundPackage could not be parsed";
         return;
     }
@@ -3273,7 +3933,14 @@ void Node::getRoundTable(const uint8_t* data, const size_t size, const cs::Round
                 }
             }
 
-            if (!receivingSignatures(rPackage, confidants) && storedRound == getBlockChain().getLastSeq()) {
+            const cs::Hash packageHash = cscrypto::calculateHash(bytes.data(), bytes.size());
+            if (isVerifiedRoundPackage(rPackage.roundTable().round, packageHash)) {
+                csdebug() << "NODE> duplicate RoundPackage, signatures already verified";
+            }
+            else if (receivingSignatures(rPackage, confidants)) {
+                markRoundPackageVerified(rPackage.roundTable().round, packageHash);
+            }
+            else if (storedRound == getBlockChain().getLastSeq()) {
                 return;
             }
         }
@@ -3284,6 +3951,11 @@ void Node::getRoundTable(const uint8_t* data, const size_t size, const cs::Round
     else {
         csdebug() << "NODE> bootstrap round, so not any confirmation available";
     }
+    // second tier of the dissemination tree: the first accepted copy of a round
+    // package is forwarded whole down the fastest links, the remaining
+    // neighbours hear its hash and pull the package only if no copy reaches them
+    relayRoundPackage(rPackage.roundTable().round, subRound, bytes, sender);
+
     currentRoundTableMessage_.round = rPackage.roundTable().round;
     currentRoundTableMessage_.sender = sender;
     currentRoundTableMessage_.message = cs::Bytes(data, data + size);
@@ -3385,7 +4057,19 @@ void Node::clearRPCache(cs::RoundNumber rNum) {
         }
         roundPackageCache_.erase(tmp);
     }
+    verifiedRoundPackageHashes_.erase(verifiedRoundPackageHashes_.begin(), verifiedRoundPackageHashes_.lower_bound(rNum - 5));
+}
+
+bool Node::isVerifiedRoundPackage(cs::RoundNumber rNum, const cs::Hash& packageHash) const {
+    const auto it = verifiedRoundPackageHashes_.find(rNum);
+    if (it == verifiedRoundPackageHashes_.end()) {
+        return false;
+    }
+    return std::find(it->second.begin(), it->second.end(), packageHash) != it->second.end();
+}
 
+void Node::markRoundPackageVerified(cs::RoundNumber rNum, const cs::Hash& packageHash) {
+    verifiedRoundPackageHashes_[rNum].push_back(packageHash);
 }
 
 void Node::sendHash(cs::RoundNumber round) {
@@ -3596,7 +4280,8 @@ void Node::getRoundPackRequest(const uint8_t* data, const size_t size, cs::Round
 void Node::emptyRoundPackReply(const cs::PublicKey& respondent) {
     csdebug() << "NODE> sending empty roundPack reply to " << cs::Utils::byteStreamToHex(respondent.data(), respondent.size());
     cs::Sequence seq = getBlockChain().getLastSeq();
-    cs::Bytes bytes;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& bytes = scratch.bytes();
     cs::ODataStream stream(bytes);
     stream << seq;
     cs::Signature signature = cscrypto::generateSignature(solver_->getPrivateKey(), bytes.data(), bytes.size());
@@ -3611,7 +4296,8 @@ void Node::getEmptyRoundPack(const uint8_t* data, const size_t size, cs::RoundNu
     cs::Signature signature;
     stream >> signature;
 
-    cs::Bytes bytes;
+    cs::ScratchBuffer scratch;
+    cs::Bytes& bytes = scratch.bytes();
     cs::ODataStream message(bytes);
     message << rNum;
 
@@ -3636,9 +4322,23 @@ void Node::roundPackReply(const cs::PublicKey& respondent) {
         return;
     }
 
-    cs::RoundPackage rp = roundPackageCache_.back();
-    bool showVersion = rp.roundTable().round >= Consensus::StartingDPOS && Consensus::miningOn;
-    sendDirect(respondent, MsgTypes::RoundTable, rp.roundTable().round, rp.subRound(), rp.toBinary(showVersion));
+    transport_->sendDirect(Packet(roundTableReplyPacket(roundPackageCache_.back())), respondent);
+}
+
+const Packet& Node::roundTableReplyPacket(cs::RoundPackage& package) {
+    const bool showVersion = package.roundTable().round >= Consensus::StartingDPOS && Consensus::miningOn;
+    const cs::Bytes& binary = package.toBinary(showVersion);
+    const cs::RoundNumber round = package.roundTable().round;
+    const cs::Byte subRound = package.subRound();
+
+    if (roundReplyPacket_.size() == 0 || roundReplyRound_ != round || roundReplySubRound_ != subRound || roundReplyBinarySize_ != binary.size()) {
+        roundReplyPacket_ = formPacket(BaseFlags::Compressed, MsgTypes::RoundTable, round, subRound, binary);
+        roundReplyRound_ = round;
+        roundReplySubRound_ = subRound;
+        roundReplyBinarySize_ = binary.size();
+    }
+
+    return roundReplyPacket_;
 }
 
 void Node::sendRoundTableRequest(uint8_t respondent) {
@@ -4554,6 +5254,11 @@ void Node::onRoundTimeElapsed() {
     }
 }
 
+void Node::onRoundStallTraceCaptured(const std::vector<cs::StackSampler::Sample>& samples, uint64_t durationMs) {
+    cslog() << "NODE> captured " << samples.size() << " stack samples during a round of " << durationMs << " ms, reporting";
+    EventReport::sendRoundStallTrace(*this, cs::Conveyer::instance().currentRoundNumber(), durationMs, samples);
+}
+
 bool Node::bootstrap(const cs::Bytes& bytes, cs::RoundNumber round) {
     std::set<cs::PublicKey> confidants;
     cs::IDataStream input(bytes.data(), bytes.size());
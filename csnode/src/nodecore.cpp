@@ -1,4 +1,7 @@
 #include "nodecore.hpp"
+
+#include <mutex>
+
 #include <datastream.hpp>
 
 namespace cs {
@@ -72,12 +75,47 @@ std::size_t std::hash<cs::TransactionsPacketHash>::operator()(const cs::Transact
     return hash;
 }
 
+cs::SharedConfidants::SharedConfidants()
+: data_(std::make_shared<const cs::ConfidantsKeys>()) {
+}
+
+cs::SharedConfidants::SharedConfidants(cs::ConfidantsKeys keys)
+: data_(intern(std::move(keys))) {
+}
+
+cs::SharedConfidants& cs::SharedConfidants::operator=(cs::ConfidantsKeys keys) {
+    data_ = intern(std::move(keys));
+    return *this;
+}
+
+void cs::SharedConfidants::push_back(const cs::PublicKey& key) {
+    cs::ConfidantsKeys grown = *data_;
+    grown.push_back(key);
+    data_ = intern(std::move(grown));
+}
+
+/*static*/
+std::shared_ptr<const cs::ConfidantsKeys> cs::SharedConfidants::intern(cs::ConfidantsKeys&& keys) {
+    // the trusted set usually survives the round change, so remembering just
+    // the last interned snapshot already folds almost all assignments into
+    // reference count bumps
+    static std::mutex mutex;
+    static std::shared_ptr<const cs::ConfidantsKeys> last;
+
+    std::lock_guard lock(mutex);
+    if (last && *last == keys) {
+        return last;
+    }
+    last = std::make_shared<const cs::ConfidantsKeys>(std::move(keys));
+    return last;
+}
+
 cs::Bytes cs::RoundTable::toBinary() const {
     cs::Bytes bytes;
     cs::ODataStream stream(bytes);
 
     stream << round;
-    stream << confidants;
+    stream << confidants.keys();
 
     return bytes;
 }
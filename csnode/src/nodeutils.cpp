@@ -2,6 +2,7 @@
 
 #include <csdb/pool.hpp>
 
+#include <lib/system/cryptoservice.hpp>
 #include <lib/system/logger.hpp>
 #include <lib/system/utils.hpp>
 
@@ -49,26 +50,42 @@ bool NodeUtils::checkGroupSignature(const cs::ConfidantsKeys& confidants, const
 
     signatureCount = 0;
     size_t cnt = 0;
-    bool validSig = true;
-    size_t cntValid = 0;
-    size_t cntInvalid = 0;
     csdebug() << log_prefix << "hash: " << cs::Utils::byteStreamToHex(hash);
+
+    // the signatures are independent, one batch lets the crypto service
+    // spread them over the pool when the confidant list is large
+    std::vector<cs::CryptoService::VerifyJob> jobs;
+    std::vector<size_t> confidantIndexes;
+    jobs.reserve(signatures.size());
+    confidantIndexes.reserve(signatures.size());
+
     for (auto it : mask) {
         if (it != cs::ConfidantConsts::InvalidConfidantIndex) {
-            if (cscrypto::verifySignature(signatures[signatureCount], confidants[cnt], hash.data(), hash.size())) {
-                csdetails() << log_prefix << "signature of [" << cnt << "] is valid";
-                ++signatureCount;
-                ++cntValid;
-            }
-            else {
-                csdebug() << log_prefix << "signature of [" << cnt << "] is NOT VALID: " << cs::Utils::byteStreamToHex(signatures[signatureCount]);
-                validSig = false;
-                ++signatureCount;
-                ++cntInvalid;
-            }
+            jobs.push_back(cs::CryptoService::VerifyJob{signatures[signatureCount].data(), confidants[cnt].data(), hash.data(), hash.size()});
+            confidantIndexes.push_back(cnt);
+            ++signatureCount;
         }
         ++cnt;
     }
+
+    const std::vector<cs::Byte> results = cs::CryptoService::instance().verifyBatch(jobs);
+
+    bool validSig = true;
+    size_t cntValid = 0;
+    size_t cntInvalid = 0;
+
+    for (size_t index = 0; index < results.size(); ++index) {
+        if (results[index] != 0) {
+            csdetails() << log_prefix << "signature of [" << confidantIndexes[index] << "] is valid";
+            ++cntValid;
+        }
+        else {
+            csdebug() << log_prefix << "signature of [" << confidantIndexes[index] << "] is NOT VALID: " << cs::Utils::byteStreamToHex(signatures[index]);
+            validSig = false;
+            ++cntInvalid;
+        }
+    }
+
     if (!validSig) {
         csdebug() << log_prefix << "signatures (" << cntInvalid << ") are not valid";
         return false;
@@ -81,13 +98,9 @@ bool NodeUtils::checkGroupSignature(const cs::ConfidantsKeys& confidants, const
 
 /*static*/
 size_t NodeUtils::realTrustedValue(const cs::Bytes& mask) {
-    size_t cnt = 0;
-    for (auto it : mask) {
-        if (it != cs::ConfidantConsts::InvalidConfidantIndex) {
-            ++cnt;
-        }
-    }
-    return cnt;
+    // word-wide kernel shared with the confirmation and characteristic
+    // paths, the per-byte loop was measurable at high confidant counts
+    return cs::Utils::trustedByteCount(mask);
 }
 
 /*static*/
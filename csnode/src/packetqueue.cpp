@@ -1,33 +1,126 @@
 #include <csnode/packetqueue.hpp>
 #include <csnode/conveyer.hpp>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 cs::PacketQueue::PacketQueue(size_t queueSize, size_t transactionsSize, size_t packetsPerRound)
 : maxQueueSize_(queueSize)
 , maxTransactionsSize_(transactionsSize)
 , maxPacketsPerRound_(packetsPerRound) {
     cachedRound_ = 0;
     cachedPackets_ = 0;
+    transactionsCount_ = 0;
+    bytesCount_ = 0;
+    memoryPressurePercent_ = 0;
+    admissionRound_ = 0;
+    admittedFeeRateEwma_ = 0.;
 }
 
-bool cs::PacketQueue::push(const csdb::Transaction& transaction) {
+cs::PacketQueue::PushResult cs::PacketQueue::push(const csdb::Transaction& transaction) {
     if (queue_.size() >= maxQueueSize_) {
-        return false;
+        return PushResult::QueueFull;
+    }
+
+    // the conveyer caches are at their byte budget, stop taking on new work
+    // instead of growing towards the OOM killer
+    if (memoryPressurePercent_ >= 100) {
+        return PushResult::QueueFull;
+    }
+
+    const size_t bytes = transaction.is_valid() ? transaction.to_byte_stream().size() : 0;
+    const double fee = transaction.max_fee().to_double();
+
+    if (queue_.size() * 100 >= maxQueueSize_ * kPressurePercent || memoryPressurePercent_ >= kPressurePercent) {
+        const auto round = cs::Conveyer::instance().currentRoundNumber();
+
+        if (round != admissionRound_) {
+            admissionRound_ = round;
+            sourceCounters_.clear();
+        }
+
+        // under pressure one source gets at most a packet's worth of
+        // transactions per round, so a flooder throttles itself long before
+        // it can crowd everyone else out of the queue
+        auto& sourceCount = sourceCounters_[transaction.source()];
+
+        if (sourceCount >= maxTransactionsSize_) {
+            return PushResult::SourceLimitReached;
+        }
+
+        // close to the limit admission is priced: transactions paying well
+        // below the recently admitted level are turned away while the sender
+        // can still resubmit with a higher max fee
+        if (queue_.size() * 100 >= maxQueueSize_ * kHighPressurePercent || memoryPressurePercent_ >= kHighPressurePercent) {
+            const double rate = bytes == 0 ? 0. : fee / static_cast<double>(bytes);
+
+            if (admittedFeeRateEwma_ > 0. && rate * 2. < admittedFeeRateEwma_) {
+                return PushResult::FeeTooLow;
+            }
+        }
+
+        ++sourceCount;
+
+        if (bytes != 0) {
+            admittedFeeRateEwma_ += (fee / static_cast<double>(bytes) - admittedFeeRateEwma_) / kFeeRateEwmaWindow;
+        }
     }
 
-    if (queue_.empty() || queue_.back().transactions().size() >= maxTransactionsSize_) {
+    if (queue_.empty() || queue_.back().transactionsCount() >= maxTransactionsSize_) {
         queue_.push_back(cs::TransactionsPacket{});
+        feeProfiles_.emplace_back();
     }
 
-    return queue_.back().addTransaction(transaction);
+    // a fresh packet grows to maxTransactionsSize_, take all reallocations at once.
+    // transactionsCount() is used above instead of transactions(): the non const
+    // accessor drops the packet's incremental hash state
+    if (queue_.back().transactionsCount() == 0) {
+        queue_.back().reserve(maxTransactionsSize_);
+        tailPacketStarted_ = std::chrono::steady_clock::now();
+    }
+
+    bool added = queue_.back().addTransaction(transaction);
+
+    if (added) {
+        ++transactionsCount_;
+        bytesCount_ += bytes;
+        feeProfiles_.back().fee += fee;
+        feeProfiles_.back().bytes += bytes;
+    }
+
+    return added ? PushResult::Added : PushResult::QueueFull;
 }
 
 void cs::PacketQueue::push(const cs::TransactionsPacket& packet) {
     // ignore size of queue for packs
+    transactionsCount_ += packet.transactionsCount();
+    bytesCount_ += packet.estimatedByteSize();
+
     queue_.push_back(packet);
     queue_.push_back(cs::TransactionsPacket{});
+
+    // contract packets are exempt from fee ordering
+    feeProfiles_.resize(queue_.size());
 }
 
-cs::PacketsVector cs::PacketQueue::pop() {
+void cs::PacketQueue::pushBulk(std::vector<cs::TransactionsPacket>&& packets) {
+    for (auto& packet : packets) {
+        transactionsCount_ += packet.transactionsCount();
+        bytesCount_ += packet.estimatedByteSize();
+        queue_.push_back(std::move(packet));
+    }
+
+    // single separator terminates the bulk, next single transaction starts a fresh packet
+    if (!packets.empty()) {
+        queue_.push_back(cs::TransactionsPacket{});
+    }
+
+    feeProfiles_.resize(queue_.size());
+    packets.clear();
+}
+
+cs::PacketsVector cs::PacketQueue::pop(std::chrono::milliseconds coalesceWindow) {
     const auto round = cs::Conveyer::instance().currentRoundNumber();
     cs::PacketsVector block;
 
@@ -39,10 +132,32 @@ cs::PacketsVector cs::PacketQueue::pop() {
         cachedPackets_ = 0;
     }
 
+    // with a backlog beyond the remaining round budget the best paying packets
+    // go first instead of strict FIFO, exempt packets keep the very front
+    const size_t budget = maxPacketsPerRound_ - cachedPackets_;
+
+    if (queue_.size() > budget) {
+        prioritizeFront(budget);
+    }
+
     while (!queue_.empty() && cachedPackets_ < maxPacketsPerRound_) {
+        // hold back a partially filled tail packet within the coalesce window,
+        // further single transactions keep joining it instead of starting
+        // a new packet after every flush tick
+        if (queue_.size() == 1) {
+            const auto count = queue_.front().transactionsCount();
+
+            if (count != 0 && count < maxTransactionsSize_ && (std::chrono::steady_clock::now() - tailPacketStarted_) < coalesceWindow) {
+                break;
+            }
+        }
+
         block.push_back(std::move(queue_.front()));
         queue_.pop_front();
+        feeProfiles_.pop_front();
 
+        transactionsCount_ -= block.back().transactionsCount();
+        bytesCount_ -= std::min(bytesCount_, block.back().estimatedByteSize());
         ++cachedPackets_;
     }
 
@@ -50,6 +165,47 @@ cs::PacketsVector cs::PacketQueue::pop() {
     return block;
 }
 
+void cs::PacketQueue::prioritizeFront(size_t budget) {
+    std::vector<size_t> order(queue_.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+
+    // arrival index breaks ties, equal payers keep FIFO among themselves
+    std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(budget), order.end(), [this](size_t lhs, size_t rhs) {
+        const double left = feeProfiles_[lhs].rate();
+        const double right = feeProfiles_[rhs].rate();
+        return left != right ? left > right : lhs < rhs;
+    });
+
+    order.resize(budget);
+    std::sort(order.begin(), order.end());
+
+    // pure FIFO already, nothing to move
+    if (order.back() + 1 == budget) {
+        return;
+    }
+
+    std::vector<bool> selected(queue_.size(), false);
+
+    for (const auto index : order) {
+        selected[index] = true;
+    }
+
+    std::deque<cs::TransactionsPacket> reordered;
+    std::deque<FeeProfile> reorderedProfiles;
+
+    for (size_t pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < queue_.size(); ++i) {
+            if (selected[i] == (pass == 0)) {
+                reordered.push_back(std::move(queue_[i]));
+                reorderedProfiles.push_back(feeProfiles_[i]);
+            }
+        }
+    }
+
+    queue_.swap(reordered);
+    feeProfiles_.swap(reorderedProfiles);
+}
+
 typename std::deque<cs::TransactionsPacket>::const_iterator cs::PacketQueue::begin() const {
     return queue_.begin();
 }
@@ -69,3 +225,15 @@ bool cs::PacketQueue::isEmpty() const {
 std::deque<cs::TransactionsPacket>::const_reference cs::PacketQueue::back() const {
     return queue_.back();
 }
+
+size_t cs::PacketQueue::transactionsCount() const {
+    return transactionsCount_;
+}
+
+size_t cs::PacketQueue::bytesCount() const {
+    return bytesCount_;
+}
+
+void cs::PacketQueue::setMemoryPressure(size_t percent) {
+    memoryPressurePercent_ = percent;
+}
@@ -1,6 +1,7 @@
 #include <poolcache.hpp>
 
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <system_error>
 
@@ -39,7 +40,7 @@ void cs::PoolCache::insert(const csdb::Pool& pool, PoolStoreType type) {
 
 void cs::PoolCache::insert(cs::Sequence sequence, const cs::Bytes& bytes, cs::PoolStoreType type) {
     type_ = type;
-    db_.insert(sequence, bytes);
+    db_.insert(sequence, pack(sequence, bytes));
 }
 
 bool cs::PoolCache::remove(cs::Sequence sequence) {
@@ -73,7 +74,7 @@ cs::Sequence cs::PoolCache::maxSequence() const {
 }
 
 std::optional<cs::PoolCache::Data> cs::PoolCache::value(cs::Sequence sequence) const {
-    auto bytes = db_.value<cs::Bytes>(sequence);
+    auto bytes = unpack(db_.value<cs::Bytes>(sequence));
     auto bType = cachedType(sequence);
     Data data{ csdb::Pool::from_binary(std::move(bytes), bType != cs::PoolStoreType::Created), bType };
 
@@ -230,6 +231,60 @@ cs::PoolStoreType cs::PoolCache::cachedType(cs::Sequence sequence) const {
     return sequences_.find(sequence)->second;
 }
 
+cs::Bytes cs::PoolCache::pack(cs::Sequence sequence, const cs::Bytes& bytes) {
+    // the pop edge advances from the lowest cached sequence, so only entries
+    // far above it sit long enough to be worth compressing
+    const bool cold = !sequences_.empty() && sequence > minSequence() + kHotWindow;
+
+    if (cold) {
+        auto region = compressor_.compress(bytes);
+
+        if (region.size() != 0 && region.size() < bytes.size()) {
+            cs::Bytes stored;
+            stored.reserve(1 + sizeof(uint64_t) + region.size());
+            stored.push_back(kCompressedTag);
+
+            const uint64_t binarySize = static_cast<uint64_t>(region.binarySize());
+            const auto sizePtr = reinterpret_cast<const cs::Byte*>(&binarySize);
+            stored.insert(stored.end(), sizePtr, sizePtr + sizeof(binarySize));
+            stored.insert(stored.end(), region.data(), region.data() + region.size());
+            return stored;
+        }
+    }
+
+    cs::Bytes stored;
+    stored.reserve(1 + bytes.size());
+    stored.push_back(kRawTag);
+    stored.insert(stored.end(), bytes.begin(), bytes.end());
+    return stored;
+}
+
+cs::Bytes cs::PoolCache::unpack(cs::Bytes&& stored) const {
+    if (stored.empty()) {
+        return std::move(stored);
+    }
+
+    const cs::Byte tag = stored.front();
+
+    if (tag == kRawTag) {
+        stored.erase(stored.begin());
+        return std::move(stored);
+    }
+
+    if (tag != kCompressedTag || stored.size() < 1 + sizeof(uint64_t)) {
+        cswarning() << csfunc() << ", unknown pool cache storage tag " << static_cast<int>(tag);
+        return cs::Bytes{};
+    }
+
+    uint64_t binarySize = 0;
+    std::memcpy(&binarySize, stored.data() + 1, sizeof(binarySize));
+
+    const CompressedRegionView region { stored.data() + 1 + sizeof(uint64_t),
+                                        stored.size() - 1 - sizeof(uint64_t),
+                                        static_cast<size_t>(binarySize) };
+    return compressor_.decompress<cs::Bytes>(region);
+}
+
 void cs::PoolCache::checkInvariant() const {
 #ifndef NDEBUG
     assert(sequences_.size() == db_.size());
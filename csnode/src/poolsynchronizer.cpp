@@ -1,8 +1,9 @@
 #include "poolsynchronizer.hpp"
 
-#include <chrono>
-#include <random>
+#include <algorithm>
+#include <limits>
 
+#include <lib/system/concurrent.hpp>
 #include <lib/system/logger.hpp>
 #include <lib/system/progressbar.hpp>
 #include <lib/system/utils.hpp>
@@ -12,14 +13,6 @@
 
 #include <solver/consensus.hpp>
 
-namespace {
-size_t getRandomIndex(size_t max) {
-    std::default_random_engine engine(std::chrono::steady_clock::now().time_since_epoch().count());
-    std::uniform_int_distribution<size_t> distr(0, max);
-    return distr(engine);
-}
-} // namespace
-
 namespace cs {
 
 /// Public methods
@@ -35,11 +28,12 @@ PoolSynchronizer::PoolSynchronizer(BlockChain* blockChain)
     // Print Pool Sync Data Info
     const uint8_t hl = 25;
     const uint8_t vl = 6;
+    const auto config = cs::ConfigHolder::instance().snapshot();
     csmeta(csdebug) << "Pool sync data : \n"
                     << std::setw(hl) << "Block pools:      "
-                    << std::setw(vl) << static_cast<int>(cs::ConfigHolder::instance().config()->getPoolSyncSettings().blockPoolsCount) << "\n"
+                    << std::setw(vl) << static_cast<int>(config->getPoolSyncSettings().blockPoolsCount) << "\n"
                     << std::setw(hl) << "Polling frequency:"
-                    << std::setw(vl) << cs::ConfigHolder::instance().config()->getPoolSyncSettings().sequencesVerificationFrequency;
+                    << std::setw(vl) << config->getPoolSyncSettings().sequencesVerificationFrequency;
 }
 
 void PoolSynchronizer::sync(cs::RoundNumber roundNum, cs::RoundNumber difference) {
@@ -59,7 +53,7 @@ void PoolSynchronizer::sync(cs::RoundNumber roundNum, cs::RoundNumber difference
     if (!isSyncroStarted_ && roundNum < (lastWrittenSequence + difference)) {
         return;
     }
-    if (maxRequestedSequence_ != kWrongSequence && maxRequestedSequence_ > lastWrittenSequence) {
+    if (maxRequestedSequence_ != kWrongSequence && maxRequestedSequence_ > lastWrittenSequence && awaitingRepliesCount() >= kMaxPipelinedRequests) {
         return;
     }
 
@@ -98,8 +92,9 @@ void PoolSynchronizer::sync(cs::RoundNumber roundNum, cs::RoundNumber difference
 
     if (!isSyncroStarted_) {
         isSyncroStarted_ = true;
+        blockChain_->startStoreBatching();
         timer_.start(
-            cs::ConfigHolder::instance().config()->getPoolSyncSettings().sequencesVerificationFrequency,
+            cs::ConfigHolder::instance().snapshot()->getPoolSyncSettings().sequencesVerificationFrequency,
             Timer::Type::HighPrecise,
             RunPolicy::CallQueuePolicy
         );
@@ -117,8 +112,9 @@ void PoolSynchronizer::syncLastPool() {
     }
     if (!isSyncroStarted_) {
         isSyncroStarted_ = true;
+        blockChain_->startStoreBatching();
     }
-    cs::PublicKey target = std::next(neighbours_.begin(), getRandomIndex(neighbours_.size() - 1))->first;
+    cs::PublicKey target = neighboursOrderedByLag().front().first;
     emit sendRequest(target, PoolsRequestedSequences{blockChain_->getLastSeq() + 1});
 }
 
@@ -164,10 +160,70 @@ void PoolSynchronizer::getBlockReply(cs::PoolsBlock&& poolsBlock, const cs::Publ
     csdebug() << "SYNC: Get Block Reply <<<<<<< : count: " << poolsBlock.size()
         << ", seqs: [" << poolsBlock.front().sequence()
         << ", " << poolsBlock.back().sequence() << "]";
+
+    // request-to-reply time of the served range feeds the adaptive sizing
+    const auto logEntry = synchroLog_.find(sender);
+    if (logEntry != synchroLog_.end()) {
+        onRangeServed(sender, cs::Utils::currentTimestamp() - std::get<2>(logEntry->second));
+    }
+
     removeSynchroLog(sender);
-    //std::thread sThread(&PoolSynchronizer::manageSyncBlocks, this, std::move(poolsBlock));;
-    //sThread.detach();
-    manageSyncBlocks(std::move(poolsBlock));
+
+    {
+        cs::Lock lock(replyMutex_);
+        replyQueue_.push_back(std::move(poolsBlock));
+    }
+
+    bool expected = false;
+
+    if (replyWorkerBusy_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        cs::Concurrent::run([this] {
+            processReplyQueue();
+        });
+    }
+
+    // next pipelined range can be requested while the worker stores this one
+    if (awaitingRepliesCount() < kMaxPipelinedRequests) {
+        sendBlockRequest();
+    }
+}
+
+void PoolSynchronizer::processReplyQueue() {
+    while (true) {
+        cs::PoolsBlock poolsBlock;
+
+        {
+            cs::Lock lock(replyMutex_);
+
+            if (replyQueue_.empty()) {
+                replyWorkerBusy_.store(false, std::memory_order_release);
+                return;
+            }
+
+            poolsBlock = std::move(replyQueue_.front());
+            replyQueue_.pop_front();
+        }
+
+        if (stopped_.load(std::memory_order_acquire)) {
+            continue;
+        }
+
+        manageSyncBlocks(std::move(poolsBlock));
+    }
+}
+
+size_t PoolSynchronizer::awaitingRepliesCount() const {
+    size_t count = 0;
+
+    for (const auto& [key, value] : synchroLog_) {
+        auto message = std::get<1>(value);
+
+        if (message == SyncroMessage::AwaitAnswer || message == SyncroMessage::NoAnswer) {
+            ++count;
+        }
+    }
+
+    return count;
 }
 
 bool PoolSynchronizer::isSyncroStarted() const {
@@ -296,6 +352,71 @@ void PoolSynchronizer::onPingReceived(cs::Sequence sequence, const cs::PublicKey
 
 void PoolSynchronizer::onNeighbourRemoved(const cs::PublicKey& publicKey) {
     neighbours_.erase(publicKey);
+    neighbourLagMs_.erase(publicKey);
+    requestProfiles_.erase(publicKey);
+}
+
+size_t PoolSynchronizer::requestSizeFor(const PublicKey& neighbour) const {
+    // one snapshot per call: a reloaded blockPoolsCount applies to the next
+    // request batch without risking a torn read here
+    const size_t configured = cs::ConfigHolder::instance().snapshot()->getPoolSyncSettings().blockPoolsCount;
+    const auto profile = requestProfiles_.find(neighbour);
+
+    if (profile == requestProfiles_.end() || profile->second.rangeSize == 0) {
+        return configured;
+    }
+
+    return std::clamp(profile->second.rangeSize, kMinRequestSize, configured * kMaxRequestSizeFactor);
+}
+
+void PoolSynchronizer::onRangeServed(const PublicKey& neighbour, uint64_t elapsedMs) {
+    auto& profile = requestProfiles_[neighbour];
+
+    if (profile.rangeSize == 0) {
+        profile.rangeSize = cs::ConfigHolder::instance().snapshot()->getPoolSyncSettings().blockPoolsCount;
+    }
+
+    if (elapsedMs <= kFastReplyMs) {
+        profile.rangeSize += profile.rangeSize / 2 + 1;
+        csdebug() << "SYNC: fast reply in " << elapsedMs << " ms from " << cs::Utils::byteStreamToHex(neighbour)
+                  << ", next range grows to " << requestSizeFor(neighbour);
+    }
+    else if (elapsedMs >= kSlowReplyMs) {
+        profile.rangeSize /= 2;
+        csdebug() << "SYNC: slow reply in " << elapsedMs << " ms from " << cs::Utils::byteStreamToHex(neighbour)
+                  << ", next range shrinks to " << requestSizeFor(neighbour);
+    }
+}
+
+void PoolSynchronizer::onRangeExpired(const PublicKey& neighbour) {
+    auto& profile = requestProfiles_[neighbour];
+
+    if (profile.rangeSize == 0) {
+        profile.rangeSize = cs::ConfigHolder::instance().snapshot()->getPoolSyncSettings().blockPoolsCount;
+    }
+
+    profile.rangeSize /= 2;
+    csdebug() << "SYNC: range expired at " << cs::Utils::byteStreamToHex(neighbour)
+              << ", next range shrinks to " << requestSizeFor(neighbour);
+}
+
+void PoolSynchronizer::onNeighbourLagUpdated(uint64_t rttMs, const cs::PublicKey& publicKey) {
+    neighbourLagMs_[publicKey] = rttMs;
+}
+
+std::vector<std::pair<cs::PublicKey, cs::Sequence>> PoolSynchronizer::neighboursOrderedByLag() const {
+    std::vector<std::pair<PublicKey, Sequence>> ordered(neighbours_.begin(), neighbours_.end());
+
+    auto lagOf = [this](const PublicKey& key) {
+        const auto it = neighbourLagMs_.find(key);
+        return it != neighbourLagMs_.end() ? it->second : std::numeric_limits<uint64_t>::max();
+    };
+
+    std::sort(ordered.begin(), ordered.end(), [&](const auto& lhs, const auto& rhs) {
+        return lagOf(lhs.first) < lagOf(rhs.first);
+    });
+
+    return ordered;
 }
 
 //
@@ -343,14 +464,32 @@ void PoolSynchronizer::sendBlockRequest() {
         return;
     }
 
-    maxRequestedSequence_ = blockChain_->getLastSeq();
+    // do not restart from the last written block while earlier ranges are
+    // still in flight, pipelined requests continue past them
+    if (maxRequestedSequence_ == kWrongSequence || maxRequestedSequence_ < blockChain_->getLastSeq()) {
+        maxRequestedSequence_ = blockChain_->getLastSeq();
+    }
+
+    // the bitmap window follows the chain tip, bits below it are never read again
+    requestedSequences_.discardBelow(blockChain_->getLastSeq());
 
     auto requiredBlocks = blockChain_->getRequiredBlocks();
-    auto neighbour = std::next(neighbours_.begin(), getRandomIndex(neighbours_.size() - 1));
-    auto end = neighbour;
+
+    // fastest sources take the earliest ranges, slower peers only get the
+    // overflow of the pipeline
+    auto ordered = neighboursOrderedByLag();
     updateSynchroLog();
-    do {
-        auto neededSequences = getNeededSequences(requiredBlocks, neighbour->second);
+
+    // expired entries have just cleared their bits: pull the walk start back to
+    // the first gap above the chain tip so their ranges are re-requested before
+    // anything new
+    const Sequence firstGap = requestedSequences_.nextClear(blockChain_->getLastSeq() + 1);
+    if (firstGap > 0 && firstGap - 1 < maxRequestedSequence_) {
+        maxRequestedSequence_ = firstGap - 1;
+    }
+
+    for (const auto& [key, lastSeq] : ordered) {
+        auto neededSequences = getNeededSequences(requiredBlocks, lastSeq, requestSizeFor(key));
 
         if (neededSequences.empty()) {
             csdetails() << "SYNC: All sequences already requested";
@@ -359,24 +498,20 @@ void PoolSynchronizer::sendBlockRequest() {
         else {
             maxRequestedSequence_ = neededSequences.back();
         }
-        if (checkSynchroLog(neighbour->first)) {
+        if (checkSynchroLog(key)) {
             cslog() << "SYNC: requesting for " << neededSequences.size()
                 << " blocks [" << neededSequences.front() << ", " << neededSequences.back()
-                << "] from " << cs::Utils::byteStreamToHex(neighbour->first);
-            emit sendRequest(neighbour->first, neededSequences);
-            addSynchroLog(neighbour->first, neededSequences, SyncroMessage::NoAnswer);
-        }
-
-        ++neighbour;
-        if (neighbour == neighbours_.end()) {
-            neighbour = neighbours_.begin();
+                << "] from " << cs::Utils::byteStreamToHex(key);
+            emit sendRequest(key, neededSequences);
+            addSynchroLog(key, neededSequences, SyncroMessage::NoAnswer);
         }
-    } while (neighbour != end);
+    }
 }
 
 std::vector<Sequence> PoolSynchronizer::getNeededSequences(
     const std::vector<BlockChain::SequenceInterval>& requiredBlocks,
-    Sequence neighbourLastSeq
+    Sequence neighbourLastSeq,
+    size_t requestSize
 ) {
     if (requiredBlocks.empty()) {
         csdebug() << "SYNC: Required blocks is empty !!!";
@@ -386,9 +521,13 @@ std::vector<Sequence> PoolSynchronizer::getNeededSequences(
     Sequence sequence = maxRequestedSequence_;
     std::vector<Sequence> neededSequences;
 
-    for (size_t i = 0; i < cs::ConfigHolder::instance().config()->getPoolSyncSettings().blockPoolsCount; ++i) {
+    for (size_t i = 0; i < requestSize; ++i) {
         ++sequence;
 
+        // the blocks already requested: a single bitmap probe, contiguous
+        // in-flight runs are skipped a whole summary stride at a time
+        sequence = requestedSequences_.nextClear(sequence);
+
         // max sequence
         if (requiredBlocks.back().second != 0 && sequence > requiredBlocks.back().second) {
             break;
@@ -399,16 +538,6 @@ std::vector<Sequence> PoolSynchronizer::getNeededSequences(
             break;
         }
 
-        //the blocks already requested
-        auto it = synchroLog_.begin();
-        while (it != synchroLog_.end()) {
-            auto& tmpSet = std::get<0>(it->second);
-            if (std::find(tmpSet.begin(), tmpSet.end(), sequence) != tmpSet.end()) {
-                break;
-            }
-            ++it;
-        }
-
         for (size_t j = 1; j <= requiredBlocks.size(); ++j) {
             // Within a valid pair
             if (sequence >= requiredBlocks[j - 1].first && sequence <= requiredBlocks[j - 1].second) {
@@ -428,6 +557,7 @@ std::vector<Sequence> PoolSynchronizer::getNeededSequences(
 void PoolSynchronizer::synchroFinished() {
     timer_.stop();
     isSyncroStarted_ = false;
+    blockChain_->stopStoreBatching();
     maxRequestedSequence_ = kWrongSequence;
     csdebug() << "SYNC: Synchro finished";
 }
@@ -440,7 +570,14 @@ void PoolSynchronizer::stop() {
     timer_.stop();
     isSyncroStarted_ = false;
     synchroLog_.clear();
+    requestedSequences_.clear();
     maxRequestedSequence_ = kWrongSequence;
+
+    {
+        cs::Lock lock(replyMutex_);
+        replyQueue_.clear();
+    }
+
     cslog() << "SYNC: shutdown — pool synchronizer stopped";
 }
 
@@ -463,6 +600,10 @@ void PoolSynchronizer::addSynchroLog(const cs::PublicKey& sender, cs::PoolsReque
     }
     //csdebug() << __func__;
     synchroLog_.emplace(sender, std::make_tuple(sequences, msg, cs::Utils::currentTimestamp()));
+
+    for (const auto sequence : sequences) {
+        requestedSequences_.insert(sequence);
+    }
     //csdebug() << __func__ << " -> " << synchroLog_.size() << ": key " << cs::Utils::byteStreamToHex(sender) << " added as " << static_cast<int>(msg) << " at " << std::get<2>(synchroLog_[sender]);
 }
 
@@ -489,6 +630,11 @@ void PoolSynchronizer::updateSynchroLog() {
         auto msg = std::get<1>(it->second);
         auto timeEvent = std::get<2>(it->second);
         if ((msg != SyncroMessage::AwaitAnswer && timeNow > timeEvent + 50000) || ((std::get<1>(it->second) == SyncroMessage::NoAnswer && timeNow > timeEvent + 2000))) {
+            // the range never arrived, clearing the bits makes it requestable again
+            for (const auto sequence : std::get<0>(it->second)) {
+                requestedSequences_.erase(sequence);
+            }
+            onRangeExpired(it->first);
             it = synchroLog_.erase(it);
         }
         else {
@@ -507,6 +653,9 @@ bool PoolSynchronizer::removeSynchroLog(const cs::PublicKey& sender) {
         return false;
     }
     //csdebug() << __func__ << " -> " << synchroLog_.size() << ": key " << cs::Utils::byteStreamToHex(sender) << " removed";
+    for (const auto sequence : std::get<0>(it->second)) {
+        requestedSequences_.erase(sequence);
+    }
     it = synchroLog_.erase(it);
     return true;
 }
@@ -45,7 +45,9 @@ bool RoundPackage::fromBinary(const cs::Bytes& bytes, cs::RoundNumber rNum, cs::
     else {
         roundStream >> ver;
     }
-    roundStream >> roundTable_.confidants;
+    cs::ConfidantsKeys confidants;
+    roundStream >> confidants;
+    roundTable_.confidants = std::move(confidants);
 
     if (roundTable_.confidants.empty() || roundTable_.confidants.size() > Consensus::MaxTrustedNodes) {
         csmeta(cserror) << name() << "Illegal confidants number in round table: " << roundTable_.confidants.size();
@@ -131,6 +133,71 @@ bool RoundPackage::fromBinary(const cs::Bytes& bytes, cs::RoundNumber rNum, cs::
     return true;
 }
 
+bool RoundPackage::isDelta(const cs::Bytes& bytes) {
+    return !bytes.empty() && bytes.front() == DeltaMarker;
+}
+
+cs::Bytes RoundPackage::toDeltaBinary(const RoundPackage& previous, bool showVersion) {
+    const cs::Bytes& full = toBinary(showVersion);
+
+    if (previous.roundTable_.round + 1 != roundTable_.round || previous.roundTable_.confidants != roundTable_.confidants) {
+        // confidants changed, nothing to elide
+        return full;
+    }
+
+    const size_t versionSize = showVersion ? sizeof(cs::Byte) : 0;
+    const size_t confidantsSize = sizeof(size_t) + roundTable_.confidants.size() * sizeof(cscrypto::PublicKey);
+
+    if (full.size() < versionSize + confidantsSize) {
+        return full;
+    }
+
+    cs::Bytes bytes;
+    bytes.reserve(full.size() - confidantsSize + 2 * sizeof(cs::Byte));
+
+    cs::ODataStream stream(bytes);
+    stream << DeltaMarker;
+    stream << static_cast<cs::Byte>(showVersion ? 1U : 0U);
+
+    bytes.insert(bytes.end(), full.begin() + static_cast<std::ptrdiff_t>(versionSize + confidantsSize), full.end());
+    return bytes;
+}
+
+bool RoundPackage::fromDeltaBinary(const cs::Bytes& bytes, const cs::ConfidantsKeys& previousConfidants, cs::RoundNumber rNum, cs::Byte subRound) {
+    if (!isDelta(bytes)) {
+        csmeta(cserror) << name() << "Not a delta round package";
+        return false;
+    }
+
+    if (previousConfidants.empty() || previousConfidants.size() > Consensus::MaxTrustedNodes) {
+        csdebug() << name() << "No valid previous confidants to restore delta round package";
+        return false;
+    }
+
+    cs::IDataStream stream(bytes.data(), bytes.size());
+    cs::Byte marker = 0U;
+    cs::Byte ver = 0U;
+    stream >> marker >> ver;
+
+    if (!stream.isValid()) {
+        csmeta(cserror) << name() << "Malformed delta round package";
+        return false;
+    }
+
+    cs::Bytes full;
+    full.reserve(bytes.size() + sizeof(size_t) + previousConfidants.size() * sizeof(cscrypto::PublicKey));
+    cs::ODataStream fullStream(full);
+
+    if (ver == 1U) {
+        fullStream << ver;
+    }
+
+    fullStream << previousConfidants;
+    full.insert(full.end(), reinterpret_cast<const cs::Byte*>(stream.data()), reinterpret_cast<const cs::Byte*>(stream.data()) + stream.size());
+
+    return fromBinary(full, rNum, subRound);
+}
+
 std::string RoundPackage::toString() {
     std::string packageString;
 
@@ -240,7 +307,7 @@ void RoundPackage::refillToSign(bool showVersion) {
         stream << ver;
     }
 
-    stream << roundTable_.confidants;
+    stream << roundTable_.confidants.keys();
     stream << poolMetaInfo_.realTrustedMask;
     stream << subRound_ << iteration;
     stream << roundTable_.hashes;
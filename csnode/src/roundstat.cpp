@@ -6,6 +6,8 @@
 #include "datastream.hpp"
 #include <configholder.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 namespace cs {
@@ -37,6 +39,11 @@ void RoundStat::onRoundStart(RoundNumber round, bool skipLogs) {
         auto newDurationMs = duration_cast<milliseconds>(steady_clock::now() - startPointMs_).count();
         auto lastRoundMs = cs::numeric_cast<size_t>(newDurationMs) - totalDurationMs_;
         totalDurationMs_ = cs::numeric_cast<size_t>(newDurationMs);
+
+        if (round > 0) {
+            appendPerfRecord(round - 1, lastRoundMs);
+        }
+
         size_t counter = 1;
 
         if (round > nodeStartRound_) {
@@ -632,6 +639,58 @@ void RoundStat::onReadBlock(const csdb::Pool& block, bool* /*shouldStop*/) {
 
 void RoundStat::onStoreBlock(const csdb::Pool& block) {
     countTrustAndTrx(block);
+    lastBlockTransactions_.store(static_cast<uint32_t>(block.transactions_count()), std::memory_order_relaxed);
+}
+
+void RoundStat::appendPerfRecord(RoundNumber round, size_t durationMs) {
+    RoundPerfRecord record;
+    record.round = round;
+    record.durationMs = static_cast<uint32_t>(std::min<size_t>(durationMs, std::numeric_limits<uint32_t>::max()));
+    record.transactions = lastBlockTransactions_.load(std::memory_order_relaxed);
+
+    std::lock_guard lock(perfMutex_);
+
+    if (perfRing_.size() < kRoundPerfWindow) {
+        perfRing_.push_back(record);
+    }
+    else {
+        perfRing_[perfNext_] = record;
+    }
+
+    perfNext_ = (perfNext_ + 1) % kRoundPerfWindow;
+}
+
+size_t RoundStat::roundDurationPercentile(double percentile) const {
+    std::vector<uint32_t> durations;
+
+    {
+        std::lock_guard lock(perfMutex_);
+
+        if (perfRing_.empty()) {
+            return 0;
+        }
+
+        durations.reserve(perfRing_.size());
+
+        for (const auto& record : perfRing_) {
+            durations.push_back(record.durationMs);
+        }
+    }
+
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    size_t rank = static_cast<size_t>(clamped / 100.0 * static_cast<double>(durations.size()));
+
+    if (rank >= durations.size()) {
+        rank = durations.size() - 1;
+    }
+
+    std::nth_element(durations.begin(), durations.begin() + static_cast<std::ptrdiff_t>(rank), durations.end());
+    return durations[rank];
+}
+
+size_t RoundStat::perfRecordsCount() const {
+    std::lock_guard lock(perfMutex_);
+    return perfRing_.size();
 }
 
 void RoundStat::onStopReadingFromDb(uint64_t totalTransactions, bool successfulQuickStart) {
@@ -744,6 +803,8 @@ void RoundStat::checkRoundElapse() {
         emit roundTimeElapsed();
     });
 
+    maybeCaptureStallTrace(static_cast<uint64_t>(ms));
+
     {
         // reset time point to tick next time after limit
         cs::Lock lock(statsElapseMutex_);
@@ -751,6 +812,38 @@ void RoundStat::checkRoundElapse() {
     }
 }
 
+void RoundStat::maybeCaptureStallTrace(uint64_t elapsedMs) {
+    if (!cs::StackSampler::isSupported()) {
+        return;
+    }
+
+    const auto& conf = cs::ConfigHolder::instance().config()->getEventsReportData();
+    if (!conf.is_active || !conf.round_stall_trace) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (lastStallTracePoint_ != std::chrono::steady_clock::time_point{} &&
+        now - lastStallTracePoint_ < std::chrono::milliseconds(kStallTraceCooldownMs)) {
+        return;
+    }
+    lastStallTracePoint_ = now;
+
+    cslog() << "RoundStat: round is " << WithDelimiters(elapsedMs) << " ms long, capturing stack samples of service threads";
+
+    // the capture blocks for its whole duration, keep it off the calls queue
+    cs::Concurrent::run([this, elapsedMs]() {
+        auto samples = cs::StackSampler::instance().capture(kStallTraceDurationMs, kStallTraceIntervalMs);
+        if (samples.empty()) {
+            return;
+        }
+
+        cs::Concurrent::execute(cs::RunPolicy::CallQueuePolicy, [this, samples = std::move(samples), elapsedMs]() {
+            emit roundStallTraceCaptured(samples, elapsedMs);
+        });
+    });
+}
+
 void RoundStat::checkStoreBlockElapse() {
     std::chrono::steady_clock::time_point point;
     uint64_t limit = 0;
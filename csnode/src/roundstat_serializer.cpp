@@ -8,6 +8,7 @@
 #include <csnode/roundstat_serializer.hpp>
 #include <csnode/serializers_helper.hpp>
 #include <csnode/roundstat.hpp>
+#include <lib/system/mmappedfile.hpp>
 #include "logger.hpp"
 
 namespace {
@@ -34,8 +35,8 @@ namespace cs {
     }
 
     void RoundStat_Serializer::save(const std::filesystem::path& rootDir) {
-        std::ofstream ofs(rootDir / kDataFileName, std::ios::binary);
-        boost::archive::binary_oarchive oa(ofs);
+        MMappedOutput out((rootDir / kDataFileName).string());
+        boost::archive::binary_oarchive oa(out.stream());
         csdebug() << kLogPrefix << __func__;
         roundStat_->printClassInfo();
         oa << roundStat_->serialize();
@@ -43,10 +44,10 @@ namespace cs {
 
     ::cscrypto::Hash RoundStat_Serializer::hash() {
         {
-            std::ofstream ofs(kDataFileName, std::ios::binary);
+            MMappedOutput out(kDataFileName);
             {
                 boost::archive::binary_oarchive oa(
-                    ofs,
+                    out.stream(),
                     boost::archive::no_header | boost::archive::no_codecvt
                 );
                 oa << roundStat_->serialize();
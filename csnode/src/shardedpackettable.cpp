@@ -0,0 +1,97 @@
+#include "csnode/shardedpackettable.hpp"
+
+bool cs::ShardedPacketTable::append(const cs::TransactionsPacketHash& hash, const cs::TransactionsPacket& packet) {
+    Shard& element = shard(hash);
+
+    cs::Lock lock(element.mutex);
+    return element.table.emplace(hash, packet).second;
+}
+
+bool cs::ShardedPacketTable::append(cs::TransactionsPacketHash&& hash, cs::TransactionsPacket&& packet) {
+    Shard& element = shard(hash);
+
+    cs::Lock lock(element.mutex);
+    return element.table.emplace(std::move(hash), std::move(packet)).second;
+}
+
+std::optional<cs::TransactionsPacket> cs::ShardedPacketTable::find(const cs::TransactionsPacketHash& hash) const {
+    const Shard& element = shard(hash);
+
+    cs::SharedLock lock(element.mutex);
+
+    if (auto iterator = element.table.find(hash); iterator != element.table.end()) {
+        return std::make_optional(iterator->second);
+    }
+
+    return std::nullopt;
+}
+
+bool cs::ShardedPacketTable::contains(const cs::TransactionsPacketHash& hash) const {
+    const Shard& element = shard(hash);
+
+    cs::SharedLock lock(element.mutex);
+    return element.table.count(hash) != 0;
+}
+
+bool cs::ShardedPacketTable::remove(const cs::TransactionsPacketHash& hash) {
+    Shard& element = shard(hash);
+
+    cs::Lock lock(element.mutex);
+    return element.table.erase(hash) != 0;
+}
+
+size_t cs::ShardedPacketTable::size() const {
+    size_t count = 0;
+
+    for (const Shard& element : shards_) {
+        cs::SharedLock lock(element.mutex);
+        count += element.table.size();
+    }
+
+    return count;
+}
+
+void cs::ShardedPacketTable::clear() {
+    for (Shard& element : shards_) {
+        cs::Lock lock(element.mutex);
+        element.table.clear();
+    }
+}
+
+void cs::ShardedPacketTable::reserve(size_t expectedPackets) {
+    // hash prefixes spread packets evenly, each shard takes an equal slice
+    const size_t perShard = expectedPackets / ShardsCount + 1;
+
+    for (Shard& element : shards_) {
+        cs::Lock lock(element.mutex);
+        element.table.reserve(perShard);
+    }
+}
+
+void cs::ShardedPacketTable::forEach(const std::function<void(const cs::TransactionsPacketHash&, const cs::TransactionsPacket&)>& func) const {
+    for (const Shard& element : shards_) {
+        cs::SharedLock lock(element.mutex);
+
+        for (const auto& [hash, packet] : element.table) {
+            func(hash, packet);
+        }
+    }
+}
+
+const cs::ShardedPacketTable::Shard& cs::ShardedPacketTable::shard(const cs::TransactionsPacketHash& hash) const {
+    return shards_[shardIndex(hash)];
+}
+
+cs::ShardedPacketTable::Shard& cs::ShardedPacketTable::shard(const cs::TransactionsPacketHash& hash) {
+    return shards_[shardIndex(hash)];
+}
+
+size_t cs::ShardedPacketTable::shardIndex(const cs::TransactionsPacketHash& hash) {
+    const cs::Bytes& bytes = hash.toBinary();
+
+    if (bytes.empty()) {
+        return 0;
+    }
+
+    return static_cast<size_t>(bytes.front()) % ShardsCount;
+}
@@ -11,6 +11,7 @@
 #include <solver/smartcontracts.hpp>
 #include <csnode/smartcontracts_serializer.hpp>
 #include <csnode/serializers_helper.hpp>
+#include <lib/system/mmappedfile.hpp>
 
 #include "logger.hpp"
 
@@ -31,8 +32,8 @@ void SmartContracts_Serializer::clear(const std::filesystem::path& rootDir) {
 }
 
 void SmartContracts_Serializer::save(const std::filesystem::path& rootDir) {
-    std::ofstream ofs(rootDir / kDataFileName, std::ios::binary);
-    boost::archive::binary_oarchive oa(ofs);
+    MMappedOutput out((rootDir / kDataFileName).string());
+    boost::archive::binary_oarchive oa(out.stream());
     csdebug() << kLogPrefix << __func__;
     contracts_->printClassInfo();
     oa << contracts_->serialize();
@@ -40,10 +41,10 @@ void SmartContracts_Serializer::save(const std::filesystem::path& rootDir) {
 
 ::cscrypto::Hash SmartContracts_Serializer::hash() {
     {
-        std::ofstream ofs(kDataFileName, std::ios::binary);
+        MMappedOutput out(kDataFileName);
         {
           boost::archive::binary_oarchive oa(
-            ofs,
+            out.stream(),
             boost::archive::no_header | boost::archive::no_codecvt
           );
           csdebug() << kLogPrefix << __func__;
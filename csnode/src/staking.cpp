@@ -32,20 +32,37 @@ void Staking::cleanObsoletteDelegations(uint64_t time) {
         it = currentDelegations_.erase(it);
     }
 
-    for (auto it = miningDelegations_.begin(); it != miningDelegations_.end(); ) {
-      it->second.erase(
-          std::remove_if(it->second.begin(), it->second.end(), [delTime](const auto& keyAndTimemoney) {
-              return keyAndTimemoney.second.time < delTime;
-          }),
-          it->second.end()
-      );
-
-      if (it->second.empty()) {
-        it = miningDelegations_.erase(it);
-      }
-      else {
-        ++it;
-      }
+    auto expiryIt = miningExpiry_.begin();
+    while (expiryIt != miningExpiry_.end() && expiryIt->first < delTime) {
+        for (const auto& target : expiryIt->second) {
+            auto found = miningDelegations_.find(target);
+            if (found == miningDelegations_.end()) {
+                continue;
+            }
+
+            found->second.erase(
+                std::remove_if(found->second.begin(), found->second.end(), [delTime](const auto& keyAndTimemoney) {
+                    return keyAndTimemoney.second.time < delTime;
+                }),
+                found->second.end()
+            );
+
+            if (found->second.empty()) {
+                miningDelegations_.erase(found);
+            }
+        }
+
+        expiryIt = miningExpiry_.erase(expiryIt);
+    }
+}
+
+void Staking::rebuildMiningExpiry() {
+    miningExpiry_.clear();
+
+    for (const auto& [target, delegations] : miningDelegations_) {
+        for (const auto& keyAndTimemoney : delegations) {
+            miningExpiry_[keyAndTimemoney.second.time].push_back(target);
+        }
     }
 }
 
@@ -227,6 +244,7 @@ void Staking::addDelegationsForTarget(
         currentDelegations_[tm.time].push_back(std::make_tuple(sKey, tKey, trx_id));
         if (tm.time >= kMinDelegationForMiningSeconds_) {
           miningDelegations_[tKey].push_back({sKey, tm});
+          miningExpiry_[tm.time].push_back(tKey);
         }
     }
     else {
@@ -7,6 +7,7 @@
 #include <tokens.hpp>
 #include <csnode/tokens_serializer.hpp>
 #include <csnode/serializers_helper.hpp>
+#include <lib/system/mmappedfile.hpp>
 
 
 #include "logger.hpp"
@@ -30,17 +31,17 @@ void TokensMaster_Serializer::clear(const std::filesystem::path& rootDir) {
 }
 
 void TokensMaster_Serializer::save(const std::filesystem::path& rootDir) {
-    std::ofstream ofs(rootDir / kDataFileName);
-    boost::archive::text_oarchive oa(ofs);
+    MMappedOutput out((rootDir / kDataFileName).string());
+    boost::archive::text_oarchive oa(out.stream());
     oa << *tokens_;
     oa << *holders_;
 }
 
 ::cscrypto::Hash TokensMaster_Serializer::hash() {
     {
-        std::ofstream ofs(kDataFileName);
+        MMappedOutput out(kDataFileName);
         boost::archive::text_oarchive oa(
-          ofs,
+          out.stream(),
           boost::archive::no_header | boost::archive::no_codecvt
         );
         std::map<TokenId, Token> tmp_tokens(
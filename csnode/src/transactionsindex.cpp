@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -20,9 +21,22 @@ constexpr const char* kLastIndexedKey   = "__last_indexed__";
 constexpr const char* kIncompleteKey    = "__incomplete__";
 constexpr const char* kCompleteKey      = "__walked_complete__";
 constexpr const char* kSchemaVersionKey = "__schema_version__";
+constexpr const char* kBloomKey         = "__addr_bloom__";
+constexpr const char* kBloomSeqKey      = "__addr_bloom_seq__";
 constexpr uint32_t    kCurrentSchema    = 2;  // bumped when trimToFloor was added
 constexpr size_t      kTrimBatchSize    = 50000;
 constexpr size_t      kTrxIndexKeySize  = 40;  // 32 (pubkey) + 8 (seq)
+constexpr size_t      kBloomBytes       = 1 << 20;  // 8M bits, ~0.2% fp at 2M addresses
+
+// public keys are uniformly distributed, so four 32-bit slices of the key
+// serve as the bloom hash functions directly
+void bloomBitPositions(const cs::PublicKey& _pubKey, size_t (&_positions)[4]) {
+    for (size_t i = 0; i < 4; ++i) {
+        uint32_t slice = 0;
+        std::memcpy(&slice, _pubKey.data() + i * sizeof(slice), sizeof(slice));
+        _positions[i] = slice % (kBloomBytes * 8);
+    }
+}
 
 auto getTrxIndexKey(const cs::PublicKey& _pubKey, cs::Sequence _seq) {
     cs::Bytes ret(_pubKey.begin(), _pubKey.end());
@@ -50,6 +64,7 @@ TransactionsIndex::TransactionsIndex(BlockChain& _bc, const std::string& _path,
     }
     loadIncompleteFromDb();
     loadCompleteFlagFromDb();
+    loadBloomFromDb();
     if (db_->isOpen() && !db_->isKeyExists(kSchemaVersionKey)) {
         db_->insert(kSchemaVersionKey, kCurrentSchema);
     }
@@ -79,6 +94,7 @@ bool TransactionsIndex::looksEmpty() const {
 void TransactionsIndex::forceRebuild() {
     lastIndexedPool_ = kWrongSequence;
     recreate_ = true;
+    bloomValid_ = false;
     if (indexIncomplete_) {
         indexIncomplete_ = false;
         updateIncompleteFlag();
@@ -141,6 +157,7 @@ void TransactionsIndex::onDbReadFinished() {
     else {
         updateLastIndexed();
     }
+    saveBloom();
 }
 
 void TransactionsIndex::onRemoveBlock(const csdb::Pool& _pool) {
@@ -192,6 +209,7 @@ void TransactionsIndex::invalidate() {
 
 void TransactionsIndex::close() {
     if (db_->isOpen()) {
+        saveBloom();
         db_->flush();
         db_->close();
     }
@@ -199,7 +217,14 @@ void TransactionsIndex::close() {
 
 void TransactionsIndex::flush() {
     if (db_->isOpen()) {
+        saveBloom();
         db_->flush();
+
+        // flush marks a quiet moment between rounds, so pre-grow the map here
+        // rather than remapping under the next heavy indexing burst
+        if (db_->growIfNeeded()) {
+            csdebug() << "trxIndex map grown ahead of demand to " << db_->mapSize() << " bytes";
+        }
     }
 }
 
@@ -356,17 +381,45 @@ void TransactionsIndex::updateFromNextBlock(const csdb::Pool& _pool) {
         }
     };
 
+    // all index entries of one block are committed as one group instead of
+    // one write transaction per address
+    std::optional<cs::Lmdb::WriteBatch> batch;
+
+    if (!_pool.transactions().empty()) {
+        try {
+            batch.emplace(db_->writeBatch());
+            activeBatch_ = &batch.value();
+        }
+        catch (const lmdb::error& error) {
+            cswarning() << "trxIndex: batch begin failed, falling back to single inserts: " << error.what();
+        }
+    }
+
     for (auto& tr : _pool.transactions()) {
         lbd(tr.source());
         lbd(tr.target());
     }
 
+    if (activeBatch_ != nullptr) {
+        activeBatch_->commit();
+        activeBatch_ = nullptr;
+    }
+
     lastIndexedPool_ = _pool.sequence();
     updateLastIndexed();
 }
 
 void TransactionsIndex::setPrevTransBlock(const PublicKey& _pubKey, cs::Sequence _curr, cs::Sequence _prev) {
-    db_->insert(getTrxIndexKey(_pubKey, _curr), _prev);
+    // single write path for index entries: the bloom invariant (every stored
+    // key's address is in the filter) holds as long as inserts come through here
+    bloomAdd(_pubKey);
+
+    if (activeBatch_ != nullptr) {
+        activeBatch_->insert(getTrxIndexKey(_pubKey, _curr), _prev);
+    }
+    else {
+        db_->insert(getTrxIndexKey(_pubKey, _curr), _prev);
+    }
 }
 
 void TransactionsIndex::removeLastTransBlock(const PublicKey& _pubKey, cs::Sequence _curr) {
@@ -374,13 +427,68 @@ void TransactionsIndex::removeLastTransBlock(const PublicKey& _pubKey, cs::Seque
 }
 
 Sequence TransactionsIndex::getPrevTransBlock(const csdb::Address& _addr, Sequence _prev) const {
-    auto key = getTrxIndexKey(bc_.getAddressByType(_addr, BlockChain::AddressType::PublicKey).public_key(), _prev);
+    const auto pubKey = bc_.getAddressByType(_addr, BlockChain::AddressType::PublicKey).public_key();
+    if (!bloomMayContain(pubKey)) {
+        return kWrongSequence;
+    }
+    auto key = getTrxIndexKey(pubKey, _prev);
     if (db_->size() == 0 || !db_->isKeyExists(key)) {
         return kWrongSequence;
     }
     return db_->value<Sequence>(key);
 }
 
+std::vector<Sequence> TransactionsIndex::getPrevTransBlocks(const csdb::Address& _addr, Sequence _curr, size_t _maxHops) const {
+    std::vector<Sequence> chain;
+    if (!db_->isOpen() || db_->size() == 0 || _curr == kWrongSequence) {
+        return chain;
+    }
+
+    const auto pubKey = bc_.getAddressByType(_addr, BlockChain::AddressType::PublicKey).public_key();
+    if (!bloomMayContain(pubKey)) {
+        return chain;
+    }
+
+    try {
+        auto txn = lmdb::txn::begin(db_->env(), nullptr, MDB_RDONLY);
+        auto dbi = lmdb::dbi::open(txn, nullptr);
+        auto cur = lmdb::cursor::open(txn, dbi);
+
+        Sequence seq = _curr;
+        while (seq != kWrongSequence && chain.size() < _maxHops) {
+            const auto keyBytes = getTrxIndexKey(pubKey, seq);
+            lmdb::val k(keyBytes.data(), keyBytes.size());
+            lmdb::val v;
+            if (!cur.get(k, v, MDB_SET_KEY)) {
+                break;
+            }
+            chain.push_back(seq);
+
+            // values are stored in ASCII decimal by the wrapper
+            Sequence prev = kWrongSequence;
+            try {
+                prev = std::stoull(std::string(static_cast<const char*>(v.data()), v.size()));
+            }
+            catch (...) {
+                break;
+            }
+            if (prev == seq) {
+                // inconsistent index, don't loop forever
+                break;
+            }
+            seq = prev;
+        }
+
+        cur.close();
+        txn.abort();
+    }
+    catch (const std::exception& e) {
+        cswarning() << "trxIndex: bulk chain walk failed: " << e.what();
+    }
+
+    return chain;
+}
+
 bool TransactionsIndex::loadLastIndexedFromDb() {
     if (!db_->isOpen() || !db_->isKeyExists(kLastIndexedKey)) {
         return false;
@@ -429,6 +537,59 @@ void TransactionsIndex::updateCompleteFlag() {
     }
 }
 
+bool TransactionsIndex::bloomMayContain(const PublicKey& _pubKey) const {
+    if (!bloomValid_) {
+        return true;
+    }
+    size_t positions[4];
+    bloomBitPositions(_pubKey, positions);
+    for (size_t pos : positions) {
+        if (!(bloomBits_[pos / 8] & (1 << (pos % 8)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TransactionsIndex::bloomAdd(const PublicKey& _pubKey) {
+    if (!bloomValid_) {
+        return;
+    }
+    size_t positions[4];
+    bloomBitPositions(_pubKey, positions);
+    for (size_t pos : positions) {
+        bloomBits_[pos / 8] |= static_cast<uint8_t>(1 << (pos % 8));
+    }
+}
+
+void TransactionsIndex::loadBloomFromDb() {
+    bloomValid_ = false;
+    if (!db_->isOpen() || !db_->isKeyExists(kBloomKey) || !db_->isKeyExists(kBloomSeqKey)) {
+        return;
+    }
+    // the filter is trusted only if it was saved against the index state we
+    // just loaded; after a crash the stamp lags lastIndexedPool_ and the
+    // filter degrades to always-check instead of risking false negatives
+    if (db_->value<Sequence>(kBloomSeqKey) != lastIndexedPool_) {
+        cslog() << "trxIndex: address bloom filter is stale, lookups fall back to LMDB until the next rebuild";
+        return;
+    }
+    cs::Bytes bits = db_->value<cs::Bytes>(kBloomKey);
+    if (bits.size() != kBloomBytes) {
+        return;
+    }
+    bloomBits_ = std::move(bits);
+    bloomValid_ = true;
+}
+
+void TransactionsIndex::saveBloom() {
+    if (!bloomValid_ || !db_->isOpen()) {
+        return;
+    }
+    db_->insert(kBloomKey, bloomBits_);
+    db_->insert(kBloomSeqKey, lastIndexedPool_);
+}
+
 void TransactionsIndex::onDbFailed(const LmdbException& e) {
     cswarning() << csfunc() << ", transactions index database exception " << e.what();
 }
@@ -437,7 +598,10 @@ inline void TransactionsIndex::init() {
     Connector::connect(&db_->failed, this, &TransactionsIndex::onDbFailed);
 
     db_->setMapSize(cs::Lmdb::Default1GbMapSize);
-    db_->open();
+
+    // index lookups are point reads of pubkey+sequence keys, readahead only
+    // evicts pages that would actually be hit again
+    db_->open(cs::Lmdb::RandomAccessEnvFlags);
 }
 
 inline void TransactionsIndex::reset() {
@@ -446,5 +610,9 @@ inline void TransactionsIndex::reset() {
     db_.reset(nullptr);
     csdb::internal::path_remove(rootPath_ + kDbPath);
     db_ = std::make_unique<Lmdb>(rootPath_ + kDbPath);
+
+    // a full walk from genesis follows, which repopulates the filter
+    bloomBits_.assign(kBloomBytes, 0);
+    bloomValid_ = true;
 }
 } // namespace cs
@@ -12,6 +12,14 @@ TransactionsIterator::TransactionsIterator(const BlockChain& bc,
     setFromTransId(bc_.getLastTransaction(addr));
 }
 
+TransactionsIterator::TransactionsIterator(const BlockChain& bc,
+                                           const csdb::Address& addr,
+                                           const csdb::TransactionID& id)
+        : bc_(bc),
+          addr_(bc_.getAddressByType(addr, BlockChain::AddressType::PublicKey)) {
+    setFromTransId(id);
+}
+
 TransactionsIterator::TransactionsIterator(const BlockChain& bc, const csdb::Address& addr, const csdb::Pool& pool)
     : bc_(bc),
       addr_(bc_.getAddressByType(addr, BlockChain::AddressType::PublicKey)),
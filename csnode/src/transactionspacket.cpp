@@ -1,5 +1,7 @@
 #include "csnode/transactionspacket.hpp"
 
+#include <cstring>
+
 #include <lz4.h>
 #include <csdb/csdb.hpp>
 #include <csdb/internal/utils.hpp>
@@ -94,6 +96,18 @@ TransactionsPacket TransactionsPacket::fromBinary(const cs::Bytes& data) {
     return fromByteStream(reinterpret_cast<const char*>(data.data()), data.size());
 }
 
+uint64_t TransactionsPacket::transactionFingerprint(const csdb::Transaction& transaction) {
+    ::csdb::priv::obstream os;
+    os.put(transaction);
+
+    const cs::Bytes hash = ::csdb::priv::crypto::calc_hash(os.buffer());
+
+    uint64_t fingerprint = 0;
+    std::memcpy(&fingerprint, hash.data(), sizeof(fingerprint));
+
+    return fingerprint;
+}
+
 TransactionsPacket TransactionsPacket::fromByteStream(const char* data, size_t size) {
     ::csdb::priv::ibstream is(data, size);
 
@@ -112,9 +126,13 @@ TransactionsPacket::TransactionsPacket(TransactionsPacket&& packet)
 , transactions_(std::move(packet.transactions_))
 , stateTransactions_(std::move(packet.stateTransactions_))
 , signatures_(std::move(packet.signatures_))
-, expiredRound_(packet.expiredRound_) {
+, expiredRound_(packet.expiredRound_)
+, hashableBytes_(std::move(packet.hashableBytes_))
+, hashableValid_(packet.hashableValid_) {
     packet.hash_ = TransactionsPacketHash();
     packet.transactions_.clear();
+    packet.hashableBytes_.clear();
+    packet.hashableValid_ = true;
 }
 
 TransactionsPacket& TransactionsPacket::operator=(const TransactionsPacket& packet) {
@@ -127,6 +145,8 @@ TransactionsPacket& TransactionsPacket::operator=(const TransactionsPacket& pack
     signatures_ = packet.signatures_;
     stateTransactions_ = packet.stateTransactions_;
     expiredRound_ = packet.expiredRound_;
+    hashableBytes_ = packet.hashableBytes_;
+    hashableValid_ = packet.hashableValid_;
 
     return *this;
 }
@@ -141,11 +161,29 @@ cs::Bytes TransactionsPacket::toBinary(Serialization options) const noexcept {
     return os.buffer();
 }
 
+void TransactionsPacket::reserve(size_t transactionsCount) {
+    transactions_.reserve(transactionsCount);
+}
+
 bool TransactionsPacket::makeHash() {
     bool isEmpty = isHashEmpty();
 
     if (isEmpty) {
-        hash_ = TransactionsPacketHash::calcFromData(toBinary(Serialization::Transactions));
+        if (hashableValid_) {
+            // every transaction is already serialized in hashableBytes_,
+            // only the header is produced here
+            ::csdb::priv::obstream os;
+            os.put(expiredRound_);
+            os.put(transactions_.size());
+
+            cs::Bytes data = os.buffer();
+            data.insert(data.end(), hashableBytes_.begin(), hashableBytes_.end());
+
+            hash_ = TransactionsPacketHash::calcFromData(data);
+        }
+        else {
+            hash_ = TransactionsPacketHash::calcFromData(toBinary(Serialization::Transactions));
+        }
     }
 
     return isEmpty;
@@ -173,6 +211,15 @@ bool TransactionsPacket::addTransaction(const csdb::Transaction& transaction) {
     }
 
     transactions_.push_back(transaction);
+
+    if (hashableValid_) {
+        ::csdb::priv::obstream os;
+        os.put(transaction);
+
+        const cs::Bytes& bytes = os.buffer();
+        hashableBytes_.insert(hashableBytes_.end(), bytes.begin(), bytes.end());
+    }
+
     return true;
 }
 
@@ -277,17 +324,43 @@ const std::vector<csdb::Transaction>& TransactionsPacket::stateTransactions() co
 }
 
 std::vector<csdb::Transaction>& TransactionsPacket::transactions() {
+    // callers may edit transactions in place, the incremental buffer can not track that
+    hashableValid_ = false;
+    hashableBytes_.clear();
+
     return transactions_;
 }
 
 void TransactionsPacket::clear() noexcept {
     transactions_.clear();
+    hashableBytes_.clear();
+    hashableValid_ = true;
 }
 
 bool TransactionsPacket::isSmart() const {
     return signatures_.size() > 1;
 }
 
+size_t TransactionsPacket::estimatedByteSize() const noexcept {
+    size_t bytes = 0;
+
+    if (hashableValid_) {
+        bytes = hashableBytes_.size();
+    }
+    else {
+        for (const auto& transaction : transactions_) {
+            bytes += transaction.to_byte_stream().size();
+        }
+    }
+
+    for (const auto& state : stateTransactions_) {
+        bytes += state.to_byte_stream().size();
+    }
+
+    bytes += signatures_.size() * (sizeof(cs::Byte) + sizeof(cs::Signature));
+    return bytes;
+}
+
 //
 // Service
 //
@@ -335,6 +408,18 @@ bool TransactionsPacket::get(::csdb::priv::ibstream& is) {
         return false;
     }
 
+    // every serialized transaction carries at least its signature, so the
+    // remaining payload caps how many the packet can really contain; a
+    // forged count is rejected before it turns into an allocation
+    if (!is.hasQuotaFor(transactionsCount, sizeof(cs::Signature))) {
+        return false;
+    }
+
+    // transactions are filled bypassing addTransaction(), the hash is
+    // calculated from a full re-serialization afterwards
+    hashableValid_ = false;
+    hashableBytes_.clear();
+
     transactions_.clear();
     transactions_.reserve(transactionsCount);
 
@@ -351,6 +436,10 @@ bool TransactionsPacket::get(::csdb::priv::ibstream& is) {
     std::size_t statesCount = 0;
 
     if (is.get(statesCount)) {
+        if (!is.hasQuotaFor(statesCount, sizeof(cs::Signature))) {
+            return false;
+        }
+
         stateTransactions_.clear();
         stateTransactions_.reserve(statesCount);
 
@@ -368,6 +457,11 @@ bool TransactionsPacket::get(::csdb::priv::ibstream& is) {
     std::size_t signaturesCount = 0;
 
     if (is.get(signaturesCount)) {
+        // fixed-width entries: one index byte plus one signature each
+        if (!is.hasQuotaFor(signaturesCount, sizeof(cs::Byte) + sizeof(cs::Signature))) {
+            return false;
+        }
+
         signatures_.clear();
         signatures_.reserve(signaturesCount);
 
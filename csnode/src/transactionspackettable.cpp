@@ -0,0 +1,116 @@
+#include "csnode/transactionspackettable.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+cs::TransactionsPacketTable::TransactionsPacketTable(const TransactionsPacketTable& other)
+: storage_(other.storage_)
+, bytes_(other.bytes_) {
+    rebuildOrdered();
+}
+
+cs::TransactionsPacketTable& cs::TransactionsPacketTable::operator=(const TransactionsPacketTable& other) {
+    if (this != &other) {
+        storage_ = other.storage_;
+        bytes_ = other.bytes_;
+        rebuildOrdered();
+    }
+
+    return *this;
+}
+
+std::pair<cs::TransactionsPacket*, bool> cs::TransactionsPacketTable::emplace(cs::TransactionsPacketHash hash, cs::TransactionsPacket packet) {
+    const auto [iterator, inserted] = storage_.emplace(std::move(hash), std::move(packet));
+
+    if (inserted) {
+        insertOrdered(&*iterator);
+        bytes_ += iterator->second.estimatedByteSize();
+    }
+
+    return std::make_pair(&iterator->second, inserted);
+}
+
+cs::TransactionsPacket* cs::TransactionsPacketTable::find(const cs::TransactionsPacketHash& hash) {
+    const auto iterator = storage_.find(hash);
+    return iterator != storage_.end() ? &iterator->second : nullptr;
+}
+
+const cs::TransactionsPacket* cs::TransactionsPacketTable::find(const cs::TransactionsPacketHash& hash) const {
+    const auto iterator = storage_.find(hash);
+    return iterator != storage_.end() ? &iterator->second : nullptr;
+}
+
+const cs::TransactionsPacket& cs::TransactionsPacketTable::at(const cs::TransactionsPacketHash& hash) const {
+    return storage_.at(hash);
+}
+
+bool cs::TransactionsPacketTable::contains(const cs::TransactionsPacketHash& hash) const {
+    return storage_.count(hash) != 0;
+}
+
+bool cs::TransactionsPacketTable::erase(const cs::TransactionsPacketHash& hash) {
+    const auto iterator = storage_.find(hash);
+
+    if (iterator == storage_.end()) {
+        return false;
+    }
+
+    const auto place = std::lower_bound(ordered_.begin(), ordered_.end(), hash, [](const Entry* entry, const cs::TransactionsPacketHash& value) {
+        return entry->first < value;
+    });
+
+    // in-place edits after emplace are not tracked, never let the counter wrap
+    bytes_ -= std::min(bytes_, iterator->second.estimatedByteSize());
+
+    // the storage hit guarantees the index holds the entry at this position
+    ordered_.erase(place);
+    storage_.erase(iterator);
+
+    return true;
+}
+
+void cs::TransactionsPacketTable::reserve(size_t expectedCount) {
+    size_t capacity = 1;
+
+    while (capacity < expectedCount) {
+        capacity <<= 1;
+    }
+
+    storage_.reserve(capacity);
+    ordered_.reserve(capacity);
+}
+
+void cs::TransactionsPacketTable::insertOrdered(const Entry* entry) {
+    const auto place = std::lower_bound(ordered_.begin(), ordered_.end(), entry->first, [](const Entry* element, const cs::TransactionsPacketHash& value) {
+        return element->first < value;
+    });
+
+    ordered_.insert(place, entry);
+}
+
+void cs::TransactionsPacketTable::rebuildOrdered() {
+    ordered_.clear();
+    ordered_.reserve(storage_.size());
+
+    for (const Entry& entry : storage_) {
+        ordered_.push_back(&entry);
+    }
+
+    std::sort(ordered_.begin(), ordered_.end(), [](const Entry* lhs, const Entry* rhs) {
+        return lhs->first < rhs->first;
+    });
+}
+
+size_t cs::TransactionsPacketTable::LeadingBytesHash::operator()(const cs::TransactionsPacketHash& hash) const noexcept {
+    const cs::Bytes& bytes = hash.toBinary();
+
+    if (bytes.empty()) {
+        return 0;
+    }
+
+    uint64_t key = 0;
+    std::memcpy(&key, bytes.data(), std::min(bytes.size(), sizeof(key)));
+
+    return static_cast<size_t>(key);
+}
@@ -1,5 +1,6 @@
 #include <csnode/transactionsvalidator.hpp>
 
+#include <algorithm>
 #include <map>
 #include <vector>
 #ifdef _MSC_VER
@@ -32,6 +33,8 @@ TransactionsValidator::TransactionsValidator(WalletsState& walletsState, const C
 void TransactionsValidator::reset(size_t transactionsNum) {
     trxList_.clear();
     trxList_.resize(transactionsNum, WalletsState::noInd_);
+    targetNodes_.clear();
+    targetNodes_.resize(transactionsNum, nullptr);
     negativeNodes_.clear();
     cntRemovedTrxs_ = 0;
 }
@@ -50,7 +53,7 @@ Reject::Reason TransactionsValidator::validateNewStateAsSource(SolverContext& co
         cslog() << kLogPrefix << __func__ << ": reject smart new_state transaction, related contract is closed";
         return Reject::Reason::ContractClosed;
     }
-    csdb::Transaction initTransaction = SmartContracts::get_transaction(context.blockchain(), trx);
+    csdb::Transaction initTransaction = findStarterTransaction(context, trx);
     if (!initTransaction.is_valid()) {
         cslog() << kLogPrefix << __func__ << ": reject new_state transaction, starter transaction does not exist";
         return Reject::Reason::MalformedTransaction;
@@ -82,6 +85,39 @@ Reject::Reason TransactionsValidator::validateNewStateAsSource(SolverContext& co
     return Reject::Reason::None;
 }
 
+csdb::Transaction TransactionsValidator::findStarterTransaction(SolverContext& context, const csdb::Transaction& trx) {
+    const cs::Sequence lastSequence = context.blockchain().getLastSeq();
+    if (lastSequence < lastSeenSequence_) {
+        // the chain was rolled back, cached starters may have vanished with their blocks
+        starterTrxCache_.clear();
+    }
+    lastSeenSequence_ = lastSequence;
+
+    csdb::UserField fld = trx.user_field(trx_uf::new_state::RefStart);
+    if (!fld.is_valid()) {
+        return csdb::Transaction{};
+    }
+    SmartContractRef ref(fld);
+    if (!ref.is_valid()) {
+        return csdb::Transaction{};
+    }
+
+    const auto key = std::make_pair(ref.sequence, static_cast<size_t>(ref.transaction));
+    const auto it = starterTrxCache_.find(key);
+    if (it != starterTrxCache_.end()) {
+        return it->second;
+    }
+
+    csdb::Transaction initTransaction = SmartContracts::get_transaction(context.blockchain(), ref);
+    if (initTransaction.is_valid()) {
+        if (starterTrxCache_.size() >= maxStarterCacheSize_) {
+            starterTrxCache_.clear();
+        }
+        starterTrxCache_.emplace(key, initTransaction);
+    }
+    return initTransaction;
+}
+
 Reject::Reason TransactionsValidator::validateCommonAsSource(SolverContext& context, const Transactions& trxs, size_t trxInd, WalletsState::WalletData& wallState) {
     auto& smarts = context.smart_contracts();
     const auto trx = trxs[trxInd];
@@ -295,6 +331,9 @@ Reject::Reason TransactionsValidator::validateTransactionAsSource(SolverContext&
     csdetails() << kLogPrefix << "innerID of " << cs::SmartContracts::to_base58(context.blockchain(), trx.source()) << " <- " << trx.innerID();
     trxList_[trxInd] = wallState.lastTrxInd_;
     wallState.lastTrxInd_ = static_cast<decltype(wallState.lastTrxInd_)>(trxInd);
+    // resolve the destination wallet once, the graph removal may revisit this
+    // transaction on every chain walk and should not pay the lookup each time
+    targetNodes_[trxInd] = &walletsState_.getData(trx.target());
 
     return Reject::Reason::None;
 }
@@ -313,6 +352,13 @@ size_t TransactionsValidator::checkRejectedSmarts(SolverContext& context, const
 
     std::map<csdb::Address, csdb::Amount> smartBalances;
 
+    // group the negative-balance emissions by contract up front; the lookup
+    // below used to rescan the whole list for every new_state in the block
+    std::map<csdb::Address, std::vector<size_t>> negativeSmartIndex;
+    for (size_t i = 0; i < smartsWithNegativeBalances_.size(); ++i) {
+        negativeSmartIndex[smarts.absolute_address(smartsWithNegativeBalances_[i].first.source())].push_back(i);
+    }
+
     for (auto& state : validNewStates_) {
         auto contract_abs_addr = smarts.absolute_address(trxs[state.first].source());
 
@@ -320,13 +366,23 @@ size_t TransactionsValidator::checkRejectedSmarts(SolverContext& context, const
             continue;
         }
 
-        auto it = std::find_if(smartsWithNegativeBalances_.cbegin(), smartsWithNegativeBalances_.cend(),
-                               [&](const auto& o) { return (smarts.absolute_address(o.first.source()) == contract_abs_addr) && o.second > state.first; });
+        const auto indexIt = negativeSmartIndex.find(contract_abs_addr);
+        if (indexIt == negativeSmartIndex.end()) {
+            continue;
+        }
 
-        if (it == smartsWithNegativeBalances_.end()) {
+        // entries were appended in block order, so the first emission past the
+        // state is found by binary search within the contract's positions
+        const auto& contractPositions = indexIt->second;
+        const auto posIt = std::upper_bound(contractPositions.cbegin(), contractPositions.cend(), state.first,
+                                            [this](size_t stateIndex, size_t pos) { return smartsWithNegativeBalances_[pos].second > stateIndex; });
+
+        if (posIt == contractPositions.cend()) {
             continue;
         }
 
+        auto it = smartsWithNegativeBalances_.cbegin() + static_cast<std::ptrdiff_t>(*posIt);
+
         WalletsState::WalletData& wallState = walletsState_.getData(contract_abs_addr);
         csdb::Transaction initTransaction = SmartContracts::get_transaction(context.blockchain(), trxs[state.first]);
         wallState.balance_ += initTransaction.amount();
@@ -348,7 +404,7 @@ size_t TransactionsValidator::checkRejectedSmarts(SolverContext& context, const
         }
 
         if (wallState.balance_ >= zeroBalance_) {
-            restoredCounter += makeSmartsValid(context, smartsWithNegativeBalances_, contract_abs_addr, maskIncluded);
+            restoredCounter += makeSmartsValid(contractPositions, maskIncluded);
         }
 
         smartBalances[contract_abs_addr] = wallState.balance_;
@@ -377,20 +433,21 @@ size_t TransactionsValidator::checkRejectedSmarts(SolverContext& context, const
     return restoredCounter;
 }
 
-size_t TransactionsValidator::makeSmartsValid(SolverContext& context, RejectedSmarts& smarts, const csdb::Address& source, CharacteristicMask& maskIncluded) {
+size_t TransactionsValidator::makeSmartsValid(const std::vector<size_t>& positions, CharacteristicMask& maskIncluded) {
     size_t maskSize = maskIncluded.size();
-    auto& s = context.smart_contracts();
     size_t restoredCounter = 0;
-    for (size_t i = 0; i < smarts.size(); ++i) {
-        if (s.absolute_address(smarts[i].first.source()) == s.absolute_address(source) && smarts[i].second < maskSize) {
-            maskIncluded[smarts[i].second] = Reject::Reason::None;
+    for (size_t pos : positions) {
+        const auto& smart = smartsWithNegativeBalances_[pos];
+        if (smart.second < maskSize) {
+            maskIncluded[smart.second] = Reject::Reason::None;
             ++restoredCounter;
-            csdebug() << kLogPrefix << "source of transaction[" << smarts[i].second << "] is replenished, cancel reject";
+            csdebug() << kLogPrefix << "source of transaction[" << smart.second << "] is replenished, cancel reject";
 
-            WalletsState::WalletData& wallState = walletsState_.getData(smarts[i].first.source());
-            wallState.trxTail_.push(smarts[i].first.innerID());
-            trxList_[smarts[i].second] = wallState.lastTrxInd_;
-            wallState.lastTrxInd_ = static_cast<decltype(wallState.lastTrxInd_)>(smarts[i].second);
+            WalletsState::WalletData& wallState = walletsState_.getData(smart.first.source());
+            wallState.trxTail_.push(smart.first.innerID());
+            trxList_[smart.second] = wallState.lastTrxInd_;
+            wallState.lastTrxInd_ = static_cast<decltype(wallState.lastTrxInd_)>(smart.second);
+            targetNodes_[smart.second] = &walletsState_.getData(smart.first.target());
         }
     }
     return restoredCounter;
@@ -450,7 +507,7 @@ bool TransactionsValidator::removeTransactions_PositiveOne(SolverContext& contex
             continue;
         }
 
-        Node& destNode = walletsState_.getData(trx.target());
+        Node& destNode = *targetNodes_[trxInd];
 
         const bool isTrxPositive = (trx.amount() <= destNode.balance_);
 
@@ -490,7 +547,7 @@ bool TransactionsValidator::removeTransactions_PositiveAll(SolverContext& contex
     for (TransactionIndex trxInd = *prevNext; trxInd != WalletsState::noInd_; trxInd = *prevNext) {
         const csdb::Transaction& trx = trxs[trxInd];
 
-        Node& destNode = walletsState_.getData(trx.target());
+        Node& destNode = *targetNodes_[trxInd];
         const bool isTrxPositive = (trx.amount() <= destNode.balance_);
 
         if (!isTrxPositive) {
@@ -544,7 +601,7 @@ bool TransactionsValidator::removeTransactions_NegativeOne(SolverContext& contex
             continue;
         }
 
-        Node& destNode = walletsState_.getData(trx.target());
+        Node& destNode = *targetNodes_[trxInd];
 
         maskIncluded[trxInd] = Reject::Reason::NegativeResult;
 
@@ -579,7 +636,7 @@ bool TransactionsValidator::removeTransactions_NegativeAll(SolverContext& contex
     for (TransactionIndex trxInd = *prevNext; trxInd != WalletsState::noInd_; trxInd = *prevNext) {
         const csdb::Transaction& trx = trxs[trxInd];
 
-        Node& destNode = walletsState_.getData(trx.target());
+        Node& destNode = *targetNodes_[trxInd];
 
         maskIncluded[trxInd] = Reject::Reason::NegativeResult;
 
@@ -7,6 +7,7 @@
 #include <csnode/staking.hpp>
 #include <csnode/walletscache.hpp>
 #include <csnode/walletsids.hpp>
+#include <lib/system/base58.hpp>
 #include <lib/system/logger.hpp>
 #include <solver/smartcontracts.hpp>
 #include <solver/consensus.hpp>
@@ -23,12 +24,19 @@ WalletsCache::WalletsCache(WalletsIds& walletsIds) : walletsIds_(walletsIds) {
     multiWallets_ = std::make_unique<MultiWallets>();
     staking_ = std::make_unique<Staking>(
       [this](const PublicKey& k) -> WalletData {
+          if (activeUpdater_ != nullptr) {
+              return activeUpdater_->getWalletData(k);
+          }
           WalletData data;
           data.key_ = k;
           multiWallets_->getWalletData(data);
           return data;
       },
       [this](const WalletsCache::WalletData& wallet) {
+          if (activeUpdater_ != nullptr) {
+              activeUpdater_->walletUpdated(wallet);
+              return;
+          }
           multiWallets_->onWalletCacheUpdated(wallet);
       }
     );
@@ -63,12 +71,34 @@ std::unique_ptr<WalletsCache::WalletData> WalletsCache::Updater::findWallet(cons
 }
 
 WalletsCache::WalletData WalletsCache::Updater::getWalletData(const PublicKey& key) {
+  if (stagingActive_) {
+      auto it = staged_.find(key);
+      if (it != staged_.end()) {
+          return it->second;
+      }
+  }
   WalletsCache::WalletData data;
   data.key_ = key;
   data_.multiWallets_->getWalletData(data);
   return data;
 }
 
+void WalletsCache::Updater::walletUpdated(const WalletData& wallet) {
+    if (stagingActive_) {
+        staged_[wallet.key_] = wallet;
+        return;
+    }
+    data_.multiWallets_->onWalletCacheUpdated(wallet);
+}
+
+void WalletsCache::Updater::flushStaged() {
+    for (const auto& entry : staged_) {
+        data_.multiWallets_->onWalletCacheUpdated(entry.second);
+    }
+    // keep the buckets, the next block tends to touch a similar working set
+    staged_.clear();
+}
+
 WalletsCache::WalletData WalletsCache::Updater::getWalletData(const csdb::Address& addr) {
   return getWalletData(toPublicKey(addr));
 }
@@ -121,7 +151,7 @@ void WalletsCache::Updater::fundConfidantsWalletsWitnReward(const cs::Confidants
         //csdebug() << "fundConfidantsWalletsWitnReward -> " << cs::Utils::byteStreamToHex(confidants[i]) << ", Mined: " << reward.to_string();
         ++numPayedTrusted;
 
-        data_.multiWallets_->onWalletCacheUpdated(walletData);
+        walletUpdated(walletData);
     }
 }
 
@@ -130,6 +160,10 @@ void WalletsCache::Updater::loadNextBlock(const csdb::Pool& pool,
                                           const cs::ConfidantsKeys& confidants,
                                           const BlockChain& blockchain,
                                           bool inverse /* = false */) {
+    // collect every wallet mutation of this block in staged_ and push the
+    // final states into the multi-index container once, see flushStaged()
+    stagingActive_ = true;
+    data_.activeUpdater_ = this;
 
     auto ufld = pool.user_field(BlockChain::kFieldTimestamp);
     uint64_t timeStamp;
@@ -155,13 +189,14 @@ void WalletsCache::Updater::loadNextBlock(const csdb::Pool& pool,
     }
 
     auto& transactions = pool.transactions();
-    csdb::Amount totalAmountOfCountedFee = 0;
+    // replay does millions of these additions, normalize the sum once per block only
+    csdb::AmountAccumulator countedFeeAccumulator;
     //if (!transactions.empty()) {
     //    csdebug() << "Start block: " << pool.sequence();
     //}
     for (auto itTrx = transactions.begin(); itTrx != transactions.end(); ++itTrx) {
         //csdebug() << "Start transaction: " << itTrx->id().to_string();
-        totalAmountOfCountedFee += load(*itTrx, blockchain, timeStamp, inverse);
+        countedFeeAccumulator += load(*itTrx, blockchain, timeStamp, inverse);
         if (SmartContracts::is_new_state(*itTrx)) {
             //csdebug() << "Start conf funding for execution";
             fundConfidantsWalletsWithExecFee(*itTrx, blockchain, inverse);
@@ -170,6 +205,7 @@ void WalletsCache::Updater::loadNextBlock(const csdb::Pool& pool,
         //csdebug() << "Finish transaction";
     }
 
+    const csdb::Amount totalAmountOfCountedFee = countedFeeAccumulator.value();
     if (totalAmountOfCountedFee > csdb::Amount(0)) {
         fundConfidantsWalletsWithFee(totalAmountOfCountedFee, confidants,
                                      cs::Utils::bitsToMask(pool.numberTrusted(), pool.realTrusted()),
@@ -221,6 +257,9 @@ void WalletsCache::Updater::loadNextBlock(const csdb::Pool& pool,
         csdebug() << "Finish block, total caches: " << data_.multiWallets_->checkWallets().to_string();
     }
 */
+    data_.activeUpdater_ = nullptr;
+    stagingActive_ = false;
+    flushStaged();
 }
 
 void WalletsCache::Updater::invokeReplenishPayableContract(const csdb::Transaction& transaction, bool inverse /* = false */) {
@@ -249,10 +288,10 @@ void WalletsCache::Updater::invokeReplenishPayableContract(const csdb::Transacti
             sourceWallData.balance_ += csdb::Amount(transaction.max_fee().to_double());
         }
 
-        data_.multiWallets_->onWalletCacheUpdated(sourceWallData);
+        walletUpdated(sourceWallData);
     }
 
-    data_.multiWallets_->onWalletCacheUpdated(wallData);
+    walletUpdated(wallData);
 }
 
 void WalletsCache::Updater::smartSourceTransactionReleased(const csdb::Transaction& smartSourceTrx,
@@ -274,8 +313,8 @@ void WalletsCache::Updater::smartSourceTransactionReleased(const csdb::Transacti
         initWallData.balance_ += countedFee;
     }
 
-    data_.multiWallets_->onWalletCacheUpdated(smartWallData);
-    data_.multiWallets_->onWalletCacheUpdated(initWallData);
+    walletUpdated(smartWallData);
+    walletUpdated(initWallData);
 }
 
 void WalletsCache::Updater::rollbackExceededTimeoutContract(const csdb::Transaction& transaction,
@@ -328,7 +367,7 @@ void WalletsCache::Updater::rollbackExceededTimeoutContract(const csdb::Transact
         }
     }
 
-    data_.multiWallets_->onWalletCacheUpdated(wallData);
+    walletUpdated(wallData);
 }
 
 #ifdef MONITOR_NODE
@@ -339,7 +378,7 @@ bool WalletsCache::Updater::setWalletTime(const PublicKey& address, const uint64
     if (wData.createTime_ == 0) {
         wData.createTime_ = p_timeStamp;
     }
-    data_.multiWallets_->onWalletCacheUpdated(wData);
+    walletUpdated(wData);
     return true;
 }
 #endif
@@ -410,7 +449,7 @@ void WalletsCache::Updater::fundConfidantsWalletsWithFee(const csdb::Amount& tot
         payedFee += feeToPay;
         ++numPayedTrusted;
 
-        data_.multiWallets_->onWalletCacheUpdated(walletData);
+        walletUpdated(walletData);
     }
 }
 
@@ -573,14 +612,14 @@ double WalletsCache::Updater::loadTrxForSource(const csdb::Transaction& tr,
 
             auto pubKey = toPublicKey(tr.source());
             csdetails() << "Wallets: innerID of (new_state) "
-                        << EncodeBase58(cs::Bytes(pubKey.begin(), pubKey.end()))
+                        << cs::Base58::encode(pubKey)
                         << " <- " << tr.innerID();
         }
         else {
             --wallData_s.transNum_;
         }
 
-        data_.multiWallets_->onWalletCacheUpdated(wallData_s);
+        walletUpdated(wallData_s);
     }
     else {
         if (!inverse) {
@@ -616,7 +655,7 @@ double WalletsCache::Updater::loadTrxForSource(const csdb::Transaction& tr,
 
             auto pubKey = toPublicKey(wallAddress);
             csdetails() << "Wallets: innerID of "
-                        << EncodeBase58(cs::Bytes(pubKey.begin(), pubKey.end()))
+                        << cs::Base58::encode(pubKey)
                         << " <- " << tr.innerID();
 
 #ifdef MONITOR_NODE
@@ -651,14 +690,14 @@ double WalletsCache::Updater::loadTrxForSource(const csdb::Transaction& tr,
         auto wallData_s = getWalletData(wallAddress);
         auto pubKey = toPublicKey(wallAddress);
         csdetails() << "Wallets: erase innerID of "
-            << EncodeBase58(cs::Bytes(pubKey.begin(), pubKey.end()))
+            << cs::Base58::encode(pubKey)
             << " -> " << tr.innerID();
         wallData_s.trxTail_.erase(tr.innerID());
-        data_.multiWallets_->onWalletCacheUpdated(wallData_s);
+        walletUpdated(wallData_s);
     }
 
     if(!alreadyUpdated){
-        data_.multiWallets_->onWalletCacheUpdated(wallData);
+        walletUpdated(wallData);
     }
 
     if (!smartIniter) {
@@ -753,7 +792,7 @@ void WalletsCache::Updater::checkSmartWaitingForMoney(const csdb::Transaction& i
             wallDataIniter.balance_ += csdb::Amount(newStateTransaction.counted_fee().to_double());
             logOperation("Contract counted fee (reverted): +", initTransaction.source().public_key(), csdb::Amount(newStateTransaction.counted_fee().to_double()));
         }
-        data_.multiWallets_->onWalletCacheUpdated(wallDataIniter);
+        walletUpdated(wallDataIniter);
         return;
     }
     bool waitingSmart = false;
@@ -777,8 +816,8 @@ void WalletsCache::Updater::checkSmartWaitingForMoney(const csdb::Transaction& i
             auto wallData = getWalletData(initTransaction.target());
             wallData.balance_ -= initTransaction.amount();
 
-            data_.multiWallets_->onWalletCacheUpdated(wallDataIniter);
-            data_.multiWallets_->onWalletCacheUpdated(wallData);
+            walletUpdated(wallDataIniter);
+            walletUpdated(wallData);
         }
     }
 
@@ -797,8 +836,8 @@ void WalletsCache::Updater::checkSmartWaitingForMoney(const csdb::Transaction& i
         wallData.balance_ += initTransaction.amount();
         logOperation("Init transactions +", wallData.key_, initTransaction.amount());
 
-        data_.multiWallets_->onWalletCacheUpdated(wallDataIniter);
-        data_.multiWallets_->onWalletCacheUpdated(wallData);
+        walletUpdated(wallDataIniter);
+        walletUpdated(wallData);
     }
 }
 
@@ -852,7 +891,7 @@ void WalletsCache::Updater::loadTrxForTarget(const csdb::Transaction& tr, const
         !inverse ? ++wallData.transNum_ : --wallData.transNum_;
     }
     
-    data_.multiWallets_->onWalletCacheUpdated(wallData);
+    walletUpdated(wallData);
 
     if (!inverse) {
         if (ufld.is_valid()) {
@@ -906,7 +945,7 @@ void WalletsCache::Updater::updateLastTransactions(const std::vector<std::pair<P
         }
 
         wallet.lastTransaction_ = u.second;
-        data_.multiWallets_->onWalletCacheUpdated(wallet);
+        walletUpdated(wallet);
     }
 }
 
@@ -11,6 +11,7 @@
 #include <csnode/multiwallets.hpp>
 #include <csnode/staking.hpp>
 #include <csnode/serializers_helper.hpp>
+#include <lib/system/mmappedfile.hpp>
 
 #include "logger.hpp"
 
@@ -30,6 +31,7 @@ void WalletsCache_Serializer::bind(WalletsCache& wCache) {
 #endif
     currentDelegations_ = reinterpret_cast<decltype(currentDelegations_)>(&wCache.staking_->currentDelegations_);
     miningDelegations_ = reinterpret_cast<decltype(miningDelegations_)>(&wCache.staking_->miningDelegations_);
+    staking_ = wCache.staking_.get();
     csdebug() << "WalletsCaches bindings made";
 }
 
@@ -43,11 +45,12 @@ void WalletsCache_Serializer::clear(const std::filesystem::path& rootDir) {
 #endif
     currentDelegations_->clear();
     miningDelegations_->clear();
+    staking_->rebuildMiningExpiry();
 }
 
 void WalletsCache_Serializer::save(const std::filesystem::path& rootDir) {
-    std::ofstream ofs(rootDir / kDataFileName, std::ios::binary);
-    boost::archive::text_oarchive oa(ofs);
+    MMappedOutput out((rootDir / kDataFileName).string());
+    boost::archive::text_oarchive oa(out.stream());
     oa << *smartPayableTransactions_;
     oa << *canceledSmarts_;
     oa << *wallets_;
@@ -60,9 +63,9 @@ void WalletsCache_Serializer::save(const std::filesystem::path& rootDir) {
 
 ::cscrypto::Hash WalletsCache_Serializer::hash() {
     {
-      std::ofstream ofs(kTmpDataFile);
+      MMappedOutput out(kTmpDataFile);
       boost::archive::text_oarchive oa(
-        ofs,
+        out.stream(),
         boost::archive::no_header | boost::archive::no_codecvt
       );
       oa << *smartPayableTransactions_;
@@ -107,5 +110,6 @@ void WalletsCache_Serializer::load(const std::filesystem::path& rootDir) {
 #endif
     ia >> *currentDelegations_;
     ia >> *miningDelegations_;
+    staking_->rebuildMiningExpiry();
 }
 }  // namespace cs
@@ -1,11 +1,186 @@
 #include <csnode/walletsids.hpp>
 #include <lib/system/logger.hpp>
 #include <lib/system/utils.hpp>
+#include <cstring>
 #include <limits>
 
 using namespace std;
 
+namespace {
+constexpr uint64_t kLsbMask = 0x0101010101010101ULL;
+constexpr uint64_t kMsbMask = 0x8080808080808080ULL;
+
+inline bool hasZeroByte(uint64_t word) {
+    return ((word - kLsbMask) & ~word & kMsbMask) != 0;
+}
+
+inline uint64_t loadWord(const cs::Byte* bytes) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+// public keys are uniformly distributed already, the first word is a
+// ready-made hash
+inline uint64_t keyHash(const cs::PublicKey& key) {
+    return loadWord(key.data());
+}
+
+// seven hash bits with the high bit set, so a fragment never collides with
+// the empty or tombstone control values
+inline cs::Byte keyFragment(uint64_t hash) {
+    return static_cast<cs::Byte>((hash & 0x7F) | 0x80);
+}
+}  // namespace
+
 namespace cs {
+WalletsIds::FlatIndex::FlatIndex() {
+    rehash(kInitialCapacity);
+}
+
+bool WalletsIds::FlatIndex::find(const cs::PublicKey& key, WalletId& id) const {
+    const uint64_t hash = keyHash(key);
+    const cs::Byte fragment = keyFragment(hash);
+    const size_t groupCount = control_.size() / kGroupSize;
+
+    size_t group = hash & (groupCount - 1);
+
+    for (;;) {
+        const size_t base = group * kGroupSize;
+        const uint64_t word = loadWord(control_.data() + base);
+
+        if (hasZeroByte(word ^ (kLsbMask * fragment))) {
+            for (size_t i = 0; i < kGroupSize; ++i) {
+                if (control_[base + i] == fragment && slots_[base + i].first == key) {
+                    id = slots_[base + i].second;
+                    return true;
+                }
+            }
+        }
+
+        // an empty slot in the group means the probe chain ends here
+        if (hasZeroByte(word)) {
+            return false;
+        }
+
+        group = (group + 1) & (groupCount - 1);
+    }
+}
+
+void WalletsIds::FlatIndex::insert(const cs::PublicKey& key, WalletId id) {
+    if ((used_ + 1) * 8 >= control_.size() * 7) {
+        rehash(control_.size() * 2);
+    }
+
+    const uint64_t hash = keyHash(key);
+    const cs::Byte fragment = keyFragment(hash);
+    const size_t groupCount = control_.size() / kGroupSize;
+    const size_t npos = std::numeric_limits<size_t>::max();
+
+    size_t group = hash & (groupCount - 1);
+    size_t insertPos = npos;
+
+    for (;;) {
+        const size_t base = group * kGroupSize;
+        const uint64_t word = loadWord(control_.data() + base);
+
+        if (hasZeroByte(word ^ (kLsbMask * fragment))) {
+            for (size_t i = 0; i < kGroupSize; ++i) {
+                if (control_[base + i] == fragment && slots_[base + i].first == key) {
+                    slots_[base + i].second = id;
+                    return;
+                }
+            }
+        }
+
+        if (insertPos == npos) {
+            for (size_t i = 0; i < kGroupSize; ++i) {
+                if (control_[base + i] == kEmpty || control_[base + i] == kTombstone) {
+                    insertPos = base + i;
+                    break;
+                }
+            }
+        }
+
+        if (hasZeroByte(word)) {
+            break;
+        }
+
+        group = (group + 1) & (groupCount - 1);
+    }
+
+    if (control_[insertPos] == kEmpty) {
+        ++used_;
+    }
+
+    control_[insertPos] = fragment;
+    slots_[insertPos] = {key, id};
+    ++size_;
+}
+
+void WalletsIds::FlatIndex::erase(const cs::PublicKey& key) {
+    const uint64_t hash = keyHash(key);
+    const cs::Byte fragment = keyFragment(hash);
+    const size_t groupCount = control_.size() / kGroupSize;
+
+    size_t group = hash & (groupCount - 1);
+
+    for (;;) {
+        const size_t base = group * kGroupSize;
+        const uint64_t word = loadWord(control_.data() + base);
+
+        if (hasZeroByte(word ^ (kLsbMask * fragment))) {
+            for (size_t i = 0; i < kGroupSize; ++i) {
+                if (control_[base + i] == fragment && slots_[base + i].first == key) {
+                    // tombstone keeps longer probe chains walkable
+                    control_[base + i] = kTombstone;
+                    --size_;
+                    return;
+                }
+            }
+        }
+
+        if (hasZeroByte(word)) {
+            return;
+        }
+
+        group = (group + 1) & (groupCount - 1);
+    }
+}
+
+void WalletsIds::FlatIndex::clear() {
+    control_.assign(control_.size(), kEmpty);
+    slots_.assign(slots_.size(), {});
+    size_ = 0;
+    used_ = 0;
+}
+
+void WalletsIds::FlatIndex::rehash(size_t capacity) {
+    const auto oldControl = std::move(control_);
+    const auto oldSlots = std::move(slots_);
+
+    control_.assign(capacity, kEmpty);
+    slots_.assign(capacity, {});
+    size_ = 0;
+    used_ = 0;
+
+    for (size_t i = 0; i < oldControl.size(); ++i) {
+        if (oldControl[i] != kEmpty && oldControl[i] != kTombstone) {
+            insert(oldSlots[i].first, oldSlots[i].second);
+        }
+    }
+}
+
+void WalletsIds::rebuildIndex() {
+    index_.clear();
+
+    for (const auto& wallet : data_) {
+        if (wallet.address.is_public_key()) {
+            index_.insert(wallet.address.public_key(), wallet.id);
+        }
+    }
+}
+
 WalletsIds::WalletsIds()
 : nextId_(0) {
     norm_.reset(new Normal(*this));
@@ -24,11 +199,15 @@ bool WalletsIds::Normal::insert(const WalletAddress& address, WalletId id) {
     }
     else if (address.is_public_key()) {
         auto res = norm_.data_.insert({address, id});
-        if (res.second && id >= norm_.nextId_) {
-            if (id >= numeric_limits<WalletId>::max() / 2)
-                throw runtime_error("idNormal >= numeric_limits<WalletId>::max() / 2");
+        if (res.second) {
+            norm_.index_.insert(address.public_key(), id);
+
+            if (id >= norm_.nextId_) {
+                if (id >= numeric_limits<WalletId>::max() / 2)
+                    throw runtime_error("idNormal >= numeric_limits<WalletId>::max() / 2");
 
-            norm_.nextId_ = id + 1;
+                norm_.nextId_ = id + 1;
+            }
         }
         return res.second;
     }
@@ -42,13 +221,7 @@ bool WalletsIds::Normal::find(const WalletAddress& address, WalletId& id) const
         return true;
     }
     else if (address.is_public_key()) {
-        const auto &index = norm_.data_.get<Wallet::byAddress>();
-        auto it = index.find(address);
-        if (it == index.end()) {
-            return false;
-        }
-        id = (*it).id;
-        return true;
+        return norm_.index_.find(address.public_key(), id);
     }
     cserror() << "Wrong address";
     return false;
@@ -71,11 +244,17 @@ bool WalletsIds::Normal::get(const WalletAddress& address, WalletId& id) {
         return false;
     }
     else if (address.is_public_key()) {
+        // hot path, existing wallets resolve without touching data_
+        if (norm_.index_.find(address.public_key(), id)) {
+            return false;
+        }
+
         auto res = norm_.data_.insert({address, norm_.nextId_});
         if (res.second) {
             if (norm_.nextId_ >= numeric_limits<WalletId>::max() / 2)
                 throw runtime_error("nextId_ >= numeric_limits<WalletId>::max() / 2");
             ++norm_.nextId_;
+            norm_.index_.insert(address.public_key(), (*res.first).id);
         }
         id = (*res.first).id;
         return res.second;
@@ -94,8 +273,8 @@ void WalletsIds::Normal::fillIds(std::map<csdb::Address, std::pair<WalletId, csd
         }
 
         if (addrAndId.first.is_public_key()) {
-            auto it = norm_.data_.find(addrAndId.first);
-            if (it != norm_.data_.end()) {
+            WalletId existingId;
+            if (norm_.index_.find(addrAndId.first.public_key(), existingId)) {
                 addrAndId.second.first = kWrongWalletId;
             }
             else {
@@ -118,6 +297,7 @@ bool WalletsIds::Normal::remove(const WalletAddress& address) {
     auto it = index.find(address);
     if (it != index.end()) {
         norm_.data_.erase(it);
+        norm_.index_.erase(address.public_key());
         if (norm_.nextId_ > 0) {
             --norm_.nextId_;
         }
@@ -11,6 +11,7 @@
 #include <csnode/walletsids.hpp>
 #include <csnode/walletsids_serializer.hpp>
 #include <csnode/serializers_helper.hpp>
+#include <lib/system/mmappedfile.hpp>
 
 #include "logger.hpp"
 
@@ -20,6 +21,7 @@ const std::string kDataFileName = "walletsids.dat";
 
 namespace cs {
 void WalletsIds_Serializer::bind(WalletsIds& ids) {
+    ids_ = &ids;
     data_ = reinterpret_cast<decltype(data_)>(&ids.data_);
     nextId_ = &ids.nextId_;
     csdebug() << "WalletsIds bindings made";
@@ -29,20 +31,21 @@ void WalletsIds_Serializer::clear(const std::filesystem::path& rootDir) {
     (void)rootDir;
     data_->clear();
     *nextId_ = 0;
+    ids_->rebuildIndex();
 }
 
 void WalletsIds_Serializer::save(const std::filesystem::path& rootDir) {
-    std::ofstream ofs(rootDir / kDataFileName, std::ios::binary);
-    boost::archive::binary_oarchive oa(ofs);
+    MMappedOutput out((rootDir / kDataFileName).string());
+    boost::archive::binary_oarchive oa(out.stream());
     oa << *data_;
     oa << *nextId_;
 }
 
 ::cscrypto::Hash WalletsIds_Serializer::hash() {
     {
-        std::ofstream ofs(kDataFileName, std::ios::binary);
+        MMappedOutput out(kDataFileName);
         boost::archive::binary_oarchive oa(
-          ofs,
+          out.stream(),
           boost::archive::no_header | boost::archive::no_codecvt
         );
         auto& data_ref = data_->get<0>();
@@ -68,5 +71,6 @@ void WalletsIds_Serializer::load(const std::filesystem::path& rootDir) {
     boost::archive::binary_iarchive ia(ifs);
     ia >> *data_;
     ia >> *nextId_;
+    ids_->rebuildIndex();
 }
 }  // namespace cs
@@ -2,27 +2,66 @@
 
 namespace cs {
 
-WalletsState::WalletData& WalletsState::getData(const WalletAddress& address) {
+PublicKey WalletsState::toCachedPublicKey(const WalletAddress& address) {
+    if (address.is_public_key()) {
+        return address.public_key();
+    }
+
+    auto memoIt = idMemo_.find(address.wallet_id());
+    if (memoIt != idMemo_.end()) {
+        return memoIt->second;
+    }
+
     auto pubKey = wallCache_.toPublicKey(address);
+    idMemo_.emplace(address.wallet_id(), pubKey);
+    return pubKey;
+}
+
+WalletsState::WalletData& WalletsState::materialize(const PublicKey& pubKey) {
+    auto walletPtr = wallCache_.findWallet(pubKey);
+    if (walletPtr) {
+        auto res = storage_.insert(std::make_pair(pubKey,
+                                                  WalletData{noInd_,
+                                                             walletPtr->balance_,
+                                                             walletPtr->delegated_,
+                                                             walletPtr->delegateSources_ ? *walletPtr->delegateSources_ : std::map<cs::PublicKey, std::vector<cs::TimeMoney>>{},// accounts, delegated to current account
+                                                             walletPtr->delegateTargets_ ? *walletPtr->delegateTargets_ : std::map<cs::PublicKey, std::vector<cs::TimeMoney>>{},// accounts to which current round delegated special amounts
+                                                             walletPtr->trxTail_}));
+        return res.first->second;
+    }
+    else {
+        auto res = storage_.insert(std::make_pair(pubKey, WalletData{noInd_}));
+        return res.first->second;
+    }
+}
+
+WalletsState::WalletData& WalletsState::getData(const WalletAddress& address) {
+    auto pubKey = toCachedPublicKey(address);
     auto it = storage_.find(pubKey);
     if (it != storage_.end()) {
         return it->second;
     }
-    else {
-        auto walletPtr = wallCache_.findWallet(address);
-        if (walletPtr) {
-            auto res = storage_.insert(std::make_pair(pubKey,
-                                                      WalletData{noInd_,
-                                                                 walletPtr->balance_,
-                                                                 walletPtr->delegated_,
-                                                                 walletPtr->delegateSources_ ? *walletPtr->delegateSources_ : std::map<cs::PublicKey, std::vector<cs::TimeMoney>>{},// accounts, delegated to current account
-                                                                 walletPtr->delegateTargets_ ? *walletPtr->delegateTargets_ : std::map<cs::PublicKey, std::vector<cs::TimeMoney>>{},// accounts to which current round delegated special amounts 
-                                                                 walletPtr->trxTail_}));
-            return res.first->second;
+
+    return materialize(pubKey);
+}
+
+void WalletsState::roundSnapshot(const std::vector<csdb::Transaction>& transactions) {
+    storage_.clear();
+    // the memo must not survive rounds: wallet ids of removed blocks may be reassigned
+    idMemo_.clear();
+
+    storage_.reserve(transactions.size());
+    idMemo_.reserve(transactions.size());
+
+    for (const auto& transaction : transactions) {
+        const auto source = toCachedPublicKey(transaction.source());
+        if (storage_.find(source) == storage_.end()) {
+            materialize(source);
         }
-        else {
-            auto res = storage_.insert(std::make_pair(pubKey, WalletData{noInd_}));
-            return res.first->second;
+
+        const auto target = toCachedPublicKey(transaction.target());
+        if (storage_.find(target) == storage_.end()) {
+            materialize(target);
         }
     }
 }
@@ -8,6 +8,8 @@
 
 namespace dbsql {
 void saveConfidants(uint64_t round, const std::vector<cs::PublicKey>& confidants, uint64_t mask);
+// flushes the export queue and stops its writer thread
+void stopExport();
 }
 
 #endif // ROUNDINFO_H
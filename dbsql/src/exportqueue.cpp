@@ -0,0 +1,101 @@
+#include "exportqueue.h"
+
+#include <iostream>
+#include <utility>
+
+#include "pgbackend.h"
+
+#include <cscrypto/cscrypto.hpp>
+
+namespace dbsql {
+ExportQueue::ExportQueue() {
+  writer_ = std::thread(&ExportQueue::routine, this);
+}
+
+ExportQueue::~ExportQueue() {
+  stop();
+}
+
+ExportQueue& ExportQueue::instance() {
+  static ExportQueue instance;
+  return instance;
+}
+
+void ExportQueue::push(ConfidantsRecord&& record) {
+  {
+    std::lock_guard<std::mutex> lock_(mutex_);
+    if (stopped_) {
+      return;
+    }
+    if (queue_.size() >= CAPACITY) {
+      queue_.pop_front();
+      ++dropped_;
+    }
+    queue_.push_back(std::move(record));
+  }
+  condition_.notify_one();
+}
+
+void ExportQueue::stop() {
+  {
+    std::lock_guard<std::mutex> lock_(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  condition_.notify_one();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  if (dropped_ > 0) {
+    std::cout << "dbsql: " << dropped_ << " export record(s) dropped\n";
+  }
+}
+
+void ExportQueue::routine() {
+  for (;;) {
+    std::vector<ConfidantsRecord> batch;
+    {
+      std::unique_lock<std::mutex> lock_(mutex_);
+      condition_.wait(lock_, [this] { return stopped_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      while (!queue_.empty() && batch.size() < BATCH_LIMIT) {
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+    }
+    writeBatch(batch);
+  }
+}
+
+void ExportQueue::writeBatch(const std::vector<ConfidantsRecord>& batch) {
+  auto conn = PGBackend::instance().connection();
+
+  // all statements of the batch travel in one simple-query message, so the
+  // whole batch costs a single server round trip and runs as one transaction
+  std::string query;
+  for (auto& record : batch) {
+    int index = 0;
+    for (auto& pkey : record.confidants) {
+      auto pk58 = EncodeBase58(pkey.data(), pkey.data() + pkey.size());
+      std::string trusted = record.mask & (1 << index++) ? "'t'" : "'f'";
+      query += "INSERT INTO public_keys(public_key)"
+               "SELECT'" + pk58 + "'"
+               "WHERE"
+               "  NOT EXISTS ("
+               "    SELECT public_key FROM public_keys WHERE public_key = '" + pk58 + "'"
+               "  );";
+      query += "INSERT INTO round_info(round_num, public_id, real_trusted)"
+               "VALUES(" + std::to_string(record.round) +
+               ", (SELECT id from public_keys WHERE public_key='" + pk58 + "')"
+               ", " + trusted + ");";
+    }
+  }
+  sendQuery(conn, query);
+
+  PGBackend::instance().freeConnection(conn);
+}
+}  // namespace dbsql
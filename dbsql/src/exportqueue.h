@@ -0,0 +1,52 @@
+#ifndef EXPORTQUEUE_H
+#define EXPORTQUEUE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace dbsql {
+// decouples SQL export from the block-store path: callers only append a
+// record to the bounded queue, a dedicated writer thread batches queued
+// records into one multi-statement query per connection round trip. A slow
+// or unreachable Postgres fills the queue and drops the oldest records, it
+// can never stall block storage
+class ExportQueue {
+public:
+  struct ConfidantsRecord {
+    uint64_t round;
+    std::vector<cs::PublicKey> confidants;
+    uint64_t mask;
+  };
+
+  static ExportQueue& instance();
+
+  void push(ConfidantsRecord&& record);
+  // flushes queued records and joins the writer thread
+  void stop();
+
+private:
+  ExportQueue();
+  ~ExportQueue();
+
+  void routine();
+  void writeBatch(const std::vector<ConfidantsRecord>& batch);
+
+  static constexpr size_t CAPACITY = 4096;
+  static constexpr size_t BATCH_LIMIT = 256;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<ConfidantsRecord> queue_;
+  uint64_t dropped_ = 0;
+  bool stopped_ = false;
+  std::thread writer_;
+};
+}  // namespace dbsql
+
+#endif // EXPORTQUEUE_H
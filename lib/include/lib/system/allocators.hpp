@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <thread>
 #include <memory>
+#include <vector>
 
 #include "cache.hpp"
 #include "logger.hpp"
@@ -44,9 +45,7 @@ public:
         return size_;
     }
 
-    ~Region() {
-        delete [] data_;
-    }
+    inline ~Region();
 
     void setSize(uint32_t size) {
         size_ = size;
@@ -54,12 +53,16 @@ public:
 
     explicit Region(cs::Byte* data, const uint32_t size, RegionPrivate)
     : data_(data)
-    , size_(size) {
+    , size_(size)
+    , capacity_(size) {
     }
 
 private:
-    static RegionPtr create(cs::Byte* data, const uint32_t size) {
-        return std::make_shared<Region>(data, size, RegionPrivate());
+    static RegionPtr create(cs::Byte* data, const uint32_t size, const uint32_t capacity, RegionAllocator* allocator) {
+        auto region = std::make_shared<Region>(data, size, RegionPrivate());
+        region->capacity_ = capacity;
+        region->allocator_ = allocator;
+        return region;
     }
 
     Region(const Region&) = delete;
@@ -68,7 +71,9 @@ private:
     Region& operator=(Region&&) = delete;
 
     cs::Byte* data_;
-    uint32_t size_;
+    uint32_t size_;                          // payload size, may be shrunk via setSize()
+    uint32_t capacity_;                      // allocated buffer size, stays as allocated
+    RegionAllocator* allocator_ = nullptr;   // where to return the buffer, heap delete when null
 
     friend class RegionAllocator;
     friend class Network;
@@ -121,31 +126,169 @@ private:
     cs::Bytes bytes_;
 };
 
-/* ActivePage points to a page with some free memory.
-   - If its free memory isn't enough to complete an alloc request,
-     ActivePage->nextPage becomes the next ActivePage;
-   - If there is no ActivePage->nextPage, we allocate another page.
-   - Whenever memory is freed on a page, if it is now empty, it
-     becomes the ActivePage->nextPage */
+// non-owning view of compressed bytes, allows parsing network payload in place
+// without copying it to CompressedRegion, caller should guarantee data lifetime
+class CompressedRegionView {
+public:
+    CompressedRegionView() = default;
+    CompressedRegionView(const CompressedRegionView&) = default;
+    CompressedRegionView& operator=(const CompressedRegionView&) = default;
+
+    CompressedRegionView(const cs::Byte* data, size_t size, size_t binarySize)
+    : binarySize_(binarySize)
+    , data_(data)
+    , size_(size) {
+    }
+
+    size_t binarySize() const {
+        return binarySize_;
+    }
+
+    cs::Byte* data() const {
+        return const_cast<cs::Byte*>(data_);
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool isEmpty() const {
+        return size_ == 0;
+    }
+
+private:
+    size_t binarySize_{};
+    const cs::Byte* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/* The default-constructed allocator serves every request from the heap.
+   Constructed with a page size it keeps a pool of fixed-size pages:
+   requests that fit are served from the pool (or grow it), bigger ones
+   fall through to the heap; freed pages go back to the pool for reuse.
+   Counters are kept either way, so ingress allocators can be sized from
+   live numbers instead of the defaults.
+   Assumptions:
+   - allocateNext may be called concurrently, regions are unuse()d from
+     any thread;
+   - no region outlives the allocator that created it */
 class RegionAllocator {
 public:
+    struct Stats {
+        uint64_t allocations = 0;       // total allocateNext() calls
+        uint64_t pageHits = 0;          // requests served from the preallocated pool
+        uint64_t pageChurn = 0;         // pool-sized pages created beyond the preallocation
+        uint64_t bytesInFlight = 0;     // bytes held by live regions right now
+        uint64_t peakBytesInFlight = 0;
+    };
+
     RegionAllocator() = default;
 
+    RegionAllocator(const uint32_t pageSize, const uint32_t preallocated)
+    : pageSize_(pageSize) {
+        pool_.reserve(preallocated);
+        for (uint32_t i = 0; i < preallocated; ++i) {
+            pool_.push_back(new cs::Byte[pageSize]);
+        }
+    }
+
+    ~RegionAllocator() {
+        for (auto page : pool_) {
+            delete [] page;
+        }
+    }
+
     RegionAllocator(const RegionAllocator&) = delete;
     RegionAllocator(RegionAllocator&&) = delete;
     RegionAllocator& operator=(const RegionAllocator&) = delete;
     RegionAllocator& operator=(RegionAllocator&&) = delete;
 
-    /* Assumptions:
-     - allocateNext and shrinkLast are only called from the thread
-       that constructed the object
-     - shrinkLast is called before the last allocation gets unuse()d */
     RegionPtr allocateNext(const uint32_t size) {
-        auto ptr = new cs::Byte[size];
-        return Region::create(ptr, size);
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+
+        cs::Byte* ptr = nullptr;
+        uint32_t capacity = size;
+
+        if (pageSize_ != 0 && size <= pageSize_) {
+            capacity = pageSize_;
+
+            {
+                cs::Lock lock(poolFlag_);
+                if (!pool_.empty()) {
+                    ptr = pool_.back();
+                    pool_.pop_back();
+                }
+            }
+
+            if (ptr != nullptr) {
+                pageHits_.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                pageChurn_.fetch_add(1, std::memory_order_relaxed);
+                ptr = new cs::Byte[pageSize_];
+            }
+        }
+        else {
+            ptr = new cs::Byte[size];
+        }
+
+        const uint64_t inFlight = bytesInFlight_.fetch_add(capacity, std::memory_order_relaxed) + capacity;
+        uint64_t peak = peakBytesInFlight_.load(std::memory_order_relaxed);
+        while (inFlight > peak && !peakBytesInFlight_.compare_exchange_weak(peak, inFlight, std::memory_order_relaxed)) {
+        }
+
+        return Region::create(ptr, size, capacity, this);
+    }
+
+    Stats stats() const {
+        Stats result;
+        result.allocations = allocations_.load(std::memory_order_relaxed);
+        result.pageHits = pageHits_.load(std::memory_order_relaxed);
+        result.pageChurn = pageChurn_.load(std::memory_order_relaxed);
+        result.bytesInFlight = bytesInFlight_.load(std::memory_order_relaxed);
+        result.peakBytesInFlight = peakBytesInFlight_.load(std::memory_order_relaxed);
+        return result;
     }
+
+    uint32_t pageSize() const {
+        return pageSize_;
+    }
+
+private:
+    void recycle(Region* region) {
+        bytesInFlight_.fetch_sub(region->capacity_, std::memory_order_relaxed);
+
+        if (pageSize_ != 0 && region->capacity_ == pageSize_) {
+            cs::Lock lock(poolFlag_);
+            pool_.push_back(region->data_);
+            return;
+        }
+
+        delete [] region->data_;
+    }
+
+    const uint32_t pageSize_ = 0;
+    std::vector<cs::Byte*> pool_;
+    cs::SpinLock poolFlag_{ATOMIC_FLAG_INIT};
+
+    std::atomic<uint64_t> allocations_ = {0};
+    std::atomic<uint64_t> pageHits_ = {0};
+    std::atomic<uint64_t> pageChurn_ = {0};
+    std::atomic<uint64_t> bytesInFlight_ = {0};
+    std::atomic<uint64_t> peakBytesInFlight_ = {0};
+
+    friend class Region;
 };
 
+inline Region::~Region() {
+    if (allocator_ != nullptr) {
+        allocator_->recycle(this);
+    }
+    else {
+        delete [] data_;
+    }
+}
+
 class MockAllocator : public RegionAllocator {
 public:
     uint64_t allocations() const {
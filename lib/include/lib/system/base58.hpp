@@ -0,0 +1,33 @@
+#ifndef BASE58_HPP
+#define BASE58_HPP
+
+#include <string>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// @brief Fast base58 encoder for public keys.
+///
+/// Address-to-string conversion is one of the hottest symbols in the API
+/// profile: explorer queries encode the same handful of popular addresses
+/// over and over. The encoder specializes the common case - a fixed 32 byte
+/// public key - with stack-only carry loops, and memoizes results in a small
+/// direct-mapped cache so the hot addresses are encoded once and then served
+/// as plain string copies. The output is identical to EncodeBase58 from
+/// cscrypto, only the route is shorter.
+///
+class Base58 {
+public:
+    /// cached fixed-width encoding of a public key
+    static std::string encode(const cs::PublicKey& key);
+
+    /// generic encoding of an arbitrary byte string, uncached
+    static std::string encode(const cs::Bytes& bytes);
+
+private:
+    static std::string encodeRaw(const cs::Byte* data, size_t size);
+};
+}  // namespace cs
+
+#endif  // BASE58_HPP
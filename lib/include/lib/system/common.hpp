@@ -5,6 +5,12 @@
 #include <shared_mutex>
 #include <string>
 
+#ifdef LOCK_PROFILING
+#include <chrono>
+
+#include <lib/system/lockprofiler.hpp>
+#endif
+
 #include <boost/smart_ptr/detail/spinlock.hpp>
 
 #include <cscrypto/cscrypto.hpp>
@@ -66,6 +72,57 @@ using SharedMutex = std::shared_mutex;
 using SpinLock = boost::detail::spinlock;
 
 // RAII locks
+#ifdef LOCK_PROFILING
+// instrumented variants reporting wait and hold time of every acquisition to
+// cs::LockProfiler. The timer base is initialized before the guard base, so
+// the blocking lock() inside the base constructor falls into the measured
+// wait window; hold time is taken at destruction, just before the unlock
+namespace lockdetail {
+struct LockTimer {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+inline uint64_t toNs(std::chrono::steady_clock::duration duration) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+}  // namespace lockdetail
+
+template <typename T>
+class Lock : private lockdetail::LockTimer, public std::lock_guard<T> {
+public:
+    explicit inline Lock(T& lockable)
+    : std::lock_guard<T>(lockable)
+    , lockable_(&lockable)
+    , acquired_(std::chrono::steady_clock::now()) {
+    }
+
+    ~Lock() {
+        LockProfiler::instance().record(lockable_, lockdetail::toNs(acquired_ - start), lockdetail::toNs(std::chrono::steady_clock::now() - acquired_));
+    }
+
+private:
+    T* lockable_;
+    std::chrono::steady_clock::time_point acquired_;
+};
+
+template <typename T>
+class SharedLock : private lockdetail::LockTimer, public std::shared_lock<T> {
+public:
+    explicit inline SharedLock(T& lockable)
+    : std::shared_lock<T>(lockable)
+    , lockable_(&lockable)
+    , acquired_(std::chrono::steady_clock::now()) {
+    }
+
+    ~SharedLock() {
+        LockProfiler::instance().record(lockable_, lockdetail::toNs(acquired_ - start), lockdetail::toNs(std::chrono::steady_clock::now() - acquired_));
+    }
+
+private:
+    T* lockable_;
+    std::chrono::steady_clock::time_point acquired_;
+};
+#else
 template <typename T>
 class Lock : public std::lock_guard<T> {
 public:
@@ -81,6 +138,7 @@ public:
     : std::shared_lock<T>(lockable) {
     }
 };
+#endif  // LOCK_PROFILING
 
 // aliasing, C++ 17 scoped lock, C++ 17 constructor template parameters deduction
 template <typename... T>
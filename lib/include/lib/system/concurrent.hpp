@@ -2,7 +2,9 @@
 #define CONCURRENT_HPP
 
 #include <assert.h>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <list>
@@ -10,12 +12,14 @@
 #include <thread>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <lib/system/cache.hpp>
 #include <lib/system/common.hpp>
 #include <lib/system/logger.hpp>
 #include <lib/system/signals.hpp>
 #include <lib/system/structures.hpp>
+#include <lib/system/threadaffinity.hpp>
 
 #include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
@@ -28,7 +32,8 @@ enum class RunPolicy : cs::Byte {
 
 enum class ConcurrentPolicy : cs::Byte {
     Thread,
-    ThreadPool
+    ThreadPool,
+    StealingThreadPool
 };
 
 enum class WatcherState : cs::Byte {
@@ -52,6 +57,144 @@ public:
     }
 };
 
+// work-stealing pool: every worker owns a deque, so concurrent posters and
+// workers do not serialize on one queue lock the way the boost pool does.
+// A worker takes its newest own job first (still warm in cache) and steals
+// the oldest job of a neighbour only when its own deque runs dry
+class StealingThreadPool {
+public:
+    explicit StealingThreadPool(size_t threadsCount)
+    : queues_(threadsCount != 0 ? threadsCount : 1) {
+        for (size_t index = 0; index < queues_.size(); ++index) {
+            threads_.emplace_back(&StealingThreadPool::work, this, index);
+        }
+    }
+
+    ~StealingThreadPool() {
+        {
+            cs::Lock lock(sleepMutex_);
+            stopped_ = true;
+        }
+
+        sleepCondition_.notify_all();
+
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    StealingThreadPool(const StealingThreadPool&) = delete;
+    StealingThreadPool& operator=(const StealingThreadPool&) = delete;
+
+    void post(std::function<void()> job) {
+        const size_t index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+        {
+            cs::Lock lock(queues_[index].mutex);
+            queues_[index].jobs.push_back(std::move(job));
+        }
+
+        // taking the sleep mutex closes the gap between a worker's empty
+        // predicate check and its wait, otherwise the notify could be lost
+        {
+            cs::Lock lock(sleepMutex_);
+        }
+
+        sleepCondition_.notify_one();
+    }
+
+    static StealingThreadPool& instance() noexcept {
+        static StealingThreadPool pool(std::thread::hardware_concurrency());
+        return pool;
+    }
+
+private:
+    struct JobQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    std::function<void()> take(size_t ownIndex) {
+        {
+            auto& queue = queues_[ownIndex];
+            cs::Lock lock(queue.mutex);
+
+            if (!queue.jobs.empty()) {
+                auto job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+
+                return job;
+            }
+        }
+
+        for (size_t step = 1; step < queues_.size(); ++step) {
+            auto& queue = queues_[(ownIndex + step) % queues_.size()];
+            cs::Lock lock(queue.mutex);
+
+            if (!queue.jobs.empty()) {
+                auto job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+
+                return job;
+            }
+        }
+
+        return {};
+    }
+
+    bool hasJobs() {
+        for (auto& queue : queues_) {
+            cs::Lock lock(queue.mutex);
+
+            if (!queue.jobs.empty()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void work(size_t ownIndex) {
+        while (true) {
+            // cheap when unchanged; picks up a cpu set configured after pool start
+            ThreadAffinity::instance().apply(ThreadAffinity::Domain::Worker);
+
+            auto job = take(ownIndex);
+
+            if (!job) {
+                std::unique_lock<std::mutex> lock(sleepMutex_);
+                sleepCondition_.wait(lock, [this] {
+                    return stopped_ || hasJobs();
+                });
+
+                if (stopped_) {
+                    return;
+                }
+
+                continue;
+            }
+
+            try {
+                job();
+            }
+            catch (std::exception& e) {
+                cserror() << "Stealing thread pool job failed, " << e.what();
+            }
+            catch (...) {
+                cserror() << "Stealing thread pool job failed with unknown error";
+            }
+        }
+    }
+
+    std::vector<JobQueue> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> nextQueue_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    bool stopped_ = false;
+};
+
 template <typename T>
 class FutureWatcher;
 class Concurrent;
@@ -366,6 +509,9 @@ public:
         if (policy == cs::ConcurrentPolicy::ThreadPool) {
             Worker::execute(std::forward<Func>(function));
         }
+        else if (policy == cs::ConcurrentPolicy::StealingThreadPool) {
+            StealingThreadPool::instance().post(std::forward<Func>(function));
+        }
         else {
             Worker::run(std::forward<Func>(function));
         }
@@ -0,0 +1,65 @@
+#ifndef CRYPTOSERVICE_HPP
+#define CRYPTOSERVICE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// @brief Centralized entry point for bulk ed25519 signature verification.
+/// Independent verifications submitted as one batch are fanned out over the
+/// shared thread pool once the batch is large enough to amortize the
+/// scheduling cost; small batches run on the calling thread. Every batch is
+/// counted, so crypto throughput is observable from a single place instead
+/// of being scattered across the call sites.
+///
+class CryptoService {
+public:
+    ///
+    /// One independent verification: pointers must stay valid for the
+    /// duration of the verify call, no data is copied in.
+    ///
+    struct VerifyJob {
+        const cs::Byte* signature = nullptr;
+        const cs::Byte* publicKey = nullptr;
+        const cs::Byte* message = nullptr;
+        size_t messageSize = 0;
+    };
+
+    static CryptoService& instance();
+
+    ///
+    /// @brief Verifies the whole batch, returns one result byte per job
+    /// in submission order (1 - valid, 0 - invalid).
+    ///
+    std::vector<cs::Byte> verifyBatch(const std::vector<VerifyJob>& jobs);
+
+    ///
+    /// @brief Returns true only if every job in the batch verifies.
+    ///
+    bool verifyAll(const std::vector<VerifyJob>& jobs);
+
+    ///
+    /// @brief Summary counters formatted for the diagnostic api.
+    ///
+    std::string report() const;
+
+    // batches below this size are verified on the calling thread, the
+    // scheduling round trip costs more than the verifications themselves
+    constexpr static size_t kParallelThreshold = 8;
+
+private:
+    CryptoService() = default;
+
+    std::atomic<uint64_t> operations_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> parallelBatches_{0};
+    std::atomic<uint64_t> busyNs_{0};
+};
+}  // namespace cs
+
+#endif  // CRYPTOSERVICE_HPP
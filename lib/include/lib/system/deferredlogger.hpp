@@ -0,0 +1,135 @@
+#ifndef DEFERREDLOGGER_HPP
+#define DEFERREDLOGGER_HPP
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+
+#include <boost/lockfree/queue.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <lib/system/logger.hpp>
+
+namespace cs {
+/// formats log records away from the calling thread: a hot-path site stores
+/// the format literal and up to four scalar arguments in a lock-free ring,
+/// the logger thread substitutes the {} placeholders in order and hands the
+/// line to Boost.Log. The site pays one ring push, never an ostringstream;
+/// when the ring is full the record is dropped and the drop is counted
+class DeferredLogger {
+public:
+    enum Options {
+        QueueSize = 4096,
+        MaxArguments = 4,
+        PollTimeMs = 20
+    };
+
+    static DeferredLogger& instance() {
+        static DeferredLogger logger;
+        return logger;
+    }
+
+    // format must be a string literal or otherwise outlive the logger thread,
+    // arguments must be arithmetic types, enums or string literals
+    template <typename... Args>
+    void log(logger::severity_level severity, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= MaxArguments, "too many arguments for a deferred log record");
+
+        Record record{};
+        record.format = format;
+        record.severity = severity;
+        record.count = static_cast<uint8_t>(sizeof...(Args));
+
+        size_t index = 0;
+        (encode(record, index, args), ...);
+
+        if (!queue_.push(record)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void stop();
+
+private:
+    enum class ArgType : uint8_t {
+        Signed,
+        Unsigned,
+        Float,
+        Bool,
+        Literal
+    };
+
+    struct Record {
+        const char* format;
+        logger::severity_level severity;
+        uint8_t count;
+        ArgType types[MaxArguments];
+        uint64_t values[MaxArguments];
+    };
+
+    DeferredLogger();
+    ~DeferredLogger();
+
+    template <typename T>
+    static void encode(Record& record, size_t& index, T value) {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, const char*>,
+                      "deferred log arguments must be scalar pods or string literals");
+
+        if constexpr (std::is_same_v<T, bool>) {
+            record.types[index] = ArgType::Bool;
+            record.values[index] = value ? 1 : 0;
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            record.types[index] = ArgType::Float;
+            double d = static_cast<double>(value);
+            std::memcpy(&record.values[index], &d, sizeof(d));
+        }
+        else if constexpr (std::is_same_v<T, const char*>) {
+            record.types[index] = ArgType::Literal;
+            std::memcpy(&record.values[index], &value, sizeof(value));
+        }
+        else if constexpr (std::is_enum_v<T> || std::is_signed_v<T>) {
+            record.types[index] = ArgType::Signed;
+            int64_t v = static_cast<int64_t>(value);
+            std::memcpy(&record.values[index], &v, sizeof(v));
+        }
+        else {
+            record.types[index] = ArgType::Unsigned;
+            record.values[index] = static_cast<uint64_t>(value);
+        }
+
+        ++index;
+    }
+
+    void eventLoop();
+    void drain();
+    static void emitRecord(const Record& record);
+    static std::string format(const Record& record);
+    static std::string toString(ArgType type, uint64_t value);
+
+    boost::lockfree::queue<Record, boost::lockfree::capacity<QueueSize>> queue_;
+    std::atomic<uint64_t> dropped_ = { 0 };
+    std::atomic<bool> isRunning_ = { false };
+    std::thread thread_;
+};
+}
+
+// capture-now, format-later logging for per-packet paths; compiled out below
+// the severity floor like the eager macros
+#define csdeferredlog(level, ...)                                                             \
+    do {                                                                                       \
+        if constexpr (logger::severityEnabled<logger::severity_level::level>()) {              \
+            cs::DeferredLogger::instance().log(logger::severity_level::level, __VA_ARGS__);    \
+        }                                                                                      \
+    } while (false)
+
+#endif  // DEFERREDLOGGER_HPP
@@ -25,25 +25,31 @@ public:
     template<typename... Args>
     void exchange(Args&&... value) const {
         std::shared_ptr<T> newValue = std::make_shared<T>(std::forward<Args>(value)...);
-        std::shared_ptr<T> current;
+        std::shared_ptr<T> current = std::atomic_load_explicit(&data_, std::memory_order_relaxed);
 
-        do {
-            current = data_;
-        }
         while (!std::atomic_compare_exchange_weak_explicit(&data_, &current, newValue, std::memory_order_release,
-                                                           std::memory_order_relaxed));
+                                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    // snapshot that stays valid across concurrent exchange() calls; readers that
+    // dereference several fields should take one share() and use it throughout
+    std::shared_ptr<const T> share() const {
+        return std::atomic_load_explicit(&data_, std::memory_order_acquire);
     }
 
+    // the pointee lives only as long as no exchange() replaces it, prefer share()
+    // on paths that may run concurrently with an exchange
     T* operator->() {
-        return data_.get();
+        return std::atomic_load_explicit(&data_, std::memory_order_acquire).get();
     }
 
     const T* operator->() const {
-        return data_.get();
+        return std::atomic_load_explicit(&data_, std::memory_order_acquire).get();
     }
 
     T operator*() const {
-        return *(data_.get());
+        return *share();
     }
 
     T data() const {
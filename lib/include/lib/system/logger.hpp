@@ -29,9 +29,21 @@
 
 namespace logging = boost::log;
 
+// compile-time severity floor: logging sites below it are eliminated from the
+// build entirely; raise it with e.g. -DCS_LOG_MIN_SEVERITY=2
+// (trace = 0, debug = 1, info = 2, warning = 3, error = 4, fatal = 5)
+#ifndef CS_LOG_MIN_SEVERITY
+#define CS_LOG_MIN_SEVERITY 0
+#endif
+
 namespace logger {
 using severity_level = logging::trivial::severity_level;
 
+template <severity_level level>
+constexpr bool severityEnabled() {
+    return static_cast<int>(level) >= CS_LOG_MIN_SEVERITY;
+}
+
 void initialize(const logging::settings& settings);
 void cleanup();
 
@@ -56,16 +68,20 @@ BOOST_LOG_INLINE_GLOBAL_LOGGER_CTOR_ARGS(File, logging::sources::severity_channe
 BOOST_LOG_INLINE_GLOBAL_LOGGER_CTOR_ARGS(EventLogger, logging::sources::severity_channel_logger_mt<logging::trivial::severity_level>, (logging::keywords::channel = "Event"))
 }  // namespace logger
 
-#define LOG_SEV(level, ...)               \
-    if (!logger::useLogger<__VA_ARGS__>()) \
-        ;                                  \
-    else                                   \
+#define LOG_SEV(level, ...)                                                       \
+    if constexpr (!logger::severityEnabled<logger::severity_level::level>())       \
+        ;                                                                          \
+    else if (!logger::useLogger<__VA_ARGS__>())                                    \
+        ;                                                                          \
+    else                                                                           \
         BOOST_LOG_SEV(logger::getLogger<__VA_ARGS__>(), logger::severity_level::level)
 
-#define cstrace(...)                       \
-    if (!logger::useLogger<__VA_ARGS__>()) \
-        ;                                  \
-    else                                   \
+#define cstrace(...)                                                               \
+    if constexpr (!logger::severityEnabled<logger::severity_level::trace>())       \
+        ;                                                                          \
+    else if (!logger::useLogger<__VA_ARGS__>())                                    \
+        ;                                                                          \
+    else                                                                           \
         BOOST_LOG_SEV(logger::getLogger<__VA_ARGS__>(), logger::severity_level::trace) << __FILE__ << ":" << __func__ << ":" << __LINE__ << " "
 
 // set Filter="%Severity% >= trace" in config to view this level messages:
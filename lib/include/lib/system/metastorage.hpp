@@ -3,6 +3,7 @@
 
 #include <boost/circular_buffer.hpp>
 #include <lib/system/common.hpp>
+#include <functional>
 #include <optional>
 
 /// nested namespace
@@ -49,6 +50,12 @@ public:
     /// element type
     using Element = MetaStorage<T>::MetaElement;
 
+    /// called with elements pushed out of storage, the plug point for spilling cold metas
+    using EvictionHandler = std::function<void(MetaElement&&)>;
+
+    /// estimates element payload size in bytes for the byte budget
+    using SizeEstimator = std::function<std::size_t(const T&)>;
+
     // default initialization
     inline MetaStorage() noexcept
     : buffer_(cs::values::kDefaultMetaStorageMaxSize) {
@@ -74,6 +81,31 @@ public:
         return buffer_.size();
     }
 
+    ///
+    /// @brief Sets handler called with every element evicted from storage.
+    /// @param handler Receives the evicted element, e.g. to spill it to disk.
+    ///
+    void setEvictionHandler(EvictionHandler handler) {
+        evictionHandler_ = std::move(handler);
+    }
+
+    ///
+    /// @brief Bounds storage by accumulated payload bytes in addition to element count.
+    /// @param bytes High-water mark, oldest elements are evicted while storage holds more.
+    /// @param estimator Returns payload size of one element, must be deterministic.
+    ///
+    void setByteBudget(std::size_t bytes, SizeEstimator estimator) {
+        byteBudget_ = bytes;
+        sizeEstimator_ = std::move(estimator);
+    }
+
+    ///
+    /// @brief Returns accumulated payload bytes, always 0 without a byte budget set.
+    ///
+    std::size_t bytesUsed() const {
+        return bytesUsed_;
+    }
+
     ///
     /// @brief Appends meta element to buffer.
     /// @param element Created from outside rvalue.
@@ -84,7 +116,19 @@ public:
         const auto result = (iterator == buffer_.end());
 
         if (result) {
+            if (buffer_.full() && !buffer_.empty()) {
+                evictFront();
+            }
+
+            if (sizeEstimator_) {
+                bytesUsed_ += sizeEstimator_(value.meta);
+            }
+
             buffer_.push_back(std::move(value));
+
+            while (sizeEstimator_ && bytesUsed_ > byteBudget_ && buffer_.size() > 1) {
+                evictFront();
+            }
         }
 
         return result;
@@ -157,6 +201,10 @@ public:
         MetaElement result = std::move(*iterator);
         buffer_.erase(iterator);
 
+        if (sizeEstimator_) {
+            bytesUsed_ -= sizeEstimator_(result.meta);
+        }
+
         return std::make_optional<T>(std::move(result.meta));
     }
 
@@ -222,7 +270,27 @@ public:
     }
 
 private:
+    // takes the oldest element out and hands it to the eviction handler instead of
+    // letting the circular buffer drop it silently
+    void evictFront() {
+        MetaElement element = std::move(buffer_.front());
+        buffer_.pop_front();
+
+        if (sizeEstimator_) {
+            bytesUsed_ -= sizeEstimator_(element.meta);
+        }
+
+        if (evictionHandler_) {
+            evictionHandler_(std::move(element));
+        }
+    }
+
     boost::circular_buffer<MetaElement> buffer_;
+
+    EvictionHandler evictionHandler_;
+    SizeEstimator sizeEstimator_;
+    std::size_t byteBudget_ = 0;
+    std::size_t bytesUsed_ = 0;
 };
 }  // namespace cs
 
@@ -0,0 +1,120 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace cs {
+///
+/// Fixed-layout latency histogram, values are microseconds.
+///
+/// Every power-of-two range is split into 8 linear sub-buckets (HDR style),
+/// so the relative error of any reported quantile stays below 12.5% across
+/// the whole range. record() does two relaxed atomic increments on a shard
+/// picked by thread, writers never share cache lines with readers;
+/// aggregation over shards happens only on report().
+///
+class LatencyHistogram {
+public:
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t micros) noexcept;
+
+    void record(std::chrono::steady_clock::duration duration) noexcept {
+        record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+    }
+
+    // count, avg and p50/p90/p99/p99.9 as a single line
+    std::string report() const;
+
+private:
+    static constexpr size_t kSubBits = 3;
+    static constexpr uint64_t kSubCount = 1ULL << kSubBits;
+    static constexpr size_t kBucketsCount = 512;
+    static constexpr size_t kShardsCount = 16;
+
+    static size_t indexOf(uint64_t value) noexcept;
+    static uint64_t lowerBoundOf(size_t index) noexcept;
+
+    struct Shard {
+        std::array<std::atomic<uint64_t>, kBucketsCount> buckets{};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> count{0};
+    };
+
+    Shard& currentShard() noexcept;
+
+    std::array<Shard, kShardsCount> shards_;
+};
+
+///
+/// Registry of named histograms.
+///
+/// Hot paths should resolve their histogram once and keep the reference:
+///
+/// static cs::LatencyHistogram& histogram = cs::Metrics::instance().histogram("conveyer_flush_us");
+///
+/// References stay valid for the process lifetime.
+///
+class Metrics {
+public:
+    static Metrics& instance() {
+        static Metrics metrics;
+        return metrics;
+    }
+
+    LatencyHistogram& histogram(const std::string& name);
+
+    // monotonic named counter, one relaxed add per event. Long-running
+    // phases (block replay, cache load) bump these so an external watcher
+    // can distinguish a slow start from a hung one. As with histograms,
+    // resolve once and keep the reference
+    std::atomic<uint64_t>& counter(const std::string& name);
+
+    // every counter with its current value, in name order
+    void forEachCounter(const std::function<void(const std::string&, uint64_t)>& callback) const;
+
+    // all histograms, one per line, sorted by name
+    std::string report() const;
+
+private:
+    Metrics() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms_;
+    std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> counters_;
+};
+
+///
+/// RAII watcher, records elapsed time to histogram on scope exit
+///
+class MetricsTimer {
+public:
+    explicit MetricsTimer(LatencyHistogram& histogram)
+    : histogram_(histogram)
+    , point_(std::chrono::steady_clock::now()) {
+    }
+
+    ~MetricsTimer() {
+        histogram_.record(std::chrono::steady_clock::now() - point_);
+    }
+
+    MetricsTimer(const MetricsTimer&) = delete;
+    MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    std::chrono::steady_clock::time_point point_;
+};
+}  // namespace cs
+
+#endif  // METRICS_HPP
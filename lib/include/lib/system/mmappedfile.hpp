@@ -1,9 +1,13 @@
 #ifndef MMAPPEDFILE_H
 #define MMAPPEDFILE_H
 
+#include <cstring>
 #include <exception>
+#include <filesystem>
 
+#include <boost/core/ref.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/stream.hpp>
 
 #include <lib/system/logger.hpp>
 
@@ -56,5 +60,116 @@ public:
 private:
     BoostMMapedFile file_;
 };
+
+// growable write mapping: bytes land straight in the page cache, so writers
+// building large files do not keep a second copy of them in process memory;
+// the mapping is doubled whenever the next write would not fit
+class MMappedGrowableSink {
+public:
+    using char_type = char;
+    using category = boost::iostreams::sink_tag;
+
+    explicit MMappedGrowableSink(const std::string& path, size_t initialSize = kInitialMapSize)
+    : path_(path) {
+        try {
+            boost::iostreams::mapped_file_params params;
+            params.path = path;
+            params.new_file_size = static_cast<boost::iostreams::stream_offset>(initialSize);
+            file_.open(params);
+        }
+        catch (std::exception& e) {
+            cserror() << e.what();
+        }
+        catch (...) {
+            cserror() << __FILE__ << ", "
+                      << __LINE__
+                      << " exception ...";
+        }
+    }
+
+    ~MMappedGrowableSink() {
+        truncate();
+    }
+
+    bool isOpen() {
+        return file_.is_open();
+    }
+
+    std::streamsize write(const char* data, std::streamsize size) {
+        if (!file_.is_open() || size < 0) {
+            return -1;
+        }
+        const size_t bytes = static_cast<size_t>(size);
+        if (written_ + bytes > file_.size()) {
+            size_t newSize = file_.size();
+            while (newSize < written_ + bytes) {
+                newSize *= 2;
+            }
+            try {
+                file_.resize(static_cast<boost::iostreams::stream_offset>(newSize));
+            }
+            catch (std::exception& e) {
+                cserror() << e.what();
+                return -1;
+            }
+        }
+        std::memcpy(file_.data() + written_, data, bytes);
+        written_ += bytes;
+        return size;
+    }
+
+    // shrinks the file to the bytes actually written and releases the mapping,
+    // safe to call more than once
+    void truncate() {
+        if (!file_.is_open()) {
+            return;
+        }
+        file_.close();
+        std::error_code error;
+        std::filesystem::resize_file(path_, written_, error);
+        if (error) {
+            cserror() << "unable to truncate " << path_ << ": " << error.message();
+        }
+    }
+
+    size_t written() const {
+        return written_;
+    }
+
+private:
+    static constexpr size_t kInitialMapSize = 1 << 22;
+
+    std::string path_;
+    boost::iostreams::mapped_file file_;
+    size_t written_ = 0;
+};
+
+// ostream facade over the growable mapping, handy for boost archives; the
+// stream is flushed and the file truncated to its real size on destruction,
+// so the archive must go out of scope first
+class MMappedOutput {
+public:
+    explicit MMappedOutput(const std::string& path)
+    : sink_(path)
+    , stream_(boost::ref(sink_)) {
+    }
+
+    ~MMappedOutput() {
+        stream_.flush();
+        sink_.truncate();
+    }
+
+    bool isOpen() {
+        return sink_.isOpen();
+    }
+
+    std::ostream& stream() {
+        return stream_;
+    }
+
+private:
+    MMappedGrowableSink sink_;
+    boost::iostreams::stream<boost::reference_wrapper<MMappedGrowableSink>> stream_;
+};
 } // namespace cs
 #endif // MMAPPEDFILE_H
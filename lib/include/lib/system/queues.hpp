@@ -99,4 +99,81 @@ private:
     __cacheline_aligned std::atomic<Element*> writingBarrier_ = {elements};
 };
 
+/* Fixed Try Queue (FTQueue) is a bounded lock-free queue for many writers
+   and a SINGLE reader. Unlike FUQueue it never spins on a full or empty
+   queue: tryPush()/tryPop() fail immediately so the caller can fall back
+   to a slower path. Each slot carries a monotonically growing sequence
+   (Vyukov-style); a slot is writable when its sequence equals the ticket
+   a producer claimed, readable when it is one past it */
+template <typename T, std::size_t MaxSize>
+class FTQueue {
+    static_assert((MaxSize & (MaxSize - 1)) == 0, "MaxSize must be a power of two");
+
+public:
+    FTQueue() {
+        for (std::size_t i = 0; i < MaxSize; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // any thread; returns false when the queue is full
+    bool tryPush(T&& value) {
+        auto ticket = pushTicket_.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        for (;;) {
+            slot = &slots_[ticket & (MaxSize - 1)];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(ticket);
+
+            if (diff == 0) {
+                if (pushTicket_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                ticket = pushTicket_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->element = std::move(value);
+        slot->sequence.store(ticket + 1, std::memory_order_release);
+        return true;
+    }
+
+    // reader thread only; returns false when the queue is empty
+    bool tryPop(T& value) {
+        Slot& slot = slots_[popTicket_ & (MaxSize - 1)];
+
+        if (slot.sequence.load(std::memory_order_acquire) != popTicket_ + 1) {
+            return false;
+        }
+
+        value = std::move(slot.element);
+        slot.sequence.store(popTicket_ + MaxSize, std::memory_order_release);
+        ++popTicket_;
+        return true;
+    }
+
+    // reader thread only
+    bool hasData() const {
+        const Slot& slot = slots_[popTicket_ & (MaxSize - 1)];
+        return slot.sequence.load(std::memory_order_acquire) == popTicket_ + 1;
+    }
+
+private:
+    struct Slot {
+        __cacheline_aligned std::atomic<std::size_t> sequence;
+        T element;
+    };
+
+    Slot slots_[MaxSize];
+
+    __cacheline_aligned std::atomic<std::size_t> pushTicket_{0};
+    __cacheline_aligned std::size_t popTicket_ = 0;
+};
+
 #endif  // QUEUES_HPP
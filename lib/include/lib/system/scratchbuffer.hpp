@@ -0,0 +1,64 @@
+#ifndef SCRATCHBUFFER_HPP
+#define SCRATCHBUFFER_HPP
+
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+///
+/// @brief RAII handle to a thread local growable byte buffer.
+/// Message composition buffers are serialized into, read once and thrown
+/// away - with a plain cs::Bytes every message pays an allocation for
+/// capacity the previous message just released. A scratch buffer rents
+/// grown capacity from a per-thread pool and returns it on destruction,
+/// so composition is allocation-free once buffers reach working size.
+/// The handle must not outlive the thread it was created on.
+///
+class ScratchBuffer {
+public:
+    ScratchBuffer() {
+        auto& buffers = pool();
+
+        if (!buffers.empty()) {
+            storage_ = std::move(buffers.back());
+            buffers.pop_back();
+            storage_.clear();
+        }
+    }
+
+    ~ScratchBuffer() {
+        auto& buffers = pool();
+
+        // a one-off giant message should not pin its capacity forever,
+        // and an unbounded pool would just move the leak
+        if (buffers.size() < kMaxPooled && storage_.capacity() <= kMaxRetainedCapacity) {
+            buffers.push_back(std::move(storage_));
+        }
+    }
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    ///
+    /// @brief Returns the rented buffer, empty but with retained capacity.
+    /// Moving bytes() out is allowed, an empty buffer goes back to the pool.
+    ///
+    cs::Bytes& bytes() {
+        return storage_;
+    }
+
+private:
+    constexpr static size_t kMaxPooled = 8;
+    constexpr static size_t kMaxRetainedCapacity = 1 << 20;
+
+    static std::vector<cs::Bytes>& pool() {
+        static thread_local std::vector<cs::Bytes> buffers;
+        return buffers;
+    }
+
+    cs::Bytes storage_;
+};
+}  // namespace cs
+
+#endif  // SCRATCHBUFFER_HPP
@@ -66,12 +66,28 @@ public:
     /// @brief Generates signal.
     /// @param args Any count of template parameters.
     ///
+    /// With exactly one slot connected the arguments are forwarded as is, so
+    /// an rvalue payload moves into a by-value slot parameter instead of being
+    /// copied. With several slots every slot gets the arguments as lvalues:
+    /// forwarding the same pack repeatedly would let the first by-value slot
+    /// steal from an rvalue and hand the rest a moved-from husk.
+    ///
     template <typename... Args>
     inline void operator()(Args&&... args) const {
+        if (slots_.size() == 1) {
+            const auto& func = slots_.front().second;
+
+            if (func) {
+                func(std::forward<Args>(args)...);
+            }
+
+            return;
+        }
+
         for ([[maybe_unused]] auto& [obj, func] : slots_) {
             csunused(obj);
             if (func) {
-                func(std::forward<Args>(args)...);
+                func(args...);
             }
         }
     }
@@ -421,6 +437,58 @@ public:
         cs::Connector::connect(lhs, std::move(func));
     }
 
+    ///
+    /// @brief Connects signal pointer with lambda or function, guarded by predicate.
+    /// @param signal Any signal pointer.
+    /// @param predicate Callable over the signal arguments, returns bool.
+    /// @param slot Function or lambda/closure.
+    ///
+    /// The predicate runs on the emitter before the slot, so a subscriber that
+    /// only cares about a subset of emissions pays one cheap check instead of a
+    /// full handler invocation. Keep predicates free of locks and allocations.
+    ///
+    template <template <typename> typename Signal, typename T, typename Predicate>
+    static void connectIf(const Signal<T>* signal, Predicate predicate, typename Signal<T>::Argument slot) {
+        if (!slot) {
+            return;
+        }
+
+        typename Signal<T>::Argument guarded = [predicate = std::move(predicate), slot = std::move(slot)](auto&&... args) -> void {
+            if (predicate(args...)) {
+                slot(std::forward<decltype(args)>(args)...);
+            }
+        };
+
+        cs::Connector::connect(signal, std::move(guarded));
+    }
+
+    ///
+    /// @brief Connects const signal pointer with objects method, guarded by predicate.
+    /// @param signal Any const signal pointer.
+    /// @param predicate Callable over the signal arguments, returns bool.
+    /// @param slotObj Pointer to slot object.
+    /// @param slot Method pointer.
+    ///
+    /// Lifetime handling matches connect(): IConnectable subscribers are dropped
+    /// automatically and disconnect(signal, object) removes guarded slots too.
+    /// Disconnection by method pointer does not match the predicate wrapper.
+    ///
+    template <template <typename> typename Signal, typename T, typename Predicate, typename Object, typename Slot>
+    static void connectIf(const Signal<T>* signal, Predicate predicate, const Object& slotObj, Slot&& slot) {
+        constexpr int size = cshelper::GetArguments<Slot>();
+        auto binder = cshelper::CheckArgs<size>().connect(slotObj, std::forward<Slot>(slot));
+
+        typename Signal<T>::Argument guarded = [predicate = std::move(predicate), binder = std::move(binder)](auto&&... args) -> void {
+            if (predicate(args...)) {
+                binder(std::forward<decltype(args)>(args)...);
+            }
+        };
+
+        cs::Lock lock(mutex_);
+        auto obj = cs::Connector::checkConnection(static_cast<const ISignal*>(signal), slotObj, std::is_base_of<IConnectable, std::remove_pointer_t<Object>>());
+        const_cast<Signal<T>*>(signal)->add(std::move(guarded), obj);
+    }
+
     ///
     /// @brief Disconnects signal with objcts slots.
     /// @return Returns true if disconnection is okay and same object/method
@@ -0,0 +1,90 @@
+#ifndef STACKSAMPLER_HPP
+#define STACKSAMPLER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace cs {
+///
+/// Lightweight in-process stack sampling for first-incident diagnostics.
+///
+/// Long-living service threads register themselves under a short name; when a
+/// watchdog decides the node is stalling, capture() interrupts the registered
+/// threads with a profiling signal for a few seconds and records their raw
+/// return addresses into preallocated buffers. The addresses are meant to be
+/// symbolized offline against the shipped binary, so a capture costs a few
+/// kilobytes of memory and microseconds per interrupted thread — cheap enough
+/// to run on a production node while the slow round is still in progress.
+///
+/// Only implemented on Linux (frame-pointer walk from a signal handler);
+/// elsewhere capture() returns no samples and registration is a no-op.
+///
+class StackSampler {
+public:
+    struct Sample {
+        std::string thread;             // name given at registration
+        uint64_t offsetMs = 0;          // time since capture start
+        std::vector<uint64_t> frames;   // return addresses, innermost first
+    };
+
+    static StackSampler& instance() noexcept {
+        static StackSampler sampler;
+        return sampler;
+    }
+
+    static constexpr bool isSupported() noexcept {
+#ifdef __linux__
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // registers the calling thread under a diagnostic name, replacing any
+    // previous registration of the same thread
+    void registerThread(const std::string& name);
+
+    // removes the calling thread from the registry; must be called before the
+    // routine returns, a stale entry would make capture() signal a dead thread
+    void unregisterThread();
+
+    // samples every registered thread each intervalMs for durationMs and
+    // returns the collected stacks; blocks the caller for the whole duration,
+    // so run it from a pool thread. Returns an empty vector on unsupported
+    // platforms or when another capture is already in progress
+    std::vector<Sample> capture(size_t durationMs, size_t intervalMs);
+
+private:
+    StackSampler() = default;
+
+    // deep enough for the node's call chains, small enough for the handler's
+    // stack-less scratch buffer
+    static constexpr size_t kMaxFrames = 64;
+
+    // overall cap so a long capture over many threads stays bounded
+    static constexpr size_t kMaxSamples = 4096;
+
+#ifdef __linux__
+    static void installHandler();
+    static void samplingHandler(int);
+
+    bool sampleThread(pthread_t thread);
+#endif
+
+    std::mutex threadsMutex_;
+#ifdef __linux__
+    std::map<pthread_t, std::string> threads_;
+#endif
+    std::atomic<bool> capturing_{false};
+};
+}  // namespace cs
+
+#endif  // STACKSAMPLER_HPP
@@ -1,6 +1,7 @@
 /* Send blaming letters to @yrtimd */
 #ifndef STRUCTURES_HPP
 #define STRUCTURES_HPP
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -336,33 +337,72 @@ public:
         return inst;
     }
 
-    // Called from a single thread
+    // Called from a single thread. Priority entries run first and preempt the
+    // regular lane between callbacks; regular entries are drained under a time
+    // budget, any remainder resumes on the next callAll() so a long backlog
+    // cannot starve the caller (the transport packet loop)
     inline void callAll();
     inline void insert(std::function<void()>);
+    // same contract as insert(), but the call goes into a separate lane drained ahead of
+    // regular entries on every callAll(); reserved for latency-critical work such as
+    // consensus state transitions which must not queue behind bulk sends
+    inline void insertPriority(std::function<void()>);
 
 private:
     CallsQueue() {
     }
+    inline static void push(std::atomic<Call*>& head, std::function<void()> f);
+    inline static Call* detach(std::atomic<Call*>& head);
+    inline static void drain(std::atomic<Call*>& head);
+
+    // per-callAll() budget for the regular lane; the transport wakes at least
+    // every 50 ms, so a smaller slice keeps packet handling responsive while a
+    // backlog of background callbacks is worked off
+    constexpr static std::chrono::milliseconds kDrainBudget{20};
+
     __cacheline_aligned std::atomic<Call*> head_ = {nullptr};
+    __cacheline_aligned std::atomic<Call*> priorityHead_ = {nullptr};
+    // remainder of a regular-lane chain whose drain exceeded the budget,
+    // resumed by the next callAll(); touched only by the draining thread
+    Call* deferred_ = nullptr;
 };
 
 inline void CallsQueue::callAll() {
-    Call* startHead = head_.load(std::memory_order_relaxed);
+    drain(priorityHead_);
 
-    if (!startHead) {
-        return;
+    if (!deferred_) {
+        deferred_ = detach(head_);
     }
 
-    Call* newHead = startHead;
-    head_.compare_exchange_strong(newHead, nullptr, std::memory_order_relaxed, std::memory_order_relaxed);
-    Call* elt = startHead;
+    const auto deadline = std::chrono::steady_clock::now() + kDrainBudget;
 
-    do {
-        elt->func();
-        Call* rem = elt;
-        elt = rem->next.load(std::memory_order_relaxed);
+    while (deferred_) {
+        Call* rem = deferred_;
+        rem->func();
+        deferred_ = rem->next.load(std::memory_order_relaxed);
         delete rem;
-    } while (elt);
+
+        // consensus work scheduled meanwhile preempts the remaining regular calls
+        drain(priorityHead_);
+
+        if (deferred_ && std::chrono::steady_clock::now() >= deadline) {
+            // yield back to the caller, the remainder resumes on the next pass
+            break;
+        }
+    }
+}
+
+// removes the whole chain from head and returns it; entries inserted
+// concurrently with the removal stay queued
+inline CallsQueue::Call* CallsQueue::detach(std::atomic<Call*>& head) {
+    Call* startHead = head.load(std::memory_order_relaxed);
+
+    if (!startHead) {
+        return nullptr;
+    }
+
+    Call* newHead = startHead;
+    head.compare_exchange_strong(newHead, nullptr, std::memory_order_relaxed, std::memory_order_relaxed);
 
     if (newHead != startHead) {
         do {
@@ -374,16 +414,37 @@ inline void CallsQueue::callAll() {
 
         newHead->next.store(nullptr, std::memory_order_relaxed);
     }
+
+    return startHead;
+}
+
+inline void CallsQueue::drain(std::atomic<Call*>& head) {
+    Call* elt = detach(head);
+
+    while (elt) {
+        elt->func();
+        Call* rem = elt;
+        elt = rem->next.load(std::memory_order_relaxed);
+        delete rem;
+    }
 }
 
 inline void CallsQueue::insert(std::function<void()> f) {
+    push(head_, std::move(f));
+}
+
+inline void CallsQueue::insertPriority(std::function<void()> f) {
+    push(priorityHead_, std::move(f));
+}
+
+inline void CallsQueue::push(std::atomic<Call*>& headRef, std::function<void()> f) {
     Call* newElt = new Call;
-    newElt->func = f;
+    newElt->func = std::move(f);
 
-    Call* head = head_.load(std::memory_order_relaxed);
+    Call* head = headRef.load(std::memory_order_relaxed);
     do {
         newElt->next.store(head, std::memory_order_relaxed);
-    } while (!head_.compare_exchange_weak(head, newElt, std::memory_order_acquire, std::memory_order_relaxed));
+    } while (!headRef.compare_exchange_weak(head, newElt, std::memory_order_acquire, std::memory_order_relaxed));
 }
 
 template <size_t Length>
@@ -0,0 +1,126 @@
+#ifndef THREADAFFINITY_HPP
+#define THREADAFFINITY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <lib/system/common.hpp>
+#include <lib/system/logger.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace cs {
+///
+/// Topology-aware thread placement.
+///
+/// Keeps the configured cpu set of every processing domain and pins the
+/// calling threads to it. When all stages of a domain share one NUMA node,
+/// first-touch allocation keeps their working set local, so no explicit
+/// memory binding is required.
+///
+class ThreadAffinity {
+public:
+    enum class Domain : cs::Byte {
+        Network,    // transport sender routine
+        Dispatch,   // transport processor routine and the calls queue it drains
+        Worker      // thread pool workers
+    };
+
+    static ThreadAffinity& instance() noexcept {
+        static ThreadAffinity affinity;
+        return affinity;
+    }
+
+    void setCpuSet(Domain domain, const std::vector<uint16_t>& cpus) {
+        const size_t index = static_cast<size_t>(domain);
+
+        {
+            cs::Lock lock(mutex_);
+            cpuSets_[index] = cpus;
+        }
+
+        versions_[index].fetch_add(1, std::memory_order_release);
+    }
+
+    ///
+    /// Pins the calling thread to the domain's cpu set, no-op while the domain
+    /// has no configured set. Cheap to call repeatedly: the pin is redone only
+    /// after the set changed, so long-living routines may call it every
+    /// iteration and pick up sets configured after their start.
+    ///
+    void apply(Domain domain) {
+        const size_t index = static_cast<size_t>(domain);
+
+        thread_local std::array<uint32_t, kDomainsCount> appliedVersions = {};
+        const uint32_t version = versions_[index].load(std::memory_order_acquire);
+
+        if (appliedVersions[index] == version) {
+            return;
+        }
+
+        appliedVersions[index] = version;
+
+        std::vector<uint16_t> cpus;
+        {
+            cs::Lock lock(mutex_);
+            cpus = cpuSets_[index];
+        }
+
+        if (cpus.empty()) {
+            return;
+        }
+
+        if (pinCurrentThread(cpus)) {
+            csdebug() << "Thread affinity: thread pinned to its domain cpu set";
+        }
+        else {
+            cswarning() << "Thread affinity: failed to pin thread to configured cpu set";
+        }
+    }
+
+private:
+    ThreadAffinity() = default;
+
+    static constexpr size_t kDomainsCount = 3;
+
+    static bool pinCurrentThread(const std::vector<uint16_t>& cpus) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (const auto cpu : cpus) {
+            CPU_SET(cpu, &set);
+        }
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        DWORD_PTR mask = 0;
+
+        for (const auto cpu : cpus) {
+            if (cpu < sizeof(DWORD_PTR) * 8) {
+                mask |= DWORD_PTR(1) << cpu;
+            }
+        }
+
+        return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+        static_cast<void>(cpus);
+        return false;
+#endif
+    }
+
+    std::mutex mutex_;
+    std::array<std::vector<uint16_t>, kDomainsCount> cpuSets_;
+    std::array<std::atomic<uint32_t>, kDomainsCount> versions_ = {};
+};
+}  // namespace cs
+
+#endif  // THREADAFFINITY_HPP
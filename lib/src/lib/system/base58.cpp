@@ -0,0 +1,103 @@
+#include <lib/system/base58.hpp>
+
+#include <array>
+#include <cstring>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+
+namespace {
+constexpr const char* kAlphabet = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// ceil(32 * log(256) / log(58)), the longest encoding of a 32 byte key
+constexpr size_t kMaxKeyDigits = 44;
+
+// direct-mapped memo of recently encoded public keys; keys are uniform
+// hashes, so their leading bytes index the table evenly. Collisions just
+// overwrite - correctness only needs the full key comparison on lookup
+constexpr size_t kCacheSize = 1024;
+
+struct CacheEntry {
+    cs::PublicKey key{};
+    std::string text;
+    bool filled = false;
+};
+
+std::array<CacheEntry, kCacheSize> cache;
+std::shared_mutex cacheLock;
+
+size_t slotOf(const cs::PublicKey& key) {
+    size_t index;
+    std::memcpy(&index, key.data(), sizeof(index));
+    return index & (kCacheSize - 1);
+}
+}  // namespace
+
+namespace cs {
+std::string Base58::encode(const cs::PublicKey& key) {
+    const size_t slot = slotOf(key);
+    {
+        std::shared_lock lock(cacheLock);
+        const CacheEntry& entry = cache[slot];
+        if (entry.filled && entry.key == key) {
+            return entry.text;
+        }
+    }
+
+    std::string text = encodeRaw(key.data(), key.size());
+
+    {
+        std::unique_lock lock(cacheLock);
+        CacheEntry& entry = cache[slot];
+        entry.key = key;
+        entry.text = text;
+        entry.filled = true;
+    }
+    return text;
+}
+
+std::string Base58::encode(const cs::Bytes& bytes) {
+    return encodeRaw(bytes.data(), bytes.size());
+}
+
+std::string Base58::encodeRaw(const cs::Byte* data, size_t size) {
+    size_t zeroes = 0;
+    while (zeroes < size && data[zeroes] == 0) {
+        ++zeroes;
+    }
+
+    // base58 digits, most significant first; sized for the 32 byte fast path,
+    // longer inputs spill over into the heap-backed general branch below
+    std::array<uint8_t, kMaxKeyDigits> digits{};
+    std::vector<uint8_t> spill;
+    uint8_t* buffer = digits.data();
+    size_t capacity = digits.size();
+    if (size - zeroes > 32) {
+        spill.assign((size - zeroes) * 138 / 100 + 1, 0);
+        buffer = spill.data();
+        capacity = spill.size();
+    }
+
+    size_t length = 0;
+    for (size_t i = zeroes; i < size; ++i) {
+        uint32_t carry = data[i];
+        size_t j = 0;
+        // constant divisor, the compiler lowers % and / to multiplications
+        for (size_t pos = capacity; j < length || carry != 0; ++j) {
+            --pos;
+            carry += uint32_t(buffer[pos]) << 8;
+            buffer[pos] = uint8_t(carry % 58);
+            carry /= 58;
+        }
+        length = j;
+    }
+
+    std::string result;
+    result.reserve(zeroes + length);
+    result.assign(zeroes, '1');
+    for (size_t pos = capacity - length; pos < capacity; ++pos) {
+        result.push_back(kAlphabet[buffer[pos]]);
+    }
+    return result;
+}
+}  // namespace cs
@@ -0,0 +1,105 @@
+#include <lib/system/cryptoservice.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <cscrypto/cscrypto.hpp>
+
+#include <lib/system/concurrent.hpp>
+
+cs::CryptoService& cs::CryptoService::instance() {
+    static cs::CryptoService service;
+    return service;
+}
+
+std::vector<cs::Byte> cs::CryptoService::verifyBatch(const std::vector<VerifyJob>& jobs) {
+    std::vector<cs::Byte> results(jobs.size(), 0);
+
+    if (jobs.empty()) {
+        return results;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+
+    auto verifyRange = [&](size_t first, size_t last) {
+        for (size_t index = first; index < last; ++index) {
+            const VerifyJob& job = jobs[index];
+            results[index] = cscrypto::verifySignature(job.signature, job.publicKey, job.message, job.messageSize) ? 1 : 0;
+        }
+    };
+
+    const size_t workers = std::thread::hardware_concurrency();
+
+    if (jobs.size() < kParallelThreshold || workers <= 1) {
+        verifyRange(0, jobs.size());
+    }
+    else {
+        const size_t chunks = std::min(workers, jobs.size());
+        const size_t perChunk = (jobs.size() + chunks - 1) / chunks;
+
+        std::atomic<size_t> jobsLeft{chunks};
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            const size_t first = chunk * perChunk;
+            const size_t last = std::min(first + perChunk, jobs.size());
+
+            boost::asio::post(cs::ThreadPool::instance(), [&, first, last] {
+                verifyRange(first, last);
+
+                if (jobsLeft.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard lock(doneMutex);
+                    doneCondition.notify_one();
+                }
+            });
+        }
+
+        std::unique_lock lock(doneMutex);
+        doneCondition.wait(lock, [&] {
+            return jobsLeft.load(std::memory_order_acquire) == 0;
+        });
+
+        parallelBatches_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    operations_.fetch_add(jobs.size(), std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    busyNs_.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), std::memory_order_relaxed);
+
+    return results;
+}
+
+bool cs::CryptoService::verifyAll(const std::vector<VerifyJob>& jobs) {
+    const std::vector<cs::Byte> results = verifyBatch(jobs);
+    return std::all_of(results.begin(), results.end(), [](cs::Byte result) {
+        return result != 0;
+    });
+}
+
+std::string cs::CryptoService::report() const {
+    const uint64_t operations = operations_.load(std::memory_order_relaxed);
+    const uint64_t batches = batches_.load(std::memory_order_relaxed);
+    const uint64_t parallel = parallelBatches_.load(std::memory_order_relaxed);
+    const uint64_t busyNs = busyNs_.load(std::memory_order_relaxed);
+
+    std::ostringstream out;
+    out << "verifications " << operations;
+    out << ", batches " << batches << " (parallel " << parallel << ")";
+
+    if (batches != 0) {
+        out << ", avg batch size " << (operations / batches);
+    }
+
+    if (operations != 0) {
+        out << ", avg verify " << (busyNs / operations / 1000) << " us";
+    }
+
+    return out.str();
+}
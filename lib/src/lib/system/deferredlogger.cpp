@@ -0,0 +1,94 @@
+#include <lib/system/deferredlogger.hpp>
+
+#include <chrono>
+
+cs::DeferredLogger::DeferredLogger() {
+    isRunning_.store(true, std::memory_order_release);
+    thread_ = std::thread(&cs::DeferredLogger::eventLoop, this);
+}
+
+cs::DeferredLogger::~DeferredLogger() {
+    stop();
+}
+
+void cs::DeferredLogger::stop() {
+    if (isRunning_.exchange(false, std::memory_order_acq_rel)) {
+        thread_.join();
+        drain();
+    }
+}
+
+void cs::DeferredLogger::eventLoop() {
+    while (isRunning_.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(PollTimeMs));
+    }
+}
+
+void cs::DeferredLogger::drain() {
+    Record record;
+    while (queue_.pop(record)) {
+        emitRecord(record);
+    }
+
+    if (auto dropped = dropped_.exchange(0, std::memory_order_relaxed); dropped != 0) {
+        BOOST_LOG_SEV(logger::getLogger<>(), logger::severity_level::warning) << "Deferred logger dropped " << dropped << " records";
+    }
+}
+
+void cs::DeferredLogger::emitRecord(const Record& record) {
+    BOOST_LOG_SEV(logger::getLogger<>(), record.severity) << format(record);
+}
+
+std::string cs::DeferredLogger::format(const Record& record) {
+    std::string result;
+    result.reserve(std::strlen(record.format) + size_t(record.count) * 8);
+
+    const char* f = record.format;
+    size_t arg = 0;
+
+    while (*f != '\0') {
+        if (f[0] == '{' && f[1] == '}' && arg < record.count) {
+            result += toString(record.types[arg], record.values[arg]);
+            ++arg;
+            f += 2;
+        }
+        else {
+            result += *f++;
+        }
+    }
+
+    // arguments without a placeholder are appended, space separated
+    for (; arg < record.count; ++arg) {
+        result += ' ';
+        result += toString(record.types[arg], record.values[arg]);
+    }
+
+    return result;
+}
+
+std::string cs::DeferredLogger::toString(ArgType type, uint64_t value) {
+    switch (type) {
+        case ArgType::Signed: {
+            int64_t v;
+            std::memcpy(&v, &value, sizeof(v));
+            return std::to_string(v);
+        }
+        case ArgType::Unsigned:
+            return std::to_string(value);
+        case ArgType::Float: {
+            double v;
+            std::memcpy(&v, &value, sizeof(v));
+            return std::to_string(v);
+        }
+        case ArgType::Bool:
+            return value != 0 ? "true" : "false";
+        case ArgType::Literal: {
+            const char* v;
+            std::memcpy(&v, &value, sizeof(v));
+            return v != nullptr ? std::string(v) : std::string();
+        }
+    }
+
+    return std::string();
+}
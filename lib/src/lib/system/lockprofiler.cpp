@@ -0,0 +1,125 @@
+#include <lib/system/lockprofiler.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+class SpinGuard {
+public:
+    explicit SpinGuard(std::atomic_flag& flag)
+    : flag_(flag) {
+        while (flag_.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+
+    ~SpinGuard() {
+        flag_.clear(std::memory_order_release);
+    }
+
+private:
+    std::atomic_flag& flag_;
+};
+
+std::string formatNs(uint64_t ns) {
+    std::ostringstream out;
+
+    if (ns >= 1000000000ULL) {
+        out << (ns / 1000000000ULL) << "." << ((ns / 100000000ULL) % 10) << " s";
+    }
+    else if (ns >= 1000000ULL) {
+        out << (ns / 1000000ULL) << "." << ((ns / 100000ULL) % 10) << " ms";
+    }
+    else {
+        out << (ns / 1000ULL) << " us";
+    }
+
+    return out.str();
+}
+}  // namespace
+
+namespace cs {
+LockProfiler::ThreadBuffer& LockProfiler::currentBuffer() {
+    static thread_local ThreadBuffer* buffer = nullptr;
+
+    if (buffer == nullptr) {
+        auto created = std::make_unique<ThreadBuffer>();
+        buffer = created.get();
+
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        buffers_.push_back(std::move(created));
+    }
+
+    return *buffer;
+}
+
+void LockProfiler::record(const void* lock, uint64_t waitNs, uint64_t holdNs) noexcept {
+    ThreadBuffer& buffer = currentBuffer();
+
+    // the spin is only ever contended by a concurrent report()
+    SpinGuard guard(buffer.spin);
+    Entry& entry = buffer.entries[lock];
+
+    ++entry.acquisitions;
+    entry.waitNs += waitNs;
+    entry.holdNs += holdNs;
+    entry.maxWaitNs = std::max(entry.maxWaitNs, waitNs);
+}
+
+void LockProfiler::name(const void* lock, const char* label) {
+    std::lock_guard<std::mutex> lock_(namesMutex_);
+    names_[lock] = label;
+}
+
+std::string LockProfiler::report() const {
+    std::unordered_map<const void*, Entry> merged;
+
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+
+        for (const auto& buffer : buffers_) {
+            SpinGuard guard(buffer->spin);
+
+            for (const auto& [lock, entry] : buffer->entries) {
+                Entry& total = merged[lock];
+                total.acquisitions += entry.acquisitions;
+                total.waitNs += entry.waitNs;
+                total.holdNs += entry.holdNs;
+                total.maxWaitNs = std::max(total.maxWaitNs, entry.maxWaitNs);
+            }
+        }
+    }
+
+    std::vector<std::pair<const void*, Entry>> sorted(merged.begin(), merged.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.second.waitNs > rhs.second.waitNs; });
+
+    if (sorted.size() > kReportedSites) {
+        sorted.resize(kReportedSites);
+    }
+
+    std::ostringstream out;
+    out << "lock profile, top " << sorted.size() << " by total wait:\n";
+
+    std::lock_guard<std::mutex> lock(namesMutex_);
+
+    for (const auto& [address, entry] : sorted) {
+        const auto label = names_.find(address);
+
+        if (label != names_.end()) {
+            out << label->second;
+        }
+        else {
+            out << address;
+        }
+
+        out << ": acquisitions " << entry.acquisitions;
+        out << ", wait total " << formatNs(entry.waitNs);
+        out << " avg " << formatNs(entry.acquisitions != 0 ? entry.waitNs / entry.acquisitions : 0);
+        out << " max " << formatNs(entry.maxWaitNs);
+        out << ", hold total " << formatNs(entry.holdNs);
+        out << " avg " << formatNs(entry.acquisitions != 0 ? entry.holdNs / entry.acquisitions : 0);
+        out << "\n";
+    }
+
+    return out.str();
+}
+}  // namespace cs
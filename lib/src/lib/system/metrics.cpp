@@ -0,0 +1,133 @@
+#include <lib/system/metrics.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace cs {
+size_t LatencyHistogram::indexOf(uint64_t value) noexcept {
+    if (value < kSubCount) {
+        return static_cast<size_t>(value);
+    }
+
+    size_t msb = 0;
+    uint64_t rest = value;
+
+    while (rest >>= 1) {
+        ++msb;
+    }
+
+    const size_t bucket = msb - kSubBits + 1;
+    const uint64_t sub = (value >> (msb - kSubBits)) - kSubCount;
+
+    return bucket * static_cast<size_t>(kSubCount) + static_cast<size_t>(sub);
+}
+
+uint64_t LatencyHistogram::lowerBoundOf(size_t index) noexcept {
+    if (index < kSubCount) {
+        return static_cast<uint64_t>(index);
+    }
+
+    const uint64_t bucket = index / kSubCount;
+    const uint64_t sub = index % kSubCount;
+
+    return (kSubCount + sub) << (bucket - 1);
+}
+
+LatencyHistogram::Shard& LatencyHistogram::currentShard() noexcept {
+    static thread_local const size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % kShardsCount;
+    return shards_[index];
+}
+
+void LatencyHistogram::record(uint64_t micros) noexcept {
+    Shard& shard = currentShard();
+
+    shard.buckets[indexOf(micros)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(micros, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string LatencyHistogram::report() const {
+    std::vector<uint64_t> buckets(kBucketsCount, 0);
+    uint64_t count = 0;
+    uint64_t sum = 0;
+
+    for (const Shard& shard : shards_) {
+        for (size_t i = 0; i < kBucketsCount; ++i) {
+            buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+
+        count += shard.count.load(std::memory_order_relaxed);
+        sum += shard.sum.load(std::memory_order_relaxed);
+    }
+
+    if (count == 0) {
+        return "count=0";
+    }
+
+    const auto quantile = [&](double q) {
+        const uint64_t rank = static_cast<uint64_t>(static_cast<double>(count) * q);
+        uint64_t seen = 0;
+
+        for (size_t i = 0; i < kBucketsCount; ++i) {
+            seen += buckets[i];
+
+            if (seen > rank) {
+                return lowerBoundOf(i);
+            }
+        }
+
+        return lowerBoundOf(kBucketsCount - 1);
+    };
+
+    std::string result;
+    result += "count=" + std::to_string(count);
+    result += ", avg=" + std::to_string(sum / count);
+    result += ", p50=" + std::to_string(quantile(0.5));
+    result += ", p90=" + std::to_string(quantile(0.9));
+    result += ", p99=" + std::to_string(quantile(0.99));
+    result += ", p999=" + std::to_string(quantile(0.999));
+
+    return result;
+}
+
+LatencyHistogram& Metrics::histogram(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& pointer = histograms_[name];
+
+    if (!pointer) {
+        pointer = std::make_unique<LatencyHistogram>();
+    }
+
+    return *pointer;
+}
+
+std::atomic<uint64_t>& Metrics::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& pointer = counters_[name];
+
+    if (!pointer) {
+        pointer = std::make_unique<std::atomic<uint64_t>>(0);
+    }
+
+    return *pointer;
+}
+
+void Metrics::forEachCounter(const std::function<void(const std::string&, uint64_t)>& callback) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& [name, value] : counters_) {
+        callback(name, value->load(std::memory_order_relaxed));
+    }
+}
+
+std::string Metrics::report() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string result;
+
+    for (const auto& [name, histogram] : histograms_) {
+        result += name + ": " + histogram->report() + "\n";
+    }
+
+    return result;
+}
+}  // namespace cs
@@ -0,0 +1,175 @@
+#include <lib/system/stacksampler.hpp>
+
+#include <chrono>
+#include <thread>
+
+#ifdef __linux__
+#include <csignal>
+#endif
+
+namespace {
+#ifdef __linux__
+// handler-to-waiter rendezvous. Exactly one thread is signalled at a time and
+// the capture loop waits for completion before touching the buffer or
+// signalling the next thread, so plain static storage is sufficient. Count is
+// the completion flag: -1 while a sample is outstanding
+uint64_t g_frames[64];  // sized to StackSampler::kMaxFrames
+std::atomic<int> g_frameCount{-1};
+
+// a thread may park with frame pointers the walker cannot follow; give the
+// handler a short grace period, then abandon the tick
+constexpr auto kHandlerWaitLimit = std::chrono::milliseconds(20);
+#endif
+}  // namespace
+
+namespace cs {
+
+#ifdef __linux__
+
+/*static*/
+void StackSampler::installHandler() {
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        struct sigaction action {};
+        action.sa_handler = &StackSampler::samplingHandler;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        ::sigaction(SIGPROF, &action, nullptr);
+    });
+}
+
+/*static*/
+void StackSampler::samplingHandler(int) {
+    // runs on the interrupted thread; only async-signal-safe operations here.
+    // The walk follows the frame-pointer chain, so depth beyond the handler's
+    // own frames requires building with frame pointers kept; without them the
+    // walk stops early and the sample degrades instead of crashing
+    void** fp = static_cast<void**>(__builtin_frame_address(0));
+    uintptr_t previous = 0;
+    int count = 0;
+
+    // frames must move strictly up the stack in sane, aligned steps;
+    // anything else means the chain is broken and the walk stops
+    constexpr uintptr_t kMaxFrameDistance = 1 << 20;
+
+    while (fp != nullptr && count < static_cast<int>(kMaxFrames)) {
+        const uintptr_t current = reinterpret_cast<uintptr_t>(fp);
+
+        if ((current & (sizeof(void*) - 1)) != 0) {
+            break;
+        }
+        if (previous != 0 && (current <= previous || current - previous > kMaxFrameDistance)) {
+            break;
+        }
+
+        void* returnAddress = fp[1];
+        if (returnAddress == nullptr) {
+            break;
+        }
+
+        g_frames[count++] = reinterpret_cast<uint64_t>(returnAddress);
+        previous = current;
+        fp = static_cast<void**>(fp[0]);
+    }
+
+    g_frameCount.store(count, std::memory_order_release);
+}
+
+bool StackSampler::sampleThread(pthread_t thread) {
+    g_frameCount.store(-1, std::memory_order_release);
+
+    if (pthread_kill(thread, SIGPROF) != 0) {
+        g_frameCount.store(0, std::memory_order_release);
+        return false;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + kHandlerWaitLimit;
+
+    while (g_frameCount.load(std::memory_order_acquire) < 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    return true;
+}
+
+void StackSampler::registerThread(const std::string& name) {
+    installHandler();
+
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    threads_[pthread_self()] = name;
+}
+
+void StackSampler::unregisterThread() {
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    threads_.erase(pthread_self());
+}
+
+std::vector<StackSampler::Sample> StackSampler::capture(size_t durationMs, size_t intervalMs) {
+    std::vector<Sample> samples;
+
+    bool expected = false;
+    if (!capturing_.compare_exchange_strong(expected, true)) {
+        return samples;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::milliseconds(durationMs);
+
+    while (std::chrono::steady_clock::now() < deadline && samples.size() < kMaxSamples) {
+        std::map<pthread_t, std::string> targets;
+        {
+            std::lock_guard<std::mutex> lock(threadsMutex_);
+            targets = threads_;
+        }
+
+        const auto offset = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        for (const auto& [thread, name] : targets) {
+            if (!sampleThread(thread)) {
+                // the previous handler may still be pending; signalling
+                // another thread now could tear the shared buffer, so this
+                // tick ends here
+                break;
+            }
+
+            const int count = g_frameCount.load(std::memory_order_acquire);
+            if (count <= 0) {
+                continue;
+            }
+
+            Sample sample;
+            sample.thread = name;
+            sample.offsetMs = static_cast<uint64_t>(offset.count());
+            sample.frames.assign(g_frames, g_frames + count);
+            samples.push_back(std::move(sample));
+
+            if (samples.size() >= kMaxSamples) {
+                break;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+
+    capturing_.store(false, std::memory_order_release);
+    return samples;
+}
+
+#else
+
+void StackSampler::registerThread(const std::string&) {
+}
+
+void StackSampler::unregisterThread() {
+}
+
+std::vector<StackSampler::Sample> StackSampler::capture(size_t, size_t) {
+    return {};
+}
+
+#endif
+
+}  // namespace cs
@@ -36,11 +36,16 @@ public:
     enum Options : size_t {
         DefaultMapSize = 10485760,
         Default1GbMapSize = 1UL * 1024UL * 1024UL * 1024UL,
-        DefaultIncreaseSize = DefaultMapSize
+        DefaultIncreaseSize = DefaultMapSize,
+        DefaultGrowthThresholdPercent = 75
     };
 
     enum Flags : unsigned int {
-        DefaultEnvFlags = MDB_NOSYNC | MDB_WRITEMAP | MDB_MAPASYNC
+        DefaultEnvFlags = MDB_NOSYNC | MDB_WRITEMAP | MDB_MAPASYNC,
+
+        // for point-lookup workloads: OS readahead only pollutes the page
+        // cache when keys are visited in hash order rather than sequentially
+        RandomAccessEnvFlags = DefaultEnvFlags | MDB_NORDAHEAD
     };
 
     explicit Lmdb(const std::string& path, const unsigned int flags = lmdb::env::default_flags);
@@ -123,6 +128,39 @@ public:
         return stats.me_mapsize;
     }
 
+    // returns used part of the map in percent of its current size
+    size_t occupancyPercent() const {
+        if (!isOpen()) {
+            return size_t{};
+        }
+
+        Info metaInfo = info();
+
+        if (metaInfo.me_mapsize == 0) {
+            return size_t{};
+        }
+
+        Stats metaStats = stats();
+        return (metaStats.ms_psize * metaInfo.me_last_pgno * 100) / metaInfo.me_mapsize;
+    }
+
+    // grows the map by increase size once occupancy reaches the threshold.
+    // Remapping stalls every reader of this environment, so owners may call
+    // this from the writing thread at a quiet moment instead of letting the
+    // write path hit the low-space guard in the middle of a busy round.
+    // Returns true when the map was actually resized
+    bool growIfNeeded(size_t thresholdPercent = Options::DefaultGrowthThresholdPercent) {
+        if (!isOpen() || occupancyPercent() < thresholdPercent) {
+            return false;
+        }
+
+        auto newSize = mapSize() + increaseSize_;
+        setMapSize(newSize);
+
+        emit mapSizeIncreased(newSize);
+        return true;
+    }
+
     // flushes data to drive in sync mode
     void flush() {
         flushImpl(true);
@@ -159,6 +197,76 @@ public:
 
     /// transactions
 
+    // groups many puts into a single write transaction committed as one group,
+    // obtained from writeBatch(); not thread safe, use from the creating thread.
+    // the destructor aborts an uncommitted batch; the per-key commited signal
+    // is not emitted for batched inserts
+    class WriteBatch {
+    public:
+        WriteBatch(WriteBatch&&) = default;
+
+        void insert(const char* keyData, std::size_t keySize, const char* valueData, std::size_t valueSize,
+                    const unsigned int flags = lmdb::dbi::default_put_flags) {
+            lmdb::val key(reinterpret_cast<const void*>(keyData), keySize);
+            lmdb::val value(reinterpret_cast<const void*>(valueData), valueSize);
+
+            dbi_.put(transaction_, key, value, flags);
+        }
+
+        template<typename Key, typename Value>
+        void insert(const Key& key, const Value& value, const unsigned int flags = lmdb::dbi::default_put_flags) {
+            decltype(auto) k = db_.cast(key);
+            decltype(auto) v = db_.cast(value);
+
+            insert(reinterpret_cast<const char*>(k.data()), k.size(),
+                   reinterpret_cast<const char*>(v.data()), v.size(),
+                   flags);
+        }
+
+        // fast path for bulk sequential loading: the key must be greater than
+        // every key already in the database in its sort order (note that the
+        // wrapper encodes integral keys as ASCII, which is not numerically
+        // sorted across digit counts)
+        template<typename Key, typename Value>
+        void append(const Key& key, const Value& value) {
+            insert(key, value, MDB_APPEND);
+        }
+
+        // commits the whole group, returns false and emits the failure signal
+        // of the owning database on error
+        bool commit() {
+            try {
+                transaction_.commit();
+                return true;
+            }
+            catch (const lmdb::error& error) {
+                db_.raise(error);
+            }
+
+            return false;
+        }
+
+    private:
+        WriteBatch(Lmdb& db, const char* name)
+        : db_(db)
+        , transaction_(lmdb::txn::begin(*db.env_))
+        , dbi_(lmdb::dbi::open(transaction_, name)) {
+        }
+
+        Lmdb& db_;
+        lmdb::txn transaction_;
+        lmdb::dbi dbi_;
+
+        friend class Lmdb;
+    };
+
+    // begins a write batch on this database, may throw lmdb::error,
+    // name - table name at current path, nullptr if only one table exist
+    WriteBatch writeBatch(const char* name = nullptr) {
+        checkMapSize();
+        return WriteBatch(*this, name);
+    }
+
     // inserts pair of key/value to database as byte stream,
     // name - table name at current path, nullptr if only one table exist,
     // with default flags rewrites value if key exists at db
@@ -458,6 +566,13 @@ protected:
     }
 
     void checkMapSize() {
+        // threshold growth first, so large maps are resized well before they
+        // run out; the free-space guard below remains the last resort for
+        // maps smaller than a couple of increase steps
+        if (growIfNeeded()) {
+            return;
+        }
+
         Info metaInfo = info();
         Stats metaStats = stats();
 
@@ -1,6 +1,8 @@
 #ifndef NEIGHBOURHOOD_HPP
 #define NEIGHBOURHOOD_HPP
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <mutex>
 #include <unordered_map>
@@ -19,6 +21,7 @@ class Neighbourhood {
 public:
     using NeighboursCallback = std::function<void(const cs::PublicKey&, cs::Sequence, cs::RoundNumber)>;
     using NeighbourPingSignal = cs::Signal<void(cs::Sequence, const cs::PublicKey&)>;
+    using NeighbourLagSignal = cs::Signal<void(uint64_t, const cs::PublicKey&)>;
 
     constexpr static uint32_t kMaxNeighbours = 16;
     constexpr static uint32_t kMinNeighbours = 1;
@@ -28,7 +31,11 @@ public:
     Neighbourhood(Transport*, Node*);
 
     void setPermanentNeighbours(const std::set<cs::PublicKey>&);
-    
+
+    // admit permanent neighbours only; a read replica keeps just its
+    // configured upstream links and stays out of the general topology
+    void restrictToPermanent();
+
     void processNeighbourMessage(const cs::PublicKey& sender, const Packet&);
     void newPeerDiscovered(const cs::PublicKey&);
     void peerDisconnected(const cs::PublicKey&);
@@ -37,12 +44,26 @@ public:
 
     void forEachNeighbour(NeighboursCallback);
     uint32_t getNeighboursCount() const;
+
+    // per-link view for diagnostics, a copy of what the ping exchange tracks
+    struct LinkStats {
+        cs::Sequence lastSeq = 0;
+        cs::RoundNumber roundNumber = 0;
+        uint64_t rttEwmaMs = 0;
+        bool permanent = false;
+    };
+    using LinkStatsCallback = std::function<void(const cs::PublicKey&, const LinkStats&)>;
+
+    void forEachLinkStat(LinkStatsCallback) const;
     bool contains(const cs::PublicKey& neighbour) const;
     void add(const std::set<cs::PublicKey>&);
 
 public signals:
     NeighbourPingSignal neighbourPingReceived;
 
+    // smoothed ping round-trip of a neighbour changed, in milliseconds
+    NeighbourLagSignal neighbourLagUpdated;
+
 private:
     template<class... Args>
     static Packet formPacket(BaseFlags flags, NetworkCommand cmd, Args&&... args);
@@ -53,6 +74,10 @@ private:
         cs::Sequence lastSeq = 0;
         cs::RoundNumber roundNumber = 0;
         bool permanent = false;
+
+        // ping round-trip tracking, updated in place on every pong
+        std::chrono::steady_clock::time_point pingSentTime{};
+        uint64_t rttEwmaMs = 0;
     };
 
     void sendVersionRequest(const cs::PublicKey& receiver);
@@ -85,5 +110,8 @@ private:
 
     mutable std::mutex permNeighbourMux_;
     std::unordered_set<cs::PublicKey> permanentNeighbours_;
+
+    // set once before traffic starts, read on every admission
+    std::atomic<bool> restrictToPermanent_{ false };
 };
 #endif  // NEIGHBOURHOOD_HPP
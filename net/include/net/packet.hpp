@@ -62,6 +62,10 @@ enum MsgTypes : uint8_t {
     TransactionPacketHash,
     TransactionsPacketBaseRequest,
     TransactionsPacketBaseReply,
+    TransactionsPacketDigestRequest,
+    TransactionsPacketDigestReply,
+    RoundPackageHash,
+    TransactionsPacketIndexRequest,
     NodeStopRequest = 255
 };
 
@@ -12,17 +12,24 @@ class PacketsQueue {
 public:
     using SenderAndPacket = std::pair<cs::PublicKey, Packet>;
 
-    bool empty() const;
-    SenderAndPacket pop();
-    void push(const cs::PublicKey&, Packet&&);
-    void clear();
-private:
     enum class Priority {
         kFirst,
         kSecond
     };
 
-    Priority getPriority(MsgTypes type) const;
+    static Priority getPriority(MsgTypes type);
+
+    // subset of first-priority types a round cannot make progress without;
+    // these keep their lane even when the sender is over its rate limit
+    static bool isConsensusMessage(MsgTypes type);
+
+    bool empty() const;
+    size_t size() const;
+    SenderAndPacket pop();
+    void push(const cs::PublicKey&, Packet&&);
+    void push(const cs::PublicKey&, Packet&&, Priority);
+    void clear();
+private:
     size_t numPackets() const;
     size_t numBytes() const;
     bool shrink();
@@ -0,0 +1,55 @@
+#ifndef PACKETTRACE_HPP
+#define PACKETTRACE_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+// capture and replay of the node message stream. The writer appends every
+// dispatched message to a fixed-capacity ring file, so a production incident
+// leaves behind the exact packet sequence that caused it; the reader restores
+// the records in arrival order for offline replay through the same dispatch
+// code, see Transport::replayTrace()
+
+struct PacketTraceRecord {
+    uint64_t timestampUs = 0;  // steady clock, microseconds since capture start
+    cs::PublicKey sender{};
+    cs::Bytes packetBytes;     // full wire packet including the header
+};
+
+class PacketTraceWriter {
+public:
+    ~PacketTraceWriter();
+
+    // capacity is rounded down to whole records at runtime; an existing file
+    // at the given path is overwritten
+    bool open(const std::string& path, uint64_t capacityBytes);
+    void close();
+
+    bool isOpen() const {
+        return file_.is_open();
+    }
+
+    void append(const cs::PublicKey& sender, const cs::Byte* data, size_t size);
+
+private:
+    void writeHeader();
+
+    std::fstream file_;
+    uint64_t capacityBytes_ = 0;
+    uint64_t writeOffset_ = 0;
+    bool wrapped_ = false;
+    uint64_t startTimeUs_ = 0;
+    uint64_t appendsSinceFlush_ = 0;
+};
+
+class PacketTraceReader {
+public:
+    // loads the whole trace to memory, oldest record first. Records partially
+    // overwritten by the ring wrap are skipped
+    static std::vector<PacketTraceRecord> load(const std::string& path);
+};
+
+#endif  // PACKETTRACE_HPP
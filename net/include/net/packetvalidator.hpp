@@ -10,7 +10,17 @@ namespace cs {
 // validates all network packets
 class PacketValidator {
 public:
+    // full check, equivalent to validateHeader() followed by validateStructure()
     static bool validate(const Packet& packet);
+
+    // branch-minimal header sanity check, cheap enough for the socket-draining
+    // thread; everything else belongs to validateStructure()
+    static bool validateHeader(const Packet& packet);
+
+    // per-type structural validation, runs on the processor thread before
+    // dispatch so validation spikes during floods never slow the receive loop
+    static bool validateStructure(const Packet& packet);
+
     static const cs::PublicKey& getBlockChainKey();
 
 private:
@@ -0,0 +1,43 @@
+#ifndef PEERQUALITYSTORE_HPP
+#define PEERQUALITYSTORE_HPP
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <lib/system/common.hpp>
+
+// persisted per-peer link quality. Survives node restarts, so a freshly
+// started node can target its historically fastest neighbours immediately
+// instead of rediscovering them ping by ping
+class PeerQualityStore {
+public:
+    struct Quality {
+        uint64_t rttEwmaMs = 0;
+        cs::Sequence lastSequence = 0;
+        uint32_t banCount = 0;
+    };
+
+    // max entries restored from disk, protects against corrupt files
+    constexpr static size_t kMaxStoredPeers = 10000;
+
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+
+    void updateLag(const cs::PublicKey& peer, uint64_t rttMs);
+    void updateSequence(const cs::PublicKey& peer, cs::Sequence sequence);
+    void registerBan(const cs::PublicKey& peer);
+
+    // returns the stored quality if the peer was seen in previous runs
+    std::optional<Quality> get(const cs::PublicKey& peer) const;
+
+    size_t size() const;
+
+private:
+    constexpr static cs::Byte kFormatVersion = 1U;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<cs::PublicKey, Quality> peers_;
+};
+#endif  // PEERQUALITYSTORE_HPP
@@ -0,0 +1,62 @@
+#ifndef PEER_RATE_LIMITER_HPP
+#define PEER_RATE_LIMITER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <csnode/cyclicbuffer.hpp>
+#include <lib/system/common.hpp>
+
+// per-neighbour inbound rate accounting over a ring of one-second slots.
+// A peer pushing more bytes or messages through us than the window budget
+// allows is reported as over limit until its window drains below half of
+// the budget (the hysteresis keeps the verdict from flapping right at the
+// boundary). Nobody gets banned here: the transport only demotes the
+// offender's non-consensus traffic in the inbox, so round messages still
+// go through while bulk floods wait behind everyone else
+class PeerRateLimiter {
+public:
+    // accounts one inbound packet, returns true while the sender is over limit
+    bool account(const cs::PublicKey& sender, size_t packetSize);
+    void remove(const cs::PublicKey& sender);
+
+    // inbound traffic snapshot per peer, for diagnostics
+    struct Stats {
+        uint64_t windowBytes = 0;
+        uint64_t windowMessages = 0;
+        uint64_t totalBytes = 0;
+        uint64_t totalMessages = 0;
+        bool throttled = false;
+    };
+
+    std::unordered_map<cs::PublicKey, Stats> stats() const;
+
+    constexpr static uint32_t kWindowSlots = 8;
+
+private:
+    constexpr static uint64_t kMaxBytesPerWindow = 32ull * 1024 * 1024;
+    constexpr static uint64_t kMaxMessagesPerWindow = 16384;
+
+    struct Slot {
+        uint64_t bytes = 0;
+        uint64_t messages = 0;
+    };
+
+    struct PeerWindow {
+        CyclicBuffer<Slot, kWindowSlots> slots;
+        uint64_t windowBytes = 0;
+        uint64_t windowMessages = 0;
+        uint64_t totalBytes = 0;
+        uint64_t totalMessages = 0;
+        uint64_t currentSecond = 0;
+        bool throttled = false;
+    };
+
+    void rotate(PeerWindow& window, uint64_t nowSeconds);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<cs::PublicKey, PeerWindow> peers_;
+};
+
+#endif // PEER_RATE_LIMITER_HPP
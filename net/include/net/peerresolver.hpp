@@ -0,0 +1,64 @@
+#ifndef PEERRESOLVER_HPP
+#define PEERRESOLVER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <p2p_network.h>
+
+// resolves configured peer host names on its own thread so a slow or stalled
+// DNS server can never block the packet path or the transport main loop. Each
+// entry is retried with per-peer exponential backoff until it resolves or the
+// resolver is stopped; successful lookups are reported through a callback on
+// the resolver thread. Entries can also be re-queued at runtime, which turns
+// the same backoff machinery into a reconnect schedule for peers whose
+// addresses may have changed since startup
+class PeerResolver {
+public:
+    struct Entry {
+        std::string host;
+        uint16_t port = 0;
+        std::string id;  // base58 node id from the config, kept as written
+    };
+
+    using ResolvedCallback = std::function<void(const Entry&, const net::bi::address&)>;
+
+    constexpr static std::chrono::milliseconds kInitialBackoff{500};
+    constexpr static std::chrono::milliseconds kMaxBackoff{60000};
+
+    ~PeerResolver();
+
+    // starts the resolver thread; entries already holding a numeric address
+    // resolve on the first attempt, host names go through DNS. The callback
+    // is invoked from the resolver thread, once per successful lookup
+    void start(std::vector<Entry> entries, ResolvedCallback callback);
+
+    // queues an entry for (re-)resolution with a fresh backoff; safe to call
+    // from any thread after start()
+    void schedule(const Entry& entry);
+
+    void stop();
+
+private:
+    struct Pending {
+        Entry entry;
+        std::chrono::steady_clock::time_point nextAttempt;
+        std::chrono::milliseconds backoff = kInitialBackoff;
+    };
+
+    void routine();
+    bool tryResolve(const Entry& entry, net::bi::address& result);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Pending> pending_;
+    ResolvedCallback callback_;
+    std::thread thread_;
+    bool stopped_ = false;
+};
+#endif  // PEERRESOLVER_HPP
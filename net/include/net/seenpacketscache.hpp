@@ -0,0 +1,44 @@
+#ifndef SEENPACKETSCACHE_HPP
+#define SEENPACKETSCACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// early duplicate suppression for broadcast flooding: every neighbour relays the
+// same logical packet, so with N neighbours up to N-1 identical copies arrive and
+// each used to pay full parsing and Node dispatch before higher layers discarded
+// it. The cache keeps 64-bit fingerprints of recently received payloads in two
+// aging generations; checkAndSet() is lock-free and sits on the receive path
+// before any deserialization.
+class SeenPacketsCache {
+public:
+    // returns true if the payload was received recently; the first copy is
+    // recorded and reported as unseen
+    bool checkAndSet(const void* data, size_t size);
+
+    uint64_t suppressedCount() const {
+        return suppressed_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // 64k buckets per generation, 1 MiB total. A bucket collision overwrites the
+    // older fingerprint and only costs a missed duplicate; wrongly dropping a
+    // first copy requires a full 64-bit fingerprint match
+    constexpr static size_t kBuckets = size_t(1) << 16;
+
+    // a generation is dropped entirely after two rotations, so a duplicate is
+    // remembered for 30..60 seconds - longer than any broadcast keeps circulating
+    constexpr static int64_t kRotateEveryMs = 30000;
+
+    using Generation = std::array<std::atomic<uint64_t>, kBuckets>;
+
+    void maybeRotate(int64_t nowMs);
+
+    Generation generations_[2];
+    // low bit selects the generation currently written to
+    std::atomic<uint32_t> epoch_ = {0};
+    std::atomic<int64_t> nextRotationMs_ = {0};
+    std::atomic<uint64_t> suppressed_ = {0};
+};
+#endif  // SEENPACKETSCACHE_HPP
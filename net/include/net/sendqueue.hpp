@@ -0,0 +1,65 @@
+#ifndef SEND_QUEUE_HPP
+#define SEND_QUEUE_HPP
+
+#include <list>
+#include <vector>
+
+#include <lib/system/common.hpp>
+
+#include "packet.hpp"
+
+// outbound counterpart of PacketsQueue: packets waiting for the wire are
+// grouped into traffic classes and drained by weighted round-robin, so a
+// multi-megabyte block reply cannot delay our own consensus stages
+class SendQueue {
+public:
+    enum class Destination : uint8_t {
+        kDirect,
+        kMulticast,
+        kBroadcast,
+        kBroadcastIfNoConnection
+    };
+
+    struct Entry {
+        Destination destination = Destination::kBroadcast;
+        Packet pack;
+        std::vector<cs::PublicKey> receivers; // single element for kDirect/kBroadcastIfNoConnection, empty for kBroadcast
+    };
+
+    enum class Class : uint8_t {
+        kConsensus = 0,
+        kRoundTable,
+        kTransactions,
+        kSyncBulk
+    };
+
+    static Class getClass(MsgTypes type);
+
+    bool empty() const;
+    Entry pop();
+    void push(Entry&&);
+    void clear();
+
+private:
+    size_t numPackets() const;
+    size_t numBytes() const;
+    bool shrink();
+    void refillCredits();
+
+    constexpr static size_t kClassesCount = 4;
+
+    // packets a class may send before yielding to lower classes; refilled
+    // when every non-empty class runs out, bounding the delay of a stage
+    // broadcast behind sync bulk to a handful of packets
+    constexpr static size_t kWeights[kClassesCount] = {8, 4, 2, 1};
+
+    constexpr static size_t kMaxPacketsToHandle = 1ul << 17; // 131_072
+    constexpr static size_t kMaxBytesToHandle = 1ul << 29; // 536_870_912 bytes
+
+    size_t bytes_[kClassesCount] = {};
+    size_t credits_[kClassesCount] = {};
+
+    std::list<Entry> queues_[kClassesCount];
+};
+
+#endif // SEND_QUEUE_HPP
@@ -16,6 +16,7 @@
 
 #include <lib/system/common.hpp>
 #include <lib/system/logger.hpp>
+#include <lib/system/queues.hpp>
 #include <lib/system/signals.hpp>
 
 #include <p2p_network.h>
@@ -23,10 +24,17 @@
 #include "neighbourhood.hpp"
 #include "packet.hpp"
 #include "packetsqueue.hpp"
+#include "packettrace.hpp"
+#include "peerqualitystore.hpp"
+#include "peerratelimiter.hpp"
+#include "peerresolver.hpp"
+#include "seenpacketscache.hpp"
+#include "sendqueue.hpp"
 
 inline volatile std::sig_atomic_t gSignalStatus = 0;
 
 using PingSignal = cs::Signal<void(cs::Sequence, const cs::PublicKey&)>;
+using PingLagSignal = cs::Signal<void(uint64_t, const cs::PublicKey&)>;
 using NeighbourAddedSignal = cs::Signal<void(const cs::PublicKey&, cs::Sequence, cs::RoundNumber)>;
 using NeighbourRemovedSignal = cs::Signal<void(const cs::PublicKey&)>;
 
@@ -53,6 +61,11 @@ public:
     void processNodeMessage(const cs::PublicKey&, const Packet&);
     void processPostponed(const cs::RoundNumber); // @TODO move to Node
 
+    // feeds a captured trace back through processNodeMessage() with the
+    // original inter-message delays divided by speedFactor; 0 replays as
+    // fast as possible. Runs instead of the network loop, see run()
+    void replayTrace(const std::string& path, uint64_t speedFactor);
+
     void sendDirect(Packet&&, const cs::PublicKey&);
     void sendMulticast(Packet&&, const std::vector<cs::PublicKey>&);
     void sendBroadcast(Packet&&);
@@ -64,8 +77,12 @@ public:
     void getBanList(BanList&) const;
     void clearInbox();
 
+    // current inbox backlog, for metrics export
+    size_t inboxQueueSize();
+
     // neighbours interface
     void setPermanentNeighbours(const std::set<cs::PublicKey>&);
+    void restrictNeighboursToPermanent();
     uint32_t getNeighboursCount() const;
     uint32_t getMaxNeighbours() const;
     void forEachNeighbour(Neighbourhood::NeighboursCallback);
@@ -74,15 +91,21 @@ public:
 
     void getKnownPeers(std::vector<cs::PeerData>&);
 
+    // human-readable per-peer link report for the diag API: ping round-trip,
+    // chain position and inbound traffic windows of every neighbour
+    std::string getPeerStatsReport();
+
     // from neigbours
     // @param added - true if new neighbour adder, false if removed
     void onNeighboursChanged(const cs::PublicKey&, cs::Sequence lastSeq,
                             cs::RoundNumber lastRound, bool added);
 public slots:
     void onPingReceived(cs::Sequence sequence, const cs::PublicKey& key);
+    void onNeighbourLagUpdated(uint64_t rttMs, const cs::PublicKey& key);
 
 public signals:
     PingSignal pingReceived;
+    PingLagSignal pingLagUpdated;
     cs::Action mainThreadIterated;
     NeighbourAddedSignal neighbourAdded;
     NeighbourRemovedSignal neighbourRemoved;
@@ -108,10 +131,20 @@ private:
     void dispatchNodeMessage(const cs::PublicKey& sender, const MsgTypes,
                              const cs::RoundNumber, const uint8_t* data, size_t);
     void processorRoutine();
+    void senderRoutine();
+    void enqueueOutbound(SendQueue::Entry&&);
+    void dispatchOutbound(SendQueue::Entry&&);
     void process();
     void checkNeighboursChange();
 
     bool good_ = false;
+
+    // boot node entries whose host names could not be parsed as numeric
+    // addresses at startup; filled by createNetConfig() while config_ is
+    // built, so it has to be constructed first. Handed to peerResolver_ in
+    // run() for asynchronous DNS instead of blocking the constructor
+    std::vector<PeerResolver::Entry> unresolvedBootNodes_;
+
     net::Config config_;
 
     Node* node_;
@@ -120,12 +153,49 @@ private:
     std::mutex inboxMux_;
     PacketsQueue inboxQueue_;
 
+    // lock-free lane for first-priority packets (consensus stages, round
+    // tables etc.), drained by processorRoutine() ahead of inboxQueue_ so
+    // they never queue behind bulk block replies; overflow falls back to
+    // the guarded queue
+    FTQueue<PacketsQueue::SenderAndPacket, 1024> fastLane_;
+
     std::atomic<bool> stopped_{false};
     std::mutex shutdownMux_;
     std::condition_variable shutdownCv_;
 
+    // outbound packets pass through a class-weighted scheduler (see
+    // SendQueue) instead of going to the host in call order, so consensus
+    // stages are never stuck behind bulk block replies to syncing peers
+    std::condition_variable outboxCv_;
+    std::mutex outboxMux_;
+    SendQueue outboxQueue_;
+
     Neighbourhood neighbourhood_;
+
+    // duplicate copies of broadcast packets relayed by several neighbours are
+    // dropped in OnMessageReceived() before any deserialization
+    SeenPacketsCache seenPackets_;
+
+    // inbound rate windows per neighbour; over-limit peers lose queueing
+    // priority for non-consensus traffic, see OnMessageReceived()
+    PeerRateLimiter rateLimiter_;
+
+    // peer link quality persisted across restarts, see checkNeighboursChange()
+    PeerQualityStore peerQuality_;
+    std::string peerQualityPath_;
+
+    // neighbour maintenance off the packet path: DNS for boot nodes and
+    // re-resolution of dropped ones run on the resolver's own thread with
+    // per-peer backoff, see run() and checkNeighboursChange()
+    PeerResolver peerResolver_;
+    std::map<cs::PublicKey, PeerResolver::Entry> bootNodeEntries_;
+
+    // optional capture of the dispatched message stream, written only from
+    // processorRoutine() so it needs no lock of its own
+    PacketTraceWriter traceWriter_;
+
     std::thread processorThread_;
+    std::thread senderThread_;
 
     struct NeighbourData {
         const cs::PublicKey key;
@@ -50,6 +50,7 @@ void Neighbourhood::peerDisconnected(const cs::PublicKey& peer) {
 void Neighbourhood::pingNeighbours() {
     std::lock_guard lock(neighbourMutex_);
     for (auto& n : neighbours_) {
+        n.second.pingSentTime = std::chrono::steady_clock::now();
         sendPing(n.first);
     }
 }
@@ -99,7 +100,9 @@ void Neighbourhood::gotVersionReply(const cs::PublicKey& sender, const Packet& p
 
 void Neighbourhood::gotPong(const cs::PublicKey& sender, const Packet& pack) {
     cs::Sequence sequence = 0;
+    uint64_t rttMs = 0;
     bool result = false;
+    bool rttUpdated = false;
 
     {
         std::lock_guard lock(neighbourMutex_);
@@ -112,6 +115,17 @@ void Neighbourhood::gotPong(const cs::PublicKey& sender, const Packet& pack) {
             stream >> info.lastSeq;
             stream >> info.roundNumber;
 
+            if (info.pingSentTime != std::chrono::steady_clock::time_point{}) {
+                const auto sample = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        std::chrono::steady_clock::now() - info.pingSentTime).count());
+
+                // TCP-style smoothing, an eighth of the new sample per pong
+                info.rttEwmaMs = info.rttEwmaMs == 0 ? sample : (info.rttEwmaMs * 7 + sample) / 8;
+
+                rttMs = info.rttEwmaMs;
+                rttUpdated = true;
+            }
+
             sequence = info.lastSeq;
             result = true;
         }
@@ -120,10 +134,14 @@ void Neighbourhood::gotPong(const cs::PublicKey& sender, const Packet& pack) {
     if (result) {
         emit neighbourPingReceived(sequence, sender);
     }
+
+    if (rttUpdated) {
+        emit neighbourLagUpdated(rttMs, sender);
+    }
 }
 
 bool Neighbourhood::isCompatible(const PeerInfo& info) const {
-    if (info.nodeVersion < cs::ConfigHolder::instance().config()->getMinCompatibleVersion()) {
+    if (info.nodeVersion < cs::ConfigHolder::instance().snapshot()->getMinCompatibleVersion()) {
         return false;
     }
 
@@ -144,6 +162,12 @@ void Neighbourhood::tryToAddNew(const cs::PublicKey& peer, const PeerInfo& info)
         return;
     }
 
+    if (restrictToPermanent_.load(std::memory_order_acquire) && !info.permanent) {
+        // replicas never grow links beyond the configured upstream set, not
+        // even into the compatible pool
+        return;
+    }
+
     if (isLimitReached() && !info.permanent) {
         addToCompatiblePool(peer);
         return;
@@ -195,6 +219,10 @@ void Neighbourhood::setPermanentNeighbours(const std::set<cs::PublicKey>& perman
     permanentNeighbours_ = decltype(permanentNeighbours_)(permanent.begin(), permanent.end());
 }
 
+void Neighbourhood::restrictToPermanent() {
+    restrictToPermanent_.store(true, std::memory_order_release);
+}
+
 bool Neighbourhood::isPermanent(const cs::PublicKey& peer) const {
     std::lock_guard lock(permNeighbourMux_);
     return permanentNeighbours_.find(peer) != permanentNeighbours_.end();
@@ -207,6 +235,18 @@ void Neighbourhood::forEachNeighbour(NeighboursCallback callback) {
     }
 }
 
+void Neighbourhood::forEachLinkStat(LinkStatsCallback callback) const {
+    std::lock_guard<std::mutex> lock(neighbourMutex_);
+    for (const auto& n : neighbours_) {
+        LinkStats stats;
+        stats.lastSeq = n.second.lastSeq;
+        stats.roundNumber = n.second.roundNumber;
+        stats.rttEwmaMs = n.second.rttEwmaMs;
+        stats.permanent = n.second.permanent;
+        callback(n.first, stats);
+    }
+}
+
 uint32_t Neighbourhood::getNeighboursCount() const {
     std::lock_guard<std::mutex> lock(neighbourMutex_);
     return static_cast<uint32_t>(neighbours_.size());
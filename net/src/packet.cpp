@@ -76,6 +76,14 @@ const char* Packet::messageTypeToString(MsgTypes messageType) {
             return "SyncroMsg";
         case TransactionPacketHash:
             return "TransactionPacketHash";
+        case TransactionsPacketDigestRequest:
+            return "TransactionsPacketDigestRequest";
+        case TransactionsPacketDigestReply:
+            return "TransactionsPacketDigestReply";
+        case RoundPackageHash:
+            return "RoundPackageHash";
+        case TransactionsPacketIndexRequest:
+            return "TransactionsPacketIndexRequest";
         default:
             return "Unknown";
     }
@@ -6,6 +6,10 @@ bool PacketsQueue::empty() const {
     return firstPriorityQ_.empty() && secondPriorityQ_.empty();
 }
 
+size_t PacketsQueue::size() const {
+    return numPackets();
+}
+
 PacketsQueue::SenderAndPacket PacketsQueue::pop() {
     SenderAndPacket result;
 
@@ -29,8 +33,11 @@ PacketsQueue::SenderAndPacket PacketsQueue::pop() {
 }
 
 void PacketsQueue::push(const cs::PublicKey& sender, Packet&& pack) {
-    auto priority = getPriority(pack.getType());
+    const auto priority = getPriority(pack.getType());
+    push(sender, std::move(pack), priority);
+}
 
+void PacketsQueue::push(const cs::PublicKey& sender, Packet&& pack, Priority priority) {
     if (!shrink()) {
         if (priority == Priority::kSecond) return;
         firstPriorityQ_.clear();
@@ -47,7 +54,7 @@ void PacketsQueue::push(const cs::PublicKey& sender, Packet&& pack) {
     }
 }
 
-PacketsQueue::Priority PacketsQueue::getPriority(MsgTypes type) const {
+PacketsQueue::Priority PacketsQueue::getPriority(MsgTypes type) {
     switch (type) {
         case MsgTypes::ThirdSmartStage:
         case MsgTypes::Utility:
@@ -58,6 +65,8 @@ PacketsQueue::Priority PacketsQueue::getPriority(MsgTypes type) const {
         case MsgTypes::TransactionPacket:
         case MsgTypes::TransactionsPacketReply:
         case MsgTypes::TransactionsPacketRequest:
+        case MsgTypes::TransactionsPacketDigestRequest:
+        case MsgTypes::TransactionsPacketDigestReply:
         case MsgTypes::FirstStage:
         case MsgTypes::SecondStage:
         case MsgTypes::FirstStageRequest:
@@ -73,12 +82,38 @@ PacketsQueue::Priority PacketsQueue::getPriority(MsgTypes type) const {
         case MsgTypes::StateReply:
         case MsgTypes::BlockAlarm:
         case MsgTypes::SyncroMsg:
+        case MsgTypes::RoundPackageHash:
             return Priority::kFirst;
         default:
             return Priority::kSecond;
     }
 }
 
+bool PacketsQueue::isConsensusMessage(MsgTypes type) {
+    switch (type) {
+        case MsgTypes::RoundTable:
+        case MsgTypes::BootstrapTable:
+        case MsgTypes::RoundPackageHash:
+        case MsgTypes::BlockHash:
+        case MsgTypes::NodeStopRequest:
+        case MsgTypes::FirstStage:
+        case MsgTypes::SecondStage:
+        case MsgTypes::ThirdStage:
+        case MsgTypes::FirstStageRequest:
+        case MsgTypes::SecondStageRequest:
+        case MsgTypes::ThirdStageRequest:
+        case MsgTypes::FirstSmartStage:
+        case MsgTypes::SecondSmartStage:
+        case MsgTypes::ThirdSmartStage:
+        case MsgTypes::SmartFirstStageRequest:
+        case MsgTypes::SmartSecondStageRequest:
+        case MsgTypes::SmartThirdStageRequest:
+            return true;
+        default:
+            return false;
+    }
+}
+
 size_t PacketsQueue::numPackets() const {
     return firstPriorityQ_.size() + secondPriorityQ_.size();
 }
@@ -0,0 +1,214 @@
+#include "packettrace.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include <lib/system/logger.hpp>
+
+namespace {
+// "CSTRACE" + format version in the low byte
+const uint64_t kTraceMagic = 0x4353545241434501ULL;
+
+// per-record sync marker, lets the reader resynchronize after the ring wrap
+// leaves a partially overwritten record behind the write offset
+const uint32_t kRecordMarker = 0xC5C5ACE1;
+
+// magic + capacity + write offset + wrapped flag, rewritten in place
+const uint64_t kHeaderSize = sizeof(uint64_t) * 3 + sizeof(uint8_t);
+
+// marker + timestamp + sender + payload size
+const uint64_t kRecordHeaderSize = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(cs::PublicKey) + sizeof(uint32_t);
+
+// header rewrites are batched, a crash loses at most this many records
+const uint64_t kHeaderFlushPeriod = 1024;
+
+uint64_t steadyNowUs() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+template <typename T>
+void putRaw(std::fstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool getRaw(const cs::Bytes& bytes, uint64_t offset, T& value) {
+    if (offset + sizeof(value) > bytes.size()) {
+        return false;
+    }
+
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    return true;
+}
+}  // namespace
+
+PacketTraceWriter::~PacketTraceWriter() {
+    close();
+}
+
+bool PacketTraceWriter::open(const std::string& path, uint64_t capacityBytes) {
+    close();
+
+    if (capacityBytes <= kHeaderSize + kRecordHeaderSize) {
+        cserror() << "PacketTrace: capacity " << capacityBytes << " bytes is too small for any record";
+        return false;
+    }
+
+    file_.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file_.is_open()) {
+        cserror() << "PacketTrace: can not open trace file " << path;
+        return false;
+    }
+
+    capacityBytes_ = capacityBytes;
+    writeOffset_ = kHeaderSize;
+    wrapped_ = false;
+    startTimeUs_ = steadyNowUs();
+
+    writeHeader();
+    file_.seekp(static_cast<std::streamoff>(writeOffset_));
+
+    return true;
+}
+
+void PacketTraceWriter::close() {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    writeHeader();
+    file_.close();
+}
+
+void PacketTraceWriter::append(const cs::PublicKey& sender, const cs::Byte* data, size_t size) {
+    const uint64_t recordSize = kRecordHeaderSize + size;
+
+    if (kHeaderSize + recordSize > capacityBytes_) {
+        // a single oversized message would never fit, drop it from the trace
+        return;
+    }
+
+    if (writeOffset_ + recordSize > capacityBytes_) {
+        wrapped_ = true;
+        writeOffset_ = kHeaderSize;
+        file_.seekp(static_cast<std::streamoff>(writeOffset_));
+    }
+
+    putRaw(file_, kRecordMarker);
+    putRaw(file_, steadyNowUs() - startTimeUs_);
+    file_.write(reinterpret_cast<const char*>(sender.data()), static_cast<std::streamsize>(sender.size()));
+    putRaw(file_, static_cast<uint32_t>(size));
+    file_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+
+    writeOffset_ += recordSize;
+
+    if (++appendsSinceFlush_ >= kHeaderFlushPeriod) {
+        appendsSinceFlush_ = 0;
+        writeHeader();
+        file_.seekp(static_cast<std::streamoff>(writeOffset_));
+    }
+}
+
+void PacketTraceWriter::writeHeader() {
+    file_.seekp(0);
+
+    putRaw(file_, kTraceMagic);
+    putRaw(file_, capacityBytes_);
+    putRaw(file_, writeOffset_);
+    putRaw(file_, static_cast<uint8_t>(wrapped_ ? 1 : 0));
+
+    file_.flush();
+}
+
+namespace {
+// parses records from [from, to), scanning forward byte by byte until a
+// marker with a sane record behind it is found
+void parseRegion(const cs::Bytes& bytes, uint64_t from, uint64_t to, std::vector<PacketTraceRecord>& records) {
+    uint64_t offset = from;
+
+    while (offset + kRecordHeaderSize <= to) {
+        uint32_t marker = 0;
+
+        if (!getRaw(bytes, offset, marker) || marker != kRecordMarker) {
+            ++offset;
+            continue;
+        }
+
+        PacketTraceRecord record;
+        uint64_t cursor = offset + sizeof(marker);
+
+        getRaw(bytes, cursor, record.timestampUs);
+        cursor += sizeof(record.timestampUs);
+
+        std::memcpy(record.sender.data(), bytes.data() + cursor, record.sender.size());
+        cursor += record.sender.size();
+
+        uint32_t payloadSize = 0;
+        getRaw(bytes, cursor, payloadSize);
+        cursor += sizeof(payloadSize);
+
+        if (cursor + payloadSize > to) {
+            ++offset;
+            continue;
+        }
+
+        record.packetBytes.assign(bytes.begin() + static_cast<std::ptrdiff_t>(cursor),
+                                  bytes.begin() + static_cast<std::ptrdiff_t>(cursor + payloadSize));
+        records.push_back(std::move(record));
+
+        offset = cursor + payloadSize;
+    }
+}
+}  // namespace
+
+std::vector<PacketTraceRecord> PacketTraceReader::load(const std::string& path) {
+    std::vector<PacketTraceRecord> records;
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (!file.is_open()) {
+        cserror() << "PacketTrace: can not open trace file " << path;
+        return records;
+    }
+
+    const auto fileSize = static_cast<uint64_t>(file.tellg());
+
+    if (fileSize < kHeaderSize) {
+        cserror() << "PacketTrace: trace file " << path << " is truncated";
+        return records;
+    }
+
+    cs::Bytes bytes(fileSize);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(fileSize));
+
+    uint64_t magic = 0;
+    uint64_t capacity = 0;
+    uint64_t writeOffset = 0;
+    uint8_t wrapped = 0;
+
+    getRaw(bytes, 0, magic);
+    getRaw(bytes, sizeof(magic), capacity);
+    getRaw(bytes, sizeof(magic) + sizeof(capacity), writeOffset);
+    getRaw(bytes, sizeof(magic) + sizeof(capacity) + sizeof(writeOffset), wrapped);
+
+    if (magic != kTraceMagic) {
+        cserror() << "PacketTrace: trace file " << path << " has unknown format";
+        return records;
+    }
+
+    if (writeOffset < kHeaderSize || writeOffset > fileSize) {
+        cserror() << "PacketTrace: trace file " << path << " has corrupt write offset";
+        return records;
+    }
+
+    // the oldest records sit behind the write offset on the previous lap
+    if (wrapped != 0) {
+        parseRegion(bytes, writeOffset, fileSize, records);
+    }
+
+    parseRegion(bytes, kHeaderSize, writeOffset, records);
+
+    return records;
+}
@@ -35,6 +35,7 @@ constexpr static cs::RoundNumber packetTypeRoundTimeout(const MsgTypes type) {
         case MsgTypes::RejectedContracts:
         case MsgTypes::TransactionPacket:
         case MsgTypes::TransactionsPacketRequest:
+        case MsgTypes::TransactionsPacketIndexRequest:
         case MsgTypes::TransactionsPacketReply:
             return Consensus::MaxRoundsCancelContract;
         default:
@@ -43,11 +44,19 @@ constexpr static cs::RoundNumber packetTypeRoundTimeout(const MsgTypes type) {
 }
 
 bool PacketValidator::validate(const Packet& packet) {
+    return validateHeader(packet) && validateStructure(packet);
+}
+
+bool PacketValidator::validateHeader(const Packet& packet) {
     if (!packet.isHeaderValid()) {
         cswarning() << "Packet header " << packet << " is not validated";
         return false;
     }
 
+    return true;
+}
+
+bool PacketValidator::validateStructure(const Packet& packet) {
     if (packet.isNetwork()) {
         return validateNetworkPacket(packet);
     }
@@ -129,10 +138,14 @@ bool PacketValidator::validateNodePacket(const Packet& packet) {
         case MsgTypes::SmartThirdStageRequest:
         case MsgTypes::TransactionsPacketBaseRequest:
         case MsgTypes::TransactionsPacketBaseReply:
+        case MsgTypes::TransactionsPacketDigestRequest:
+        case MsgTypes::TransactionsPacketDigestReply:
+        case MsgTypes::TransactionsPacketIndexRequest:
         case MsgTypes::RejectedContracts:
         case MsgTypes::StateRequest:
         case MsgTypes::StateReply:
         case MsgTypes::EventReport:
+        case MsgTypes::RoundPackageHash:  // announcement of an old round is useless, let it be cut
             return true;
 
         default: {
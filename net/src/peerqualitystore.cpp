@@ -0,0 +1,117 @@
+#include <peerqualitystore.hpp>
+
+#include <fstream>
+
+#include <csnode/datastream.hpp>
+
+#include <lib/system/logger.hpp>
+
+void PeerQualityStore::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (!file.is_open()) {
+        csdebug() << "PeerQualityStore: no stored peers at " << path;
+        return;
+    }
+
+    const auto fileSize = static_cast<size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    cs::Bytes bytes(fileSize);
+
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(fileSize))) {
+        cswarning() << "PeerQualityStore: can not read " << path;
+        return;
+    }
+
+    cs::IDataStream stream(bytes.data(), bytes.size());
+
+    cs::Byte version = 0U;
+    size_t count = 0;
+    stream >> version >> count;
+
+    if (!stream.isValid() || version != kFormatVersion || count > kMaxStoredPeers) {
+        cswarning() << "PeerQualityStore: incompatible or corrupt file " << path;
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    for (size_t i = 0; i < count; ++i) {
+        cs::PublicKey peer;
+        Quality quality;
+
+        stream >> peer >> quality.rttEwmaMs >> quality.lastSequence >> quality.banCount;
+
+        if (!stream.isValid()) {
+            cswarning() << "PeerQualityStore: truncated file " << path;
+            peers_.clear();
+            return;
+        }
+
+        peers_.emplace(peer, quality);
+    }
+
+    cslog() << "PeerQualityStore: restored " << peers_.size() << " peers from " << path;
+}
+
+void PeerQualityStore::save(const std::string& path) const {
+    cs::Bytes bytes;
+    cs::ODataStream stream(bytes);
+
+    {
+        std::lock_guard lock(mutex_);
+
+        stream << kFormatVersion;
+        stream << peers_.size();
+
+        for (const auto& [peer, quality] : peers_) {
+            stream << peer << quality.rttEwmaMs << quality.lastSequence << quality.banCount;
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open()) {
+        cswarning() << "PeerQualityStore: can not write " << path;
+        return;
+    }
+
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    csdebug() << "PeerQualityStore: saved " << size() << " peers to " << path;
+}
+
+void PeerQualityStore::updateLag(const cs::PublicKey& peer, uint64_t rttMs) {
+    std::lock_guard lock(mutex_);
+    peers_[peer].rttEwmaMs = rttMs;
+}
+
+void PeerQualityStore::updateSequence(const cs::PublicKey& peer, cs::Sequence sequence) {
+    std::lock_guard lock(mutex_);
+    auto& quality = peers_[peer];
+
+    if (quality.lastSequence < sequence) {
+        quality.lastSequence = sequence;
+    }
+}
+
+void PeerQualityStore::registerBan(const cs::PublicKey& peer) {
+    std::lock_guard lock(mutex_);
+    ++peers_[peer].banCount;
+}
+
+std::optional<PeerQualityStore::Quality> PeerQualityStore::get(const cs::PublicKey& peer) const {
+    std::lock_guard lock(mutex_);
+    const auto it = peers_.find(peer);
+
+    if (it == peers_.end()) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+size_t PeerQualityStore::size() const {
+    std::lock_guard lock(mutex_);
+    return peers_.size();
+}
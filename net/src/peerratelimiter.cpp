@@ -0,0 +1,88 @@
+#include "peerratelimiter.hpp"
+
+#include <chrono>
+
+bool PeerRateLimiter::account(const cs::PublicKey& sender, size_t packetSize) {
+    const uint64_t now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    PeerWindow& window = peers_[sender];
+
+    if (window.slots.empty()) {
+        window.slots.push_back(Slot{});
+        window.currentSecond = now;
+    }
+
+    rotate(window, now);
+
+    Slot& slot = window.slots.back();
+    slot.bytes += packetSize;
+    ++slot.messages;
+    window.windowBytes += packetSize;
+    ++window.windowMessages;
+    window.totalBytes += packetSize;
+    ++window.totalMessages;
+
+    if (window.throttled) {
+        if (window.windowBytes * 2 < kMaxBytesPerWindow && window.windowMessages * 2 < kMaxMessagesPerWindow) {
+            window.throttled = false;
+        }
+    }
+    else if (window.windowBytes > kMaxBytesPerWindow || window.windowMessages > kMaxMessagesPerWindow) {
+        window.throttled = true;
+    }
+
+    return window.throttled;
+}
+
+std::unordered_map<cs::PublicKey, PeerRateLimiter::Stats> PeerRateLimiter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::unordered_map<cs::PublicKey, Stats> result;
+    result.reserve(peers_.size());
+
+    for (const auto& [peer, window] : peers_) {
+        Stats& stats = result[peer];
+        stats.windowBytes = window.windowBytes;
+        stats.windowMessages = window.windowMessages;
+        stats.totalBytes = window.totalBytes;
+        stats.totalMessages = window.totalMessages;
+        stats.throttled = window.throttled;
+    }
+
+    return result;
+}
+
+void PeerRateLimiter::remove(const cs::PublicKey& sender) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peers_.erase(sender);
+}
+
+void PeerRateLimiter::rotate(PeerWindow& window, uint64_t nowSeconds) {
+    if (nowSeconds - window.currentSecond >= kWindowSlots) {
+        // silent long enough for the whole window to expire, start over clean;
+        // lifetime counters survive the reset
+        const uint64_t totalBytes = window.totalBytes;
+        const uint64_t totalMessages = window.totalMessages;
+        window = PeerWindow{};
+        window.totalBytes = totalBytes;
+        window.totalMessages = totalMessages;
+        window.slots.push_back(Slot{});
+        window.currentSecond = nowSeconds;
+        return;
+    }
+
+    while (window.currentSecond < nowSeconds) {
+        ++window.currentSecond;
+
+        if (window.slots.full()) {
+            const Slot& oldest = window.slots.front();
+            window.windowBytes -= oldest.bytes;
+            window.windowMessages -= oldest.messages;
+            window.slots.pop_front();
+        }
+
+        window.slots.push_back(Slot{});
+    }
+}
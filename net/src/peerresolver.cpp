@@ -0,0 +1,121 @@
+#include "peerresolver.hpp"
+
+#include <algorithm>
+
+#include <boost/asio.hpp>
+
+#include <lib/system/logger.hpp>
+
+PeerResolver::~PeerResolver() {
+    stop();
+}
+
+void PeerResolver::start(std::vector<Entry> entries, ResolvedCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback_ = std::move(callback);
+
+        const auto now = std::chrono::steady_clock::now();
+        for (auto& entry : entries) {
+            pending_.push_back(Pending{std::move(entry), now, kInitialBackoff});
+        }
+
+        if (!thread_.joinable()) {
+            stopped_ = false;
+            thread_ = std::thread(&PeerResolver::routine, this);
+        }
+    }
+
+    cv_.notify_one();
+}
+
+void PeerResolver::schedule(const Entry& entry) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const bool queued = std::any_of(pending_.begin(), pending_.end(),
+                                        [&entry](const Pending& p) { return p.entry.id == entry.id; });
+        if (queued) {
+            return;
+        }
+        pending_.push_back(Pending{entry, std::chrono::steady_clock::now(), kInitialBackoff});
+    }
+
+    cv_.notify_one();
+}
+
+void PeerResolver::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+
+    cv_.notify_one();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void PeerResolver::routine() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopped_) {
+        if (pending_.empty()) {
+            cv_.wait(lock, [this] { return stopped_ || !pending_.empty(); });
+            continue;
+        }
+
+        auto next = std::min_element(pending_.begin(), pending_.end(),
+                                     [](const Pending& lhs, const Pending& rhs) { return lhs.nextAttempt < rhs.nextAttempt; });
+
+        if (next->nextAttempt > std::chrono::steady_clock::now()) {
+            // also woken early by stop() or by schedule() inserting a closer deadline
+            cv_.wait_until(lock, next->nextAttempt);
+            continue;
+        }
+
+        Pending item = std::move(*next);
+        pending_.erase(next);
+
+        // DNS happens without the lock, so schedule() and stop() stay responsive
+        // no matter how long the lookup takes
+        lock.unlock();
+
+        net::bi::address address;
+        const bool resolved = tryResolve(item.entry, address);
+
+        if (resolved && callback_) {
+            callback_(item.entry, address);
+        }
+
+        lock.lock();
+
+        if (!resolved && !stopped_) {
+            item.backoff = std::min(item.backoff * 2, kMaxBackoff);
+            item.nextAttempt = std::chrono::steady_clock::now() + item.backoff;
+            csdebug() << "RESOLVER> " << item.entry.host << " not resolved, next attempt in " << item.backoff.count() << " ms";
+            pending_.push_back(std::move(item));
+        }
+    }
+}
+
+bool PeerResolver::tryResolve(const Entry& entry, net::bi::address& result) {
+    boost::system::error_code code;
+    result = net::bi::address::from_string(entry.host, code);
+
+    if (!code) {
+        // numeric literal, nothing to look up
+        return true;
+    }
+
+    boost::asio::io_context context;
+    boost::asio::ip::udp::resolver resolver(context);
+    const auto resolved = resolver.resolve(entry.host, std::to_string(entry.port), code);
+
+    if (code || resolved.empty()) {
+        return false;
+    }
+
+    result = resolved.begin()->endpoint().address();
+    return true;
+}
@@ -0,0 +1,57 @@
+#include "seenpacketscache.hpp"
+
+#include <chrono>
+
+namespace {
+// FNV-1a, enough spread for a suppression cache and much cheaper than a
+// cryptographic digest on every received packet
+uint64_t fingerprint(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+    // zero marks an empty bucket
+    return h != 0 ? h : 1;
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+bool SeenPacketsCache::checkAndSet(const void* data, size_t size) {
+    maybeRotate(nowMs());
+
+    const uint64_t fp = fingerprint(data, size);
+    const size_t bucket = static_cast<size_t>(fp) & (kBuckets - 1);
+    const uint32_t current = epoch_.load(std::memory_order_relaxed) & 1;
+
+    if (generations_[current][bucket].load(std::memory_order_relaxed) == fp ||
+        generations_[current ^ 1][bucket].load(std::memory_order_relaxed) == fp) {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    generations_[current][bucket].store(fp, std::memory_order_relaxed);
+    return false;
+}
+
+void SeenPacketsCache::maybeRotate(int64_t now) {
+    int64_t next = nextRotationMs_.load(std::memory_order_relaxed);
+    if (now < next) {
+        return;
+    }
+    // single winner rotates; concurrent lookups into the generation being wiped
+    // at worst miss a duplicate, never drop a first copy
+    if (!nextRotationMs_.compare_exchange_strong(next, now + kRotateEveryMs, std::memory_order_relaxed)) {
+        return;
+    }
+    // the oldest generation is wiped and becomes the new write target, the one
+    // written until now keeps serving lookups for one more rotation period
+    const uint32_t wiped = (epoch_.fetch_add(1, std::memory_order_relaxed) + 1) & 1;
+    for (auto& slot : generations_[wiped]) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
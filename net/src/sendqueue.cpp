@@ -0,0 +1,136 @@
+#include "sendqueue.hpp"
+
+#include <stdexcept>
+
+SendQueue::Class SendQueue::getClass(MsgTypes type) {
+    switch (type) {
+        case MsgTypes::FirstStage:
+        case MsgTypes::SecondStage:
+        case MsgTypes::ThirdStage:
+        case MsgTypes::FirstStageRequest:
+        case MsgTypes::SecondStageRequest:
+        case MsgTypes::ThirdStageRequest:
+        case MsgTypes::FirstSmartStage:
+        case MsgTypes::SecondSmartStage:
+        case MsgTypes::ThirdSmartStage:
+        case MsgTypes::SmartFirstStageRequest:
+        case MsgTypes::SmartSecondStageRequest:
+        case MsgTypes::SmartThirdStageRequest:
+        case MsgTypes::BlockHash:
+        case MsgTypes::HashReply:
+        case MsgTypes::RejectedContracts:
+        case MsgTypes::StateReply:
+        case MsgTypes::BlockAlarm:
+            return Class::kConsensus;
+        case MsgTypes::RoundTable:
+        case MsgTypes::BootstrapTable:
+        case MsgTypes::RoundTableRequest:
+        case MsgTypes::RoundTableReply:
+        case MsgTypes::RoundPackRequest:
+        case MsgTypes::RoundPackageHash:
+        case MsgTypes::EmptyRoundPack:
+        case MsgTypes::Utility:
+        case MsgTypes::NodeStopRequest:
+            return Class::kRoundTable;
+        case MsgTypes::TransactionPacket:
+        case MsgTypes::TransactionPacketHash:
+        case MsgTypes::TransactionsPacketRequest:
+        case MsgTypes::TransactionsPacketReply:
+        case MsgTypes::TransactionsPacketBaseRequest:
+        case MsgTypes::TransactionsPacketBaseReply:
+        case MsgTypes::TransactionsPacketDigestRequest:
+        case MsgTypes::TransactionsPacketDigestReply:
+            return Class::kTransactions;
+        default:
+            return Class::kSyncBulk;
+    }
+}
+
+bool SendQueue::empty() const {
+    for (auto& queue : queues_) {
+        if (!queue.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SendQueue::Entry SendQueue::pop() {
+    for (;;) {
+        bool anyData = false;
+
+        for (size_t i = 0; i < kClassesCount; ++i) {
+            if (queues_[i].empty()) {
+                continue;
+            }
+
+            anyData = true;
+            if (credits_[i] == 0) {
+                continue;
+            }
+
+            --credits_[i];
+            Entry result = std::move(queues_[i].front());
+            queues_[i].pop_front();
+            bytes_[i] -= result.pack.size();
+            return result;
+        }
+
+        if (!anyData) {
+            throw std::domain_error("SendQueue is empty.");
+        }
+
+        refillCredits();
+    }
+}
+
+void SendQueue::push(Entry&& entry) {
+    auto cls = static_cast<size_t>(getClass(entry.pack.getType()));
+
+    if (!shrink()) {
+        if (cls == static_cast<size_t>(Class::kSyncBulk)) return;
+    }
+
+    bytes_[cls] += entry.pack.size();
+    queues_[cls].push_back(std::move(entry));
+}
+
+void SendQueue::clear() {
+    for (size_t i = 0; i < kClassesCount; ++i) {
+        queues_[i].clear();
+        bytes_[i] = 0;
+        credits_[i] = 0;
+    }
+}
+
+size_t SendQueue::numPackets() const {
+    size_t result = 0;
+    for (auto& queue : queues_) {
+        result += queue.size();
+    }
+    return result;
+}
+
+size_t SendQueue::numBytes() const {
+    size_t result = 0;
+    for (auto bytes : bytes_) {
+        result += bytes;
+    }
+    return result;
+}
+
+bool SendQueue::shrink() {
+  if ((numPackets() > kMaxPacketsToHandle) || (numBytes() > kMaxBytesToHandle)) {
+    auto bulk = static_cast<size_t>(Class::kSyncBulk);
+    queues_[bulk].clear();
+    bytes_[bulk] = 0;
+  }
+
+  return (numPackets() <= kMaxPacketsToHandle) && (numBytes() <= kMaxBytesToHandle);
+}
+
+void SendQueue::refillCredits() {
+    for (size_t i = 0; i < kClassesCount; ++i) {
+        credits_[i] = kWeights[i];
+    }
+}
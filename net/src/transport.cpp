@@ -2,6 +2,8 @@
 #include "transport.hpp"
 
 #include <algorithm>
+#include <array>
+#include <sstream>
 #include <thread>
 #include <unordered_set>
 
@@ -12,7 +14,10 @@
 #include <csnode/conveyer.hpp>
 #include <csnode/configholder.hpp>
 
+#include <lib/system/metrics.hpp>
 #include <lib/system/structures.hpp>
+#include <lib/system/stacksampler.hpp>
+#include <lib/system/threadaffinity.hpp>
 #include <lib/system/utils.hpp>
 
 #include <packetvalidator.hpp>
@@ -50,8 +55,145 @@ uint16_t getVersion(uint64_t user_data) {
   return static_cast<uint16_t>(user_data >> 8);
 }
 
-net::Config createNetConfig(bool& good) {
-    auto config = *cs::ConfigHolder::instance().config();
+// node message dispatch table indexed by MsgTypes; captureless lambdas decay
+// to plain function pointers, so the whole table is built at compile time and
+// dispatch is one indexed load instead of a long switch. Round relevance is
+// still decided by Node::chooseMessageAction from the packet header alone,
+// before any payload parsing
+using MessageHandler = void (*)(Node&, const cs::PublicKey&, MsgTypes, cs::RoundNumber, const uint8_t*, size_t);
+
+constexpr size_t kMsgTypesCount = 256;
+
+constexpr std::array<MessageHandler, kMsgTypesCount> buildDispatchTable() {
+    std::array<MessageHandler, kMsgTypesCount> table{};
+
+    table[MsgTypes::BlockRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getBlockRequest(data, size, sender);
+    };
+    table[MsgTypes::RequestedBlock] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getBlockReply(data, size, sender);
+    };
+    table[MsgTypes::Utility] = [](Node& node, const cs::PublicKey&, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getUtilityMessage(data, size);
+    };
+    table[MsgTypes::NodeStopRequest] = [](Node& node, const cs::PublicKey&, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getNodeStopRequest(rNum, data, size);
+    };
+    table[MsgTypes::RoundTable] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getRoundTable(data, size, rNum, sender);
+    };
+    table[MsgTypes::BootstrapTable] = [](Node& node, const cs::PublicKey&, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getBootstrapTable(data, size, rNum);
+    };
+    table[MsgTypes::RoundTableRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getRoundTableRequest(data, size, rNum, sender);
+    };
+    table[MsgTypes::BlockHash] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getHash(data, size, rNum, sender);
+    };
+    table[MsgTypes::HashReply] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getHashReply(data, size, rNum, sender);
+    };
+    table[MsgTypes::TransactionPacket] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getTransactionsPacket(data, size, sender);
+    };
+    table[MsgTypes::TransactionsPacketRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketHashesRequest(data, size, rNum, sender);
+    };
+    table[MsgTypes::TransactionsPacketReply] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketHashesReply(data, size, rNum, sender);
+    };
+    table[MsgTypes::FirstStage] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getStageOne(data, size, sender);
+    };
+    table[MsgTypes::SecondStage] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getStageTwo(data, size, sender);
+    };
+    table[MsgTypes::ThirdStage] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getStageThree(data, size, sender);
+    };
+
+    constexpr MessageHandler stageRequest = [](Node& node, const cs::PublicKey& sender, MsgTypes type, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getStageRequest(type, data, size, sender);
+    };
+    table[MsgTypes::FirstStageRequest] = stageRequest;
+    table[MsgTypes::SecondStageRequest] = stageRequest;
+    table[MsgTypes::ThirdStageRequest] = stageRequest;
+
+    table[MsgTypes::FirstSmartStage] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getSmartStageOne(data, size, rNum, sender);
+    };
+    table[MsgTypes::SecondSmartStage] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getSmartStageTwo(data, size, rNum, sender);
+    };
+    table[MsgTypes::ThirdSmartStage] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        csdebug() << "+++++++++++++++++++  ThirdSmartStage arrived +++++++++++++++++++++";
+        node.getSmartStageThree(data, size, rNum, sender);
+    };
+
+    constexpr MessageHandler smartStageRequest = [](Node& node, const cs::PublicKey& sender, MsgTypes type, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getSmartStageRequest(type, data, size, sender);
+    };
+    table[MsgTypes::SmartFirstStageRequest] = smartStageRequest;
+    table[MsgTypes::SmartSecondStageRequest] = smartStageRequest;
+    table[MsgTypes::SmartThirdStageRequest] = smartStageRequest;
+
+    table[MsgTypes::RejectedContracts] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getSmartReject(data, size, rNum, sender);
+    };
+    table[MsgTypes::RoundTableReply] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getRoundTableReply(data, size, sender);
+    };
+    table[MsgTypes::RoundPackRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getRoundPackRequest(data, size, rNum, sender);
+    };
+    table[MsgTypes::RoundPackageHash] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getRoundPackageHash(data, size, rNum, sender);
+    };
+    table[MsgTypes::EmptyRoundPack] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getEmptyRoundPack(data, size, rNum, sender);
+    };
+    table[MsgTypes::StateRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getStateRequest(data, size, rNum, sender);
+    };
+    table[MsgTypes::StateReply] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getStateReply(data, size, rNum, sender);
+    };
+    table[MsgTypes::BlockAlarm] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getBlockAlarm(data, size, rNum, sender);
+    };
+    table[MsgTypes::EventReport] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getEventReport(data, size, rNum, sender);
+    };
+    table[MsgTypes::SyncroMsg] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber, const uint8_t* data, size_t size) {
+        node.getSyncroMessage(data, size, sender);
+    };
+    table[MsgTypes::TransactionPacketHash] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketHash(data, size, rNum, sender);
+    };
+    table[MsgTypes::TransactionsPacketBaseRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketHashRequest(data, size, rNum, sender);
+    };
+    table[MsgTypes::TransactionsPacketBaseReply] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketHashesBaseReply(data, size, rNum, sender);
+    };
+    table[MsgTypes::TransactionsPacketDigestRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketDigestsRequest(data, size, rNum, sender);
+    };
+    table[MsgTypes::TransactionsPacketDigestReply] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketDigestsReply(data, size, rNum, sender);
+    };
+    table[MsgTypes::TransactionsPacketIndexRequest] = [](Node& node, const cs::PublicKey& sender, MsgTypes, cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+        node.getPacketIndexRequest(data, size, rNum, sender);
+    };
+
+    return table;
+}
+
+constexpr auto kDispatchTable = buildDispatchTable();
+
+net::Config createNetConfig(bool& good, std::vector<PeerResolver::Entry>& unresolved) {
+    auto config = *cs::ConfigHolder::instance().snapshot();
     net::Config result(toNodeId(config.getMyPublicKey()));
     good = true;
 
@@ -76,14 +218,26 @@ net::Config createNetConfig(bool& good) {
                 break;
             }
 
-            net::NodeEntrance entry;
-            entry.address = net::bi::address::from_string(node.ip); // @TODO change it
-            entry.udp_port = entry.tcp_port = node.port;
             std::vector<uint8_t> idBytes;
-            if (!DecodeBase58(node.id, idBytes)) {
+            if (!DecodeBase58(node.id, idBytes) || idBytes.size() != cs::kPublicKeyLength) {
                 good = false;
                 break;
             }
+
+            boost::system::error_code code;
+            auto address = net::bi::address::from_string(node.ip, code);
+
+            if (code) {
+                // a host name, not a numeric address: resolving here would put
+                // DNS latency on the startup path, so the entry goes to the
+                // async resolver instead, see Transport::run()
+                unresolved.push_back(PeerResolver::Entry{node.ip, node.port, node.id});
+                continue;
+            }
+
+            net::NodeEntrance entry;
+            entry.address = address;
+            entry.udp_port = entry.tcp_port = node.port;
             std::copy(idBytes.begin(), idBytes.end(), reinterpret_cast<uint8_t*>(entry.id.GetPtr()));
             result.custom_boot_nodes.push_back(entry);
         }
@@ -116,22 +270,81 @@ void pollSignalFlag() {
 extern void pollSignalFlag();
 
 Transport::Transport(Node* node)
-: config_(createNetConfig(good_))
+: config_(createNetConfig(good_, unresolvedBootNodes_))
 , node_(node)
 , neighbourhood_(this, node_)
 , host_(config_, static_cast<HostEventHandler&>(*this)) {
     cs::Connector::connect(&neighbourhood_.neighbourPingReceived, this, &Transport::onPingReceived);
+    cs::Connector::connect(&neighbourhood_.neighbourLagUpdated, this, &Transport::onNeighbourLagUpdated);
 }
 
 Transport::~Transport() {
     if (processorThread_.joinable()) {
         processorThread_.join();
     }
+    if (senderThread_.joinable()) {
+        senderThread_.join();
+    }
 }
 
 void Transport::run() {
+    // a snapshot stays valid even if a reload lands while run() is starting up
+    const auto config = cs::ConfigHolder::instance().snapshot();
+
+    peerQualityPath_ = config->getPathToDB() + "/peersquality.dat";
+    peerQuality_.load(peerQualityPath_);
+
+    // topology-aware placement: routines and pool workers pin themselves to the configured domains
+    cs::ThreadAffinity::instance().setCpuSet(cs::ThreadAffinity::Domain::Network, config->getAffinityNetworkCores());
+    cs::ThreadAffinity::instance().setCpuSet(cs::ThreadAffinity::Domain::Dispatch, config->getAffinityDispatchCores());
+    cs::ThreadAffinity::instance().setCpuSet(cs::ThreadAffinity::Domain::Worker, config->getAffinityWorkerCores());
+
+    // offline reproduction of a captured incident, the network stays down
+    if (!config->getReplayTraceFile().empty()) {
+        replayTrace(config->getReplayTraceFile(), config->getReplayTraceSpeed());
+        return;
+    }
+
+    if (!config->getPacketTraceFile().empty()) {
+        if (traceWriter_.open(config->getPacketTraceFile(), config->getPacketTraceSizeMb() * 1024 * 1024)) {
+            cslog() << "TRANSPORT> Capturing packet trace to " << config->getPacketTraceFile();
+        }
+    }
+
+    // remember every configured boot node by key, so a dropped one can be
+    // re-resolved and knocked again later, see checkNeighboursChange()
+    for (auto& bootNode : config->getIpList()) {
+        cs::Bytes idBytes;
+        if (DecodeBase58(bootNode.id, idBytes) && idBytes.size() == cs::kPublicKeyLength) {
+            cs::PublicKey key;
+            std::copy(idBytes.cbegin(), idBytes.cend(), key.begin());
+            bootNodeEntries_.emplace(key, PeerResolver::Entry{bootNode.ip, bootNode.port, bootNode.id});
+        }
+    }
+
     host_.Run();
     processorThread_ = std::thread(&Transport::processorRoutine, this);
+    senderThread_ = std::thread(&Transport::senderRoutine, this);
+
+    // boot node host names resolve on the resolver's own thread with per-peer
+    // backoff; a stalled DNS server can no longer delay startup or freeze the
+    // main loop. A successful lookup turns into an id-addressed connect
+    // request: the overlay either reaches the peer through discovery or
+    // answers directly once the address is live
+    if (!unresolvedBootNodes_.empty() || !bootNodeEntries_.empty()) {
+        peerResolver_.start(std::move(unresolvedBootNodes_), [this](const PeerResolver::Entry& entry, const net::bi::address& address) {
+            csdebug() << "TRANSPORT> boot node " << entry.host << " resolved to " << address.to_string();
+
+            cs::Bytes idBytes;
+            if (!DecodeBase58(entry.id, idBytes) || idBytes.size() != cs::kPublicKeyLength) {
+                return;
+            }
+
+            cs::PublicKey key;
+            std::copy(idBytes.cbegin(), idBytes.cend(), key.begin());
+            neighbourhood_.add({key});
+        });
+    }
 
     {
         std::unique_lock<std::mutex> lock(shutdownMux_);
@@ -155,16 +368,30 @@ void Transport::run() {
 void Transport::stop() {
     stopped_.store(true, std::memory_order_release);
     Transport::gSignalStatus = 1;
+    peerResolver_.stop();
+
+    if (!peerQualityPath_.empty()) {
+        peerQuality_.save(peerQualityPath_);
+    }
+    if (seenPackets_.suppressedCount() != 0) {
+        cslog() << "TRANSPORT> duplicate packets suppressed: " << seenPackets_.suppressedCount();
+    }
+    traceWriter_.close();
     {
         std::lock_guard<std::mutex> lock(shutdownMux_);
     }
     shutdownCv_.notify_all();
     newPacketsReceived_.notify_all();
+    outboxCv_.notify_all();
 }
 
 void Transport::OnMessageReceived(const net::NodeId& id, net::ByteVector&& data) {
     Packet pack(std::move(data));
-    if (!cs::PacketValidator::validate(pack)) {
+
+    // only the branch-minimal header check runs on the socket-draining thread;
+    // per-type structural validation happens on the processor thread right
+    // before dispatch, where flood-time validation spikes cost nothing here
+    if (!cs::PacketValidator::validateHeader(pack)) {
         return;
     }
 
@@ -174,9 +401,39 @@ void Transport::OnMessageReceived(const net::NodeId& id, net::ByteVector&& data)
         return;
     }
 
+    // broadcast flooding delivers the same logical packet from several
+    // neighbours; identical payloads we have already accepted are dropped here,
+    // before queueing and parsing. Copies lost in the network never reach the
+    // cache, so requested resends still go through
+    if (seenPackets_.checkAndSet(pack.data(), pack.size())) {
+        return;
+    }
+
+    // per-neighbour rate accounting: peers flooding beyond the window budget
+    // keep talking, but everything except their consensus messages drops to
+    // second priority so a misbehaving neighbour cannot stretch round latency
+    const bool overLimit = rateLimiter_.account(publicKey, pack.size());
+
+    auto priority = PacketsQueue::getPriority(pack.getType());
+    if (overLimit && priority == PacketsQueue::Priority::kFirst && !PacketsQueue::isConsensusMessage(pack.getType())) {
+        priority = PacketsQueue::Priority::kSecond;
+    }
+
+    if (priority == PacketsQueue::Priority::kFirst) {
+        PacketsQueue::SenderAndPacket entry{publicKey, std::move(pack)};
+
+        if (fastLane_.tryPush(std::move(entry))) {
+            newPacketsReceived_.notify_one();
+            return;
+        }
+
+        // lane full, fall through to the guarded queue; entry still owns the packet
+        pack = std::move(entry.second);
+    }
+
     {
         std::lock_guard g(inboxMux_);
-        inboxQueue_.push(publicKey, std::move(pack));
+        inboxQueue_.push(publicKey, std::move(pack), priority);
     }
 
     newPacketsReceived_.notify_one();
@@ -187,7 +444,9 @@ void Transport::OnNodeDiscovered(const net::NodeId& id) {
 }
 
 void Transport::OnNodeRemoved(const net::NodeId& id) {
-    neighbourhood_.peerDisconnected(toPublicKey(id));
+    const auto publicKey = toPublicKey(id);
+    rateLimiter_.remove(publicKey);
+    neighbourhood_.peerDisconnected(publicKey);
 }
 
 void Transport::onNeighboursChanged(const cs::PublicKey& neighbour, cs::Sequence lastSeq,
@@ -197,16 +456,28 @@ void Transport::onNeighboursChanged(const cs::PublicKey& neighbour, cs::Sequence
 }
 
 void Transport::onPingReceived(cs::Sequence sequence, const cs::PublicKey& key) {
+    peerQuality_.updateSequence(key, sequence);
+
     cs::Concurrent::execute(cs::RunPolicy::CallQueuePolicy, [=] {
         emit pingReceived(sequence, key);
     });
 }
 
+void Transport::onNeighbourLagUpdated(uint64_t rttMs, const cs::PublicKey& key) {
+    peerQuality_.updateLag(key, rttMs);
+
+    cs::Concurrent::execute(cs::RunPolicy::CallQueuePolicy, [=] {
+        emit pingLagUpdated(rttMs, key);
+    });
+}
+
 void Transport::sendDirect(Packet&& pack, const cs::PublicKey& receiver) {
-    host_.SendDirect(toNodeId(receiver), pack.moveData());
+    enqueueOutbound({SendQueue::Destination::kDirect, std::move(pack), {receiver}});
 }
 
 void Transport::ban(const cs::PublicKey& key) {
+    // kept in the quality store even while the actual ban is disabled
+    peerQuality_.registerBan(key);
     //host_.Ban(toNodeId(key));
 }
 
@@ -228,18 +499,74 @@ void Transport::getBanList(BanList& ret_container) const {
 }
 
 void Transport::sendMulticast(Packet&& pack, const std::vector<cs::PublicKey>& receivers) {
-    for (auto& receiver : receivers) {
-        auto ptr = reinterpret_cast<const uint8_t*>(pack.data());
-        host_.SendDirect(toNodeId(receiver), cs::Bytes(ptr, ptr + pack.size()));
-    }
+    enqueueOutbound({SendQueue::Destination::kMulticast, std::move(pack), receivers});
 }
 
 void Transport::sendBroadcast(Packet&& pack) {
-    host_.SendBroadcast(pack.moveData());
+    enqueueOutbound({SendQueue::Destination::kBroadcast, std::move(pack), {}});
 }
 
 void Transport::sendBroadcastIfNoConnection(Packet&& pack, const cs::PublicKey& receiver) {
-    host_.SendBroadcastIfNoConnection(toNodeId(receiver), pack.moveData());
+    enqueueOutbound({SendQueue::Destination::kBroadcastIfNoConnection, std::move(pack), {receiver}});
+}
+
+void Transport::enqueueOutbound(SendQueue::Entry&& entry) {
+    {
+        std::lock_guard g(outboxMux_);
+        outboxQueue_.push(std::move(entry));
+    }
+
+    outboxCv_.notify_one();
+}
+
+void Transport::dispatchOutbound(SendQueue::Entry&& entry) {
+    switch (entry.destination) {
+        case SendQueue::Destination::kDirect:
+            host_.SendDirect(toNodeId(entry.receivers.front()), entry.pack.moveData());
+            break;
+        case SendQueue::Destination::kMulticast:
+            for (auto& receiver : entry.receivers) {
+                auto ptr = reinterpret_cast<const uint8_t*>(entry.pack.data());
+                host_.SendDirect(toNodeId(receiver), cs::Bytes(ptr, ptr + entry.pack.size()));
+            }
+            break;
+        case SendQueue::Destination::kBroadcast:
+            host_.SendBroadcast(entry.pack.moveData());
+            break;
+        case SendQueue::Destination::kBroadcastIfNoConnection:
+            host_.SendBroadcastIfNoConnection(toNodeId(entry.receivers.front()), entry.pack.moveData());
+            break;
+    }
+}
+
+void Transport::senderRoutine() {
+    constexpr size_t kRoutineWaitTimeMs = 50;
+
+    cs::ThreadAffinity::instance().apply(cs::ThreadAffinity::Domain::Network);
+    cs::StackSampler::instance().registerThread("net-sender");
+
+    while (!stopped_.load(std::memory_order_acquire) && Transport::gSignalStatus == 0) {
+        std::unique_lock lock(outboxMux_);
+        outboxCv_.wait_for(lock, std::chrono::milliseconds{kRoutineWaitTimeMs}, [this]() {
+            return !outboxQueue_.empty() || stopped_.load(std::memory_order_acquire);
+        });
+        if (stopped_.load(std::memory_order_acquire)) break;
+
+        while (!outboxQueue_.empty()) {
+            SendQueue::Entry entry;
+            try {
+                entry = outboxQueue_.pop();
+            } catch (...) {
+              continue;
+            }
+
+            lock.unlock();
+            dispatchOutbound(std::move(entry));
+            lock.lock();
+        }
+    }
+
+    cs::StackSampler::instance().unregisterThread();
 }
 
 void Transport::clearInbox() {
@@ -247,36 +574,97 @@ void Transport::clearInbox() {
         std::lock_guard g(inboxMux_);
         inboxQueue_.clear();
     }
+
+    // called from message handlers, i.e. on the processor thread, so
+    // draining the single-reader lane here is legal
+    PacketsQueue::SenderAndPacket dropped;
+    while (fastLane_.tryPop(dropped)) {
+    }
+}
+
+size_t Transport::inboxQueueSize() {
+    std::lock_guard g(inboxMux_);
+    return inboxQueue_.size();
 }
 
 void Transport::processorRoutine() {
     constexpr size_t kRoutineWaitTimeMs = 50;
 
+    // packets handled per lock acquisition; under burst ingress the mutex is
+    // taken once per batch instead of once per message
+    constexpr size_t kMaxBatchSize = 64;
+
+    std::vector<PacketsQueue::SenderAndPacket> batch;
+    batch.reserve(kMaxBatchSize);
+
+    cs::ThreadAffinity::instance().apply(cs::ThreadAffinity::Domain::Dispatch);
+
+    // the message handlers, the conveyer slots and the drained calls queue
+    // all run here, making this the prime suspect of any slow round
+    cs::StackSampler::instance().registerThread("dispatch");
+
     while (!stopped_.load(std::memory_order_acquire) && Transport::gSignalStatus == 0) {
         process();
 
         std::unique_lock lock(inboxMux_);
         newPacketsReceived_.wait_for(lock, std::chrono::milliseconds{kRoutineWaitTimeMs}, [this]() {
-            return !inboxQueue_.empty() || stopped_.load(std::memory_order_acquire);
+            return fastLane_.hasData() || !inboxQueue_.empty() || stopped_.load(std::memory_order_acquire);
         });
         if (stopped_.load(std::memory_order_acquire)) break;
 
-        while (!inboxQueue_.empty()) {
-            PacketsQueue::SenderAndPacket senderAndPack;
-            try {
-                senderAndPack = inboxQueue_.pop();
-            } catch (...) {
-              continue;
+        while (fastLane_.hasData() || !inboxQueue_.empty()) {
+            while (batch.size() < kMaxBatchSize) {
+                PacketsQueue::SenderAndPacket senderAndPack;
+
+                if (fastLane_.tryPop(senderAndPack)) {
+                    batch.push_back(std::move(senderAndPack));
+                    continue;
+                }
+
+                if (inboxQueue_.empty()) {
+                    break;
+                }
+
+                try {
+                    batch.push_back(inboxQueue_.pop());
+                } catch (...) {
+                  break;
+                }
+            }
+
+            if (batch.empty()) {
+                break;
             }
 
             lock.unlock();
 
+            // same-type runs (e.g. a burst of TransactionPacket messages) are
+            // dispatched back to back so handler code and conveyer state stay
+            // hot; all messages here carry a round number and tolerate the
+            // cross-type reorder within a batch
+            std::stable_sort(batch.begin(), batch.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.second.getType() < rhs.second.getType();
+            });
+
             process();
-            processNodeMessage(senderAndPack.first, senderAndPack.second);
 
+            for (auto& senderAndPack : batch) {
+                // deferred half of packet validation: structural per-type checks
+                // run here, on the processor thread, so the receive loop stayed
+                // at wire speed while this packet waited in the queue
+                if (!cs::PacketValidator::validateStructure(senderAndPack.second)) {
+                    continue;
+                }
+
+                processNodeMessage(senderAndPack.first, senderAndPack.second);
+            }
+
+            batch.clear();
             lock.lock();
         }
     }
+
+    cs::StackSampler::instance().unregisterThread();
 }
 
 void Transport::process() {
@@ -290,18 +678,41 @@ void Transport::checkNeighboursChange() {
         auto& neighbour = neighboursToHandle_.front();
         if (neighbour.added) {
             emit neighbourAdded(neighbour.key, neighbour.lastSeq, neighbour.lastRound);
+
+            // seed subscribers with the lag stored from previous runs, so the pool
+            // synchronizer ranks a known fast peer before its first pong arrives
+            const auto quality = peerQuality_.get(neighbour.key);
+
+            if (quality.has_value() && quality->rttEwmaMs != 0) {
+                emit pingLagUpdated(quality->rttEwmaMs, neighbour.key);
+            }
         }
         else {
             emit neighbourRemoved(neighbour.key);
+
+            // configured boot nodes are worth keeping: re-resolve off-thread
+            // (the address may have changed since startup) and knock again
+            const auto bootNode = bootNodeEntries_.find(neighbour.key);
+
+            if (bootNode != bootNodeEntries_.end()) {
+                peerResolver_.schedule(bootNode->second);
+            }
         }
         neighboursToHandle_.pop_front();
     }
 }
 
 void Transport::processNodeMessage(const cs::PublicKey& sender, const Packet& pack) {
+    static cs::LatencyHistogram& histogram = cs::Metrics::instance().histogram("transport_process_message_us");
+    cs::MetricsTimer timer(histogram);
+
     auto type = pack.getType();
     auto rNum = pack.getRoundNum();
 
+    if (traceWriter_.isOpen()) {
+        traceWriter_.append(sender, static_cast<const cs::Byte*>(pack.data()), pack.size());
+    }
+
     switch (node_->chooseMessageAction(rNum, type, sender)) {
         case Node::MessageActions::Process:
             return dispatchNodeMessage(sender, type, rNum, pack.getMsgData(), pack.getMsgSize());
@@ -312,92 +723,46 @@ void Transport::processNodeMessage(const cs::PublicKey& sender, const Packet& pa
     }
 }
 
-void Transport::dispatchNodeMessage(const cs::PublicKey& sender, const MsgTypes type, const cs::RoundNumber rNum, const uint8_t* data, size_t size) {
-    // add special logs here
-    switch (type) {
-        case MsgTypes::ThirdSmartStage:
-            csdebug() << "+++++++++++++++++++  ThirdSmartStage arrived +++++++++++++++++++++";
-            break;
-        default:
-            break;
+void Transport::replayTrace(const std::string& path, uint64_t speedFactor) {
+    const auto records = PacketTraceReader::load(path);
+
+    if (records.empty()) {
+        cswarning() << "TRANSPORT> Nothing to replay from " << path;
+        return;
     }
 
-    // call handlers
-    switch (type) {
-        case MsgTypes::BlockRequest:
-            return node_->getBlockRequest(data, size, sender);
-        case MsgTypes::RequestedBlock:
-            return node_->getBlockReply(data, size, sender);
-        case MsgTypes::Utility:
-            return node_->getUtilityMessage(data, size);
-        case MsgTypes::NodeStopRequest:
-            return node_->getNodeStopRequest(rNum, data, size);
-        case MsgTypes::RoundTable:
-            return node_->getRoundTable(data, size, rNum, sender);
-        case MsgTypes::BootstrapTable:
-            return node_->getBootstrapTable(data, size, rNum);
-        case MsgTypes::RoundTableRequest:
-            return node_->getRoundTableRequest(data, size, rNum, sender);
-        case MsgTypes::BlockHash:
-            return node_->getHash(data, size, rNum, sender);
-        case MsgTypes::HashReply:
-            return node_->getHashReply(data, size, rNum, sender);
-        case MsgTypes::TransactionPacket:
-            return node_->getTransactionsPacket(data, size, sender);
-        case MsgTypes::TransactionsPacketRequest:
-            return node_->getPacketHashesRequest(data, size, rNum, sender);
-        case MsgTypes::TransactionsPacketReply:
-            return node_->getPacketHashesReply(data, size, rNum, sender);
-        case MsgTypes::FirstStage:
-            return node_->getStageOne(data, size, sender);
-        case MsgTypes::SecondStage:
-            return node_->getStageTwo(data, size, sender);
-        case MsgTypes::FirstStageRequest:
-            return node_->getStageRequest(type, data, size, sender);
-        case MsgTypes::SecondStageRequest:
-            return node_->getStageRequest(type, data, size, sender);
-        case MsgTypes::ThirdStageRequest:
-            return node_->getStageRequest(type, data, size, sender);
-        case MsgTypes::ThirdStage:
-            return node_->getStageThree(data, size, sender);
-        case MsgTypes::FirstSmartStage:
-            return node_->getSmartStageOne(data, size, rNum, sender);
-        case MsgTypes::SecondSmartStage:
-            return node_->getSmartStageTwo(data, size, rNum, sender);
-        case MsgTypes::ThirdSmartStage:
-            return node_->getSmartStageThree(data, size, rNum, sender);
-        case MsgTypes::SmartFirstStageRequest:
-            return node_->getSmartStageRequest(type, data, size, sender);
-        case MsgTypes::SmartSecondStageRequest:
-            return node_->getSmartStageRequest(type, data, size, sender);
-        case MsgTypes::SmartThirdStageRequest:
-            return node_->getSmartStageRequest(type, data, size, sender);
-        case MsgTypes::RejectedContracts:
-            return node_->getSmartReject(data, size, rNum, sender);
-        case MsgTypes::RoundTableReply:
-            return node_->getRoundTableReply(data, size, sender);
-        case MsgTypes::RoundPackRequest:
-            return node_->getRoundPackRequest(data, size, rNum, sender);
-        case MsgTypes::EmptyRoundPack:
-            return node_->getEmptyRoundPack(data, size, rNum, sender);
-        case MsgTypes::StateRequest:
-            return node_->getStateRequest(data, size, rNum, sender);
-        case MsgTypes::StateReply:
-            return node_->getStateReply(data, size, rNum, sender);
-        case MsgTypes::BlockAlarm:
-            return node_->getBlockAlarm(data, size, rNum, sender);
-        case MsgTypes::EventReport:
-            return node_->getEventReport(data, size, rNum, sender);
-        case MsgTypes::SyncroMsg:
-            return node_->getSyncroMessage(data, size, sender);
-        case MsgTypes::TransactionPacketHash:
-            return node_->getPacketHash(data, size, rNum, sender);
-        case MsgTypes::TransactionsPacketBaseRequest:
-            return node_->getPacketHashRequest(data, size, rNum, sender);
-        case MsgTypes::TransactionsPacketBaseReply:
-            return node_->getPacketHashesBaseReply(data, size, rNum, sender);
-        default:
+    cslog() << "TRANSPORT> Replaying " << records.size() << " messages from " << path
+            << (speedFactor == 0 ? " at full speed" : ", speed factor " + std::to_string(speedFactor));
+
+    uint64_t previousUs = records.front().timestampUs;
+
+    for (const auto& record : records) {
+        if (stopped_.load(std::memory_order_acquire)) {
             break;
+        }
+
+        if (speedFactor != 0 && record.timestampUs > previousUs) {
+            std::this_thread::sleep_for(std::chrono::microseconds((record.timestampUs - previousUs) / speedFactor));
+        }
+
+        previousUs = record.timestampUs;
+
+        Packet pack(cs::Bytes(record.packetBytes));
+
+        if (pack.isHeaderValid()) {
+            processNodeMessage(record.sender, pack);
+        }
+
+        // timers and deferred calls the handlers scheduled between messages
+        CallsQueue::instance().callAll();
+    }
+
+    cslog() << "TRANSPORT> Replay finished";
+}
+
+void Transport::dispatchNodeMessage(const cs::PublicKey& sender, const MsgTypes type, const cs::RoundNumber rNum, const uint8_t* data, size_t size) {
+    if (const auto handler = kDispatchTable[static_cast<size_t>(type)]) {
+        handler(*node_, sender, type, rNum, data, size);
     }
 }
 
@@ -419,10 +784,42 @@ void Transport::setPermanentNeighbours(const std::set<cs::PublicKey>& neighbours
     neighbourhood_.setPermanentNeighbours(neighbours);
 }
 
+void Transport::restrictNeighboursToPermanent() {
+    neighbourhood_.restrictToPermanent();
+}
+
 void Transport::forEachNeighbour(Neighbourhood::NeighboursCallback callback) {
     neighbourhood_.forEachNeighbour(callback);
 }
 
+std::string Transport::getPeerStatsReport() {
+    const auto traffic = rateLimiter_.stats();
+
+    std::ostringstream out;
+    out << "peer link stats, " << getNeighboursCount() << " neighbours:\n";
+
+    neighbourhood_.forEachLinkStat([&](const cs::PublicKey& peer, const Neighbourhood::LinkStats& link) {
+        out << EncodeBase58(peer.data(), peer.data() + peer.size())
+            << ": rtt " << link.rttEwmaMs << " ms, seq " << link.lastSeq << ", round " << link.roundNumber;
+        if (link.permanent) {
+            out << ", permanent";
+        }
+
+        auto it = traffic.find(peer);
+        if (it != traffic.end()) {
+            const auto& stats = it->second;
+            out << ", in " << stats.totalBytes << " bytes / " << stats.totalMessages << " msgs"
+                << ", last " << PeerRateLimiter::kWindowSlots << " s " << stats.windowBytes << " bytes / " << stats.windowMessages << " msgs";
+            if (stats.throttled) {
+                out << ", throttled";
+            }
+        }
+        out << '\n';
+    });
+
+    return out.str();
+}
+
 uint32_t Transport::getNeighboursCount() const {
     return neighbourhood_.getNeighboursCount();
 }
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <lib/system/queues.hpp>
+
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <map>
-#include <set>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 // template<typename TResol = std::chrono::milliseconds>
 class CallsQueueScheduler {
@@ -37,9 +41,7 @@ public:
      * @date    17.09.2018
      */
 
-    CallsQueueScheduler()
-    : _queue(compare) {
-    }
+    CallsQueueScheduler() = default;
 
     CallsQueueScheduler(const CallsQueueScheduler&) = delete;
     CallsQueueScheduler& operator=(const CallsQueueScheduler&) = delete;
@@ -147,7 +149,7 @@ public:
      *
      * @param   id  The identifier of call to remove. The id must be obtained by previous call to Insert()
      *
-     * @return  True if it succeeds, false if it fails.
+     * @return  True if the removal was submitted, the worker thread performs it asynchronously.
      */
 
     bool Remove(CallTag id);
@@ -221,45 +223,80 @@ public:
 
 private:
     /**
-     * @struct  Context
+     * @struct  Command
      *
-     * @brief   Stores all info to call, re-schedule and cancel further calls in queue.
+     * @brief   A scheduler operation submitted from any thread through the lock-free ring; the
+     *          worker thread is the only consumer, so Insert()/Remove() never contend with it.
      *
      * @author  aae
      * @date    17.09.2018
      */
 
-    struct Context {
-        /** @brief   The identifier: lets find item in queue (e.g. for remove) */
-        CallTag id;
+    struct Command {
+        enum class Type : uint8_t {
+            none,
+            insert,
+            remove,
+            remove_all,
+            clear
+        };
+
+        /** @brief   The operation to perform */
+        Type type{Type::none};
+
+        /** @brief   The identifier of the call the operation refers to */
+        CallTag id{no_tag};
 
         /** @brief   The time point for scheduled execution */
-        ClockType::time_point tp;
+        ClockType::time_point tp{};
 
         /** @brief   The delta - time period for periodic calls */
-        long long dt;
+        long long dt{0};
+
+        /** @brief   True to replace an existing schedule with the same id */
+        bool replace{false};
 
         /** @brief   The procedure to call*/
         ProcType proc;
-
-        // support for std::find() by id
-        bool operator==(const CallTag rhs) const {
-            return id == rhs;
-        }
     };
 
-    // used for sort items in _queue by time to call
-    std::function<bool(const Context& lhs, const Context& rhs)> compare = [](const Context& lhs, const Context& rhs) { return lhs.tp < rhs.tp; };
-
-    // container requirements: auto sort by tp, search by id
-    std::multiset<Context, decltype(compare)> _queue;
-    // sync access to _queue
-    std::mutex _mtx_queue;
+    // scheduled call as seen by the worker thread, found by tag; Remove() makes wheel
+    // references stale by erasing here, stale references are skipped on expiration
+    struct Entry {
+        ClockType::time_point tp;
+        long long dt;
+        // distinguishes the current schedule from stale wheel/overflow references
+        uint64_t epoch;
+        ProcType proc;
+    };
 
-    // process _queue and puts on time calls into CallsQueue::instance() object
+    // timer wheel geometry: kWheelSize slots of kTickMs cover ~4 s which fits every round
+    // timeout in use; longer waits sit in _overflow and cascade in as the horizon approaches
+    constexpr static size_t kWheelSize = 256;  // must be power of two
+    constexpr static long long kTickMs = 16;
+
+    // lock-free submission ring, any thread pushes, only the worker thread pops
+    FTQueue<Command, 256> _commands;
+
+    // the structures below are owned by the worker thread exclusively and need no locking
+
+    // active calls by tag
+    std::unordered_map<CallTag, Entry> _active;
+    // per-slot (tag, epoch) references into _active
+    std::array<std::vector<std::pair<CallTag, uint64_t>>, kWheelSize> _wheel;
+    // calls scheduled beyond the wheel horizon, sorted by time point
+    std::multimap<ClockType::time_point, std::pair<CallTag, uint64_t>> _overflow;
+    // index of the slot that covers [_wheel_time, _wheel_time + kTickMs)
+    size_t _slot{0};
+    // lower bound of the current slot interval
+    ClockType::time_point _wheel_time;
+    // source of Entry::epoch values
+    uint64_t _epochs{0};
+
+    // process the wheel and puts on time calls into the CallsQueue::instance() priority lane
     std::thread _worker;
 
-    // signals to _worker thread that _queue was updated
+    // signals to _worker thread that new commands were submitted
     std::condition_variable _signal;
     // need by _signal
     std::mutex _mtx_signal;
@@ -270,7 +307,7 @@ private:
     // flag to stop _worker thread
     std::atomic_bool _stop = {false};
 
-    // statistics
+    // statistics (updated by the worker thread only)
     uint32_t _cnt_total{0};
     uint32_t _cnt_block_exe{0};
     uint32_t _cnt_block_que{0};
@@ -282,12 +319,33 @@ private:
         uint32_t done;
     };
 
+    // guards _exe_sync: it is shared between the worker thread and lambdas run by CallsQueue;
+    // taken only when a timeout actually fires, never on the Insert()/Remove() hot path
+    std::mutex _mtx_exe;
     std::map<CallTag, ExeSync> _exe_sync;
 
     // thread procedure
     void SchedulerProc();
 
-    // methods below are NOT thread-safe, they must be synced at point of call!
+    // pushes cmd into the ring (yields while full, which means the worker fell far behind)
+    // and rings the worker doorbell
+    void Submit(Command&& cmd);
+
+    // methods below are called by the worker thread only
+
+    void ApplyCommand(Command& cmd);
+    // places a reference to _active[id] into the wheel or, beyond the horizon, into _overflow
+    void ScheduleEntry(CallTag id, ClockType::time_point tp);
+    // moves overflow items that fit under the horizon into the wheel
+    void CascadeOverflow();
+    // advances the wheel up to now and executes expired calls
+    void FireDue(ClockType::time_point now);
+    // puts the call into CallsQueue and re-schedules periodic items
+    void Fire(CallTag id, ClockType::time_point now);
+    // the time point of the nearest scheduled call, or far future when idle
+    ClockType::time_point NextWakeup() const;
+
+    // methods below are NOT thread-safe, they must be synced by _mtx_exe at point of call!
 
     // must be called when put the lambda in CallsQueue for execution
     void OnExeQueued(CallTag id);
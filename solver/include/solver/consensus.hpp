@@ -94,6 +94,21 @@ public:
     /** @brief   Max timeout (msec) to wait stages (Trusted-2,3) */
     const static uint32_t TimeStageRequest;
 
+    /** @brief   Upper bound (msec) for the adaptive stage timeout, see stageTimeout() */
+    const static uint32_t TimeStageRequestMax;
+
+    /**
+     * Stage timeout matched to observed round durations: p95 of the recent
+     * rounds plus a quarter margin, clamped to [TimeStageRequest,
+     * TimeStageRequestMax]. On congested networks stages legitimately arrive
+     * late and a fixed timeout fires too early, restarting rounds for nothing;
+     * until enough rounds are measured the fixed constant is used.
+     *
+     * @param roundP95Ms    p95 of recent round durations, msec (0 if unknown)
+     * @param samples       how many rounds the percentile is built from
+     */
+    static uint32_t stageTimeout(size_t roundP95Ms, size_t samples);
+
     /** @brief   Max subround delta */
     const static uint8_t MaxSubroundDelta;
 
@@ -0,0 +1,65 @@
+#ifndef EXE_QUEUE_JOURNAL_HPP
+#define EXE_QUEUE_JOURNAL_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <lmdb.hpp>
+
+#include <lib/system/common.hpp>
+
+namespace cs {
+
+// incremental persistence of the smart contracts execution queue. Every
+// enqueue and status change appends one record, so after a hard restart the
+// queue is rebuilt by replaying the journal instead of re-reading blocks;
+// the quick-start snapshot covers graceful shutdowns only. Records are keyed
+// by a monotonic counter and hold either a full serialized queue item or a
+// tombstone, restore() compacts the journal back to one record per live item
+class ExeQueueJournal {
+public:
+    explicit ExeQueueJournal(const std::string& path);
+    ~ExeQueueJournal();
+
+    // appends the serialized queue item under its journal id, the latest
+    // record of an id wins on replay
+    void upsert(uint64_t id, const cs::Bytes& item);
+
+    // appends a tombstone, the item has left the queue
+    void erase(uint64_t id);
+
+    // replays the journal in append order and compacts it; pairs come back
+    // in queue order, the id of every pair is ready for further upserts
+    std::vector<std::pair<uint64_t, cs::Bytes>> restore();
+
+    // drops every record and rewrites the journal from a live queue snapshot,
+    // used when block replay has adjusted the queue with the journal muted
+    void rebuild(const std::vector<std::pair<uint64_t, cs::Bytes>>& items);
+
+    size_t size() const;
+
+private slots:
+    void onFailed(const cs::LmdbException& exception);
+
+private:
+    enum RecordTag : cs::Byte {
+        kUpsertTag = 0,
+        kEraseTag = 1
+    };
+
+    void initialization();
+    void append(cs::Byte tag, uint64_t id, const cs::Bytes& item);
+
+    // the lmdb wrapper stores integral keys as decimal text which breaks
+    // cursor ordering past one digit width, big-endian fixed width keys keep
+    // lexicographic order equal to numeric order
+    static cs::Bytes makeKey(uint64_t sequence);
+    static uint64_t decodeKey(const cs::Bytes& key);
+
+    cs::Lmdb db_;
+    uint64_t nextRecord_ = 1;
+};
+}  // namespace cs
+
+#endif  // EXE_QUEUE_JOURNAL_HPP
@@ -316,6 +316,8 @@ using SmartContractExecutedSignal = cs::Signal<void(cs::TransactionsPacket)>;
 // passes to every slot the "starter" transaction
 using SmartContractSignal = cs::Signal<void(const csdb::Transaction&)>;
 
+class ExeQueueJournal;
+
 class SmartContracts final {
 public:
     explicit SmartContracts(BlockChain&, CallsQueueScheduler&);
@@ -550,6 +552,9 @@ public slots:
     void on_start_reading_blocks(cs::Sequence lastBlockNum) {
         cs::Lock lock(public_access_lock);
         max_read_sequence = lastBlockNum;
+        // replay reproduces the very items the journal already holds, mute it
+        // until the last block is read, then resync in one pass
+        reading_blocks = true;
     }
 
 private:
@@ -673,6 +678,9 @@ private:
         bool is_executor;
         // is rejected by consensus
         bool is_rejected;
+        // identity in the execution queue journal, not serialized, stays 0
+        // until the first journal write
+        uint64_t journal_id = 0;
         // actual consensus
         std::unique_ptr<SmartConsensus> pconsensus;
 
@@ -686,6 +694,7 @@ private:
             abs_addr = src.abs_addr;
             is_executor = src.is_executor;
             is_rejected = src.is_rejected;
+            journal_id = src.journal_id;
             if (!src.executions.empty()) {
                 executions.assign(src.executions.cbegin(), src.executions.cend());
             }
@@ -727,6 +736,23 @@ private:
     // requirements: items are non-movable during the whole life cycle
     std::list<QueueItem> exe_queue;
 
+    // incremental queue persistence, restores the pre-restart position within
+    // the first round after boot, see exequeuejournal.hpp
+    std::unique_ptr<cs::ExeQueueJournal> pjournal;
+    uint64_t next_journal_id = 1;
+    // true while blocks are replayed from the database
+    bool reading_blocks = false;
+
+    // appends the current state of the item to the journal, assigns an id on
+    // the first call for the item
+    void journal_store(QueueItem& item);
+    void journal_erase(const QueueItem& item);
+    // rebuilds exe_queue from the journal unless the quick-start snapshot
+    // has already delivered it
+    void restore_exe_queue();
+    // rewrites the journal from the live queue after a muted replay
+    void journal_resync();
+
     // is locked in all non-static public methods
     // is locked in const methods also
     //mutable cs::SpinLock public_access_lock = ATOMIC_FLAG_INIT;
@@ -203,6 +203,13 @@ public:
         return core.scheduler;
     }
 
+    /**
+     * Stage exchange timeout for the current network conditions, msec.
+     * Derived from the round-duration telemetry collected by RoundStat and
+     * bounded by the protocol constants, see Consensus::stageTimeout()
+     */
+    uint32_t stageTimeout() const;
+
     // Access to common state properties.
 
     /**
@@ -9,6 +9,8 @@
 
 #include <csnode/itervalidator.hpp>
 
+#include <lib/system/concurrent.hpp>
+
 #include <csdb/pool.hpp>
 #include <csnode/transactionspacket.hpp>
 #include <csnode/roundpackage.hpp>
@@ -326,6 +328,54 @@ private:
     std::vector<cs::StageTwo> stageTwoStorage;
     std::vector<cs::StageThree> stageThreeStorage;
     std::vector<cs::StageThree> trueStageThreeStorage;
+
+    // recycling pools: stages retired on nextRound() donate their heap buffers to stages of
+    // subsequent rounds, so steady-state consensus does not go to the allocator every round
+    std::vector<cs::StageOne> stageOnePool_;
+    std::vector<cs::StageTwo> stageTwoPool_;
+    std::vector<cs::StageThree> stageThreePool_;
+
+    template <typename StageT>
+    static void recycleStages(std::vector<StageT>& storage, std::vector<StageT>& pool) {
+        constexpr size_t max_pooled = 2 * Consensus::MaxTrustedNodes;
+        size_t donated = 0;
+        for (auto& stage : storage) {
+            if (pool.size() >= max_pooled) {
+                break;
+            }
+            pool.push_back(std::move(stage));
+            ++donated;
+        }
+
+        if (donated < storage.size()) {
+            // stages past the pool cap still own their buffers; hand the whole
+            // vector to a worker so their destructor cascade never runs on the
+            // round-change path
+            cs::Concurrent::run([scrap = std::move(storage)]() mutable {
+                scrap.clear();
+            });
+
+            storage = std::vector<StageT>();
+            storage.reserve(max_pooled / 2);
+            return;
+        }
+
+        // every element donated its buffers, only empty shells remain
+        storage.clear();
+    }
+
+    template <typename StageT>
+    static void storeRecycled(std::vector<StageT>& storage, std::vector<StageT>& pool, const StageT& stage) {
+        if (pool.empty()) {
+            storage.push_back(stage);
+            return;
+        }
+        // assignment re-uses the heap buffers of the retired stage
+        StageT& recycled = pool.back();
+        recycled = stage;
+        storage.push_back(std::move(recycled));
+        pool.pop_back();
+    }
     bool realTrustedChanged_;
     cs::Bytes tempRealTrusted_;
 
@@ -1,94 +1,234 @@
 #include "callsqueuescheduler.hpp"
-#include <algorithm>
 #include <lib/system/utils.hpp>  // CallsQueue
 
 void CallsQueueScheduler::SchedulerProc() {
-    bool signaled{false};
-    constexpr long long min_wait_for = 5;
-    while (!_stop) {
-        // get earliest action time
-        auto earliest = ClockType::now() + std::chrono::seconds(60);
-        {
-            std::lock_guard<std::mutex> lque(_mtx_queue);
-            if (!_queue.empty()) {
-                earliest = _queue.cbegin()->tp;
-            }
+    _wheel_time = ClockType::now();
+    _slot = 0;
+    while (true) {
+        // apply all commands submitted through the ring since the last pass
+        Command cmd;
+        while (_commands.tryPop(cmd)) {
+            ApplyCommand(cmd);
         }
-        // sleep until scheduled event and get ready to awake at any time
-        std::unique_lock<std::mutex> lsig(_mtx_signal);
-        signaled = _signal.wait_until(lsig, earliest, [this]() { return _flag; });  // std::system_error!
-        // test stop condition before reaction
+        // test stop condition after the drain so Stop() may clear the queue first
         if (_stop) {
             break;
         }
-        // event occurs
-        if (signaled) {
-            // reset _flag for the next signal
-            _flag = false;
-            // awake by direct notification: re-schedule next timeout
-            std::lock_guard<std::mutex> lque(_mtx_queue);
-            if (!_queue.empty()) {
-                // test whether to call immediately
-                if ((_queue.cbegin()->tp - ClockType::now()).count() >= min_wait_for) {
-                    // schedule next wait period
-                    continue;
+        FireDue(ClockType::now());
+        // sleep until the nearest scheduled call and get ready to awake at any time
+        const auto wakeup = NextWakeup();
+        std::unique_lock<std::mutex> lsig(_mtx_signal);
+        _signal.wait_until(lsig, wakeup, [this]() { return _flag; });  // std::system_error!
+        // reset _flag for the next signal
+        _flag = false;
+    }
+}
+
+void CallsQueueScheduler::Submit(Command&& cmd) {
+    while (!_commands.tryPush(std::move(cmd))) {
+        // the ring overflows only if the worker thread has fallen far behind
+        std::this_thread::yield();
+    }
+    // awake worker thread to handle the command
+    {
+        std::lock_guard<std::mutex> lsig(_mtx_signal);
+        _flag = true;
+    }
+    _signal.notify_one();
+}
+
+void CallsQueueScheduler::ApplyCommand(Command& cmd) {
+    switch (cmd.type) {
+        case Command::Type::insert: {
+            const auto it = _active.find(cmd.id);
+            if (it != _active.end()) {
+                if (!cmd.replace) {
+                    // reject schedule, the one already added before and still in queue
+                    _cnt_block_que += 1;
+                    return;
                 }
-                // fall through to execute proc now (either timeout almost coincided with the signal, or proc is scheduled with
-                // tiny wait_for)
+                // re-schedule, the old wheel reference goes stale through the new epoch
+                csdebug() << "Erasing existing calls: " << cmd.id;
+                it->second = Entry{cmd.tp, cmd.dt, ++_epochs, std::move(cmd.proc)};
             }
             else {
-                // queue is empty, schedule next wait period
-                continue;
+                _active.emplace(cmd.id, Entry{cmd.tp, cmd.dt, ++_epochs, std::move(cmd.proc)});
             }
+            ScheduleEntry(cmd.id, cmd.tp);
+            break;
         }
-        // awake due timeout: the most probable its time to execute earliest proc
-        // test scheduled time (if it was at all)
-        Context run;
-        run.id = no_tag;
-        {
-            std::lock_guard<std::mutex> lque(_mtx_queue);
-            // execute calls until wait time >= min_wait_for
-            while (!_queue.empty()) {
-                if ((_queue.cbegin()->tp - ClockType::now()).count() >= min_wait_for) {
-                    break;
+        case Command::Type::remove: {
+            {
+                std::lock_guard<std::mutex> lexe(_mtx_exe);
+                // rollback last counter increment
+                const auto it_sync = _exe_sync.find(cmd.id);
+                if (it_sync != _exe_sync.end()) {
+                    it_sync->second.queued = it_sync->second.done;
                 }
-                run = *_queue.cbegin();
-                _queue.erase(_queue.cbegin());
-                ProcType proc = run.proc;
-                // push to CallsQueue only if there are no any previous calls
-                if (CanExe(run.id)) {
-                    OnExeQueued(run.id);
-                    CallsQueue::instance().insert([this, run]() {
-                        {
-                            std::lock_guard<std::mutex> lque(_mtx_queue);
-                            if (!ConfirmExe(run.id)) {
-                                // its highly likely the job was canceled
-                                return;
-                            }
-                        }
-                        // call out of lock to avoid recursive mutex locking if proc to insert another scheduled call
-                        run.proc();
-                        {
-                            std::lock_guard<std::mutex> lque(_mtx_queue);
-                            OnExeDone(run.id);
-                        }
-                    });
-                    _cnt_total += 1;
+            }
+            // O(1), the wheel reference goes stale and is skipped on expiration
+            _active.erase(cmd.id);
+            break;
+        }
+        case Command::Type::remove_all:
+        case Command::Type::clear: {
+            {
+                std::lock_guard<std::mutex> lexe(_mtx_exe);
+                if (cmd.type == Command::Type::clear) {
+                    _exe_sync.clear();
                 }
                 else {
-                    _cnt_block_exe += 1;
-                }
-                // Launch::periodic -> schedule next item
-                if (run.dt > 0) {
-                    run.tp = ClockType::now() + std::chrono::milliseconds(run.dt);
-                    auto pos = _queue.insert(run);
-                    if (pos == _queue.end()) {
-                        // periodic calls aborted due to unexpected problem!
+                    for (auto& sync : _exe_sync) {
+                        // rollback last counter increment
+                        sync.second.queued = sync.second.done;
                     }
                 }
             }
+            _active.clear();
+            for (auto& slot : _wheel) {
+                slot.clear();
+            }
+            _overflow.clear();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void CallsQueueScheduler::ScheduleEntry(CallTag id, ClockType::time_point tp) {
+    constexpr auto horizon = std::chrono::milliseconds(kTickMs * static_cast<long long>(kWheelSize));
+    if (tp >= _wheel_time + horizon) {
+        _overflow.emplace(tp, std::make_pair(id, _active[id].epoch));
+        return;
+    }
+    long long ticks = 0;
+    if (tp > _wheel_time) {
+        ticks = std::chrono::duration_cast<std::chrono::milliseconds>(tp - _wheel_time).count() / kTickMs;
+    }
+    _wheel[(_slot + static_cast<size_t>(ticks)) & (kWheelSize - 1)].emplace_back(id, _active[id].epoch);
+}
+
+void CallsQueueScheduler::CascadeOverflow() {
+    constexpr auto horizon = std::chrono::milliseconds(kTickMs * static_cast<long long>(kWheelSize));
+    while (!_overflow.empty() && _overflow.begin()->first < _wheel_time + horizon) {
+        const auto [id, epoch] = _overflow.begin()->second;
+        const auto tp = _overflow.begin()->first;
+        _overflow.erase(_overflow.begin());
+        const auto it = _active.find(id);
+        if (it == _active.end() || it->second.epoch != epoch) {
+            // canceled or re-scheduled meanwhile
+            continue;
+        }
+        ScheduleEntry(id, tp);
+    }
+}
+
+void CallsQueueScheduler::FireDue(ClockType::time_point now) {
+    CascadeOverflow();
+    const auto tick = std::chrono::milliseconds(kTickMs);
+    // advance through fully expired slots
+    while (_wheel_time + tick <= now) {
+        auto& slot = _wheel[_slot];
+        for (const auto& [id, epoch] : slot) {
+            const auto it = _active.find(id);
+            if (it == _active.end() || it->second.epoch != epoch) {
+                // canceled or re-scheduled meanwhile
+                continue;
+            }
+            Fire(id, now);
+        }
+        slot.clear();
+        _slot = (_slot + 1) & (kWheelSize - 1);
+        _wheel_time += tick;
+        CascadeOverflow();
+    }
+    // the current slot is partially expired, execute calls that are already on time;
+    // indexed loop: Fire() may re-schedule a short periodic call back into this very slot
+    auto& slot = _wheel[_slot];
+    for (size_t i = 0; i < slot.size();) {
+        const auto [id, epoch] = slot[i];
+        const auto it = _active.find(id);
+        if (it == _active.end() || it->second.epoch != epoch) {
+            slot.erase(slot.begin() + static_cast<ptrdiff_t>(i));
+            continue;
+        }
+        if (it->second.tp > now) {
+            ++i;
+            continue;
+        }
+        slot.erase(slot.begin() + static_cast<ptrdiff_t>(i));
+        Fire(id, now);
+    }
+}
+
+void CallsQueueScheduler::Fire(CallTag id, ClockType::time_point now) {
+    const auto it = _active.find(id);
+    ProcType proc = it->second.proc;
+    bool can_exe = false;
+    {
+        std::lock_guard<std::mutex> lexe(_mtx_exe);
+        // push to CallsQueue only if there are no any previous calls
+        can_exe = CanExe(id);
+        if (can_exe) {
+            OnExeQueued(id);
+        }
+    }
+    if (can_exe) {
+        // the scheduler serves consensus state timeouts and continuations, so fired procs
+        // take the priority lane and do not wait behind bulk work queued by other modules
+        CallsQueue::instance().insertPriority([this, id, proc]() {
+            {
+                std::lock_guard<std::mutex> lexe(_mtx_exe);
+                if (!ConfirmExe(id)) {
+                    // its highly likely the job was canceled
+                    return;
+                }
+            }
+            // call out of lock to avoid recursive mutex locking if proc to insert another scheduled call
+            proc();
+            {
+                std::lock_guard<std::mutex> lexe(_mtx_exe);
+                OnExeDone(id);
+            }
+        });
+        _cnt_total += 1;
+    }
+    else {
+        _cnt_block_exe += 1;
+    }
+    // Launch::periodic -> schedule next expiration
+    if (it->second.dt > 0) {
+        it->second.tp = now + std::chrono::milliseconds(it->second.dt);
+        it->second.epoch = ++_epochs;
+        ScheduleEntry(id, it->second.tp);
+    }
+    else {
+        _active.erase(it);
+    }
+}
+
+CallsQueueScheduler::ClockType::time_point CallsQueueScheduler::NextWakeup() const {
+    const auto idle = ClockType::now() + std::chrono::seconds(60);
+    if (_active.empty()) {
+        return idle;
+    }
+    auto nearest = idle;
+    if (!_overflow.empty()) {
+        nearest = _overflow.begin()->first;
+    }
+    // the first non-empty slot bounds the nearest wheel expiration; a slot holding only
+    // stale references costs one spurious wakeup which is harmless
+    for (size_t i = 0; i < kWheelSize; ++i) {
+        if (!_wheel[(_slot + i) & (kWheelSize - 1)].empty()) {
+            const auto slot_end = _wheel_time + std::chrono::milliseconds(kTickMs * static_cast<long long>(i + 1));
+            if (slot_end < nearest) {
+                nearest = slot_end;
+            }
+            break;
         }
     }
+    return nearest;
 }
 
 void CallsQueueScheduler::Run() {
@@ -132,8 +272,11 @@ bool CallsQueueScheduler::ConfirmExe(CallTag id) {
 void CallsQueueScheduler::Stop() {
     Clear();
     _stop = true;
-    // awake worker thread if it sleeps
-    _flag = true;
+    // awake worker thread if it sleeps, the clear command is drained before the stop test
+    {
+        std::lock_guard<std::mutex> lsig(_mtx_signal);
+        _flag = true;
+    }
     _signal.notify_one();
     if (_worker.joinable()) {
         _worker.join();
@@ -150,77 +293,34 @@ CallsQueueScheduler::CallTag CallsQueueScheduler::Insert(ClockType::duration wai
     // CallTag id = (CallTag) &proc;
     // current solution requires enable RTTI = Yes (/GR) to compile:
     CallTag id = (tag == auto_tag ? proc.target_type().hash_code() : tag);
-    {
-        std::lock_guard<std::mutex> l(_mtx_queue);
-        auto it = std::find(_queue.cbegin(), _queue.cend(), id);
-        if (it != _queue.cend()) {
-            if (!replace_existing) {
-                // reject schedule, the one already added before and still in queue
-                _cnt_block_que += 1;
-                return id;
-            }
-            else {
-                // remove from queue, below we will add a new schedule
-                csdebug() << "Erasing existing calls: " << it->id;
-                _queue.erase(it);
-            }
-        }
-        // add new item
-        auto result = _queue.insert(CallsQueueScheduler::Context{
-            id, ClockType::now() + wait_for, (scheme == Launch::once ? 0 : std::chrono::duration_cast<std::chrono::milliseconds>(wait_for).count()), std::move(proc)
-            //, std::move(comment)
-        });
-        if (result == _queue.end()) {
-            return no_tag;
-        }
-    }
-    // awake worker thread to re-schedule its waiting
-    _flag = true;
-    _signal.notify_one();
+    Command cmd;
+    cmd.type = Command::Type::insert;
+    cmd.id = id;
+    cmd.tp = ClockType::now() + wait_for;
+    cmd.dt = (scheme == Launch::once ? 0 : std::chrono::duration_cast<std::chrono::milliseconds>(wait_for).count());
+    cmd.replace = replace_existing;
+    cmd.proc = proc;
+    Submit(std::move(cmd));
+    // a duplicated schedule rejected by the worker owns the same id anyway
     return id;
 }
 
 bool CallsQueueScheduler::Remove(CallsQueueScheduler::CallTag id) {
-    {
-        std::lock_guard<std::mutex> l(_mtx_queue);
-        // rollback last counter increment
-        auto it_sync = _exe_sync.find(id);
-        if (it_sync != _exe_sync.end()) {
-            it_sync->second.queued = it_sync->second.done;
-        }
-        auto it = std::find(_queue.cbegin(), _queue.cend(), id);
-        if (it == _queue.cend()) {
-            return false;
-        }
-        _queue.erase(it);
-    }
-    // awake worker thread to re-schedule its waiting
-    _flag = true;
-    _signal.notify_one();
+    Command cmd;
+    cmd.type = Command::Type::remove;
+    cmd.id = id;
+    Submit(std::move(cmd));
     return true;
 }
 
 void CallsQueueScheduler::RemoveAll() {
-    {
-        std::lock_guard<std::mutex> l(_mtx_queue);
-        _queue.clear();
-        for (auto& sync : _exe_sync) {
-            // rollback last counter increment
-            sync.second.queued = sync.second.done;
-        }
-    }
-    // awake worker thread to re-schedule its waiting
-    _flag = true;
-    _signal.notify_one();
+    Command cmd;
+    cmd.type = Command::Type::remove_all;
+    Submit(std::move(cmd));
 }
 
 void CallsQueueScheduler::Clear() {
-    {
-        std::lock_guard<std::mutex> l(_mtx_queue);
-        _queue.clear();
-        _exe_sync.clear();
-    }
-    // awake worker thread to re-schedule its waiting
-    _flag = true;
-    _signal.notify_one();
+    Command cmd;
+    cmd.type = Command::Type::clear;
+    Submit(std::move(cmd));
 }
@@ -60,6 +60,26 @@ const uint32_t Consensus::TimeRound = 2000;
 /** @brief   Max timeout (msec) to wait stages (Trusted-2,3) */
 const uint32_t Consensus::TimeStageRequest = 2000;
 
+/** @brief   Upper bound (msec) for the adaptive stage timeout */
+const uint32_t Consensus::TimeStageRequestMax = 8000;
+
+uint32_t Consensus::stageTimeout(size_t roundP95Ms, size_t samples) {
+    // too few measured rounds to trust the distribution
+    constexpr size_t kMinSamples = 16;
+    if (samples < kMinSamples || roundP95Ms == 0) {
+        return TimeStageRequest;
+    }
+
+    size_t withMargin = roundP95Ms + roundP95Ms / 4;
+    if (withMargin < TimeStageRequest) {
+        withMargin = TimeStageRequest;
+    }
+    if (withMargin > TimeStageRequestMax) {
+        withMargin = TimeStageRequestMax;
+    }
+    return static_cast<uint32_t>(withMargin);
+}
+
 /** @brief   Max subround delta */
 const uint8_t Consensus::MaxSubroundDelta = 10;
 
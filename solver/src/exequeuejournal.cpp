@@ -0,0 +1,136 @@
+#include <exequeuejournal.hpp>
+
+#include <algorithm>
+
+#include <csnode/datastream.hpp>
+
+#include <lib/system/logger.hpp>
+
+static const std::string dbPath = "/exequeuedb";
+
+namespace {
+const char* kLogPrefix = "ExeQueueJournal: ";
+}
+
+cs::ExeQueueJournal::ExeQueueJournal(const std::string& path)
+: db_(path + dbPath) {
+    initialization();
+}
+
+cs::ExeQueueJournal::~ExeQueueJournal() {
+    db_.close();
+}
+
+void cs::ExeQueueJournal::initialization() {
+    cs::Connector::connect(&db_.failed, this, &cs::ExeQueueJournal::onFailed);
+
+    db_.setMapSize(cs::Lmdb::Default1GbMapSize);
+    db_.open();
+}
+
+void cs::ExeQueueJournal::upsert(uint64_t id, const cs::Bytes& item) {
+    append(kUpsertTag, id, item);
+}
+
+void cs::ExeQueueJournal::erase(uint64_t id) {
+    append(kEraseTag, id, cs::Bytes{});
+}
+
+void cs::ExeQueueJournal::append(cs::Byte tag, uint64_t id, const cs::Bytes& item) {
+    cs::Bytes record;
+    cs::ODataStream os(record);
+    os << tag;
+    os << id;
+    os << item;
+
+    db_.insert(makeKey(nextRecord_++), record);
+}
+
+std::vector<std::pair<uint64_t, cs::Bytes>> cs::ExeQueueJournal::restore() {
+    std::vector<std::pair<uint64_t, cs::Bytes>> items;
+
+    if (db_.isEmpty()) {
+        nextRecord_ = 1;
+        return items;
+    }
+
+    const cs::Bytes firstKey = db_.first<cs::Bytes, cs::Bytes>().first;
+    const cs::Bytes lastKey = db_.last<cs::Bytes, cs::Bytes>().first;
+
+    if (firstKey.size() != sizeof(uint64_t) || lastKey.size() != sizeof(uint64_t)) {
+        cswarning() << kLogPrefix << "unexpected journal key layout, journal dropped";
+        rebuild({});
+        return items;
+    }
+
+    const uint64_t last = decodeKey(lastKey);
+
+    // record keys are dense by construction, a plain key walk replaces the
+    // cursor iteration the lmdb wrapper does not expose
+    for (uint64_t sequence = decodeKey(firstKey); sequence <= last; ++sequence) {
+        const cs::Bytes key = makeKey(sequence);
+
+        if (!db_.isKeyExists(key)) {
+            continue;
+        }
+
+        cs::Bytes record = db_.value<cs::Bytes>(key);
+        cs::IDataStream is(record.data(), record.size());
+
+        cs::Byte tag = kUpsertTag;
+        uint64_t id = 0;
+        cs::Bytes item;
+        is >> tag;
+        is >> id;
+        is >> item;
+
+        auto it = std::find_if(items.begin(), items.end(), [id](const auto& pair) {
+            return pair.first == id;
+        });
+
+        if (tag == kEraseTag) {
+            if (it != items.end()) {
+                items.erase(it);
+            }
+        }
+        else if (it != items.end()) {
+            // the item keeps its queue position, only the payload is newer
+            it->second = std::move(item);
+        }
+        else {
+            items.emplace_back(id, std::move(item));
+        }
+    }
+
+    rebuild(items);
+    return items;
+}
+
+void cs::ExeQueueJournal::rebuild(const std::vector<std::pair<uint64_t, cs::Bytes>>& items) {
+    if (!db_.isEmpty()) {
+        const cs::Bytes firstKey = db_.first<cs::Bytes, cs::Bytes>().first;
+        const cs::Bytes lastKey = db_.last<cs::Bytes, cs::Bytes>().first;
+
+        if (firstKey.size() == sizeof(uint64_t) && lastKey.size() == sizeof(uint64_t)) {
+            const uint64_t last = decodeKey(lastKey);
+
+            for (uint64_t sequence = decodeKey(firstKey); sequence <= last; ++sequence) {
+                db_.remove(makeKey(sequence));
+            }
+        }
+    }
+
+    nextRecord_ = 1;
+
+    for (const auto& [id, item] : items) {
+        upsert(id, item);
+    }
+}
+
+size_t cs::ExeQueueJournal::size() const {
+    return db_.size();
+}
+
+void cs::ExeQueueJournal::onFailed(const cs::LmdbException& exception) {
+    cswarning() << kLogPrefix << "database error: " << exception.what();
+}
@@ -1,7 +1,14 @@
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <utility>
+
 #include <smartconsensus.hpp>
 #include <smartcontracts.hpp>
 
+#include <lib/system/concurrent.hpp>
+
 #pragma warning(push)
 #pragma warning(disable : 4267 4244 4100 4245)
 #include <csnode/node.hpp>
@@ -367,10 +374,9 @@ void SmartConsensus::addSmartStageTwo(cs::StageTwoSmarts& stage, bool send) {
     if (stageTwo.sender == stage.sender) {
         return;
     }
-    // stageTwo = stage;
+    stageTwo = stage;
     std::string stagesPlot;
     for (size_t i = 0; i < smartConfidants_.size(); ++i) {
-        smartStageTwoStorage_.at(stage.sender) = stage;
         stagesPlot = stagesPlot + '[' + std::to_string(static_cast<int>(smartStageTwoStorage_.at(i).sender)) + "] ";
     }
     csdebug() << kLogPrefix << FormatRef{ smartRoundNumber_, smartTransaction_ }
@@ -461,13 +467,56 @@ void SmartConsensus::processStages() {
     csdebug() << kLogPrefix << FormatRef{ smartRoundNumber_, smartTransaction_ } << " hash "
         << cs::Utils::byteStreamToHex(finHash.data(), finHash.size()) << ", count = " << maxFreq;
     auto& myStage2 = smartStageTwoStorage_.at(ownSmartsConfNum_);
+
+    // with n confidants the walk below may demand up to n*n signature checks;
+    // verify all diverging signatures on the thread pool first, then consume
+    // the cached verdicts serially, so consensus CPU grows with the number of
+    // divergences instead of burning this thread one check at a time
+    std::vector<std::pair<size_t, size_t>> pendingChecks; // stage index, confidant index
+    for (size_t s = 0; s < smartStageTwoStorage_.size(); ++s) {
+        const auto& st = smartStageTwoStorage_[s];
+        if (st.sender == ownSmartsConfNum_) {
+            continue;
+        }
+        for (size_t i = 0; i < cnt; ++i) {
+            if (st.signatures[i] != myStage2.signatures[i]) {
+                pendingChecks.emplace_back(s, i);
+            }
+        }
+    }
+
+    std::vector<uint8_t> checkResults(pendingChecks.size(), 0);
+
+    if (!pendingChecks.empty()) {
+        std::atomic<size_t> jobsLeft{pendingChecks.size()};
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+
+        for (size_t job = 0; job < pendingChecks.size(); ++job) {
+            boost::asio::post(cs::ThreadPool::instance(), [&, job] {
+                const auto [s, i] = pendingChecks[job];
+                const auto& st = smartStageTwoStorage_[s];
+                checkResults[job] = cscrypto::verifySignature(st.signatures[i], smartConfidants_[i], st.hashes[i].data(), sizeof(st.hashes[i])) ? 1 : 0;
+
+                if (jobsLeft.fetch_sub(1) == 1) {
+                    std::unique_lock<std::mutex> lock(doneMutex);
+                    doneCondition.notify_one();
+                }
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCondition.wait(lock, [&] { return jobsLeft.load() == 0; });
+    }
+
+    size_t nextCheck = 0;
     for (auto& st : smartStageTwoStorage_) {
         if (st.sender == ownSmartsConfNum_) {
             continue;
         }
         for (size_t i = 0; i < cnt; ++i) {
             if (st.signatures[i] != myStage2.signatures[i]) {
-                if (cscrypto::verifySignature(st.signatures[i], smartConfidants_[i], st.hashes[i].data(), sizeof(st.hashes[i]))) {
+                if (checkResults[nextCheck++] != 0) {
                     ++(smartUntrusted.at(i));
                     if (st.hashes[i] == Zero::hash) {
                         cslog() << kLogPrefix << "Confidant [" << i << "] is marked as untrusted (zero hash) - possibly silent";
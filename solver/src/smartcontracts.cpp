@@ -1,4 +1,5 @@
 #include <smartcontracts.hpp>
+#include <exequeuejournal.hpp>
 #include <solvercontext.hpp>
 
 #include <ContractExecutor.h>
@@ -17,7 +18,9 @@
 #include <lib/system/logger.hpp>
 
 #include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <sstream>
@@ -126,6 +129,79 @@ namespace {
         set_return_value(new_state_transaction, variant);
     }
 
+    // LRU of the most recently stored/queried contract states. States of busy tokens run to
+    // megabytes, so repeated get_contract_state() queries and the freshness test in
+    // dbcache_update() must not re-read and re-decode the whole blob from contracts.db every
+    // time. Entry validity is tracked by the new_state reference stored along with the state:
+    // the cached ref always mirrors the record most recently written to (or read from) the db.
+    // The cache is deliberately shallow to bound memory held by large states
+    class ContractStateLru {
+    public:
+        constexpr static size_t kMaxEntries = 16;
+
+        bool get(const csdb::Address& abs_addr, cs::SmartContractRef& ref, std::string& state) {
+            cs::Lock lock(mux_);
+            const auto it = index_.find(abs_addr);
+            if (it == index_.end()) {
+                return false;
+            }
+            order_.splice(order_.begin(), order_, it->second);
+            ref = it->second->second.ref;
+            state = it->second->second.state;
+            return true;
+        }
+
+        // cheap variant of get() to test entry freshness without copying the state
+        bool getRef(const csdb::Address& abs_addr, cs::SmartContractRef& ref) {
+            cs::Lock lock(mux_);
+            const auto it = index_.find(abs_addr);
+            if (it == index_.end()) {
+                return false;
+            }
+            ref = it->second->second.ref;
+            return true;
+        }
+
+        void put(const csdb::Address& abs_addr, const cs::SmartContractRef& ref, const std::string& state) {
+            cs::Lock lock(mux_);
+            const auto it = index_.find(abs_addr);
+            if (it != index_.end()) {
+                order_.splice(order_.begin(), order_, it->second);
+                it->second->second = Entry{ref, state};
+                return;
+            }
+            order_.emplace_front(abs_addr, Entry{ref, state});
+            index_[abs_addr] = order_.begin();
+            if (order_.size() > kMaxEntries) {
+                index_.erase(order_.back().first);
+                order_.pop_back();
+            }
+        }
+
+        void erase(const csdb::Address& abs_addr) {
+            cs::Lock lock(mux_);
+            const auto it = index_.find(abs_addr);
+            if (it != index_.end()) {
+                order_.erase(it->second);
+                index_.erase(it);
+            }
+        }
+
+    private:
+        struct Entry {
+            cs::SmartContractRef ref;
+            std::string state;
+        };
+
+        using Order = std::list<std::pair<csdb::Address, Entry>>;
+
+        Order order_;
+        std::map<csdb::Address, Order::iterator> index_;
+        std::mutex mux_;
+    };
+
+    ContractStateLru stateLru;
+
 }
 
 namespace cs {
@@ -209,6 +285,12 @@ void SmartContracts::init(const cs::PublicKey& id, Node* node) {
         exec_handler_ptr = connector_ptr->apiExecHandler();
     }
     node_id = id;
+
+    // the journal survives hard restarts, unlike the quick-start snapshot
+    // which is written on graceful shutdown only; same caches root as the
+    // blockchain side databases
+    pjournal = std::make_unique<cs::ExeQueueJournal>("./caches");
+    restore_exe_queue();
 }
 
 /*public*/
@@ -284,6 +366,11 @@ bool SmartContracts::is_executable(const csdb::Transaction& tr) {
     }
     // to contain smart contract trx must contain either FLD[0] (deploy, start) or FLD[-2] (new_state), both of type
     // "String":
+    // cheap presence probe first: the overwhelming majority of transactions
+    // carry no contract marker at all and never need their fields decoded
+    if (!tr.contains_user_field(trx_uf::deploy::Code) && !tr.contains_user_field(trx_uf::start::Methods)) {
+        return false;
+    }
     csdb::UserField f = tr.user_field(trx_uf::deploy::Code);
     if constexpr (trx_uf::deploy::Code != trx_uf::start::Methods) {
         if (!f.is_valid()) {
@@ -325,6 +412,10 @@ bool SmartContracts::is_new_state(const csdb::Transaction& tr) {
     }
     // must contain user field new_state::Value and new_state::RefStart
     using namespace cs::trx_uf;
+    if (!tr.contains_user_field(new_state::RefStart)) {
+        // ordinary transaction, bail out before any field is materialized
+        return false;
+    }
     // test user_field[RefStart] helps filter out ancient smart contracts:
     if (tr.user_field(new_state::RefStart).type() != csdb::UserField::Type::String) {
         return false;
@@ -419,8 +510,14 @@ std::string SmartContracts::get_contract_state(const BlockChain& storage, const
     //csdebug() << kLogPrefix << __func__;
     SmartContractRef dummy;
     std::string state;
+    if (stateLru.get(abs_addr, dummy, state)) {
+        return state;
+    }
     // no matter which value is returned:
     /*bool ok =*/ SmartContracts::dbcache_read(storage, abs_addr, dummy, state);
+    if (!state.empty()) {
+        stateLru.put(abs_addr, dummy, state);
+    }
     cscrypto::Bytes st1(state.data(), state.data() + state.size());
     //csdebug() << kLogPrefix << __func__ << " state from dbcache: " << cs::Utils::byteStreamToHex(st1);
     return state;
@@ -709,6 +806,7 @@ void SmartContracts::enqueue(const csdb::Pool& block, size_t trx_idx, bool skip_
 
     update_status(*it, new_item.sequence, SmartContractStatus::Waiting, skip_log);
     it->is_executor = contains_me(block.confidants());
+    journal_store(*it);
 }
 
 void SmartContracts::test_exe_queue(bool reading_db) {
@@ -1392,6 +1490,9 @@ void SmartContracts::on_read_block(const csdb::Pool& block, bool* should_stop) {
             }
         }
         csdebug() << kLogPrefix << "finish reading DB, " << WithDelimiters(known_contracts.size()) << " contracts were loaded";
+        reading_blocks = false;
+        // replay may have altered the queue while the journal was muted
+        journal_resync();
     }
 }
 
@@ -1833,6 +1934,7 @@ SmartContracts::queue_iterator SmartContracts::remove_from_queue(SmartContracts:
         if (it->status == SmartContractStatus::Canceled) {
             update_lock_status(*it, false, skip_log);
         }
+        journal_erase(*it);
         it = exe_queue.erase(it);
 
         if (!skip_log) {
@@ -1879,6 +1981,10 @@ void SmartContracts::remove_from_queue(const SmartContractRef& item, bool skip_l
         update_lock_status(it->abs_addr, false, skip_log);
         remove_from_queue(it, skip_log);
     }
+    else {
+        // the item stays with one execution less
+        journal_store(*it);
+    }
 }
 
 bool SmartContracts::execute(SmartExecutionData& data, bool validationMode) {
@@ -3008,6 +3114,62 @@ void SmartContracts::update_status(QueueItem& item, cs::RoundNumber r, SmartCont
         default:
             break;
     }
+
+    journal_store(item);
+}
+
+void SmartContracts::journal_store(QueueItem& item) {
+    if (!pjournal || reading_blocks) {
+        return;
+    }
+    if (item.journal_id == 0) {
+        item.journal_id = next_journal_id++;
+    }
+    pjournal->upsert(item.journal_id, item.to_bytes());
+}
+
+void SmartContracts::journal_erase(const QueueItem& item) {
+    if (!pjournal || reading_blocks) {
+        return;
+    }
+    if (item.journal_id != 0) {
+        pjournal->erase(item.journal_id);
+    }
+}
+
+void SmartContracts::restore_exe_queue() {
+    if (!pjournal) {
+        return;
+    }
+    auto items = pjournal->restore();
+    if (!exe_queue.empty()) {
+        // the quick-start snapshot has already delivered the queue, it wins
+        journal_resync();
+        return;
+    }
+    for (auto& [id, payload] : items) {
+        QueueItem item = QueueItem::from_bytes(payload);
+        item.journal_id = id;
+        exe_queue.push_back(item);
+        next_journal_id = std::max(next_journal_id, id + 1);
+    }
+    if (!exe_queue.empty()) {
+        cslog() << kLogPrefix << "restored " << exe_queue.size() << " execution queue item(s) from journal";
+    }
+}
+
+void SmartContracts::journal_resync() {
+    if (!pjournal) {
+        return;
+    }
+    std::vector<std::pair<uint64_t, Bytes>> items;
+    for (auto& item : exe_queue) {
+        if (item.journal_id == 0) {
+            item.journal_id = next_journal_id++;
+        }
+        items.emplace_back(item.journal_id, item.to_bytes());
+    }
+    pjournal->rebuild(items);
 }
 
 void SmartContracts::test_contracts_locks() {
@@ -3074,12 +3236,19 @@ void SmartContracts::update_lock_status(const csdb::Address& abs_addr, bool valu
 bool SmartContracts::dbcache_update(const BlockChain& blockchain, const csdb::Address& abs_addr, const SmartContractRef& ref_start, const std::string& state, bool force_update) {
     //csdebug() << kLogPrefix << __func__;
     if (!force_update) {
-        // test if new data is actually newer than stored data
-        cs::Bytes current_data;
-        if (blockchain.getContractData(abs_addr, current_data)) {
-            cs::IDataStream stream(current_data.data(), current_data.size());
-            SmartContractRef current_ref;
-            stream >> current_ref.sequence >> current_ref.transaction;
+        // test if new data is actually newer than stored data; the lru mirrors the last record
+        // written to db, so a hot contract does not require re-reading the whole blob
+        SmartContractRef current_ref;
+        bool have_current = stateLru.getRef(abs_addr, current_ref);
+        if (!have_current) {
+            cs::Bytes current_data;
+            if (blockchain.getContractData(abs_addr, current_data)) {
+                cs::IDataStream stream(current_data.data(), current_data.size());
+                stream >> current_ref.sequence >> current_ref.transaction;
+                have_current = true;
+            }
+        }
+        if (have_current) {
             if (current_ref.sequence > ref_start.sequence) {
                 csdebug() << kLogPrefix << "contract state from " << current_ref << " was stored, ignore " << ref_start;
                 return false;
@@ -3099,7 +3268,11 @@ bool SmartContracts::dbcache_update(const BlockChain& blockchain, const csdb::Ad
     cs::Bytes data;
     cs::ODataStream stream(data);
     stream << ref_start.sequence << ref_start.transaction << state;
-    return blockchain.updateContractData(abs_addr, data);
+    if (!blockchain.updateContractData(abs_addr, data)) {
+        return false;
+    }
+    stateLru.put(abs_addr, ref_start, state);
+    return true;
 }
 
 /*static*/
@@ -3187,6 +3360,7 @@ size_t SmartContracts::validateRestoredStatesAgainstChain(BlockChain& blockchain
             item.ref_state   = SmartContractRef{};
             item.state.clear();
             blockchain.updateContractData(abs_addr, cs::Bytes{});
+            stateLru.erase(abs_addr);
             ++invalidated_tx_missing;
             continue;
         }
@@ -3207,6 +3381,7 @@ size_t SmartContracts::validateRestoredStatesAgainstChain(BlockChain& blockchain
                 item.ref_state   = SmartContractRef{};
                 item.state.clear();
                 blockchain.updateContractData(abs_addr, cs::Bytes{});
+                stateLru.erase(abs_addr);
                 ++invalidated_hash_mismatch;
             } else {
                 ++verified;
@@ -3225,6 +3400,7 @@ size_t SmartContracts::validateRestoredStatesAgainstChain(BlockChain& blockchain
                 item.ref_state   = SmartContractRef{};
                 item.state.clear();
                 blockchain.updateContractData(abs_addr, cs::Bytes{});
+                stateLru.erase(abs_addr);
                 ++invalidated_hash_mismatch;
             } else {
                 ++verified;
@@ -1,4 +1,5 @@
 #include "solvercontext.hpp"
+#include "consensus.hpp"
 #include "smartcontracts.hpp"
 #include "solvercore.hpp"
 
@@ -17,6 +18,11 @@ BlockChain& SolverContext::blockchain() const {
     return core.pnode->getBlockChain();
 }
 
+uint32_t SolverContext::stageTimeout() const {
+    const auto& stat = core.pnode->roundStat();
+    return Consensus::stageTimeout(stat.roundDurationPercentile(95.0), stat.perfRecordsCount());
+}
+
 std::string SolverContext::sender_description(const cs::PublicKey& sender_id) {
     // either RVO or string's move constructor used:
     return core.pnode->getSenderText(sender_id);
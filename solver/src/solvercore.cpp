@@ -9,6 +9,7 @@
 #include <csnode/node.hpp>
 #pragma warning(pop)
 
+#include <csnode/configholder.hpp>
 #include <csnode/datastream.hpp>
 #include <csnode/walletsstate.hpp>
 #include <lib/system/logger.hpp>
@@ -65,6 +66,13 @@ SolverCore::SolverCore()
 , psmarts(nullptr)
 
 /*, smartProcess_(this)*/ {
+    // stage storages never outgrow the trusted list, one up-front reservation
+    // keeps the vectors themselves off the allocator during consensus rounds
+    stageOneStorage.reserve(Consensus::MaxTrustedNodes);
+    stageTwoStorage.reserve(Consensus::MaxTrustedNodes);
+    stageThreeStorage.reserve(Consensus::MaxTrustedNodes);
+    trueStageThreeStorage.reserve(Consensus::MaxTrustedNodes);
+
     if constexpr (MonitorModeOn) {
         cslog() << log_prefix << "opt_monitor_mode is on, so use special transition table";
         InitMonitorModeTransitions();
@@ -89,6 +97,12 @@ SolverCore::SolverCore(Node* pNode, csdb::Address GenesisAddress, csdb::Address
     addr_genesis = GenesisAddress;
     addr_start = StartAddress;
     pnode = pNode;
+    if (opt_mode == Mode::Default && cs::ConfigHolder::instance().config()->isObserverMode()) {
+        // observer boxes follow blocks only; the monitor table keeps the state
+        // machine in NormalState and never allocates the trusted-stage states
+        cslog() << log_prefix << "observer profile is on, switch to monitor transition table";
+        InitMonitorModeTransitions();
+    }
     auto& bc = pNode->getBlockChain();
     pws = std::make_unique<cs::WalletsState>(bc.getCacheUpdater());
     psmarts = std::make_unique<cs::SmartContracts>(bc, scheduler);
@@ -616,7 +630,7 @@ void SolverCore::spawn_next_round(const cs::PublicKeys& nodes, const cs::Packets
     cs::Bytes trustedList;
     cs::ODataStream tStream(trustedList);
     tStream << justCreatedRoundPackage_.roundTable().round;
-    tStream << justCreatedRoundPackage_.roundTable().confidants;
+    tStream << justCreatedRoundPackage_.roundTable().confidants.keys();
     if (!trustedList.empty()) {
         stage3.trustedHash = cscrypto::calculateHash(trustedList.data(), trustedList.size());
         stage3.trustedSignature = cscrypto::generateSignature(private_key, stage3.trustedHash.data(), stage3.trustedHash.size());
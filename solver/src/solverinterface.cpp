@@ -162,10 +162,10 @@ void SolverCore::nextRound(bool updateRound) {
         recv_hash.clear();
     }
     deferredBlock_ = csdb::Pool{};
-    stageOneStorage.clear();
-    stageTwoStorage.clear();
-    stageThreeStorage.clear();
-    trueStageThreeStorage.clear();
+    recycleStages(stageOneStorage, stageOnePool_);
+    recycleStages(stageTwoStorage, stageTwoPool_);
+    recycleStages(stageThreeStorage, stageThreePool_);
+    recycleStages(trueStageThreeStorage, stageThreePool_);
     trusted_candidates.clear();
     realTrustedChanged_ = false;
     tempRealTrusted_.clear();
@@ -220,7 +220,7 @@ void SolverCore::gotStageOne(const cs::StageOne& stage) {
     }
 
 
-    stageOneStorage.push_back(stage);
+    storeRecycled(stageOneStorage, stageOnePool_, stage);
     csdebug() << kLogPrefix_ << __func__ << ": <-- stage-1 [" << static_cast<int>(stage.sender) << "] = " << stageOneStorage.size();
 
     if (!pstate) {
@@ -277,7 +277,7 @@ void SolverCore::gotStageTwo(const cs::StageTwo& stage) {
         return;
     }
 
-    stageTwoStorage.push_back(stage);
+    storeRecycled(stageTwoStorage, stageTwoPool_, stage);
     csdebug() << kLogPrefix_ << __func__ << ": <-- stage-2 [" << static_cast<int>(stage.sender) << "] = " << stageTwoStorage.size();
 
     if (!pstate) {
@@ -357,7 +357,7 @@ void SolverCore::gotStageThree(const cs::StageThree& stage, const uint8_t flagg)
         // if (getRealTrusted()[stageFrom.sender] == cs::ConfidantConsts::InvalidConfidantIndex) {
         //  realTrustedSet(stageFrom.sender, cs::ConfidantConsts::FirstWriterIndex);
         //}
-        trueStageThreeStorage.emplace_back(stageFrom);
+        storeRecycled(trueStageThreeStorage, stageThreePool_, stageFrom);
         addRoundSignature(stageFrom);
         csdebug() << kLogPrefix_ << __func__ << ": StageThree from T[" << static_cast<int>(stageFrom.sender) << "] - final check ... passed!";
     };
@@ -373,7 +373,7 @@ void SolverCore::gotStageThree(const cs::StageThree& stage, const uint8_t flagg)
                     lamda(st, stage);
                 }
             }
-            trueStageThreeStorage.push_back(stage);
+            storeRecycled(trueStageThreeStorage, stageThreePool_, stage);
             addRoundSignature(stage);
             break;
 
@@ -385,7 +385,7 @@ void SolverCore::gotStageThree(const cs::StageThree& stage, const uint8_t flagg)
             break;
     }
 
-    stageThreeStorage.push_back(stage);
+    storeRecycled(stageThreeStorage, stageThreePool_, stage);
 
     csdebug() << kLogPrefix_ << __func__ << ": <-- stage-3 [" << static_cast<int>(stage.sender) << "] = " << stageThreeStorage.size() << " : " << trueStageThreeStorage.size();
 
@@ -445,12 +445,14 @@ void SolverCore::adjustStageThreeStorage() {
     std::vector<cs::StageThree> tmpStageThreeStorage;
     for (auto& it : stageThreeStorage) {
         if (it.iteration == currentStage3iteration_) {
-            tmpStageThreeStorage.push_back(it);
+            tmpStageThreeStorage.push_back(std::move(it));
+        }
+        else {
+            stageThreePool_.push_back(std::move(it));
         }
     }
-    stageThreeStorage.clear();
-    stageThreeStorage = tmpStageThreeStorage;
-    trueStageThreeStorage.clear();  // how to put the realTrusted value to the on-stage3
+    stageThreeStorage = std::move(tmpStageThreeStorage);
+    recycleStages(trueStageThreeStorage, stageThreePool_);  // how to put the realTrusted value to the on-stage3
     pnode->adjustStageThreeStorage();
 }
 
@@ -52,12 +52,13 @@ namespace cs {
     }
 
     uint8_t TrustedMask::trustedSize() {
-        return static_cast<uint8_t>(mask_.size() - std::count(mask_.cbegin(), mask_.cend(), cs::ConfidantConsts::InvalidConfidantIndex));
+        return trustedSize(mask_);
     }
 
     uint8_t TrustedMask::trustedSize(const std::vector<uint8_t>& mask)
     {
-        return static_cast<uint8_t>(mask.size() - std::count(mask.cbegin(), mask.cend(), cs::ConfidantConsts::InvalidConfidantIndex));
+        // same SWAR kernel the node side uses for the real trusted count
+        return static_cast<uint8_t>(cs::Utils::trustedByteCount(mask));
     }
 
     StageOne::StageOne() {
@@ -80,8 +81,7 @@ namespace cs {
         message.reserve(expectedMessageSize);
 
         cs::ODataStream stream(message);
-        stream << sender;
-        stream << hash;
+        stream.addFields(sender, hash);
         stream << trustedCandidates;
         stream << hashesCandidates;
         stream << roundTimeStamp;
@@ -141,12 +141,7 @@ namespace cs {
         message.reserve(stageSize);
 
         cs::ODataStream stream(message);
-        stream << sender;
-        stream << writer;
-        stream << iteration;
-        stream << blockSignature;
-        stream << roundSignature;
-        stream << trustedSignature;
+        stream.addFields(sender, writer, iteration, blockSignature, roundSignature, trustedSignature);
         stream << realTrustedMask;
     }
 
@@ -53,7 +53,7 @@ void TrustedStage2State::on(SolverContext& context) {
         csunused(TimerBaseId);
         SolverContext* pctx = &context;
 
-        auto dt = Consensus::TimeStageRequest;
+        auto dt = context.stageTimeout();
         // increase dt in case of large trx amount:
         cs::Conveyer& conveyer = cs::Conveyer::instance();
         const cs::Characteristic* characteristic = conveyer.characteristic(conveyer.currentRoundNumber());
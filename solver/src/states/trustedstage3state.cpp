@@ -82,7 +82,7 @@ void TrustedStage3State::on(SolverContext& context) {
 
         SolverContext* pctx = &context;
 
-        auto dt = 2 * Consensus::TimeStageRequest;
+        auto dt = 2 * context.stageTimeout();
         csdebug() << name() << ": start track timeout " << 0 << " ms of stages-2 received";
         timeout_request_stage.start(context.scheduler(), 0,  // no timeout
                                     // timeout #1 handler:
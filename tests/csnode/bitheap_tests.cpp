@@ -57,3 +57,51 @@ TEST(BeatHeap, BasicOperations) {
     ASSERT_EQ(heap.count(), 4);
 
 }
+
+TEST(BeatHeap, WordBoundaryShifts) {
+    using Heap = cs::BitHeap<int64_t, 1024>;
+    Heap heap;
+
+    // fill a pattern, then force shifts that are not multiples of the word size
+    heap.push(100);
+    for (int64_t v = 1; v < 100; v += 7) {
+        heap.push(v);
+    }
+    heap.push(100 + 63);
+    heap.push(100 + 64);
+    heap.push(100 + 65);
+
+    for (int64_t v = 1; v < 100; v += 7) {
+        ASSERT_TRUE(heap.contains(v)) << v;
+    }
+    ASSERT_TRUE(heap.contains(100));
+    ASSERT_TRUE(heap.contains(163));
+    ASSERT_TRUE(heap.contains(164));
+    ASSERT_EQ(heap.getGreatest(), 165);
+    ASSERT_FALSE(heap.contains(2));
+
+    // popping the greatest must skip the 62-bit gap down to 163 in one step
+    heap.pop(165);
+    heap.pop(164);
+    ASSERT_EQ(heap.getGreatest(), 163);
+    heap.pop(163);
+    ASSERT_EQ(heap.getGreatest(), 100);
+    ASSERT_EQ(heap.count(), size_t(1 + 99 / 7 + 1));
+}
+
+TEST(BeatHeap, ShiftBeyondWindowDropsHistory) {
+    using Heap = cs::BitHeap<int64_t, 1024>;
+    Heap heap;
+
+    heap.push(10);
+    heap.push(11);
+    heap.push(12);
+    // jump farther than the window: everything before it falls out
+    heap.push(5000);
+
+    ASSERT_EQ(heap.getGreatest(), 5000);
+    ASSERT_FALSE(heap.contains(11));
+    ASSERT_FALSE(heap.contains(12));
+    ASSERT_TRUE(heap.contains(5000));
+    ASSERT_EQ(heap.count(), size_t(1));
+}
@@ -0,0 +1,115 @@
+#define TESTING
+
+#include "gtest/gtest.h"
+
+#include <csnode/blockreadcache.hpp>
+
+#include <csdb/amount.hpp>
+#include <csdb/amount_commission.hpp>
+#include <csdb/currency.hpp>
+
+static csdb::Transaction createTestTransaction(const int64_t id, const uint8_t amount) {
+    cs::Signature sign{};
+    csdb::Transaction transaction{id,
+                                  csdb::Address::from_public_key(cs::PublicKey{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                                                               0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01}),
+                                  csdb::Address::from_public_key(cs::PublicKey{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                                                               0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02}),
+                                  csdb::Currency{amount},
+                                  csdb::Amount{0, 0},
+                                  csdb::AmountCommission{0.},
+                                  csdb::AmountCommission{0.},
+                                  sign};
+    return transaction;
+}
+
+static csdb::Pool createPool(cs::Sequence sequence) {
+    csdb::Pool pool;
+
+    pool.set_sequence(sequence);
+    pool.add_transaction(createTestTransaction(static_cast<int64_t>(sequence), 100));
+    pool.compose();
+
+    return pool;
+}
+
+static cs::BlockReadCache::RangeLoader makeLoader(size_t& calls) {
+    return [&calls](cs::Sequence from, size_t count) {
+        ++calls;
+        std::vector<csdb::Pool> result;
+        result.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            result.push_back(createPool(from + static_cast<cs::Sequence>(i)));
+        }
+
+        return result;
+    };
+}
+
+TEST(BlockReadCache, MissLoadsOnceThenHits) {
+    cs::BlockReadCache cache;
+    size_t calls = 0;
+    auto loader = makeLoader(calls);
+
+    auto pool = cache.get(5, loader);
+    ASSERT_TRUE(pool.is_valid());
+    ASSERT_EQ(pool.sequence(), 5U);
+    ASSERT_EQ(calls, 1U);
+
+    pool = cache.get(5, loader);
+    ASSERT_EQ(pool.sequence(), 5U);
+    ASSERT_EQ(calls, 1U);
+    ASSERT_EQ(cache.hits(), 1U);
+}
+
+TEST(BlockReadCache, SequentialWalkTriggersReadahead) {
+    cs::BlockReadCache cache;
+    size_t calls = 0;
+    auto loader = makeLoader(calls);
+
+    // four consecutive accesses make the run sequential, the fourth miss
+    // reads ahead and the rest of the walk never touches the loader
+    for (cs::Sequence sequence = 1; sequence <= 35; ++sequence) {
+        auto pool = cache.get(sequence, loader);
+        ASSERT_EQ(pool.sequence(), sequence);
+    }
+
+    ASSERT_EQ(calls, 4U);
+}
+
+TEST(BlockReadCache, EvictedPoolsAreServedFromCompressedLevel) {
+    cs::BlockReadCache cache;
+    size_t calls = 0;
+    auto loader = makeLoader(calls);
+
+    // long walk pushes the early pools out of the deserialized level
+    for (cs::Sequence sequence = 0; sequence < 200; ++sequence) {
+        cache.get(sequence, loader);
+    }
+
+    const size_t callsAfterWalk = calls;
+
+    auto pool = cache.get(2, loader);
+    ASSERT_TRUE(pool.is_valid());
+    ASSERT_EQ(pool.sequence(), 2U);
+    ASSERT_EQ(calls, callsAfterWalk);
+}
+
+TEST(BlockReadCache, InvalidateFromDropsTail) {
+    cs::BlockReadCache cache;
+    size_t calls = 0;
+    auto loader = makeLoader(calls);
+
+    cache.get(5, loader);
+    cache.get(10, loader);
+    const size_t callsBefore = calls;
+
+    cache.invalidateFrom(10);
+
+    cache.get(5, loader);
+    ASSERT_EQ(calls, callsBefore);
+
+    cache.get(10, loader);
+    ASSERT_EQ(calls, callsBefore + 1);
+}
@@ -56,6 +56,52 @@ TEST(Compressor, TestCompressByte) {
     ASSERT_EQ(byte, entity);
 }
 
+TEST(Compressor, DictionaryRoundTrip) {
+    cs::Bytes dictionary;
+
+    for (size_t i = 0; i < 1024; ++i) {
+        dictionary.push_back(static_cast<cs::Byte>(i % 251));
+    }
+
+    cs::Compressor producer;
+    producer.setDictionary(dictionary);
+
+    cs::Compressor consumer;
+    consumer.setDictionary(dictionary);
+
+    std::vector<size_t> data;
+
+    for (size_t i = 0; i < 100; ++i) {
+        data.push_back(i % 10);
+    }
+
+    auto region = producer.compress(data);
+    ASSERT_EQ(cs::Compressor::checkCompression(region), cs::Compressor::Compression::CompressedWithDictionary);
+
+    auto entity = consumer.decompress<std::vector<size_t>>(region);
+    ASSERT_EQ(data, entity);
+}
+
+TEST(Compressor, DictionaryMissingOnConsumer) {
+    cs::Bytes dictionary(1024, cs::Byte{ 0xAB });
+
+    cs::Compressor producer;
+    producer.setDictionary(dictionary);
+
+    std::vector<size_t> data;
+
+    for (size_t i = 0; i < 100; ++i) {
+        data.push_back(i % 10);
+    }
+
+    auto region = producer.compress(data);
+
+    // a consumer without the dictionary must fail gracefully
+    cs::Compressor consumer;
+    auto entity = consumer.decompress<std::vector<size_t>>(region);
+    ASSERT_TRUE(entity.empty());
+}
+
 TEST(SynchronizedCompressor, BaseSynchronizedCompressorUsage) {
     cs::SynchronizedCompressor compressor;
 
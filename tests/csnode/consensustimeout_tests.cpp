@@ -0,0 +1,21 @@
+#include <consensus.hpp>
+
+#include "gtest/gtest.h"
+
+TEST(ConsensusStageTimeout, FallsBackUntilEnoughRoundsMeasured) {
+    ASSERT_EQ(Consensus::stageTimeout(6000, 0), Consensus::TimeStageRequest);
+    ASSERT_EQ(Consensus::stageTimeout(6000, 15), Consensus::TimeStageRequest);
+    ASSERT_EQ(Consensus::stageTimeout(0, 100), Consensus::TimeStageRequest);
+}
+
+TEST(ConsensusStageTimeout, TracksPercentileWithMargin) {
+    // 4000 ms p95 + 25% margin
+    ASSERT_EQ(Consensus::stageTimeout(4000, 100), 5000U);
+}
+
+TEST(ConsensusStageTimeout, ClampedToProtocolLimits) {
+    // fast network never drops below the fixed constant
+    ASSERT_EQ(Consensus::stageTimeout(100, 100), Consensus::TimeStageRequest);
+    // congestion never pushes past the upper bound
+    ASSERT_EQ(Consensus::stageTimeout(60000, 100), Consensus::TimeStageRequestMax);
+}
@@ -174,6 +174,38 @@ TEST(Conveyer, RoundTableReturnsNullIfRoundWasNotAdded) {
     ASSERT_EQ(conveyer.roundTable(1), nullptr);
 }
 
+TEST(Conveyer, HashIndexMaskRoundTrip) {
+    ConveyerTest conveyer{};
+    cs::PacketsHashes tableHashes;
+
+    for (size_t i = 1; i <= 10; ++i) {
+        tableHashes.push_back(CreateTestPacket(i).hash());
+    }
+
+    auto round_table{CreateTestRoundTable(tableHashes)};
+    conveyer.setRound(round_table.round);
+    conveyer.setTable(round_table);
+
+    cs::PacketsHashes needed{tableHashes[1], tableHashes[4], tableHashes[9]};
+    auto mask = conveyer.makeHashIndexMask(kRoundNumber, needed);
+
+    ASSERT_TRUE(mask.has_value());
+    ASSERT_EQ(mask.value().size(), (tableHashes.size() + 7) / 8);
+    ASSERT_EQ(conveyer.resolveHashIndexMask(kRoundNumber, mask.value()), needed);
+
+    // wrong mask length must not be resolved against this table
+    cs::Bytes badMask(mask.value());
+    badMask.push_back(0);
+    ASSERT_TRUE(conveyer.resolveHashIndexMask(kRoundNumber, badMask).empty());
+
+    // a hash outside the table can not be encoded
+    cs::PacketsHashes foreign{CreateTestPacket(42).hash()};
+    ASSERT_FALSE(conveyer.makeHashIndexMask(kRoundNumber, foreign).has_value());
+
+    // unknown round has no table to index
+    ASSERT_FALSE(conveyer.makeHashIndexMask(kRoundNumber + 1, needed).has_value());
+}
+
 TEST(Conveyer, AddTransaction) {
     ConveyerTest conveyer{};
     auto transaction{CreateTestTransaction(3, 1)};
@@ -185,6 +217,14 @@ TEST(Conveyer, AddTransaction) {
     ASSERT_EQ(packet.toBinary(), transactions_block.back().toBinary());
 }
 
+TEST(Conveyer, RejectsDuplicateTransaction) {
+    ConveyerTest conveyer{};
+    auto transaction{CreateTestTransaction(3, 1)};
+    ASSERT_EQ(conveyer.addTransaction(transaction), cs::PacketQueue::PushResult::Added);
+    ASSERT_EQ(conveyer.addTransaction(transaction), cs::PacketQueue::PushResult::Duplicate);
+    ASSERT_EQ(1, conveyer.packetQueue().size());
+}
+
 TEST(Conveyer, TransactionPacketTableIsEmptyAtCreation) {
     constexpr auto size = 0;
     ConveyerTest conveyer{};
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include <limits>
 #include "datastream.hpp"
+#include "compressor.hpp"
 #include <lib/system/console.hpp>
 
 TEST(DataStream, DataPointerIsCorrectAfterCreation) {
@@ -38,6 +40,25 @@ TEST(DataStream, IsAvailableReturnsFalseIfRequestedTooMany) {
     ASSERT_FALSE(stream.isAvailable(9));
 }
 
+TEST(DataStream, IsAvailableDoesNotOverflowOnHugeSize) {
+    char data[8] = "1234567";
+    cs::IDataStream stream(data, sizeof data);
+    // index_ + size would wrap around and pass the naive check
+    ASSERT_FALSE(stream.isAvailable(std::numeric_limits<std::size_t>::max() - 4));
+}
+
+TEST(DataStream, ForgedVectorCountIsRejectedWithoutAllocation) {
+    cs::Bytes buffer;
+    cs::ODataStream out(buffer);
+    out << std::numeric_limits<std::size_t>::max();
+
+    cs::IDataStream stream(buffer.data(), buffer.size());
+    std::vector<cs::PublicKey> keys;
+    stream >> keys;
+
+    ASSERT_TRUE(keys.empty());
+}
+
 TEST(DataStream, MustGetCorrectStdArrayFromStream) {
     char data[8] = "1234567";
     cs::IDataStream stream(data, sizeof data);
@@ -165,3 +186,137 @@ TEST(DataStream, CorrectAmountSerialization) {
 
     ASSERT_TRUE(amount == expectedAmount);
 }
+
+TEST(DataStream, CompressedRegionViewIsParsedInPlace) {
+    cs::Bytes binary = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+    cs::CompressedRegion region { cs::Bytes(binary), binary.size() };
+
+    cs::Bytes bytes;
+    cs::ODataStream output(bytes);
+    output << region;
+
+    cs::IDataStream input(bytes.data(), bytes.size());
+
+    cs::CompressedRegionView view;
+    input >> view;
+
+    ASSERT_TRUE(input.isValid());
+    ASSERT_TRUE(input.isEmpty());
+    ASSERT_EQ(view.binarySize(), binary.size());
+    ASSERT_EQ(view.size(), binary.size());
+
+    // view points to the source buffer, no copy is made
+    ASSERT_EQ(view.data(), bytes.data() + (2 * sizeof(std::size_t)));
+}
+
+TEST(DataStream, CompressedRegionViewDecompressMatchesOwningRegion) {
+    cs::Bytes payload(1024, cs::Byte{0x2A});
+
+    cs::Compressor compressor;
+    cs::CompressedRegion region = compressor.compress(payload);
+
+    cs::CompressedRegionView view { region.data(), region.size(), region.binarySize() };
+
+    ASSERT_EQ(compressor.decompress<cs::Bytes>(view), payload);
+    ASSERT_EQ(compressor.decompress<cs::Bytes>(region), payload);
+}
+
+TEST(DataStream, FixedFieldPackMatchesFieldByFieldFormat) {
+    const uint8_t sender = 3;
+    const uint32_t round = 100500;
+    const std::array<uint8_t, 32> hash = { 0x01, 0x02, 0x03, 0x04 };
+
+    cs::Bytes fieldByField;
+    cs::ODataStream reference(fieldByField);
+    reference << sender;
+    reference << round;
+    reference << hash;
+
+    cs::Bytes packed;
+    cs::ODataStream stream(packed);
+    stream.addFields(sender, round, hash);
+
+    ASSERT_EQ(packed, fieldByField);
+}
+
+TEST(DataStream, FixedFieldPackRoundTrip) {
+    const uint8_t sender = 7;
+    const uint64_t id = 0xABCDEF0102030405ULL;
+    const std::array<uint8_t, 64> signature = { 0xAA, 0xBB, 0xCC };
+
+    cs::Bytes bytes;
+    cs::ODataStream output(bytes);
+    output.addFields(sender, id, signature);
+
+    cs::IDataStream input(bytes.data(), bytes.size());
+
+    uint8_t expectedSender = 0;
+    uint64_t expectedId = 0;
+    std::array<uint8_t, 64> expectedSignature = {0};
+    input.parseFields(expectedSender, expectedId, expectedSignature);
+
+    ASSERT_TRUE(input.isValid());
+    ASSERT_TRUE(input.isEmpty());
+    ASSERT_EQ(expectedSender, sender);
+    ASSERT_EQ(expectedId, id);
+    ASSERT_EQ(expectedSignature, signature);
+}
+
+TEST(DataStream, FixedFieldPackChecksAvailabilityOnce) {
+    cs::Bytes bytes = { 0x01, 0x02 };
+    cs::IDataStream input(bytes.data(), bytes.size());
+
+    uint8_t sender = 0;
+    uint64_t id = 0;
+    input.parseFields(sender, id);
+
+    // the whole pack does not fit, nothing is consumed
+    ASSERT_FALSE(input.isValid());
+    ASSERT_EQ(input.size(), bytes.size());
+    ASSERT_EQ(sender, 0);
+    ASSERT_EQ(id, 0u);
+}
+
+TEST(DataStream, ByteArrayVectorRoundTrip) {
+    std::vector<std::array<uint8_t, 32>> keys(3);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i].fill(static_cast<uint8_t>(i + 1));
+    }
+
+    cs::Bytes bytes;
+    cs::ODataStream output(bytes);
+    output << keys;
+
+    // count prefix plus the raw run of arrays, same as the element-wise format
+    ASSERT_EQ(bytes.size(), sizeof(std::size_t) + keys.size() * 32);
+
+    cs::IDataStream input(bytes.data(), bytes.size());
+
+    std::vector<std::array<uint8_t, 32>> parsed;
+    input >> parsed;
+
+    ASSERT_TRUE(input.isValid());
+    ASSERT_TRUE(input.isEmpty());
+    ASSERT_EQ(parsed, keys);
+}
+
+TEST(DataStream, ByteArrayVectorRejectsTruncatedRun) {
+    std::vector<std::array<uint8_t, 32>> keys(2);
+    keys[0].fill(0xAA);
+    keys[1].fill(0xBB);
+
+    cs::Bytes bytes;
+    cs::ODataStream output(bytes);
+    output << keys;
+
+    // cut into the middle of the second array
+    bytes.resize(bytes.size() - 16);
+
+    cs::IDataStream input(bytes.data(), bytes.size());
+
+    std::vector<std::array<uint8_t, 32>> parsed;
+    input >> parsed;
+
+    ASSERT_TRUE(parsed.empty());
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <csnode/packetqueue.hpp>
 
+#include <csdb/address.hpp>
+#include <csdb/amount.hpp>
+#include <csdb/transaction.hpp>
+
 const size_t kMaxPacketTransactions = 100;
 const size_t kMaxPacketsPerRound = 10;
 const size_t kMaxQueueSize = 100;
@@ -58,3 +62,144 @@ TEST(PacketQueue, popTransactionsBlocks) {
 
     ASSERT_EQ(queue.isEmpty(), true);
 }
+
+TEST(PacketQueue, pushBulkPackets) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+
+    std::vector<cs::TransactionsPacket> packets;
+
+    for (size_t i = 0; i < 5; ++i) {
+        cs::TransactionsPacket packet;
+        packet.addTransaction(csdb::Transaction{});
+        packets.push_back(packet);
+    }
+
+    queue.pushBulk(std::move(packets));
+
+    // 5 packets and one trailing separator
+    ASSERT_EQ(queue.size(), 6);
+    ASSERT_EQ(queue.transactionsCount(), 5);
+}
+
+TEST(PacketQueue, transactionsCountMaintainedByPushAndPop) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+    addTransactions(queue);
+
+    ASSERT_EQ(queue.transactionsCount(), (kMaxPacketTransactions * 2) + 1);
+
+    while (!queue.isEmpty()) {
+        queue.pop();
+    }
+
+    ASSERT_EQ(queue.transactionsCount(), 0);
+}
+
+TEST(PacketQueue, partialTailPacketIsHeldWithinCoalesceWindow) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+    queue.push(csdb::Transaction{});
+
+    // young partial tail stays queued, further singles keep joining it
+    auto held = queue.pop(std::chrono::hours{1});
+    ASSERT_TRUE(held.empty());
+    ASSERT_EQ(queue.transactionsCount(), 1);
+
+    // zero window flushes immediately, the pre-coalescing behaviour
+    auto flushed = queue.pop(std::chrono::milliseconds{0});
+    ASSERT_EQ(flushed.size(), 1);
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+TEST(PacketQueue, fullTailPacketIgnoresCoalesceWindow) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+
+    for (size_t i = 0; i < kMaxPacketTransactions; ++i) {
+        queue.push(csdb::Transaction{});
+    }
+
+    auto flushed = queue.pop(std::chrono::hours{1});
+    ASSERT_EQ(flushed.size(), 1);
+    ASSERT_EQ(flushed.front().transactionsCount(), kMaxPacketTransactions);
+}
+
+TEST(PacketQueue, floodingSourceIsRateLimitedUnderPressure) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+
+    auto result = cs::PacketQueue::PushResult::Added;
+    size_t accepted = 0;
+    const size_t hardLimit = kMaxQueueSize * kMaxPacketTransactions;
+
+    while (result == cs::PacketQueue::PushResult::Added && accepted < hardLimit) {
+        result = queue.push(csdb::Transaction{});
+
+        if (result == cs::PacketQueue::PushResult::Added) {
+            ++accepted;
+        }
+    }
+
+    // the per source cap fires under queue pressure, long before the queue
+    // itself fills up and starts turning everyone away
+    ASSERT_EQ(result, cs::PacketQueue::PushResult::SourceLimitReached);
+    ASSERT_LT(queue.size(), kMaxQueueSize);
+    ASSERT_EQ(queue.transactionsCount(), accepted);
+}
+
+static csdb::Transaction makeQueueTransaction(int64_t innerId) {
+    csdb::Transaction transaction;
+
+    auto source = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000008");
+    cs::PublicKey key;
+
+    transaction.set_target(csdb::Address::from_public_key(key));
+    transaction.set_source(source);
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(100, 0));
+    transaction.set_innerID(innerId);
+
+    return transaction;
+}
+
+TEST(PacketQueue, bytesCountMaintainedByPushAndPop) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+    ASSERT_EQ(queue.bytesCount(), 0u);
+
+    for (int64_t id = 1; id <= 10; ++id) {
+        queue.push(makeQueueTransaction(id));
+    }
+
+    ASSERT_GT(queue.bytesCount(), 0u);
+
+    while (!queue.isEmpty()) {
+        queue.pop();
+    }
+
+    ASSERT_EQ(queue.bytesCount(), 0u);
+}
+
+TEST(PacketQueue, fullMemoryPressureStopsAdmission) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+
+    queue.setMemoryPressure(100);
+    ASSERT_EQ(queue.push(makeQueueTransaction(1)), cs::PacketQueue::PushResult::QueueFull);
+    ASSERT_TRUE(queue.isEmpty());
+
+    // pressure released, the same transaction is admitted again
+    queue.setMemoryPressure(0);
+    ASSERT_EQ(queue.push(makeQueueTransaction(1)), cs::PacketQueue::PushResult::Added);
+}
+
+TEST(PacketQueue, memoryPressureEnablesSourceCaps) {
+    cs::PacketQueue queue = PacketCreator::create<PacketCreator::Default>();
+    queue.setMemoryPressure(60);
+
+    auto result = cs::PacketQueue::PushResult::Added;
+    int64_t id = 0;
+
+    while (result == cs::PacketQueue::PushResult::Added && id < int64_t(kMaxQueueSize * kMaxPacketTransactions)) {
+        result = queue.push(makeQueueTransaction(++id));
+    }
+
+    // the per source cap fires on memory pressure alone, the queue itself
+    // is nowhere near its fill based pressure level
+    ASSERT_EQ(result, cs::PacketQueue::PushResult::SourceLimitReached);
+    ASSERT_LT(queue.size() * 100, kMaxQueueSize * 50);
+}
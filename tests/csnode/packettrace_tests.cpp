@@ -0,0 +1,91 @@
+#include <cstdio>
+#include <fstream>
+
+#include <packettrace.hpp>
+
+#include "gtest/gtest.h"
+
+static cs::PublicKey makeSender(cs::Byte filler) {
+    cs::PublicKey key;
+    key.fill(filler);
+    return key;
+}
+
+static cs::Bytes makePayload(cs::Byte filler, size_t size) {
+    return cs::Bytes(size, filler);
+}
+
+TEST(PacketTrace, WriteLoadRoundTrip) {
+    const std::string path = "packettrace_test.dat";
+    const size_t recordsCount = 10;
+
+    {
+        PacketTraceWriter writer;
+        ASSERT_TRUE(writer.open(path, 1024 * 1024));
+
+        for (size_t i = 0; i < recordsCount; ++i) {
+            const auto payload = makePayload(static_cast<cs::Byte>(i), 100 + i);
+            writer.append(makeSender(static_cast<cs::Byte>(i)), payload.data(), payload.size());
+        }
+    }
+
+    const auto records = PacketTraceReader::load(path);
+
+    ASSERT_EQ(records.size(), recordsCount);
+
+    for (size_t i = 0; i < recordsCount; ++i) {
+        ASSERT_EQ(records[i].sender, makeSender(static_cast<cs::Byte>(i)));
+        ASSERT_EQ(records[i].packetBytes, makePayload(static_cast<cs::Byte>(i), 100 + i));
+
+        if (i != 0) {
+            ASSERT_GE(records[i].timestampUs, records[i - 1].timestampUs);
+        }
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(PacketTrace, RingWrapKeepsNewestRecords) {
+    const std::string path = "packettrace_wrap_test.dat";
+    const size_t payloadSize = 100;
+    const size_t recordsCount = 100;
+
+    {
+        PacketTraceWriter writer;
+
+        // room for roughly ten records, the rest must wrap over the oldest
+        ASSERT_TRUE(writer.open(path, 10 * (payloadSize + 64)));
+
+        for (size_t i = 0; i < recordsCount; ++i) {
+            const auto payload = makePayload(static_cast<cs::Byte>(i), payloadSize);
+            writer.append(makeSender(static_cast<cs::Byte>(i)), payload.data(), payload.size());
+        }
+    }
+
+    const auto records = PacketTraceReader::load(path);
+
+    ASSERT_FALSE(records.empty());
+    ASSERT_LT(records.size(), recordsCount);
+
+    // the survivors are the newest records and keep their arrival order
+    ASSERT_EQ(records.back().sender, makeSender(static_cast<cs::Byte>(recordsCount - 1)));
+
+    for (size_t i = 1; i < records.size(); ++i) {
+        ASSERT_GE(records[i].timestampUs, records[i - 1].timestampUs);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(PacketTrace, RejectsUnknownFormat) {
+    const std::string path = "packettrace_corrupt.dat";
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "definitely not a packet trace, but long enough to hold a header";
+    }
+
+    ASSERT_TRUE(PacketTraceReader::load(path).empty());
+
+    std::remove(path.c_str());
+}
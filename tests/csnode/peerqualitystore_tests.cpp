@@ -0,0 +1,69 @@
+#include <cstdio>
+#include <fstream>
+
+#include <peerqualitystore.hpp>
+
+#include "gtest/gtest.h"
+
+static cs::PublicKey makeKey(cs::Byte filler) {
+    cs::PublicKey key;
+    key.fill(filler);
+    return key;
+}
+
+TEST(PeerQualityStore, UpdateAndGet) {
+    PeerQualityStore store;
+    const auto peer = makeKey(1);
+
+    ASSERT_FALSE(store.get(peer).has_value());
+
+    store.updateLag(peer, 42);
+    store.updateSequence(peer, 100);
+    store.updateSequence(peer, 50);  // must not go backwards
+    store.registerBan(peer);
+
+    const auto quality = store.get(peer);
+
+    ASSERT_TRUE(quality.has_value());
+    ASSERT_EQ(quality->rttEwmaMs, 42U);
+    ASSERT_EQ(quality->lastSequence, 100U);
+    ASSERT_EQ(quality->banCount, 1U);
+}
+
+TEST(PeerQualityStore, SaveLoadRoundTrip) {
+    const std::string path = "peersquality_test.dat";
+
+    PeerQualityStore store;
+    store.updateLag(makeKey(1), 10);
+    store.updateLag(makeKey(2), 20);
+    store.updateSequence(makeKey(2), 777);
+    store.save(path);
+
+    PeerQualityStore restored;
+    restored.load(path);
+
+    ASSERT_EQ(restored.size(), 2U);
+
+    const auto quality = restored.get(makeKey(2));
+    ASSERT_TRUE(quality.has_value());
+    ASSERT_EQ(quality->rttEwmaMs, 20U);
+    ASSERT_EQ(quality->lastSequence, 777U);
+
+    std::remove(path.c_str());
+}
+
+TEST(PeerQualityStore, RejectsCorruptFile) {
+    const std::string path = "peersquality_corrupt.dat";
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "not a peer quality store";
+    }
+
+    PeerQualityStore store;
+    store.load(path);
+
+    ASSERT_EQ(store.size(), 0U);
+
+    std::remove(path.c_str());
+}
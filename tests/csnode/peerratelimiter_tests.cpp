@@ -0,0 +1,87 @@
+#include <peerratelimiter.hpp>
+
+#include "gtest/gtest.h"
+
+static cs::PublicKey makePeer(cs::Byte filler) {
+    cs::PublicKey key;
+    key.fill(filler);
+    return key;
+}
+
+TEST(PeerRateLimiter, ModerateTrafficStaysUnderLimit) {
+    PeerRateLimiter limiter;
+    const auto peer = makePeer(1);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(limiter.account(peer, 256));
+    }
+}
+
+TEST(PeerRateLimiter, ByteFloodTripsTheLimit) {
+    PeerRateLimiter limiter;
+    const auto peer = makePeer(2);
+
+    // 64 MB in one burst is twice the window budget
+    bool overLimit = false;
+    for (size_t i = 0; i < 64 && !overLimit; ++i) {
+        overLimit = limiter.account(peer, 1 << 20);
+    }
+
+    ASSERT_TRUE(overLimit);
+    // stays throttled while the flood continues
+    ASSERT_TRUE(limiter.account(peer, 1 << 20));
+}
+
+TEST(PeerRateLimiter, MessageFloodTripsTheLimit) {
+    PeerRateLimiter limiter;
+    const auto peer = makePeer(3);
+
+    bool overLimit = false;
+    for (size_t i = 0; i < 20000 && !overLimit; ++i) {
+        overLimit = limiter.account(peer, 1);
+    }
+
+    ASSERT_TRUE(overLimit);
+}
+
+TEST(PeerRateLimiter, PeersAreAccountedIndependently) {
+    PeerRateLimiter limiter;
+    const auto noisy = makePeer(4);
+    const auto quiet = makePeer(5);
+
+    for (size_t i = 0; i < 64; ++i) {
+        limiter.account(noisy, 1 << 20);
+    }
+
+    ASSERT_FALSE(limiter.account(quiet, 256));
+}
+
+TEST(PeerRateLimiter, StatsReflectAccountedTraffic) {
+    PeerRateLimiter limiter;
+    const auto peer = makePeer(7);
+
+    for (size_t i = 0; i < 10; ++i) {
+        limiter.account(peer, 100);
+    }
+
+    const auto stats = limiter.stats();
+    auto it = stats.find(peer);
+    ASSERT_NE(it, stats.end());
+    ASSERT_EQ(it->second.totalBytes, 1000U);
+    ASSERT_EQ(it->second.totalMessages, 10U);
+    ASSERT_EQ(it->second.windowBytes, 1000U);
+    ASSERT_FALSE(it->second.throttled);
+}
+
+TEST(PeerRateLimiter, RemoveForgetsTheWindow) {
+    PeerRateLimiter limiter;
+    const auto peer = makePeer(6);
+
+    for (size_t i = 0; i < 64; ++i) {
+        limiter.account(peer, 1 << 20);
+    }
+    ASSERT_TRUE(limiter.account(peer, 1));
+
+    limiter.remove(peer);
+    ASSERT_FALSE(limiter.account(peer, 256));
+}
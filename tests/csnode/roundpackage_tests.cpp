@@ -0,0 +1,89 @@
+#include <roundpackage.hpp>
+#include <nodecore.hpp>
+
+#include <consensus.hpp>
+
+#include "gtest/gtest.h"
+
+static cs::ConfidantsKeys makeConfidants(cs::Byte filler) {
+    cs::ConfidantsKeys confidants;
+
+    for (size_t i = 0; i < 4; ++i) {
+        cs::PublicKey key;
+        key.fill(static_cast<cs::Byte>(filler + i));
+        confidants.push_back(key);
+    }
+
+    return confidants;
+}
+
+static cs::RoundPackage makePackage(cs::RoundNumber round, const cs::ConfidantsKeys& confidants) {
+    cs::RoundTable table;
+    table.round = round;
+    table.confidants = confidants;
+
+    cs::PoolMetaInfo meta;
+    meta.sequenceNumber = round - 1;
+    meta.timestamp = "1234567890";
+    meta.realTrustedMask = cs::Bytes{ 0, 1, 2, 3 };
+    meta.characteristic.mask = cs::Bytes{ 1, 1, 0, 1 };
+
+    cs::RoundPackage package;
+    package.updateRoundTable(table);
+    package.updatePoolMeta(meta);
+
+    cs::Signatures signatures(confidants.size(), cs::Zero::signature);
+    package.updateRoundSignatures(signatures);
+    package.updatePoolSignatures(signatures);
+    package.updateTrustedSignatures(signatures);
+
+    return package;
+}
+
+TEST(RoundPackage, DeltaRoundTrip) {
+    const auto confidants = makeConfidants(1);
+
+    auto previous = makePackage(9, confidants);
+    auto current = makePackage(10, confidants);
+
+    auto bytes = current.toDeltaBinary(previous, true);
+
+    ASSERT_TRUE(cs::RoundPackage::isDelta(bytes));
+    ASSERT_LT(bytes.size(), current.toBinary(true).size());
+
+    cs::RoundPackage restored;
+
+    ASSERT_TRUE(restored.fromDeltaBinary(bytes, previous.roundTable().confidants, 10, 0));
+    ASSERT_EQ(restored.roundTable().confidants, confidants);
+    ASSERT_EQ(restored.poolMetaInfo().sequenceNumber, 9U);
+    ASSERT_EQ(restored.poolMetaInfo().timestamp, current.poolMetaInfo().timestamp);
+    ASSERT_EQ(restored.poolMetaInfo().characteristic.mask, current.poolMetaInfo().characteristic.mask);
+}
+
+TEST(RoundPackage, DeltaFallsBackToFullFormat) {
+    auto previous = makePackage(9, makeConfidants(1));
+    auto current = makePackage(10, makeConfidants(100));
+
+    // confidants changed, the delta representation degenerates to the full one
+    auto bytes = current.toDeltaBinary(previous, true);
+
+    ASSERT_FALSE(cs::RoundPackage::isDelta(bytes));
+
+    cs::RoundPackage restored;
+
+    ASSERT_TRUE(restored.fromBinary(bytes, 10, 0));
+    ASSERT_EQ(restored.roundTable().confidants, current.roundTable().confidants);
+}
+
+TEST(RoundPackage, DeltaRequiresPreviousConfidants) {
+    const auto confidants = makeConfidants(1);
+
+    auto previous = makePackage(9, confidants);
+    auto current = makePackage(10, confidants);
+
+    auto bytes = current.toDeltaBinary(previous, true);
+    ASSERT_TRUE(cs::RoundPackage::isDelta(bytes));
+
+    cs::RoundPackage restored;
+    ASSERT_FALSE(restored.fromDeltaBinary(bytes, cs::ConfidantsKeys{}, 10, 0));
+}
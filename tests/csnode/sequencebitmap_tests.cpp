@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include <csnode/sequencebitmap.hpp>
+
+TEST(SequenceBitmap, BasicOperations) {
+    cs::SequenceBitmap map;
+
+    ASSERT_EQ(map.count(), 0);
+    ASSERT_FALSE(map.contains(100));
+
+    map.insert(100);
+    map.insert(101);
+    map.insert(103);
+
+    ASSERT_EQ(map.count(), 3);
+    ASSERT_TRUE(map.contains(100));
+    ASSERT_TRUE(map.contains(101));
+    ASSERT_FALSE(map.contains(102));
+    ASSERT_TRUE(map.contains(103));
+
+    // duplicate insert must not inflate the counter
+    map.insert(101);
+    ASSERT_EQ(map.count(), 3);
+
+    ASSERT_EQ(map.nextClear(100), 102);
+    ASSERT_EQ(map.nextClear(102), 102);
+    ASSERT_EQ(map.nextClear(103), 104);
+
+    map.erase(101);
+    ASSERT_FALSE(map.contains(101));
+    ASSERT_EQ(map.count(), 2);
+    ASSERT_EQ(map.nextClear(100), 101);
+
+    map.clear();
+    ASSERT_EQ(map.count(), 0);
+    ASSERT_FALSE(map.contains(100));
+}
+
+TEST(SequenceBitmap, NextClearSkipsFullSummaryStrides) {
+    cs::SequenceBitmap map;
+
+    // a contiguous in-flight run spanning several summary strides
+    // (a stride covers 64 words * 64 bits = 4096 sequences)
+    const cs::Sequence first = 1000;
+    const cs::Sequence last = first + 3 * 4096 + 170;
+
+    for (cs::Sequence sequence = first; sequence <= last; ++sequence) {
+        map.insert(sequence);
+    }
+
+    ASSERT_EQ(map.count(), static_cast<size_t>(last - first + 1));
+    ASSERT_EQ(map.nextClear(first), last + 1);
+    ASSERT_EQ(map.nextClear(first + 4096), last + 1);
+    ASSERT_EQ(map.nextClear(last + 1), last + 1);
+
+    // punch a hole in the middle of a stride and find it again
+    map.erase(first + 2 * 4096 + 7);
+    ASSERT_EQ(map.nextClear(first), first + 2 * 4096 + 7);
+}
+
+TEST(SequenceBitmap, DiscardBelowSlidesWindow) {
+    cs::SequenceBitmap map;
+
+    for (cs::Sequence sequence = 0; sequence < 10000; ++sequence) {
+        map.insert(sequence);
+    }
+
+    map.discardBelow(8192);
+
+    // discarding trims whole strides, everything from the cut upwards survives
+    ASSERT_TRUE(map.contains(8192));
+    ASSERT_TRUE(map.contains(9999));
+    ASSERT_FALSE(map.contains(100));
+    ASSERT_EQ(map.nextClear(8192), 10000);
+
+    // sequences below the window read as clear and never reappear
+    map.insert(100);
+    ASSERT_FALSE(map.contains(100));
+}
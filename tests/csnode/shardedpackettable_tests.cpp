@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <csnode/shardedpackettable.hpp>
+
+#include <csdb/address.hpp>
+#include <csdb/transaction.hpp>
+
+static cs::TransactionsPacket makePacket(int64_t innerId) {
+    csdb::Transaction transaction;
+
+    auto startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000007");
+    cs::PublicKey key;
+
+    transaction.set_target(csdb::Address::from_public_key(key));
+    transaction.set_source(startAddress);
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(10000, 0));
+    transaction.set_innerID(innerId);
+
+    cs::TransactionsPacket packet;
+    packet.addTransaction(transaction);
+    packet.makeHash();
+
+    return packet;
+}
+
+TEST(ShardedPacketTable, EmptyState) {
+    cs::ShardedPacketTable table;
+
+    ASSERT_EQ(table.size(), 0u);
+    ASSERT_FALSE(table.contains(cs::TransactionsPacketHash()));
+}
+
+TEST(ShardedPacketTable, AppendAndFind) {
+    cs::ShardedPacketTable table;
+    cs::TransactionsPacket packet = makePacket(1);
+
+    ASSERT_TRUE(table.append(packet.hash(), packet));
+    ASSERT_FALSE(table.append(packet.hash(), packet));
+    ASSERT_EQ(table.size(), 1u);
+
+    auto found = table.find(packet.hash());
+    ASSERT_TRUE(found.has_value());
+    ASSERT_EQ(found->hash(), packet.hash());
+}
+
+TEST(ShardedPacketTable, RemoveAndClear) {
+    cs::ShardedPacketTable table;
+
+    for (int64_t id = 1; id <= 100; ++id) {
+        cs::TransactionsPacket packet = makePacket(id);
+        table.append(packet.hash(), packet);
+    }
+
+    ASSERT_EQ(table.size(), 100u);
+
+    cs::TransactionsPacket packet = makePacket(1);
+    ASSERT_TRUE(table.remove(packet.hash()));
+    ASSERT_FALSE(table.remove(packet.hash()));
+    ASSERT_EQ(table.size(), 99u);
+
+    table.clear();
+    ASSERT_EQ(table.size(), 0u);
+}
+
+TEST(ShardedPacketTable, ReserveKeepsContentIntact) {
+    cs::ShardedPacketTable table;
+
+    for (int64_t id = 1; id <= 64; ++id) {
+        cs::TransactionsPacket packet = makePacket(id);
+        table.append(packet.hash(), packet);
+    }
+
+    table.reserve(4096);
+
+    ASSERT_EQ(table.size(), 64u);
+
+    for (int64_t id = 1; id <= 64; ++id) {
+        ASSERT_TRUE(table.contains(makePacket(id).hash()));
+    }
+
+    // shrinking reservation requests are a no-op
+    table.reserve(0);
+    ASSERT_EQ(table.size(), 64u);
+}
+
+TEST(ShardedPacketTable, ForEachVisitsAllPackets) {
+    cs::ShardedPacketTable table;
+
+    for (int64_t id = 1; id <= 50; ++id) {
+        cs::TransactionsPacket packet = makePacket(id);
+        table.append(packet.hash(), packet);
+    }
+
+    size_t count = 0;
+
+    table.forEach([&](const cs::TransactionsPacketHash& hash, const cs::TransactionsPacket& packet) {
+        ASSERT_EQ(hash, packet.hash());
+        ++count;
+    });
+
+    ASSERT_EQ(count, table.size());
+}
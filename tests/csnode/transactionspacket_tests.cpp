@@ -222,6 +222,28 @@ TEST(TransactionsPacket, moveOperator) {
     ASSERT_EQ(copiedPacket.toBinary(), movedPacket.toBinary());
 }
 
+TEST(TransactionsPacket, incrementalHashMatchesFullSerialization) {
+    cs::TransactionsPacket packet;
+    packet.setExpiredRound(12345);
+
+    for (int64_t i = 0; i < 100; ++i) {
+        packet.addTransaction(makeTransaction(i));
+    }
+
+    packet.makeHash();
+
+    // filling through the non const transactions() accessor drops the
+    // incremental state, so this packet hashes via full re-serialization
+    const cs::TransactionsPacket& source = packet;
+
+    cs::TransactionsPacket reference;
+    reference.setExpiredRound(12345);
+    reference.transactions() = source.transactions();
+    reference.makeHash();
+
+    ASSERT_EQ(packet.hash(), reference.hash());
+}
+
 TEST(TransactionPacketHash, fromBinary) {
     auto startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000007");
 
@@ -245,3 +267,35 @@ TEST(TransactionPacketHash, fromBinary) {
 
     ASSERT_EQ(hash, packet.hash());
 }
+
+TEST(TransactionsPacket, transactionFingerprint) {
+    const auto first = makeTransaction(1);
+    const auto second = makeTransaction(2);
+
+    ASSERT_EQ(cs::TransactionsPacket::transactionFingerprint(first), cs::TransactionsPacket::transactionFingerprint(first));
+    ASSERT_NE(cs::TransactionsPacket::transactionFingerprint(first), cs::TransactionsPacket::transactionFingerprint(second));
+}
+
+TEST(TransactionsPacket, rebuildFromFingerprintsReproducesHash) {
+    // the digest reconciliation flow rebuilds a packet from transactions found by
+    // fingerprint, the result must reproduce the original hash byte for byte
+    cs::TransactionsPacket source;
+    source.setExpiredRound(4242);
+
+    for (int64_t i = 0; i < 10; ++i) {
+        source.addTransaction(makeTransaction(i));
+    }
+
+    source.makeHash();
+
+    cs::TransactionsPacket rebuilt;
+    rebuilt.setExpiredRound(source.expiredRound());
+    rebuilt.reserve(source.transactionsCount());
+
+    for (const auto& transaction : source.transactions()) {
+        rebuilt.addTransaction(transaction);
+    }
+
+    rebuilt.makeHash();
+    ASSERT_EQ(rebuilt.hash(), source.hash());
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <csnode/transactionspackettable.hpp>
+
+#include <csdb/address.hpp>
+#include <csdb/transaction.hpp>
+
+static cs::TransactionsPacket makeTablePacket(int64_t innerId) {
+    csdb::Transaction transaction;
+
+    auto startAddress = csdb::Address::from_string("0000000000000000000000000000000000000000000000000000000000000008");
+    cs::PublicKey key;
+
+    transaction.set_target(csdb::Address::from_public_key(key));
+    transaction.set_source(startAddress);
+    transaction.set_currency(1);
+    transaction.set_amount(csdb::Amount(10000, 0));
+    transaction.set_innerID(innerId);
+
+    cs::TransactionsPacket packet;
+    packet.addTransaction(transaction);
+    packet.makeHash();
+
+    return packet;
+}
+
+TEST(TransactionsPacketTable, EmptyState) {
+    cs::TransactionsPacketTable table;
+
+    ASSERT_EQ(table.size(), 0u);
+    ASSERT_TRUE(table.empty());
+    ASSERT_FALSE(table.contains(cs::TransactionsPacketHash()));
+    ASSERT_EQ(table.find(cs::TransactionsPacketHash()), nullptr);
+    ASSERT_TRUE(table.begin() == table.end());
+}
+
+TEST(TransactionsPacketTable, EmplaceAndFind) {
+    cs::TransactionsPacketTable table;
+    cs::TransactionsPacket packet = makeTablePacket(1);
+
+    ASSERT_TRUE(table.emplace(packet.hash(), packet).second);
+    ASSERT_FALSE(table.emplace(packet.hash(), packet).second);
+    ASSERT_EQ(table.size(), 1u);
+
+    const cs::TransactionsPacket* found = table.find(packet.hash());
+    ASSERT_NE(found, nullptr);
+    ASSERT_EQ(found->hash(), packet.hash());
+    ASSERT_EQ(table.at(packet.hash()).hash(), packet.hash());
+}
+
+TEST(TransactionsPacketTable, EraseRemovesFromLookupAndIteration) {
+    cs::TransactionsPacketTable table;
+
+    for (int64_t id = 1; id <= 50; ++id) {
+        cs::TransactionsPacket packet = makeTablePacket(id);
+        table.emplace(packet.hash(), packet);
+    }
+
+    ASSERT_EQ(table.size(), 50u);
+
+    cs::TransactionsPacket packet = makeTablePacket(1);
+    ASSERT_TRUE(table.erase(packet.hash()));
+    ASSERT_FALSE(table.erase(packet.hash()));
+    ASSERT_EQ(table.size(), 49u);
+    ASSERT_FALSE(table.contains(packet.hash()));
+
+    for (const auto& entry : table) {
+        ASSERT_NE(entry.first, packet.hash());
+    }
+}
+
+TEST(TransactionsPacketTable, IteratesInSortedHashOrder) {
+    cs::TransactionsPacketTable table;
+    table.reserve(100);
+
+    for (int64_t id = 1; id <= 100; ++id) {
+        cs::TransactionsPacket packet = makeTablePacket(id);
+        table.emplace(packet.hash(), packet);
+    }
+
+    std::vector<cs::TransactionsPacketHash> hashes;
+
+    for (const auto& [hash, packet] : table) {
+        ASSERT_EQ(packet.hash(), hash);
+        hashes.push_back(hash);
+    }
+
+    ASSERT_EQ(hashes.size(), table.size());
+    ASSERT_TRUE(std::is_sorted(hashes.begin(), hashes.end()));
+}
+
+TEST(TransactionsPacketTable, CopyKeepsSortedIteration) {
+    cs::TransactionsPacketTable table;
+
+    for (int64_t id = 1; id <= 20; ++id) {
+        cs::TransactionsPacket packet = makeTablePacket(id);
+        table.emplace(packet.hash(), packet);
+    }
+
+    cs::TransactionsPacketTable copy = table;
+    ASSERT_EQ(copy.size(), table.size());
+
+    auto original = table.begin();
+
+    for (const auto& entry : copy) {
+        ASSERT_EQ(entry.first, original->first);
+        ++original;
+    }
+}
+
+TEST(TransactionsPacketTable, ByteSizeFollowsEmplaceAndErase) {
+    cs::TransactionsPacketTable table;
+    ASSERT_EQ(table.byteSize(), 0u);
+
+    size_t expected = 0;
+
+    for (int64_t id = 1; id <= 10; ++id) {
+        cs::TransactionsPacket packet = makeTablePacket(id);
+        expected += packet.estimatedByteSize();
+        table.emplace(packet.hash(), packet);
+    }
+
+    ASSERT_EQ(table.byteSize(), expected);
+
+    // duplicates are rejected and must not be accounted twice
+    cs::TransactionsPacket duplicate = makeTablePacket(1);
+    table.emplace(duplicate.hash(), duplicate);
+    ASSERT_EQ(table.byteSize(), expected);
+
+    for (int64_t id = 1; id <= 10; ++id) {
+        table.erase(makeTablePacket(id).hash());
+    }
+
+    ASSERT_EQ(table.byteSize(), 0u);
+}
+
+TEST(TransactionsPacketTable, CopyKeepsByteSize) {
+    cs::TransactionsPacketTable table;
+
+    for (int64_t id = 1; id <= 5; ++id) {
+        cs::TransactionsPacket packet = makeTablePacket(id);
+        table.emplace(packet.hash(), packet);
+    }
+
+    cs::TransactionsPacketTable copy = table;
+    ASSERT_EQ(copy.byteSize(), table.byteSize());
+}
@@ -0,0 +1,86 @@
+#include <csnode/walletsids.hpp>
+
+#include "gtest/gtest.h"
+
+static csdb::Address makeAddress(uint64_t seed) {
+    cs::PublicKey key;
+    key.fill(0);
+
+    for (size_t i = 0; i < sizeof(seed); ++i) {
+        key[i] = static_cast<cs::Byte>(seed >> (i * 8));
+    }
+
+    key[31] = static_cast<cs::Byte>(seed % 251);
+    return csdb::Address::from_public_key(key);
+}
+
+TEST(WalletsIds, InsertAndFind) {
+    cs::WalletsIds ids;
+
+    ASSERT_TRUE(ids.normal().insert(makeAddress(1), 0));
+    ASSERT_TRUE(ids.normal().insert(makeAddress(2), 1));
+    ASSERT_FALSE(ids.normal().insert(makeAddress(1), 0));
+
+    cs::WalletsIds::WalletId id = cs::WalletsIds::kWrongWalletId;
+
+    ASSERT_TRUE(ids.normal().find(makeAddress(2), id));
+    ASSERT_EQ(id, 1U);
+    ASSERT_FALSE(ids.normal().find(makeAddress(3), id));
+
+    ASSERT_EQ(ids.getNextId(), 2U);
+}
+
+TEST(WalletsIds, GetAssignsSequentialIds) {
+    cs::WalletsIds ids;
+    cs::WalletsIds::WalletId id = cs::WalletsIds::kWrongWalletId;
+
+    ASSERT_TRUE(ids.normal().get(makeAddress(10), id));
+    ASSERT_EQ(id, 0U);
+
+    ASSERT_TRUE(ids.normal().get(makeAddress(11), id));
+    ASSERT_EQ(id, 1U);
+
+    // the second resolution of a known wallet must not mint a new id
+    ASSERT_FALSE(ids.normal().get(makeAddress(10), id));
+    ASSERT_EQ(id, 0U);
+    ASSERT_EQ(ids.getNextId(), 2U);
+}
+
+TEST(WalletsIds, RemoveForgetsAddress) {
+    cs::WalletsIds ids;
+    cs::WalletsIds::WalletId id = cs::WalletsIds::kWrongWalletId;
+
+    ids.normal().insert(makeAddress(1), 0);
+    ids.normal().insert(makeAddress(2), 1);
+
+    ASSERT_TRUE(ids.normal().remove(makeAddress(2)));
+    ASSERT_FALSE(ids.normal().find(makeAddress(2), id));
+    ASSERT_TRUE(ids.normal().find(makeAddress(1), id));
+    ASSERT_EQ(ids.getNextId(), 1U);
+}
+
+TEST(WalletsIds, SurvivesGrowthAndChurn) {
+    const uint64_t walletsCount = 10000;
+
+    cs::WalletsIds ids;
+    cs::WalletsIds::WalletId id = cs::WalletsIds::kWrongWalletId;
+
+    for (uint64_t i = 0; i < walletsCount; ++i) {
+        ASSERT_TRUE(ids.normal().get(makeAddress(i), id));
+        ASSERT_EQ(id, i);
+    }
+
+    // churn the tail, erasures leave tombstones behind in the index
+    for (uint64_t i = walletsCount - 1; i >= walletsCount - 100; --i) {
+        ASSERT_TRUE(ids.normal().remove(makeAddress(i)));
+    }
+
+    for (uint64_t i = 0; i < walletsCount - 100; ++i) {
+        ASSERT_TRUE(ids.normal().find(makeAddress(i), id));
+        ASSERT_EQ(id, i);
+    }
+
+    for (uint64_t i = walletsCount - 100; i < walletsCount; ++i) {
+        ASSERT_FALSE(ids.normal().find(makeAddress(i), id));
+    }
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <lib/system/common.hpp>
+#include <lib/system/cryptoservice.hpp>
+
+#include <cscrypto/cscrypto.hpp>
+
+TEST(CryptoService, EmptyBatch) {
+    auto& service = cs::CryptoService::instance();
+
+    ASSERT_TRUE(service.verifyBatch({}).empty());
+    ASSERT_TRUE(service.verifyAll({}));
+}
+
+TEST(CryptoService, RejectsGarbageSignatures) {
+    auto& service = cs::CryptoService::instance();
+
+    const cs::Signature signature{};
+    const cs::PublicKey key{};
+    const cs::Bytes message(64, 0x42);
+
+    // enough jobs to exercise the parallel path as well
+    std::vector<cs::CryptoService::VerifyJob> jobs(32, cs::CryptoService::VerifyJob{signature.data(), key.data(), message.data(), message.size()});
+
+    const auto results = service.verifyBatch(jobs);
+    ASSERT_EQ(results.size(), jobs.size());
+
+    for (const auto result : results) {
+        ASSERT_EQ(result, 0);
+    }
+
+    ASSERT_FALSE(service.verifyAll(jobs));
+    ASSERT_NE(service.report().find("verifications"), std::string::npos);
+}
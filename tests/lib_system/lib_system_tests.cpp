@@ -2,20 +2,25 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <list>
 #include <mutex>
 #include <thread>
 #include <type_traits>
 #include <condition_variable>
+#include <vector>
 
 #include <lib/system/random.hpp>
 #include <lib/system/allocators.hpp>
+#include <lib/system/threadaffinity.hpp>
 #include <lib/system/queues.hpp>
 #include <lib/system/structures.hpp>
 #include <lib/system/lockfreechanger.hpp>
 #include <lib/system/console.hpp>
+#include <lib/system/utils.hpp>
 #include <lib/system/pmrfactory.hpp>
+#include <lib/system/stacksampler.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -113,6 +118,43 @@ TEST(RegionAllocator, alloc_with_resizes) {
     ASSERT_EQ(allocator.allocations(), allocations);
 }
 
+TEST(RegionAllocator, PooledPagesAreReused) {
+    constexpr uint32_t kPageSize = 256, kPreallocated = 4;
+    cs::RegionAllocator allocator(kPageSize, kPreallocated);
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        auto p = allocator.allocateNext(100);
+        *(reinterpret_cast<uint32_t*>(p->data())) = i;
+    }
+
+    auto stats = allocator.stats();
+    ASSERT_EQ(stats.allocations, 100u);
+    // first allocation takes a preallocated page, each next one reuses it
+    ASSERT_EQ(stats.pageHits, 100u);
+    ASSERT_EQ(stats.pageChurn, 0u);
+    ASSERT_EQ(stats.bytesInFlight, 0u);
+}
+
+TEST(RegionAllocator, StatsTrackBytesInFlight) {
+    constexpr uint32_t kPageSize = 64, kPreallocated = 1;
+    cs::RegionAllocator allocator(kPageSize, kPreallocated);
+
+    {
+        std::vector<cs::RegionPtr> pointers;
+        pointers.push_back(allocator.allocateNext(10));    // pooled, counts as a full page
+        pointers.push_back(allocator.allocateNext(1000));  // oversized, straight from the heap
+
+        auto stats = allocator.stats();
+        ASSERT_EQ(stats.bytesInFlight, kPageSize + 1000u);
+        ASSERT_EQ(stats.peakBytesInFlight, kPageSize + 1000u);
+        ASSERT_EQ(stats.pageChurn, 0u);
+    }
+
+    auto stats = allocator.stats();
+    ASSERT_EQ(stats.bytesInFlight, 0u);
+    ASSERT_EQ(stats.peakBytesInFlight, kPageSize + 1000u);
+}
+
 TEST(RegionAllocator, multithreaded_stress) {
     cs::RegionAllocator a;
     uint64_t total = 0;
@@ -214,6 +256,65 @@ TEST(fuqueue, overwrite) {
     }
 }
 
+TEST(ftqueue, consecutive) {
+    FTQueue<uint32_t, 1024> q;
+
+    for (uint32_t i = 0; i < 1024; ++i) {
+        ASSERT_TRUE(q.tryPush(uint32_t(i)));
+    }
+
+    // queue is full, push must fail instead of spinning
+    ASSERT_FALSE(q.tryPush(uint32_t(0)));
+
+    for (uint32_t i = 0; i < 1024; ++i) {
+        ASSERT_TRUE(q.hasData());
+        uint32_t value = 0;
+        ASSERT_TRUE(q.tryPop(value));
+        ASSERT_EQ(value, i);
+    }
+
+    uint32_t value = 0;
+    ASSERT_FALSE(q.hasData());
+    ASSERT_FALSE(q.tryPop(value));
+}
+
+TEST(ftqueue, multiproducer) {
+    FTQueue<uint32_t, 1024> q;
+
+    std::atomic<uint64_t> wSum = {0};
+    uint64_t rSum = 0;
+
+    auto wrFunc = [&]() {
+        for (uint32_t i = 0; i < 100000; ++i) {
+            while (!q.tryPush(uint32_t(i))) {
+                std::this_thread::yield();
+            }
+            wSum.fetch_add(i, std::memory_order_relaxed);
+        }
+    };
+
+    std::thread w1(wrFunc);
+    std::thread w2(wrFunc);
+    std::thread w3(wrFunc);
+
+    for (int i = 0; i < 300000;) {
+        uint32_t value = 0;
+        if (q.tryPop(value)) {
+            rSum += value;
+            ++i;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    w1.join();
+    w2.join();
+    w3.join();
+
+    ASSERT_EQ(wSum.load(), rSum);
+}
+
 TEST(fuqueue, DISABLED_multithreaded_stress) {
     FUQueue<uint32_t, 1000> q;
 
@@ -419,6 +520,70 @@ TEST(FixedHashMap, depush) {
     }
 }
 
+TEST(CallsQueue, priority_lane_drains_first) {
+    auto& queue = CallsQueue::instance();
+    // the singleton may hold leftovers of other tests
+    queue.callAll();
+
+    std::vector<int> order;
+    queue.insert([&order]() { order.push_back(1); });
+    queue.insert([&order]() { order.push_back(2); });
+    queue.insertPriority([&order]() { order.push_back(100); });
+    queue.insertPriority([&order]() { order.push_back(101); });
+
+    queue.callAll();
+
+    ASSERT_EQ(order.size(), size_t(4));
+    // priority entries run before any regular entry regardless of insertion order
+    ASSERT_GT(order[0], 99);
+    ASSERT_GT(order[1], 99);
+    ASSERT_LT(order[2], 99);
+    ASSERT_LT(order[3], 99);
+}
+
+TEST(CallsQueue, priority_call_preempts_regular_backlog) {
+    auto& queue = CallsQueue::instance();
+    queue.callAll();
+
+    std::vector<int> order;
+    // the priority entry is scheduled from within a regular callback and must
+    // run before the remaining regular ones
+    queue.insert([&order]() { order.push_back(2); });
+    queue.insert([&order, &queue]() {
+        order.push_back(1);
+        queue.insertPriority([&order]() { order.push_back(100); });
+    });
+
+    queue.callAll();
+
+    ASSERT_EQ(order.size(), size_t(3));
+    ASSERT_EQ(order[0], 1);
+    ASSERT_EQ(order[1], 100);
+    ASSERT_EQ(order[2], 2);
+}
+
+TEST(CallsQueue, regular_drain_is_budgeted) {
+    auto& queue = CallsQueue::instance();
+    queue.callAll();
+
+    size_t executed = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        queue.insert([&executed]() {
+            ++executed;
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        });
+    }
+
+    // each callback overruns the drain budget, so one pass executes exactly one
+    // call and defers the rest to the next pass
+    queue.callAll();
+    ASSERT_EQ(executed, size_t(1));
+
+    queue.callAll();
+    queue.callAll();
+    ASSERT_EQ(executed, size_t(3));
+}
+
 template <>
 uint8_t getHashIndex(const uint16_t& h) {
     return static_cast<uint8_t>(h % (1 << 8));
@@ -749,3 +914,120 @@ TEST(PmrBytes, BaseUsage) {
     cs::Bytes expectedBytes = { 0xFF, 0xAA, 0xBB, 0xEE };
     ASSERT_TRUE(std::equal(std::begin(bytes), std::end(bytes), std::begin(expectedBytes)));
 }
+
+TEST(ThreadAffinity, EmptyCpuSetIsNoOp) {
+    auto& affinity = cs::ThreadAffinity::instance();
+
+    affinity.setCpuSet(cs::ThreadAffinity::Domain::Worker, {});
+    affinity.apply(cs::ThreadAffinity::Domain::Worker);
+
+    SUCCEED();
+}
+
+#ifdef __linux__
+TEST(ThreadAffinity, PinsCallingThreadToConfiguredCpu) {
+    auto& affinity = cs::ThreadAffinity::instance();
+
+    std::thread thread([&] {
+        affinity.setCpuSet(cs::ThreadAffinity::Domain::Dispatch, { 0 });
+        affinity.apply(cs::ThreadAffinity::Domain::Dispatch);
+
+        ASSERT_EQ(sched_getcpu(), 0);
+    });
+
+    thread.join();
+    affinity.setCpuSet(cs::ThreadAffinity::Domain::Dispatch, {});
+}
+#endif
+
+// reference byte-loop implementations the SWAR kernels must agree with
+static size_t referenceTrustedCount(const cs::Bytes& mask) {
+    size_t count = 0;
+    for (auto byte : mask) {
+        if (byte != 255U) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static uint64_t referenceMaskToBits(const cs::Bytes& mask) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < mask.size(); ++i) {
+        if (mask[i] != 255U) {
+            value |= uint64_t(1) << i;
+        }
+    }
+    return value;
+}
+
+TEST(Utils, trustedByteCountMatchesByteLoop) {
+    for (size_t size = 0; size <= 64; ++size) {
+        cs::Bytes mask(size);
+
+        for (auto& byte : mask) {
+            byte = cs::Random::generateValue<int>(0, 2) == 0 ? 255U : cs::Byte(cs::Random::generateValue<int>(0, 254));
+        }
+
+        ASSERT_EQ(cs::Utils::trustedByteCount(mask), referenceTrustedCount(mask));
+    }
+}
+
+TEST(Utils, maskToBitsMatchesByteLoop) {
+    for (size_t size = 0; size <= 64; ++size) {
+        cs::Bytes mask(size);
+
+        for (size_t i = 0; i < size; ++i) {
+            mask[i] = (i % 3 == 0) ? 255U : cs::Byte(i);
+        }
+
+        ASSERT_EQ(cs::Utils::maskToBits(mask), referenceMaskToBits(mask));
+    }
+}
+
+TEST(Utils, maskToBitsRoundTripsThroughBitsToMask) {
+    const uint64_t bits = 0xA5F00F5AA5F00F5AULL;
+    const cs::Bytes mask = cs::Utils::bitsToMask(64, bits);
+
+    ASSERT_EQ(cs::Utils::maskToBits(mask), bits);
+    ASSERT_EQ(cs::Utils::trustedByteCount(mask), static_cast<size_t>(cs::Utils::maskValue(bits)));
+}
+
+TEST(StackSampler, CapturesRegisteredThreads) {
+    if (!cs::StackSampler::isSupported()) {
+        auto samples = cs::StackSampler::instance().capture(50, 10);
+        ASSERT_TRUE(samples.empty());
+        return;
+    }
+
+    std::atomic<bool> stop{false};
+    std::thread worker([&stop]() {
+        cs::StackSampler::instance().registerThread("test-worker");
+
+        while (!stop.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        cs::StackSampler::instance().unregisterThread();
+    });
+
+    auto samples = cs::StackSampler::instance().capture(200, 20);
+
+    stop.store(true, std::memory_order_release);
+    worker.join();
+
+    ASSERT_FALSE(samples.empty());
+
+    for (const auto& sample : samples) {
+        ASSERT_EQ(sample.thread, std::string("test-worker"));
+        ASSERT_FALSE(sample.frames.empty());
+        ASSERT_LE(sample.offsetMs, size_t(200));
+    }
+}
+
+TEST(StackSampler, UnregisteredThreadIsNotSampled) {
+    // no thread registered in this test: a capture must come back empty
+    // instead of signalling anything
+    auto samples = cs::StackSampler::instance().capture(30, 10);
+    ASSERT_TRUE(samples.empty());
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <lib/system/lockprofiler.hpp>
+
+TEST(LockProfiler, reportContainsNamedLock) {
+    int lock = 0;
+    auto& profiler = cs::LockProfiler::instance();
+
+    profiler.name(&lock, "test.namedLock");
+    profiler.record(&lock, 1000, 2000);
+
+    const std::string report = profiler.report();
+    ASSERT_NE(report.find("test.namedLock"), std::string::npos);
+    ASSERT_NE(report.find("acquisitions 1"), std::string::npos);
+}
+
+TEST(LockProfiler, mergesRecordsAcrossThreads) {
+    int lock = 0;
+    auto& profiler = cs::LockProfiler::instance();
+
+    profiler.name(&lock, "test.sharedAcrossThreads");
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < 100; ++j) {
+                profiler.record(&lock, 10, 20);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::string report = profiler.report();
+    ASSERT_NE(report.find("test.sharedAcrossThreads: acquisitions 400"), std::string::npos);
+}
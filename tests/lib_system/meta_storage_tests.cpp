@@ -150,3 +150,63 @@ TEST(MetaStorage, MaxAndLast) {
 
     ASSERT_EQ(storage.last(), expectedString);
 }
+
+TEST(MetaStorage, EvictionHandlerGetsOverwrittenElement) {
+    TestIntMetaSatorage storage(3);
+    std::vector<cs::RoundNumber> evictedRounds;
+
+    storage.setEvictionHandler([&](TestIntMetaSatorage::Element&& element) {
+        evictedRounds.push_back(element.round);
+    });
+
+    for (cs::RoundNumber round = 1; round <= 5; ++round) {
+        ASSERT_EQ(storage.append(round, static_cast<int>(round) * 10), true);
+    }
+
+    printStorageSize(storage);
+
+    ASSERT_EQ(storage.size(), 3);
+    ASSERT_EQ(evictedRounds, (std::vector<cs::RoundNumber>{1, 2}));
+    ASSERT_EQ(storage.contains(1), false);
+    ASSERT_EQ(storage.contains(5), true);
+}
+
+TEST(MetaStorage, ByteBudgetEvictsOldest) {
+    TestStringMetaStorage storage(100);
+    std::vector<cs::RoundNumber> evictedRounds;
+
+    storage.setEvictionHandler([&](TestStringMetaStorage::Element&& element) {
+        evictedRounds.push_back(element.round);
+    });
+    storage.setByteBudget(10, [](const std::string& value) {
+        return value.size();
+    });
+
+    storage.append(1, std::string(4, 'a'));
+    storage.append(2, std::string(4, 'b'));
+    ASSERT_EQ(storage.bytesUsed(), 8);
+    ASSERT_EQ(evictedRounds.empty(), true);
+
+    // pushes accumulated bytes over the high-water mark
+    storage.append(3, std::string(4, 'c'));
+
+    ASSERT_EQ(storage.bytesUsed(), 8);
+    ASSERT_EQ(evictedRounds, (std::vector<cs::RoundNumber>{1}));
+    ASSERT_EQ(storage.contains(1), false);
+    ASSERT_EQ(storage.contains(2), true);
+    ASSERT_EQ(storage.contains(3), true);
+}
+
+TEST(MetaStorage, ExtractReleasesBudget) {
+    TestStringMetaStorage storage(100);
+    storage.setByteBudget(100, [](const std::string& value) {
+        return value.size();
+    });
+
+    storage.append(1, std::string(30, 'x'));
+    ASSERT_EQ(storage.bytesUsed(), 30);
+
+    std::optional<std::string> value = storage.extract(1);
+    ASSERT_EQ(value.has_value(), true);
+    ASSERT_EQ(storage.bytesUsed(), 0);
+}
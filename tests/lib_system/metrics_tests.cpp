@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <lib/system/metrics.hpp>
+
+TEST(Metrics, emptyHistogramReport) {
+    cs::LatencyHistogram histogram;
+    ASSERT_EQ(histogram.report(), "count=0");
+}
+
+TEST(Metrics, reportContainsRecordedCount) {
+    auto& histogram = cs::Metrics::instance().histogram("test_report_count_us");
+
+    for (uint64_t value = 0; value < 100; ++value) {
+        histogram.record(value);
+    }
+
+    const std::string report = histogram.report();
+    ASSERT_NE(report.find("count=100"), std::string::npos);
+
+    const std::string full = cs::Metrics::instance().report();
+    ASSERT_NE(full.find("test_report_count_us"), std::string::npos);
+}
+
+TEST(Metrics, quantilesAreOrdered) {
+    cs::LatencyHistogram histogram;
+
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value);
+    }
+
+    const std::string report = histogram.report();
+
+    const auto valueOf = [&](const std::string& key) {
+        const size_t position = report.find(key);
+        return std::stoull(report.substr(position + key.size()));
+    };
+
+    const auto p50 = valueOf("p50=");
+    const auto p90 = valueOf("p90=");
+    const auto p99 = valueOf("p99=");
+
+    ASSERT_LE(p50, p90);
+    ASSERT_LE(p90, p99);
+
+    // sub-bucket layout keeps the relative error below 12.5%
+    ASSERT_GE(p50, 4375u);
+    ASSERT_LE(p50, 5000u);
+}
+
+TEST(Metrics, concurrentRecording) {
+    auto& histogram = cs::Metrics::instance().histogram("test_concurrent_us");
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            for (uint64_t value = 0; value < 1000; ++value) {
+                histogram.record(value);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_NE(histogram.report().find("count=4000"), std::string::npos);
+}
+
+TEST(Metrics, counterIsSharedByName) {
+    auto& counter = cs::Metrics::instance().counter("test_progress_counter");
+    counter.fetch_add(5, std::memory_order_relaxed);
+
+    // the same name must resolve to the same atomic
+    ASSERT_EQ(cs::Metrics::instance().counter("test_progress_counter").load(), 5u);
+
+    bool found = false;
+    cs::Metrics::instance().forEachCounter([&](const std::string& name, uint64_t value) {
+        if (name == "test_progress_counter") {
+            found = true;
+            ASSERT_EQ(value, 5u);
+        }
+    });
+
+    ASSERT_TRUE(found);
+}
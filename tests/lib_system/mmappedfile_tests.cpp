@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <lib/system/mmappedfile.hpp>
+
+namespace {
+const std::string kTestFileName = "mmappedfile_test.tmp";
+
+std::string readBack(const std::string& fileName) {
+    std::ifstream ifs(fileName, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+TEST(MMappedGrowableSink, GrowsPastInitialMappingAndTruncates) {
+    const std::string payload(1024, 'x');
+
+    {
+        // tiny initial mapping forces several grow steps
+        cs::MMappedGrowableSink sink(kTestFileName, 16);
+        ASSERT_TRUE(sink.isOpen());
+
+        for (size_t i = 0; i < 8; ++i) {
+            ASSERT_EQ(sink.write(payload.data(), static_cast<std::streamsize>(payload.size())), static_cast<std::streamsize>(payload.size()));
+        }
+
+        ASSERT_EQ(sink.written(), payload.size() * 8);
+    }
+
+    ASSERT_EQ(std::filesystem::file_size(kTestFileName), payload.size() * 8);
+    std::filesystem::remove(kTestFileName);
+}
+
+TEST(MMappedOutput, StreamContentMatchesWhatWasWritten) {
+    const std::string content = "snapshot payload, written through the mapping";
+
+    {
+        cs::MMappedOutput out(kTestFileName);
+        ASSERT_TRUE(out.isOpen());
+        out.stream() << content;
+    }
+
+    ASSERT_EQ(readBack(kTestFileName), content);
+    std::filesystem::remove(kTestFileName);
+}
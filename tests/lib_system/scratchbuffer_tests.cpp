@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+
+#include <lib/system/scratchbuffer.hpp>
+
+TEST(ScratchBuffer, StartsEmpty) {
+    cs::ScratchBuffer scratch;
+
+    ASSERT_TRUE(scratch.bytes().empty());
+}
+
+TEST(ScratchBuffer, CapacityIsRecycledBetweenHandles) {
+    size_t grownCapacity = 0;
+
+    {
+        cs::ScratchBuffer scratch;
+        scratch.bytes().resize(64 * 1024);
+        grownCapacity = scratch.bytes().capacity();
+    }
+
+    cs::ScratchBuffer scratch;
+
+    ASSERT_TRUE(scratch.bytes().empty());
+    ASSERT_GE(scratch.bytes().capacity(), grownCapacity);
+}
+
+TEST(ScratchBuffer, MovedOutBufferIsHandledGracefully) {
+    {
+        cs::ScratchBuffer scratch;
+        scratch.bytes().resize(128);
+
+        cs::Bytes stolen = std::move(scratch.bytes());
+        ASSERT_EQ(stolen.size(), 128u);
+    }
+
+    // the pool took back an empty buffer, renting still works
+    cs::ScratchBuffer scratch;
+    scratch.bytes().push_back(cs::Byte{1});
+
+    ASSERT_EQ(scratch.bytes().size(), 1u);
+}
+
+TEST(ScratchBuffer, OversizedBuffersAreNotRetained) {
+    {
+        cs::ScratchBuffer scratch;
+        scratch.bytes().resize((1 << 20) + 1);
+    }
+
+    cs::ScratchBuffer scratch;
+
+    // a giant one-off message must not pin its capacity in the pool
+    ASSERT_LE(scratch.bytes().capacity(), size_t(1 << 20));
+}
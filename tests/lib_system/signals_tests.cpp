@@ -374,6 +374,64 @@ TEST(Signals, NonArgumentsCopy) {
     ASSERT_EQ(checker.value, expectedValue);
 }
 
+TEST(Signals, PredicateGuardedLambdaConnection) {
+    size_t callsCount = 0;
+
+    cs::Signal<void(int)> signal;
+    cs::Connector::connectIf(&signal, [](int value) { return value > 0; }, [&](int value) {
+        ++callsCount;
+        std::cout << "Guarded slot value " << value << std::endl;
+    });
+
+    emit signal(-1);
+    emit signal(0);
+
+    ASSERT_EQ(callsCount, 0);
+
+    emit signal(1);
+    emit signal(42);
+
+    ASSERT_EQ(callsCount, 2);
+    ASSERT_EQ(cs::Connector::callbacks(&signal), 1);
+}
+
+TEST(Signals, PredicateGuardedObjectConnection) {
+    static size_t callsCount = 0;
+    callsCount = 0;
+
+    class A {
+    public signals:
+        cs::Signal<void(const std::string&)> signal;
+    };
+
+    class B : public cs::IConnectable {
+    public slots:
+        void onSignal(const std::string& message) {
+            ++callsCount;
+            std::cout << "Guarded object slot message " << message << std::endl;
+        }
+    };
+
+    A a;
+
+    {
+        B b;
+        cs::Connector::connectIf(&a.signal, [](const std::string& message) { return !message.empty(); }, &b, &B::onSignal);
+
+        emit a.signal("");
+        ASSERT_EQ(callsCount, 0);
+
+        emit a.signal("cs");
+        ASSERT_EQ(callsCount, 1);
+    }
+
+    // guarded slots follow the usual object lifetime rules
+    emit a.signal("cs");
+
+    ASSERT_EQ(callsCount, 1);
+    ASSERT_EQ(cs::Connector::callbacks(&a.signal), 0);
+}
+
 TEST(Signals, ArgumentsCopy) {
     static bool isCopied = false;
 